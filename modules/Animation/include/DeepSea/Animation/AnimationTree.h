@@ -122,6 +122,27 @@ DS_ANIMATION_EXPORT dsAnimationTree* dsAnimationTree_loadStream(
 DS_ANIMATION_EXPORT dsAnimationTree* dsAnimationTree_loadData(
 	dsAllocator* allocator, dsAllocator* scratchAllocator, const void* data, size_t size);
 
+/**
+ * @brief Loads an animation tree asynchronously.
+ *
+ * The file is read and the animation tree is loaded on an IO thread, so the allocators must be
+ * thread-safe.
+ *
+ * @remark errno will be set on failure.
+ * @param asyncIO The asynchronous IO manager to read the file with.
+ * @param allocator The allocator to create the animation tree with.
+ * @param scratchAllocator The allocator for temporary data. This must support freeing memory. If
+ *     NULL, it will use the animation tree allocator.
+ * @param file The file to load from. The path will be copied.
+ * @param completeFunc The function to call with the loaded animation tree on the IO thread.
+ * @param userData The user data to pass to completeFunc.
+ * @return False if the load couldn't be started. If true is returned, completeFunc is guaranteed
+ *     to be called.
+ */
+DS_ANIMATION_EXPORT bool dsAnimationTree_loadAsync(dsAsyncIO* asyncIO, dsAllocator* allocator,
+	dsAllocator* scratchAllocator, const dsAsyncIOFile* file,
+	dsAsyncLoadCompleteFunction completeFunc, void* userData);
+
 /**
  * @brief Clones an animation tree.
  *
@@ -109,6 +109,27 @@ DS_ANIMATION_EXPORT dsDirectAnimation* dsDirectAnimation_loadStream(
 DS_ANIMATION_EXPORT dsDirectAnimation* dsDirectAnimation_loadData(
 	dsAllocator* allocator, dsAllocator* scratchAllocator, const void* data, size_t size);
 
+/**
+ * @brief Loads a direct animation asynchronously.
+ *
+ * The file is read and the direct animation is loaded on an IO thread, so the allocators must be
+ * thread-safe.
+ *
+ * @remark errno will be set on failure.
+ * @param asyncIO The asynchronous IO manager to read the file with.
+ * @param allocator The allocator to create the direct animation with.
+ * @param scratchAllocator The allocator for temporary data. This must support freeing memory. If
+ *     NULL, it will use the direct animation allocator.
+ * @param file The file to load from. The path will be copied.
+ * @param completeFunc The function to call with the loaded direct animation on the IO thread.
+ * @param userData The user data to pass to completeFunc.
+ * @return False if the load couldn't be started. If true is returned, completeFunc is guaranteed
+ *     to be called.
+ */
+DS_ANIMATION_EXPORT bool dsDirectAnimation_loadAsync(dsAsyncIO* asyncIO, dsAllocator* allocator,
+	dsAllocator* scratchAllocator, const dsAsyncIOFile* file,
+	dsAsyncLoadCompleteFunction completeFunc, void* userData);
+
 /**
  * @brief Destroys a direct animation.
  * @param animation The direct animation to destroy.
@@ -1,5 +1,5 @@
 /*
- * Copyright 2022-2025 Aaron Barany
+ * Copyright 2022-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -109,6 +109,27 @@ DS_ANIMATION_EXPORT dsKeyframeAnimation* dsKeyframeAnimation_loadStream(dsAlloca
 DS_ANIMATION_EXPORT dsKeyframeAnimation* dsKeyframeAnimation_loadData(dsAllocator* allocator,
 	dsAllocator* scratchAllocator, const void* data, size_t size);
 
+/**
+ * @brief Loads a keyframe animation asynchronously.
+ *
+ * The file is read and the keyframe animation is loaded on an IO thread, so the allocators must be
+ * thread-safe.
+ *
+ * @remark errno will be set on failure.
+ * @param asyncIO The asynchronous IO manager to read the file with.
+ * @param allocator The allocator to create the keyframe animation with.
+ * @param scratchAllocator The allocator for temporary data. This must support freeing memory. If
+ *     NULL, it will use the keyframe animation allocator.
+ * @param file The file to load from. The path will be copied.
+ * @param completeFunc The function to call with the loaded keyframe animation on the IO thread.
+ * @param userData The user data to pass to completeFunc.
+ * @return False if the load couldn't be started. If true is returned, completeFunc is guaranteed
+ *     to be called.
+ */
+DS_ANIMATION_EXPORT bool dsKeyframeAnimation_loadAsync(dsAsyncIO* asyncIO, dsAllocator* allocator,
+	dsAllocator* scratchAllocator, const dsAsyncIOFile* file,
+	dsAsyncLoadCompleteFunction completeFunc, void* userData);
+
 /**
  * @brief Destroys a keyframe animation.
  * @param animation The keyframe animation to destroy.
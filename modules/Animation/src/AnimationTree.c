@@ -23,8 +23,9 @@
 #include <DeepSea/Core/Memory/Allocator.h>
 #include <DeepSea/Core/Memory/BufferAllocator.h>
 #include <DeepSea/Core/Memory/StackAllocator.h>
+#include <DeepSea/Core/Streams/AsyncIO.h>
 #include <DeepSea/Core/Streams/FileArchive.h>
-#include <DeepSea/Core/Streams/FileStream.h>
+#include <DeepSea/Core/Streams/MappedFileStream.h>
 #include <DeepSea/Core/Streams/ResourceStream.h>
 #include <DeepSea/Core/Streams/Stream.h>
 #include <DeepSea/Core/Assert.h>
@@ -724,6 +725,41 @@ dsAnimationTree* dsAnimationTree_createJoints(
 	return tree;
 }
 
+typedef struct LoadAsyncContext
+{
+	dsAllocator* allocator;
+	dsAllocator* scratchAllocator;
+	dsAsyncLoadCompleteFunction completeFunc;
+	void* userData;
+} LoadAsyncContext;
+
+static void loadAsyncComplete(void* userData, const dsAsyncIORequest* request, void* data,
+	size_t size, int errorCode)
+{
+	LoadAsyncContext* context = (LoadAsyncContext*)userData;
+	dsAnimationTree* tree = NULL;
+	if (data)
+	{
+		tree = dsAnimationTree_loadImpl(context->allocator, context->scratchAllocator, data, size,
+			request->file.path);
+		if (!tree)
+			errorCode = errno;
+		DS_VERIFY(dsAllocator_free(context->scratchAllocator, data));
+	}
+	else
+	{
+		DS_LOG_ERROR_F(DS_ANIMATION_LOG_TAG, "Couldn't open animation tree file '%s'.",
+			request->file.path);
+		if (errorCode == 0)
+			errorCode = EFORMAT;
+	}
+
+	dsAsyncLoadCompleteFunction completeFunc = context->completeFunc;
+	void* completeUserData = context->userData;
+	DS_VERIFY(dsAllocator_free(context->scratchAllocator, context));
+	completeFunc(completeUserData, tree, errorCode);
+}
+
 dsAnimationTree* dsAnimationTree_loadFile(
 	dsAllocator* allocator, dsAllocator* scratchAllocator, const char* filePath)
 {
@@ -736,22 +772,21 @@ dsAnimationTree* dsAnimationTree_loadFile(
 	if (!scratchAllocator)
 		scratchAllocator = allocator;
 
-	dsFileStream stream;
-	if (!dsFileStream_openPath(&stream, filePath, "rb"))
+	dsMappedFileStream stream;
+	if (!dsMappedFileStream_openPath(&stream, filePath))
 	{
 		DS_LOG_ERROR_F(DS_ANIMATION_LOG_TAG, "Couldn't open animation tree file '%s'.", filePath);
 		return NULL;
 	}
 
+	// Load directly from the mapped file rather than copying it to a separate buffer.
 	size_t size;
-	void* buffer = dsStream_readUntilEnd(&size, (dsStream*)&stream, scratchAllocator);
-	dsFileStream_close(&stream);
-	if (!buffer)
-		return NULL;
+	const void* buffer = dsMappedFileStream_getBuffer(&stream, &size);
+	DS_ASSERT(buffer);
 
 	dsAnimationTree* tree = dsAnimationTree_loadImpl(
 		allocator, scratchAllocator, buffer, size, filePath);
-	DS_VERIFY(dsAllocator_free(scratchAllocator, buffer));
+	DS_VERIFY(dsMappedFileStream_close(&stream));
 	return tree;
 }
 
@@ -855,6 +890,52 @@ dsAnimationTree* dsAnimationTree_loadData(
 	return dsAnimationTree_loadImpl(allocator, scratchAllocator, data, size, NULL);
 }
 
+bool dsAnimationTree_loadAsync(dsAsyncIO* asyncIO, dsAllocator* allocator,
+	dsAllocator* scratchAllocator, const dsAsyncIOFile* file,
+	dsAsyncLoadCompleteFunction completeFunc, void* userData)
+{
+	if (!asyncIO || !allocator || !file || !file->path || !completeFunc)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (!scratchAllocator)
+		scratchAllocator = allocator;
+
+	if (!scratchAllocator->freeFunc)
+	{
+		errno = EINVAL;
+		DS_LOG_ERROR(DS_ANIMATION_LOG_TAG,
+			"Animation tree scratch allocator must support freeing memory for async loads.");
+		return false;
+	}
+
+	LoadAsyncContext* context = DS_ALLOCATE_OBJECT(scratchAllocator, LoadAsyncContext);
+	if (!context)
+		return false;
+
+	context->allocator = allocator;
+	context->scratchAllocator = scratchAllocator;
+	context->completeFunc = completeFunc;
+	context->userData = userData;
+
+	dsAsyncIORequest request;
+	memset(&request, 0, sizeof(request));
+	request.file = *file;
+	request.allocator = scratchAllocator;
+	request.completeFunc = &loadAsyncComplete;
+	request.userData = context;
+	request.completeOnIOThread = true;
+	if (!dsAsyncIO_addRequests(asyncIO, &request, 1))
+	{
+		DS_VERIFY(dsAllocator_free(scratchAllocator, context));
+		return false;
+	}
+
+	return true;
+}
+
 dsAnimationTree* dsAnimationTree_clone(dsAllocator* allocator, const dsAnimationTree* tree)
 {
 	if (!allocator || !tree)
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <DeepSea/Core/Config.h>
+#include <DeepSea/Core/Export.h>
+#include <DeepSea/Core/Types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @file
+ * @brief Functions for logging asynchronously.
+ *
+ * The asynchronous log keeps a fixed-size ring buffer for each thread that logs messages. Queuing a
+ * message only copies it into the calling thread's buffer without taking any locks, while a
+ * background thread sends the queued messages to the output function. Messages are dropped if the
+ * buffer is full, and the number of dropped messages is reported through the output function once
+ * there's room again.
+ *
+ * Error and fatal messages are output synchronously after all previously queued messages so they
+ * aren't lost if the application is about to crash. Messages too large to fit in a thread buffer
+ * and messages from threads beyond the maximum thread count are also output synchronously.
+ *
+ * To use the asynchronous log, set it as the log function:
+ * dsLog_setFunction(asyncLog, &dsAsyncLog_log).
+ *
+ * @see dsAsyncLog
+ */
+
+/**
+ * @brief The default size of the buffer for each thread.
+ */
+#define DS_DEFAULT_ASYNC_LOG_BUFFER_SIZE 65536
+
+/**
+ * @brief The default maximum number of threads that may queue messages.
+ */
+#define DS_DEFAULT_ASYNC_LOG_MAX_THREADS 64
+
+/**
+ * @brief Creates an asynchronous log.
+ * @remark errno will be set on failure.
+ * @param allocator The allocator for the asynchronous log. This must support freeing memory.
+ * @param threadBufferSize The size of the buffer for each thread in bytes. This will be rounded up
+ *     to a power of two. If 0, DS_DEFAULT_ASYNC_LOG_BUFFER_SIZE will be used.
+ * @param maxThreads The maximum number of threads that may queue messages. If 0,
+ *     DS_DEFAULT_ASYNC_LOG_MAX_THREADS will be used.
+ * @param outputFunc The function to output the messages with. This will only be called by a single
+ *     thread at a time. If NULL, dsLog_defaultPrint() will be used.
+ * @param outputUserData The user data to pass to outputFunc.
+ * @return The asynchronous log or NULL if it couldn't be created.
+ */
+DS_CORE_EXPORT dsAsyncLog* dsAsyncLog_create(dsAllocator* allocator, size_t threadBufferSize,
+	uint32_t maxThreads, dsLogFunction outputFunc, void* outputUserData);
+
+/**
+ * @brief Logs a message to an asynchronous log.
+ *
+ * This has the signature of dsLogFunction so it can be passed to dsLog_setFunction() with the
+ * asynchronous log as the user data.
+ *
+ * @remark This function is thread-safe.
+ * @param asyncLog The asynchronous log.
+ * @param level The level of the message.
+ * @param tag The tag for the message.
+ * @param file The file for the message.
+ * @param line The line for the message.
+ * @param function The function for the message.
+ * @param message The log message.
+ */
+DS_CORE_EXPORT void dsAsyncLog_log(void* asyncLog, dsLogLevel level, const char* tag,
+	const char* file, unsigned int line, const char* function, const char* message);
+
+/**
+ * @brief Outputs all queued messages on the current thread.
+ * @remark This function is thread-safe.
+ * @remark errno will be set on failure.
+ * @param asyncLog The asynchronous log.
+ * @return False if asyncLog is NULL.
+ */
+DS_CORE_EXPORT bool dsAsyncLog_flush(dsAsyncLog* asyncLog);
+
+/**
+ * @brief Gets the total number of messages that were dropped due to full buffers.
+ * @remark This function is thread-safe.
+ * @param asyncLog The asynchronous log.
+ * @return The number of dropped messages.
+ */
+DS_CORE_EXPORT uint64_t dsAsyncLog_getDroppedCount(const dsAsyncLog* asyncLog);
+
+/**
+ * @brief Destroys an asynchronous log.
+ *
+ * All queued messages will be output before destruction. If the asynchronous log is the current
+ * log function, the log function will be cleared. No other threads may be logging to the
+ * asynchronous log at this point.
+ *
+ * @param asyncLog The asynchronous log to destroy.
+ */
+DS_CORE_EXPORT void dsAsyncLog_destroy(dsAsyncLog* asyncLog);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <DeepSea/Core/Config.h>
+#include <DeepSea/Core/Export.h>
+#include <DeepSea/Core/Containers/Types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @file
+ * @brief Functions for managing a hash map.
+ *
+ * The hash map uses open addressing with control bytes for each slot, allowing a group of slots to
+ * be checked with a single SIMD comparison. This avoids the pointer chasing of dsHashTable, making
+ * it better suited for frequent lookups. Unlike dsHashTable, the hash map allocates its own memory.
+ *
+ * Pointers to entries are only valid until the next insertion or removal.
+ *
+ * @see dsHashMap
+ */
+
+/**
+ * @brief Initializes a hash map.
+ * @remark errno will be set on failure.
+ * @param hashMap The hash map to initialize.
+ * @param allocator The allocator for the hash map. This must support freeing memory.
+ * @param reserveCount The number of entries to reserve space for. This may be 0 to defer allocation
+ *     until the first insertion.
+ * @param hashFunc The hashing function.
+ * @param keysEqualFunc The function to determine if two keys are equal.
+ * @return False if the parameters are invalid or allocation failed.
+ */
+DS_CORE_EXPORT bool dsHashMap_initialize(dsHashMap* hashMap, dsAllocator* allocator,
+	uint32_t reserveCount, dsHashFunction hashFunc, dsKeysEqualFunction keysEqualFunc);
+
+/**
+ * @brief Reserves space in the hash map for a number of entries.
+ * @remark errno will be set on failure.
+ * @param hashMap The hash map to reserve space in.
+ * @param count The total number of entries to reserve space for.
+ * @return False if the parameters are invalid or allocation failed.
+ */
+DS_CORE_EXPORT bool dsHashMap_reserve(dsHashMap* hashMap, uint32_t count);
+
+/**
+ * @brief Inserts an entry into the hash map.
+ * @remark errno will be set on failure.
+ * @param hashMap The hash map to insert into.
+ * @param key The key for the entry. The pointer will be kept for comparison.
+ * @param value The value for the entry.
+ * @param[out] existingValue If not NULL, this will be set to the value already in the hash map for
+ *     the same key, or NULL if there was no existing entry.
+ * @return False if the entry wasn't inserted. errno will be set to EPERM if the key already exists.
+ */
+DS_CORE_EXPORT bool dsHashMap_insert(dsHashMap* hashMap, const void* key, void* value,
+	void** existingValue);
+
+/**
+ * @brief Finds an entry within the hash map.
+ * @param hashMap The hash map to find the entry in.
+ * @param key The key to find the entry for.
+ * @return The found entry, or NULL if not found.
+ */
+DS_CORE_EXPORT dsHashMapEntry* dsHashMap_find(const dsHashMap* hashMap, const void* key);
+
+/**
+ * @brief Removes an entry from the hash map.
+ *
+ * The last entry will be moved into the removed entry's place.
+ *
+ * @param hashMap The hash map to remove the entry from.
+ * @param key The key for the entry.
+ * @param[out] outEntry If not NULL, this will be set to the removed entry.
+ * @return False if the entry wasn't found.
+ */
+DS_CORE_EXPORT bool dsHashMap_remove(dsHashMap* hashMap, const void* key,
+	dsHashMapEntry* outEntry);
+
+/**
+ * @brief Clears the contents of the hash map.
+ *
+ * The memory will be kept to re-use for future insertions.
+ *
+ * @remark errno will be set on failure.
+ * @param hashMap The hash map to clear.
+ * @return False if hashMap is NULL.
+ */
+DS_CORE_EXPORT bool dsHashMap_clear(dsHashMap* hashMap);
+
+/**
+ * @brief Destroys the memory for the hash map.
+ *
+ * The keys and values aren't freed since they're owned by the caller.
+ *
+ * @param hashMap The hash map to shut down.
+ */
+DS_CORE_EXPORT void dsHashMap_shutdown(dsHashMap* hashMap);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright 2016-2022 Aaron Barany
+ * Copyright 2016-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -198,6 +198,98 @@ typedef struct dsHashTable
 			tableSize*sizeof(dsHashTableNode*)]; \
 	}
 
+/**
+ * @brief Structure for an entry within a hash map.
+ * @see HashMap.h
+ */
+typedef struct dsHashMapEntry
+{
+	/**
+	 * @brief The key for the entry.
+	 */
+	const void* key;
+
+	/**
+	 * @brief The value for the entry.
+	 */
+	void* value;
+
+	/**
+	 * @brief The hash for the key, after being mixed by the hash map.
+	 */
+	uint32_t hash;
+} dsHashMapEntry;
+
+/**
+ * @brief Structure that holds a hash map.
+ *
+ * Unlike dsHashTable, the hash map manages its own memory and uses open addressing, where groups of
+ * slots are checked at once with SIMD instructions when available. Keys and values are referenced
+ * by pointer and their lifetime must be managed by the caller.
+ *
+ * The entries are stored in a dense array that may be iterated over directly, though it shouldn't
+ * be modified. Removing an entry will move the last entry into its place, so the iteration order
+ * won't be stable across removals.
+ *
+ * None of the members should be modified directly.
+ *
+ * @see HashMap.h
+ */
+typedef struct dsHashMap
+{
+	/**
+	 * @brief The allocator for the hash map.
+	 */
+	dsAllocator* allocator;
+
+	/**
+	 * @brief The hash function for the keys.
+	 */
+	dsHashFunction hashFunc;
+
+	/**
+	 * @brief The function for comparing two keys.
+	 */
+	dsKeysEqualFunction keysEqualFunc;
+
+	/**
+	 * @brief The entries in the hash map.
+	 */
+	dsHashMapEntry* entries;
+
+	/**
+	 * @brief The number of entries in the hash map.
+	 */
+	uint32_t entryCount;
+
+	/**
+	 * @brief The maximum number of entries before re-allocating.
+	 */
+	uint32_t maxEntries;
+
+	/**
+	 * @brief Control bytes for each slot in the table.
+	 *
+	 * Each byte is either empty, deleted, or holds the lower 7 bits of the hash.
+	 */
+	int8_t* controls;
+
+	/**
+	 * @brief The index into the entries for each slot in the table.
+	 */
+	uint32_t* slots;
+
+	/**
+	 * @brief The number of slots in the table.
+	 */
+	uint32_t capacity;
+
+	/**
+	 * @brief The number of entries that may be added before the table must grow.
+	 */
+	uint32_t growthLeft;
+} dsHashMap;
+
 /**
  * @brief Struct with a pool of allocated strings.
  *
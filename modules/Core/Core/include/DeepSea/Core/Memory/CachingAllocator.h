@@ -0,0 +1,129 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <DeepSea/Core/Config.h>
+#include <DeepSea/Core/Export.h>
+#include <DeepSea/Core/Memory/Types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @file
+ * @brief Implementation of dsAllocator that caches small allocations for each thread.
+ *
+ * Allocations up to DS_CACHING_ALLOCATOR_MAX_CACHED_SIZE with the default alignment are rounded up
+ * to a size class and taken from a bin local to the current thread. Freed blocks are returned to
+ * the bin of the thread that frees them. When a bin grows too large, a batch of blocks is moved to
+ * a global pool that other threads can take from, and the global pool returns memory to the base
+ * allocator once full. Larger allocations or allocations with a larger alignment are passed
+ * through to the base allocator.
+ *
+ * The size, totalAllocations, and currentAllocations members of dsAllocator are updated
+ * periodically rather than on every allocation to avoid contention between threads. Call
+ * dsCachingAllocator_flushThreadCache() on each thread that has used the allocator to get exact
+ * values.
+ *
+ * @see dsCachingAllocator
+ */
+
+/**
+ * @brief The maximum size of an allocation that will be cached.
+ */
+#define DS_CACHING_ALLOCATOR_MAX_CACHED_SIZE 4096
+
+/**
+ * @brief Creates a caching allocator.
+ * @remark errno will be set on failure.
+ * @param allocator The allocator to take memory from. This must support freeing memory and be
+ *     thread-safe.
+ * @return The caching allocator or NULL if an error occurred.
+ */
+DS_CORE_EXPORT dsCachingAllocator* dsCachingAllocator_create(dsAllocator* allocator);
+
+/**
+ * @brief Allocates memory from the caching allocator.
+ * @remark errno will be set on failure.
+ * @param allocator The allocator to allocate from.
+ * @param size The size to allocate.
+ * @param alignment The minimum alignment for the allocation.
+ * @return The allocated memory or NULL if an error occurred.
+ */
+DS_CORE_EXPORT void* dsCachingAllocator_alloc(
+	dsCachingAllocator* allocator, size_t size, unsigned int alignment);
+
+/**
+ * @brief Re-allocates memory from the caching allocator.
+ * @remark errno will be set on failure.
+ * @param allocator The allocator to allocate from.
+ * @param ptr The original pointer to reallocate.
+ * @param size The size to allocate.
+ * @param alignment The minimum alignment for the allocation.
+ * @return The allocated memory or NULL. If NULL and size isn't 0, an error occurred.
+ */
+DS_CORE_EXPORT void* dsCachingAllocator_realloc(
+	dsCachingAllocator* allocator, void* ptr, size_t size, unsigned int alignment);
+
+/**
+ * @brief Frees memory from the caching allocator.
+ *
+ * The memory may be freed from any thread, not only the thread that allocated it.
+ *
+ * @remark errno will be set on failure.
+ * @param allocator The allocator to free from.
+ * @param ptr The memory pointer to free.
+ * @return True if the memory could be freed.
+ */
+DS_CORE_EXPORT bool dsCachingAllocator_free(dsCachingAllocator* allocator, void* ptr);
+
+/**
+ * @brief Flushes the cache for the current thread.
+ *
+ * All cached blocks for the current thread will be moved to the global pool and any pending
+ * statistics will be applied to the base dsAllocator. This is done automatically when a thread
+ * exits.
+ *
+ * @remark errno will be set on failure.
+ * @param allocator The allocator to flush the current thread's cache for.
+ * @return False if allocator is NULL.
+ */
+DS_CORE_EXPORT bool dsCachingAllocator_flushThreadCache(dsCachingAllocator* allocator);
+
+/**
+ * @brief Gets the allocator memory is taken from.
+ * @param allocator The caching allocator.
+ * @return The base allocator or NULL if allocator is NULL.
+ */
+DS_CORE_EXPORT dsAllocator* dsCachingAllocator_getBaseAllocator(
+	const dsCachingAllocator* allocator);
+
+/**
+ * @brief Destroys a caching allocator.
+ *
+ * All memory allocated from the caching allocator must be freed first, and no other threads may
+ * use the allocator concurrently. All cached memory will be returned to the base allocator.
+ *
+ * @param allocator The allocator to destroy.
+ */
+DS_CORE_EXPORT void dsCachingAllocator_destroy(dsCachingAllocator* allocator);
+
+#ifdef __cplusplus
+}
+#endif
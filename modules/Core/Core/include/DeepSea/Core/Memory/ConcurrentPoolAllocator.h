@@ -0,0 +1,119 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <DeepSea/Core/Config.h>
+#include <DeepSea/Core/Export.h>
+#include <DeepSea/Core/Memory/Types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @file
+ * @brief Implementation of dsAllocator that allocates fixed chunks from a growable pool of memory.
+ *
+ * All allocations are the same size. Free chunks are kept in a lock-free list, using a tag with
+ * the head of the list to avoid the ABA problem, so allocating and freeing never takes a lock.
+ * When no free chunks remain, a new page is allocated from the base allocator, with each page
+ * being twice as large as the previous one. Pages are only freed when the allocator is destroyed.
+ *
+ * When thread caches are enabled, each thread keeps a small number of chunks that may be allocated
+ * and freed without touching shared state, exchanging half of the cache with the shared list at
+ * once. In this case the statistics for the dsAllocator are applied when exchanging chunks with the
+ * shared list or when the thread exits, so they may lag behind the true values.
+ *
+ * @see dsConcurrentPoolAllocator
+ */
+
+/**
+ * @brief Creates a concurrent pool allocator.
+ * @remark errno will be set on failure.
+ * @param allocator The allocator to take pages from. This must support freeing memory and be
+ *     thread-safe.
+ * @param chunkSize The size of each chunk.
+ * @param initialChunkCount The number of chunks in the first page. This will be rounded up to a
+ *     power of two.
+ * @param threadCaches True to cache chunks for each thread.
+ * @return The pool allocator or NULL if an error occurred.
+ */
+DS_CORE_EXPORT dsConcurrentPoolAllocator* dsConcurrentPoolAllocator_create(dsAllocator* allocator,
+	size_t chunkSize, size_t initialChunkCount, bool threadCaches);
+
+/**
+ * @brief Allocates memory from the pool allocator.
+ * @remark errno will be set on failure.
+ * @param allocator The allocator to allocate from.
+ * @param size The size to allocate. This must be equal to or less than the chunk size.
+ * @param alignment The minimum alignment of the allocation. This must not be larger than
+ *     DS_ALLOC_ALIGNMENT.
+ * @return The allocated memory or NULL if an error occurred.
+ */
+DS_CORE_EXPORT void* dsConcurrentPoolAllocator_alloc(
+	dsConcurrentPoolAllocator* allocator, size_t size, unsigned int alignment);
+
+/**
+ * @brief Frees memory from the pool allocator.
+ * @remark errno will be set on failure.
+ * @param allocator The allocator to free from.
+ * @param ptr The memory pointer to free.
+ * @return True if the memory could be freed.
+ */
+DS_CORE_EXPORT bool dsConcurrentPoolAllocator_free(dsConcurrentPoolAllocator* allocator, void* ptr);
+
+/**
+ * @brief Gets the size of each chunk.
+ * @param allocator The pool allocator.
+ * @return The chunk size, aligned to DS_ALLOC_ALIGNMENT, or 0 if allocator is NULL.
+ */
+DS_CORE_EXPORT size_t dsConcurrentPoolAllocator_getChunkSize(
+	const dsConcurrentPoolAllocator* allocator);
+
+/**
+ * @brief Gets the total number of chunks across all pages.
+ * @param allocator The pool allocator.
+ * @return The number of chunks or 0 if allocator is NULL.
+ */
+DS_CORE_EXPORT size_t dsConcurrentPoolAllocator_getChunkCount(
+	const dsConcurrentPoolAllocator* allocator);
+
+/**
+ * @brief Validates the consistency of the allocator.
+ *
+ * This can help make sure that there were no buffer overruns. This checks the shared free list
+ * against the number of chunks and the allocator statistics.
+ *
+ * @remark This may not be called concurrently with allocations or frees.
+ * @param allocator The allocator to validate.
+ * @return True if the allocator is valid. This will not set errno.
+ */
+DS_CORE_EXPORT bool dsConcurrentPoolAllocator_validate(dsConcurrentPoolAllocator* allocator);
+
+/**
+ * @brief Destroys a concurrent pool allocator.
+ *
+ * All pages will be freed, including any chunks that are still allocated.
+ *
+ * @param allocator The allocator to destroy.
+ */
+DS_CORE_EXPORT void dsConcurrentPoolAllocator_destroy(dsConcurrentPoolAllocator* allocator);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <DeepSea/Core/Config.h>
+#include <DeepSea/Core/Export.h>
+#include <DeepSea/Core/Memory/Types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @file
+ * @brief Implementation of dsAllocator for temporary memory that lasts for a number of frames.
+ *
+ * Each frame has its own chain of blocks that memory is taken from. Each thread reserves chunks
+ * from the current frame's blocks and allocates from them without synchronization, so only
+ * reserving a new chunk requires a lock. Large allocations are taken directly from the blocks.
+ * When a frame runs out of space a new block is chained, and the blocks are combined into a single
+ * larger block once the frame is reset.
+ *
+ * Memory cannot be freed individually. When dsFrameAllocator_beginFrame() cycles back to a frame,
+ * all memory previously allocated for that frame is reclaimed. This means memory stays valid for
+ * frameCount frames, so a frame count of 1 is for memory that lasts for the current frame only.
+ *
+ * The size member of dsAllocator is the total size of blocks reserved from the base allocator, and
+ * totalAllocations and currentAllocations track the block allocations. Individual allocations
+ * aren't tracked to avoid contention between threads.
+ *
+ * @see dsFrameAllocator
+ */
+
+/**
+ * @brief The default size of each block for a frame allocator.
+ */
+#define DS_DEFAULT_FRAME_ALLOCATOR_BLOCK_SIZE (1024*1024)
+
+/**
+ * @brief Creates a frame allocator.
+ * @remark errno will be set on failure.
+ * @param allocator The allocator to take memory from. This must support freeing memory and be
+ *     thread-safe.
+ * @param blockSize The size of each block to reserve memory for allocations. Blocks will be larger
+ *     when needed for large allocations.
+ * @param frameCount The number of frames to keep memory for before it is reclaimed.
+ * @return The frame allocator or NULL if an error occurred.
+ */
+DS_CORE_EXPORT dsFrameAllocator* dsFrameAllocator_create(dsAllocator* allocator, size_t blockSize,
+	unsigned int frameCount);
+
+/**
+ * @brief Allocates memory from the frame allocator.
+ *
+ * This may be called from any thread, but may not be called concurrently with
+ * dsFrameAllocator_beginFrame().
+ *
+ * @remark errno will be set on failure.
+ * @param allocator The allocator to allocate from.
+ * @param size The size to allocate.
+ * @param alignment The minimum alignment for the allocation.
+ * @return The allocated memory or NULL if an error occurred.
+ */
+DS_CORE_EXPORT void* dsFrameAllocator_alloc(
+	dsFrameAllocator* allocator, size_t size, unsigned int alignment);
+
+/**
+ * @brief Begins a new frame for the frame allocator.
+ *
+ * When the frame number changes, the allocator moves to the next frame's blocks and all memory
+ * previously allocated for that frame is reclaimed. Calling this again with the same frame number
+ * does nothing.
+ *
+ * @remark This may not be called concurrently with allocations.
+ * @remark errno will be set on failure.
+ * @param allocator The allocator to begin the frame for.
+ * @param frameNumber The number of the frame being started.
+ * @return False if allocator is NULL.
+ */
+DS_CORE_EXPORT bool dsFrameAllocator_beginFrame(dsFrameAllocator* allocator, uint64_t frameNumber);
+
+/**
+ * @brief Gets the number of frames memory is kept for.
+ * @param allocator The frame allocator.
+ * @return The number of frames or 0 if allocator is NULL.
+ */
+DS_CORE_EXPORT unsigned int dsFrameAllocator_getFrameCount(const dsFrameAllocator* allocator);
+
+/**
+ * @brief Destroys a frame allocator.
+ *
+ * All memory allocated from the frame allocator will be freed.
+ *
+ * @param allocator The allocator to destroy.
+ */
+DS_CORE_EXPORT void dsFrameAllocator_destroy(dsFrameAllocator* allocator);
+
+#ifdef __cplusplus
+}
+#endif
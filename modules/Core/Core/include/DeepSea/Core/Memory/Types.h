@@ -271,6 +271,48 @@ typedef struct dsPoolAllocator
 	dsSpinlock lock;
 } dsPoolAllocator;
 
+/**
+ * @brief Structure for a pool allocator that may be used concurrently across threads.
+ *
+ * This is effectively a subclass of dsAllocator and a pointer to dsConcurrentPoolAllocator can be
+ * freely cast between the two types.
+ *
+ * Unlike dsPoolAllocator, chunks are managed with a lock-free free list and new pages of chunks
+ * are allocated when the pool is exhausted. Chunks may optionally be cached for each thread.
+ *
+ * @see ConcurrentPoolAllocator.h
+ */
+typedef struct dsConcurrentPoolAllocator dsConcurrentPoolAllocator;
+
+/**
+ * @brief Structure for an allocator that caches memory for each thread in front of another
+ *     allocator.
+ *
+ * This is effectively a subclass of dsAllocator and a pointer to dsCachingAllocator can be freely
+ * cast between the two types.
+ *
+ * Small allocations are served from per-thread bins for each size class, only touching shared
+ * state when exchanging batches of blocks with a global pool. Statistics for the base dsAllocator
+ * are accumulated for each thread and applied periodically.
+ *
+ * @see CachingAllocator.h
+ */
+typedef struct dsCachingAllocator dsCachingAllocator;
+
+/**
+ * @brief Structure for an allocator for temporary memory within a frame.
+ *
+ * This is effectively a subclass of dsAllocator and a pointer to dsFrameAllocator can be freely
+ * cast between the two types.
+ *
+ * Memory is taken linearly from blocks for the current frame and is never freed individually.
+ * Instead, all memory for a frame is reclaimed once that frame's buffer is re-used after cycling
+ * through all frames. Allocations may be made concurrently across threads.
+ *
+ * @see FrameAllocator.h
+ */
+typedef struct dsFrameAllocator dsFrameAllocator;
+
 /**
  * @brief Structure to determine if an object is still alive.
  * @see Lifetime.h
@@ -1,5 +1,5 @@
 /*
- * Copyright 2018-2023 Aaron Barany
+ * Copyright 2018-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -47,10 +47,11 @@ extern "C"
 DS_CORE_EXPORT inline int dsCombineCmp(int a, int b);
 
 /**
- * @brief Performs a qsort on an array with a context pointer.
+ * @brief Sorts an array with a context pointer.
  *
- * This is equivalent to qsort_r() on Linux, but is generalized to work properly with other
- * platforms that have equivalent but slihgtly different functions.
+ * This is an introsort, using quicksort with a fallback to heapsort if the partitions become too
+ * unbalanced and insertion sort for small partitions. It's an unstable sort, and has an interface
+ * similar to qsort_r() on Linux.
  *
  * @param array The array to sort.
  * @param memberCount The number of members.
@@ -61,6 +62,79 @@ DS_CORE_EXPORT inline int dsCombineCmp(int a, int b);
 DS_CORE_EXPORT void dsSort(void* array, size_t memberCount, size_t memberSize,
 	dsSortCompareFunction compareFunc, void* context);
 
+/**
+ * @brief Sorts an array in parallel with a thread pool.
+ *
+ * The array is partitioned on the current thread until there are enough ranges to keep the threads
+ * busy, and each range is sorted with dsSort() as a separate task. Small arrays will be sorted on
+ * the current thread.
+ *
+ * @remark The compare function will be called across multiple threads, so it must be thread-safe.
+ * @param array The array to sort.
+ * @param memberCount The number of members.
+ * @param memberSize The size of each member.
+ * @param compareFunc The comparison function.
+ * @param context The context to provide with the comapre function.
+ * @param threadPool The thread pool to sort with. If NULL, this is equivalent to dsSort().
+ * @param allocator The allocator for temporary data when sorting with the thread pool. If NULL or
+ *     allocation fails, this will fall back to dsSort().
+ */
+DS_CORE_EXPORT void dsParallelSort(void* array, size_t memberCount, size_t memberSize,
+	dsSortCompareFunction compareFunc, void* context, dsThreadPool* threadPool,
+	dsAllocator* allocator);
+
+/**
+ * @brief Sorts an array by an unsigned 32-bit integer key from smallest to largest.
+ *
+ * This is a radix sort, which avoids calling a compare function for each element. It is a stable
+ * sort.
+ *
+ * @remark errno will be set on failure.
+ * @param array The array to sort.
+ * @param tempArray Temporary array to sort with. This must have space for memberCount members.
+ * @param memberCount The number of members.
+ * @param memberSize The size of each member.
+ * @param keyOffset The offset in bytes of the uint32_t key within each member.
+ * @return False if the parameters are invalid.
+ */
+DS_CORE_EXPORT bool dsRadixSortUInt32Key(void* array, void* tempArray, size_t memberCount,
+	size_t memberSize, size_t keyOffset);
+
+/**
+ * @brief Sorts an array by an unsigned 64-bit integer key from smallest to largest.
+ *
+ * This is a radix sort, which avoids calling a compare function for each element. It is a stable
+ * sort. Passes are skipped for bytes that are the same for all keys, so unused upper bits add
+ * little cost.
+ *
+ * @remark errno will be set on failure.
+ * @param array The array to sort.
+ * @param tempArray Temporary array to sort with. This must have space for memberCount members.
+ * @param memberCount The number of members.
+ * @param memberSize The size of each member.
+ * @param keyOffset The offset in bytes of the uint64_t key within each member.
+ * @return False if the parameters are invalid.
+ */
+DS_CORE_EXPORT bool dsRadixSortUInt64Key(void* array, void* tempArray, size_t memberCount,
+	size_t memberSize, size_t keyOffset);
+
+/**
+ * @brief Sorts an array by a float key from smallest to largest.
+ *
+ * This is a radix sort, which avoids calling a compare function for each element. It is a stable
+ * sort. -0 will be sorted before 0, and the keys must not be NaN.
+ *
+ * @remark errno will be set on failure.
+ * @param array The array to sort.
+ * @param tempArray Temporary array to sort with. This must have space for memberCount members.
+ * @param memberCount The number of members.
+ * @param memberSize The size of each member.
+ * @param keyOffset The offset in bytes of the float key within each member.
+ * @return False if the parameters are invalid.
+ */
+DS_CORE_EXPORT bool dsRadixSortFloatKey(void* array, void* tempArray, size_t memberCount,
+	size_t memberSize, size_t keyOffset);
+
 /**
  * @brief Performs a binary search on a sorted array.
  * @param key The key to search for.
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <DeepSea/Core/Config.h>
+#include <DeepSea/Core/Export.h>
+#include <DeepSea/Core/Streams/Types.h>
+#include <DeepSea/Core/Thread/Types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @file
+ * @brief Functions for reading files asynchronously.
+ *
+ * Requests are added in batches and read in the order they were added. The reads themselves use
+ * the blocking stream implementations, but are moved off of the calling thread so it isn't stalled
+ * waiting on IO.
+ *
+ * @see dsAsyncIO
+ */
+
+/**
+ * @brief Creates an asynchronous IO manager.
+ * @remark errno will be set on failure.
+ * @param allocator The allocator for the IO manager. This must support freeing memory.
+ * @param threadPool The thread pool to service requests with. If NULL, dedicated IO threads will be
+ *     created instead.
+ * @param threadCount The maximum number of requests to service at once. When threadPool is NULL,
+ *     this is the number of IO threads to create. A value of 0 will use a single thread when
+ *     threadPool is NULL or allow all threads of threadPool to service requests.
+ * @return The IO manager or NULL if it couldn't be created.
+ */
+DS_CORE_EXPORT dsAsyncIO* dsAsyncIO_create(dsAllocator* allocator, dsThreadPool* threadPool,
+	unsigned int threadCount);
+
+/**
+ * @brief Adds requests to read files.
+ *
+ * Either all requests will be added or none of them will be. Once added, the complete function will
+ * always be called for each request, even if the file couldn't be read.
+ *
+ * @remark This function is thread-safe.
+ * @remark errno will be set on failure.
+ * @param asyncIO The IO manager.
+ * @param requests The requests to add.
+ * @param requestCount The number of requests.
+ * @return False if the requests couldn't be added.
+ */
+DS_CORE_EXPORT bool dsAsyncIO_addRequests(dsAsyncIO* asyncIO, const dsAsyncIORequest* requests,
+	uint32_t requestCount);
+
+/**
+ * @brief Gets the number of requests that haven't finished being read yet.
+ * @remark This function is thread-safe.
+ * @param asyncIO The IO manager.
+ * @return The number of active requests.
+ */
+DS_CORE_EXPORT uint32_t dsAsyncIO_getActiveRequestCount(const dsAsyncIO* asyncIO);
+
+/**
+ * @brief Invokes the complete functions for the requests that finished on the current thread.
+ *
+ * This only applies to requests that weren't completed on the IO thread. This should typically be
+ * called once per frame on the main thread.
+ *
+ * @remark This function is thread-safe.
+ * @param asyncIO The IO manager.
+ * @return The number of complete functions that were invoked.
+ */
+DS_CORE_EXPORT uint32_t dsAsyncIO_processCompleted(dsAsyncIO* asyncIO);
+
+/**
+ * @brief Waits for all active requests to finish, then processes the completed requests.
+ * @remark errno will be set on failure.
+ * @param asyncIO The IO manager.
+ * @return False if asyncIO is invalid.
+ */
+DS_CORE_EXPORT bool dsAsyncIO_waitForRequests(dsAsyncIO* asyncIO);
+
+/**
+ * @brief Destroys an asynchronous IO manager.
+ *
+ * Requests that are currently being read will be waited on, while requests that haven't started
+ * will be completed with the error ECANCELED. Complete functions for any remaining requests will be
+ * invoked on the current thread.
+ *
+ * @param asyncIO The IO manager to destroy.
+ */
+DS_CORE_EXPORT void dsAsyncIO_destroy(dsAsyncIO* asyncIO);
+
+#ifdef __cplusplus
+}
+#endif
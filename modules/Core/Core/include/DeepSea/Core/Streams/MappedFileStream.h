@@ -0,0 +1,110 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <DeepSea/Core/Config.h>
+#include <DeepSea/Core/Export.h>
+#include <DeepSea/Core/Streams/Types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @file
+ * @brief Functions for operating on memory mapped file streams.
+ *
+ * Memory mapped file streams are read-only. The contents of the file may be accessed directly with
+ * dsStream_getBuffer(), which avoids copying the file into a separate buffer. Pages of the file
+ * are loaded on demand by the operating system.
+ *
+ * @see dsMappedFileStream
+ */
+
+/**
+ * @brief Opens a memory mapped file stream with a file path.
+ * @remark errno will be set on failure.
+ * @param stream The stream to open.
+ * @param path The file path to open.
+ * @return False if the file couldn't be opened or mapped.
+ */
+DS_CORE_EXPORT bool dsMappedFileStream_openPath(dsMappedFileStream* stream, const char* path);
+
+/**
+ * @brief Reads from a memory mapped file stream.
+ * @remark errno will be set on failure.
+ * @param stream The stream to read from.
+ * @param data The data pointer to hold the data that was read.
+ * @param size The number of bytes to read.
+ * @return The number of bytes read from the stream.
+ */
+DS_CORE_EXPORT size_t dsMappedFileStream_read(dsMappedFileStream* stream, void* data, size_t size);
+
+/**
+ * @brief Seeks in a memory mapped file stream.
+ * @remark errno will be set on failure.
+ * @param stream The stream to seek in.
+ * @param offset The offset from way.
+ * @param way The position in the stream to take the offset from.
+ * @return False if the seek was invalid.
+ */
+DS_CORE_EXPORT bool dsMappedFileStream_seek(dsMappedFileStream* stream, int64_t offset,
+	dsStreamSeekWay way);
+
+/**
+ * @brief Tells the current position in a memory mapped file stream.
+ * @remark errno will be set on failure.
+ * @param stream The stream to get the position from.
+ * @return The position in the stream, or DS_STREAM_INVALID_POS if the position cannot be
+ *     determined.
+ */
+DS_CORE_EXPORT uint64_t dsMappedFileStream_tell(dsMappedFileStream* stream);
+
+/**
+ * @brief Gets the remaining bytes in the stream at the current location.
+ * @remark errno will be set on failure.
+ * @param stream The stream to get the remaining bytes from.
+ * @return The remeaning bytes in the stream, or DS_STREAM_INVALID_POS if the position cannot be
+ *     determined.
+ */
+DS_CORE_EXPORT uint64_t dsMappedFileStream_remainingBytes(dsMappedFileStream* stream);
+
+/**
+ * @brief Gets direct access to the remaining data in a memory mapped file stream.
+ * @remark errno will be set on failure.
+ * @param stream The stream to access the data from.
+ * @param[out] outSize The number of bytes remaining in the stream.
+ * @return The pointer to the data at the current position, or NULL if the stream is invalid.
+ */
+DS_CORE_EXPORT const void* dsMappedFileStream_getBuffer(dsMappedFileStream* stream,
+	size_t* outSize);
+
+/**
+ * @brief Closes a memory mapped file stream.
+ *
+ * Any pointers from dsMappedFileStream_getBuffer() will no longer be valid.
+ *
+ * @remark errno will be set on failure.
+ * @param stream The stream to close.
+ * @return False if the stream cannot be closed.
+ */
+DS_CORE_EXPORT bool dsMappedFileStream_close(dsMappedFileStream* stream);
+
+#ifdef __cplusplus
+}
+#endif
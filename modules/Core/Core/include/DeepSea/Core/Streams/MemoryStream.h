@@ -1,5 +1,5 @@
 /*
- * Copyright 2016-2025 Aaron Barany
+ * Copyright 2016-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -88,6 +88,15 @@ DS_CORE_EXPORT uint64_t dsMemoryStream_tell(dsMemoryStream* stream);
  */
 DS_CORE_EXPORT uint64_t dsMemoryStream_remainingBytes(dsMemoryStream* stream);
 
+/**
+ * @brief Gets direct access to the remaining data in a memory stream.
+ * @remark errno will be set on failure.
+ * @param stream The stream to access the data from.
+ * @param[out] outSize The number of bytes remaining in the stream.
+ * @return The pointer to the data at the current position, or NULL if the stream is invalid.
+ */
+DS_CORE_EXPORT const void* dsMemoryStream_getBuffer(dsMemoryStream* stream, size_t* outSize);
+
 /**
  * @brief Closes a memory stream.
  * @remark errno will be set on failure.
@@ -1,5 +1,5 @@
 /*
- * Copyright 2016-2025 Aaron Barany
+ * Copyright 2016-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -119,6 +119,28 @@ DS_CORE_EXPORT inline bool dsStream_canGetRemainingBytes(dsStream* stream);
  */
 DS_CORE_EXPORT inline uint64_t dsStream_remainingBytes(dsStream* stream);
 
+/**
+ * @brief Checks whether the remaining data can be accessed directly from the stream.
+ * @param stream The stream to access the data from.
+ * @return True if dsStream_getBuffer() can be called.
+ */
+DS_CORE_EXPORT inline bool dsStream_canGetBuffer(dsStream* stream);
+
+/**
+ * @brief Gets direct access to the remaining data in the stream without copying.
+ *
+ * This is supported for streams that keep their data in memory, such as memory streams and memory
+ * mapped files. The position of the stream isn't changed. The returned pointer is only valid until
+ * the stream is closed.
+ *
+ * @remark errno will be set on failure.
+ * @param[out] outSize The number of bytes remaining in the stream.
+ * @param stream The stream to access the data from.
+ * @return The pointer to the data at the current position, or NULL if the data can't be accessed
+ *     directly.
+ */
+DS_CORE_EXPORT inline const void* dsStream_getBuffer(size_t* outSize, dsStream* stream);
+
 /**
  * @brief Skips bytes in a stream.
  *
@@ -237,6 +259,22 @@ inline uint64_t dsStream_remainingBytes(dsStream* stream)
 	return end - position;
 }
 
+inline bool dsStream_canGetBuffer(dsStream* stream)
+{
+	return stream && stream->getBufferFunc;
+}
+
+inline const void* dsStream_getBuffer(size_t* outSize, dsStream* stream)
+{
+	if (!outSize || !stream || !stream->getBufferFunc)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	return stream->getBufferFunc(stream, outSize);
+}
+
 inline void dsStream_flush(dsStream* stream)
 {
 	if (!stream || !stream->flushFunc)
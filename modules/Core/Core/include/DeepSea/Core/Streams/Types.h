@@ -160,6 +160,14 @@ typedef bool (*dsStreamSeekFunction)(dsStream* stream, int64_t offset, dsStreamS
  */
 typedef uint64_t (*dsStreamTellFunction)(dsStream* stream);
 
+/**
+ * @brief Function for getting direct access to the remaining data in a stream.
+ * @param stream The stream to get the data from.
+ * @param[out] outSize The number of bytes remaining in the stream.
+ * @return The pointer to the data at the current position, or NULL if it couldn't be accessed.
+ */
+typedef const void* (*dsStreamGetBufferFunction)(dsStream* stream, size_t* outSize);
+
 /**
  * @brief Function for restarting a stream to the start.
  * @param stream The stream to restart.
@@ -250,6 +258,13 @@ struct dsStream
 	 */
 	dsStreamTellFunction remainingBytesFunc;
 
+	/**
+	 * @brief Function to get direct access to the remaining data in the stream.
+	 *
+	 * This may be NULL if the stream doesn't hold its data in memory.
+	 */
+	dsStreamGetBufferFunction getBufferFunc;
+
 	/**
 	 * @brief The restart function.
 	 *
@@ -293,6 +308,44 @@ typedef struct dsFileStream
 	FILE* file;
 } dsFileStream;
 
+/**
+ * @brief Structure that defines a stream for a memory mapped file.
+ *
+ * This is effectively a subclass of dsStream and a pointer to dsMappedFileStream can be freely
+ * cast between the two types.
+ *
+ * @see MappedFileStream.h
+ */
+typedef struct dsMappedFileStream
+{
+	/**
+	 * @brief The base stream.
+	 */
+	dsStream stream;
+
+	/**
+	 * @brief The mapped data for the file.
+	 */
+	const void* data;
+
+	/**
+	 * @brief The size of the file.
+	 */
+	size_t size;
+
+	/**
+	 * @brief The current position in the file.
+	 */
+	size_t position;
+
+	/**
+	 * @brief Platform handle for the mapping.
+	 *
+	 * This is only used on platforms that require a separate handle to unmap the file.
+	 */
+	void* mappingHandle;
+} dsMappedFileStream;
+
 /**
  * @brief Structure that defines a memory stream.
  *
@@ -562,6 +615,142 @@ typedef struct dsArchiveRelativePath
 	const dsFileArchive* archive;
 } dsArchiveRelativePath;
 
+/**
+ * @brief Enum for where to read a file from for asynchronous IO.
+ * @see AsyncIO.h
+ */
+typedef enum dsAsyncIOSource
+{
+	dsAsyncIOSource_File,     ///< Path on the filesystem.
+	dsAsyncIOSource_Resource, ///< Resource path.
+	dsAsyncIOSource_Archive   ///< Path within a file archive.
+} dsAsyncIOSource;
+
+/**
+ * @brief Struct describing a manager for asynchronous IO requests.
+ *
+ * Requests are serviced either on dedicated IO threads or on a dsThreadPool. Completion callbacks
+ * may either be invoked directly on the thread that serviced the request or be queued to be
+ * invoked on the thread that calls dsAsyncIO_processCompleted().
+ *
+ * @see AsyncIO.h
+ */
+typedef struct dsAsyncIO dsAsyncIO;
+
+/**
+ * @brief Struct describing a file to read asynchronously.
+ * @see AsyncIO.h
+ */
+typedef struct dsAsyncIOFile
+{
+	/**
+	 * @brief Where to read the file from.
+	 */
+	dsAsyncIOSource source;
+
+	/**
+	 * @brief The resource type when source is dsAsyncIOSource_Resource.
+	 */
+	dsFileResourceType resourceType;
+
+	/**
+	 * @brief The archive when source is dsAsyncIOSource_Archive.
+	 *
+	 * This must remain alive until the request completes.
+	 */
+	const dsFileArchive* archive;
+
+	/**
+	 * @brief The path to the file.
+	 *
+	 * This will be copied when the request is added.
+	 */
+	const char* path;
+} dsAsyncIOFile;
+
+/// @cond Doxygen_Suppress
+typedef struct dsAsyncIORequest dsAsyncIORequest;
+/// @endcond
+
+/**
+ * @brief Function called when an asynchronous IO request completes.
+ * @param userData The user data for the request.
+ * @param request The request that completed. The path is a copy that is only valid for the
+ *     duration of the call.
+ * @param data The data that was read, or NULL if the read failed. If the request didn't provide a
+ *     buffer, this was allocated with the request's allocator and ownership is passed to the
+ *     function.
+ * @param size The number of bytes that were read.
+ * @param errorCode The errno value if the read failed, or 0 if it succeeded.
+ */
+typedef void (*dsAsyncIOCompleteFunction)(void* userData, const dsAsyncIORequest* request,
+	void* data, size_t size, int errorCode);
+
+/**
+ * @brief Function called when an object has been loaded asynchronously.
+ * @param userData The user data provided when loading.
+ * @param object The object that was loaded, or NULL if it couldn't be loaded. Ownership is passed
+ *     to the function.
+ * @param errorCode The errno value if the object couldn't be loaded, or 0 if it was loaded.
+ */
+typedef void (*dsAsyncLoadCompleteFunction)(void* userData, void* object, int errorCode);
+
+/**
+ * @brief Struct describing a request to read a file asynchronously.
+ * @see AsyncIO.h
+ */
+struct dsAsyncIORequest
+{
+	/**
+	 * @brief The file to read from.
+	 */
+	dsAsyncIOFile file;
+
+	/**
+	 * @brief The offset in bytes to start reading from.
+	 */
+	uint64_t offset;
+
+	/**
+	 * @brief The number of bytes to read.
+	 *
+	 * If 0, the remainder of the file after offset will be read. This may be less if the end of
+	 * the file is reached.
+	 */
+	size_t size;
+
+	/**
+	 * @brief The buffer to read into.
+	 *
+	 * If NULL, a buffer will be allocated with allocator. Otherwise size must be non-zero and the
+	 * buffer must remain alive until the request completes.
+	 */
+	void* buffer;
+
+	/**
+	 * @brief The allocator to create the buffer with when buffer is NULL.
+	 *
+	 * This must support freeing memory.
+	 */
+	dsAllocator* allocator;
+
+	/**
+	 * @brief The function to call when the request completes.
+	 */
+	dsAsyncIOCompleteFunction completeFunc;
+
+	/**
+	 * @brief User data to pass to completeFunc.
+	 */
+	void* userData;
+
+	/**
+	 * @brief Whether to invoke completeFunc on the IO thread rather than queuing it for
+	 *     dsAsyncIO_processCompleted().
+	 */
+	bool completeOnIOThread;
+};
+
 #ifdef __cplusplus
 }
 #endif
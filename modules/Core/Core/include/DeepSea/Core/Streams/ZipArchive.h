@@ -1,5 +1,5 @@
 /*
- * Copyright 2025 Aaron Barany
+ * Copyright 2025-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -19,6 +19,7 @@
 #include <DeepSea/Core/Config.h>
 #include <DeepSea/Core/Export.h>
 #include <DeepSea/Core/Streams/Types.h>
+#include <DeepSea/Core/Thread/Types.h>
 
 #if DS_ZIP_ARCHIVE_ENABLED
 
@@ -124,6 +125,56 @@ DS_CORE_EXPORT bool dsZipArchive_closeDirectory(
  */
 DS_CORE_EXPORT dsStream* dsZipArchive_openFile(const dsZipArchive* archive, const char* path);
 
+/**
+ * @brief Gets the maximum size of the cache for decompressed files.
+ * @param archive The archive.
+ * @return The maximum size of the cache in bytes, or 0 if caching is disabled.
+ */
+DS_CORE_EXPORT size_t dsZipArchive_getMaxCacheSize(const dsZipArchive* archive);
+
+/**
+ * @brief Sets the maximum size of the cache for decompressed files.
+ *
+ * When the cache is enabled, compressed files that fit within the cache will be fully decompressed
+ * when first opened and kept in memory for later opens. The least recently used files will be
+ * evicted once the cache size is exceeded. Files that are currently open will be kept alive until
+ * they are closed, but will no longer count towards the size of the cache.
+ *
+ * This is thread-safe with opening files, but shouldn't be called concurrently with itself.
+ *
+ * @remark errno will be set on failure.
+ * @param archive The archive.
+ * @param maxCacheSize The maximum size of the cache in bytes. Set to 0 to disable caching, which is
+ *     the default.
+ * @return False if the parameters are invalid.
+ */
+DS_CORE_EXPORT bool dsZipArchive_setMaxCacheSize(dsZipArchive* archive, size_t maxCacheSize);
+
+/**
+ * @brief Gets the number of bytes of decompressed data that are currently cached.
+ * @param archive The archive.
+ * @return The size of the cached data.
+ */
+DS_CORE_EXPORT size_t dsZipArchive_getCacheSize(const dsZipArchive* archive);
+
+/**
+ * @brief Decompresses files into the cache ahead of time.
+ *
+ * Files that are uncompressed, already cached, or too large to fit in the cache will be skipped.
+ * The cache must be enabled with dsZipArchive_setMaxCacheSize() to prefetch files.
+ *
+ * @remark errno will be set on failure.
+ * @param archive The archive to prefetch the files from.
+ * @param paths The paths to the files to prefetch.
+ * @param pathCount The number of paths.
+ * @param threadPool The thread pool to decompress the files in parallel. If NULL, the files will be
+ *     decompressed on the current thread.
+ * @return False if a file couldn't be found or decompressed. Any files that could be decompressed
+ *     will still be added to the cache.
+ */
+DS_CORE_EXPORT bool dsZipArchive_prefetch(const dsZipArchive* archive, const char* const* paths,
+	uint32_t pathCount, dsThreadPool* threadPool);
+
 /**
  * @brief Closes a zip archive.
  *
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <DeepSea/Core/Config.h>
+#include <DeepSea/Core/Thread/Types.h>
+#include <DeepSea/Core/Export.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @file
+ * @brief Functions to create and manipulate a task graph.
+ *
+ * Tasks are identified by their index, which is assigned in the order they are added. A task may
+ * only depend on tasks that were added before it, which guarantees that the graph has no cycles.
+ *
+ * When a task finishes, one of its successors that is ready to execute will be run directly on the
+ * same thread as a continuation, while the rest are queued on the thread pool. This avoids the
+ * round-trip through the task queue for chains of dependent tasks.
+ *
+ * @remark Functions to build the graph are not thread-safe, and the graph may not be modified
+ *     while it's executing.
+ * @see dsTaskGraph
+ */
+
+/**
+ * @brief Constant for an invalid task index.
+ */
+#define DS_TASK_GRAPH_INVALID_TASK ((uint32_t)-1)
+
+/**
+ * @brief Creates a task graph.
+ * @remark errno will be set on failure.
+ * @param allocator The allocator for the task graph. This must support freeing memory.
+ * @param threadPool The thread pool to execute the tasks on. This must be alive at least as long as
+ *     the task graph.
+ * @param maxTasks The maximum number of tasks that can be queued at once. This isn't a hard limit,
+ *     but may cause tasks to be executed on the thread that queued them if it is exceeded.
+ * @param maxConcurrency The maximum number of tasks to run in parallel. If 0 all threads on the
+ *     thread pool may run tasks from this graph.
+ * @return The task graph or NULL if it couldn't be created.
+ */
+DS_CORE_EXPORT dsTaskGraph* dsTaskGraph_create(dsAllocator* allocator, dsThreadPool* threadPool,
+	uint32_t maxTasks, uint32_t maxConcurrency);
+
+/**
+ * @brief Gets the number of tasks in a task graph.
+ * @param graph The task graph.
+ * @return The number of tasks.
+ */
+DS_CORE_EXPORT uint32_t dsTaskGraph_getTaskCount(const dsTaskGraph* graph);
+
+/**
+ * @brief Adds a task to the task graph.
+ * @remark errno will be set on failure.
+ * @param graph The task graph.
+ * @param task The task to execute. This may be NULL to add a task that only waits for its
+ *     predecessors, which can be used as a single point for other tasks to depend on.
+ * @param predecessors The indices of the tasks that must finish before this task is executed. All
+ *     indices must be for tasks previously added to the graph.
+ * @param predecessorCount The number of predecessors.
+ * @return The index of the task or DS_TASK_GRAPH_INVALID_TASK if it couldn't be added.
+ */
+DS_CORE_EXPORT uint32_t dsTaskGraph_addTask(dsTaskGraph* graph, const dsThreadTask* task,
+	const uint32_t* predecessors, uint32_t predecessorCount);
+
+/**
+ * @brief Adds a dependency between two tasks.
+ * @remark errno will be set on failure.
+ * @param graph The task graph.
+ * @param task The index of the task that will wait on the predecessor.
+ * @param predecessor The index of the task that must finish first. This must be less than task.
+ * @return False if the dependency couldn't be added.
+ */
+DS_CORE_EXPORT bool dsTaskGraph_addDependency(dsTaskGraph* graph, uint32_t task,
+	uint32_t predecessor);
+
+/**
+ * @brief Removes all tasks from the task graph.
+ * @remark errno will be set on failure.
+ * @param graph The task graph.
+ * @return False if the graph couldn't be cleared.
+ */
+DS_CORE_EXPORT bool dsTaskGraph_clear(dsTaskGraph* graph);
+
+/**
+ * @brief Starts executing the tasks in the task graph.
+ *
+ * All tasks that don't have any predecessors will be queued immediately. The graph may be executed
+ * again after dsTaskGraph_wait() is called.
+ *
+ * @remark errno will be set on failure.
+ * @param graph The task graph.
+ * @return False if the graph couldn't be started.
+ */
+DS_CORE_EXPORT bool dsTaskGraph_start(dsTaskGraph* graph);
+
+/**
+ * @brief Waits for all tasks in the task graph to finish.
+ *
+ * This will also process tasks on the current thread while waiting.
+ *
+ * @remark This must not be called within a task of the same graph, otherwise a deadlock will
+ *     occur.
+ * @remark errno will be set on failure.
+ * @param graph The task graph.
+ * @return False if the graph couldn't be waited on.
+ */
+DS_CORE_EXPORT bool dsTaskGraph_wait(dsTaskGraph* graph);
+
+/**
+ * @brief Executes the tasks in the task graph and waits for them to finish.
+ *
+ * This is equivalent to calling dsTaskGraph_start() followed by dsTaskGraph_wait().
+ *
+ * @remark errno will be set on failure.
+ * @param graph The task graph.
+ * @return False if the graph couldn't be executed.
+ */
+DS_CORE_EXPORT bool dsTaskGraph_execute(dsTaskGraph* graph);
+
+/**
+ * @brief Destroys a task graph.
+ *
+ * This will implicitly wait for any remaining tasks to finish executing.
+ *
+ * @param graph The task graph to destroy.
+ */
+DS_CORE_EXPORT void dsTaskGraph_destroy(dsTaskGraph* graph);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright 2023 Aaron Barany
+ * Copyright 2023-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -73,6 +73,7 @@ DS_CORE_EXPORT unsigned int dsThreadPool_defaultThreadCount(void);
  *     valid for task queues to perform their work serially in dsThreadTaskQueue_waitForTasks().
  *     Pass dsThreadPool_defaultThreadCount() for a default value based on the number of logical
  *     cores.
+ * @param flags Flags to control the behavior of the thread pool.
  * @param stackSize The size of the stack of each thread in bytes. Set to 0 for the system default.
  * @param startThreadFunc Function to call when a worker thread starts to set up any per-thread
  *     resources. May be NULL if no setup is needed.
@@ -82,8 +83,15 @@ DS_CORE_EXPORT unsigned int dsThreadPool_defaultThreadCount(void);
  * @return The thread pool or NULL if it couldn't be created.
  */
 DS_CORE_EXPORT dsThreadPool* dsThreadPool_create(dsAllocator* allocator, unsigned int threadCount,
-	size_t stackSize, dsThreadTaskFunction startThreadFunc, dsThreadTaskFunction endThreadFunc,
-	void* startEndThreadUserData);
+	dsThreadPoolFlags flags, size_t stackSize, dsThreadTaskFunction startThreadFunc,
+	dsThreadTaskFunction endThreadFunc, void* startEndThreadUserData);
+
+/**
+ * @brief Gets the flags for a thread pool.
+ * @param threadPool The thread pool.
+ * @return The flags the thread pool was created with.
+ */
+DS_CORE_EXPORT dsThreadPoolFlags dsThreadPool_getFlags(const dsThreadPool* threadPool);
 
 /**
  * @brief Gets the number of threads for a thread pool.
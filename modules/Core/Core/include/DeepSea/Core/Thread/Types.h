@@ -1,5 +1,5 @@
 /*
- * Copyright 2016-2024 Aaron Barany
+ * Copyright 2016-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -210,6 +210,22 @@ typedef struct dsThreadStorage
  */
 typedef struct dsThreadObjectStorage dsThreadObjectStorage;
 
+/**
+ * @brief Enum for flags that control the behavior of a thread pool.
+ * @see ThreadPool.h
+ */
+typedef enum dsThreadPoolFlags
+{
+	dsThreadPoolFlags_None = 0x0, ///< No special behavior.
+	/**
+	 * Use per-thread task deques with work stealing rather than a single shared task list. This
+	 * avoids locking a single mutex for every task that's executed, reducing contention with many
+	 * threads and small tasks. Tasks are no longer guaranteed to be executed in a round-robin order
+	 * between task queues.
+	 */
+	dsThreadPoolFlags_WorkStealing = 0x1
+} dsThreadPoolFlags;
+
 /**
  * @brief Structure that manages threads to processes tasks held on task queues.
  *
@@ -260,6 +276,20 @@ typedef struct dsThreadTask
  */
 typedef struct dsThreadTaskQueue dsThreadTaskQueue;
 
+/**
+ * @brief Struct describing a graph of tasks with dependencies between them.
+ *
+ * Each task in the graph keeps a counter for the number of predecessors that haven't finished
+ * yet. Once a task finishes, the counter is decremented for each of its successors, and any that
+ * reach 0 are executed. This allows independent chains of work to overlap rather than waiting for
+ * a full barrier between each step.
+ *
+ * Building the graph isn't thread-safe, but it may be executed any number of times once built.
+ *
+ * @see TaskGraph.h
+ */
+typedef struct dsTaskGraph dsTaskGraph;
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <DeepSea/Core/Config.h>
+#include <DeepSea/Core/Export.h>
+#include <DeepSea/Core/Streams/Types.h>
+#include <DeepSea/Core/Types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @file
+ * @brief Functions for the built-in trace profiler.
+ *
+ * The trace profiler hooks up the DeepSea profiling functions without any external dependencies.
+ * Each thread records events into its own fixed-size ring buffer without taking any locks, so the
+ * overhead and memory usage are bounded and it's suitable to leave running. Once a buffer is full,
+ * the oldest events are overwritten.
+ *
+ * The recorded events may be written in the Chrome trace event JSON format at any time, which can
+ * be viewed with chrome://tracing or https://ui.perfetto.dev.
+ */
+
+/**
+ * @brief The default number of events to keep for each thread.
+ */
+#define DS_DEFAULT_TRACE_PROFILER_EVENTS 65536
+
+/**
+ * @brief The default maximum number of threads that may record events.
+ */
+#define DS_DEFAULT_TRACE_PROFILER_MAX_THREADS 64
+
+/**
+ * @brief Starts profiling with the trace profiler.
+ * @remark errno will be set on failure.
+ * @param allocator The allocator for the profiler data. This must support freeing memory.
+ * @param eventsPerThread The number of events to keep for each thread. This will be rounded up to a
+ *     power of two. If 0, DS_DEFAULT_TRACE_PROFILER_EVENTS will be used.
+ * @param maxThreads The maximum number of threads that may record events. Events from further
+ *     threads will be ignored. If 0, DS_DEFAULT_TRACE_PROFILER_MAX_THREADS will be used.
+ * @param maxFrames The maximum number of frames to write out. Events before the start of the
+ *     oldest of the most recent maxFrames frames will be omitted. If 0, all events that remain in
+ *     the buffers will be written.
+ * @return False if the profiler couldn't be started.
+ */
+DS_CORE_EXPORT bool dsTraceProfiler_start(dsAllocator* allocator, uint32_t eventsPerThread,
+	uint32_t maxThreads, uint32_t maxFrames);
+
+/**
+ * @brief Gets whether or not the trace profiler is currently started.
+ * @return True if the trace profiler is started.
+ */
+DS_CORE_EXPORT bool dsTraceProfiler_isStarted(void);
+
+/**
+ * @brief Writes the recorded events in the Chrome trace event JSON format.
+ *
+ * This may be called while other threads are recording events. Events that are overwritten while
+ * writing will be omitted.
+ *
+ * @remark errno will be set on failure.
+ * @param stream The stream to write to.
+ * @return False if the events couldn't be written.
+ */
+DS_CORE_EXPORT bool dsTraceProfiler_writeJSON(dsStream* stream);
+
+/**
+ * @brief Writes the recorded events in the Chrome trace event JSON format to a file.
+ * @remark errno will be set on failure.
+ * @param filePath The path to the file to write.
+ * @return False if the events couldn't be written.
+ */
+DS_CORE_EXPORT bool dsTraceProfiler_writeJSONFile(const char* filePath);
+
+/**
+ * @brief Stops profiling with the trace profiler.
+ *
+ * No other threads may be recording profile events when this is called.
+ *
+ * @remark errno will be set on failure.
+ * @return False if the trace profiler wasn't started.
+ */
+DS_CORE_EXPORT bool dsTraceProfiler_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -101,6 +101,16 @@ typedef int (*dsSortCompareFunction)(const void* left, const void* right, void*
 typedef void (*dsLogFunction)(void* userData, dsLogLevel level, const char* tag,
 	const char* file, unsigned int line, const char* function, const char* message);
 
+/**
+ * @brief Struct describing an asynchronous log sink.
+ *
+ * Messages are queued on per-thread buffers and sent to the output function on a background
+ * thread.
+ *
+ * @see AsyncLog.h
+ */
+typedef struct dsAsyncLog dsAsyncLog;
+
 /**
  * @brief Type for a function registering a thread name.
  * @param userData The user data for profiling functions.
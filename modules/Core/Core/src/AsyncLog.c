@@ -0,0 +1,467 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <DeepSea/Core/AsyncLog.h>
+
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Thread/ConditionVariable.h>
+#include <DeepSea/Core/Thread/Mutex.h>
+#include <DeepSea/Core/Thread/Thread.h>
+#include <DeepSea/Core/Thread/ThreadStorage.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Atomic.h>
+#include <DeepSea/Core/Bits.h>
+#include <DeepSea/Core/Error.h>
+#include <DeepSea/Core/Log.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#define PADDING_RECORD ((uint32_t)-1)
+#define RECORD_ALIGNMENT 8
+#define MIN_BUFFER_SIZE 1024
+#define MAX_BUFFER_SIZE 0x40000000
+
+// Records are written contiguously in the ring buffer, with the strings following the header.
+// Positions increase monotonically and wrap naturally since the buffer size is a power of two.
+typedef struct LogRecord
+{
+	uint32_t size;
+	uint32_t level;
+	uint32_t line;
+	uint32_t tagLength;
+	uint32_t fileLength;
+	uint32_t functionLength;
+	uint32_t messageLength;
+	uint32_t padding;
+} LogRecord;
+
+typedef struct ThreadBuffer
+{
+	uint8_t* data;
+	uint32_t writePos;
+	uint32_t readPos;
+	uint32_t droppedCount;
+	uint32_t reportedDroppedCount;
+} ThreadBuffer;
+
+struct dsAsyncLog
+{
+	dsAllocator* allocator;
+	dsLogFunction outputFunc;
+	void* outputUserData;
+
+	uint32_t bufferSize;
+	uint32_t maxThreads;
+	uint32_t bufferCount;
+	ThreadBuffer** buffers;
+	dsThreadStorage threadBuffer;
+
+	// Guards registering new thread buffers.
+	dsMutex* registerMutex;
+	// Guards reading from the thread buffers and calling the output function.
+	dsMutex* outputMutex;
+	// Guards waiting on the condition for the log thread.
+	dsMutex* waitMutex;
+	dsConditionVariable* condition;
+
+	dsThread thread;
+	bool threadStarted;
+	uint32_t waiting;
+	bool stop;
+};
+
+static void outputMessage(dsAsyncLog* asyncLog, dsLogLevel level, const char* tag,
+	const char* file, unsigned int line, const char* function, const char* message)
+{
+	if (asyncLog->outputFunc)
+	{
+		asyncLog->outputFunc(asyncLog->outputUserData, level, tag, file, line, function,
+			message);
+	}
+	else
+		dsLog_defaultPrint(level, tag, file, line, function, message);
+}
+
+static void drainBuffer(dsAsyncLog* asyncLog, ThreadBuffer* buffer)
+{
+	// Load the dropped count before the write position so every message queued before the drops
+	// is output ahead of the report.
+	uint32_t droppedCount;
+	DS_ATOMIC_LOAD32(&buffer->droppedCount, &droppedCount);
+
+	uint32_t mask = asyncLog->bufferSize - 1;
+	uint32_t readPos = buffer->readPos;
+	uint32_t writePos;
+	DS_ATOMIC_LOAD32(&buffer->writePos, &writePos);
+	while (readPos != writePos)
+	{
+		const LogRecord* record = (const LogRecord*)(buffer->data + (readPos & mask));
+		if (record->level != PADDING_RECORD)
+		{
+			const char* tag = (const char*)(record + 1);
+			const char* file = tag + record->tagLength;
+			const char* function = file + record->fileLength;
+			const char* message = function + record->functionLength;
+			outputMessage(asyncLog, (dsLogLevel)record->level, tag, file, record->line, function,
+				message);
+		}
+
+		readPos += record->size;
+	}
+
+	// Release the space back to the writer only after the records have been output.
+	DS_ATOMIC_STORE32(&buffer->readPos, &readPos);
+
+	if (droppedCount != buffer->reportedDroppedCount)
+	{
+		char message[64];
+		snprintf(message, sizeof(message), "Dropped %u log messages due to a full buffer.",
+			droppedCount - buffer->reportedDroppedCount);
+		outputMessage(asyncLog, dsLogLevel_Warning, DS_CORE_LOG_TAG, __FILE__, __LINE__,
+			__FUNCTION__, message);
+		buffer->reportedDroppedCount = droppedCount;
+	}
+}
+
+static void drainBuffersLocked(dsAsyncLog* asyncLog)
+{
+	uint32_t bufferCount;
+	DS_ATOMIC_LOAD32(&asyncLog->bufferCount, &bufferCount);
+	for (uint32_t i = 0; i < bufferCount; ++i)
+		drainBuffer(asyncLog, asyncLog->buffers[i]);
+}
+
+static bool hasQueuedMessages(dsAsyncLog* asyncLog)
+{
+	uint32_t bufferCount;
+	DS_ATOMIC_LOAD32(&asyncLog->bufferCount, &bufferCount);
+	for (uint32_t i = 0; i < bufferCount; ++i)
+	{
+		ThreadBuffer* buffer = asyncLog->buffers[i];
+		uint32_t readPos, writePos;
+		DS_ATOMIC_LOAD32(&buffer->readPos, &readPos);
+		DS_ATOMIC_LOAD32(&buffer->writePos, &writePos);
+		if (readPos != writePos)
+			return true;
+	}
+
+	return false;
+}
+
+static dsThreadReturnType logThreadFunc(void* userData)
+{
+	dsAsyncLog* asyncLog = (dsAsyncLog*)userData;
+	while (true)
+	{
+		DS_VERIFY(dsMutex_lock(asyncLog->outputMutex));
+		drainBuffersLocked(asyncLog);
+		DS_VERIFY(dsMutex_unlock(asyncLog->outputMutex));
+
+		DS_VERIFY(dsMutex_lock(asyncLog->waitMutex));
+		if (asyncLog->stop)
+		{
+			DS_VERIFY(dsMutex_unlock(asyncLog->waitMutex));
+			break;
+		}
+
+		// Writers only notify when this is set, which avoids a system call for every message while
+		// the log thread is busy.
+		uint32_t waiting = true;
+		DS_ATOMIC_STORE32(&asyncLog->waiting, &waiting);
+		if (!hasQueuedMessages(asyncLog))
+			dsConditionVariable_wait(asyncLog->condition, asyncLog->waitMutex);
+		waiting = false;
+		DS_ATOMIC_STORE32(&asyncLog->waiting, &waiting);
+		DS_VERIFY(dsMutex_unlock(asyncLog->waitMutex));
+	}
+
+	return 0;
+}
+
+static ThreadBuffer* getThreadBuffer(dsAsyncLog* asyncLog)
+{
+	ThreadBuffer* buffer = (ThreadBuffer*)dsThreadStorage_get(asyncLog->threadBuffer);
+	if (buffer)
+		return buffer;
+
+	DS_VERIFY(dsMutex_lock(asyncLog->registerMutex));
+	uint32_t bufferCount = asyncLog->bufferCount;
+	if (bufferCount < asyncLog->maxThreads)
+	{
+		buffer = (ThreadBuffer*)dsAllocator_alloc(asyncLog->allocator,
+			DS_ALIGNED_SIZE(sizeof(ThreadBuffer), DS_ALLOC_ALIGNMENT) + asyncLog->bufferSize);
+		if (buffer)
+		{
+			memset(buffer, 0, sizeof(ThreadBuffer));
+			buffer->data = (uint8_t*)buffer +
+				DS_ALIGNED_SIZE(sizeof(ThreadBuffer), DS_ALLOC_ALIGNMENT);
+
+			// Publish the buffer before the count so the log thread never sees a NULL buffer.
+			asyncLog->buffers[bufferCount] = buffer;
+			++bufferCount;
+			DS_ATOMIC_STORE32(&asyncLog->bufferCount, &bufferCount);
+			dsThreadStorage_set(asyncLog->threadBuffer, buffer);
+		}
+	}
+	DS_VERIFY(dsMutex_unlock(asyncLog->registerMutex));
+	return buffer;
+}
+
+static void notifyLogThread(dsAsyncLog* asyncLog)
+{
+	uint32_t notWaiting = false;
+	uint32_t waiting;
+	DS_ATOMIC_EXCHANGE32(&asyncLog->waiting, &notWaiting, &waiting);
+	if (!waiting)
+		return;
+
+	DS_VERIFY(dsMutex_lock(asyncLog->waitMutex));
+	DS_VERIFY(dsConditionVariable_notifyAll(asyncLog->condition));
+	DS_VERIFY(dsMutex_unlock(asyncLog->waitMutex));
+}
+
+static void outputSynchronous(dsAsyncLog* asyncLog, dsLogLevel level, const char* tag,
+	const char* file, unsigned int line, const char* function, const char* message)
+{
+	// Output any queued messages first to preserve ordering.
+	DS_VERIFY(dsMutex_lock(asyncLog->outputMutex));
+	drainBuffersLocked(asyncLog);
+	outputMessage(asyncLog, level, tag, file, line, function, message);
+	DS_VERIFY(dsMutex_unlock(asyncLog->outputMutex));
+}
+
+dsAsyncLog* dsAsyncLog_create(dsAllocator* allocator, size_t threadBufferSize,
+	uint32_t maxThreads, dsLogFunction outputFunc, void* outputUserData)
+{
+	if (!allocator || threadBufferSize > MAX_BUFFER_SIZE)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (!allocator->freeFunc)
+	{
+		errno = EINVAL;
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Async log allocator must support freeing memory.");
+		return NULL;
+	}
+
+	if (threadBufferSize == 0)
+		threadBufferSize = DS_DEFAULT_ASYNC_LOG_BUFFER_SIZE;
+	else if (threadBufferSize < MIN_BUFFER_SIZE)
+		threadBufferSize = MIN_BUFFER_SIZE;
+	if (maxThreads == 0)
+		maxThreads = DS_DEFAULT_ASYNC_LOG_MAX_THREADS;
+
+	dsAsyncLog* asyncLog = DS_ALLOCATE_OBJECT(allocator, dsAsyncLog);
+	if (!asyncLog)
+		return NULL;
+
+	memset(asyncLog, 0, sizeof(dsAsyncLog));
+	asyncLog->allocator = dsAllocator_keepPointer(allocator);
+	asyncLog->outputFunc = outputFunc;
+	asyncLog->outputUserData = outputUserData;
+	asyncLog->bufferSize = (uint32_t)threadBufferSize;
+	if (!DS_IS_POWER_OF_2(asyncLog->bufferSize))
+		asyncLog->bufferSize = 1U << (32 - dsClz(asyncLog->bufferSize));
+	asyncLog->maxThreads = maxThreads;
+
+	asyncLog->buffers = DS_ALLOCATE_OBJECT_ARRAY(allocator, ThreadBuffer*, maxThreads);
+	if (!asyncLog->buffers || !dsThreadStorage_initialize(&asyncLog->threadBuffer))
+	{
+		DS_VERIFY(dsAllocator_free(allocator, asyncLog->buffers));
+		DS_VERIFY(dsAllocator_free(allocator, asyncLog));
+		return NULL;
+	}
+
+	asyncLog->registerMutex = dsMutex_create(allocator, "Async log register");
+	asyncLog->outputMutex = dsMutex_create(allocator, "Async log output");
+	asyncLog->waitMutex = dsMutex_create(allocator, "Async log wait");
+	asyncLog->condition = dsConditionVariable_create(allocator, "Async log");
+	if (!asyncLog->registerMutex || !asyncLog->outputMutex || !asyncLog->waitMutex ||
+		!asyncLog->condition)
+	{
+		dsAsyncLog_destroy(asyncLog);
+		return NULL;
+	}
+
+	if (!dsThread_create(&asyncLog->thread, &logThreadFunc, asyncLog, 0, "Async Log"))
+	{
+		dsAsyncLog_destroy(asyncLog);
+		return NULL;
+	}
+	asyncLog->threadStarted = true;
+
+	return asyncLog;
+}
+
+void dsAsyncLog_log(void* asyncLog, dsLogLevel level, const char* tag, const char* file,
+	unsigned int line, const char* function, const char* message)
+{
+	dsAsyncLog* log = (dsAsyncLog*)asyncLog;
+	if (!log)
+		return;
+
+	// Avoid queuing messages that will be thrown away.
+	if (!log->outputFunc)
+	{
+#if DS_DEBUG
+		if (level < dsLogLevel_Debug)
+			return;
+#else
+		if (level < dsLogLevel_Info)
+			return;
+#endif
+	}
+
+	if (!tag)
+		tag = "";
+	if (!file)
+		file = "";
+	if (!function)
+		function = "";
+	if (!message)
+		message = "";
+
+	if (level >= dsLogLevel_Error)
+	{
+		outputSynchronous(log, level, tag, file, line, function, message);
+		return;
+	}
+
+	size_t tagLength = strlen(tag) + 1;
+	size_t fileLength = strlen(file) + 1;
+	size_t functionLength = strlen(function) + 1;
+	size_t messageLength = strlen(message) + 1;
+	size_t recordSize = DS_ALIGNED_SIZE(sizeof(LogRecord) + tagLength + fileLength +
+		functionLength + messageLength, RECORD_ALIGNMENT);
+
+	ThreadBuffer* buffer = getThreadBuffer(log);
+	if (!buffer || recordSize > log->bufferSize)
+	{
+		outputSynchronous(log, level, tag, file, line, function, message);
+		return;
+	}
+
+	// Only this thread writes to the buffer, so only the read position needs to be synchronized.
+	uint32_t mask = log->bufferSize - 1;
+	uint32_t writePos = buffer->writePos;
+	uint32_t readPos;
+	DS_ATOMIC_LOAD32(&buffer->readPos, &readPos);
+	uint32_t freeSize = log->bufferSize - (writePos - readPos);
+	uint32_t contiguousSize = log->bufferSize - (writePos & mask);
+	uint32_t paddingSize = contiguousSize < recordSize ? contiguousSize : 0;
+	if (paddingSize + recordSize > freeSize)
+	{
+		DS_ATOMIC_FETCH_ADD32(&buffer->droppedCount, 1);
+		return;
+	}
+
+	if (paddingSize > 0)
+	{
+		LogRecord* padding = (LogRecord*)(buffer->data + (writePos & mask));
+		padding->size = paddingSize;
+		padding->level = PADDING_RECORD;
+		writePos += paddingSize;
+	}
+
+	LogRecord* record = (LogRecord*)(buffer->data + (writePos & mask));
+	record->size = (uint32_t)recordSize;
+	record->level = level;
+	record->line = line;
+	record->tagLength = (uint32_t)tagLength;
+	record->fileLength = (uint32_t)fileLength;
+	record->functionLength = (uint32_t)functionLength;
+	record->messageLength = (uint32_t)messageLength;
+
+	char* strings = (char*)(record + 1);
+	memcpy(strings, tag, tagLength);
+	strings += tagLength;
+	memcpy(strings, file, fileLength);
+	strings += fileLength;
+	memcpy(strings, function, functionLength);
+	strings += functionLength;
+	memcpy(strings, message, messageLength);
+
+	writePos += (uint32_t)recordSize;
+	DS_ATOMIC_STORE32(&buffer->writePos, &writePos);
+	notifyLogThread(log);
+}
+
+bool dsAsyncLog_flush(dsAsyncLog* asyncLog)
+{
+	if (!asyncLog)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	DS_VERIFY(dsMutex_lock(asyncLog->outputMutex));
+	drainBuffersLocked(asyncLog);
+	DS_VERIFY(dsMutex_unlock(asyncLog->outputMutex));
+	return true;
+}
+
+uint64_t dsAsyncLog_getDroppedCount(const dsAsyncLog* asyncLog)
+{
+	if (!asyncLog)
+		return 0;
+
+	uint32_t bufferCount;
+	DS_ATOMIC_LOAD32(&asyncLog->bufferCount, &bufferCount);
+	uint64_t droppedCount = 0;
+	for (uint32_t i = 0; i < bufferCount; ++i)
+	{
+		uint32_t bufferDroppedCount;
+		DS_ATOMIC_LOAD32(&asyncLog->buffers[i]->droppedCount, &bufferDroppedCount);
+		droppedCount += bufferDroppedCount;
+	}
+
+	return droppedCount;
+}
+
+void dsAsyncLog_destroy(dsAsyncLog* asyncLog)
+{
+	if (!asyncLog)
+		return;
+
+	if (dsLog_getFunction() == &dsAsyncLog_log && dsLog_getUserData() == asyncLog)
+		dsLog_clearFunction();
+
+	if (asyncLog->threadStarted)
+	{
+		DS_VERIFY(dsMutex_lock(asyncLog->waitMutex));
+		asyncLog->stop = true;
+		DS_VERIFY(dsConditionVariable_notifyAll(asyncLog->condition));
+		DS_VERIFY(dsMutex_unlock(asyncLog->waitMutex));
+		DS_VERIFY(dsThread_join(&asyncLog->thread, NULL));
+
+		// Output anything queued after the log thread's final pass.
+		drainBuffersLocked(asyncLog);
+	}
+
+	for (uint32_t i = 0; i < asyncLog->bufferCount; ++i)
+		DS_VERIFY(dsAllocator_free(asyncLog->allocator, asyncLog->buffers[i]));
+	DS_VERIFY(dsAllocator_free(asyncLog->allocator, asyncLog->buffers));
+	dsThreadStorage_shutdown(&asyncLog->threadBuffer);
+
+	dsConditionVariable_destroy(asyncLog->condition);
+	dsMutex_destroy(asyncLog->waitMutex);
+	dsMutex_destroy(asyncLog->outputMutex);
+	dsMutex_destroy(asyncLog->registerMutex);
+	DS_VERIFY(dsAllocator_free(asyncLog->allocator, asyncLog));
+}
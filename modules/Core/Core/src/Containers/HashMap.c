@@ -0,0 +1,481 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <DeepSea/Core/Containers/HashMap.h>
+
+#include <DeepSea/Core/Containers/ResizeableArray.h>
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Memory/Memory.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Bits.h>
+#include <DeepSea/Core/Error.h>
+#include <DeepSea/Core/Log.h>
+#include <string.h>
+
+#if DS_X86_64 || defined(__SSE2__) || _M_IX86_FP >= 2
+#define HAS_SSE2 1
+#include <emmintrin.h>
+#elif DS_ARM_64
+#define HAS_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Control bytes for slots without an entry. Full slots store the lower 7 bits of the hash, so
+// only empty and deleted slots are negative.
+#define CONTROL_EMPTY ((int8_t)-128)
+#define CONTROL_DELETED ((int8_t)-2)
+
+#define GROUP_SIZE 16
+#define MIN_CAPACITY GROUP_SIZE
+#define MAX_CAPACITY (1U << 31)
+#define NOT_FOUND UINT32_MAX
+
+// Groups are checked with a bitmask with a bit set for each matching slot in the group.
+#if HAS_SSE2
+
+typedef __m128i Group;
+
+static inline Group loadGroup(const int8_t* controls)
+{
+	return _mm_loadu_si128((const __m128i*)controls);
+}
+
+static inline uint32_t matchControl(Group group, int8_t control)
+{
+	return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(control)));
+}
+
+static inline uint32_t matchEmptyOrDeleted(Group group)
+{
+	return (uint32_t)_mm_movemask_epi8(group);
+}
+
+#elif HAS_NEON
+
+typedef int8x16_t Group;
+
+static inline Group loadGroup(const int8_t* controls)
+{
+	return vld1q_s8(controls);
+}
+
+static inline uint32_t toBitmask(uint8x16_t match)
+{
+	static const uint8_t bits[GROUP_SIZE] =
+		{1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+	uint8x16_t maskedBits = vandq_u8(match, vld1q_u8(bits));
+	return (uint32_t)vaddv_u8(vget_low_u8(maskedBits)) |
+		((uint32_t)vaddv_u8(vget_high_u8(maskedBits)) << 8);
+}
+
+static inline uint32_t matchControl(Group group, int8_t control)
+{
+	return toBitmask(vceqq_s8(group, vdupq_n_s8(control)));
+}
+
+static inline uint32_t matchEmptyOrDeleted(Group group)
+{
+	return toBitmask(vcltzq_s8(group));
+}
+
+#else
+
+typedef const int8_t* Group;
+
+static inline Group loadGroup(const int8_t* controls)
+{
+	return controls;
+}
+
+static inline uint32_t matchControl(Group group, int8_t control)
+{
+	uint32_t mask = 0;
+	for (uint32_t i = 0; i < GROUP_SIZE; ++i)
+		mask |= (uint32_t)(group[i] == control) << i;
+	return mask;
+}
+
+static inline uint32_t matchEmptyOrDeleted(Group group)
+{
+	uint32_t mask = 0;
+	for (uint32_t i = 0; i < GROUP_SIZE; ++i)
+		mask |= (uint32_t)(group[i] < 0) << i;
+	return mask;
+}
+
+#endif
+
+static inline uint32_t mixHash(uint32_t hash)
+{
+	// Finalizer from MurmurHash3 to spread the bits of weak hash functions, such as for pointers or
+	// integers. This is reversible, so it doesn't add any collisions.
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6b;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+static inline int8_t hashControl(uint32_t hash)
+{
+	return (int8_t)(hash & 0x7F);
+}
+
+static inline uint32_t hashPosition(const dsHashMap* hashMap, uint32_t hash)
+{
+	return (hash >> 7) & (hashMap->capacity - 1);
+}
+
+static inline uint32_t maxLoad(uint32_t capacity)
+{
+	return capacity - capacity/8;
+}
+
+static uint32_t capacityForCount(uint32_t count)
+{
+	uint32_t capacity = MIN_CAPACITY;
+	while (maxLoad(capacity) < count)
+	{
+		if (capacity == MAX_CAPACITY)
+			return 0;
+		capacity *= 2;
+	}
+	return capacity;
+}
+
+static inline void setControl(dsHashMap* hashMap, uint32_t slot, int8_t control)
+{
+	// The first group is mirrored after the end of the table so a group may be loaded at any slot.
+	hashMap->controls[slot] = control;
+	if (slot < GROUP_SIZE)
+		hashMap->controls[hashMap->capacity + slot] = control;
+}
+
+static uint32_t findSlot(const dsHashMap* hashMap, const void* key, uint32_t hash)
+{
+	if (hashMap->capacity == 0)
+		return NOT_FOUND;
+
+	// Probe whole groups with a triangular sequence, which visits every group once with a power of
+	// two capacity. There is always at least one empty slot to end the search.
+	uint32_t mask = hashMap->capacity - 1;
+	int8_t control = hashControl(hash);
+	uint32_t position = hashPosition(hashMap, hash);
+	uint32_t step = 0;
+	while (true)
+	{
+		Group group = loadGroup(hashMap->controls + position);
+		for (uint32_t match = matchControl(group, control); match; match &= match - 1)
+		{
+			uint32_t slot = (position + dsCtz(match)) & mask;
+			const dsHashMapEntry* entry = hashMap->entries + hashMap->slots[slot];
+			if (entry->hash == hash && hashMap->keysEqualFunc(entry->key, key))
+				return slot;
+		}
+
+		if (matchControl(group, CONTROL_EMPTY))
+			return NOT_FOUND;
+
+		step += GROUP_SIZE;
+		position = (position + step) & mask;
+	}
+}
+
+static uint32_t findFreeSlot(const dsHashMap* hashMap, uint32_t hash)
+{
+	uint32_t mask = hashMap->capacity - 1;
+	uint32_t position = hashPosition(hashMap, hash);
+	uint32_t step = 0;
+	while (true)
+	{
+		uint32_t match = matchEmptyOrDeleted(loadGroup(hashMap->controls + position));
+		if (match)
+			return (position + dsCtz(match)) & mask;
+
+		step += GROUP_SIZE;
+		position = (position + step) & mask;
+	}
+}
+
+static bool resizeTable(dsHashMap* hashMap, uint32_t capacity)
+{
+	DS_ASSERT(capacity >= MIN_CAPACITY && maxLoad(capacity) >= hashMap->entryCount);
+	if (!DS_ARRAY_SIZE_VALID(sizeof(uint32_t), capacity))
+	{
+		errno = ENOMEM;
+		return false;
+	}
+
+	size_t slotsSize = DS_ALIGNED_SIZE(sizeof(uint32_t)*capacity, DS_ALLOC_ALIGNMENT);
+	size_t controlsSize = capacity + GROUP_SIZE;
+	if (!DS_CAN_ADD_SIZES(slotsSize, controlsSize))
+	{
+		errno = ENOMEM;
+		return false;
+	}
+
+	uint8_t* buffer = (uint8_t*)dsAllocator_alloc(hashMap->allocator, slotsSize + controlsSize);
+	if (!buffer)
+		return false;
+
+	DS_VERIFY(dsAllocator_free(hashMap->allocator, hashMap->slots));
+	hashMap->slots = (uint32_t*)buffer;
+	hashMap->controls = (int8_t*)(buffer + slotsSize);
+	hashMap->capacity = capacity;
+	hashMap->growthLeft = maxLoad(capacity) - hashMap->entryCount;
+	memset(hashMap->controls, CONTROL_EMPTY, controlsSize);
+
+	// Hashes are stored with the entries, so the keys don't need to be hashed again.
+	for (uint32_t i = 0; i < hashMap->entryCount; ++i)
+	{
+		uint32_t hash = hashMap->entries[i].hash;
+		uint32_t slot = findFreeSlot(hashMap, hash);
+		setControl(hashMap, slot, hashControl(hash));
+		hashMap->slots[slot] = i;
+	}
+
+	return true;
+}
+
+static bool growTable(dsHashMap* hashMap)
+{
+	// Re-build at the same size when enough of the space is taken by deleted slots.
+	uint32_t capacity = hashMap->capacity;
+	if (capacity == 0)
+		capacity = MIN_CAPACITY;
+	else if ((uint64_t)hashMap->entryCount*32 > (uint64_t)capacity*25)
+	{
+		if (capacity == MAX_CAPACITY)
+		{
+			errno = ENOMEM;
+			return false;
+		}
+		capacity *= 2;
+	}
+
+	return resizeTable(hashMap, capacity);
+}
+
+bool dsHashMap_initialize(dsHashMap* hashMap, dsAllocator* allocator, uint32_t reserveCount,
+	dsHashFunction hashFunc, dsKeysEqualFunction keysEqualFunc)
+{
+	if (!hashMap || !allocator || !hashFunc || !keysEqualFunc)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (!allocator->freeFunc)
+	{
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Hash map allocator must support freeing memory.");
+		errno = EINVAL;
+		return false;
+	}
+
+	memset(hashMap, 0, sizeof(dsHashMap));
+	hashMap->allocator = allocator;
+	hashMap->hashFunc = hashFunc;
+	hashMap->keysEqualFunc = keysEqualFunc;
+	if (reserveCount > 0 && !dsHashMap_reserve(hashMap, reserveCount))
+	{
+		dsHashMap_shutdown(hashMap);
+		return false;
+	}
+
+	return true;
+}
+
+bool dsHashMap_reserve(dsHashMap* hashMap, uint32_t count)
+{
+	if (!hashMap || !hashMap->allocator)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (count > hashMap->maxEntries)
+	{
+		if (!DS_ARRAY_SIZE_VALID(sizeof(dsHashMapEntry), count))
+		{
+			errno = ENOMEM;
+			return false;
+		}
+
+		dsHashMapEntry* entries = (dsHashMapEntry*)dsAllocator_reallocWithFallback(
+			hashMap->allocator, hashMap->entries, hashMap->entryCount*sizeof(dsHashMapEntry),
+			count*sizeof(dsHashMapEntry));
+		if (!entries)
+			return false;
+
+		hashMap->entries = entries;
+		hashMap->maxEntries = count;
+	}
+
+	if (hashMap->capacity > 0 && maxLoad(hashMap->capacity) >= count)
+		return true;
+
+	uint32_t capacity = capacityForCount(count);
+	if (!capacity)
+	{
+		errno = ENOMEM;
+		return false;
+	}
+
+	return resizeTable(hashMap, capacity);
+}
+
+bool dsHashMap_insert(dsHashMap* hashMap, const void* key, void* value, void** existingValue)
+{
+	if (existingValue)
+		*existingValue = NULL;
+
+	if (!hashMap || !hashMap->allocator)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	uint32_t hash = mixHash(hashMap->hashFunc(key));
+	uint32_t slot = findSlot(hashMap, key, hash);
+	if (slot != NOT_FOUND)
+	{
+		if (existingValue)
+			*existingValue = hashMap->entries[hashMap->slots[slot]].value;
+		errno = EPERM;
+		return false;
+	}
+
+	uint32_t entryIndex = hashMap->entryCount;
+	if (!DS_RESIZEABLE_ARRAY_ADD(hashMap->allocator, hashMap->entries, hashMap->entryCount,
+			hashMap->maxEntries, 1))
+	{
+		return false;
+	}
+
+	// Deleted slots may be re-used without using up the space for growth.
+	slot = hashMap->capacity > 0 ? findFreeSlot(hashMap, hash) : NOT_FOUND;
+	if (slot == NOT_FOUND ||
+		(hashMap->growthLeft == 0 && hashMap->controls[slot] == CONTROL_EMPTY))
+	{
+		--hashMap->entryCount;
+		if (!growTable(hashMap))
+			return false;
+
+		++hashMap->entryCount;
+		slot = findFreeSlot(hashMap, hash);
+	}
+
+	if (hashMap->controls[slot] == CONTROL_EMPTY)
+		--hashMap->growthLeft;
+	setControl(hashMap, slot, hashControl(hash));
+	hashMap->slots[slot] = entryIndex;
+
+	dsHashMapEntry* entry = hashMap->entries + entryIndex;
+	entry->key = key;
+	entry->value = value;
+	entry->hash = hash;
+	return true;
+}
+
+dsHashMapEntry* dsHashMap_find(const dsHashMap* hashMap, const void* key)
+{
+	if (!hashMap || hashMap->entryCount == 0)
+		return NULL;
+
+	uint32_t slot = findSlot(hashMap, key, mixHash(hashMap->hashFunc(key)));
+	if (slot == NOT_FOUND)
+		return NULL;
+
+	return hashMap->entries + hashMap->slots[slot];
+}
+
+bool dsHashMap_remove(dsHashMap* hashMap, const void* key, dsHashMapEntry* outEntry)
+{
+	if (!hashMap || hashMap->entryCount == 0)
+		return false;
+
+	uint32_t slot = findSlot(hashMap, key, mixHash(hashMap->hashFunc(key)));
+	if (slot == NOT_FOUND)
+		return false;
+
+	uint32_t entryIndex = hashMap->slots[slot];
+	if (outEntry)
+		*outEntry = hashMap->entries[entryIndex];
+	setControl(hashMap, slot, CONTROL_DELETED);
+
+	// Keep the entries densely packed by moving the last entry into the removed entry's place.
+	uint32_t lastIndex = --hashMap->entryCount;
+	if (lastIndex == 0)
+	{
+		// Nothing left, so the deleted slots can be reclaimed.
+		DS_VERIFY(dsHashMap_clear(hashMap));
+		return true;
+	}
+	else if (entryIndex == lastIndex)
+		return true;
+
+	const dsHashMapEntry* lastEntry = hashMap->entries + lastIndex;
+	uint32_t mask = hashMap->capacity - 1;
+	int8_t control = hashControl(lastEntry->hash);
+	uint32_t position = hashPosition(hashMap, lastEntry->hash);
+	uint32_t step = 0;
+	while (true)
+	{
+		Group group = loadGroup(hashMap->controls + position);
+		for (uint32_t match = matchControl(group, control); match; match &= match - 1)
+		{
+			uint32_t lastSlot = (position + dsCtz(match)) & mask;
+			if (hashMap->slots[lastSlot] == lastIndex)
+			{
+				hashMap->slots[lastSlot] = entryIndex;
+				hashMap->entries[entryIndex] = *lastEntry;
+				return true;
+			}
+		}
+
+		DS_ASSERT(!matchControl(group, CONTROL_EMPTY));
+		step += GROUP_SIZE;
+		position = (position + step) & mask;
+	}
+}
+
+bool dsHashMap_clear(dsHashMap* hashMap)
+{
+	if (!hashMap)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	hashMap->entryCount = 0;
+	if (hashMap->capacity > 0)
+	{
+		memset(hashMap->controls, CONTROL_EMPTY, hashMap->capacity + GROUP_SIZE);
+		hashMap->growthLeft = maxLoad(hashMap->capacity);
+	}
+	return true;
+}
+
+void dsHashMap_shutdown(dsHashMap* hashMap)
+{
+	if (!hashMap || !hashMap->allocator)
+		return;
+
+	DS_VERIFY(dsAllocator_free(hashMap->allocator, hashMap->entries));
+	DS_VERIFY(dsAllocator_free(hashMap->allocator, hashMap->slots));
+	memset(hashMap, 0, sizeof(dsHashMap));
+}
@@ -0,0 +1,508 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <DeepSea/Core/Memory/CachingAllocator.h>
+
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Memory/Memory.h>
+#include <DeepSea/Core/Thread/Spinlock.h>
+#include <DeepSea/Core/Thread/ThreadObjectStorage.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Atomic.h>
+#include <DeepSea/Core/Bits.h>
+#include <DeepSea/Core/Error.h>
+#include <DeepSea/Core/Log.h>
+#include <string.h>
+
+#define SIZE_CLASS_COUNT 16
+#define LARGE_SIZE_CLASS 0xFFFFFFFF
+#define HEADER_SIZE DS_ALLOC_ALIGNMENT
+// Target number of bytes to exchange with the global pool at once.
+#define BATCH_BYTES (16*1024)
+#define MIN_BATCH_COUNT 4
+#define MAX_BATCH_COUNT 128
+#define MAX_GLOBAL_BATCHES 32
+#define STATISTICS_INTERVAL 64
+
+// Stored immediately before each allocation.
+typedef struct BlockHeader
+{
+	size_t size;
+	uint32_t sizeClass;
+	uint32_t offset;
+} BlockHeader;
+
+_Static_assert(sizeof(BlockHeader) <= HEADER_SIZE, "Block header doesn't fit.");
+
+// Overlaps the user memory of blocks that have been freed.
+typedef struct FreeBlock
+{
+	struct FreeBlock* next;
+} FreeBlock;
+
+typedef struct BlockList
+{
+	FreeBlock* head;
+	uint32_t count;
+} BlockList;
+
+typedef struct GlobalBin
+{
+	dsSpinlock lock;
+	BlockList batches[MAX_GLOBAL_BATCHES];
+	uint32_t batchCount;
+} GlobalBin;
+
+typedef struct ThreadCache
+{
+	dsCachingAllocator* allocator;
+	BlockList bins[SIZE_CLASS_COUNT];
+
+	// Statistics that have yet to be applied to the allocator. Only accessed by the owning thread,
+	// and may wrap around when more memory is freed than allocated on this thread.
+	size_t pendingSize;
+	uint32_t pendingTotalAllocations;
+	uint32_t pendingCurrentAllocations;
+	uint32_t pendingOperations;
+} ThreadCache;
+
+struct dsCachingAllocator
+{
+	dsAllocator allocator;
+	dsAllocator* baseAllocator;
+	dsThreadObjectStorage* threadCaches;
+	GlobalBin globalBins[SIZE_CLASS_COUNT];
+};
+
+static const size_t sizeClassSizes[SIZE_CLASS_COUNT] =
+	{16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096};
+
+_Static_assert(DS_CACHING_ALLOCATOR_MAX_CACHED_SIZE == 4096, "Unexpected max cached size.");
+
+static uint32_t getSizeClass(size_t size)
+{
+	DS_ASSERT(size > 0 && size <= DS_CACHING_ALLOCATOR_MAX_CACHED_SIZE);
+	if (size <= 64)
+		return (uint32_t)((size - 1) >> 4);
+
+	// Two size classes for each power of two above 64.
+	uint32_t bit = 31 - dsClz((uint32_t)(size - 1));
+	uint32_t sizeClass = 4 + (bit - 6)*2;
+	if (size - 1 >= (3U << (bit - 1)))
+		++sizeClass;
+	DS_ASSERT(size <= sizeClassSizes[sizeClass]);
+	return sizeClass;
+}
+
+static uint32_t getBatchCount(uint32_t sizeClass)
+{
+	size_t count = BATCH_BYTES/sizeClassSizes[sizeClass];
+	if (count < MIN_BATCH_COUNT)
+		return MIN_BATCH_COUNT;
+	else if (count > MAX_BATCH_COUNT)
+		return MAX_BATCH_COUNT;
+	return (uint32_t)count;
+}
+
+static inline BlockHeader* getHeader(void* ptr)
+{
+	return (BlockHeader*)((uint8_t*)ptr - sizeof(BlockHeader));
+}
+
+static void freeBlockList(dsAllocator* baseAllocator, FreeBlock* block)
+{
+	while (block)
+	{
+		FreeBlock* next = block->next;
+		DS_VERIFY(dsAllocator_free(baseAllocator, (uint8_t*)block - HEADER_SIZE));
+		block = next;
+	}
+}
+
+static void pushGlobalBatch(dsCachingAllocator* allocator, uint32_t sizeClass, FreeBlock* head,
+	uint32_t count)
+{
+	GlobalBin* bin = allocator->globalBins + sizeClass;
+	DS_VERIFY(dsSpinlock_lock(&bin->lock));
+	if (bin->batchCount < MAX_GLOBAL_BATCHES)
+	{
+		BlockList* batch = bin->batches + bin->batchCount++;
+		batch->head = head;
+		batch->count = count;
+		head = NULL;
+	}
+	DS_VERIFY(dsSpinlock_unlock(&bin->lock));
+
+	// Return the memory to the base allocator once the global pool is full.
+	freeBlockList(allocator->baseAllocator, head);
+}
+
+static FreeBlock* popGlobalBatch(dsCachingAllocator* allocator, uint32_t sizeClass,
+	uint32_t* outCount)
+{
+	GlobalBin* bin = allocator->globalBins + sizeClass;
+	FreeBlock* head = NULL;
+	*outCount = 0;
+	DS_VERIFY(dsSpinlock_lock(&bin->lock));
+	if (bin->batchCount > 0)
+	{
+		BlockList* batch = bin->batches + --bin->batchCount;
+		head = batch->head;
+		*outCount = batch->count;
+	}
+	DS_VERIFY(dsSpinlock_unlock(&bin->lock));
+	return head;
+}
+
+static void applyStatistics(dsCachingAllocator* allocator, ThreadCache* cache)
+{
+	dsAllocator* baseAllocator = (dsAllocator*)allocator;
+	if (cache->pendingSize)
+		DS_ATOMIC_FETCH_ADD_SIZE(&baseAllocator->size, cache->pendingSize);
+	if (cache->pendingTotalAllocations)
+		DS_ATOMIC_FETCH_ADD32(&baseAllocator->totalAllocations, cache->pendingTotalAllocations);
+	if (cache->pendingCurrentAllocations)
+	{
+		DS_ATOMIC_FETCH_ADD32(&baseAllocator->currentAllocations,
+			cache->pendingCurrentAllocations);
+	}
+
+	cache->pendingSize = 0;
+	cache->pendingTotalAllocations = 0;
+	cache->pendingCurrentAllocations = 0;
+	cache->pendingOperations = 0;
+}
+
+static void addStatistics(dsCachingAllocator* allocator, ThreadCache* cache, size_t size,
+	uint32_t totalAllocations, uint32_t currentAllocations)
+{
+	if (!cache)
+	{
+		dsAllocator* baseAllocator = (dsAllocator*)allocator;
+		DS_ATOMIC_FETCH_ADD_SIZE(&baseAllocator->size, size);
+		DS_ATOMIC_FETCH_ADD32(&baseAllocator->totalAllocations, totalAllocations);
+		DS_ATOMIC_FETCH_ADD32(&baseAllocator->currentAllocations, currentAllocations);
+		return;
+	}
+
+	cache->pendingSize += size;
+	cache->pendingTotalAllocations += totalAllocations;
+	cache->pendingCurrentAllocations += currentAllocations;
+	if (++cache->pendingOperations >= STATISTICS_INTERVAL)
+		applyStatistics(allocator, cache);
+}
+
+static void flushThreadCache(ThreadCache* cache)
+{
+	dsCachingAllocator* allocator = cache->allocator;
+	for (uint32_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+	{
+		BlockList* bin = cache->bins + i;
+		if (!bin->head)
+			continue;
+
+		pushGlobalBatch(allocator, i, bin->head, bin->count);
+		bin->head = NULL;
+		bin->count = 0;
+	}
+
+	applyStatistics(allocator, cache);
+}
+
+static void destroyThreadCache(void* object)
+{
+	ThreadCache* cache = (ThreadCache*)object;
+	flushThreadCache(cache);
+	DS_VERIFY(dsAllocator_free(cache->allocator->baseAllocator, cache));
+}
+
+static ThreadCache* getThreadCache(dsCachingAllocator* allocator)
+{
+	ThreadCache* cache = (ThreadCache*)dsThreadObjectStorage_get(allocator->threadCaches);
+	if (cache)
+		return cache;
+
+	// Failing to create the cache isn't fatal, allocations will go directly to the base allocator.
+	int prevErrno = errno;
+	cache = DS_ALLOCATE_OBJECT(allocator->baseAllocator, ThreadCache);
+	if (!cache)
+	{
+		errno = prevErrno;
+		return NULL;
+	}
+
+	memset(cache, 0, sizeof(ThreadCache));
+	cache->allocator = allocator;
+	if (!dsThreadObjectStorage_set(allocator->threadCaches, cache))
+	{
+		errno = prevErrno;
+		return NULL;
+	}
+
+	return cache;
+}
+
+static void* allocCached(dsCachingAllocator* allocator, ThreadCache* cache, uint32_t sizeClass)
+{
+	if (cache)
+	{
+		BlockList* bin = cache->bins + sizeClass;
+		if (!bin->head)
+			bin->head = popGlobalBatch(allocator, sizeClass, &bin->count);
+
+		FreeBlock* block = bin->head;
+		if (block)
+		{
+			bin->head = block->next;
+			--bin->count;
+			return block;
+		}
+	}
+
+	uint8_t* basePtr = (uint8_t*)dsAllocator_alloc(allocator->baseAllocator,
+		HEADER_SIZE + sizeClassSizes[sizeClass]);
+	if (!basePtr)
+		return NULL;
+
+	void* ptr = basePtr + HEADER_SIZE;
+	BlockHeader* header = getHeader(ptr);
+	header->size = sizeClassSizes[sizeClass];
+	header->sizeClass = sizeClass;
+	header->offset = HEADER_SIZE;
+	return ptr;
+}
+
+static void freeCached(dsCachingAllocator* allocator, ThreadCache* cache, void* ptr,
+	uint32_t sizeClass)
+{
+	if (!cache)
+	{
+		DS_VERIFY(dsAllocator_free(allocator->baseAllocator, (uint8_t*)ptr - HEADER_SIZE));
+		return;
+	}
+
+	BlockList* bin = cache->bins + sizeClass;
+	FreeBlock* block = (FreeBlock*)ptr;
+	block->next = bin->head;
+	bin->head = block;
+
+	uint32_t batchCount = getBatchCount(sizeClass);
+	if (++bin->count < batchCount*2)
+		return;
+
+	// Keep the most recently freed blocks since they're most likely to be in the CPU cache, moving
+	// the rest to the global pool.
+	FreeBlock* last = bin->head;
+	for (uint32_t i = 1; i < batchCount; ++i)
+		last = last->next;
+
+	FreeBlock* moved = last->next;
+	last->next = NULL;
+	pushGlobalBatch(allocator, sizeClass, moved, bin->count - batchCount);
+	bin->count = batchCount;
+	applyStatistics(allocator, cache);
+}
+
+static void* allocLarge(dsCachingAllocator* allocator, size_t size, unsigned int alignment)
+{
+	size_t offset = alignment > HEADER_SIZE ? alignment : HEADER_SIZE;
+	if (!DS_CAN_ADD_SIZES(size, offset))
+	{
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	dsAllocator* baseAllocator = allocator->baseAllocator;
+	uint8_t* basePtr = (uint8_t*)baseAllocator->allocFunc(baseAllocator, size + offset,
+		alignment > DS_ALLOC_ALIGNMENT ? alignment : DS_ALLOC_ALIGNMENT);
+	if (!basePtr)
+		return NULL;
+
+	void* ptr = basePtr + offset;
+	BlockHeader* header = getHeader(ptr);
+	header->size = size;
+	header->sizeClass = LARGE_SIZE_CLASS;
+	header->offset = (uint32_t)offset;
+	return ptr;
+}
+
+dsCachingAllocator* dsCachingAllocator_create(dsAllocator* allocator)
+{
+	if (!allocator)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (!allocator->freeFunc)
+	{
+		DS_LOG_ERROR(DS_CORE_LOG_TAG,
+			"Caching allocator base allocator must support freeing memory.");
+		errno = EINVAL;
+		return NULL;
+	}
+
+	dsCachingAllocator* cachingAllocator = DS_ALLOCATE_OBJECT(allocator, dsCachingAllocator);
+	if (!cachingAllocator)
+		return NULL;
+
+	memset(cachingAllocator, 0, sizeof(dsCachingAllocator));
+	cachingAllocator->threadCaches = dsThreadObjectStorage_create(allocator, &destroyThreadCache);
+	if (!cachingAllocator->threadCaches)
+	{
+		DS_VERIFY(dsAllocator_free(allocator, cachingAllocator));
+		return NULL;
+	}
+
+	dsAllocator* baseAllocator = (dsAllocator*)cachingAllocator;
+	baseAllocator->allocFunc = (dsAllocatorAllocFunction)&dsCachingAllocator_alloc;
+	baseAllocator->reallocFunc = (dsAllocatorReallocFunction)&dsCachingAllocator_realloc;
+	baseAllocator->freeFunc = (dsAllocatorFreeFunction)&dsCachingAllocator_free;
+	cachingAllocator->baseAllocator = allocator;
+	for (uint32_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+		DS_VERIFY(dsSpinlock_initialize(&cachingAllocator->globalBins[i].lock));
+	return cachingAllocator;
+}
+
+void* dsCachingAllocator_alloc(dsCachingAllocator* allocator, size_t size, unsigned int alignment)
+{
+	if (!allocator)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (size == 0)
+		return NULL;
+
+	ThreadCache* cache = getThreadCache(allocator);
+	void* ptr;
+	size_t allocSize;
+	if (size <= DS_CACHING_ALLOCATOR_MAX_CACHED_SIZE && alignment <= DS_ALLOC_ALIGNMENT)
+	{
+		uint32_t sizeClass = getSizeClass(size);
+		ptr = allocCached(allocator, cache, sizeClass);
+		allocSize = sizeClassSizes[sizeClass];
+	}
+	else
+	{
+		ptr = allocLarge(allocator, size, alignment);
+		allocSize = size;
+	}
+
+	if (!ptr)
+		return NULL;
+
+	addStatistics(allocator, cache, allocSize, 1, 1);
+	return ptr;
+}
+
+void* dsCachingAllocator_realloc(
+	dsCachingAllocator* allocator, void* ptr, size_t size, unsigned int alignment)
+{
+	if (!allocator)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (!ptr)
+		return dsCachingAllocator_alloc(allocator, size, alignment);
+
+	if (size == 0)
+	{
+		dsCachingAllocator_free(allocator, ptr);
+		return NULL;
+	}
+
+	// Keep the same block if the size class doesn't change.
+	BlockHeader* header = getHeader(ptr);
+	if (header->sizeClass != LARGE_SIZE_CLASS && size <= DS_CACHING_ALLOCATOR_MAX_CACHED_SIZE &&
+		alignment <= DS_ALLOC_ALIGNMENT && getSizeClass(size) == header->sizeClass)
+	{
+		addStatistics(allocator, getThreadCache(allocator), 0, 1, 0);
+		return ptr;
+	}
+
+	void* newPtr = dsCachingAllocator_alloc(allocator, size, alignment);
+	if (!newPtr)
+		return NULL;
+
+	memcpy(newPtr, ptr, header->size < size ? header->size : size);
+	DS_VERIFY(dsCachingAllocator_free(allocator, ptr));
+	return newPtr;
+}
+
+bool dsCachingAllocator_free(dsCachingAllocator* allocator, void* ptr)
+{
+	if (!allocator)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (!ptr)
+		return true;
+
+	ThreadCache* cache = getThreadCache(allocator);
+	BlockHeader* header = getHeader(ptr);
+	uint32_t sizeClass = header->sizeClass;
+	addStatistics(allocator, cache, 0 - header->size, 0, (uint32_t)-1);
+	if (sizeClass == LARGE_SIZE_CLASS)
+		return dsAllocator_free(allocator->baseAllocator, (uint8_t*)ptr - header->offset);
+
+	DS_ASSERT(sizeClass < SIZE_CLASS_COUNT);
+	freeCached(allocator, cache, ptr, sizeClass);
+	return true;
+}
+
+bool dsCachingAllocator_flushThreadCache(dsCachingAllocator* allocator)
+{
+	if (!allocator)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	ThreadCache* cache = (ThreadCache*)dsThreadObjectStorage_get(allocator->threadCaches);
+	if (cache)
+		flushThreadCache(cache);
+	return true;
+}
+
+dsAllocator* dsCachingAllocator_getBaseAllocator(const dsCachingAllocator* allocator)
+{
+	return allocator ? allocator->baseAllocator : NULL;
+}
+
+void dsCachingAllocator_destroy(dsCachingAllocator* allocator)
+{
+	if (!allocator)
+		return;
+
+	// Flushes the caches for any remaining threads into the global bins.
+	dsThreadObjectStorage_destroy(allocator->threadCaches);
+
+	for (uint32_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+	{
+		GlobalBin* bin = allocator->globalBins + i;
+		for (uint32_t j = 0; j < bin->batchCount; ++j)
+			freeBlockList(allocator->baseAllocator, bin->batches[j].head);
+		dsSpinlock_shutdown(&bin->lock);
+	}
+
+	DS_VERIFY(dsAllocator_free(allocator->baseAllocator, allocator));
+}
@@ -0,0 +1,516 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <DeepSea/Core/Memory/ConcurrentPoolAllocator.h>
+
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Memory/Memory.h>
+#include <DeepSea/Core/Thread/Spinlock.h>
+#include <DeepSea/Core/Thread/ThreadObjectStorage.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Atomic.h>
+#include <DeepSea/Core/Bits.h>
+#include <DeepSea/Core/Error.h>
+#include <DeepSea/Core/Log.h>
+#include <string.h>
+
+#define MAX_PAGES 32
+#define MAX_CHUNK_COUNT UINT32_MAX
+#define MAX_INITIAL_CHUNK_COUNT (1U << 31)
+#define THREAD_CACHE_SIZE 32
+#define STATISTICS_INTERVAL 64
+
+// Free chunks store the index of the next free chunk + 1 at the start of the chunk, with 0 for the
+// end of the list. The head of the list has the same value in the lower 32 bits and a tag in the
+// upper 32 bits that's incremented with each change to avoid the ABA problem.
+#define HEAD_INDEX(head) ((uint32_t)(head))
+#define HEAD_TAG(head) ((head) >> 32)
+
+typedef struct ThreadCache
+{
+	dsConcurrentPoolAllocator* allocator;
+	uint32_t count;
+
+	// Statistics that have yet to be applied to the allocator. pendingAllocations may be negative
+	// when freeing chunks allocated on other threads.
+	int32_t pendingAllocations;
+	uint32_t pendingTotalAllocations;
+	uint32_t pendingOperations;
+
+	uint32_t chunks[THREAD_CACHE_SIZE];
+} ThreadCache;
+
+struct dsConcurrentPoolAllocator
+{
+	dsAllocator allocator;
+	dsAllocator* baseAllocator;
+	dsThreadObjectStorage* threadCaches;
+	size_t chunkSize;
+	uint32_t firstPageShift;
+
+	uint64_t freeHead;
+	uint32_t freeCount;
+
+	// Number of chunks held by thread caches as of the last time statistics were applied. Adding
+	// the pending allocations for each thread gives the true number of chunks in the caches.
+	uint32_t cachedCount;
+
+	dsSpinlock growLock;
+	uint32_t pageCount;
+	uint32_t chunkCount;
+	uint8_t* pages[MAX_PAGES];
+};
+
+static inline size_t getPageStart(const dsConcurrentPoolAllocator* allocator, uint32_t page)
+{
+	return (((size_t)1 << page) - 1) << allocator->firstPageShift;
+}
+
+static inline uint32_t* getChunk(const dsConcurrentPoolAllocator* allocator, uint32_t index)
+{
+	// Each page is twice the size of the previous one.
+	uint32_t page = 31 - dsClz((index >> allocator->firstPageShift) + 1);
+	DS_ASSERT(page < allocator->pageCount);
+	return (uint32_t*)(allocator->pages[page] +
+		(index - getPageStart(allocator, page))*allocator->chunkSize);
+}
+
+static bool getChunkIndex(uint32_t* outIndex, const dsConcurrentPoolAllocator* allocator,
+	const void* ptr)
+{
+	uint32_t pageCount;
+	DS_ATOMIC_LOAD32(&allocator->pageCount, &pageCount);
+	const uint8_t* bytePtr = (const uint8_t*)ptr;
+	// Later pages are larger, so check them first.
+	for (uint32_t i = pageCount; i-- > 0;)
+	{
+		const uint8_t* page = allocator->pages[i];
+		size_t pageChunks = (size_t)1 << (allocator->firstPageShift + i);
+		if (bytePtr < page || bytePtr >= page + pageChunks*allocator->chunkSize)
+			continue;
+
+		size_t offset = (size_t)(bytePtr - page);
+		if (offset % allocator->chunkSize != 0)
+			return false;
+
+		*outIndex = (uint32_t)(getPageStart(allocator, i) + offset/allocator->chunkSize);
+		return true;
+	}
+
+	return false;
+}
+
+static inline void setNextChunk(uint32_t* chunk, uint32_t next)
+{
+	// Other threads with a stale head may read this concurrently.
+	DS_ATOMIC_STORE32(chunk, &next);
+}
+
+static bool popChunk(dsConcurrentPoolAllocator* allocator, uint32_t* outIndex)
+{
+	uint64_t head, newHead;
+	DS_ATOMIC_LOAD64(&allocator->freeHead, &head);
+	do
+	{
+		if (!HEAD_INDEX(head))
+			return false;
+
+		// The chunk may be taken by another thread before the exchange, in which case the next
+		// value may be garbage. The tag will have changed, causing the exchange to fail.
+		uint32_t next;
+		DS_ATOMIC_LOAD32(getChunk(allocator, HEAD_INDEX(head) - 1), &next);
+		newHead = ((HEAD_TAG(head) + 1) << 32) | next;
+	} while (!DS_ATOMIC_COMPARE_EXCHANGE64(&allocator->freeHead, &head, &newHead, true));
+
+	DS_ATOMIC_FETCH_ADD32(&allocator->freeCount, -1);
+	*outIndex = HEAD_INDEX(head) - 1;
+	return true;
+}
+
+static void pushChunks(dsConcurrentPoolAllocator* allocator, uint32_t first, uint32_t last,
+	uint32_t count)
+{
+	uint32_t* lastChunk = getChunk(allocator, last);
+	uint64_t head, newHead;
+	DS_ATOMIC_LOAD64(&allocator->freeHead, &head);
+	do
+	{
+		setNextChunk(lastChunk, HEAD_INDEX(head));
+		newHead = ((HEAD_TAG(head) + 1) << 32) | (first + 1);
+	} while (!DS_ATOMIC_COMPARE_EXCHANGE64(&allocator->freeHead, &head, &newHead, true));
+
+	DS_ATOMIC_FETCH_ADD32(&allocator->freeCount, count);
+}
+
+static bool addPage(dsConcurrentPoolAllocator* allocator)
+{
+	DS_VERIFY(dsSpinlock_lock(&allocator->growLock));
+
+	// Another thread may have added a page or freed chunks while waiting for the lock.
+	uint64_t head;
+	DS_ATOMIC_LOAD64(&allocator->freeHead, &head);
+	if (HEAD_INDEX(head))
+	{
+		DS_VERIFY(dsSpinlock_unlock(&allocator->growLock));
+		return true;
+	}
+
+	uint32_t page = allocator->pageCount;
+	uint64_t pageChunks = (uint64_t)1 << (allocator->firstPageShift + page);
+	if (page == MAX_PAGES || pageChunks > MAX_CHUNK_COUNT - allocator->chunkCount ||
+		!DS_ARRAY_SIZE_VALID(allocator->chunkSize, pageChunks))
+	{
+		DS_VERIFY(dsSpinlock_unlock(&allocator->growLock));
+		errno = ENOMEM;
+		return false;
+	}
+
+	uint8_t* pageBuffer = (uint8_t*)dsAllocator_alloc(allocator->baseAllocator,
+		(size_t)pageChunks*allocator->chunkSize);
+	if (!pageBuffer)
+	{
+		DS_VERIFY(dsSpinlock_unlock(&allocator->growLock));
+		return false;
+	}
+
+	// Nothing else can see the page yet, so the chunks can be linked without atomics.
+	uint32_t firstIndex = allocator->chunkCount;
+	uint32_t lastIndex = (uint32_t)(firstIndex + pageChunks - 1);
+	for (uint32_t i = 0; i < pageChunks - 1; ++i)
+		*(uint32_t*)(pageBuffer + i*allocator->chunkSize) = firstIndex + i + 2;
+
+	allocator->pages[page] = pageBuffer;
+	uint32_t newPageCount = page + 1;
+	uint32_t newChunkCount = lastIndex + 1;
+	DS_ATOMIC_STORE32(&allocator->pageCount, &newPageCount);
+	DS_ATOMIC_STORE32(&allocator->chunkCount, &newChunkCount);
+	pushChunks(allocator, firstIndex, lastIndex, (uint32_t)pageChunks);
+
+	DS_VERIFY(dsSpinlock_unlock(&allocator->growLock));
+	return true;
+}
+
+static bool allocChunk(dsConcurrentPoolAllocator* allocator, uint32_t* outIndex)
+{
+	while (!popChunk(allocator, outIndex))
+	{
+		if (!addPage(allocator))
+			return false;
+	}
+
+	return true;
+}
+
+static void applyStatistics(dsConcurrentPoolAllocator* allocator, ThreadCache* cache)
+{
+	dsAllocator* baseAllocator = (dsAllocator*)allocator;
+	if (cache->pendingAllocations)
+	{
+		DS_ATOMIC_FETCH_ADD_SIZE(&baseAllocator->size,
+			(ptrdiff_t)cache->pendingAllocations*(ptrdiff_t)allocator->chunkSize);
+		DS_ATOMIC_FETCH_ADD32(&baseAllocator->currentAllocations, cache->pendingAllocations);
+		DS_ATOMIC_FETCH_ADD32(&allocator->cachedCount, -cache->pendingAllocations);
+	}
+	if (cache->pendingTotalAllocations)
+		DS_ATOMIC_FETCH_ADD32(&baseAllocator->totalAllocations, cache->pendingTotalAllocations);
+
+	cache->pendingAllocations = 0;
+	cache->pendingTotalAllocations = 0;
+	cache->pendingOperations = 0;
+}
+
+static void addStatistics(dsConcurrentPoolAllocator* allocator, ThreadCache* cache,
+	int32_t allocations, uint32_t totalAllocations)
+{
+	cache->pendingAllocations += allocations;
+	cache->pendingTotalAllocations += totalAllocations;
+	if (++cache->pendingOperations >= STATISTICS_INTERVAL)
+		applyStatistics(allocator, cache);
+}
+
+static bool refillThreadCache(dsConcurrentPoolAllocator* allocator, ThreadCache* cache)
+{
+	DS_ASSERT(cache->count == 0);
+	uint32_t index;
+	if (!allocChunk(allocator, &index))
+		return false;
+
+	cache->chunks[cache->count++] = index;
+	while (cache->count < THREAD_CACHE_SIZE/2 && popChunk(allocator, &index))
+		cache->chunks[cache->count++] = index;
+
+	DS_ATOMIC_FETCH_ADD32(&allocator->cachedCount, cache->count);
+	applyStatistics(allocator, cache);
+	return true;
+}
+
+static void spillThreadCache(dsConcurrentPoolAllocator* allocator, ThreadCache* cache,
+	uint32_t count)
+{
+	DS_ASSERT(count > 0 && count <= cache->count);
+
+	// Return the oldest chunks, keeping the most recently freed since they're most likely to be in
+	// the CPU cache.
+	for (uint32_t i = 0; i < count - 1; ++i)
+		setNextChunk(getChunk(allocator, cache->chunks[i]), cache->chunks[i + 1] + 1);
+	pushChunks(allocator, cache->chunks[0], cache->chunks[count - 1], count);
+
+	cache->count -= count;
+	memmove(cache->chunks, cache->chunks + count, cache->count*sizeof(uint32_t));
+	DS_ATOMIC_FETCH_ADD32(&allocator->cachedCount, -(int32_t)count);
+	applyStatistics(allocator, cache);
+}
+
+static void destroyThreadCache(void* object)
+{
+	ThreadCache* cache = (ThreadCache*)object;
+	dsConcurrentPoolAllocator* allocator = cache->allocator;
+	if (cache->count > 0)
+		spillThreadCache(allocator, cache, cache->count);
+	else
+		applyStatistics(allocator, cache);
+	DS_VERIFY(dsAllocator_free(allocator->baseAllocator, cache));
+}
+
+static ThreadCache* getThreadCache(dsConcurrentPoolAllocator* allocator)
+{
+	if (!allocator->threadCaches)
+		return NULL;
+
+	ThreadCache* cache = (ThreadCache*)dsThreadObjectStorage_get(allocator->threadCaches);
+	if (cache)
+		return cache;
+
+	// Failing to create the cache isn't fatal, chunks will be taken from the shared list.
+	int prevErrno = errno;
+	cache = DS_ALLOCATE_OBJECT(allocator->baseAllocator, ThreadCache);
+	if (!cache)
+	{
+		errno = prevErrno;
+		return NULL;
+	}
+
+	memset(cache, 0, sizeof(ThreadCache));
+	cache->allocator = allocator;
+	if (!dsThreadObjectStorage_set(allocator->threadCaches, cache))
+	{
+		errno = prevErrno;
+		return NULL;
+	}
+
+	return cache;
+}
+
+dsConcurrentPoolAllocator* dsConcurrentPoolAllocator_create(dsAllocator* allocator,
+	size_t chunkSize, size_t initialChunkCount, bool threadCaches)
+{
+	if (!allocator || chunkSize == 0 || initialChunkCount == 0)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (!allocator->freeFunc)
+	{
+		DS_LOG_ERROR(DS_CORE_LOG_TAG,
+			"Concurrent pool allocator base allocator must support freeing memory.");
+		errno = EINVAL;
+		return NULL;
+	}
+
+	size_t alignedChunkSize = DS_ALIGNED_SIZE(chunkSize, DS_ALLOC_ALIGNMENT);
+	if (alignedChunkSize < chunkSize || initialChunkCount > MAX_INITIAL_CHUNK_COUNT)
+	{
+		errno = ERANGE;
+		return NULL;
+	}
+
+	dsConcurrentPoolAllocator* poolAllocator =
+		DS_ALLOCATE_OBJECT(allocator, dsConcurrentPoolAllocator);
+	if (!poolAllocator)
+		return NULL;
+
+	memset(poolAllocator, 0, sizeof(dsConcurrentPoolAllocator));
+	poolAllocator->baseAllocator = allocator;
+	poolAllocator->chunkSize = alignedChunkSize;
+	if (initialChunkCount > 1)
+		poolAllocator->firstPageShift = 32 - dsClz((uint32_t)(initialChunkCount - 1));
+	DS_VERIFY(dsSpinlock_initialize(&poolAllocator->growLock));
+
+	dsAllocator* baseAllocator = (dsAllocator*)poolAllocator;
+	baseAllocator->allocFunc = (dsAllocatorAllocFunction)&dsConcurrentPoolAllocator_alloc;
+	baseAllocator->freeFunc = (dsAllocatorFreeFunction)&dsConcurrentPoolAllocator_free;
+
+	if (threadCaches)
+	{
+		poolAllocator->threadCaches = dsThreadObjectStorage_create(allocator,
+			&destroyThreadCache);
+		if (!poolAllocator->threadCaches)
+		{
+			dsConcurrentPoolAllocator_destroy(poolAllocator);
+			return NULL;
+		}
+	}
+
+	if (!addPage(poolAllocator))
+	{
+		dsConcurrentPoolAllocator_destroy(poolAllocator);
+		return NULL;
+	}
+
+	return poolAllocator;
+}
+
+void* dsConcurrentPoolAllocator_alloc(
+	dsConcurrentPoolAllocator* allocator, size_t size, unsigned int alignment)
+{
+	if (!allocator || size == 0 || alignment == 0 || size > allocator->chunkSize ||
+		alignment > DS_ALLOC_ALIGNMENT)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	uint32_t index;
+	ThreadCache* cache = getThreadCache(allocator);
+	if (cache)
+	{
+		if (cache->count == 0 && !refillThreadCache(allocator, cache))
+			return NULL;
+
+		index = cache->chunks[--cache->count];
+		addStatistics(allocator, cache, 1, 1);
+	}
+	else
+	{
+		if (!allocChunk(allocator, &index))
+			return NULL;
+
+		dsAllocator* baseAllocator = (dsAllocator*)allocator;
+		DS_ATOMIC_FETCH_ADD_SIZE(&baseAllocator->size, allocator->chunkSize);
+		DS_ATOMIC_FETCH_ADD32(&baseAllocator->totalAllocations, 1);
+		DS_ATOMIC_FETCH_ADD32(&baseAllocator->currentAllocations, 1);
+	}
+
+	return getChunk(allocator, index);
+}
+
+bool dsConcurrentPoolAllocator_free(dsConcurrentPoolAllocator* allocator, void* ptr)
+{
+	if (!allocator)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (!ptr)
+		return true;
+
+	// Make sure that the pointer is valid.
+	uint32_t index;
+	if (!getChunkIndex(&index, allocator, ptr))
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	ThreadCache* cache = getThreadCache(allocator);
+	if (cache)
+	{
+		if (cache->count == THREAD_CACHE_SIZE)
+			spillThreadCache(allocator, cache, THREAD_CACHE_SIZE/2);
+
+		cache->chunks[cache->count++] = index;
+		addStatistics(allocator, cache, -1, 0);
+	}
+	else
+	{
+		pushChunks(allocator, index, index, 1);
+
+		dsAllocator* baseAllocator = (dsAllocator*)allocator;
+		DS_ATOMIC_FETCH_ADD_SIZE(&baseAllocator->size, -(ptrdiff_t)allocator->chunkSize);
+		DS_ATOMIC_FETCH_ADD32(&baseAllocator->currentAllocations, -1);
+	}
+
+	return true;
+}
+
+size_t dsConcurrentPoolAllocator_getChunkSize(const dsConcurrentPoolAllocator* allocator)
+{
+	if (!allocator)
+		return 0;
+
+	return allocator->chunkSize;
+}
+
+size_t dsConcurrentPoolAllocator_getChunkCount(const dsConcurrentPoolAllocator* allocator)
+{
+	if (!allocator)
+		return 0;
+
+	uint32_t chunkCount;
+	DS_ATOMIC_LOAD32(&allocator->chunkCount, &chunkCount);
+	return chunkCount;
+}
+
+bool dsConcurrentPoolAllocator_validate(dsConcurrentPoolAllocator* allocator)
+{
+	if (!allocator || allocator->pageCount == 0 || allocator->pageCount > MAX_PAGES ||
+		allocator->chunkSize % DS_ALLOC_ALIGNMENT != 0 ||
+		allocator->chunkCount != getPageStart(allocator, allocator->pageCount))
+	{
+		return false;
+	}
+
+	// Guard against cycles by never visiting more nodes than there are chunks.
+	uint32_t foundNodes = 0;
+	uint32_t next = HEAD_INDEX(allocator->freeHead);
+	while (next)
+	{
+		if (next > allocator->chunkCount || foundNodes >= allocator->chunkCount)
+			return false;
+
+		++foundNodes;
+		next = *getChunk(allocator, next - 1);
+	}
+
+	if (foundNodes != allocator->freeCount)
+		return false;
+
+	// Every chunk is either in the shared list, cached for a thread, or allocated.
+	dsAllocator* baseAllocator = (dsAllocator*)allocator;
+	if ((uint64_t)allocator->freeCount + allocator->cachedCount +
+			baseAllocator->currentAllocations != allocator->chunkCount)
+	{
+		return false;
+	}
+
+	return baseAllocator->size == baseAllocator->currentAllocations*allocator->chunkSize;
+}
+
+void dsConcurrentPoolAllocator_destroy(dsConcurrentPoolAllocator* allocator)
+{
+	if (!allocator)
+		return;
+
+	// Returns any chunks still cached for threads, which requires the pages to still be present.
+	dsThreadObjectStorage_destroy(allocator->threadCaches);
+
+	for (uint32_t i = 0; i < allocator->pageCount; ++i)
+		DS_VERIFY(dsAllocator_free(allocator->baseAllocator, allocator->pages[i]));
+	dsSpinlock_shutdown(&allocator->growLock);
+	DS_VERIFY(dsAllocator_free(allocator->baseAllocator, allocator));
+}
@@ -0,0 +1,376 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <DeepSea/Core/Memory/FrameAllocator.h>
+
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Memory/BufferAllocator.h>
+#include <DeepSea/Core/Memory/Memory.h>
+#include <DeepSea/Core/Thread/Spinlock.h>
+#include <DeepSea/Core/Thread/ThreadObjectStorage.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Error.h>
+#include <DeepSea/Core/Log.h>
+#include <string.h>
+
+// Size of the chunks each thread reserves to allocate from without locking.
+#define CHUNK_SIZE (16*1024)
+// Larger allocations are taken directly from the frame's blocks.
+#define MAX_CHUNK_ALLOC_SIZE (CHUNK_SIZE/4)
+
+typedef struct Block
+{
+	struct Block* next;
+	size_t size;
+} Block;
+
+#define BLOCK_HEADER_SIZE DS_ALIGNED_SIZE(sizeof(Block), DS_ALLOC_ALIGNMENT)
+
+typedef struct Frame
+{
+	Block* blocks;
+	Block* curBlock;
+	size_t curOffset;
+} Frame;
+
+typedef struct ThreadChunk
+{
+	dsFrameAllocator* allocator;
+	uint32_t generation;
+	uint8_t* cur;
+	uint8_t* end;
+} ThreadChunk;
+
+struct dsFrameAllocator
+{
+	dsAllocator allocator;
+	dsAllocator* baseAllocator;
+	dsThreadObjectStorage* threadChunks;
+	dsSpinlock lock;
+
+	size_t blockSize;
+	Frame* frames;
+	unsigned int frameCount;
+	unsigned int frameIndex;
+	uint64_t frameNumber;
+
+	// Incremented each frame to invalidate the chunks reserved by each thread.
+	uint32_t generation;
+};
+
+static inline uint8_t* getBlockData(Block* block)
+{
+	return (uint8_t*)block + BLOCK_HEADER_SIZE;
+}
+
+static inline uint8_t* alignPointer(uint8_t* ptr, unsigned int alignment)
+{
+	uintptr_t rem = (uintptr_t)ptr & (alignment - 1);
+	return rem > 0 ? ptr + (alignment - rem) : ptr;
+}
+
+static Block* allocateBlock(dsFrameAllocator* allocator, size_t size)
+{
+	if (!DS_CAN_ADD_SIZES(size, BLOCK_HEADER_SIZE))
+	{
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	Block* block = (Block*)dsAllocator_alloc(allocator->baseAllocator, BLOCK_HEADER_SIZE + size);
+	if (!block)
+		return NULL;
+
+	block->next = NULL;
+	block->size = size;
+
+	dsAllocator* baseAllocator = (dsAllocator*)allocator;
+	baseAllocator->size += size;
+	++baseAllocator->totalAllocations;
+	++baseAllocator->currentAllocations;
+	return block;
+}
+
+static void freeBlocks(dsFrameAllocator* allocator, Block* block)
+{
+	dsAllocator* baseAllocator = (dsAllocator*)allocator;
+	while (block)
+	{
+		Block* next = block->next;
+		DS_ASSERT(baseAllocator->size >= block->size && baseAllocator->currentAllocations > 0);
+		baseAllocator->size -= block->size;
+		--baseAllocator->currentAllocations;
+		DS_VERIFY(dsAllocator_free(allocator->baseAllocator, block));
+		block = next;
+	}
+}
+
+static void* allocShared(dsFrameAllocator* allocator, size_t size, unsigned int alignment)
+{
+	if (!DS_CAN_ADD_SIZES(size, alignment))
+	{
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	uint8_t* ptr = NULL;
+	DS_VERIFY(dsSpinlock_lock(&allocator->lock));
+	Frame* frame = allocator->frames + allocator->frameIndex;
+	Block* block = frame->curBlock;
+	if (!block && frame->blocks)
+	{
+		block = frame->curBlock = frame->blocks;
+		frame->curOffset = 0;
+	}
+
+	while (block)
+	{
+		uint8_t* data = getBlockData(block);
+		uint8_t* alignedPtr = alignPointer(data + frame->curOffset, alignment);
+		size_t offset = (size_t)(alignedPtr - data);
+		if (offset <= block->size && size <= block->size - offset)
+		{
+			frame->curOffset = offset + size;
+			ptr = alignedPtr;
+			break;
+		}
+
+		// Move on to the next block retained from a previous use of this frame.
+		block = block->next;
+		if (block)
+		{
+			frame->curBlock = block;
+			frame->curOffset = 0;
+		}
+	}
+
+	if (!ptr)
+	{
+		size_t blockSize = size + alignment;
+		if (blockSize < allocator->blockSize)
+			blockSize = allocator->blockSize;
+
+		block = allocateBlock(allocator, blockSize);
+		if (block)
+		{
+			if (frame->curBlock)
+			{
+				DS_ASSERT(!frame->curBlock->next);
+				frame->curBlock->next = block;
+			}
+			else
+				frame->blocks = block;
+
+			uint8_t* data = getBlockData(block);
+			ptr = alignPointer(data, alignment);
+			frame->curBlock = block;
+			frame->curOffset = (size_t)(ptr - data) + size;
+		}
+	}
+	DS_VERIFY(dsSpinlock_unlock(&allocator->lock));
+	return ptr;
+}
+
+static void resetFrame(dsFrameAllocator* allocator, Frame* frame)
+{
+	frame->curBlock = NULL;
+	frame->curOffset = 0;
+	if (!frame->blocks || !frame->blocks->next)
+		return;
+
+	// Combine the blocks into a single block so the next use of this frame doesn't need to chain.
+	size_t totalSize = 0;
+	for (Block* block = frame->blocks; block; block = block->next)
+		totalSize += block->size;
+
+	freeBlocks(allocator, frame->blocks);
+
+	// Failing to allocate the combined block isn't fatal, it will be allocated on demand.
+	int prevErrno = errno;
+	frame->blocks = allocateBlock(allocator, totalSize);
+	if (!frame->blocks)
+		errno = prevErrno;
+}
+
+static void destroyThreadChunk(void* object)
+{
+	ThreadChunk* chunk = (ThreadChunk*)object;
+	DS_VERIFY(dsAllocator_free(chunk->allocator->baseAllocator, chunk));
+}
+
+static ThreadChunk* getThreadChunk(dsFrameAllocator* allocator)
+{
+	ThreadChunk* chunk = (ThreadChunk*)dsThreadObjectStorage_get(allocator->threadChunks);
+	if (chunk)
+		return chunk;
+
+	// Failing to create the chunk isn't fatal, allocations will use the shared blocks directly.
+	int prevErrno = errno;
+	chunk = DS_ALLOCATE_OBJECT(allocator->baseAllocator, ThreadChunk);
+	if (!chunk)
+	{
+		errno = prevErrno;
+		return NULL;
+	}
+
+	memset(chunk, 0, sizeof(ThreadChunk));
+	chunk->allocator = allocator;
+	chunk->generation = allocator->generation;
+	if (!dsThreadObjectStorage_set(allocator->threadChunks, chunk))
+	{
+		errno = prevErrno;
+		return NULL;
+	}
+
+	return chunk;
+}
+
+static void* allocFromChunk(ThreadChunk* chunk, size_t size, unsigned int alignment)
+{
+	if (!chunk->cur)
+		return NULL;
+
+	uint8_t* ptr = alignPointer(chunk->cur, alignment);
+	if (ptr > chunk->end || size > (size_t)(chunk->end - ptr))
+		return NULL;
+
+	chunk->cur = ptr + size;
+	return ptr;
+}
+
+dsFrameAllocator* dsFrameAllocator_create(dsAllocator* allocator, size_t blockSize,
+	unsigned int frameCount)
+{
+	if (!allocator || blockSize == 0 || frameCount == 0)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (!allocator->freeFunc)
+	{
+		DS_LOG_ERROR(DS_CORE_LOG_TAG,
+			"Frame allocator base allocator must support freeing memory.");
+		errno = EINVAL;
+		return NULL;
+	}
+
+	size_t fullSize = DS_ALIGNED_SIZE(sizeof(dsFrameAllocator), DS_ALLOC_ALIGNMENT) +
+		DS_ALIGNED_SIZE(sizeof(Frame)*frameCount, DS_ALLOC_ALIGNMENT);
+	void* buffer = dsAllocator_alloc(allocator, fullSize);
+	if (!buffer)
+		return NULL;
+
+	dsBufferAllocator bufferAlloc;
+	DS_VERIFY(dsBufferAllocator_initialize(&bufferAlloc, buffer, fullSize));
+	dsFrameAllocator* frameAllocator = DS_ALLOCATE_OBJECT(&bufferAlloc, dsFrameAllocator);
+	DS_ASSERT(frameAllocator);
+	memset(frameAllocator, 0, sizeof(dsFrameAllocator));
+
+	frameAllocator->frames = DS_ALLOCATE_OBJECT_ARRAY(&bufferAlloc, Frame, frameCount);
+	DS_ASSERT(frameAllocator->frames);
+	memset(frameAllocator->frames, 0, sizeof(Frame)*frameCount);
+
+	frameAllocator->threadChunks = dsThreadObjectStorage_create(allocator, &destroyThreadChunk);
+	if (!frameAllocator->threadChunks)
+	{
+		DS_VERIFY(dsAllocator_free(allocator, frameAllocator));
+		return NULL;
+	}
+
+	dsAllocator* baseAllocator = (dsAllocator*)frameAllocator;
+	baseAllocator->allocFunc = (dsAllocatorAllocFunction)&dsFrameAllocator_alloc;
+	frameAllocator->baseAllocator = allocator;
+	DS_VERIFY(dsSpinlock_initialize(&frameAllocator->lock));
+	frameAllocator->blockSize = blockSize;
+	frameAllocator->frameCount = frameCount;
+	return frameAllocator;
+}
+
+void* dsFrameAllocator_alloc(dsFrameAllocator* allocator, size_t size, unsigned int alignment)
+{
+	if (!allocator || size == 0 || alignment == 0)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (size > MAX_CHUNK_ALLOC_SIZE || alignment > MAX_CHUNK_ALLOC_SIZE)
+		return allocShared(allocator, size, alignment);
+
+	ThreadChunk* chunk = getThreadChunk(allocator);
+	if (!chunk)
+		return allocShared(allocator, size, alignment);
+
+	if (chunk->generation != allocator->generation)
+	{
+		chunk->generation = allocator->generation;
+		chunk->cur = chunk->end = NULL;
+	}
+
+	void* ptr = allocFromChunk(chunk, size, alignment);
+	if (ptr)
+		return ptr;
+
+	// Any remaining space in the previous chunk is abandoned until the frame is reset.
+	uint8_t* newChunk = (uint8_t*)allocShared(allocator, CHUNK_SIZE, DS_ALLOC_ALIGNMENT);
+	if (!newChunk)
+		return NULL;
+
+	chunk->cur = newChunk;
+	chunk->end = newChunk + CHUNK_SIZE;
+	ptr = allocFromChunk(chunk, size, alignment);
+	DS_ASSERT(ptr);
+	return ptr;
+}
+
+bool dsFrameAllocator_beginFrame(dsFrameAllocator* allocator, uint64_t frameNumber)
+{
+	if (!allocator)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (frameNumber == allocator->frameNumber)
+		return true;
+
+	allocator->frameNumber = frameNumber;
+	allocator->frameIndex = (unsigned int)(frameNumber % allocator->frameCount);
+	++allocator->generation;
+	resetFrame(allocator, allocator->frames + allocator->frameIndex);
+	return true;
+}
+
+unsigned int dsFrameAllocator_getFrameCount(const dsFrameAllocator* allocator)
+{
+	if (!allocator)
+		return 0;
+
+	return allocator->frameCount;
+}
+
+void dsFrameAllocator_destroy(dsFrameAllocator* allocator)
+{
+	if (!allocator)
+		return;
+
+	dsThreadObjectStorage_destroy(allocator->threadChunks);
+	for (unsigned int i = 0; i < allocator->frameCount; ++i)
+		freeBlocks(allocator, allocator->frames[i].blocks);
+	dsSpinlock_shutdown(&allocator->lock);
+	DS_VERIFY(dsAllocator_free(allocator->baseAllocator, allocator));
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright 2018-2023 Aaron Barany
+ * Copyright 2018-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -14,67 +14,444 @@
  * limitations under the License.
  */
 
-#define _GNU_SOURCE
 #include <DeepSea/Core/Sort.h>
-#include <stdlib.h>
-#if DS_WINDOWS
-#include <search.h>
-#elif DS_ANDROID
-#include <DeepSea/Core/Thread/ThreadStorage.h>
-#endif
 
-#if DS_APPLE || DS_BSD || DS_WINDOWS
-typedef struct ContextWrapper
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Thread/ThreadPool.h>
+#include <DeepSea/Core/Thread/ThreadTaskQueue.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Bits.h>
+#include <DeepSea/Core/Error.h>
+#include <string.h>
+
+// Partitions at or below this size are sorted with an insertion sort.
+#define INSERTION_SORT_COUNT 16
+
+// Arrays below this size aren't worth the overhead of sorting in parallel.
+#define MIN_PARALLEL_COUNT 4096
+#define MAX_PARALLEL_RANGES 64
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define MAX_RADIX_PASSES (64/RADIX_BITS)
+
+typedef struct SortInfo
 {
-	dsSortCompareFunction func;
+	dsSortCompareFunction compareFunc;
 	void* context;
-} ContextWrapper;
+	size_t memberSize;
+} SortInfo;
 
-static int sortWrapper(void* context, const void* left, const void* right)
+typedef struct SortRange
 {
-	ContextWrapper* contextWrapper = (ContextWrapper*)context;
-	return contextWrapper->func(left, right, contextWrapper->context);
+	const SortInfo* info;
+	uint8_t* first;
+	size_t count;
+} SortRange;
+
+typedef struct ParallelSortInfo
+{
+	SortInfo info;
+	dsThreadTaskQueue* taskQueue;
+	size_t taskThreshold;
+	SortRange ranges[MAX_PARALLEL_RANGES];
+	uint32_t rangeCount;
+} ParallelSortInfo;
+
+static inline void swapMembers(uint8_t* left, uint8_t* right, size_t memberSize)
+{
+	// Handle the most common sizes directly to avoid a loop for each swap.
+	if (memberSize == sizeof(uint32_t))
+	{
+		uint32_t temp;
+		memcpy(&temp, left, sizeof(uint32_t));
+		memcpy(left, right, sizeof(uint32_t));
+		memcpy(right, &temp, sizeof(uint32_t));
+	}
+	else if (memberSize == sizeof(uint64_t))
+	{
+		uint64_t temp;
+		memcpy(&temp, left, sizeof(uint64_t));
+		memcpy(left, right, sizeof(uint64_t));
+		memcpy(right, &temp, sizeof(uint64_t));
+	}
+	else
+	{
+		uint64_t temp;
+		for (; memberSize >= sizeof(uint64_t); memberSize -= sizeof(uint64_t),
+			left += sizeof(uint64_t), right += sizeof(uint64_t))
+		{
+			memcpy(&temp, left, sizeof(uint64_t));
+			memcpy(left, right, sizeof(uint64_t));
+			memcpy(right, &temp, sizeof(uint64_t));
+		}
+
+		for (; memberSize > 0; --memberSize, ++left, ++right)
+		{
+			uint8_t tempByte = *left;
+			*left = *right;
+			*right = tempByte;
+		}
+	}
 }
-#elif DS_ANDROID
-// Android currently doesn't have qsort_r(), so emulate using thread-local storage.
-typedef struct ContextWrapper
+
+static inline int compareMembers(const SortInfo* info, const uint8_t* left, const uint8_t* right)
 {
-	dsSortCompareFunction func;
-	void* context;
-} ContextWrapper;
+	return info->compareFunc(left, right, info->context);
+}
+
+static void insertionSort(const SortInfo* info, uint8_t* first, size_t count)
+{
+	size_t memberSize = info->memberSize;
+	uint8_t* end = first + count*memberSize;
+	for (uint8_t* cur = first + memberSize; cur < end; cur += memberSize)
+	{
+		for (uint8_t* member = cur;
+			member > first && compareMembers(info, member - memberSize, member) > 0;
+			member -= memberSize)
+		{
+			swapMembers(member - memberSize, member, memberSize);
+		}
+	}
+}
+
+static void siftDown(const SortInfo* info, uint8_t* first, size_t index, size_t count)
+{
+	size_t memberSize = info->memberSize;
+	while (true)
+	{
+		size_t child = index*2 + 1;
+		if (child >= count)
+			return;
+
+		uint8_t* childMember = first + child*memberSize;
+		if (child + 1 < count && compareMembers(info, childMember, childMember + memberSize) < 0)
+		{
+			++child;
+			childMember += memberSize;
+		}
+
+		uint8_t* member = first + index*memberSize;
+		if (compareMembers(info, member, childMember) >= 0)
+			return;
 
-static DS_THREAD_LOCAL ContextWrapper sortContext;
+		swapMembers(member, childMember, memberSize);
+		index = child;
+	}
+}
 
-static int sortWrapper(const void* left, const void* right)
+static void heapSort(const SortInfo* info, uint8_t* first, size_t count)
 {
-	ContextWrapper* contextWrapper = &sortContext;
-	return contextWrapper->func(left, right, contextWrapper->context);
+	for (size_t i = count/2; i-- > 0;)
+		siftDown(info, first, i, count);
+
+	for (size_t i = count - 1; i > 0; --i)
+	{
+		swapMembers(first, first + i*info->memberSize, info->memberSize);
+		siftDown(info, first, 0, i);
+	}
 }
 
-static void qsort_r_workaround(void* array, size_t memberCount, size_t memberSize,
-	dsSortCompareFunction compareFunc, void* context)
+static size_t partition(const SortInfo* info, uint8_t* first, size_t count)
 {
-	ContextWrapper* contextWrapper = &sortContext;
-	contextWrapper->func = compareFunc;
-	contextWrapper->context = context;
-	qsort(array, memberCount, memberSize, &sortWrapper);
+	DS_ASSERT(count > INSERTION_SORT_COUNT);
+	size_t memberSize = info->memberSize;
+
+	// Use the median of the first, middle, and last members as the pivot, moved to the start.
+	uint8_t* middle = first + (count/2)*memberSize;
+	uint8_t* last = first + (count - 1)*memberSize;
+	if (compareMembers(info, middle, first) < 0)
+		swapMembers(middle, first, memberSize);
+	if (compareMembers(info, last, middle) < 0)
+	{
+		swapMembers(last, middle, memberSize);
+		if (compareMembers(info, middle, first) < 0)
+			swapMembers(middle, first, memberSize);
+	}
+	swapMembers(first, middle, memberSize);
+
+	// Stop on members equal to the pivot from both sides to keep partitions balanced with many
+	// duplicate values.
+	size_t i = 1;
+	size_t j = count - 1;
+	while (true)
+	{
+		while (i < count && compareMembers(info, first + i*memberSize, first) < 0)
+			++i;
+		while (compareMembers(info, first + j*memberSize, first) > 0)
+			--j;
+
+		if (i >= j)
+			break;
+
+		swapMembers(first + i*memberSize, first + j*memberSize, memberSize);
+		++i;
+		--j;
+	}
+
+	swapMembers(first, first + j*memberSize, memberSize);
+	return j;
 }
+
+static unsigned int maxSortDepth(size_t count)
+{
+#if DS_64BIT
+	return (64 - dsClz64(count))*2;
+#else
+	return (32 - dsClz((uint32_t)count))*2;
 #endif
+}
+
+static void introSort(const SortInfo* info, uint8_t* first, size_t count, unsigned int depth)
+{
+	while (count > INSERTION_SORT_COUNT)
+	{
+		if (depth == 0)
+		{
+			heapSort(info, first, count);
+			return;
+		}
+		--depth;
+
+		// Recurse into the smaller side to limit the stack depth.
+		size_t pivot = partition(info, first, count);
+		size_t rightCount = count - pivot - 1;
+		uint8_t* right = first + (pivot + 1)*info->memberSize;
+		if (pivot < rightCount)
+		{
+			introSort(info, first, pivot, depth);
+			first = right;
+			count = rightCount;
+		}
+		else
+		{
+			introSort(info, right, rightCount, depth);
+			count = pivot;
+		}
+	}
+
+	insertionSort(info, first, count);
+}
+
+static void sortRangeTask(void* userData)
+{
+	const SortRange* range = (const SortRange*)userData;
+	introSort(range->info, range->first, range->count, maxSortDepth(range->count));
+}
+
+static void parallelSortRec(ParallelSortInfo* parallelInfo, uint8_t* first, size_t count,
+	unsigned int depth)
+{
+	if (count <= 1)
+		return;
+
+	const SortInfo* info = &parallelInfo->info;
+	if (count <= parallelInfo->taskThreshold || depth == 0)
+	{
+		// Queue the task immediately so the threads may start while the remaining ranges are
+		// partitioned. Sort on the current thread if out of ranges.
+		if (parallelInfo->rangeCount >= MAX_PARALLEL_RANGES)
+		{
+			introSort(info, first, count, maxSortDepth(count));
+			return;
+		}
+
+		SortRange* range = parallelInfo->ranges + parallelInfo->rangeCount++;
+		range->info = info;
+		range->first = first;
+		range->count = count;
+
+		dsThreadTask task = {&sortRangeTask, range};
+		DS_VERIFY(dsThreadTaskQueue_addTasks(parallelInfo->taskQueue, &task, 1));
+		return;
+	}
+
+	size_t pivot = partition(info, first, count);
+	parallelSortRec(parallelInfo, first, pivot, depth - 1);
+	parallelSortRec(parallelInfo, first + (pivot + 1)*info->memberSize, count - pivot - 1,
+		depth - 1);
+}
+
+static inline uint32_t floatKeyToUInt(uint32_t key)
+{
+	// Flip all bits for negative values and only the sign bit for positive values so the integer
+	// ordering matches the float ordering.
+	uint32_t mask = (uint32_t)-(int32_t)(key >> 31) | 0x80000000U;
+	return key ^ mask;
+}
+
+typedef enum RadixKeyType
+{
+	RadixKeyType_UInt32,
+	RadixKeyType_Float,
+	RadixKeyType_UInt64
+} RadixKeyType;
+
+static inline uint64_t getRadixKey(const uint8_t* member, size_t keyOffset, RadixKeyType keyType)
+{
+	if (keyType == RadixKeyType_UInt64)
+	{
+		uint64_t key;
+		memcpy(&key, member + keyOffset, sizeof(uint64_t));
+		return key;
+	}
+
+	uint32_t key;
+	memcpy(&key, member + keyOffset, sizeof(uint32_t));
+	return keyType == RadixKeyType_Float ? floatKeyToUInt(key) : key;
+}
+
+static inline void copyMember(uint8_t* dst, const uint8_t* src, size_t memberSize)
+{
+	if (memberSize == sizeof(uint64_t))
+		memcpy(dst, src, sizeof(uint64_t));
+	else if (memberSize == sizeof(uint64_t)*2)
+		memcpy(dst, src, sizeof(uint64_t)*2);
+	else
+		memcpy(dst, src, memberSize);
+}
+
+static bool radixSort(void* array, void* tempArray, size_t memberCount, size_t memberSize,
+	size_t keyOffset, RadixKeyType keyType)
+{
+	if ((!array || !tempArray) && memberCount > 0)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	size_t keySize = keyType == RadixKeyType_UInt64 ? sizeof(uint64_t) : sizeof(uint32_t);
+	if (memberSize < keySize || keyOffset > memberSize - keySize)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (memberCount <= 1)
+		return true;
+
+	// Compute the histogram for all passes at once.
+	unsigned int passCount = (unsigned int)(keySize*8/RADIX_BITS);
+	size_t counts[MAX_RADIX_PASSES][RADIX_BUCKETS];
+	memset(counts, 0, sizeof(size_t)*RADIX_BUCKETS*passCount);
+	const uint8_t* end = (const uint8_t*)array + memberCount*memberSize;
+	for (const uint8_t* member = (const uint8_t*)array; member < end; member += memberSize)
+	{
+		uint64_t key = getRadixKey(member, keyOffset, keyType);
+		for (unsigned int i = 0; i < passCount; ++i)
+			++counts[i][(key >> (i*RADIX_BITS)) & (RADIX_BUCKETS - 1)];
+	}
+
+	uint8_t* src = (uint8_t*)array;
+	uint8_t* dst = (uint8_t*)tempArray;
+	uint64_t firstKey = getRadixKey(src, keyOffset, keyType);
+	for (unsigned int i = 0; i < passCount; ++i)
+	{
+		// Skip the pass if all keys have the same digit.
+		unsigned int shift = i*RADIX_BITS;
+		size_t* passCounts = counts[i];
+		if (passCounts[(firstKey >> shift) & (RADIX_BUCKETS - 1)] == memberCount)
+			continue;
+
+		size_t offset = 0;
+		for (unsigned int j = 0; j < RADIX_BUCKETS; ++j)
+		{
+			size_t count = passCounts[j];
+			passCounts[j] = offset;
+			offset += count;
+		}
+
+		end = src + memberCount*memberSize;
+		for (const uint8_t* member = src; member < end; member += memberSize)
+		{
+			size_t digit = (size_t)(getRadixKey(member, keyOffset, keyType) >> shift) &
+				(RADIX_BUCKETS - 1);
+			copyMember(dst + (passCounts[digit]++)*memberSize, member, memberSize);
+		}
+
+		uint8_t* temp = src;
+		src = dst;
+		dst = temp;
+	}
+
+	if (src != array)
+		memcpy(array, src, memberCount*memberSize);
+	return true;
+}
 
 void dsSort(void* array, size_t memberCount, size_t memberSize, dsSortCompareFunction compareFunc,
 	void* context)
 {
-#if DS_WINDOWS
-	ContextWrapper wrapper = {compareFunc, context};
-	qsort_s(array, memberCount, memberSize, &sortWrapper, &wrapper);
-#elif DS_APPLE
-	ContextWrapper wrapper = {compareFunc, context};
-	qsort_r(array, memberCount, memberSize, &wrapper, &sortWrapper);
-#elif DS_ANDROID
-	qsort_r_workaround(array, memberCount, memberSize, compareFunc, context);
-#else
-	qsort_r(array, memberCount, memberSize, compareFunc, context);
-#endif
+	if (!array || memberCount <= 1 || memberSize == 0 || !compareFunc)
+		return;
+
+	SortInfo info = {compareFunc, context, memberSize};
+	introSort(&info, (uint8_t*)array, memberCount, maxSortDepth(memberCount));
+}
+
+void dsParallelSort(void* array, size_t memberCount, size_t memberSize,
+	dsSortCompareFunction compareFunc, void* context, dsThreadPool* threadPool,
+	dsAllocator* allocator)
+{
+	if (!array || memberCount <= 1 || memberSize == 0 || !compareFunc)
+		return;
+
+	unsigned int threadCount = threadPool ? dsThreadPool_getThreadCount(threadPool) : 0;
+	if (threadCount == 0 || !allocator || memberCount < MIN_PARALLEL_COUNT)
+	{
+		dsSort(array, memberCount, memberSize, compareFunc, context);
+		return;
+	}
+
+	ParallelSortInfo* parallelInfo = DS_ALLOCATE_OBJECT(allocator, ParallelSortInfo);
+	if (!parallelInfo)
+	{
+		dsSort(array, memberCount, memberSize, compareFunc, context);
+		return;
+	}
+
+	parallelInfo->taskQueue = dsThreadTaskQueue_create(allocator, threadPool, MAX_PARALLEL_RANGES,
+		0);
+	if (!parallelInfo->taskQueue)
+	{
+		DS_VERIFY(dsAllocator_free(allocator, parallelInfo));
+		dsSort(array, memberCount, memberSize, compareFunc, context);
+		return;
+	}
+
+	parallelInfo->info.compareFunc = compareFunc;
+	parallelInfo->info.context = context;
+	parallelInfo->info.memberSize = memberSize;
+	parallelInfo->taskThreshold = memberCount/((threadCount + 1)*4);
+	if (parallelInfo->taskThreshold < MIN_PARALLEL_COUNT/4)
+		parallelInfo->taskThreshold = MIN_PARALLEL_COUNT/4;
+	parallelInfo->rangeCount = 0;
+
+	// Limit the depth when partitioning on the current thread so a bad series of pivots doesn't
+	// serialize the sort.
+	parallelSortRec(parallelInfo, (uint8_t*)array, memberCount, maxSortDepth(memberCount)/2);
+	DS_VERIFY(dsThreadTaskQueue_waitForTasks(parallelInfo->taskQueue));
+
+	dsThreadTaskQueue_destroy(parallelInfo->taskQueue);
+	DS_VERIFY(dsAllocator_free(allocator, parallelInfo));
+}
+
+bool dsRadixSortUInt32Key(void* array, void* tempArray, size_t memberCount, size_t memberSize,
+	size_t keyOffset)
+{
+	return radixSort(array, tempArray, memberCount, memberSize, keyOffset, RadixKeyType_UInt32);
+}
+
+bool dsRadixSortUInt64Key(void* array, void* tempArray, size_t memberCount, size_t memberSize,
+	size_t keyOffset)
+{
+	return radixSort(array, tempArray, memberCount, memberSize, keyOffset, RadixKeyType_UInt64);
+}
+
+bool dsRadixSortFloatKey(void* array, void* tempArray, size_t memberCount, size_t memberSize,
+	size_t keyOffset)
+{
+	return radixSort(array, tempArray, memberCount, memberSize, keyOffset, RadixKeyType_Float);
 }
 
 const void* dsBinarySearch(const void* key, const void* array, size_t memberCount,
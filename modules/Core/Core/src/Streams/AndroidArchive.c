@@ -1,5 +1,5 @@
 /*
- * Copyright 2025 Aaron Barany
+ * Copyright 2025-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -325,6 +325,7 @@ dsStream* dsAndroidArchive_openFile(const dsAndroidArchive* archive, const char*
 	baseStream->tellFunc = &dsAndroidAssetStream_tell;
 	baseStream->remainingBytesFunc = &dsAndroidAssetStream_remainingBytes;
 	baseStream->remainingBytesFunc = NULL;
+	baseStream->getBufferFunc = NULL;
 	baseStream->flushFunc = NULL;
 	baseStream->closeFunc = &dsAndroidAssetStream_close;
 
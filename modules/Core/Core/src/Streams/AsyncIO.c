@@ -0,0 +1,522 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <DeepSea/Core/Streams/AsyncIO.h>
+
+#include <DeepSea/Core/Containers/List.h>
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Streams/FileArchive.h>
+#include <DeepSea/Core/Streams/FileStream.h>
+#include <DeepSea/Core/Streams/ResourceStream.h>
+#include <DeepSea/Core/Streams/Stream.h>
+#include <DeepSea/Core/Thread/ConditionVariable.h>
+#include <DeepSea/Core/Thread/Mutex.h>
+#include <DeepSea/Core/Thread/Thread.h>
+#include <DeepSea/Core/Thread/ThreadPool.h>
+#include <DeepSea/Core/Thread/ThreadTaskQueue.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Error.h>
+#include <DeepSea/Core/Log.h>
+#include <DeepSea/Core/Profile.h>
+
+#include <string.h>
+
+#define MAX_POOL_TASKS 256
+
+typedef struct AsyncIORequest
+{
+	dsListNode node;
+	dsAsyncIORequest request;
+	dsAsyncIO* asyncIO;
+	void* data;
+	size_t size;
+	int errorCode;
+} AsyncIORequest;
+
+struct dsAsyncIO
+{
+	dsAllocator* allocator;
+	dsThreadPool* threadPool;
+	dsThreadTaskQueue* taskQueue;
+	dsThread* threads;
+	unsigned int threadCount;
+	unsigned int maxDrainTasks;
+	unsigned int drainTaskCount;
+
+	dsMutex* mutex;
+	dsConditionVariable* requestCondition;
+	dsConditionVariable* finishCondition;
+
+	dsList pendingRequests;
+	dsList completedRequests;
+	uint32_t activeRequestCount;
+	bool stop;
+};
+
+static void readRequest(AsyncIORequest* requestNode)
+{
+	const dsAsyncIORequest* request = &requestNode->request;
+	DS_PROFILE_DYNAMIC_SCOPE_START(request->file.path);
+
+	union
+	{
+		dsFileStream fileStream;
+		dsResourceStream resourceStream;
+	} streams;
+
+	dsStream* stream = NULL;
+	switch (request->file.source)
+	{
+		case dsAsyncIOSource_File:
+			if (dsFileStream_openPath(&streams.fileStream, request->file.path, "rb"))
+				stream = (dsStream*)&streams.fileStream;
+			break;
+		case dsAsyncIOSource_Resource:
+			if (dsResourceStream_open(&streams.resourceStream, request->file.resourceType,
+					request->file.path, "rb"))
+			{
+				stream = (dsStream*)&streams.resourceStream;
+			}
+			break;
+		case dsAsyncIOSource_Archive:
+			stream = dsFileArchive_openFile(request->file.archive, request->file.path);
+			break;
+		default:
+			DS_ASSERT(false);
+			errno = EINVAL;
+			break;
+	}
+
+	if (!stream)
+	{
+		requestNode->errorCode = errno;
+		DS_PROFILE_SCOPE_END();
+		return;
+	}
+
+	if (request->offset > 0 && dsStream_skip(stream, request->offset) != request->offset)
+	{
+		requestNode->errorCode = EIO;
+		DS_VERIFY(dsStream_close(stream));
+		DS_PROFILE_SCOPE_END();
+		return;
+	}
+
+	if (request->buffer)
+	{
+		requestNode->data = request->buffer;
+		requestNode->size = dsStream_read(stream, request->buffer, request->size);
+	}
+	else if (request->size > 0)
+	{
+		requestNode->data = dsAllocator_alloc(request->allocator, request->size);
+		if (requestNode->data)
+			requestNode->size = dsStream_read(stream, requestNode->data, request->size);
+		else
+			requestNode->errorCode = errno;
+	}
+	else if (!dsStream_canGetRemainingBytes(stream) || dsStream_remainingBytes(stream) > 0)
+	{
+		requestNode->data = dsStream_readUntilEnd(&requestNode->size, stream, request->allocator);
+		if (!requestNode->data)
+			requestNode->errorCode = errno;
+	}
+
+	DS_VERIFY(dsStream_close(stream));
+	DS_PROFILE_SCOPE_END();
+}
+
+static void completeRequest(AsyncIORequest* requestNode)
+{
+	const dsAsyncIORequest* request = &requestNode->request;
+	void* data = requestNode->data;
+	if (requestNode->errorCode != 0 && data && data != request->buffer)
+	{
+		DS_VERIFY(dsAllocator_free(request->allocator, data));
+		data = NULL;
+	}
+
+	if (request->completeFunc)
+	{
+		request->completeFunc(request->userData, request, data, requestNode->size,
+			requestNode->errorCode);
+	}
+	else if (data && data != request->buffer)
+		DS_VERIFY(dsAllocator_free(request->allocator, data));
+}
+
+static void processRequest(dsAsyncIO* asyncIO, AsyncIORequest* requestNode)
+{
+	readRequest(requestNode);
+
+	bool completed = requestNode->request.completeOnIOThread;
+	if (completed)
+	{
+		completeRequest(requestNode);
+		DS_VERIFY(dsAllocator_free(asyncIO->allocator, requestNode));
+	}
+
+	DS_VERIFY(dsMutex_lock(asyncIO->mutex));
+	if (!completed)
+		DS_VERIFY(dsList_append(&asyncIO->completedRequests, &requestNode->node));
+	DS_ASSERT(asyncIO->activeRequestCount > 0);
+	if (--asyncIO->activeRequestCount == 0)
+		DS_VERIFY(dsConditionVariable_notifyAll(asyncIO->finishCondition));
+	DS_VERIFY(dsMutex_unlock(asyncIO->mutex));
+}
+
+static AsyncIORequest* popPendingRequest(dsAsyncIO* asyncIO)
+{
+	AsyncIORequest* requestNode = (AsyncIORequest*)asyncIO->pendingRequests.head;
+	if (requestNode)
+		DS_VERIFY(dsList_remove(&asyncIO->pendingRequests, &requestNode->node));
+	return requestNode;
+}
+
+static dsThreadReturnType ioThreadFunc(void* userData)
+{
+	dsAsyncIO* asyncIO = (dsAsyncIO*)userData;
+	DS_VERIFY(dsMutex_lock(asyncIO->mutex));
+	while (!asyncIO->stop)
+	{
+		AsyncIORequest* requestNode = popPendingRequest(asyncIO);
+		if (!requestNode)
+		{
+			dsConditionVariable_wait(asyncIO->requestCondition, asyncIO->mutex);
+			continue;
+		}
+
+		DS_VERIFY(dsMutex_unlock(asyncIO->mutex));
+		processRequest(asyncIO, requestNode);
+		DS_VERIFY(dsMutex_lock(asyncIO->mutex));
+	}
+	DS_VERIFY(dsMutex_unlock(asyncIO->mutex));
+
+	return 0;
+}
+
+static void ioTaskFunc(void* userData)
+{
+	// Each task drains pending requests in the order they were added until none are left, so only
+	// as many tasks as can run in parallel are ever queued regardless of the number of requests.
+	dsAsyncIO* asyncIO = (dsAsyncIO*)userData;
+	DS_VERIFY(dsMutex_lock(asyncIO->mutex));
+	while (true)
+	{
+		AsyncIORequest* requestNode = asyncIO->stop ? NULL : popPendingRequest(asyncIO);
+		if (!requestNode)
+			break;
+
+		DS_VERIFY(dsMutex_unlock(asyncIO->mutex));
+		processRequest(asyncIO, requestNode);
+		DS_VERIFY(dsMutex_lock(asyncIO->mutex));
+	}
+
+	DS_ASSERT(asyncIO->drainTaskCount > 0);
+	--asyncIO->drainTaskCount;
+	DS_VERIFY(dsMutex_unlock(asyncIO->mutex));
+}
+
+static unsigned int getMaxDrainTasks(const dsAsyncIO* asyncIO)
+{
+	unsigned int maxTasks = asyncIO->maxDrainTasks;
+	if (maxTasks == 0)
+		maxTasks = dsThreadPool_getThreadCount(asyncIO->threadPool);
+	if (maxTasks == 0)
+		return 1;
+	return maxTasks < MAX_POOL_TASKS ? maxTasks : MAX_POOL_TASKS;
+}
+
+static void cancelPendingRequests(dsAsyncIO* asyncIO)
+{
+	AsyncIORequest* requestNode;
+	while ((requestNode = popPendingRequest(asyncIO)) != NULL)
+	{
+		requestNode->errorCode = ECANCELED;
+		DS_VERIFY(dsList_append(&asyncIO->completedRequests, &requestNode->node));
+		DS_ASSERT(asyncIO->activeRequestCount > 0);
+		--asyncIO->activeRequestCount;
+	}
+}
+
+dsAsyncIO* dsAsyncIO_create(dsAllocator* allocator, dsThreadPool* threadPool,
+	unsigned int threadCount)
+{
+	if (!allocator)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (!allocator->freeFunc)
+	{
+		errno = EINVAL;
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Async IO allocator must support freeing memory.");
+		return NULL;
+	}
+
+	if (!threadPool && threadCount == 0)
+		threadCount = 1;
+
+	dsAsyncIO* asyncIO = DS_ALLOCATE_OBJECT(allocator, dsAsyncIO);
+	if (!asyncIO)
+		return NULL;
+
+	memset(asyncIO, 0, sizeof(dsAsyncIO));
+	asyncIO->allocator = dsAllocator_keepPointer(allocator);
+	DS_VERIFY(dsList_initialize(&asyncIO->pendingRequests));
+	DS_VERIFY(dsList_initialize(&asyncIO->completedRequests));
+
+	asyncIO->mutex = dsMutex_create(allocator, "Async IO");
+	asyncIO->requestCondition = dsConditionVariable_create(allocator, "Async IO request");
+	asyncIO->finishCondition = dsConditionVariable_create(allocator, "Async IO finish");
+	if (!asyncIO->mutex || !asyncIO->requestCondition || !asyncIO->finishCondition)
+	{
+		dsAsyncIO_destroy(asyncIO);
+		return NULL;
+	}
+
+	if (threadPool)
+	{
+		asyncIO->threadPool = threadPool;
+		asyncIO->maxDrainTasks = threadCount;
+		asyncIO->taskQueue = dsThreadTaskQueue_create(allocator, threadPool, MAX_POOL_TASKS,
+			threadCount);
+		if (!asyncIO->taskQueue)
+		{
+			dsAsyncIO_destroy(asyncIO);
+			return NULL;
+		}
+		return asyncIO;
+	}
+
+	asyncIO->threads = DS_ALLOCATE_OBJECT_ARRAY(allocator, dsThread, threadCount);
+	if (!asyncIO->threads)
+	{
+		dsAsyncIO_destroy(asyncIO);
+		return NULL;
+	}
+
+	for (unsigned int i = 0; i < threadCount; ++i)
+	{
+		if (!dsThread_create(asyncIO->threads + i, &ioThreadFunc, asyncIO, 0, "Async IO"))
+		{
+			dsAsyncIO_destroy(asyncIO);
+			return NULL;
+		}
+		++asyncIO->threadCount;
+	}
+
+	return asyncIO;
+}
+
+bool dsAsyncIO_addRequests(dsAsyncIO* asyncIO, const dsAsyncIORequest* requests,
+	uint32_t requestCount)
+{
+	if (!asyncIO || (!requests && requestCount > 0))
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	for (uint32_t i = 0; i < requestCount; ++i)
+	{
+		const dsAsyncIORequest* request = requests + i;
+		if (!request->file.path ||
+			(request->file.source == dsAsyncIOSource_Archive && !request->file.archive) ||
+			(request->buffer && request->size == 0) ||
+			(!request->buffer && (!request->allocator || !request->allocator->freeFunc)))
+		{
+			errno = EINVAL;
+			return false;
+		}
+	}
+
+	if (requestCount == 0)
+		return true;
+
+	// Allocate all requests up front so either all or none are added.
+	dsList newRequests;
+	DS_VERIFY(dsList_initialize(&newRequests));
+	for (uint32_t i = 0; i < requestCount; ++i)
+	{
+		const dsAsyncIORequest* request = requests + i;
+		size_t pathLen = strlen(request->file.path) + 1;
+		AsyncIORequest* requestNode = (AsyncIORequest*)dsAllocator_alloc(asyncIO->allocator,
+			sizeof(AsyncIORequest) + pathLen);
+		if (!requestNode)
+		{
+			dsListNode* node = newRequests.head;
+			while (node)
+			{
+				dsListNode* next = node->next;
+				DS_VERIFY(dsAllocator_free(asyncIO->allocator, node));
+				node = next;
+			}
+			return false;
+		}
+
+		requestNode->request = *request;
+		char* path = (char*)(requestNode + 1);
+		memcpy(path, request->file.path, pathLen);
+		requestNode->request.file.path = path;
+		requestNode->asyncIO = asyncIO;
+		requestNode->data = NULL;
+		requestNode->size = 0;
+		requestNode->errorCode = 0;
+		DS_VERIFY(dsList_append(&newRequests, &requestNode->node));
+	}
+
+	unsigned int maxTasks = asyncIO->taskQueue ? getMaxDrainTasks(asyncIO) : 0;
+	DS_VERIFY(dsMutex_lock(asyncIO->mutex));
+	if (asyncIO->pendingRequests.tail)
+	{
+		asyncIO->pendingRequests.tail->next = newRequests.head;
+		newRequests.head->previous = asyncIO->pendingRequests.tail;
+	}
+	else
+		asyncIO->pendingRequests.head = newRequests.head;
+	asyncIO->pendingRequests.tail = newRequests.tail;
+	asyncIO->pendingRequests.length += newRequests.length;
+	asyncIO->activeRequestCount += requestCount;
+
+	// Only add drain tasks up to the number that can run at once. Running tasks will pick up the
+	// new requests, which also keeps the task queue from filling up and running tasks on this
+	// thread.
+	uint32_t newTaskCount = 0;
+	if (asyncIO->taskQueue)
+	{
+		if (asyncIO->drainTaskCount < maxTasks)
+		{
+			newTaskCount = maxTasks - asyncIO->drainTaskCount;
+			if (newTaskCount > requestCount)
+				newTaskCount = requestCount;
+			asyncIO->drainTaskCount += newTaskCount;
+		}
+	}
+	else
+		DS_VERIFY(dsConditionVariable_notifyAll(asyncIO->requestCondition));
+	DS_VERIFY(dsMutex_unlock(asyncIO->mutex));
+
+	if (newTaskCount > 0)
+	{
+		dsThreadTask tasks[32];
+		for (uint32_t i = 0; i < DS_ARRAY_SIZE(tasks); ++i)
+		{
+			tasks[i].taskFunc = &ioTaskFunc;
+			tasks[i].userData = asyncIO;
+		}
+
+		// The requests are already queued, so adding tasks can't fail for a valid task queue.
+		for (uint32_t i = 0; i < newTaskCount; i += DS_ARRAY_SIZE(tasks))
+		{
+			uint32_t taskCount = newTaskCount - i;
+			if (taskCount > DS_ARRAY_SIZE(tasks))
+				taskCount = DS_ARRAY_SIZE(tasks);
+			DS_VERIFY(dsThreadTaskQueue_addTasks(asyncIO->taskQueue, tasks, taskCount));
+		}
+	}
+
+	return true;
+}
+
+uint32_t dsAsyncIO_getActiveRequestCount(const dsAsyncIO* asyncIO)
+{
+	if (!asyncIO)
+		return 0;
+
+	DS_VERIFY(dsMutex_lock(asyncIO->mutex));
+	uint32_t activeRequestCount = asyncIO->activeRequestCount;
+	DS_VERIFY(dsMutex_unlock(asyncIO->mutex));
+	return activeRequestCount;
+}
+
+uint32_t dsAsyncIO_processCompleted(dsAsyncIO* asyncIO)
+{
+	if (!asyncIO)
+		return 0;
+
+	DS_VERIFY(dsMutex_lock(asyncIO->mutex));
+	dsListNode* node = asyncIO->completedRequests.head;
+	DS_VERIFY(dsList_clear(&asyncIO->completedRequests));
+	DS_VERIFY(dsMutex_unlock(asyncIO->mutex));
+
+	uint32_t completedCount = 0;
+	while (node)
+	{
+		dsListNode* next = node->next;
+		AsyncIORequest* requestNode = (AsyncIORequest*)node;
+		completeRequest(requestNode);
+		DS_VERIFY(dsAllocator_free(asyncIO->allocator, requestNode));
+		++completedCount;
+		node = next;
+	}
+
+	return completedCount;
+}
+
+bool dsAsyncIO_waitForRequests(dsAsyncIO* asyncIO)
+{
+	if (!asyncIO)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	DS_PROFILE_WAIT_START("dsAsyncIO_waitForRequests");
+	DS_VERIFY(dsMutex_lock(asyncIO->mutex));
+	while (asyncIO->activeRequestCount > 0)
+		dsConditionVariable_wait(asyncIO->finishCondition, asyncIO->mutex);
+	DS_VERIFY(dsMutex_unlock(asyncIO->mutex));
+	DS_PROFILE_WAIT_END();
+
+	dsAsyncIO_processCompleted(asyncIO);
+	return true;
+}
+
+void dsAsyncIO_destroy(dsAsyncIO* asyncIO)
+{
+	if (!asyncIO)
+		return;
+
+	if (asyncIO->mutex)
+	{
+		DS_VERIFY(dsMutex_lock(asyncIO->mutex));
+		asyncIO->stop = true;
+		cancelPendingRequests(asyncIO);
+		if (asyncIO->requestCondition)
+			DS_VERIFY(dsConditionVariable_notifyAll(asyncIO->requestCondition));
+		DS_VERIFY(dsMutex_unlock(asyncIO->mutex));
+	}
+
+	for (unsigned int i = 0; i < asyncIO->threadCount; ++i)
+		DS_VERIFY(dsThread_join(asyncIO->threads + i, NULL));
+
+	// Any remaining tasks will find the pending list empty.
+	if (asyncIO->taskQueue)
+	{
+		DS_VERIFY(dsThreadTaskQueue_waitForTasks(asyncIO->taskQueue));
+		dsThreadTaskQueue_destroy(asyncIO->taskQueue);
+	}
+
+	dsAsyncIO_processCompleted(asyncIO);
+
+	DS_VERIFY(dsAllocator_free(asyncIO->allocator, asyncIO->threads));
+	dsConditionVariable_destroy(asyncIO->finishCondition);
+	dsConditionVariable_destroy(asyncIO->requestCondition);
+	dsMutex_destroy(asyncIO->mutex);
+	DS_VERIFY(dsAllocator_free(asyncIO->allocator, asyncIO));
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright 2016-2025 Aaron Barany
+ * Copyright 2016-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -76,6 +76,7 @@ static void initFileStream(dsFileStream* stream, FILE* file)
 	baseStream->seekFunc = (dsStreamSeekFunction)&dsFileStream_seek;
 	baseStream->tellFunc = (dsStreamTellFunction)&dsFileStream_tell;
 	baseStream->remainingBytesFunc = (dsStreamTellFunction)&dsFileStream_remainingBytes;
+	baseStream->getBufferFunc = NULL;
 	baseStream->restartFunc = NULL;
 	baseStream->flushFunc = (dsStreamFlushFunction)&dsFileStream_flush;
 	baseStream->closeFunc = (dsStreamCloseFunction)&dsFileStream_close;
@@ -0,0 +1,315 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Guarantee 64-bits on GNU systems.
+#define _FILE_OFFSET_BITS 64
+
+#include <DeepSea/Core/Streams/MappedFileStream.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Error.h>
+
+#include <string.h>
+
+#if DS_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Mapping an empty file isn't allowed, so point to a dummy value instead.
+static const uint8_t emptyFileData = 0;
+
+#if DS_WINDOWS
+static void setErrno(void)
+{
+	switch (GetLastError())
+	{
+		case ERROR_FILE_NOT_FOUND:
+		case ERROR_PATH_NOT_FOUND:
+			errno = ENOENT;
+			break;
+		case ERROR_ACCESS_DENIED:
+			errno = EACCES;
+			break;
+		case ERROR_NOT_ENOUGH_MEMORY:
+			errno = ENOMEM;
+			break;
+		default:
+			errno = EIO;
+			break;
+	}
+}
+
+static bool mapFile(dsMappedFileStream* stream, const char* path)
+{
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		setErrno();
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		setErrno();
+		CloseHandle(file);
+		return false;
+	}
+
+	if ((uint64_t)fileSize.QuadPart > SIZE_MAX)
+	{
+		CloseHandle(file);
+		errno = EFBIG;
+		return false;
+	}
+
+	stream->size = (size_t)fileSize.QuadPart;
+	if (stream->size == 0)
+	{
+		CloseHandle(file);
+		stream->data = &emptyFileData;
+		stream->mappingHandle = NULL;
+		return true;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	// The mapping keeps a reference to the file.
+	CloseHandle(file);
+	if (!mapping)
+	{
+		setErrno();
+		return false;
+	}
+
+	const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!data)
+	{
+		setErrno();
+		CloseHandle(mapping);
+		return false;
+	}
+
+	stream->data = data;
+	stream->mappingHandle = mapping;
+	return true;
+}
+
+static bool unmapFile(dsMappedFileStream* stream)
+{
+	if (!stream->mappingHandle)
+		return true;
+
+	if (!UnmapViewOfFile(stream->data))
+	{
+		setErrno();
+		return false;
+	}
+
+	CloseHandle(stream->mappingHandle);
+	return true;
+}
+#else
+static bool mapFile(dsMappedFileStream* stream, const char* path)
+{
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(fd, &info) != 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	if (S_ISDIR(info.st_mode))
+	{
+		close(fd);
+		errno = EISDIR;
+		return false;
+	}
+
+	if ((uint64_t)info.st_size > SIZE_MAX)
+	{
+		close(fd);
+		errno = EFBIG;
+		return false;
+	}
+
+	stream->size = (size_t)info.st_size;
+	stream->mappingHandle = NULL;
+	if (stream->size == 0)
+	{
+		close(fd);
+		stream->data = &emptyFileData;
+		return true;
+	}
+
+	void* data = mmap(NULL, stream->size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps a reference to the file.
+	close(fd);
+	if (data == MAP_FAILED)
+		return false;
+
+	stream->data = data;
+	return true;
+}
+
+static bool unmapFile(dsMappedFileStream* stream)
+{
+	if (stream->size == 0)
+		return true;
+
+	return munmap((void*)stream->data, stream->size) == 0;
+}
+#endif
+
+bool dsMappedFileStream_openPath(dsMappedFileStream* stream, const char* path)
+{
+	if (!stream || !path || *path == 0)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (!mapFile(stream, path))
+		return false;
+
+	dsStream* baseStream = (dsStream*)stream;
+	baseStream->readFunc = (dsStreamReadFunction)&dsMappedFileStream_read;
+	baseStream->writeFunc = NULL;
+	baseStream->seekFunc = (dsStreamSeekFunction)&dsMappedFileStream_seek;
+	baseStream->tellFunc = (dsStreamTellFunction)&dsMappedFileStream_tell;
+	baseStream->remainingBytesFunc = (dsStreamTellFunction)&dsMappedFileStream_remainingBytes;
+	baseStream->getBufferFunc = (dsStreamGetBufferFunction)&dsMappedFileStream_getBuffer;
+	baseStream->restartFunc = NULL;
+	baseStream->flushFunc = NULL;
+	baseStream->closeFunc = (dsStreamCloseFunction)&dsMappedFileStream_close;
+	stream->position = 0;
+	return true;
+}
+
+size_t dsMappedFileStream_read(dsMappedFileStream* stream, void* data, size_t size)
+{
+	if (!stream || !stream->data || !data)
+	{
+		errno = EINVAL;
+		return 0;
+	}
+
+	size_t remaining = stream->size - stream->position;
+	if (size > remaining)
+		size = remaining;
+
+	memcpy(data, (const uint8_t*)stream->data + stream->position, size);
+	stream->position += size;
+	DS_ASSERT(stream->position <= stream->size);
+	return size;
+}
+
+bool dsMappedFileStream_seek(dsMappedFileStream* stream, int64_t offset, dsStreamSeekWay way)
+{
+	if (!stream || !stream->data)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	int64_t position;
+	switch (way)
+	{
+		case dsStreamSeekWay_Beginning:
+			position = offset;
+			break;
+		case dsStreamSeekWay_Current:
+			position = (int64_t)stream->position + offset;
+			break;
+		case dsStreamSeekWay_End:
+			position = (int64_t)stream->size + offset;
+			break;
+		default:
+			DS_ASSERT(false);
+			errno = EINVAL;
+			return false;
+	}
+
+	if (position < 0 || (uint64_t)position > stream->size)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	stream->position = (size_t)position;
+	return true;
+}
+
+uint64_t dsMappedFileStream_tell(dsMappedFileStream* stream)
+{
+	if (!stream || !stream->data)
+	{
+		errno = EINVAL;
+		return DS_STREAM_INVALID_POS;
+	}
+
+	return stream->position;
+}
+
+uint64_t dsMappedFileStream_remainingBytes(dsMappedFileStream* stream)
+{
+	if (!stream || !stream->data)
+	{
+		errno = EINVAL;
+		return DS_STREAM_INVALID_POS;
+	}
+
+	return stream->size - stream->position;
+}
+
+const void* dsMappedFileStream_getBuffer(dsMappedFileStream* stream, size_t* outSize)
+{
+	if (!stream || !stream->data || !outSize)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	*outSize = stream->size - stream->position;
+	return (const uint8_t*)stream->data + stream->position;
+}
+
+bool dsMappedFileStream_close(dsMappedFileStream* stream)
+{
+	if (!stream || !stream->data)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (!unmapFile(stream))
+		return false;
+
+	stream->data = NULL;
+	stream->size = 0;
+	stream->position = 0;
+	stream->mappingHandle = NULL;
+	return true;
+}
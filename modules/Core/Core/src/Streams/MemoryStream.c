@@ -1,5 +1,5 @@
 /*
- * Copyright 2016-2025 Aaron Barany
+ * Copyright 2016-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -33,6 +33,7 @@ bool dsMemoryStream_open(dsMemoryStream* stream, void* buffer, size_t size)
 	baseStream->seekFunc = (dsStreamSeekFunction)&dsMemoryStream_seek;
 	baseStream->tellFunc = (dsStreamTellFunction)&dsMemoryStream_tell;
 	baseStream->remainingBytesFunc = (dsStreamTellFunction)&dsMemoryStream_remainingBytes;
+	baseStream->getBufferFunc = (dsStreamGetBufferFunction)&dsMemoryStream_getBuffer;
 	baseStream->restartFunc = NULL;
 	baseStream->flushFunc = NULL;
 	baseStream->closeFunc = (dsStreamCloseFunction)&dsMemoryStream_close;
@@ -137,6 +138,18 @@ uint64_t dsMemoryStream_remainingBytes(dsMemoryStream* stream)
 	return stream->size - stream->position;
 }
 
+const void* dsMemoryStream_getBuffer(dsMemoryStream* stream, size_t* outSize)
+{
+	if (!stream || !stream->buffer || !outSize)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	*outSize = stream->size - stream->position;
+	return (const uint8_t*)stream->buffer + stream->position;
+}
+
 bool dsMemoryStream_close(dsMemoryStream* stream)
 {
 	if (!stream || !stream->buffer)
@@ -1,5 +1,5 @@
 /*
- * Copyright 2018-2025 Aaron Barany
+ * Copyright 2018-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -605,6 +605,7 @@ bool dsResourceStream_open(dsResourceStream* stream, dsFileResourceType type, co
 			baseStream->seekFunc = (dsStreamSeekFunction)&assetSeek;
 			baseStream->tellFunc = (dsStreamTellFunction)&assetTell;
 			baseStream->remainingBytesFunc = (dsStreamTellFunction)&assetRemainingBytes;
+			baseStream->getBufferFunc = NULL;
 			baseStream->restartFunc = NULL;
 			baseStream->flushFunc = NULL;
 			baseStream->closeFunc = (dsStreamCloseFunction)&assetClose;
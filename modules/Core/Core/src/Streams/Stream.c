@@ -1,5 +1,5 @@
 /*
- * Copyright 2016-2025 Aaron Barany
+ * Copyright 2016-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -116,6 +116,8 @@ bool dsStream_seek(dsStream* stream, int64_t offset, dsStreamSeekWay way);
 uint64_t dsStream_tell(dsStream* stream);
 bool dsStream_canGetRemainingBytes(dsStream* stream);
 uint64_t dsStream_remainingBytes(dsStream* stream);
+bool dsStream_canGetBuffer(dsStream* stream);
+const void* dsStream_getBuffer(size_t* outSize, dsStream* stream);
 
 uint64_t dsStream_skip(dsStream* stream, uint64_t size)
 {
@@ -18,11 +18,15 @@
 
 #if DS_ZIP_ARCHIVE_ENABLED
 
+#include <DeepSea/Core/Containers/List.h>
+#include <DeepSea/Core/Containers/ResizeableArray.h>
 #include <DeepSea/Core/Memory/Allocator.h>
 #include <DeepSea/Core/Memory/BufferAllocator.h>
 #include <DeepSea/Core/Streams/Endian.h>
 #include <DeepSea/Core/Streams/FileStream.h>
 #include <DeepSea/Core/Streams/ResourceStream.h>
+#include <DeepSea/Core/Thread/Mutex.h>
+#include <DeepSea/Core/Thread/ThreadTaskQueue.h>
 #include <DeepSea/Core/Assert.h>
 #include <DeepSea/Core/Error.h>
 #include <DeepSea/Core/Log.h>
@@ -34,6 +38,9 @@
 #define DS_READ_BUFFER_SIZE 4096
 // 1 MB
 #define DS_DEFAULT_DECOMPRESS_BUFFER_SIZE 1048576
+// Minimum distance between inflate checkpoints, 1 MB. Each checkpoint stores the full window.
+#define DS_INFLATE_CHECKPOINT_SPACING 1048576
+#define DS_INFLATE_WINDOW_SIZE 32768
 
 #if DS_PATH_SEPARATOR != '/' || DS_PATH_ALT_SEPARATOR != 0
 #define DS_NEEDS_PATH_SEPARATOR_FIXUP 1
@@ -134,6 +141,34 @@ typedef struct dsDirectoryIteratorInfo
 	const FileEntry* endEntry;
 } dsDirectoryIteratorInfo;
 
+typedef struct InflateCheckpoint
+{
+	// Positions relative to the start of the entry, not the start of the .zip file.
+	uint64_t compressedPosition;
+	uint64_t uncompressedPosition;
+	// Number of bits from the previous compressed byte that are part of the next block.
+	uint32_t bits;
+	uint32_t windowSize;
+	uint8_t* window;
+} InflateCheckpoint;
+
+typedef struct CachedEntry
+{
+	dsListNode node;
+	const FileEntry* entry;
+	const uint8_t* data;
+	uint32_t refCount;
+	bool inCache;
+} CachedEntry;
+
+typedef struct PrefetchTask
+{
+	const dsZipArchive* archive;
+	const FileEntry* entry;
+	CachedEntry* cachedEntry;
+	int errorCode;
+} PrefetchTask;
+
 typedef struct dsCompressedZipStream
 {
 	dsStream stream;
@@ -150,6 +185,11 @@ typedef struct dsCompressedZipStream
 	uint64_t compressedPosition;
 	uint64_t uncompressedPosition;
 	zng_stream decompress;
+
+	InflateCheckpoint* checkpoints;
+	uint32_t checkpointCount;
+	uint32_t maxCheckpoints;
+	bool useCheckpoints;
 } dsCompressedZipStream;
 
 typedef struct dsUncompressedZipStream
@@ -162,6 +202,15 @@ typedef struct dsUncompressedZipStream
 	uint64_t position;
 } dsUncompressedZipStream;
 
+typedef struct dsCachedZipStream
+{
+	dsStream stream;
+
+	dsZipArchive* archive;
+	CachedEntry* cachedEntry;
+	uint64_t position;
+} dsCachedZipStream;
+
 struct dsZipArchive
 {
 	dsFileArchive archive;
@@ -173,6 +222,13 @@ struct dsZipArchive
 	FileEntry* entries;
 	size_t entryCount;
 	size_t decompressBufferSize;
+
+	// Cache of decompressed entries, with the least recently used entry at the head of the list.
+	dsMutex* cacheMutex;
+	CachedEntry** cachedEntries;
+	dsList cacheList;
+	size_t maxCacheSize;
+	size_t cacheSize;
 };
 
 static bool readUInt16(uint16_t* result, dsStream* stream)
@@ -405,10 +461,14 @@ static size_t getFullAllocSize(
 	dsMemorySize sizes[] =
 	{
 		{sizeof(char), strlen(path) + 1},
-		{sizeof(FileEntry), entryCount}
+		{sizeof(FileEntry), entryCount},
+		{sizeof(CachedEntry*), entryCount}
 	};
-	if (!dsAccumulateAlignedSizes(&fullAllocSize, sizes, DS_ARRAY_SIZE(sizes), DS_ALLOC_ALIGNMENT))
+	if (!dsAccumulateAlignedSizes(&fullAllocSize, sizes, DS_ARRAY_SIZE(sizes), DS_ALLOC_ALIGNMENT) ||
+		!dsAddAlignedSize(&fullAllocSize, dsMutex_fullAllocSize(), DS_ALLOC_ALIGNMENT))
+	{
 		return 0;
+	}
 
 	if (!dsStream_seek(stream, firstDirRecordOffset, dsStreamSeekWay_Beginning))
 	{
@@ -702,12 +762,24 @@ static dsZipArchive* openZipImpl(dsAllocator* allocator, dsFileResourceType type
 	archive->entryCount = entryCount;
 	archive->decompressBufferSize = decompressBufferSize;
 
+	archive->cachedEntries = DS_ALLOCATE_OBJECT_ARRAY(&bufferAlloc, CachedEntry*, entryCount);
+	DS_ASSERT(archive->cachedEntries || entryCount == 0);
+	if (entryCount > 0)
+		memset(archive->cachedEntries, 0, sizeof(CachedEntry*)*entryCount);
+	DS_VERIFY(dsList_initialize(&archive->cacheList));
+	archive->maxCacheSize = 0;
+	archive->cacheSize = 0;
+
 	if (!readFileEntries(&bufferAlloc, stream, path, firstDirRecordOffset, archive->entries,
 			archive->entryCount))
 	{
-		return false;
+		DS_VERIFY(dsAllocator_free(allocator, buffer));
+		return NULL;
 	}
 
+	archive->cacheMutex = dsMutex_create((dsAllocator*)&bufferAlloc, "Zip Cache");
+	DS_ASSERT(archive->cacheMutex);
+
 	dsFileArchive* baseArchive = (dsFileArchive*)archive;
 	baseArchive->getPathStatusFunc = (dsGetFileArchivePathStatusFunction)&dsZipArchive_pathStatus;
 	baseArchive->openDirectoryFunc =
@@ -799,13 +871,100 @@ static void zlibFreeFunc(void* opaque, void* address)
 	DS_VERIFY(dsAllocator_free(allocator, address));
 }
 
-static size_t dsCompressedZipStream_read(dsStream* stream, void* data, size_t size)
+static void addCheckpoint(dsCompressedZipStream* zipStream, uint64_t uncompressedPosition)
+{
+	uint64_t lastPosition = 0;
+	if (zipStream->checkpointCount > 0)
+		lastPosition = zipStream->checkpoints[zipStream->checkpointCount - 1].uncompressedPosition;
+	if (uncompressedPosition < lastPosition + DS_INFLATE_CHECKPOINT_SPACING)
+		return;
+
+	// Checkpoints are only used to speed up seeking, so ignore any allocation failures.
+	uint8_t* window =
+		DS_ALLOCATE_OBJECT_ARRAY(zipStream->allocator, uint8_t, DS_INFLATE_WINDOW_SIZE);
+	if (!window)
+		return;
+
+	uint32_t index = zipStream->checkpointCount;
+	if (!DS_RESIZEABLE_ARRAY_ADD(zipStream->allocator, zipStream->checkpoints,
+			zipStream->checkpointCount, zipStream->maxCheckpoints, 1))
+	{
+		DS_VERIFY(dsAllocator_free(zipStream->allocator, window));
+		return;
+	}
+
+	zng_stream* decompress = &zipStream->decompress;
+	InflateCheckpoint* checkpoint = zipStream->checkpoints + index;
+	checkpoint->compressedPosition = zipStream->compressedPosition - decompress->avail_in;
+	checkpoint->uncompressedPosition = uncompressedPosition;
+	checkpoint->bits = decompress->data_type & 0x7;
+	checkpoint->windowSize = 0;
+	checkpoint->window = window;
+	zng_inflateGetDictionary(decompress, window, &checkpoint->windowSize);
+}
+
+static const InflateCheckpoint* findCheckpoint(
+	const dsCompressedZipStream* zipStream, uint64_t position)
+{
+	// Find the last checkpoint at or before the position.
+	uint32_t begin = 0;
+	uint32_t end = zipStream->checkpointCount;
+	while (begin < end)
+	{
+		uint32_t mid = begin + (end - begin)/2;
+		if (zipStream->checkpoints[mid].uncompressedPosition <= position)
+			begin = mid + 1;
+		else
+			end = mid;
+	}
+
+	return begin > 0 ? zipStream->checkpoints + begin - 1 : NULL;
+}
+
+static bool restoreCheckpoint(dsCompressedZipStream* zipStream, const InflateCheckpoint* checkpoint)
+{
+	// Need to start from the previous byte if the block starts partway through it.
+	uint64_t compressedPosition = checkpoint->compressedPosition;
+	if (checkpoint->bits > 0)
+		--compressedPosition;
+	if (!dsStream_seek(zipStream->baseStream, zipStream->entry->offset + compressedPosition,
+			dsStreamSeekWay_Beginning))
+	{
+		return false;
+	}
+
+	zng_stream* decompress = &zipStream->decompress;
+	zng_inflateReset(decompress);
+	decompress->avail_in = 0;
+	decompress->next_out = (uint8_t*)zipStream->uncompressedBuffer;
+	decompress->avail_out = 0;
+	zipStream->compressedPosition = compressedPosition;
+	zipStream->uncompressedPosition = checkpoint->uncompressedPosition;
+
+	if (checkpoint->bits > 0)
+	{
+		uint8_t value;
+		if (dsStream_read(zipStream->baseStream, &value, sizeof(value)) != sizeof(value))
+		{
+			errno = EFORMAT;
+			return false;
+		}
+
+		++zipStream->compressedPosition;
+		zng_inflatePrime(decompress, checkpoint->bits, value >> (8 - checkpoint->bits));
+	}
+
+	zng_inflateSetDictionary(decompress, checkpoint->window, checkpoint->windowSize);
+	return true;
+}
+
+// dataBytes may be NULL to skip over the data.
+static size_t decompressData(dsCompressedZipStream* zipStream, uint8_t* dataBytes, size_t size)
 {
-	DS_ASSERT(stream);
-	dsCompressedZipStream* zipStream = (dsCompressedZipStream*)stream;
 	const FileEntry* entry = zipStream->entry;
 	zng_stream* decompress = &zipStream->decompress;
-	uint8_t* dataBytes = (uint8_t*)data;
+	// Stop at each block to allow for checkpoints to be added.
+	int flush = zipStream->useCheckpoints ? Z_BLOCK : Z_SYNC_FLUSH;
 	bool compressEnd = false;
 	size_t readSize = 0;
 	while (readSize < size && zipStream->uncompressedPosition < entry->uncompressedSize)
@@ -834,9 +993,10 @@ static size_t dsCompressedZipStream_read(dsStream* stream, void* data, size_t si
 				decompress->avail_in = (uint32_t)compressedReadSize;;
 			}
 
+			uint32_t prevAvailIn = decompress->avail_in;
 			decompress->next_out = (uint8_t*)zipStream->uncompressedBuffer;
 			decompress->avail_out = (uint32_t)zipStream->uncompressedBufferSize;
-			int32_t result = zng_inflate(decompress, Z_SYNC_FLUSH);
+			int32_t result = zng_inflate(decompress, flush);
 			switch (result)
 			{
 				case Z_OK:
@@ -865,21 +1025,37 @@ static size_t dsCompressedZipStream_read(dsStream* stream, void* data, size_t si
 			size_t availableBuffer = decompress->next_out - (uint8_t*)zipStream->uncompressedBuffer;
 			decompress->next_out = (uint8_t*)zipStream->uncompressedBuffer;
 			decompress->avail_out = (uint32_t)availableBuffer;
-			// Break out if no more data for some reason to avoid infinite loop.
+
+			// Bit 128 is set at a block boundary, bit 64 is set if it's the last block.
+			if (zipStream->useCheckpoints && (decompress->data_type & 128) &&
+				!(decompress->data_type & 64))
+			{
+				addCheckpoint(zipStream, zipStream->uncompressedPosition + availableBuffer);
+			}
+
 			if (decompress->avail_out == 0)
-				break;
+			{
+				// May stop at the start of a block without any output. Break out if no progress was
+				// made to avoid an infinite loop.
+				if (compressEnd || decompress->avail_in == prevAvailIn)
+					break;
+				continue;
+			}
 		}
 
 		size_t remainingSize = size - readSize;
 		size_t copySize = decompress->avail_out;
 		if (copySize > remainingSize)
 			copySize = remainingSize;
-		memcpy(dataBytes, decompress->next_out, copySize);
+		if (dataBytes)
+		{
+			memcpy(dataBytes, decompress->next_out, copySize);
+			dataBytes += copySize;
+		}
 
 		// Update buffers, sizes, and positions for the amount we copied.
 		decompress->next_out += copySize;
 		decompress->avail_out -= (uint32_t)copySize;
-		dataBytes += copySize;
 		readSize += copySize;
 		zipStream->uncompressedPosition += copySize;
 	}
@@ -887,6 +1063,79 @@ static size_t dsCompressedZipStream_read(dsStream* stream, void* data, size_t si
 	return readSize;
 }
 
+static size_t dsCompressedZipStream_read(dsStream* stream, void* data, size_t size)
+{
+	DS_ASSERT(stream);
+	return decompressData((dsCompressedZipStream*)stream, (uint8_t*)data, size);
+}
+
+static bool dsCompressedZipStream_restart(dsStream* stream);
+
+static bool dsCompressedZipStream_seek(dsStream* stream, int64_t offset, dsStreamSeekWay way)
+{
+	DS_ASSERT(stream);
+	dsCompressedZipStream* zipStream = (dsCompressedZipStream*)stream;
+	const FileEntry* entry = zipStream->entry;
+	zng_stream* decompress = &zipStream->decompress;
+	switch (way)
+	{
+		case dsStreamSeekWay_Beginning:
+			break;
+		case dsStreamSeekWay_Current:
+			offset += zipStream->uncompressedPosition;
+			break;
+		case dsStreamSeekWay_End:
+			offset += entry->uncompressedSize;
+			break;
+	}
+
+	if (offset < 0 || (uint64_t)offset > entry->uncompressedSize)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	// Check if the position is within the data that was last decompressed.
+	uint64_t position = offset;
+	uint64_t bufferStart = zipStream->uncompressedPosition -
+		(decompress->next_out - (uint8_t*)zipStream->uncompressedBuffer);
+	uint64_t bufferEnd = zipStream->uncompressedPosition + decompress->avail_out;
+	if (position >= bufferStart && position <= bufferEnd)
+	{
+		decompress->next_out = (uint8_t*)zipStream->uncompressedBuffer + (position - bufferStart);
+		decompress->avail_out = (uint32_t)(bufferEnd - position);
+		zipStream->uncompressedPosition = position;
+		return true;
+	}
+
+	// Jump to the closest checkpoint when seeking backward or if it skips ahead of the current
+	// position, otherwise need to decompress from the start when seeking backward.
+	const InflateCheckpoint* checkpoint = findCheckpoint(zipStream, position);
+	if (checkpoint && (position < zipStream->uncompressedPosition ||
+			checkpoint->uncompressedPosition > zipStream->uncompressedPosition))
+	{
+		if (!restoreCheckpoint(zipStream, checkpoint))
+			return false;
+	}
+	else if (position < zipStream->uncompressedPosition && !dsCompressedZipStream_restart(stream))
+		return false;
+
+	while (zipStream->uncompressedPosition < position)
+	{
+		uint64_t skipSize = position - zipStream->uncompressedPosition;
+		if (skipSize > SIZE_MAX)
+			skipSize = SIZE_MAX;
+		if (decompressData(zipStream, NULL, (size_t)skipSize) != skipSize)
+		{
+			// Entry ended before the expected size.
+			errno = EFORMAT;
+			return false;
+		}
+	}
+
+	return true;
+}
+
 static uint64_t dsCompressedZipStream_tell(dsStream* stream)
 {
 	DS_ASSERT(stream);
@@ -912,6 +1161,7 @@ static bool dsCompressedZipStream_restart(dsStream* stream)
 	zipStream->compressedPosition = 0;
 	zng_inflateReset(&zipStream->decompress);
 	zipStream->decompress.avail_in = 0;
+	zipStream->decompress.next_out = (uint8_t*)zipStream->uncompressedBuffer;
 	zipStream->decompress.avail_out = 0;
 	return true;
 }
@@ -922,6 +1172,10 @@ static bool dsCompressedZipStream_close(dsStream* stream)
 	dsCompressedZipStream* zipStream = (dsCompressedZipStream*)stream;
 	zng_inflateEnd(&zipStream->decompress);
 	DS_VERIFY(dsStream_close(zipStream->baseStream));
+
+	for (uint32_t i = 0; i < zipStream->checkpointCount; ++i)
+		DS_VERIFY(dsAllocator_free(zipStream->allocator, zipStream->checkpoints[i].window));
+	DS_VERIFY(dsAllocator_free(zipStream->allocator, zipStream->checkpoints));
 	return dsAllocator_free(zipStream->allocator, stream);
 }
 
@@ -1001,6 +1255,375 @@ static bool dsUncompressedZipStream_close(dsStream* stream)
 	return dsAllocator_free(zipStream->allocator, stream);
 }
 
+static bool openBaseStream(dsStream* stream, const dsZipArchive* archive, const FileEntry* entry)
+{
+	if (archive->resourceType < 0)
+	{
+		if (!dsFileStream_openPath((dsFileStream*)stream, archive->path, "rb"))
+			return false;
+	}
+	else if (!dsResourceStream_open(
+			(dsResourceStream*)stream, archive->resourceType, archive->path, "rb"))
+	{
+		return false;
+	}
+
+	if (!dsStream_seek(stream, entry->offset, dsStreamSeekWay_Beginning))
+	{
+		DS_VERIFY(dsStream_close(stream));
+		return false;
+	}
+
+	return true;
+}
+
+static CachedEntry* decompressFullEntry(const dsZipArchive* archive, const FileEntry* entry)
+{
+	DS_ASSERT(entry->compressed && entry->uncompressedSize <= SIZE_MAX);
+	size_t compressedBufferSize = archive->decompressBufferSize;
+	if (entry->compressedSize < compressedBufferSize)
+		compressedBufferSize = (size_t)entry->compressedSize;
+
+	size_t fullSize = DS_ALIGNED_SIZE(sizeof(CachedEntry), DS_ALLOC_ALIGNMENT) + (size_t)entry->uncompressedSize;
+	void* buffer = dsAllocator_alloc(archive->allocator, fullSize);
+	if (!buffer)
+		return NULL;
+
+	void* compressedBuffer = NULL;
+	if (compressedBufferSize > 0)
+	{
+		compressedBuffer = dsAllocator_alloc(archive->allocator, compressedBufferSize);
+		if (!compressedBuffer)
+		{
+			DS_VERIFY(dsAllocator_free(archive->allocator, buffer));
+			return NULL;
+		}
+	}
+
+	union
+	{
+		dsFileStream fileStream;
+		dsResourceStream resourceStream;
+	} baseStreamStorage;
+	dsStream* baseStream = (dsStream*)&baseStreamStorage;
+	if (!openBaseStream(baseStream, archive, entry))
+	{
+		DS_VERIFY(dsAllocator_free(archive->allocator, compressedBuffer));
+		DS_VERIFY(dsAllocator_free(archive->allocator, buffer));
+		return NULL;
+	}
+
+	CachedEntry* cachedEntry = (CachedEntry*)buffer;
+	uint8_t* data = (uint8_t*)buffer + DS_ALIGNED_SIZE(sizeof(CachedEntry), DS_ALLOC_ALIGNMENT);
+
+	zng_stream decompress;
+	memset(&decompress, 0, sizeof(decompress));
+	decompress.zalloc = &zlibAllocFunc;
+	decompress.zfree = &zlibFreeFunc;
+	decompress.opaque = archive->allocator;
+	int32_t result = zng_inflateInit2(&decompress, -MAX_WBITS);
+	if (result == Z_OK)
+	{
+		uint64_t compressedPosition = 0;
+		decompress.next_out = data;
+		do
+		{
+			if (decompress.avail_in == 0 && compressedPosition < entry->compressedSize)
+			{
+				uint64_t remainingSize = entry->compressedSize - compressedPosition;
+				size_t readSize = compressedBufferSize;
+				if (remainingSize < readSize)
+					readSize = (size_t)remainingSize;
+				readSize = dsStream_read(baseStream, compressedBuffer, readSize);
+				if (readSize == 0)
+				{
+					result = Z_DATA_ERROR;
+					break;
+				}
+
+				compressedPosition += readSize;
+				decompress.next_in = (uint8_t*)compressedBuffer;
+				decompress.avail_in = (uint32_t)readSize;
+			}
+
+			// Output size may be larger than what can be processed in a single call.
+			size_t remainingOutput = (size_t)entry->uncompressedSize - (decompress.next_out - data);
+			decompress.avail_out =
+				remainingOutput > UINT32_MAX ? UINT32_MAX : (uint32_t)remainingOutput;
+			result = zng_inflate(&decompress, Z_NO_FLUSH);
+		} while (result == Z_OK);
+		zng_inflateEnd(&decompress);
+
+		if (result == Z_STREAM_END && (size_t)(decompress.next_out - data) != entry->uncompressedSize)
+			result = Z_DATA_ERROR;
+	}
+
+	DS_VERIFY(dsStream_close(baseStream));
+	DS_VERIFY(dsAllocator_free(archive->allocator, compressedBuffer));
+
+	if (result != Z_STREAM_END)
+	{
+		DS_VERIFY(dsAllocator_free(archive->allocator, buffer));
+		errno = result == Z_MEM_ERROR ? ENOMEM : EFORMAT;
+		return NULL;
+	}
+
+	cachedEntry->entry = entry;
+	cachedEntry->data = data;
+	cachedEntry->refCount = 0;
+	cachedEntry->inCache = false;
+	return cachedEntry;
+}
+
+// The functions below that modify the cache must be called with the cache mutex locked.
+static void removeCachedEntry(dsZipArchive* archive, CachedEntry* cachedEntry)
+{
+	DS_ASSERT(cachedEntry->inCache);
+	DS_VERIFY(dsList_remove(&archive->cacheList, (dsListNode*)cachedEntry));
+	archive->cachedEntries[cachedEntry->entry - archive->entries] = NULL;
+	archive->cacheSize -= (size_t)cachedEntry->entry->uncompressedSize;
+	cachedEntry->inCache = false;
+
+	// Entries still used by an open stream will be freed once the stream is closed.
+	if (cachedEntry->refCount == 0)
+		DS_VERIFY(dsAllocator_free(archive->allocator, cachedEntry));
+}
+
+static void evictCachedEntries(dsZipArchive* archive, size_t requiredSize)
+{
+	while (archive->cacheList.head && archive->cacheSize + requiredSize > archive->maxCacheSize)
+		removeCachedEntry(archive, (CachedEntry*)archive->cacheList.head);
+}
+
+static void touchCachedEntry(dsZipArchive* archive, CachedEntry* cachedEntry)
+{
+	DS_VERIFY(dsList_remove(&archive->cacheList, (dsListNode*)cachedEntry));
+	DS_VERIFY(dsList_append(&archive->cacheList, (dsListNode*)cachedEntry));
+}
+
+static CachedEntry* insertCachedEntry(dsZipArchive* archive, CachedEntry* cachedEntry)
+{
+	// Another thread may have decompressed the same entry in the meantime.
+	size_t index = cachedEntry->entry - archive->entries;
+	CachedEntry* existingEntry = archive->cachedEntries[index];
+	if (existingEntry)
+	{
+		DS_VERIFY(dsAllocator_free(archive->allocator, cachedEntry));
+		touchCachedEntry(archive, existingEntry);
+		return existingEntry;
+	}
+
+	// The cache size may have been reduced while decompressing, in which case the caller keeps
+	// ownership.
+	size_t size = (size_t)cachedEntry->entry->uncompressedSize;
+	if (size > archive->maxCacheSize)
+		return cachedEntry;
+
+	evictCachedEntries(archive, size);
+	DS_VERIFY(dsList_append(&archive->cacheList, (dsListNode*)cachedEntry));
+	archive->cachedEntries[index] = cachedEntry;
+	archive->cacheSize += size;
+	cachedEntry->inCache = true;
+	return cachedEntry;
+}
+
+static bool acquireCachedEntry(
+	CachedEntry** outCachedEntry, dsZipArchive* archive, const FileEntry* entry)
+{
+	*outCachedEntry = NULL;
+	DS_VERIFY(dsMutex_lock(archive->cacheMutex));
+	if (archive->maxCacheSize == 0 || entry->uncompressedSize > archive->maxCacheSize)
+	{
+		DS_VERIFY(dsMutex_unlock(archive->cacheMutex));
+		return true;
+	}
+
+	CachedEntry* cachedEntry = archive->cachedEntries[entry - archive->entries];
+	if (cachedEntry)
+	{
+		touchCachedEntry(archive, cachedEntry);
+		++cachedEntry->refCount;
+		DS_VERIFY(dsMutex_unlock(archive->cacheMutex));
+		*outCachedEntry = cachedEntry;
+		return true;
+	}
+	DS_VERIFY(dsMutex_unlock(archive->cacheMutex));
+
+	// Decompress outside of the lock so other files can be opened in the meantime.
+	cachedEntry = decompressFullEntry(archive, entry);
+	if (!cachedEntry)
+		return false;
+
+	DS_VERIFY(dsMutex_lock(archive->cacheMutex));
+	cachedEntry = insertCachedEntry(archive, cachedEntry);
+	++cachedEntry->refCount;
+	DS_VERIFY(dsMutex_unlock(archive->cacheMutex));
+
+	*outCachedEntry = cachedEntry;
+	return true;
+}
+
+static void releaseCachedEntry(dsZipArchive* archive, CachedEntry* cachedEntry)
+{
+	DS_VERIFY(dsMutex_lock(archive->cacheMutex));
+	DS_ASSERT(cachedEntry->refCount > 0);
+	bool freeEntry = --cachedEntry->refCount == 0 && !cachedEntry->inCache;
+	DS_VERIFY(dsMutex_unlock(archive->cacheMutex));
+
+	if (freeEntry)
+		DS_VERIFY(dsAllocator_free(archive->allocator, cachedEntry));
+}
+
+static void prefetchEntryTask(void* userData)
+{
+	PrefetchTask* task = (PrefetchTask*)userData;
+	task->cachedEntry = decompressFullEntry(task->archive, task->entry);
+	if (!task->cachedEntry)
+		task->errorCode = errno;
+}
+
+static size_t dsCachedZipStream_read(dsStream* stream, void* data, size_t size)
+{
+	DS_ASSERT(stream);
+	dsCachedZipStream* zipStream = (dsCachedZipStream*)stream;
+	const CachedEntry* cachedEntry = zipStream->cachedEntry;
+	uint64_t remainingSize = cachedEntry->entry->uncompressedSize - zipStream->position;
+	if (size > remainingSize)
+		size = (size_t)remainingSize;
+	memcpy(data, cachedEntry->data + zipStream->position, size);
+	zipStream->position += size;
+	return size;
+}
+
+static bool dsCachedZipStream_seek(dsStream* stream, int64_t offset, dsStreamSeekWay way)
+{
+	DS_ASSERT(stream);
+	dsCachedZipStream* zipStream = (dsCachedZipStream*)stream;
+	const FileEntry* entry = zipStream->cachedEntry->entry;
+	switch (way)
+	{
+		case dsStreamSeekWay_Beginning:
+			break;
+		case dsStreamSeekWay_Current:
+			offset += zipStream->position;
+			break;
+		case dsStreamSeekWay_End:
+			offset += entry->uncompressedSize;
+			break;
+	}
+
+	if (offset < 0 || (uint64_t)offset > entry->uncompressedSize)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	zipStream->position = offset;
+	return true;
+}
+
+static uint64_t dsCachedZipStream_tell(dsStream* stream)
+{
+	DS_ASSERT(stream);
+	dsCachedZipStream* zipStream = (dsCachedZipStream*)stream;
+	return zipStream->position;
+}
+
+static uint64_t dsCachedZipStream_remainingBytes(dsStream* stream)
+{
+	DS_ASSERT(stream);
+	dsCachedZipStream* zipStream = (dsCachedZipStream*)stream;
+	return zipStream->cachedEntry->entry->uncompressedSize - zipStream->position;
+}
+
+static const void* dsCachedZipStream_getBuffer(dsStream* stream, size_t* outSize)
+{
+	DS_ASSERT(stream && outSize);
+	dsCachedZipStream* zipStream = (dsCachedZipStream*)stream;
+	const CachedEntry* cachedEntry = zipStream->cachedEntry;
+	*outSize = (size_t)(cachedEntry->entry->uncompressedSize - zipStream->position);
+	return cachedEntry->data + zipStream->position;
+}
+
+static bool dsCachedZipStream_restart(dsStream* stream)
+{
+	DS_ASSERT(stream);
+	dsCachedZipStream* zipStream = (dsCachedZipStream*)stream;
+	zipStream->position = 0;
+	return true;
+}
+
+static bool dsCachedZipStream_close(dsStream* stream)
+{
+	DS_ASSERT(stream);
+	dsCachedZipStream* zipStream = (dsCachedZipStream*)stream;
+	releaseCachedEntry(zipStream->archive, zipStream->cachedEntry);
+	return dsAllocator_free(zipStream->archive->allocator, stream);
+}
+
+static dsStream* openCachedStream(dsZipArchive* archive, CachedEntry* cachedEntry)
+{
+	dsCachedZipStream* zipStream = DS_ALLOCATE_OBJECT(archive->allocator, dsCachedZipStream);
+	if (!zipStream)
+	{
+		releaseCachedEntry(archive, cachedEntry);
+		return NULL;
+	}
+
+	dsStream* stream = (dsStream*)zipStream;
+	stream->readFunc = &dsCachedZipStream_read;
+	stream->writeFunc = NULL;
+	stream->seekFunc = &dsCachedZipStream_seek;
+	stream->tellFunc = &dsCachedZipStream_tell;
+	stream->remainingBytesFunc = &dsCachedZipStream_remainingBytes;
+	stream->getBufferFunc = &dsCachedZipStream_getBuffer;
+	stream->restartFunc = &dsCachedZipStream_restart;
+	stream->flushFunc = NULL;
+	stream->closeFunc = &dsCachedZipStream_close;
+
+	zipStream->archive = archive;
+	zipStream->cachedEntry = cachedEntry;
+	zipStream->position = 0;
+	return stream;
+}
+
+static const FileEntry* findFileEntry(const dsZipArchive* archive, const char* path)
+{
+	size_t pathLen = strlen(path);
+
+	// Always use / for path separator.
+#if DS_NEEDS_PATH_SEPARATOR_FIXUP
+	char finalPath[DS_PATH_MAX];
+	path = fixupPathSeparators(finalPath, sizeof(finalPath), path, pathLen);
+	if (!path)
+		return NULL;
+#endif
+
+	// Allow for leading ./. If empty after removing, the root directory was referenced.
+	path = removeLeadingDotDir(path, &pathLen);
+	if (pathLen == 0)
+	{
+		errno = ENOENT;
+		return NULL;
+	}
+
+	const FileEntry* entry = (const FileEntry*)dsBinarySearch(path, archive->entries,
+		archive->entryCount, sizeof(FileEntry), &comparePathWithEntry, (void*)pathLen);
+	if (!entry)
+	{
+		errno = ENOENT;
+		return NULL;
+	}
+
+	if (path[pathLen - 1] == '/')
+	{
+		errno = EISDIR;
+		return NULL;
+	}
+
+	return entry;
+}
+
 dsZipArchive* dsZipArchive_open(
 	dsAllocator* allocator, const char* path, size_t decompressBufferSize)
 {
@@ -1303,36 +1926,20 @@ dsStream* dsZipArchive_openFile(const dsZipArchive* archive, const char* path)
 		return NULL;
 	}
 
-	size_t pathLen = strlen(path);
-
-	// Always use / for path separator.
-#if DS_NEEDS_PATH_SEPARATOR_FIXUP
-	char finalPath[DS_PATH_MAX];
-	path = fixupPathSeparators(finalPath, sizeof(finalPath), path, pathLen);
-	if (!path)
-		return NULL;
-#endif
-
-	// Allow for leading ./. If empty after removing, the root directory was referenced.
-	path = removeLeadingDotDir(path, &pathLen);
-	if (pathLen == 0)
-	{
-		errno = ENOENT;
-		return NULL;
-	}
-
-	const FileEntry* entry = (const FileEntry*)dsBinarySearch(path, archive->entries,
-		archive->entryCount, sizeof(FileEntry), &comparePathWithEntry, (void*)pathLen);
+	const FileEntry* entry = findFileEntry(archive, path);
 	if (!entry)
-	{
-		errno = ENOENT;
 		return NULL;
-	}
 
-	if (path[pathLen - 1] == '/')
+	if (entry->compressed)
 	{
-		errno = EISDIR;
-		return NULL;
+		// The archive is only modified internally for the cache, which is guarded by a mutex.
+		dsZipArchive* mutableArchive = (dsZipArchive*)archive;
+		CachedEntry* cachedEntry;
+		if (!acquireCachedEntry(&cachedEntry, mutableArchive, entry))
+			return NULL;
+
+		if (cachedEntry)
+			return openCachedStream(mutableArchive, cachedEntry);
 	}
 
 	size_t fullSize;
@@ -1379,31 +1986,12 @@ dsStream* dsZipArchive_openFile(const dsZipArchive* archive, const char* path)
 
 	dsStream* baseStream;
 	if (archive->resourceType < 0)
-	{
-		dsFileStream* fileStream = DS_ALLOCATE_OBJECT(&bufferAlloc, dsFileStream);
-		DS_ASSERT(fileStream);
-		if (!dsFileStream_openPath(fileStream, archive->path, "rb"))
-		{
-			DS_VERIFY(dsAllocator_free(archive->allocator, stream));
-			return NULL;
-		}
-		baseStream = (dsStream*)fileStream;
-	}
+		baseStream = (dsStream*)DS_ALLOCATE_OBJECT(&bufferAlloc, dsFileStream);
 	else
+		baseStream = (dsStream*)DS_ALLOCATE_OBJECT(&bufferAlloc, dsResourceStream);
+	DS_ASSERT(baseStream);
+	if (!openBaseStream(baseStream, archive, entry))
 	{
-		dsResourceStream* resourceStream = DS_ALLOCATE_OBJECT(&bufferAlloc, dsResourceStream);
-		DS_ASSERT(resourceStream);
-		if (!dsResourceStream_open(resourceStream, archive->resourceType, archive->path, "rb"))
-		{
-			DS_VERIFY(dsAllocator_free(archive->allocator, stream));
-			return NULL;
-		}
-		baseStream = (dsStream*)resourceStream;
-	}
-
-	if (!dsStream_seek(baseStream, entry->offset, dsStreamSeekWay_Beginning))
-	{
-		DS_VERIFY(dsStream_close(baseStream));
 		DS_VERIFY(dsAllocator_free(archive->allocator, stream));
 		return NULL;
 	}
@@ -1412,9 +2000,10 @@ dsStream* dsZipArchive_openFile(const dsZipArchive* archive, const char* path)
 	{
 		stream->readFunc = &dsCompressedZipStream_read;
 		stream->writeFunc = NULL;
-		stream->seekFunc = NULL;
+		stream->seekFunc = &dsCompressedZipStream_seek;
 		stream->tellFunc = &dsCompressedZipStream_tell;
 		stream->remainingBytesFunc = &dsCompressedZipStream_remainingBytes;
+		stream->getBufferFunc = NULL;
 		stream->restartFunc = &dsCompressedZipStream_restart;
 		stream->flushFunc = NULL;
 		stream->closeFunc = &dsCompressedZipStream_close;
@@ -1433,6 +2022,11 @@ dsStream* dsZipArchive_openFile(const dsZipArchive* archive, const char* path)
 		compressedStream->uncompressedBufferSize = uncompressedBufferSize;
 		compressedStream->compressedPosition = 0;
 		compressedStream->uncompressedPosition = 0;
+		compressedStream->checkpoints = NULL;
+		compressedStream->checkpointCount = 0;
+		compressedStream->maxCheckpoints = 0;
+		compressedStream->useCheckpoints =
+			entry->uncompressedSize > DS_INFLATE_CHECKPOINT_SPACING;
 
 		memset(&compressedStream->decompress, 0, sizeof(compressedStream->decompress));
 		compressedStream->decompress.zalloc = &zlibAllocFunc;
@@ -1454,6 +2048,7 @@ dsStream* dsZipArchive_openFile(const dsZipArchive* archive, const char* path)
 				return NULL;
 		}
 
+		compressedStream->decompress.next_out = (uint8_t*)compressedStream->uncompressedBuffer;
 		return stream;
 	}
 
@@ -1462,6 +2057,7 @@ dsStream* dsZipArchive_openFile(const dsZipArchive* archive, const char* path)
 	stream->seekFunc = &dsUncompressedZipStream_seek;
 	stream->tellFunc = &dsUncompressedZipStream_tell;
 	stream->remainingBytesFunc = &dsUncompressedZipStream_remainingBytes;
+	stream->getBufferFunc = NULL;
 	stream->restartFunc = &dsUncompressedZipStream_restart;
 	stream->flushFunc = NULL;
 	stream->closeFunc = &dsUncompressedZipStream_close;
@@ -1485,10 +2081,180 @@ bool dsZipArchive_closeFile(const dsZipArchive* archive, dsStream* stream)
 	return true;
 }
 
+size_t dsZipArchive_getMaxCacheSize(const dsZipArchive* archive)
+{
+	if (!archive)
+		return 0;
+
+	return archive->maxCacheSize;
+}
+
+bool dsZipArchive_setMaxCacheSize(dsZipArchive* archive, size_t maxCacheSize)
+{
+	if (!archive)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	DS_VERIFY(dsMutex_lock(archive->cacheMutex));
+	archive->maxCacheSize = maxCacheSize;
+	evictCachedEntries(archive, 0);
+	DS_VERIFY(dsMutex_unlock(archive->cacheMutex));
+	return true;
+}
+
+size_t dsZipArchive_getCacheSize(const dsZipArchive* archive)
+{
+	if (!archive)
+		return 0;
+
+	DS_VERIFY(dsMutex_lock(archive->cacheMutex));
+	size_t cacheSize = archive->cacheSize;
+	DS_VERIFY(dsMutex_unlock(archive->cacheMutex));
+	return cacheSize;
+}
+
+bool dsZipArchive_prefetch(const dsZipArchive* archive, const char* const* paths,
+	uint32_t pathCount, dsThreadPool* threadPool)
+{
+	if (!archive || (!paths && pathCount > 0))
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (archive->maxCacheSize == 0)
+	{
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Zip archive cache must be enabled to prefetch files.");
+		errno = EPERM;
+		return false;
+	}
+
+	if (pathCount == 0)
+		return true;
+
+	size_t fullSize = DS_ALIGNED_SIZE(sizeof(PrefetchTask)*pathCount, DS_ALLOC_ALIGNMENT) +
+		DS_ALIGNED_SIZE(sizeof(dsThreadTask)*pathCount, DS_ALLOC_ALIGNMENT);
+	void* buffer = dsAllocator_alloc(archive->allocator, fullSize);
+	if (!buffer)
+		return false;
+
+	dsBufferAllocator bufferAlloc;
+	DS_VERIFY(dsBufferAllocator_initialize(&bufferAlloc, buffer, fullSize));
+	PrefetchTask* prefetchTasks = DS_ALLOCATE_OBJECT_ARRAY(&bufferAlloc, PrefetchTask, pathCount);
+	DS_ASSERT(prefetchTasks);
+	dsThreadTask* threadTasks = DS_ALLOCATE_OBJECT_ARRAY(&bufferAlloc, dsThreadTask, pathCount);
+	DS_ASSERT(threadTasks);
+
+	// The archive is only modified internally for the cache, which is guarded by a mutex.
+	dsZipArchive* mutableArchive = (dsZipArchive*)archive;
+	uint32_t taskCount = 0;
+	DS_VERIFY(dsMutex_lock(mutableArchive->cacheMutex));
+	for (uint32_t i = 0; i < pathCount; ++i)
+	{
+		if (!paths[i])
+		{
+			DS_VERIFY(dsMutex_unlock(mutableArchive->cacheMutex));
+			DS_VERIFY(dsAllocator_free(archive->allocator, buffer));
+			errno = EINVAL;
+			return false;
+		}
+
+		const FileEntry* entry = findFileEntry(archive, paths[i]);
+		if (!entry)
+		{
+			DS_VERIFY(dsMutex_unlock(mutableArchive->cacheMutex));
+			DS_VERIFY(dsAllocator_free(archive->allocator, buffer));
+			return false;
+		}
+
+		if (!entry->compressed || entry->uncompressedSize > archive->maxCacheSize ||
+			archive->cachedEntries[entry - archive->entries])
+		{
+			continue;
+		}
+
+		PrefetchTask* prefetchTask = prefetchTasks + taskCount;
+		prefetchTask->archive = archive;
+		prefetchTask->entry = entry;
+		prefetchTask->cachedEntry = NULL;
+		prefetchTask->errorCode = 0;
+
+		dsThreadTask* threadTask = threadTasks + taskCount;
+		threadTask->taskFunc = &prefetchEntryTask;
+		threadTask->userData = prefetchTask;
+		++taskCount;
+	}
+	DS_VERIFY(dsMutex_unlock(mutableArchive->cacheMutex));
+
+	bool success = true;
+	if (threadPool && taskCount > 1)
+	{
+		dsThreadTaskQueue* taskQueue =
+			dsThreadTaskQueue_create(archive->allocator, threadPool, taskCount, 0);
+		if (taskQueue)
+		{
+			success = dsThreadTaskQueue_addTasks(taskQueue, threadTasks, taskCount) &&
+				dsThreadTaskQueue_waitForTasks(taskQueue);
+			dsThreadTaskQueue_destroy(taskQueue);
+		}
+		else
+			success = false;
+	}
+	else
+	{
+		for (uint32_t i = 0; i < taskCount; ++i)
+			prefetchEntryTask(prefetchTasks + i);
+	}
+
+	// Add to the cache in the order the paths were provided to have a consistent order for
+	// eviction.
+	int errorCode = 0;
+	DS_VERIFY(dsMutex_lock(mutableArchive->cacheMutex));
+	for (uint32_t i = 0; i < taskCount; ++i)
+	{
+		PrefetchTask* prefetchTask = prefetchTasks + i;
+		if (prefetchTask->cachedEntry)
+		{
+			CachedEntry* cachedEntry = insertCachedEntry(mutableArchive, prefetchTask->cachedEntry);
+			if (!cachedEntry->inCache)
+				DS_VERIFY(dsAllocator_free(archive->allocator, cachedEntry));
+		}
+		else if (prefetchTask->errorCode != 0 && errorCode == 0)
+			errorCode = prefetchTask->errorCode;
+	}
+	DS_VERIFY(dsMutex_unlock(mutableArchive->cacheMutex));
+
+	DS_VERIFY(dsAllocator_free(archive->allocator, buffer));
+	if (!success)
+		return false;
+	else if (errorCode != 0)
+	{
+		errno = errorCode;
+		return false;
+	}
+
+	return true;
+}
+
 void dsZipArchive_close(dsZipArchive* archive)
 {
-	if (archive)
-		DS_VERIFY(dsAllocator_free(archive->allocator, archive));
+	if (!archive)
+		return;
+
+	// All streams must be closed, so nothing should reference the cached entries.
+	dsListNode* node = archive->cacheList.head;
+	while (node)
+	{
+		CachedEntry* cachedEntry = (CachedEntry*)node;
+		node = node->next;
+		DS_ASSERT(cachedEntry->refCount == 0);
+		DS_VERIFY(dsAllocator_free(archive->allocator, cachedEntry));
+	}
+
+	dsMutex_destroy(archive->cacheMutex);
+	DS_VERIFY(dsAllocator_free(archive->allocator, archive));
 }
 
 #endif
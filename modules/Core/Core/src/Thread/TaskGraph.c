@@ -0,0 +1,414 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <DeepSea/Core/Thread/TaskGraph.h>
+
+#include <DeepSea/Core/Containers/ResizeableArray.h>
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Thread/ThreadTaskQueue.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Atomic.h>
+#include <DeepSea/Core/Error.h>
+#include <DeepSea/Core/Log.h>
+#include <DeepSea/Core/Profile.h>
+
+#include <string.h>
+
+// Number of ready tasks to queue at once when a task finishes.
+#define READY_TASK_BATCH_SIZE 32
+
+typedef struct TaskNode
+{
+	dsTaskGraph* graph;
+	dsThreadTask task;
+	uint32_t predecessorCount;
+	uint32_t remainingPredecessors;
+	uint32_t firstSuccessor;
+	uint32_t successorCount;
+} TaskNode;
+
+typedef struct Dependency
+{
+	uint32_t task;
+	uint32_t predecessor;
+} Dependency;
+
+struct dsTaskGraph
+{
+	dsAllocator* allocator;
+	dsThreadTaskQueue* taskQueue;
+
+	TaskNode* nodes;
+	uint32_t nodeCount;
+	uint32_t maxNodes;
+
+	Dependency* dependencies;
+	uint32_t dependencyCount;
+	uint32_t maxDependencies;
+
+	// Flattened successor lists for all nodes, built from the dependencies before executing.
+	uint32_t* successors;
+	uint32_t successorCount;
+	uint32_t maxSuccessors;
+
+	dsThreadTask* rootTasks;
+	uint32_t rootTaskCount;
+	uint32_t maxRootTasks;
+
+	bool dirty;
+	bool executing;
+};
+
+static void runTaskNode(void* userData)
+{
+	TaskNode* node = (TaskNode*)userData;
+	dsTaskGraph* graph = node->graph;
+	do
+	{
+		if (node->task.taskFunc)
+			node->task.taskFunc(node->task.userData);
+
+		// Keep the first successor that becomes ready to continue on this thread, queueing the
+		// rest for other threads to pick up.
+		TaskNode* continuation = NULL;
+		dsThreadTask readyTasks[READY_TASK_BATCH_SIZE];
+		uint32_t readyTaskCount = 0;
+		const uint32_t* successors = graph->successors + node->firstSuccessor;
+		for (uint32_t i = 0; i < node->successorCount; ++i)
+		{
+			TaskNode* successor = graph->nodes + successors[i];
+			if (DS_ATOMIC_FETCH_ADD32(&successor->remainingPredecessors, -1) != 1)
+				continue;
+
+			if (!continuation)
+			{
+				continuation = successor;
+				continue;
+			}
+
+			if (readyTaskCount == READY_TASK_BATCH_SIZE)
+			{
+				DS_VERIFY(dsThreadTaskQueue_addTasks(graph->taskQueue, readyTasks,
+					readyTaskCount));
+				readyTaskCount = 0;
+			}
+
+			dsThreadTask* readyTask = readyTasks + readyTaskCount++;
+			readyTask->taskFunc = &runTaskNode;
+			readyTask->userData = successor;
+		}
+
+		if (readyTaskCount > 0)
+			DS_VERIFY(dsThreadTaskQueue_addTasks(graph->taskQueue, readyTasks, readyTaskCount));
+
+		node = continuation;
+	} while (node);
+}
+
+static bool buildGraph(dsTaskGraph* graph)
+{
+	TaskNode* nodes = graph->nodes;
+	for (uint32_t i = 0; i < graph->nodeCount; ++i)
+	{
+		nodes[i].predecessorCount = 0;
+		nodes[i].successorCount = 0;
+	}
+
+	for (uint32_t i = 0; i < graph->dependencyCount; ++i)
+	{
+		const Dependency* dependency = graph->dependencies + i;
+		++nodes[dependency->task].predecessorCount;
+		++nodes[dependency->predecessor].successorCount;
+	}
+
+	graph->successorCount = 0;
+	if (!DS_RESIZEABLE_ARRAY_ADD(graph->allocator, graph->successors, graph->successorCount,
+			graph->maxSuccessors, graph->dependencyCount))
+	{
+		return false;
+	}
+
+	graph->rootTaskCount = 0;
+	uint32_t firstSuccessor = 0;
+	for (uint32_t i = 0; i < graph->nodeCount; ++i)
+	{
+		TaskNode* node = nodes + i;
+		node->firstSuccessor = firstSuccessor;
+		firstSuccessor += node->successorCount;
+		// Re-populated below.
+		node->successorCount = 0;
+
+		if (node->predecessorCount > 0)
+			continue;
+
+		uint32_t rootIndex = graph->rootTaskCount;
+		if (!DS_RESIZEABLE_ARRAY_ADD(graph->allocator, graph->rootTasks, graph->rootTaskCount,
+				graph->maxRootTasks, 1))
+		{
+			return false;
+		}
+
+		dsThreadTask* rootTask = graph->rootTasks + rootIndex;
+		rootTask->taskFunc = &runTaskNode;
+		rootTask->userData = node;
+	}
+	DS_ASSERT(firstSuccessor == graph->dependencyCount);
+
+	// Keep the successors in the order the dependencies were added.
+	for (uint32_t i = 0; i < graph->dependencyCount; ++i)
+	{
+		const Dependency* dependency = graph->dependencies + i;
+		TaskNode* predecessor = nodes + dependency->predecessor;
+		graph->successors[predecessor->firstSuccessor + predecessor->successorCount++] =
+			dependency->task;
+	}
+
+	graph->dirty = false;
+	return true;
+}
+
+dsTaskGraph* dsTaskGraph_create(dsAllocator* allocator, dsThreadPool* threadPool,
+	uint32_t maxTasks, uint32_t maxConcurrency)
+{
+	if (!allocator || !threadPool || maxTasks == 0)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (!allocator->freeFunc)
+	{
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Task graph allocator must support freeing memory.");
+		errno = EINVAL;
+		return NULL;
+	}
+
+	dsTaskGraph* graph = DS_ALLOCATE_OBJECT(allocator, dsTaskGraph);
+	if (!graph)
+		return NULL;
+
+	memset(graph, 0, sizeof(dsTaskGraph));
+	graph->allocator = dsAllocator_keepPointer(allocator);
+	graph->taskQueue = dsThreadTaskQueue_create(allocator, threadPool, maxTasks, maxConcurrency);
+	if (!graph->taskQueue)
+	{
+		DS_VERIFY(dsAllocator_free(allocator, graph));
+		return NULL;
+	}
+
+	return graph;
+}
+
+uint32_t dsTaskGraph_getTaskCount(const dsTaskGraph* graph)
+{
+	return graph ? graph->nodeCount : 0;
+}
+
+uint32_t dsTaskGraph_addTask(dsTaskGraph* graph, const dsThreadTask* task,
+	const uint32_t* predecessors, uint32_t predecessorCount)
+{
+	if (!graph || (!predecessors && predecessorCount > 0))
+	{
+		errno = EINVAL;
+		return DS_TASK_GRAPH_INVALID_TASK;
+	}
+
+	if (graph->executing)
+	{
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Can't modify a task graph while it's executing.");
+		errno = EPERM;
+		return DS_TASK_GRAPH_INVALID_TASK;
+	}
+
+	uint32_t index = graph->nodeCount;
+	for (uint32_t i = 0; i < predecessorCount; ++i)
+	{
+		if (predecessors[i] >= index)
+		{
+			errno = EINDEX;
+			return DS_TASK_GRAPH_INVALID_TASK;
+		}
+	}
+
+	uint32_t firstDependency = graph->dependencyCount;
+	if (!DS_RESIZEABLE_ARRAY_ADD(graph->allocator, graph->dependencies, graph->dependencyCount,
+			graph->maxDependencies, predecessorCount))
+	{
+		return DS_TASK_GRAPH_INVALID_TASK;
+	}
+
+	if (!DS_RESIZEABLE_ARRAY_ADD(graph->allocator, graph->nodes, graph->nodeCount,
+			graph->maxNodes, 1))
+	{
+		graph->dependencyCount = firstDependency;
+		return DS_TASK_GRAPH_INVALID_TASK;
+	}
+
+	TaskNode* node = graph->nodes + index;
+	node->graph = graph;
+	if (task)
+		node->task = *task;
+	else
+	{
+		node->task.taskFunc = NULL;
+		node->task.userData = NULL;
+	}
+	node->predecessorCount = 0;
+	node->remainingPredecessors = 0;
+	node->firstSuccessor = 0;
+	node->successorCount = 0;
+
+	for (uint32_t i = 0; i < predecessorCount; ++i)
+	{
+		Dependency* dependency = graph->dependencies + firstDependency + i;
+		dependency->task = index;
+		dependency->predecessor = predecessors[i];
+	}
+
+	graph->dirty = true;
+	return index;
+}
+
+bool dsTaskGraph_addDependency(dsTaskGraph* graph, uint32_t task, uint32_t predecessor)
+{
+	if (!graph)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (graph->executing)
+	{
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Can't modify a task graph while it's executing.");
+		errno = EPERM;
+		return false;
+	}
+
+	// Requiring the predecessor to be added first guarantees there are no cycles.
+	if (task >= graph->nodeCount || predecessor >= task)
+	{
+		errno = EINDEX;
+		return false;
+	}
+
+	uint32_t index = graph->dependencyCount;
+	if (!DS_RESIZEABLE_ARRAY_ADD(graph->allocator, graph->dependencies, graph->dependencyCount,
+			graph->maxDependencies, 1))
+	{
+		return false;
+	}
+
+	Dependency* dependency = graph->dependencies + index;
+	dependency->task = task;
+	dependency->predecessor = predecessor;
+	graph->dirty = true;
+	return true;
+}
+
+bool dsTaskGraph_clear(dsTaskGraph* graph)
+{
+	if (!graph)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (graph->executing)
+	{
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Can't modify a task graph while it's executing.");
+		errno = EPERM;
+		return false;
+	}
+
+	graph->nodeCount = 0;
+	graph->dependencyCount = 0;
+	graph->successorCount = 0;
+	graph->rootTaskCount = 0;
+	graph->dirty = false;
+	return true;
+}
+
+bool dsTaskGraph_start(dsTaskGraph* graph)
+{
+	DS_PROFILE_FUNC_START();
+
+	if (!graph)
+	{
+		errno = EINVAL;
+		DS_PROFILE_FUNC_RETURN(false);
+	}
+
+	if (graph->executing)
+	{
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Task graph is already executing.");
+		errno = EPERM;
+		DS_PROFILE_FUNC_RETURN(false);
+	}
+
+	if (graph->dirty && !buildGraph(graph))
+		DS_PROFILE_FUNC_RETURN(false);
+
+	// Counters will be visible to other threads once the tasks are queued.
+	for (uint32_t i = 0; i < graph->nodeCount; ++i)
+	{
+		TaskNode* node = graph->nodes + i;
+		node->remainingPredecessors = node->predecessorCount;
+	}
+
+	graph->executing = true;
+	if (!dsThreadTaskQueue_addTasks(graph->taskQueue, graph->rootTasks, graph->rootTaskCount))
+	{
+		graph->executing = false;
+		DS_PROFILE_FUNC_RETURN(false);
+	}
+
+	DS_PROFILE_FUNC_RETURN(true);
+}
+
+bool dsTaskGraph_wait(dsTaskGraph* graph)
+{
+	DS_PROFILE_FUNC_START();
+
+	if (!graph)
+	{
+		errno = EINVAL;
+		DS_PROFILE_FUNC_RETURN(false);
+	}
+
+	if (!dsThreadTaskQueue_waitForTasks(graph->taskQueue))
+		DS_PROFILE_FUNC_RETURN(false);
+
+	graph->executing = false;
+	DS_PROFILE_FUNC_RETURN(true);
+}
+
+bool dsTaskGraph_execute(dsTaskGraph* graph)
+{
+	return dsTaskGraph_start(graph) && dsTaskGraph_wait(graph);
+}
+
+void dsTaskGraph_destroy(dsTaskGraph* graph)
+{
+	if (!graph)
+		return;
+
+	dsThreadTaskQueue_destroy(graph->taskQueue);
+	DS_VERIFY(dsAllocator_free(graph->allocator, graph->nodes));
+	DS_VERIFY(dsAllocator_free(graph->allocator, graph->dependencies));
+	DS_VERIFY(dsAllocator_free(graph->allocator, graph->successors));
+	DS_VERIFY(dsAllocator_free(graph->allocator, graph->rootTasks));
+	DS_VERIFY(dsAllocator_free(graph->allocator, graph));
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright 2023 Aaron Barany
+ * Copyright 2023-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -22,7 +22,9 @@
 #include <DeepSea/Core/Memory/Allocator.h>
 #include <DeepSea/Core/Thread/ConditionVariable.h>
 #include <DeepSea/Core/Thread/Mutex.h>
+#include <DeepSea/Core/Thread/Spinlock.h>
 #include <DeepSea/Core/Thread/Thread.h>
+#include <DeepSea/Core/Thread/ThreadStorage.h>
 #include <DeepSea/Core/Assert.h>
 #include <DeepSea/Core/Atomic.h>
 #include <DeepSea/Core/Error.h>
@@ -32,30 +34,130 @@
 #include <string.h>
 #include <math.h>
 
-static dsThreadReturnType threadFunc(void* userData)
+static DS_THREAD_LOCAL const dsThreadPool* gWorkerThreadPool;
+static DS_THREAD_LOCAL uint32_t gWorkerIndex;
+
+static void signalThreadStopping(dsThreadPool* threadPool)
 {
-	dsThreadPool* threadPool = (dsThreadPool*)userData;
+	DS_ASSERT(threadPool->waitThreadCount > 0);
+	if (--threadPool->waitThreadCount == 0)
+		DS_VERIFY(dsConditionVariable_notifyAll(threadPool->waitThreadCondition));
+}
 
-	if (threadPool->startThreadFunc)
-		threadPool->startThreadFunc(threadPool->startEndThreadUserData);
+static bool createDeques(dsThreadPool* threadPool, uint32_t dequeCount)
+{
+	for (uint32_t i = threadPool->dequeCount; i < dequeCount; ++i)
+	{
+		dsThreadPoolDeque* deque = DS_ALLOCATE_OBJECT(threadPool->allocator, dsThreadPoolDeque);
+		if (!deque)
+			return false;
+
+		DS_VERIFY(dsSpinlock_initialize(&deque->lock));
+		deque->head = 0;
+		deque->count = 0;
+
+		// Publish the deque only after it's fully initialized so other threads may access it without
+		// locking the state mutex.
+		threadPool->deques[i] = deque;
+		uint32_t newDequeCount = i + 1;
+		DS_ATOMIC_STORE32(&threadPool->dequeCount, &newDequeCount);
+	}
 
-	DS_VERIFY(dsMutex_lock(threadPool->stateMutex));
+	return true;
+}
 
-	// Find the index for this thread.
-	dsThreadID thisThreadID = dsThread_thisThreadID();
-	uint32_t threadIndex = 0;
-	for (; threadIndex < threadPool->threadCount; ++threadIndex)
+static bool reserveTask(dsThreadTaskQueue* taskQueue, dsThreadTaskQueue* onlyTaskQueue)
+{
+	if (onlyTaskQueue)
 	{
-		if (dsThread_equal(thisThreadID, dsThread_getID(threadPool->threads + threadIndex)))
-			break;
+		if (taskQueue != onlyTaskQueue)
+			return false;
+
+		DS_ATOMIC_FETCH_ADD32(&taskQueue->executingTasks, 1);
+		return true;
 	}
-	DS_ASSERT(threadIndex < threadPool->threadCount);
 
-	// Signal that this thread has started.
-	DS_ASSERT(threadPool->waitThreadCount > 0);
-	if (--threadPool->waitThreadCount == 0)
-		DS_VERIFY(dsConditionVariable_notifyAll(threadPool->waitThreadCondition));
+	uint32_t maxConcurrency;
+	DS_ATOMIC_LOAD32(&taskQueue->maxConcurrency, &maxConcurrency);
+	uint32_t curConcurrency = DS_ATOMIC_FETCH_ADD32(&taskQueue->executingTasks, 1);
+	if (maxConcurrency == 0 || curConcurrency < maxConcurrency)
+		return true;
+
+	DS_ATOMIC_FETCH_ADD32(&taskQueue->executingTasks, -1);
+	return false;
+}
+
+static void removeDequeEntry(dsThreadPoolDeque* deque, uint32_t index)
+{
+	const uint32_t mask = DS_THREAD_POOL_DEQUE_SIZE - 1;
+	uint32_t count = deque->count;
+	DS_ASSERT(index < count);
 
+	// Shift whichever side of the removed entry is smaller.
+	if (index < count/2)
+	{
+		for (uint32_t i = index; i > 0; --i)
+		{
+			deque->entries[(deque->head + i) & mask] =
+				deque->entries[(deque->head + i - 1) & mask];
+		}
+		deque->head = (deque->head + 1) & mask;
+	}
+	else
+	{
+		for (uint32_t i = index + 1; i < count; ++i)
+		{
+			deque->entries[(deque->head + i - 1) & mask] =
+				deque->entries[(deque->head + i) & mask];
+		}
+	}
+
+	--count;
+	DS_ATOMIC_STORE32(&deque->count, &count);
+}
+
+static bool popDequeTask(dsThreadTask* outTask, dsThreadTaskQueue** outTaskQueue,
+	dsThreadPoolDeque* deque, bool fromBack, dsThreadTaskQueue* onlyTaskQueue)
+{
+	// Avoid locking deques that are empty.
+	uint32_t count;
+	DS_ATOMIC_LOAD32(&deque->count, &count);
+	if (count == 0)
+		return false;
+
+	const uint32_t mask = DS_THREAD_POOL_DEQUE_SIZE - 1;
+	bool found = false;
+	dsThreadTaskQueue* skipTaskQueue = NULL;
+	DS_VERIFY(dsSpinlock_lock(&deque->lock));
+	count = deque->count;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		uint32_t index = fromBack ? count - i - 1 : i;
+		dsThreadPoolTaskEntry* entry = deque->entries + ((deque->head + index) & mask);
+		// Task queues at their max concurrency are likely to have multiple tasks in a row.
+		if (entry->taskQueue == skipTaskQueue || !reserveTask(entry->taskQueue, onlyTaskQueue))
+		{
+			skipTaskQueue = entry->taskQueue;
+			continue;
+		}
+
+		*outTask = entry->task;
+		if (outTaskQueue)
+			*outTaskQueue = entry->taskQueue;
+		// Executing tasks were incremented when reserving, so the task is always accounted for by
+		// any thread waiting on the task queue.
+		DS_ATOMIC_FETCH_ADD32(&entry->taskQueue->queuedTasks, -1);
+		removeDequeEntry(deque, index);
+		found = true;
+		break;
+	}
+	DS_VERIFY(dsSpinlock_unlock(&deque->lock));
+	return found;
+}
+
+static void processSharedTasks(dsThreadPool* threadPool, uint32_t threadIndex)
+{
+	// State mutex is locked on entry.
 	dsThreadTask curTask = {NULL, NULL};
 	do
 	{
@@ -66,10 +168,7 @@ static dsThreadReturnType threadFunc(void* userData)
 		}
 		else if (threadIndex >= threadPool->threadCount)
 		{
-			// Signal that this thread is stopping.
-			DS_ASSERT(threadPool->waitThreadCount > 0);
-			if (--threadPool->waitThreadCount == 0)
-				DS_VERIFY(dsConditionVariable_notifyAll(threadPool->waitThreadCondition));
+			signalThreadStopping(threadPool);
 			DS_VERIFY(dsMutex_unlock(threadPool->stateMutex));
 			break;
 		}
@@ -112,6 +211,91 @@ static dsThreadReturnType threadFunc(void* userData)
 		DS_VERIFY(dsMutex_lock(threadPool->stateMutex));
 		dsThreadTaskQueue_finishTask(curTaskQueue);
 	} while (true);
+}
+
+static void processWorkStealingTasks(dsThreadPool* threadPool, uint32_t threadIndex)
+{
+	// State mutex is unlocked on entry.
+	gWorkerThreadPool = threadPool;
+	gWorkerIndex = threadIndex;
+	do
+	{
+		// Generation must be loaded before searching for tasks so any tasks added during the search
+		// will prevent waiting below.
+		uint32_t generation;
+		DS_ATOMIC_LOAD32(&threadPool->taskGeneration, &generation);
+
+		uint32_t threadCount;
+		DS_ATOMIC_LOAD32(&threadPool->threadCount, &threadCount);
+		if (threadIndex < threadCount)
+		{
+			dsThreadTask curTask;
+			dsThreadTaskQueue* curTaskQueue;
+			if (dsThreadPool_popTask(&curTask, &curTaskQueue, threadPool, threadIndex, NULL))
+			{
+				DS_ASSERT(curTask.taskFunc);
+				curTask.taskFunc(curTask.userData);
+				dsThreadTaskQueue_finishTaskUnlocked(curTaskQueue);
+				continue;
+			}
+		}
+
+		DS_VERIFY(dsMutex_lock(threadPool->stateMutex));
+		if (threadPool->stop)
+		{
+			DS_VERIFY(dsMutex_unlock(threadPool->stateMutex));
+			break;
+		}
+		else if (threadIndex >= threadPool->threadCount)
+		{
+			signalThreadStopping(threadPool);
+			DS_VERIFY(dsMutex_unlock(threadPool->stateMutex));
+			break;
+		}
+
+		// Nothing to do: wait until new tasks are added.
+		DS_ATOMIC_FETCH_ADD32(&threadPool->sleepingThreads, 1);
+		uint32_t curGeneration;
+		DS_ATOMIC_LOAD32(&threadPool->taskGeneration, &curGeneration);
+		if (curGeneration == generation)
+			dsConditionVariable_wait(threadPool->stateCondition, threadPool->stateMutex);
+		DS_ATOMIC_FETCH_ADD32(&threadPool->sleepingThreads, -1);
+		DS_VERIFY(dsMutex_unlock(threadPool->stateMutex));
+	} while (true);
+	gWorkerThreadPool = NULL;
+}
+
+static dsThreadReturnType threadFunc(void* userData)
+{
+	dsThreadPool* threadPool = (dsThreadPool*)userData;
+
+	if (threadPool->startThreadFunc)
+		threadPool->startThreadFunc(threadPool->startEndThreadUserData);
+
+	DS_VERIFY(dsMutex_lock(threadPool->stateMutex));
+
+	// Find the index for this thread.
+	dsThreadID thisThreadID = dsThread_thisThreadID();
+	uint32_t threadIndex = 0;
+	for (; threadIndex < threadPool->threadCount; ++threadIndex)
+	{
+		if (dsThread_equal(thisThreadID, dsThread_getID(threadPool->threads + threadIndex)))
+			break;
+	}
+	DS_ASSERT(threadIndex < threadPool->threadCount);
+
+	// Signal that this thread has started.
+	DS_ASSERT(threadPool->waitThreadCount > 0);
+	if (--threadPool->waitThreadCount == 0)
+		DS_VERIFY(dsConditionVariable_notifyAll(threadPool->waitThreadCondition));
+
+	if (threadPool->flags & dsThreadPoolFlags_WorkStealing)
+	{
+		DS_VERIFY(dsMutex_unlock(threadPool->stateMutex));
+		processWorkStealingTasks(threadPool, threadIndex);
+	}
+	else
+		processSharedTasks(threadPool, threadIndex);
 
 	if (threadPool->endThreadFunc)
 		threadPool->endThreadFunc(threadPool->startEndThreadUserData);
@@ -164,6 +348,129 @@ void dsThreadPool_removeTaskQueue(dsThreadPool* threadPool, dsThreadTaskQueue* t
 	DS_VERIFY(dsMutex_unlock(threadPool->stateMutex));
 }
 
+uint32_t dsThreadPool_getWorkerIndex(const dsThreadPool* threadPool)
+{
+	return gWorkerThreadPool == threadPool ? gWorkerIndex : DS_THREAD_POOL_NO_WORKER;
+}
+
+uint32_t dsThreadPool_pushTasks(dsThreadPool* threadPool, dsThreadTaskQueue* taskQueue,
+	const dsThreadTask* tasks, uint32_t taskCount)
+{
+	DS_ASSERT(threadPool->flags & dsThreadPoolFlags_WorkStealing);
+	uint32_t dequeCount;
+	DS_ATOMIC_LOAD32(&threadPool->dequeCount, &dequeCount);
+	DS_ASSERT(dequeCount > 0);
+
+	// Worker threads keep tasks local for other threads to steal, while other threads spread tasks
+	// across the deques to reduce the amount of stealing required.
+	uint32_t startDeque, spreadCount;
+	uint32_t workerIndex = dsThreadPool_getWorkerIndex(threadPool);
+	if (workerIndex < dequeCount)
+	{
+		startDeque = workerIndex;
+		spreadCount = 1;
+	}
+	else
+	{
+		startDeque = (uint32_t)DS_ATOMIC_FETCH_ADD32(&threadPool->nextDeque, 1) % dequeCount;
+		spreadCount = taskCount < dequeCount ? taskCount : dequeCount;
+	}
+	uint32_t chunkSize = (taskCount + spreadCount - 1)/spreadCount;
+
+	const uint32_t mask = DS_THREAD_POOL_DEQUE_SIZE - 1;
+	uint32_t pushedCount = 0;
+	for (uint32_t i = 0; i < dequeCount && pushedCount < taskCount; ++i)
+	{
+		// Any deques past the initial spread are only used if the earlier deques were full.
+		uint32_t pushCount = taskCount - pushedCount;
+		if (i < spreadCount && pushCount > chunkSize)
+			pushCount = chunkSize;
+
+		dsThreadPoolDeque* deque = threadPool->deques[(startDeque + i) % dequeCount];
+		DS_VERIFY(dsSpinlock_lock(&deque->lock));
+		uint32_t count = deque->count;
+		uint32_t available = DS_THREAD_POOL_DEQUE_SIZE - count;
+		if (pushCount > available)
+			pushCount = available;
+
+		for (uint32_t j = 0; j < pushCount; ++j)
+		{
+			dsThreadPoolTaskEntry* entry = deque->entries + ((deque->head + count + j) & mask);
+			entry->task = tasks[pushedCount + j];
+			entry->taskQueue = taskQueue;
+		}
+		count += pushCount;
+		DS_ATOMIC_STORE32(&deque->count, &count);
+		DS_VERIFY(dsSpinlock_unlock(&deque->lock));
+
+		pushedCount += pushCount;
+	}
+
+	return pushedCount;
+}
+
+void dsThreadPool_notifyTasksAdded(dsThreadPool* threadPool)
+{
+	// Avoid locking the mutex if no threads are waiting. The generation is incremented before
+	// checking the number of waiting threads, while waiting threads are incremented before checking
+	// the generation, so one side is guaranteed to see the other's change.
+	DS_ATOMIC_FETCH_ADD32(&threadPool->taskGeneration, 1);
+	uint32_t sleepingThreads, waitingThreads;
+	DS_ATOMIC_LOAD32(&threadPool->sleepingThreads, &sleepingThreads);
+	DS_ATOMIC_LOAD32(&threadPool->waitingThreads, &waitingThreads);
+	if (sleepingThreads == 0 && waitingThreads == 0)
+		return;
+
+	DS_VERIFY(dsMutex_lock(threadPool->stateMutex));
+	if (sleepingThreads > 0)
+		DS_VERIFY(dsConditionVariable_notifyAll(threadPool->stateCondition));
+	// Also wake up any threads waiting for finish so they can also process tasks.
+	if (waitingThreads > 0)
+		DS_VERIFY(dsConditionVariable_notifyAll(threadPool->finishTasksCondition));
+	DS_VERIFY(dsMutex_unlock(threadPool->stateMutex));
+}
+
+void dsThreadPool_notifyTasksFinished(dsThreadPool* threadPool)
+{
+	uint32_t waitingThreads;
+	DS_ATOMIC_LOAD32(&threadPool->waitingThreads, &waitingThreads);
+	if (waitingThreads == 0)
+		return;
+
+	DS_VERIFY(dsMutex_lock(threadPool->stateMutex));
+	DS_VERIFY(dsConditionVariable_notifyAll(threadPool->finishTasksCondition));
+	DS_VERIFY(dsMutex_unlock(threadPool->stateMutex));
+}
+
+bool dsThreadPool_popTask(dsThreadTask* outTask, dsThreadTaskQueue** outTaskQueue,
+	dsThreadPool* threadPool, uint32_t workerIndex, dsThreadTaskQueue* taskQueue)
+{
+	uint32_t dequeCount;
+	DS_ATOMIC_LOAD32(&threadPool->dequeCount, &dequeCount);
+
+	// Take the most recent task from the worker's own deque since it's most likely to be in cache.
+	if (workerIndex < dequeCount &&
+		popDequeTask(outTask, outTaskQueue, threadPool->deques[workerIndex], true, taskQueue))
+	{
+		return true;
+	}
+
+	// Steal the oldest task from other deques, starting after the worker's own deque to spread out
+	// contention between threads.
+	uint32_t startDeque = workerIndex < dequeCount ? workerIndex + 1 : 0;
+	for (uint32_t i = 0; i < dequeCount; ++i)
+	{
+		uint32_t index = (startDeque + i) % dequeCount;
+		if (index != workerIndex &&
+			popDequeTask(outTask, outTaskQueue, threadPool->deques[index], false, taskQueue))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 unsigned int dsThreadPool_fullThreadCount(void)
 {
 	unsigned int threadCount = dsThread_logicalCoreCount();
@@ -190,8 +497,8 @@ unsigned int dsThreadPool_defaultThreadCount(void)
 }
 
 dsThreadPool* dsThreadPool_create(dsAllocator* allocator, unsigned int threadCount,
-	size_t stackSize, dsThreadTaskFunction startThreadFunc, dsThreadTaskFunction endThreadFunc,
-	void* startEndThreadUserData)
+	dsThreadPoolFlags flags, size_t stackSize, dsThreadTaskFunction startThreadFunc,
+	dsThreadTaskFunction endThreadFunc, void* startEndThreadUserData)
 {
 	if (!allocator || threadCount > DS_THREAD_POOL_MAX_THREADS)
 	{
@@ -212,6 +519,7 @@ dsThreadPool* dsThreadPool_create(dsAllocator* allocator, unsigned int threadCou
 
 	memset(threadPool, 0, sizeof(dsThreadPool));
 	threadPool->allocator = dsAllocator_keepPointer(allocator);
+	threadPool->flags = flags;
 	threadPool->stackSize = stackSize;
 	threadPool->startThreadFunc = startThreadFunc;
 	threadPool->endThreadFunc = endThreadFunc;
@@ -239,6 +547,28 @@ dsThreadPool* dsThreadPool_create(dsAllocator* allocator, unsigned int threadCou
 		return NULL;
 	}
 
+	if (flags & dsThreadPoolFlags_WorkStealing)
+	{
+		threadPool->finishTasksCondition =
+			dsConditionVariable_create(allocator, "Thread Pool Finish Tasks Condition");
+		if (!threadPool->finishTasksCondition)
+		{
+			DS_VERIFY(dsThreadPool_destroy(threadPool));
+			return NULL;
+		}
+
+		// Allocate space for the maximum number of deques up front so the array never changes while
+		// threads are accessing it. Always keep at least one deque for tasks to be added to when no
+		// threads are present.
+		threadPool->deques =
+			DS_ALLOCATE_OBJECT_ARRAY(allocator, dsThreadPoolDeque*, DS_THREAD_POOL_MAX_THREADS);
+		if (!threadPool->deques || !createDeques(threadPool, 1))
+		{
+			DS_VERIFY(dsThreadPool_destroy(threadPool));
+			return NULL;
+		}
+	}
+
 	if (!dsThreadPool_setThreadCount(threadPool, threadCount))
 	{
 		DS_VERIFY(dsThreadPool_destroy(threadPool));
@@ -248,6 +578,11 @@ dsThreadPool* dsThreadPool_create(dsAllocator* allocator, unsigned int threadCou
 	return threadPool;
 }
 
+dsThreadPoolFlags dsThreadPool_getFlags(const dsThreadPool* threadPool)
+{
+	return threadPool ? threadPool->flags : dsThreadPoolFlags_None;
+}
+
 unsigned int dsThreadPool_getThreadCount(const dsThreadPool* threadPool)
 {
 	if (!threadPool)
@@ -292,7 +627,9 @@ bool dsThreadPool_setThreadCount(dsThreadPool* threadPool, unsigned int threadCo
 
 		// Move the threads to the local array so joining doesn't depend on the thread pool state.
 		memcpy(waitThreads, threadPool->threads + threadCount, sizeof(dsThread)*stopThreadCount);
-		threadPool->threadCount = threadCount;
+		// Work stealing threads check the thread count without locking.
+		uint32_t newThreadCount = threadCount;
+		DS_ATOMIC_STORE32(&threadPool->threadCount, &newThreadCount);
 
 		// Wake threads so they can be shut down. Also ensures that thread queues with a limited
 		// concurrency will have the next tasks executed on threads that are still running.
@@ -302,9 +639,15 @@ bool dsThreadPool_setThreadCount(dsThreadPool* threadPool, unsigned int threadCo
 	{
 		uint32_t firstThread = threadPool->threadCount;
 		uint32_t newThreads = threadCount - firstThread;
-		threadPool->waitThreadCount = newThreads;
-		success = DS_RESIZEABLE_ARRAY_ADD(threadPool->allocator, threadPool->threads,
-			threadPool->threadCount, threadPool->maxThreads, newThreads);
+		// Deques are never removed so they don't need to be synchronized with other threads.
+		success = !(threadPool->flags & dsThreadPoolFlags_WorkStealing) ||
+			createDeques(threadPool, threadCount);
+		if (success)
+		{
+			threadPool->waitThreadCount = newThreads;
+			success = DS_RESIZEABLE_ARRAY_ADD(threadPool->allocator, threadPool->threads,
+				threadPool->threadCount, threadPool->maxThreads, newThreads);
+		}
 		if (success)
 		{
 			for (uint32_t i = firstThread; i < threadCount; ++i)
@@ -359,11 +702,24 @@ bool dsThreadPool_destroy(dsThreadPool* threadPool)
 	for (uint32_t i = 0; i < threadPool->threadCount; ++i)
 		dsThread_join(threadPool->threads + i, NULL);
 
+	if (threadPool->deques)
+	{
+		for (uint32_t i = 0; i < threadPool->dequeCount; ++i)
+		{
+			dsThreadPoolDeque* deque = threadPool->deques[i];
+			DS_ASSERT(deque->count == 0);
+			dsSpinlock_shutdown(&deque->lock);
+			DS_VERIFY(dsAllocator_free(threadPool->allocator, deque));
+		}
+		DS_VERIFY(dsAllocator_free(threadPool->allocator, threadPool->deques));
+	}
+
 	DS_VERIFY(dsAllocator_free(threadPool->allocator, threadPool->taskQueues));
 	DS_VERIFY(dsAllocator_free(threadPool->allocator, threadPool->threads));
 	dsMutex_destroy(threadPool->stateMutex);
 	dsConditionVariable_destroy(threadPool->stateCondition);
 	dsConditionVariable_destroy(threadPool->waitThreadCondition);
+	dsConditionVariable_destroy(threadPool->finishTasksCondition);
 	DS_VERIFY(dsAllocator_free(threadPool->allocator, threadPool));
 	return true;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright 2023 Aaron Barany
+ * Copyright 2023-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -18,9 +18,32 @@
 
 #include <DeepSea/Core/Thread/Types.h>
 
+// Maximum number of tasks for each per-thread deque when work stealing. Must be a power of two.
+#define DS_THREAD_POOL_DEQUE_SIZE 1024
+
+// Sentinel for the current thread not being a worker of the thread pool.
+#define DS_THREAD_POOL_NO_WORKER ((uint32_t)-1)
+
+typedef struct dsThreadPoolTaskEntry
+{
+	dsThreadTask task;
+	dsThreadTaskQueue* taskQueue;
+} dsThreadPoolTaskEntry;
+
+// Ring buffer of tasks. The owning thread takes tasks from the back while other threads steal from
+// the front.
+typedef struct dsThreadPoolDeque
+{
+	dsSpinlock lock;
+	uint32_t head;
+	uint32_t count;
+	dsThreadPoolTaskEntry entries[DS_THREAD_POOL_DEQUE_SIZE];
+} dsThreadPoolDeque;
+
 struct dsThreadPool
 {
 	dsAllocator* allocator;
+	dsThreadPoolFlags flags;
 	size_t stackSize;
 	dsThreadTaskFunction startThreadFunc;
 	dsThreadTaskFunction endThreadFunc;
@@ -34,6 +57,18 @@ struct dsThreadPool
 	uint32_t taskQueueCount;
 	uint32_t maxTaskQueues;
 
+	// Only used for work stealing. Deques are only ever added while running, so they may be safely
+	// accessed up to dequeCount without holding stateMutex.
+	dsThreadPoolDeque** deques;
+	uint32_t dequeCount;
+	uint32_t nextDeque;
+	uint32_t taskGeneration;
+	uint32_t sleepingThreads;
+	// Shared between all task queues to avoid accessing a task queue after its last task finished,
+	// at which point it may be destroyed.
+	dsConditionVariable* finishTasksCondition;
+	uint32_t waitingThreads;
+
 	dsMutex* stateMutex;
 	dsConditionVariable* stateCondition;
 	dsConditionVariable* waitThreadCondition;
@@ -44,3 +79,16 @@ struct dsThreadPool
 
 bool dsThreadPool_addTaskQueue(dsThreadPool* threadPool, dsThreadTaskQueue* taskQueue);
 void dsThreadPool_removeTaskQueue(dsThreadPool* threadPool, dsThreadTaskQueue* taskQueue);
+
+// Work stealing functions. None of these require stateMutex to be locked.
+uint32_t dsThreadPool_getWorkerIndex(const dsThreadPool* threadPool);
+uint32_t dsThreadPool_pushTasks(dsThreadPool* threadPool, dsThreadTaskQueue* taskQueue,
+	const dsThreadTask* tasks, uint32_t taskCount);
+void dsThreadPool_notifyTasksAdded(dsThreadPool* threadPool);
+void dsThreadPool_notifyTasksFinished(dsThreadPool* threadPool);
+
+// When taskQueue is non-NULL, only tasks for that queue will be popped and its max concurrency is
+// ignored. Otherwise the task's queue is reserved for execution based on its max concurrency. On
+// success the executing task count for the queue will have been incremented.
+bool dsThreadPool_popTask(dsThreadTask* outTask, dsThreadTaskQueue** outTaskQueue,
+	dsThreadPool* threadPool, uint32_t workerIndex, dsThreadTaskQueue* taskQueue);
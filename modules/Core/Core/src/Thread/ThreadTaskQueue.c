@@ -53,6 +53,123 @@ void dsThreadTaskQueue_finishTask(dsThreadTaskQueue* taskQueue)
 		DS_VERIFY(dsConditionVariable_notifyAll(taskQueue->finishTasksCondition));
 }
 
+void dsThreadTaskQueue_finishTaskUnlocked(dsThreadTaskQueue* taskQueue)
+{
+	dsThreadPool* threadPool = taskQueue->threadPool;
+	uint32_t prevExecutingTasks = DS_ATOMIC_FETCH_ADD32(&taskQueue->executingTasks, -1);
+	DS_ASSERT(prevExecutingTasks > 0);
+	// The task queue may be destroyed as soon as the executing tasks reach 0, so only the thread pool
+	// may be accessed afterward.
+	if (prevExecutingTasks == 1)
+		dsThreadPool_notifyTasksFinished(threadPool);
+}
+
+static void executeTask(dsThreadTaskQueue* taskQueue, const dsThreadTask* task)
+{
+	// Executing tasks must have already been incremented.
+	DS_ASSERT(task->taskFunc);
+	task->taskFunc(task->userData);
+	dsThreadTaskQueue_finishTaskUnlocked(taskQueue);
+}
+
+static bool addWorkStealingTasks(dsThreadTaskQueue* taskQueue, const dsThreadTask* tasks,
+	uint32_t taskCount)
+{
+	dsThreadPool* threadPool = taskQueue->threadPool;
+	uint32_t workerIndex = dsThreadPool_getWorkerIndex(threadPool);
+	uint32_t taskIndex = 0;
+	while (taskIndex < taskCount)
+	{
+		// Reserve space for as many tasks as possible without exceeding the max task count.
+		uint32_t remainingTasks = taskCount - taskIndex;
+		uint32_t reserveCount;
+		uint32_t queuedTasks;
+		DS_ATOMIC_LOAD32(&taskQueue->queuedTasks, &queuedTasks);
+		do
+		{
+			reserveCount = queuedTasks < taskQueue->maxTasks ?
+				taskQueue->maxTasks - queuedTasks : 0;
+			if (reserveCount > remainingTasks)
+				reserveCount = remainingTasks;
+			if (reserveCount == 0)
+				break;
+
+			uint32_t newQueuedTasks = queuedTasks + reserveCount;
+			if (DS_ATOMIC_COMPARE_EXCHANGE32(&taskQueue->queuedTasks, &queuedTasks,
+					&newQueuedTasks, true))
+			{
+				break;
+			}
+		} while (true);
+
+		if (reserveCount > 0)
+		{
+			uint32_t pushCount = dsThreadPool_pushTasks(threadPool, taskQueue, tasks + taskIndex,
+				reserveCount);
+			if (pushCount < reserveCount)
+			{
+				DS_ATOMIC_FETCH_ADD32(&taskQueue->queuedTasks,
+					-(int32_t)(reserveCount - pushCount));
+			}
+
+			if (pushCount > 0)
+			{
+				dsThreadPool_notifyTasksAdded(threadPool);
+				taskIndex += pushCount;
+				continue;
+			}
+
+			// All deques on the thread pool are full: execute the task directly.
+			DS_ATOMIC_FETCH_ADD32(&taskQueue->executingTasks, 1);
+			executeTask(taskQueue, tasks + taskIndex);
+			++taskIndex;
+			continue;
+		}
+
+		// No space: pop off the next task to execute. Other threads may have already taken all
+		// remaining tasks, in which case the next loop will have space.
+		dsThreadTask curTask;
+		if (dsThreadPool_popTask(&curTask, NULL, threadPool, workerIndex, taskQueue))
+			executeTask(taskQueue, &curTask);
+	}
+
+	return true;
+}
+
+static void waitForWorkStealingTasks(dsThreadTaskQueue* taskQueue)
+{
+	dsThreadPool* threadPool = taskQueue->threadPool;
+	uint32_t workerIndex = dsThreadPool_getWorkerIndex(threadPool);
+	do
+	{
+		dsThreadTask curTask;
+		if (dsThreadPool_popTask(&curTask, NULL, threadPool, workerIndex, taskQueue))
+		{
+			executeTask(taskQueue, &curTask);
+			continue;
+		}
+
+		// Waiting threads are incremented before checking the task counts, while the task counts
+		// are changed before checking the waiting threads, so one side is guaranteed to see the
+		// other's change.
+		DS_VERIFY(dsMutex_lock(threadPool->stateMutex));
+		DS_ATOMIC_FETCH_ADD32(&threadPool->waitingThreads, 1);
+		uint32_t queuedTasks, executingTasks;
+		DS_ATOMIC_LOAD32(&taskQueue->queuedTasks, &queuedTasks);
+		DS_ATOMIC_LOAD32(&taskQueue->executingTasks, &executingTasks);
+		bool finished = queuedTasks == 0 && executingTasks == 0;
+		// Queued tasks that couldn't be popped are in the process of being added or taken by other
+		// threads, so try again rather than waiting.
+		if (!finished && queuedTasks == 0)
+			dsConditionVariable_wait(threadPool->finishTasksCondition, threadPool->stateMutex);
+		DS_ATOMIC_FETCH_ADD32(&threadPool->waitingThreads, -1);
+		DS_VERIFY(dsMutex_unlock(threadPool->stateMutex));
+
+		if (finished)
+			break;
+	} while (true);
+}
+
 size_t dsThreadTaskQueue_sizeof(void)
 {
 	return sizeof(dsThreadTaskQueue);
@@ -108,6 +225,8 @@ dsThreadTaskQueue* dsThreadTaskQueue_create(dsAllocator* allocator,
 
 	taskQueue->maxConcurrency = maxConcurrency;
 	taskQueue->executingTasks = 0;
+	taskQueue->maxTasks = maxTasks;
+	taskQueue->queuedTasks = 0;
 
 	taskQueue->finishTasksCondition =
 		dsConditionVariable_create((dsAllocator*)&bufferAlloc, "Finish Tasks Condition");
@@ -157,7 +276,10 @@ bool dsThreadTaskQueue_setMaxConcurrency(dsThreadTaskQueue* taskQueue, uint32_t
 
 	// Wake up the threads if we increased concurrency.
 	if (prevMaxConcurrency < maxConcurrency)
+	{
+		DS_ATOMIC_FETCH_ADD32(&threadPool->taskGeneration, 1);
 		DS_VERIFY(dsConditionVariable_notifyAll(taskQueue->threadPool->stateCondition));
+	}
 
 	DS_VERIFY(dsMutex_unlock(threadPool->stateMutex));
 	return true;
@@ -187,6 +309,9 @@ bool dsThreadTaskQueue_addTasks(dsThreadTaskQueue* taskQueue, const dsThreadTask
 	}
 
 	dsThreadPool* threadPool = taskQueue->threadPool;
+	if (threadPool->flags & dsThreadPoolFlags_WorkStealing)
+		DS_PROFILE_FUNC_RETURN(addWorkStealingTasks(taskQueue, tasks, taskCount));
+
 	// Keep a local list to only need one synchronization point with the thread pool.
 	dsThreadTaskEntry* newTaskHead = NULL;
 	dsThreadTaskEntry* newTaskTail = NULL;
@@ -293,6 +418,12 @@ bool dsThreadTaskQueue_waitForTasks(dsThreadTaskQueue* taskQueue)
 	}
 
 	dsThreadPool* threadPool = taskQueue->threadPool;
+	if (threadPool->flags & dsThreadPoolFlags_WorkStealing)
+	{
+		waitForWorkStealingTasks(taskQueue);
+		DS_PROFILE_FUNC_RETURN(true);
+	}
+
 	// Queue list is synchronized with the thread pool.
 	DS_VERIFY(dsMutex_lock(threadPool->stateMutex));
 	do
@@ -1,5 +1,5 @@
 /*
- * Copyright 2023 Aaron Barany
+ * Copyright 2023-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -38,7 +38,14 @@ struct dsThreadTaskQueue
 	uint32_t executingTasks;
 	dsSpinlock addTaskLock;
 	dsConditionVariable* finishTasksCondition;
+
+	// Only used for work stealing, where tasks are stored on the thread pool.
+	uint32_t maxTasks;
+	uint32_t queuedTasks;
 };
 
 bool dsThreadTaskQueue_popTask(dsThreadTask* outTask, dsThreadTaskQueue* taskQueue);
 void dsThreadTaskQueue_finishTask(dsThreadTaskQueue* taskQueue);
+
+// Finishes a task when work stealing. The thread pool's state mutex must not be locked.
+void dsThreadTaskQueue_finishTaskUnlocked(dsThreadTaskQueue* taskQueue);
@@ -0,0 +1,723 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <DeepSea/Core/TraceProfiler.h>
+
+#include <DeepSea/Core/Containers/Hash.h>
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Streams/FileStream.h>
+#include <DeepSea/Core/Streams/Stream.h>
+#include <DeepSea/Core/Thread/Spinlock.h>
+#include <DeepSea/Core/Thread/ThreadStorage.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Atomic.h>
+#include <DeepSea/Core/Bits.h>
+#include <DeepSea/Core/Error.h>
+#include <DeepSea/Core/Log.h>
+#include <DeepSea/Core/Profile.h>
+#include <DeepSea/Core/Timer.h>
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MIN_EVENTS 64
+#define MAX_EVENTS 0x1000000
+#define THREAD_NAME_LENGTH 64
+#define INITIAL_STRING_CAPACITY 256
+#define WRITE_BUFFER_SIZE 4096
+
+typedef enum EventKind
+{
+	EventKind_Begin,
+	EventKind_End,
+	EventKind_Stat,
+	EventKind_Gpu,
+	EventKind_FrameBegin,
+	EventKind_FrameEnd
+} EventKind;
+
+typedef struct Event
+{
+	uint64_t ticks;
+	const char* name;
+	const char* category;
+	double value;
+	uint32_t kind;
+	uint32_t type;
+} Event;
+
+// Each thread only writes to its own buffer, so the write index is the only synchronization needed.
+// Indices increase monotonically, with the oldest events overwritten once the buffer is full.
+typedef struct ThreadBuffer
+{
+	Event* events;
+	uint64_t writeIndex;
+	char name[THREAD_NAME_LENGTH];
+} ThreadBuffer;
+
+typedef struct TraceProfiler
+{
+	dsAllocator* allocator;
+	uint32_t eventCount;
+	uint32_t maxThreads;
+	uint32_t maxFrames;
+
+	uint32_t bufferCount;
+	ThreadBuffer** buffers;
+	dsThreadStorage threadBuffer;
+	bool threadBufferInitialized;
+	// Guards registering new thread buffers and the thread names.
+	dsSpinlock registerLock;
+
+	uint64_t startTicks;
+	double tickScale;
+	uint64_t frameCount;
+	uint64_t* frameStarts;
+
+	// Guards the table of dynamic strings.
+	dsSpinlock stringLock;
+	char** strings;
+	uint32_t stringCapacity;
+	uint32_t stringCount;
+} TraceProfiler;
+
+typedef struct JSONWriter
+{
+	dsStream* stream;
+	size_t size;
+	bool error;
+	char buffer[WRITE_BUFFER_SIZE];
+} JSONWriter;
+
+static const char* gTypeNames[] =
+{
+	"Function",
+	"Scope",
+	"Wait",
+	"Lock"
+};
+
+static TraceProfiler* gProfiler;
+
+static char** findStringSlot(char** strings, uint32_t capacity, const char* string, uint32_t hash)
+{
+	uint32_t mask = capacity - 1;
+	for (uint32_t i = hash & mask; ; i = (i + 1) & mask)
+	{
+		if (!strings[i] || strcmp(strings[i], string) == 0)
+			return strings + i;
+	}
+}
+
+static bool growStrings(TraceProfiler* profiler)
+{
+	uint32_t newCapacity = profiler->stringCapacity*2;
+	char** newStrings = DS_ALLOCATE_OBJECT_ARRAY(profiler->allocator, char*, newCapacity);
+	if (!newStrings)
+		return false;
+
+	memset(newStrings, 0, sizeof(char*)*newCapacity);
+	for (uint32_t i = 0; i < profiler->stringCapacity; ++i)
+	{
+		char* string = profiler->strings[i];
+		if (string)
+			*findStringSlot(newStrings, newCapacity, string, dsHashString(string)) = string;
+	}
+
+	DS_VERIFY(dsAllocator_free(profiler->allocator, profiler->strings));
+	profiler->strings = newStrings;
+	profiler->stringCapacity = newCapacity;
+	return true;
+}
+
+// Dynamic names may be freed after the profile call, so they need to be copied. Each unique string
+// is only stored once to keep the memory bounded for names that repeat each frame.
+static const char* internString(TraceProfiler* profiler, const char* string)
+{
+	if (!string)
+		return NULL;
+
+	uint32_t hash = dsHashString(string);
+	DS_VERIFY(dsSpinlock_lock(&profiler->stringLock));
+	char** slot = findStringSlot(profiler->strings, profiler->stringCapacity, string, hash);
+	if (*slot)
+	{
+		DS_VERIFY(dsSpinlock_unlock(&profiler->stringLock));
+		return *slot;
+	}
+
+	if ((profiler->stringCount + 1)*2 > profiler->stringCapacity)
+	{
+		if (!growStrings(profiler))
+		{
+			DS_VERIFY(dsSpinlock_unlock(&profiler->stringLock));
+			return NULL;
+		}
+
+		slot = findStringSlot(profiler->strings, profiler->stringCapacity, string, hash);
+	}
+
+	size_t length = strlen(string) + 1;
+	char* copy = DS_ALLOCATE_OBJECT_ARRAY(profiler->allocator, char, length);
+	if (copy)
+	{
+		memcpy(copy, string, length);
+		*slot = copy;
+		++profiler->stringCount;
+	}
+	DS_VERIFY(dsSpinlock_unlock(&profiler->stringLock));
+	return copy;
+}
+
+static ThreadBuffer* getThreadBuffer(TraceProfiler* profiler)
+{
+	ThreadBuffer* buffer = (ThreadBuffer*)dsThreadStorage_get(profiler->threadBuffer);
+	if (buffer)
+		return buffer;
+
+	// Avoid taking the lock for every event once all buffers are taken.
+	uint32_t bufferCount;
+	DS_ATOMIC_LOAD32(&profiler->bufferCount, &bufferCount);
+	if (bufferCount >= profiler->maxThreads)
+		return NULL;
+
+	DS_VERIFY(dsSpinlock_lock(&profiler->registerLock));
+	bufferCount = profiler->bufferCount;
+	if (bufferCount < profiler->maxThreads)
+	{
+		buffer = (ThreadBuffer*)dsAllocator_alloc(profiler->allocator,
+			DS_ALIGNED_SIZE(sizeof(ThreadBuffer), DS_ALLOC_ALIGNMENT) +
+				sizeof(Event)*profiler->eventCount);
+		if (buffer)
+		{
+			memset(buffer, 0, sizeof(ThreadBuffer));
+			buffer->events = (Event*)((uint8_t*)buffer +
+				DS_ALIGNED_SIZE(sizeof(ThreadBuffer), DS_ALLOC_ALIGNMENT));
+
+			// Publish the buffer before the count so exporting never sees a NULL buffer.
+			profiler->buffers[bufferCount] = buffer;
+			++bufferCount;
+			DS_ATOMIC_STORE32(&profiler->bufferCount, &bufferCount);
+			dsThreadStorage_set(profiler->threadBuffer, buffer);
+		}
+	}
+	DS_VERIFY(dsSpinlock_unlock(&profiler->registerLock));
+	return buffer;
+}
+
+static void addEvent(TraceProfiler* profiler, EventKind kind, uint32_t type, const char* name,
+	const char* category, double value, uint64_t ticks)
+{
+	ThreadBuffer* buffer = getThreadBuffer(profiler);
+	if (!buffer)
+		return;
+
+	uint64_t writeIndex = buffer->writeIndex;
+	Event* event = buffer->events + (writeIndex & (profiler->eventCount - 1));
+	event->ticks = ticks;
+	event->name = name;
+	event->category = category;
+	event->value = value;
+	event->kind = kind;
+	event->type = type;
+
+	++writeIndex;
+	DS_ATOMIC_STORE64(&buffer->writeIndex, &writeIndex);
+}
+
+static void registerThread(void* userData, const char* name)
+{
+	TraceProfiler* profiler = (TraceProfiler*)userData;
+	ThreadBuffer* buffer = getThreadBuffer(profiler);
+	if (!buffer || !name)
+		return;
+
+	DS_VERIFY(dsSpinlock_lock(&profiler->registerLock));
+	strncpy(buffer->name, name, THREAD_NAME_LENGTH - 1);
+	buffer->name[THREAD_NAME_LENGTH - 1] = 0;
+	DS_VERIFY(dsSpinlock_unlock(&profiler->registerLock));
+}
+
+static void startFrame(void* userData)
+{
+	TraceProfiler* profiler = (TraceProfiler*)userData;
+	uint64_t ticks = dsTimer_currentTicks();
+	if (profiler->maxFrames > 0)
+	{
+		uint64_t frameCount;
+		DS_ATOMIC_LOAD64(&profiler->frameCount, &frameCount);
+		DS_ATOMIC_STORE64(profiler->frameStarts + frameCount % (profiler->maxFrames + 1), &ticks);
+		++frameCount;
+		DS_ATOMIC_STORE64(&profiler->frameCount, &frameCount);
+	}
+
+	addEvent(profiler, EventKind_FrameBegin, 0, NULL, NULL, 0.0, ticks);
+}
+
+static void endFrame(void* userData)
+{
+	addEvent((TraceProfiler*)userData, EventKind_FrameEnd, 0, NULL, NULL, 0.0,
+		dsTimer_currentTicks());
+}
+
+static void push(void* userData, void** localData, dsProfileType type, const char* name,
+	const char* file, const char* function, unsigned int line, bool dynamicName)
+{
+	DS_UNUSED(localData);
+	DS_UNUSED(file);
+	DS_UNUSED(function);
+	DS_UNUSED(line);
+
+	TraceProfiler* profiler = (TraceProfiler*)userData;
+	uint64_t ticks = dsTimer_currentTicks();
+	if (dynamicName)
+		name = internString(profiler, name);
+	addEvent(profiler, EventKind_Begin, type, name, NULL, 0.0, ticks);
+}
+
+static void pop(void* userData, dsProfileType type, const char* file, const char* function,
+	unsigned int line)
+{
+	DS_UNUSED(file);
+	DS_UNUSED(function);
+	DS_UNUSED(line);
+	addEvent((TraceProfiler*)userData, EventKind_End, type, NULL, NULL, 0.0,
+		dsTimer_currentTicks());
+}
+
+static void statValue(void* userData, void** localData, const char* category, const char* name,
+	double value, const char* file, const char* function, unsigned int line, bool dynamicName)
+{
+	DS_UNUSED(localData);
+	DS_UNUSED(file);
+	DS_UNUSED(function);
+	DS_UNUSED(line);
+
+	TraceProfiler* profiler = (TraceProfiler*)userData;
+	uint64_t ticks = dsTimer_currentTicks();
+	if (dynamicName)
+		name = internString(profiler, name);
+	addEvent(profiler, EventKind_Stat, 0, name, category, value, ticks);
+}
+
+static void gpuValue(void* userData, const char* category, const char* name, uint64_t timeNs)
+{
+	TraceProfiler* profiler = (TraceProfiler*)userData;
+	uint64_t ticks = dsTimer_currentTicks();
+	addEvent(profiler, EventKind_Gpu, 0, internString(profiler, name),
+		internString(profiler, category), (double)timeNs*1e-6, ticks);
+}
+
+static void destroyProfiler(TraceProfiler* profiler)
+{
+	dsAllocator* allocator = profiler->allocator;
+	for (uint32_t i = 0; i < profiler->bufferCount; ++i)
+		DS_VERIFY(dsAllocator_free(allocator, profiler->buffers[i]));
+	DS_VERIFY(dsAllocator_free(allocator, profiler->buffers));
+	DS_VERIFY(dsAllocator_free(allocator, profiler->frameStarts));
+
+	if (profiler->strings)
+	{
+		for (uint32_t i = 0; i < profiler->stringCapacity; ++i)
+			DS_VERIFY(dsAllocator_free(allocator, profiler->strings[i]));
+		DS_VERIFY(dsAllocator_free(allocator, profiler->strings));
+	}
+
+	if (profiler->threadBufferInitialized)
+		dsThreadStorage_shutdown(&profiler->threadBuffer);
+	dsSpinlock_shutdown(&profiler->registerLock);
+	dsSpinlock_shutdown(&profiler->stringLock);
+	DS_VERIFY(dsAllocator_free(allocator, profiler));
+}
+
+static uint64_t getFrameCutoff(const TraceProfiler* profiler)
+{
+	if (profiler->maxFrames == 0)
+		return 0;
+
+	uint64_t frameCount;
+	DS_ATOMIC_LOAD64(&profiler->frameCount, &frameCount);
+	if (frameCount <= profiler->maxFrames)
+		return 0;
+
+	// The frame starts have an extra element so the oldest frame kept won't be replaced by a frame
+	// started while exporting.
+	uint64_t cutoff;
+	DS_ATOMIC_LOAD64(
+		profiler->frameStarts + (frameCount - profiler->maxFrames) % (profiler->maxFrames + 1),
+		&cutoff);
+	return cutoff;
+}
+
+static void flushJSON(JSONWriter* writer)
+{
+	if (writer->error || writer->size == 0)
+		return;
+
+	if (dsStream_write(writer->stream, writer->buffer, writer->size) != writer->size)
+		writer->error = true;
+	writer->size = 0;
+}
+
+static void writeJSONData(JSONWriter* writer, const char* data, size_t size)
+{
+	while (size > 0 && !writer->error)
+	{
+		if (writer->size == WRITE_BUFFER_SIZE)
+			flushJSON(writer);
+
+		size_t copySize = WRITE_BUFFER_SIZE - writer->size;
+		if (copySize > size)
+			copySize = size;
+		memcpy(writer->buffer + writer->size, data, copySize);
+		writer->size += copySize;
+		data += copySize;
+		size -= copySize;
+	}
+}
+
+static void writeJSONFormat(JSONWriter* writer, const char* format, ...)
+{
+	char buffer[128];
+	va_list args;
+	va_start(args, format);
+	int length = vsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
+	DS_ASSERT(length >= 0 && (size_t)length < sizeof(buffer));
+	writeJSONData(writer, buffer, length);
+}
+
+static void writeJSONString(JSONWriter* writer, const char* string)
+{
+	writeJSONData(writer, "\"", 1);
+	if (string)
+	{
+		const char* start = string;
+		for (const char* c = string; *c; ++c)
+		{
+			if (*c != '"' && *c != '\\' && (unsigned char)*c >= 0x20)
+				continue;
+
+			writeJSONData(writer, start, c - start);
+			if (*c == '"' || *c == '\\')
+				writeJSONFormat(writer, "\\%c", *c);
+			else
+				writeJSONFormat(writer, "\\u%04x", (unsigned int)(unsigned char)*c);
+			start = c + 1;
+		}
+		writeJSONData(writer, start, strlen(start));
+	}
+	writeJSONData(writer, "\"", 1);
+}
+
+static void writeJSONEvent(JSONWriter* writer, const TraceProfiler* profiler, const Event* event,
+	uint32_t threadID)
+{
+	double timestamp = (double)(event->ticks - profiler->startTicks)*profiler->tickScale*1e6;
+	double value = isfinite(event->value) ? event->value : 0.0;
+	switch (event->kind)
+	{
+		case EventKind_Begin:
+			writeJSONData(writer, "{\"name\":", 8);
+			writeJSONString(writer, event->name);
+			writeJSONData(writer, ",\"cat\":", 7);
+			writeJSONString(writer, gTypeNames[event->type]);
+			writeJSONFormat(writer, ",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", timestamp,
+				threadID);
+			break;
+		case EventKind_FrameBegin:
+			writeJSONFormat(writer,
+				"{\"name\":\"Frame\",\"cat\":\"Frame\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,"
+				"\"tid\":%u}", timestamp, threadID);
+			break;
+		case EventKind_End:
+		case EventKind_FrameEnd:
+			writeJSONFormat(writer, "{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", timestamp,
+				threadID);
+			break;
+		case EventKind_Stat:
+		case EventKind_Gpu:
+			writeJSONData(writer, "{\"name\":", 8);
+			writeJSONString(writer, event->name);
+			writeJSONData(writer, ",\"cat\":", 7);
+			writeJSONString(writer, event->category);
+			writeJSONFormat(writer,
+				",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"%s\":%.9g}}",
+				timestamp, threadID, event->kind == EventKind_Gpu ? "ms" : "value", value);
+			break;
+		default:
+			DS_ASSERT(false);
+			break;
+	}
+}
+
+static void writeJSONSeparator(JSONWriter* writer, bool* first)
+{
+	if (*first)
+		*first = false;
+	else
+		writeJSONData(writer, ",\n", 2);
+}
+
+static void writeThreadEvents(JSONWriter* writer, TraceProfiler* profiler, ThreadBuffer* buffer,
+	uint32_t threadID, Event* events, uint64_t cutoffTicks, bool* first)
+{
+	char name[THREAD_NAME_LENGTH];
+	DS_VERIFY(dsSpinlock_lock(&profiler->registerLock));
+	memcpy(name, buffer->name, THREAD_NAME_LENGTH);
+	DS_VERIFY(dsSpinlock_unlock(&profiler->registerLock));
+
+	if (name[0])
+	{
+		writeJSONSeparator(writer, first);
+		writeJSONFormat(writer,
+			"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+			threadID);
+		writeJSONString(writer, name);
+		writeJSONData(writer, "}}", 2);
+	}
+
+	// Copy the events out first since the thread may continue to write while exporting.
+	uint64_t eventCount = profiler->eventCount;
+	uint64_t endIndex;
+	DS_ATOMIC_LOAD64(&buffer->writeIndex, &endIndex);
+	uint64_t beginIndex = endIndex > eventCount ? endIndex - eventCount : 0;
+	for (uint64_t i = beginIndex; i < endIndex; ++i)
+		events[i - beginIndex] = buffer->events[i & (eventCount - 1)];
+
+	// Any events written during the copy may have overwritten the oldest events, and the next
+	// event may be partially written.
+	uint64_t latestIndex;
+	DS_ATOMIC_LOAD64(&buffer->writeIndex, &latestIndex);
+	uint64_t validIndex = beginIndex;
+	if (latestIndex + 1 > beginIndex + eventCount)
+		validIndex = latestIndex + 1 - eventCount;
+
+	// Track the depth to skip ends for scopes that begin before the exported range.
+	uint32_t depth = 0;
+	for (uint64_t i = validIndex; i < endIndex; ++i)
+	{
+		const Event* event = events + (i - beginIndex);
+		if (event->ticks < cutoffTicks)
+			continue;
+
+		if (event->kind == EventKind_Begin || event->kind == EventKind_FrameBegin)
+			++depth;
+		else if (event->kind == EventKind_End || event->kind == EventKind_FrameEnd)
+		{
+			if (depth == 0)
+				continue;
+			--depth;
+		}
+
+		writeJSONSeparator(writer, first);
+		writeJSONEvent(writer, profiler, event, threadID);
+	}
+}
+
+bool dsTraceProfiler_start(dsAllocator* allocator, uint32_t eventsPerThread,
+	uint32_t maxThreads, uint32_t maxFrames)
+{
+	if (!allocator || eventsPerThread > MAX_EVENTS)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (!allocator->freeFunc)
+	{
+		errno = EINVAL;
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Trace profiler allocator must support freeing memory.");
+		return false;
+	}
+
+	if (dsProfile_getFunctions()->pushFunc)
+	{
+		errno = EPERM;
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Profiler already started.");
+		return false;
+	}
+
+	if (eventsPerThread == 0)
+		eventsPerThread = DS_DEFAULT_TRACE_PROFILER_EVENTS;
+	else if (eventsPerThread < MIN_EVENTS)
+		eventsPerThread = MIN_EVENTS;
+	if (maxThreads == 0)
+		maxThreads = DS_DEFAULT_TRACE_PROFILER_MAX_THREADS;
+
+	TraceProfiler* profiler = DS_ALLOCATE_OBJECT(allocator, TraceProfiler);
+	if (!profiler)
+		return false;
+
+	memset(profiler, 0, sizeof(TraceProfiler));
+	profiler->allocator = dsAllocator_keepPointer(allocator);
+	profiler->eventCount = eventsPerThread;
+	if (!DS_IS_POWER_OF_2(profiler->eventCount))
+		profiler->eventCount = 1U << (32 - dsClz(profiler->eventCount));
+	profiler->maxThreads = maxThreads;
+	profiler->maxFrames = maxFrames;
+	DS_VERIFY(dsSpinlock_initialize(&profiler->registerLock));
+	DS_VERIFY(dsSpinlock_initialize(&profiler->stringLock));
+
+	profiler->buffers = DS_ALLOCATE_OBJECT_ARRAY(allocator, ThreadBuffer*, maxThreads);
+	if (!profiler->buffers)
+	{
+		destroyProfiler(profiler);
+		return false;
+	}
+
+	if (maxFrames > 0)
+	{
+		profiler->frameStarts = DS_ALLOCATE_OBJECT_ARRAY(allocator, uint64_t, maxFrames + 1);
+		if (!profiler->frameStarts)
+		{
+			destroyProfiler(profiler);
+			return false;
+		}
+	}
+
+	profiler->stringCapacity = INITIAL_STRING_CAPACITY;
+	profiler->strings = DS_ALLOCATE_OBJECT_ARRAY(allocator, char*, profiler->stringCapacity);
+	if (!profiler->strings)
+	{
+		destroyProfiler(profiler);
+		return false;
+	}
+	memset(profiler->strings, 0, sizeof(char*)*profiler->stringCapacity);
+
+	if (!dsThreadStorage_initialize(&profiler->threadBuffer))
+	{
+		destroyProfiler(profiler);
+		return false;
+	}
+	profiler->threadBufferInitialized = true;
+
+	profiler->tickScale = dsTimer_create().scale;
+	profiler->startTicks = dsTimer_currentTicks();
+	gProfiler = profiler;
+
+	dsProfileFunctions functions =
+	{
+		&registerThread, &startFrame, &endFrame, &push, &pop, &statValue, &gpuValue
+	};
+	dsProfile_setFunctions(profiler, &functions);
+	return true;
+}
+
+bool dsTraceProfiler_isStarted(void)
+{
+	return gProfiler != NULL;
+}
+
+bool dsTraceProfiler_writeJSON(dsStream* stream)
+{
+	if (!stream)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	TraceProfiler* profiler = gProfiler;
+	if (!profiler)
+	{
+		errno = EPERM;
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Trace profiler not started.");
+		return false;
+	}
+
+	Event* events = DS_ALLOCATE_OBJECT_ARRAY(profiler->allocator, Event, profiler->eventCount);
+	if (!events)
+		return false;
+
+	JSONWriter* writer = DS_ALLOCATE_OBJECT(profiler->allocator, JSONWriter);
+	if (!writer)
+	{
+		DS_VERIFY(dsAllocator_free(profiler->allocator, events));
+		return false;
+	}
+
+	writer->stream = stream;
+	writer->size = 0;
+	writer->error = false;
+
+	uint64_t cutoffTicks = getFrameCutoff(profiler);
+	writeJSONData(writer, "{\"traceEvents\":[\n", 17);
+	bool first = true;
+	uint32_t bufferCount;
+	DS_ATOMIC_LOAD32(&profiler->bufferCount, &bufferCount);
+	for (uint32_t i = 0; i < bufferCount; ++i)
+	{
+		writeThreadEvents(writer, profiler, profiler->buffers[i], i + 1, events, cutoffTicks,
+			&first);
+	}
+	writeJSONData(writer, "\n]}\n", 4);
+	flushJSON(writer);
+
+	bool success = !writer->error;
+	DS_VERIFY(dsAllocator_free(profiler->allocator, writer));
+	DS_VERIFY(dsAllocator_free(profiler->allocator, events));
+	if (!success)
+	{
+		errno = EIO;
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Couldn't write trace profiler events.");
+	}
+	return success;
+}
+
+bool dsTraceProfiler_writeJSONFile(const char* filePath)
+{
+	if (!filePath)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (!gProfiler)
+	{
+		errno = EPERM;
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Trace profiler not started.");
+		return false;
+	}
+
+	dsFileStream stream;
+	if (!dsFileStream_openPath(&stream, filePath, "w"))
+	{
+		DS_LOG_ERROR_F(DS_CORE_LOG_TAG, "Couldn't open trace file '%s'.", filePath);
+		return false;
+	}
+
+	bool success = dsTraceProfiler_writeJSON((dsStream*)&stream);
+	DS_VERIFY(dsFileStream_close(&stream));
+	return success;
+}
+
+bool dsTraceProfiler_stop(void)
+{
+	TraceProfiler* profiler = gProfiler;
+	if (!profiler)
+	{
+		errno = EPERM;
+		DS_LOG_ERROR(DS_CORE_LOG_TAG, "Trace profiler not started.");
+		return false;
+	}
+
+	dsProfile_clearFunctions();
+	gProfiler = NULL;
+	destroyProfiler(profiler);
+	return true;
+}
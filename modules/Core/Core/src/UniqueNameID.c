@@ -17,9 +17,8 @@
 #include <DeepSea/Core/UniqueNameID.h>
 
 #include <DeepSea/Core/Containers/Hash.h>
-#include <DeepSea/Core/Containers/HashTable.h>
+#include <DeepSea/Core/Containers/HashMap.h>
 #include <DeepSea/Core/Memory/Allocator.h>
-#include <DeepSea/Core/Memory/BufferAllocator.h>
 #include <DeepSea/Core/Thread/Spinlock.h>
 #include <DeepSea/Core/Assert.h>
 #include <DeepSea/Core/Error.h>
@@ -27,18 +26,11 @@
 
 #include <string.h>
 
-typedef struct UniqueNameNode
-{
-	dsHashTableNode node;
-	uint32_t id;
-} UniqueNameNode;
-
 typedef struct dsUniqueNameIDs
 {
 	dsAllocator* allocator;
-	dsHashTable* hashTable;
+	dsHashMap hashMap;
 	dsSpinlock lock;
-	uint32_t nameLimit;
 	uint32_t nextID;
 } dsUniqueNameIDs;
 
@@ -69,20 +61,15 @@ bool dsUniqueNameID_initialize(dsAllocator* allocator, uint32_t initialNameLimit
 	if (!uniqueNameIDs)
 		return false;
 
-	size_t tableSize = dsHashTable_tableSize(initialNameLimit);
-	size_t hashTableSize = dsHashTable_sizeof(tableSize);
 	uniqueNameIDs->allocator = dsAllocator_keepPointer(allocator);
-	uniqueNameIDs->hashTable = (dsHashTable*)dsAllocator_alloc(allocator, hashTableSize);
-	if (!uniqueNameIDs)
+	if (!dsHashMap_initialize(&uniqueNameIDs->hashMap, uniqueNameIDs->allocator, initialNameLimit,
+			&dsHashString, &dsHashStringEqual))
 	{
-		dsAllocator_free(allocator, uniqueNameIDs);
+		DS_VERIFY(dsAllocator_free(allocator, uniqueNameIDs));
 		return false;
 	}
 
-	DS_VERIFY(dsHashTable_initialize(
-		uniqueNameIDs->hashTable, tableSize, dsHashString, dsHashStringEqual));
 	DS_VERIFY(dsSpinlock_initialize(&uniqueNameIDs->lock));
-	uniqueNameIDs->nameLimit = initialNameLimit;
 	uniqueNameIDs->nextID = 1;
 
 	sUniqueNameIDs = uniqueNameIDs;
@@ -110,56 +97,32 @@ uint32_t dsUniqueNameID_create(const char* name)
 
 	DS_VERIFY(dsSpinlock_lock(&sUniqueNameIDs->lock));
 
-	UniqueNameNode* nameNode = (UniqueNameNode*)dsHashTable_find(sUniqueNameIDs->hashTable, name);
-	uint32_t id;
-	if (nameNode)
-		id = nameNode->id;
-	else
+	dsHashMapEntry* entry = dsHashMap_find(&sUniqueNameIDs->hashMap, name);
+	if (entry)
 	{
-		if (sUniqueNameIDs->hashTable->list.length >= sUniqueNameIDs->nameLimit)
-		{
-			size_t nextNameLimit = sUniqueNameIDs->nameLimit*2;
-			size_t tableSize = dsHashTable_tableSize(nextNameLimit);
-			size_t hashTableSize = dsHashTable_sizeof(tableSize);
-			dsHashTable* nextHashTable = (dsHashTable*)dsAllocator_alloc(
-				sUniqueNameIDs->allocator, hashTableSize);
-			if (!nextHashTable)
-			{
-				DS_VERIFY(dsSpinlock_unlock(&sUniqueNameIDs->lock));
-				return 0;
-			}
-
-			DS_VERIFY(dsHashTable_rehash(nextHashTable, tableSize, sUniqueNameIDs->hashTable));
-			DS_VERIFY(dsAllocator_free(sUniqueNameIDs->allocator, sUniqueNameIDs->hashTable));
-			sUniqueNameIDs->hashTable = nextHashTable;
-		}
-
-		size_t nameLen = strlen(name) + 1;
-		size_t fullSize = sizeof(UniqueNameNode);
-		if (!dsAddAlignedSize(&fullSize, nameLen, DS_ALLOC_ALIGNMENT))
-			return 0;
-
-		void* buffer = dsAllocator_alloc(sUniqueNameIDs->allocator, fullSize);
-		if (!buffer)
-		{
-			DS_VERIFY(dsSpinlock_unlock(&sUniqueNameIDs->lock));
-			return 0;
-		}
-
-		dsBufferAllocator bufferAlloc;
-		DS_VERIFY(dsBufferAllocator_initialize(&bufferAlloc, buffer, fullSize));
-
-		nameNode = DS_ALLOCATE_OBJECT(&bufferAlloc, UniqueNameNode);
-		DS_ASSERT(nameNode);
-
-		char* nameCopy =  DS_ALLOCATE_OBJECT_ARRAY(&bufferAlloc, char, nameLen);
-		memcpy(nameCopy, name, nameLen);
-		id = nameNode->id = sUniqueNameIDs->nextID++;
-
-		DS_VERIFY(dsHashTable_insert(
-			sUniqueNameIDs->hashTable, nameCopy, (dsHashTableNode*)nameNode, NULL));
+		uint32_t id = (uint32_t)(size_t)entry->value;
+		DS_VERIFY(dsSpinlock_unlock(&sUniqueNameIDs->lock));
+		return id;
+	}
+
+	size_t nameLen = strlen(name) + 1;
+	char* nameCopy = DS_ALLOCATE_OBJECT_ARRAY(sUniqueNameIDs->allocator, char, nameLen);
+	if (!nameCopy)
+	{
+		DS_VERIFY(dsSpinlock_unlock(&sUniqueNameIDs->lock));
+		return 0;
 	}
 
+	memcpy(nameCopy, name, nameLen);
+	uint32_t id = sUniqueNameIDs->nextID;
+	if (!dsHashMap_insert(&sUniqueNameIDs->hashMap, nameCopy, (void*)(size_t)id, NULL))
+	{
+		DS_VERIFY(dsAllocator_free(sUniqueNameIDs->allocator, nameCopy));
+		DS_VERIFY(dsSpinlock_unlock(&sUniqueNameIDs->lock));
+		return 0;
+	}
+
+	++sUniqueNameIDs->nextID;
 	DS_VERIFY(dsSpinlock_unlock(&sUniqueNameIDs->lock));
 	return id;
 }
@@ -172,9 +135,9 @@ uint32_t dsUniqueNameID_get(const char* name)
 	DS_VERIFY(dsSpinlock_lock(&sUniqueNameIDs->lock));
 
 	uint32_t id = 0;
-	UniqueNameNode* nameNode = (UniqueNameNode*)dsHashTable_find(sUniqueNameIDs->hashTable, name);
-	if (nameNode)
-		id = nameNode->id;
+	dsHashMapEntry* entry = dsHashMap_find(&sUniqueNameIDs->hashMap, name);
+	if (entry)
+		id = (uint32_t)(size_t)entry->value;
 
 	DS_VERIFY(dsSpinlock_unlock(&sUniqueNameIDs->lock));
 	return id;
@@ -188,15 +151,12 @@ bool dsUniqueNameID_shutdown(void)
 		return false;
 	}
 
-	dsListNode* node = sUniqueNameIDs->hashTable->list.head;
-	while (node)
-	{
-		dsListNode* nextNode = node->next;
-		DS_VERIFY(dsAllocator_free(sUniqueNameIDs->allocator, node));
-		node = nextNode;
-	}
+	// The hash map doesn't own the names.
+	dsHashMap* hashMap = &sUniqueNameIDs->hashMap;
+	for (uint32_t i = 0; i < hashMap->entryCount; ++i)
+		DS_VERIFY(dsAllocator_free(sUniqueNameIDs->allocator, (void*)hashMap->entries[i].key));
 
-	DS_VERIFY(dsAllocator_free(sUniqueNameIDs->allocator, sUniqueNameIDs->hashTable));
+	dsHashMap_shutdown(hashMap);
 	dsSpinlock_shutdown(&sUniqueNameIDs->lock);
 	DS_VERIFY(dsAllocator_free(sUniqueNameIDs->allocator, sUniqueNameIDs));
 	sUniqueNameIDs = NULL;
@@ -0,0 +1,330 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Helpers.h"
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Memory/SystemAllocator.h>
+#include <DeepSea/Core/Streams/AsyncIO.h>
+#include <DeepSea/Core/Streams/Path.h>
+#include <DeepSea/Core/Thread/Thread.h>
+#include <DeepSea/Core/Thread/ThreadPool.h>
+#include <DeepSea/Core/Atomic.h>
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+// Handle older versions of gtest.
+#ifndef INSTANTIATE_TEST_SUITE_P
+#define INSTANTIATE_TEST_SUITE_P INSTANTIATE_TEST_CASE_P
+#endif
+
+class AsyncIOTest : public testing::TestWithParam<bool>
+{
+public:
+	AsyncIOTest()
+		: allocator(reinterpret_cast<dsAllocator*>(&systemAllocator))
+		, threadPool(nullptr)
+		, asyncIO(nullptr)
+	{
+	}
+
+	void SetUp() override
+	{
+		EXPECT_TRUE(dsSystemAllocator_initialize(&systemAllocator, DS_ALLOCATOR_NO_LIMIT));
+		if (GetParam())
+		{
+			threadPool = dsThreadPool_create(allocator, 2, dsThreadPoolFlags_None, 0, nullptr,
+				nullptr, nullptr);
+			ASSERT_TRUE(threadPool);
+		}
+
+		asyncIO = dsAsyncIO_create(allocator, threadPool, 2);
+		ASSERT_TRUE(asyncIO);
+	}
+
+	void TearDown() override
+	{
+		dsAsyncIO_destroy(asyncIO);
+		EXPECT_TRUE(dsThreadPool_destroy(threadPool));
+		EXPECT_EQ(0U, allocator->size);
+	}
+
+	dsSystemAllocator systemAllocator;
+	dsAllocator* allocator;
+	dsThreadPool* threadPool;
+	dsAsyncIO* asyncIO;
+};
+
+namespace
+{
+
+struct Result
+{
+	std::string data;
+	int errorCode = -1;
+	uint32_t order = 0;
+	bool onCallingThread = false;
+};
+
+struct ResultList
+{
+	std::vector<Result> results;
+	dsAllocator* allocator;
+	dsThreadID callingThread;
+	uint32_t completeCount;
+};
+
+struct ResultRef
+{
+	ResultList* list;
+	uint32_t index;
+};
+
+void completeRequest(void* userData, const dsAsyncIORequest* request, void* data, size_t size,
+	int errorCode)
+{
+	ResultRef* ref = reinterpret_cast<ResultRef*>(userData);
+	Result& result = ref->list->results[ref->index];
+	if (data)
+		result.data.assign(reinterpret_cast<const char*>(data), size);
+	result.errorCode = errorCode;
+	result.order = DS_ATOMIC_FETCH_ADD32(&ref->list->completeCount, 1);
+	result.onCallingThread = dsThread_equal(dsThread_thisThreadID(), ref->list->callingThread);
+	if (data && data != request->buffer)
+	{
+		EXPECT_TRUE(dsAllocator_free(ref->list->allocator, data));
+	}
+}
+
+} // namespace
+
+static const char* assetDir = "Core-assets";
+
+static void initRequest(dsAsyncIORequest& request, const char* path, ResultRef& ref,
+	dsAllocator* allocator)
+{
+	request.file.source = dsAsyncIOSource_Resource;
+	request.file.resourceType = dsFileResourceType_Embedded;
+	request.file.archive = nullptr;
+	request.file.path = path;
+	request.offset = 0;
+	request.size = 0;
+	request.buffer = nullptr;
+	request.allocator = allocator;
+	request.completeFunc = &completeRequest;
+	request.userData = &ref;
+	request.completeOnIOThread = false;
+}
+
+TEST_P(AsyncIOTest, Create)
+{
+	EXPECT_FALSE_ERRNO(EINVAL, dsAsyncIO_create(nullptr, nullptr, 0));
+	dsAsyncIO* otherIO = dsAsyncIO_create(allocator, nullptr, 0);
+	ASSERT_TRUE(otherIO);
+	EXPECT_EQ(0U, dsAsyncIO_getActiveRequestCount(otherIO));
+	EXPECT_TRUE(dsAsyncIO_waitForRequests(otherIO));
+	dsAsyncIO_destroy(otherIO);
+}
+
+TEST_P(AsyncIOTest, ReadFiles)
+{
+	char textPath[DS_PATH_MAX];
+	ASSERT_TRUE(dsPath_combine(textPath, sizeof(textPath), assetDir, "text.txt"));
+	char emptyPath[DS_PATH_MAX];
+	ASSERT_TRUE(dsPath_combine(emptyPath, sizeof(emptyPath), assetDir, "empty"));
+	char missingPath[DS_PATH_MAX];
+	ASSERT_TRUE(dsPath_combine(missingPath, sizeof(missingPath), assetDir, "missing"));
+
+	ResultList resultList;
+	resultList.results.resize(4);
+	resultList.allocator = allocator;
+	resultList.callingThread = dsThread_thisThreadID();
+	resultList.completeCount = 0;
+
+	ResultRef refs[4];
+	dsAsyncIORequest requests[4];
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		refs[i].list = &resultList;
+		refs[i].index = i;
+	}
+
+	initRequest(requests[0], textPath, refs[0], allocator);
+	initRequest(requests[1], emptyPath, refs[1], allocator);
+	initRequest(requests[2], missingPath, refs[2], allocator);
+
+	char buffer[6];
+	initRequest(requests[3], textPath, refs[3], allocator);
+	requests[3].offset = 8;
+	requests[3].size = sizeof(buffer);
+	requests[3].buffer = buffer;
+
+	EXPECT_FALSE_ERRNO(EINVAL, dsAsyncIO_addRequests(nullptr, requests, 4));
+	requests[0].file.path = nullptr;
+	EXPECT_FALSE_ERRNO(EINVAL, dsAsyncIO_addRequests(asyncIO, requests, 4));
+	requests[0].file.path = textPath;
+	requests[3].size = 0;
+	EXPECT_FALSE_ERRNO(EINVAL, dsAsyncIO_addRequests(asyncIO, requests, 4));
+	requests[3].size = sizeof(buffer);
+
+	ASSERT_TRUE(dsAsyncIO_addRequests(asyncIO, requests, 4));
+	EXPECT_TRUE(dsAsyncIO_waitForRequests(asyncIO));
+	EXPECT_EQ(0U, dsAsyncIO_getActiveRequestCount(asyncIO));
+	EXPECT_EQ(4U, resultList.completeCount);
+
+	EXPECT_EQ(0, resultList.results[0].errorCode);
+	EXPECT_EQ("This is not a zip file.\n", resultList.results[0].data);
+	EXPECT_TRUE(resultList.results[0].onCallingThread);
+
+	EXPECT_EQ(0, resultList.results[1].errorCode);
+	EXPECT_EQ("", resultList.results[1].data);
+
+	EXPECT_EQ(ENOENT, resultList.results[2].errorCode);
+	EXPECT_EQ("", resultList.results[2].data);
+
+	EXPECT_EQ(0, resultList.results[3].errorCode);
+	EXPECT_EQ("not a ", resultList.results[3].data);
+
+	EXPECT_EQ(0U, dsAsyncIO_processCompleted(asyncIO));
+}
+
+TEST_P(AsyncIOTest, CompleteOnIOThread)
+{
+	char textPath[DS_PATH_MAX];
+	ASSERT_TRUE(dsPath_combine(textPath, sizeof(textPath), assetDir, "text.txt"));
+
+	ResultList resultList;
+	resultList.results.resize(16);
+	resultList.allocator = allocator;
+	resultList.callingThread = dsThread_thisThreadID();
+	resultList.completeCount = 0;
+
+	ResultRef refs[16];
+	dsAsyncIORequest requests[16];
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		refs[i].list = &resultList;
+		refs[i].index = i;
+		initRequest(requests[i], textPath, refs[i], allocator);
+		requests[i].offset = i;
+		requests[i].size = 4;
+		requests[i].completeOnIOThread = true;
+	}
+
+	ASSERT_TRUE(dsAsyncIO_addRequests(asyncIO, requests, 16));
+	EXPECT_TRUE(dsAsyncIO_waitForRequests(asyncIO));
+	EXPECT_EQ(16U, resultList.completeCount);
+
+	const char* text = "This is not a zip file.\n";
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		EXPECT_EQ(0, resultList.results[i].errorCode);
+		EXPECT_EQ(std::string(text + i, 4), resultList.results[i].data);
+		EXPECT_FALSE(resultList.results[i].onCallingThread);
+	}
+}
+
+TEST_P(AsyncIOTest, ManyRequests)
+{
+	char textPath[DS_PATH_MAX];
+	ASSERT_TRUE(dsPath_combine(textPath, sizeof(textPath), assetDir, "text.txt"));
+
+	// More requests than can be queued as tasks at once in a thread pool.
+	const uint32_t requestCount = 1000;
+	ResultList resultList;
+	resultList.results.resize(requestCount);
+	resultList.allocator = allocator;
+	resultList.callingThread = dsThread_thisThreadID();
+	resultList.completeCount = 0;
+
+	std::vector<ResultRef> refs(requestCount);
+	std::vector<dsAsyncIORequest> requests(requestCount);
+	for (uint32_t i = 0; i < requestCount; ++i)
+	{
+		refs[i].list = &resultList;
+		refs[i].index = i;
+		initRequest(requests[i], textPath, refs[i], allocator);
+		requests[i].offset = i % 16;
+		requests[i].size = 4;
+		// Completing on the IO thread runs the callback on the thread that performed the read.
+		requests[i].completeOnIOThread = true;
+	}
+
+	// Add in multiple batches to add requests while others are still being read.
+	const uint32_t batchSizes[] = {600, 1, 399};
+	uint32_t offset = 0;
+	for (uint32_t batchSize : batchSizes)
+	{
+		ASSERT_TRUE(dsAsyncIO_addRequests(asyncIO, requests.data() + offset, batchSize));
+		offset += batchSize;
+	}
+	ASSERT_EQ(requestCount, offset);
+
+	EXPECT_TRUE(dsAsyncIO_waitForRequests(asyncIO));
+	EXPECT_EQ(0U, dsAsyncIO_getActiveRequestCount(asyncIO));
+	EXPECT_EQ(requestCount, resultList.completeCount);
+
+	const char* text = "This is not a zip file.\n";
+	for (uint32_t i = 0; i < requestCount; ++i)
+	{
+		const Result& result = resultList.results[i];
+		EXPECT_EQ(0, result.errorCode);
+		EXPECT_EQ(std::string(text + i % 16, 4), result.data);
+		EXPECT_FALSE(result.onCallingThread) << "request " << i;
+	}
+}
+
+TEST_P(AsyncIOTest, CancelOnDestroy)
+{
+	char textPath[DS_PATH_MAX];
+	ASSERT_TRUE(dsPath_combine(textPath, sizeof(textPath), assetDir, "text.txt"));
+
+	ResultList resultList;
+	resultList.results.resize(64);
+	resultList.allocator = allocator;
+	resultList.callingThread = dsThread_thisThreadID();
+	resultList.completeCount = 0;
+
+	ResultRef refs[64];
+	dsAsyncIORequest requests[64];
+	for (uint32_t i = 0; i < 64; ++i)
+	{
+		refs[i].list = &resultList;
+		refs[i].index = i;
+		initRequest(requests[i], textPath, refs[i], allocator);
+	}
+
+	ASSERT_TRUE(dsAsyncIO_addRequests(asyncIO, requests, 64));
+	dsAsyncIO_destroy(asyncIO);
+	asyncIO = nullptr;
+
+	// Every request must be completed exactly once, either read or cancelled.
+	EXPECT_EQ(64U, resultList.completeCount);
+	for (const Result& result : resultList.results)
+	{
+		if (result.errorCode == 0)
+		{
+			EXPECT_EQ("This is not a zip file.\n", result.data);
+		}
+		else
+		{
+			EXPECT_EQ(ECANCELED, result.errorCode);
+		}
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(AsyncIO, AsyncIOTest, testing::Values(false, true));
@@ -0,0 +1,254 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Helpers.h"
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Memory/SystemAllocator.h>
+#include <DeepSea/Core/Thread/Thread.h>
+#include <DeepSea/Core/AsyncLog.h>
+#include <DeepSea/Core/Atomic.h>
+#include <DeepSea/Core/Log.h>
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+class AsyncLogTest : public testing::Test
+{
+public:
+	struct Message
+	{
+		dsLogLevel level;
+		std::string tag;
+		unsigned int line;
+		std::string message;
+	};
+
+	AsyncLogTest()
+		: allocator(reinterpret_cast<dsAllocator*>(&systemAllocator))
+		, blockOutput(false)
+		, outputBlocked(false)
+	{
+	}
+
+	static void logFunc(void* userData, dsLogLevel level, const char* tag,
+		const char* /*file*/, unsigned int line, const char* /*function*/,
+		const char* messageStr)
+	{
+		AsyncLogTest* self = reinterpret_cast<AsyncLogTest*>(userData);
+		uint32_t block;
+		DS_ATOMIC_LOAD32(&self->blockOutput, &block);
+		if (block)
+		{
+			uint32_t blocked = true;
+			DS_ATOMIC_STORE32(&self->outputBlocked, &blocked);
+			do
+			{
+				dsThread_yield();
+				DS_ATOMIC_LOAD32(&self->blockOutput, &block);
+			} while (block);
+		}
+
+		// The output function is only called by one thread at a time.
+		Message message = {level, tag, line, messageStr};
+		self->messages.push_back(message);
+	}
+
+	void SetUp() override
+	{
+		EXPECT_TRUE(dsSystemAllocator_initialize(&systemAllocator, DS_ALLOCATOR_NO_LIMIT));
+	}
+
+	void TearDown() override
+	{
+		EXPECT_EQ(0U, allocator->size);
+	}
+
+	dsSystemAllocator systemAllocator;
+	dsAllocator* allocator;
+	std::vector<Message> messages;
+	uint32_t blockOutput;
+	uint32_t outputBlocked;
+};
+
+TEST_F(AsyncLogTest, Create)
+{
+	EXPECT_FALSE_ERRNO(EINVAL, dsAsyncLog_create(nullptr, 0, 0, &logFunc, this));
+
+	dsAsyncLog* asyncLog = dsAsyncLog_create(allocator, 0, 0, &logFunc, this);
+	ASSERT_TRUE(asyncLog);
+	EXPECT_EQ(0U, dsAsyncLog_getDroppedCount(asyncLog));
+	dsAsyncLog_destroy(asyncLog);
+}
+
+TEST_F(AsyncLogTest, Messages)
+{
+	dsAsyncLog* asyncLog = dsAsyncLog_create(allocator, 0, 0, &logFunc, this);
+	ASSERT_TRUE(asyncLog);
+	dsLog_setFunction(asyncLog, &dsAsyncLog_log);
+
+	DS_LOG_INFO("first", "Info message.");
+	DS_LOG_WARNING_F("second", "Formatted %s.", "warning");
+	DS_LOG_TRACE("third", "Trace message.");
+
+	EXPECT_TRUE(dsAsyncLog_flush(asyncLog));
+	ASSERT_EQ(3U, messages.size());
+	EXPECT_EQ(dsLogLevel_Info, messages[0].level);
+	EXPECT_EQ("first", messages[0].tag);
+	EXPECT_EQ("Info message.", messages[0].message);
+	EXPECT_EQ(dsLogLevel_Warning, messages[1].level);
+	EXPECT_EQ("second", messages[1].tag);
+	EXPECT_EQ("Formatted warning.", messages[1].message);
+	EXPECT_EQ(dsLogLevel_Trace, messages[2].level);
+	EXPECT_EQ("third", messages[2].tag);
+	EXPECT_EQ("Trace message.", messages[2].message);
+
+	dsAsyncLog_destroy(asyncLog);
+	EXPECT_FALSE(dsLog_getFunction());
+}
+
+TEST_F(AsyncLogTest, ErrorIsSynchronous)
+{
+	dsAsyncLog* asyncLog = dsAsyncLog_create(allocator, 0, 0, &logFunc, this);
+	ASSERT_TRUE(asyncLog);
+
+	dsAsyncLog_log(asyncLog, dsLogLevel_Info, "tag", __FILE__, __LINE__, __FUNCTION__,
+		"Queued message.");
+	dsAsyncLog_log(asyncLog, dsLogLevel_Error, "tag", __FILE__, __LINE__, __FUNCTION__,
+		"Error message.");
+
+	// No flush needed for the error, and the queued message must come first.
+	ASSERT_EQ(2U, messages.size());
+	EXPECT_EQ("Queued message.", messages[0].message);
+	EXPECT_EQ(dsLogLevel_Error, messages[1].level);
+	EXPECT_EQ("Error message.", messages[1].message);
+
+	dsAsyncLog_destroy(asyncLog);
+}
+
+TEST_F(AsyncLogTest, LargeMessage)
+{
+	dsAsyncLog* asyncLog = dsAsyncLog_create(allocator, 1024, 0, &logFunc, this);
+	ASSERT_TRUE(asyncLog);
+
+	std::string largeMessage(2048, 'a');
+	dsAsyncLog_log(asyncLog, dsLogLevel_Info, "tag", __FILE__, __LINE__, __FUNCTION__,
+		largeMessage.c_str());
+	ASSERT_EQ(1U, messages.size());
+	EXPECT_EQ(largeMessage, messages[0].message);
+
+	dsAsyncLog_destroy(asyncLog);
+}
+
+TEST_F(AsyncLogTest, DropMessages)
+{
+	dsAsyncLog* asyncLog = dsAsyncLog_create(allocator, 1024, 0, &logFunc, this);
+	ASSERT_TRUE(asyncLog);
+
+	uint32_t block = true;
+	DS_ATOMIC_STORE32(&blockOutput, &block);
+	dsAsyncLog_log(asyncLog, dsLogLevel_Info, "tag", __FILE__, __LINE__, __FUNCTION__,
+		"Blocking message.");
+
+	uint32_t blocked;
+	do
+	{
+		dsThread_yield();
+		DS_ATOMIC_LOAD32(&outputBlocked, &blocked);
+	} while (!blocked);
+
+	const unsigned int messageCount = 100;
+	for (unsigned int i = 0; i < messageCount; ++i)
+	{
+		dsAsyncLog_log(asyncLog, dsLogLevel_Info, "tag", __FILE__, i, __FUNCTION__,
+			"Message that will fill up the buffer.");
+	}
+
+	uint64_t droppedCount = dsAsyncLog_getDroppedCount(asyncLog);
+	EXPECT_LT(0U, droppedCount);
+	EXPECT_GT(messageCount, droppedCount);
+
+	block = false;
+	DS_ATOMIC_STORE32(&blockOutput, &block);
+	EXPECT_TRUE(dsAsyncLog_flush(asyncLog));
+
+	// Blocking message, queued messages, then the dropped message report.
+	ASSERT_EQ(messageCount - droppedCount + 2, messages.size());
+	EXPECT_EQ("Blocking message.", messages[0].message);
+	for (unsigned int i = 1; i < messages.size() - 1; ++i)
+		EXPECT_EQ(i - 1, messages[i].line);
+	EXPECT_EQ(dsLogLevel_Warning, messages.back().level);
+	EXPECT_EQ("Dropped " + std::to_string(droppedCount) +
+		" log messages due to a full buffer.", messages.back().message);
+
+	dsAsyncLog_destroy(asyncLog);
+}
+
+namespace
+{
+
+struct ThreadInfo
+{
+	dsAsyncLog* asyncLog;
+	unsigned int index;
+};
+
+dsThreadReturnType logThread(void* userData)
+{
+	ThreadInfo* info = reinterpret_cast<ThreadInfo*>(userData);
+	for (unsigned int i = 0; i < 100; ++i)
+	{
+		dsAsyncLog_log(info->asyncLog, dsLogLevel_Info, "tag", __FILE__, i, __FUNCTION__,
+			std::to_string(info->index).c_str());
+	}
+	return 0;
+}
+
+} // namespace
+
+TEST_F(AsyncLogTest, MultipleThreads)
+{
+	dsAsyncLog* asyncLog = dsAsyncLog_create(allocator, 0, 0, &logFunc, this);
+	ASSERT_TRUE(asyncLog);
+
+	const unsigned int threadCount = 4;
+	dsThread threads[threadCount];
+	ThreadInfo infos[threadCount];
+	for (unsigned int i = 0; i < threadCount; ++i)
+	{
+		infos[i].asyncLog = asyncLog;
+		infos[i].index = i;
+		ASSERT_TRUE(dsThread_create(threads + i, &logThread, infos + i, 0, "Log"));
+	}
+
+	for (unsigned int i = 0; i < threadCount; ++i)
+		EXPECT_TRUE(dsThread_join(threads + i, nullptr));
+
+	EXPECT_TRUE(dsAsyncLog_flush(asyncLog));
+	EXPECT_EQ(0U, dsAsyncLog_getDroppedCount(asyncLog));
+	ASSERT_EQ(threadCount*100, messages.size());
+
+	// Messages from the same thread must stay in order.
+	unsigned int nextLine[threadCount] = {};
+	for (const Message& message : messages)
+	{
+		unsigned int index = std::stoi(message.message);
+		ASSERT_GT(threadCount, index);
+		EXPECT_EQ(nextLine[index]++, message.line);
+	}
+
+	dsAsyncLog_destroy(asyncLog);
+}
@@ -0,0 +1,317 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Helpers.h"
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Memory/BufferAllocator.h>
+#include <DeepSea/Core/Memory/CachingAllocator.h>
+#include <DeepSea/Core/Memory/Memory.h>
+#include <DeepSea/Core/Memory/SystemAllocator.h>
+#include <DeepSea/Core/Thread/Thread.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Timer.h>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+// NOTE: Performance tests compare many threads allocating and freeing small blocks concurrently
+// with the caching allocator and system allocator.
+#define DS_PERFORMANCE_TESTS 0
+
+class CachingAllocatorTest : public testing::Test
+{
+public:
+	void SetUp() override
+	{
+		ASSERT_TRUE(dsSystemAllocator_initialize(&systemAllocator, DS_ALLOCATOR_NO_LIMIT));
+		cachingAllocator = dsCachingAllocator_create((dsAllocator*)&systemAllocator);
+		ASSERT_TRUE(cachingAllocator);
+		allocator = (dsAllocator*)cachingAllocator;
+	}
+
+	void TearDown() override
+	{
+		dsCachingAllocator_destroy(cachingAllocator);
+		EXPECT_EQ(0U, ((dsAllocator*)&systemAllocator)->size);
+	}
+
+	dsSystemAllocator systemAllocator;
+	dsCachingAllocator* cachingAllocator;
+	dsAllocator* allocator;
+};
+
+namespace
+{
+
+const unsigned int threadAllocationCount = 1000;
+
+dsThreadReturnType allocThreadFunc(void* data)
+{
+	auto allocator = (dsAllocator*)data;
+	std::vector<uint8_t*> pointers(threadAllocationCount);
+	for (unsigned int i = 0; i < threadAllocationCount; ++i)
+	{
+		size_t size = (i*37) % 5000 + 1;
+		pointers[i] = (uint8_t*)dsAllocator_alloc(allocator, size);
+		EXPECT_NE(nullptr, pointers[i]);
+		EXPECT_EQ(0U, (uintptr_t)pointers[i] % DS_ALLOC_ALIGNMENT);
+		memset(pointers[i], (int)(i & 0xFF), size);
+	}
+
+	for (unsigned int i = 0; i < threadAllocationCount; ++i)
+	{
+		size_t size = (i*37) % 5000 + 1;
+		EXPECT_EQ((uint8_t)(i & 0xFF), pointers[i][0]);
+		EXPECT_EQ((uint8_t)(i & 0xFF), pointers[i][size - 1]);
+		EXPECT_TRUE(dsAllocator_free(allocator, pointers[i]));
+	}
+	return 0;
+}
+
+} // namespace
+
+TEST(CachingAllocator, Create)
+{
+	EXPECT_NULL_ERRNO(EINVAL, dsCachingAllocator_create(nullptr));
+
+	dsBufferAllocator bufferAllocator;
+	uint8_t buffer[1024];
+	ASSERT_TRUE(dsBufferAllocator_initialize(&bufferAllocator, buffer, sizeof(buffer)));
+	EXPECT_NULL_ERRNO(EINVAL, dsCachingAllocator_create((dsAllocator*)&bufferAllocator));
+}
+
+TEST_F(CachingAllocatorTest, Allocation)
+{
+	EXPECT_EQ((dsAllocator*)&systemAllocator,
+		dsCachingAllocator_getBaseAllocator(cachingAllocator));
+
+	void* ptr1 = dsAllocator_alloc(allocator, 11);
+	EXPECT_NE(nullptr, ptr1);
+	EXPECT_EQ(0U, (uintptr_t)ptr1 % DS_ALLOC_ALIGNMENT);
+
+	void* ptr2 = dsAllocator_alloc(allocator, 101);
+	EXPECT_NE(nullptr, ptr2);
+	EXPECT_EQ(0U, (uintptr_t)ptr2 % DS_ALLOC_ALIGNMENT);
+
+	void* ptr3 = dsAllocator_alloc(allocator, 1003);
+	EXPECT_NE(nullptr, ptr3);
+	EXPECT_EQ(0U, (uintptr_t)ptr3 % DS_ALLOC_ALIGNMENT);
+
+	void* ptr4 = dsAllocator_alloc(allocator, 5000);
+	EXPECT_NE(nullptr, ptr4);
+	EXPECT_EQ(0U, (uintptr_t)ptr4 % DS_ALLOC_ALIGNMENT);
+
+	EXPECT_TRUE(dsCachingAllocator_flushThreadCache(cachingAllocator));
+	EXPECT_EQ(16U + 128U + 1024U + 5000U, allocator->size);
+	EXPECT_EQ(4U, allocator->totalAllocations);
+	EXPECT_EQ(4U, allocator->currentAllocations);
+
+	EXPECT_TRUE(dsAllocator_free(allocator, ptr3));
+	EXPECT_TRUE(dsAllocator_free(allocator, ptr1));
+	EXPECT_TRUE(dsCachingAllocator_flushThreadCache(cachingAllocator));
+	EXPECT_EQ(128U + 5000U, allocator->size);
+	EXPECT_EQ(4U, allocator->totalAllocations);
+	EXPECT_EQ(2U, allocator->currentAllocations);
+
+	EXPECT_TRUE(dsAllocator_free(allocator, ptr2));
+	EXPECT_TRUE(dsAllocator_free(allocator, ptr4));
+	EXPECT_TRUE(dsCachingAllocator_flushThreadCache(cachingAllocator));
+	EXPECT_EQ(0U, allocator->size);
+	EXPECT_EQ(4U, allocator->totalAllocations);
+	EXPECT_EQ(0U, allocator->currentAllocations);
+}
+
+TEST_F(CachingAllocatorTest, ReuseMemory)
+{
+	void* ptr1 = dsAllocator_alloc(allocator, 24);
+	ASSERT_TRUE(ptr1);
+	EXPECT_TRUE(dsAllocator_free(allocator, ptr1));
+
+	// Same size class should re-use the cached block.
+	void* ptr2 = dsAllocator_alloc(allocator, 30);
+	EXPECT_EQ(ptr1, ptr2);
+
+	// Different size class should get a different block.
+	void* ptr3 = dsAllocator_alloc(allocator, 40);
+	ASSERT_TRUE(ptr3);
+	EXPECT_NE(ptr2, ptr3);
+
+	EXPECT_TRUE(dsAllocator_free(allocator, ptr2));
+	EXPECT_TRUE(dsAllocator_free(allocator, ptr3));
+
+	// Should be re-used after moving to the global pool.
+	EXPECT_TRUE(dsCachingAllocator_flushThreadCache(cachingAllocator));
+	void* ptr4 = dsAllocator_alloc(allocator, 20);
+	EXPECT_EQ(ptr1, ptr4);
+	EXPECT_TRUE(dsAllocator_free(allocator, ptr4));
+}
+
+TEST_F(CachingAllocatorTest, Alignment)
+{
+	void* ptr1 = dsCachingAllocator_alloc(cachingAllocator, 20, 64);
+	EXPECT_NE(nullptr, ptr1);
+	EXPECT_EQ(0U, (uintptr_t)ptr1 % 64);
+
+	void* ptr2 = dsCachingAllocator_alloc(cachingAllocator, 1000, 256);
+	EXPECT_NE(nullptr, ptr2);
+	EXPECT_EQ(0U, (uintptr_t)ptr2 % 256);
+
+	ptr2 = dsCachingAllocator_realloc(cachingAllocator, ptr2, 2000, 128);
+	EXPECT_NE(nullptr, ptr2);
+	EXPECT_EQ(0U, (uintptr_t)ptr2 % 128);
+
+	EXPECT_TRUE(dsCachingAllocator_free(cachingAllocator, ptr1));
+	EXPECT_TRUE(dsCachingAllocator_free(cachingAllocator, ptr2));
+	EXPECT_TRUE(dsCachingAllocator_flushThreadCache(cachingAllocator));
+	EXPECT_EQ(0U, allocator->size);
+	EXPECT_EQ(0U, allocator->currentAllocations);
+}
+
+TEST_F(CachingAllocatorTest, Reallocation)
+{
+	EXPECT_NULL_ERRNO(EINVAL, dsCachingAllocator_realloc(nullptr, nullptr, 10,
+		DS_ALLOC_ALIGNMENT));
+
+	uint8_t* ptr = (uint8_t*)dsAllocator_realloc(allocator, nullptr, 100);
+	ASSERT_NE(nullptr, ptr);
+	for (unsigned int i = 0; i < 100; ++i)
+		ptr[i] = (uint8_t)i;
+
+	// Same size class.
+	uint8_t* newPtr = (uint8_t*)dsAllocator_realloc(allocator, ptr, 110);
+	EXPECT_EQ(ptr, newPtr);
+
+	ptr = (uint8_t*)dsAllocator_realloc(allocator, newPtr, 6000);
+	ASSERT_NE(nullptr, ptr);
+	EXPECT_NE(newPtr, ptr);
+	for (unsigned int i = 0; i < 100; ++i)
+		EXPECT_EQ((uint8_t)i, ptr[i]);
+
+	ptr = (uint8_t*)dsAllocator_realloc(allocator, ptr, 50);
+	ASSERT_NE(nullptr, ptr);
+	for (unsigned int i = 0; i < 50; ++i)
+		EXPECT_EQ((uint8_t)i, ptr[i]);
+
+	EXPECT_TRUE(dsCachingAllocator_flushThreadCache(cachingAllocator));
+	EXPECT_EQ(64U, allocator->size);
+	EXPECT_EQ(4U, allocator->totalAllocations);
+	EXPECT_EQ(1U, allocator->currentAllocations);
+
+	EXPECT_EQ(nullptr, dsAllocator_realloc(allocator, ptr, 0));
+	EXPECT_TRUE(dsCachingAllocator_flushThreadCache(cachingAllocator));
+	EXPECT_EQ(0U, allocator->size);
+	EXPECT_EQ(0U, allocator->currentAllocations);
+}
+
+TEST_F(CachingAllocatorTest, ManyAllocations)
+{
+	// Enough allocations to move batches between the thread cache and global pool.
+	std::vector<void*> pointers(5000);
+	for (unsigned int j = 0; j < 3; ++j)
+	{
+		for (void*& ptr : pointers)
+		{
+			ptr = dsAllocator_alloc(allocator, 32);
+			ASSERT_TRUE(ptr);
+		}
+
+		for (void* ptr : pointers)
+			EXPECT_TRUE(dsAllocator_free(allocator, ptr));
+	}
+
+	EXPECT_TRUE(dsCachingAllocator_flushThreadCache(cachingAllocator));
+	EXPECT_EQ(0U, allocator->size);
+	EXPECT_EQ(15000U, allocator->totalAllocations);
+	EXPECT_EQ(0U, allocator->currentAllocations);
+}
+
+TEST_F(CachingAllocatorTest, MultipleThreads)
+{
+	const unsigned int threadCount = 10;
+	dsThread threads[threadCount];
+	for (unsigned int i = 0; i < threadCount; ++i)
+		EXPECT_TRUE(dsThread_create(threads + i, &allocThreadFunc, allocator, 0, nullptr));
+
+	for (unsigned int i = 0; i < threadCount; ++i)
+		EXPECT_TRUE(dsThread_join(threads + i, nullptr));
+
+	// Thread caches are flushed when the threads exit.
+	EXPECT_EQ(0U, allocator->size);
+	EXPECT_EQ(threadCount*threadAllocationCount, allocator->totalAllocations);
+	EXPECT_EQ(0U, allocator->currentAllocations);
+}
+
+#if DS_PERFORMANCE_TESTS
+
+namespace
+{
+
+const unsigned int performanceIterations = 1000000;
+
+dsThreadReturnType performanceThreadFunc(void* data)
+{
+	// Keep a small working set alive, similar to scratch memory for tasks.
+	auto allocator = (dsAllocator*)data;
+	void* pointers[64] = {};
+	uint32_t seed = 0;
+	for (unsigned int i = 0; i < performanceIterations; ++i)
+	{
+		seed = seed*1664525 + 1013904223;
+		unsigned int index = i % 64;
+		DS_VERIFY(dsAllocator_free(allocator, pointers[index]));
+		pointers[index] = dsAllocator_alloc(allocator, (seed >> 24) + 16);
+		DS_ASSERT(pointers[index]);
+	}
+
+	for (void* ptr : pointers)
+		DS_VERIFY(dsAllocator_free(allocator, ptr));
+	return 0;
+}
+
+void timeThreads(dsAllocator* allocator, const char* name)
+{
+	dsTimer timer = dsTimer_create();
+	unsigned int maxThreadCount = dsThread_logicalCoreCount();
+	std::vector<dsThread> threads(maxThreadCount);
+	for (unsigned int threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+	{
+		uint64_t start = dsTimer_currentTicks();
+		for (unsigned int i = 0; i < threadCount; ++i)
+		{
+			EXPECT_TRUE(dsThread_create(threads.data() + i, &performanceThreadFunc, allocator, 0,
+				nullptr));
+		}
+
+		for (unsigned int i = 0; i < threadCount; ++i)
+			EXPECT_TRUE(dsThread_join(threads.data() + i, nullptr));
+		uint64_t end = dsTimer_currentTicks();
+
+		double seconds = dsTimer_ticksToSeconds(timer, end - start);
+		printf("%s %u threads: %f allocations/s\n", name, threadCount,
+			(double)threadCount*performanceIterations/seconds);
+	}
+}
+
+} // namespace
+
+TEST_F(CachingAllocatorTest, Performance)
+{
+	timeThreads((dsAllocator*)&systemAllocator, "system");
+	printf("\n");
+	timeThreads(allocator, "caching");
+}
+
+#endif // DS_PERFORMANCE_TESTS
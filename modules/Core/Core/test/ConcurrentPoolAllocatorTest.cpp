@@ -0,0 +1,381 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Helpers.h"
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Memory/BufferAllocator.h>
+#include <DeepSea/Core/Memory/ConcurrentPoolAllocator.h>
+#include <DeepSea/Core/Memory/Memory.h>
+#include <DeepSea/Core/Memory/PoolAllocator.h>
+#include <DeepSea/Core/Memory/SystemAllocator.h>
+#include <DeepSea/Core/Thread/Spinlock.h>
+#include <DeepSea/Core/Thread/Thread.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Timer.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// Handle older versions of gtest.
+#ifndef INSTANTIATE_TEST_SUITE_P
+#define INSTANTIATE_TEST_SUITE_P INSTANTIATE_TEST_CASE_P
+#endif
+
+// NOTE: Performance tests compare many threads allocating and freeing chunks concurrently with the
+// concurrent pool allocator and a pool allocator.
+#define DS_PERFORMANCE_TESTS 0
+
+static const size_t chunkSize = 24;
+static const size_t initialChunkCount = 4;
+
+class ConcurrentPoolAllocatorTest : public testing::TestWithParam<bool>
+{
+public:
+	void SetUp() override
+	{
+		ASSERT_TRUE(dsSystemAllocator_initialize(&systemAllocator, DS_ALLOCATOR_NO_LIMIT));
+		poolAllocator = dsConcurrentPoolAllocator_create((dsAllocator*)&systemAllocator,
+			chunkSize, initialChunkCount, GetParam());
+		ASSERT_TRUE(poolAllocator);
+		allocator = (dsAllocator*)poolAllocator;
+	}
+
+	void TearDown() override
+	{
+		dsConcurrentPoolAllocator_destroy(poolAllocator);
+		EXPECT_EQ(0U, ((dsAllocator*)&systemAllocator)->size);
+	}
+
+	dsSystemAllocator systemAllocator;
+	dsConcurrentPoolAllocator* poolAllocator;
+	dsAllocator* allocator;
+};
+
+INSTANTIATE_TEST_SUITE_P(ConcurrentPoolAllocator, ConcurrentPoolAllocatorTest, testing::Bool());
+
+namespace
+{
+
+const unsigned int threadAllocationCount = 1000;
+
+struct ThreadData
+{
+	dsAllocator* allocator;
+	uint8_t value;
+};
+
+dsThreadReturnType allocThreadFunc(void* data)
+{
+	auto threadData = (ThreadData*)data;
+	dsAllocator* allocator = threadData->allocator;
+	std::vector<uint8_t*> pointers(threadAllocationCount);
+	for (unsigned int i = 0; i < threadAllocationCount; ++i)
+	{
+		pointers[i] = (uint8_t*)dsAllocator_alloc(allocator, chunkSize);
+		EXPECT_NE(nullptr, pointers[i]);
+		if (pointers[i])
+			memset(pointers[i], threadData->value, chunkSize);
+
+		// Free some chunks along the way to mix allocations and frees across threads.
+		if (i % 3 == 2)
+		{
+			EXPECT_TRUE(dsAllocator_free(allocator, pointers[i - 1]));
+			pointers[i - 1] = nullptr;
+		}
+	}
+
+	for (uint8_t* ptr : pointers)
+	{
+		if (!ptr)
+			continue;
+
+		EXPECT_EQ(threadData->value, ptr[0]);
+		EXPECT_EQ(threadData->value, ptr[chunkSize - 1]);
+		EXPECT_TRUE(dsAllocator_free(allocator, ptr));
+	}
+	return 0;
+}
+
+} // namespace
+
+TEST(ConcurrentPoolAllocator, Create)
+{
+	dsSystemAllocator systemAllocator;
+	ASSERT_TRUE(dsSystemAllocator_initialize(&systemAllocator, DS_ALLOCATOR_NO_LIMIT));
+	EXPECT_NULL_ERRNO(EINVAL, dsConcurrentPoolAllocator_create(nullptr, chunkSize,
+		initialChunkCount, false));
+	EXPECT_NULL_ERRNO(EINVAL, dsConcurrentPoolAllocator_create((dsAllocator*)&systemAllocator, 0,
+		initialChunkCount, false));
+	EXPECT_NULL_ERRNO(EINVAL, dsConcurrentPoolAllocator_create((dsAllocator*)&systemAllocator,
+		chunkSize, 0, false));
+
+	dsBufferAllocator bufferAllocator;
+	uint8_t buffer[1024];
+	ASSERT_TRUE(dsBufferAllocator_initialize(&bufferAllocator, buffer, sizeof(buffer)));
+	EXPECT_NULL_ERRNO(EINVAL, dsConcurrentPoolAllocator_create((dsAllocator*)&bufferAllocator,
+		chunkSize, initialChunkCount, false));
+
+	// Initial chunk count is rounded to a power of two.
+	dsConcurrentPoolAllocator* poolAllocator = dsConcurrentPoolAllocator_create(
+		(dsAllocator*)&systemAllocator, chunkSize, 5, false);
+	ASSERT_TRUE(poolAllocator);
+	EXPECT_EQ(DS_ALIGNED_SIZE(chunkSize, DS_ALLOC_ALIGNMENT),
+		dsConcurrentPoolAllocator_getChunkSize(poolAllocator));
+	EXPECT_EQ(8U, dsConcurrentPoolAllocator_getChunkCount(poolAllocator));
+	EXPECT_TRUE(dsConcurrentPoolAllocator_validate(poolAllocator));
+	dsConcurrentPoolAllocator_destroy(poolAllocator);
+	EXPECT_EQ(0U, ((dsAllocator*)&systemAllocator)->size);
+}
+
+TEST_P(ConcurrentPoolAllocatorTest, AllocateFree)
+{
+	size_t alignedChunkSize = dsConcurrentPoolAllocator_getChunkSize(poolAllocator);
+	EXPECT_EQ(initialChunkCount, dsConcurrentPoolAllocator_getChunkCount(poolAllocator));
+	EXPECT_TRUE(dsConcurrentPoolAllocator_validate(poolAllocator));
+
+	EXPECT_NULL_ERRNO(EINVAL, dsConcurrentPoolAllocator_alloc(nullptr, chunkSize,
+		DS_ALLOC_ALIGNMENT));
+	EXPECT_NULL_ERRNO(EINVAL, dsConcurrentPoolAllocator_alloc(poolAllocator, 0,
+		DS_ALLOC_ALIGNMENT));
+	EXPECT_NULL_ERRNO(EINVAL, dsConcurrentPoolAllocator_alloc(poolAllocator,
+		alignedChunkSize + 1, DS_ALLOC_ALIGNMENT));
+	EXPECT_NULL_ERRNO(EINVAL, dsConcurrentPoolAllocator_alloc(poolAllocator, chunkSize,
+		DS_ALLOC_ALIGNMENT*2));
+
+	void* ptr1 = dsAllocator_alloc(allocator, 14);
+	ASSERT_TRUE(ptr1);
+	EXPECT_EQ(0U, (uintptr_t)ptr1 % DS_ALLOC_ALIGNMENT);
+	// Statistics are applied lazily with thread caches.
+	bool exactStatistics = !GetParam();
+	if (exactStatistics)
+	{
+		EXPECT_EQ(alignedChunkSize, allocator->size);
+		EXPECT_EQ(1U, allocator->totalAllocations);
+		EXPECT_EQ(1U, allocator->currentAllocations);
+	}
+	EXPECT_TRUE(dsConcurrentPoolAllocator_validate(poolAllocator));
+
+	void* ptr2 = dsAllocator_alloc(allocator, alignedChunkSize);
+	ASSERT_TRUE(ptr2);
+	EXPECT_NE(ptr1, ptr2);
+	if (exactStatistics)
+	{
+		EXPECT_EQ(2*alignedChunkSize, allocator->size);
+	}
+	EXPECT_TRUE(dsConcurrentPoolAllocator_validate(poolAllocator));
+
+	EXPECT_FALSE_ERRNO(EINVAL, dsAllocator_free(allocator, (uint8_t*)ptr1 + 1));
+	int local;
+	EXPECT_FALSE_ERRNO(EINVAL, dsAllocator_free(allocator, &local));
+	EXPECT_TRUE(dsAllocator_free(allocator, nullptr));
+
+	EXPECT_TRUE(dsAllocator_free(allocator, ptr1));
+	if (exactStatistics)
+	{
+		EXPECT_EQ(alignedChunkSize, allocator->size);
+		EXPECT_EQ(2U, allocator->totalAllocations);
+		EXPECT_EQ(1U, allocator->currentAllocations);
+	}
+	EXPECT_TRUE(dsConcurrentPoolAllocator_validate(poolAllocator));
+
+	// Most recently freed chunk is re-used first.
+	EXPECT_EQ(ptr1, dsAllocator_alloc(allocator, chunkSize));
+	EXPECT_TRUE(dsAllocator_free(allocator, ptr1));
+	EXPECT_TRUE(dsAllocator_free(allocator, ptr2));
+	if (exactStatistics)
+	{
+		EXPECT_EQ(0U, allocator->size);
+		EXPECT_EQ(0U, allocator->currentAllocations);
+	}
+	EXPECT_TRUE(dsConcurrentPoolAllocator_validate(poolAllocator));
+}
+
+TEST_P(ConcurrentPoolAllocatorTest, Grow)
+{
+	// Pages double in size each time the pool is exhausted.
+	std::vector<void*> pointers;
+	for (unsigned int i = 0; i < 100; ++i)
+	{
+		void* ptr = dsAllocator_alloc(allocator, chunkSize);
+		ASSERT_TRUE(ptr);
+		memset(ptr, (int)i, chunkSize);
+		pointers.push_back(ptr);
+		EXPECT_TRUE(dsConcurrentPoolAllocator_validate(poolAllocator));
+	}
+
+	EXPECT_EQ(124U, dsConcurrentPoolAllocator_getChunkCount(poolAllocator));
+	if (!GetParam())
+	{
+		EXPECT_EQ(100U, allocator->currentAllocations);
+	}
+
+	std::vector<void*> sortedPointers = pointers;
+	std::sort(sortedPointers.begin(), sortedPointers.end());
+	EXPECT_EQ(sortedPointers.end(), std::unique(sortedPointers.begin(), sortedPointers.end()));
+
+	for (unsigned int i = 0; i < pointers.size(); ++i)
+	{
+		EXPECT_EQ((uint8_t)i, ((uint8_t*)pointers[i])[chunkSize - 1]);
+		EXPECT_TRUE(dsAllocator_free(allocator, pointers[i]));
+	}
+
+	if (!GetParam())
+	{
+		EXPECT_EQ(0U, allocator->size);
+		EXPECT_EQ(0U, allocator->currentAllocations);
+	}
+	EXPECT_TRUE(dsConcurrentPoolAllocator_validate(poolAllocator));
+
+	// All chunks are re-used without growing further.
+	for (void*& ptr : pointers)
+	{
+		ptr = dsAllocator_alloc(allocator, chunkSize);
+		ASSERT_TRUE(ptr);
+	}
+	EXPECT_EQ(124U, dsConcurrentPoolAllocator_getChunkCount(poolAllocator));
+
+	for (void* ptr : pointers)
+		EXPECT_TRUE(dsAllocator_free(allocator, ptr));
+	EXPECT_TRUE(dsConcurrentPoolAllocator_validate(poolAllocator));
+}
+
+TEST_P(ConcurrentPoolAllocatorTest, MultipleThreads)
+{
+	const unsigned int threadCount = 10;
+	dsThread threads[threadCount];
+	ThreadData threadData[threadCount];
+	for (unsigned int i = 0; i < threadCount; ++i)
+	{
+		threadData[i].allocator = allocator;
+		threadData[i].value = (uint8_t)(i + 1);
+		EXPECT_TRUE(dsThread_create(threads + i, &allocThreadFunc, threadData + i, 0, nullptr));
+	}
+
+	for (unsigned int i = 0; i < threadCount; ++i)
+		EXPECT_TRUE(dsThread_join(threads + i, nullptr));
+
+	// Thread caches are returned when the threads exit.
+	EXPECT_EQ(0U, allocator->size);
+	EXPECT_EQ(threadCount*threadAllocationCount, allocator->totalAllocations);
+	EXPECT_EQ(0U, allocator->currentAllocations);
+	EXPECT_TRUE(dsConcurrentPoolAllocator_validate(poolAllocator));
+}
+
+#if DS_PERFORMANCE_TESTS
+
+namespace
+{
+
+const unsigned int performanceIterations = 1000000;
+
+struct LockedPoolAllocator
+{
+	dsAllocator allocator;
+	dsPoolAllocator pool;
+	dsSpinlock lock;
+};
+
+// Matches how a pool allocator would be shared across threads before.
+void* lockedPoolAlloc(dsAllocator* allocator, size_t size, unsigned int alignment)
+{
+	auto lockedAllocator = (LockedPoolAllocator*)allocator;
+	DS_VERIFY(dsSpinlock_lock(&lockedAllocator->lock));
+	void* ptr = dsPoolAllocator_alloc(&lockedAllocator->pool, size, alignment);
+	DS_VERIFY(dsSpinlock_unlock(&lockedAllocator->lock));
+	return ptr;
+}
+
+bool lockedPoolFree(dsAllocator* allocator, void* ptr)
+{
+	auto lockedAllocator = (LockedPoolAllocator*)allocator;
+	DS_VERIFY(dsSpinlock_lock(&lockedAllocator->lock));
+	bool result = dsPoolAllocator_free(&lockedAllocator->pool, ptr);
+	DS_VERIFY(dsSpinlock_unlock(&lockedAllocator->lock));
+	return result;
+}
+
+dsThreadReturnType performanceThreadFunc(void* data)
+{
+	auto allocator = (dsAllocator*)data;
+	void* pointers[64] = {};
+	for (unsigned int i = 0; i < performanceIterations; ++i)
+	{
+		unsigned int index = i % 64;
+		DS_VERIFY(dsAllocator_free(allocator, pointers[index]));
+		pointers[index] = dsAllocator_alloc(allocator, chunkSize);
+		DS_ASSERT(pointers[index]);
+	}
+
+	for (void* ptr : pointers)
+		DS_VERIFY(dsAllocator_free(allocator, ptr));
+	return 0;
+}
+
+void timeThreads(dsAllocator* allocator, const char* name)
+{
+	dsTimer timer = dsTimer_create();
+	unsigned int maxThreadCount = dsThread_logicalCoreCount();
+	std::vector<dsThread> threads(maxThreadCount);
+	for (unsigned int threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+	{
+		uint64_t start = dsTimer_currentTicks();
+		for (unsigned int i = 0; i < threadCount; ++i)
+		{
+			EXPECT_TRUE(dsThread_create(threads.data() + i, &performanceThreadFunc, allocator, 0,
+				nullptr));
+		}
+
+		for (unsigned int i = 0; i < threadCount; ++i)
+			EXPECT_TRUE(dsThread_join(threads.data() + i, nullptr));
+		uint64_t end = dsTimer_currentTicks();
+
+		double seconds = dsTimer_ticksToSeconds(timer, end - start);
+		printf("%s %u threads: %f allocations/s\n", name, threadCount,
+			(double)threadCount*performanceIterations/seconds);
+	}
+}
+
+} // namespace
+
+TEST_P(ConcurrentPoolAllocatorTest, Performance)
+{
+	if (!GetParam())
+	{
+		unsigned int maxThreadCount = dsThread_logicalCoreCount();
+		size_t poolChunkCount = maxThreadCount*64;
+		size_t bufferSize = dsPoolAllocator_bufferSize(chunkSize, poolChunkCount);
+		void* buffer = dsAllocator_alloc((dsAllocator*)&systemAllocator, bufferSize);
+		ASSERT_TRUE(buffer);
+
+		LockedPoolAllocator lockedAllocator = {};
+		ASSERT_TRUE(dsPoolAllocator_initialize(&lockedAllocator.pool, chunkSize, poolChunkCount,
+			buffer, bufferSize));
+		ASSERT_TRUE(dsSpinlock_initialize(&lockedAllocator.lock));
+		lockedAllocator.allocator.allocFunc = &lockedPoolAlloc;
+		lockedAllocator.allocator.freeFunc = &lockedPoolFree;
+		timeThreads((dsAllocator*)&lockedAllocator, "locked pool");
+		printf("\n");
+
+		dsSpinlock_shutdown(&lockedAllocator.lock);
+		dsPoolAllocator_shutdown(&lockedAllocator.pool);
+		DS_VERIFY(dsAllocator_free((dsAllocator*)&systemAllocator, buffer));
+	}
+
+	timeThreads(allocator, GetParam() ? "concurrent pool with thread caches" : "concurrent pool");
+}
+
+#endif // DS_PERFORMANCE_TESTS
@@ -0,0 +1,336 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Helpers.h"
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Memory/BufferAllocator.h>
+#include <DeepSea/Core/Memory/FrameAllocator.h>
+#include <DeepSea/Core/Memory/Memory.h>
+#include <DeepSea/Core/Memory/SystemAllocator.h>
+#include <DeepSea/Core/Thread/Thread.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Timer.h>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+// NOTE: Performance tests compare many threads allocating small blocks concurrently with the frame
+// allocator and system allocator.
+#define DS_PERFORMANCE_TESTS 0
+
+static const size_t blockSize = 64*1024;
+static const unsigned int frameCount = 2;
+
+class FrameAllocatorTest : public testing::Test
+{
+public:
+	void SetUp() override
+	{
+		ASSERT_TRUE(dsSystemAllocator_initialize(&systemAllocator, DS_ALLOCATOR_NO_LIMIT));
+		frameAllocator = dsFrameAllocator_create((dsAllocator*)&systemAllocator, blockSize,
+			frameCount);
+		ASSERT_TRUE(frameAllocator);
+		allocator = (dsAllocator*)frameAllocator;
+	}
+
+	void TearDown() override
+	{
+		dsFrameAllocator_destroy(frameAllocator);
+		EXPECT_EQ(0U, ((dsAllocator*)&systemAllocator)->size);
+	}
+
+	dsSystemAllocator systemAllocator;
+	dsFrameAllocator* frameAllocator;
+	dsAllocator* allocator;
+};
+
+namespace
+{
+
+const unsigned int threadAllocationCount = 1000;
+
+size_t getThreadAllocSize(unsigned int i)
+{
+	return (i*37) % 5000 + 1;
+}
+
+struct ThreadData
+{
+	dsAllocator* allocator;
+	std::vector<uint8_t*> pointers;
+	uint8_t value;
+};
+
+dsThreadReturnType allocThreadFunc(void* data)
+{
+	auto threadData = (ThreadData*)data;
+	threadData->pointers.resize(threadAllocationCount);
+	for (unsigned int i = 0; i < threadAllocationCount; ++i)
+	{
+		size_t size = getThreadAllocSize(i);
+		uint8_t* ptr = (uint8_t*)dsAllocator_alloc(threadData->allocator, size);
+		EXPECT_NE(nullptr, ptr);
+		if (!ptr)
+			continue;
+
+		EXPECT_EQ(0U, (uintptr_t)ptr % DS_ALLOC_ALIGNMENT);
+		memset(ptr, threadData->value, size);
+		threadData->pointers[i] = ptr;
+	}
+	return 0;
+}
+
+} // namespace
+
+TEST(FrameAllocator, Create)
+{
+	dsSystemAllocator systemAllocator;
+	ASSERT_TRUE(dsSystemAllocator_initialize(&systemAllocator, DS_ALLOCATOR_NO_LIMIT));
+	EXPECT_NULL_ERRNO(EINVAL, dsFrameAllocator_create(nullptr, 1024, 2));
+	EXPECT_NULL_ERRNO(EINVAL, dsFrameAllocator_create((dsAllocator*)&systemAllocator, 0, 2));
+	EXPECT_NULL_ERRNO(EINVAL, dsFrameAllocator_create((dsAllocator*)&systemAllocator, 1024, 0));
+
+	dsBufferAllocator bufferAllocator;
+	uint8_t buffer[1024];
+	ASSERT_TRUE(dsBufferAllocator_initialize(&bufferAllocator, buffer, sizeof(buffer)));
+	EXPECT_NULL_ERRNO(EINVAL, dsFrameAllocator_create((dsAllocator*)&bufferAllocator, 1024, 2));
+}
+
+TEST_F(FrameAllocatorTest, Allocation)
+{
+	EXPECT_EQ(frameCount, dsFrameAllocator_getFrameCount(frameAllocator));
+	EXPECT_NULL_ERRNO(EINVAL, dsFrameAllocator_alloc(nullptr, 16, DS_ALLOC_ALIGNMENT));
+	EXPECT_NULL_ERRNO(EINVAL, dsFrameAllocator_alloc(frameAllocator, 0, DS_ALLOC_ALIGNMENT));
+	EXPECT_NULL_ERRNO(EINVAL, dsFrameAllocator_alloc(frameAllocator, 16, 0));
+
+	uint8_t* ptr1 = (uint8_t*)dsAllocator_alloc(allocator, 10);
+	ASSERT_TRUE(ptr1);
+	EXPECT_EQ(0U, (uintptr_t)ptr1 % DS_ALLOC_ALIGNMENT);
+	EXPECT_EQ(blockSize, allocator->size);
+	EXPECT_EQ(1U, allocator->totalAllocations);
+	EXPECT_EQ(1U, allocator->currentAllocations);
+
+	uint8_t* ptr2 = (uint8_t*)dsAllocator_alloc(allocator, 20);
+	ASSERT_TRUE(ptr2);
+	EXPECT_EQ(0U, (uintptr_t)ptr2 % DS_ALLOC_ALIGNMENT);
+	EXPECT_EQ(ptr1 + DS_ALLOC_ALIGNMENT, ptr2);
+	EXPECT_EQ(blockSize, allocator->size);
+
+	uint8_t* ptr3 = (uint8_t*)dsFrameAllocator_alloc(frameAllocator, 4, 256);
+	ASSERT_TRUE(ptr3);
+	EXPECT_EQ(0U, (uintptr_t)ptr3 % 256);
+
+	uint8_t* ptr4 = (uint8_t*)dsFrameAllocator_alloc(frameAllocator, 4, 1);
+	ASSERT_TRUE(ptr4);
+	EXPECT_EQ(ptr3 + 4, ptr4);
+
+	// Memory can't be freed or reallocated.
+	EXPECT_FALSE_ERRNO(EINVAL, dsAllocator_free(allocator, ptr1));
+	EXPECT_NULL_ERRNO(EINVAL, dsAllocator_reallocWithFallback(allocator, ptr2, 20, 40));
+}
+
+TEST_F(FrameAllocatorTest, LargeAllocations)
+{
+	// Large allocations are taken directly from the blocks, chaining new blocks as needed.
+	uint8_t* ptr1 = (uint8_t*)dsAllocator_alloc(allocator, blockSize/2);
+	ASSERT_TRUE(ptr1);
+	memset(ptr1, 0x12, blockSize/2);
+	EXPECT_EQ(blockSize, allocator->size);
+	EXPECT_EQ(1U, allocator->currentAllocations);
+
+	uint8_t* ptr2 = (uint8_t*)dsAllocator_alloc(allocator, blockSize*3/4);
+	ASSERT_TRUE(ptr2);
+	memset(ptr2, 0x34, blockSize*3/4);
+	EXPECT_EQ(blockSize*2, allocator->size);
+	EXPECT_EQ(2U, allocator->currentAllocations);
+
+	size_t hugeSize = blockSize*4;
+	uint8_t* ptr3 = (uint8_t*)dsFrameAllocator_alloc(frameAllocator, hugeSize, 128);
+	ASSERT_TRUE(ptr3);
+	EXPECT_EQ(0U, (uintptr_t)ptr3 % 128);
+	memset(ptr3, 0x56, hugeSize);
+	EXPECT_LE(blockSize*2 + hugeSize, allocator->size);
+	EXPECT_EQ(3U, allocator->currentAllocations);
+
+	EXPECT_EQ(0x12, ptr1[blockSize/2 - 1]);
+	EXPECT_EQ(0x34, ptr2[blockSize*3/4 - 1]);
+	EXPECT_EQ(0x56, ptr3[hugeSize - 1]);
+
+	// Cycling back to the first frame combines the blocks into one.
+	size_t usedSize = allocator->size;
+	EXPECT_TRUE(dsFrameAllocator_beginFrame(frameAllocator, 1));
+	EXPECT_EQ(usedSize, allocator->size);
+	EXPECT_EQ(3U, allocator->currentAllocations);
+
+	EXPECT_TRUE(dsFrameAllocator_beginFrame(frameAllocator, 2));
+	EXPECT_EQ(usedSize, allocator->size);
+	EXPECT_EQ(1U, allocator->currentAllocations);
+	EXPECT_EQ(4U, allocator->totalAllocations);
+
+	// Same allocations should now fit without any new blocks.
+	EXPECT_TRUE(dsAllocator_alloc(allocator, blockSize/2));
+	EXPECT_TRUE(dsAllocator_alloc(allocator, blockSize*3/4));
+	EXPECT_TRUE(dsFrameAllocator_alloc(frameAllocator, hugeSize, 128));
+	EXPECT_EQ(usedSize, allocator->size);
+	EXPECT_EQ(1U, allocator->currentAllocations);
+	EXPECT_EQ(4U, allocator->totalAllocations);
+}
+
+TEST_F(FrameAllocatorTest, MultiBuffering)
+{
+	EXPECT_FALSE(dsFrameAllocator_beginFrame(nullptr, 1));
+
+	uint8_t* frame0Ptr = (uint8_t*)dsAllocator_alloc(allocator, 100);
+	ASSERT_TRUE(frame0Ptr);
+	memset(frame0Ptr, 0xAB, 100);
+
+	// Beginning the same frame again doesn't reset anything.
+	EXPECT_TRUE(dsFrameAllocator_beginFrame(frameAllocator, 0));
+	uint8_t* ptr = (uint8_t*)dsAllocator_alloc(allocator, 100);
+	ASSERT_TRUE(ptr);
+	EXPECT_NE(frame0Ptr, ptr);
+
+	// Memory from the previous frame stays valid while the next frame is in flight.
+	EXPECT_TRUE(dsFrameAllocator_beginFrame(frameAllocator, 1));
+	uint8_t* frame1Ptr = (uint8_t*)dsAllocator_alloc(allocator, 100);
+	ASSERT_TRUE(frame1Ptr);
+	memset(frame1Ptr, 0xCD, 100);
+	EXPECT_EQ(0xAB, frame0Ptr[99]);
+	EXPECT_EQ(blockSize*2, allocator->size);
+
+	// Memory is re-used once cycling back to the same frame.
+	EXPECT_TRUE(dsFrameAllocator_beginFrame(frameAllocator, 2));
+	EXPECT_EQ(frame0Ptr, dsAllocator_alloc(allocator, 100));
+	EXPECT_EQ(0xCD, frame1Ptr[99]);
+
+	EXPECT_TRUE(dsFrameAllocator_beginFrame(frameAllocator, 3));
+	EXPECT_EQ(frame1Ptr, dsAllocator_alloc(allocator, 100));
+	EXPECT_EQ(blockSize*2, allocator->size);
+	EXPECT_EQ(2U, allocator->totalAllocations);
+	EXPECT_EQ(2U, allocator->currentAllocations);
+}
+
+TEST_F(FrameAllocatorTest, MultipleThreads)
+{
+	const unsigned int threadCount = 10;
+	dsThread threads[threadCount];
+	ThreadData threadData[threadCount];
+	for (unsigned int frame = 1; frame <= 3; ++frame)
+	{
+		EXPECT_TRUE(dsFrameAllocator_beginFrame(frameAllocator, frame));
+		for (unsigned int i = 0; i < threadCount; ++i)
+		{
+			threadData[i].allocator = allocator;
+			threadData[i].value = (uint8_t)(frame*threadCount + i);
+			EXPECT_TRUE(dsThread_create(threads + i, &allocThreadFunc, threadData + i, 0,
+				nullptr));
+		}
+
+		for (unsigned int i = 0; i < threadCount; ++i)
+			EXPECT_TRUE(dsThread_join(threads + i, nullptr));
+
+		// Make sure no memory overlapped between threads.
+		for (unsigned int i = 0; i < threadCount; ++i)
+		{
+			for (unsigned int j = 0; j < threadAllocationCount; ++j)
+			{
+				const uint8_t* ptr = threadData[i].pointers[j];
+				ASSERT_TRUE(ptr);
+				EXPECT_EQ(threadData[i].value, ptr[0]);
+				EXPECT_EQ(threadData[i].value, ptr[getThreadAllocSize(j) - 1]);
+			}
+		}
+	}
+}
+
+#if DS_PERFORMANCE_TESTS
+
+namespace
+{
+
+const unsigned int performanceIterations = 1000000;
+
+dsThreadReturnType systemPerformanceThreadFunc(void* data)
+{
+	// Free everything at the end similar to how memory would be used for a frame.
+	auto allocator = (dsAllocator*)data;
+	std::vector<void*> pointers(performanceIterations);
+	uint32_t seed = 0;
+	for (unsigned int i = 0; i < performanceIterations; ++i)
+	{
+		seed = seed*1664525 + 1013904223;
+		pointers[i] = dsAllocator_alloc(allocator, (seed >> 24) + 16);
+		DS_ASSERT(pointers[i]);
+	}
+
+	for (void* ptr : pointers)
+		DS_VERIFY(dsAllocator_free(allocator, ptr));
+	return 0;
+}
+
+dsThreadReturnType framePerformanceThreadFunc(void* data)
+{
+	auto allocator = (dsAllocator*)data;
+	uint32_t seed = 0;
+	for (unsigned int i = 0; i < performanceIterations; ++i)
+	{
+		seed = seed*1664525 + 1013904223;
+		DS_VERIFY(dsAllocator_alloc(allocator, (seed >> 24) + 16));
+	}
+	return 0;
+}
+
+void timeThreads(dsAllocator* allocator, dsThreadFunction threadFunc, const char* name,
+	dsFrameAllocator* frameAllocator)
+{
+	dsTimer timer = dsTimer_create();
+	unsigned int maxThreadCount = dsThread_logicalCoreCount();
+	std::vector<dsThread> threads(maxThreadCount);
+	uint64_t frame = 0;
+	for (unsigned int threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+	{
+		if (frameAllocator)
+		{
+			EXPECT_TRUE(dsFrameAllocator_beginFrame(frameAllocator, ++frame));
+		}
+
+		uint64_t start = dsTimer_currentTicks();
+		for (unsigned int i = 0; i < threadCount; ++i)
+		{
+			EXPECT_TRUE(dsThread_create(threads.data() + i, threadFunc, allocator, 0,
+				nullptr));
+		}
+
+		for (unsigned int i = 0; i < threadCount; ++i)
+			EXPECT_TRUE(dsThread_join(threads.data() + i, nullptr));
+		uint64_t end = dsTimer_currentTicks();
+
+		double seconds = dsTimer_ticksToSeconds(timer, end - start);
+		printf("%s %u threads: %f allocations/s\n", name, threadCount,
+			(double)threadCount*performanceIterations/seconds);
+	}
+}
+
+} // namespace
+
+TEST_F(FrameAllocatorTest, Performance)
+{
+	timeThreads((dsAllocator*)&systemAllocator, &systemPerformanceThreadFunc, "system", nullptr);
+	printf("\n");
+	timeThreads(allocator, &framePerformanceThreadFunc, "frame", frameAllocator);
+}
+
+#endif // DS_PERFORMANCE_TESTS
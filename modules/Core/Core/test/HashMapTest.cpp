@@ -0,0 +1,443 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Helpers.h"
+#include <DeepSea/Core/Containers/Hash.h>
+#include <DeepSea/Core/Containers/HashMap.h>
+#include <DeepSea/Core/Containers/HashTable.h>
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Memory/BufferAllocator.h>
+#include <DeepSea/Core/Memory/SystemAllocator.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Timer.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+// NOTE: Performance tests compare insertion, lookup, and iteration with a hash table.
+#define DS_PERFORMANCE_TESTS 0
+
+static uint32_t chainHashFunction(const void*)
+{
+	return 0;
+}
+
+class HashMapTest : public testing::Test
+{
+public:
+	void SetUp() override
+	{
+		ASSERT_TRUE(dsSystemAllocator_initialize(&systemAllocator, DS_ALLOCATOR_NO_LIMIT));
+		allocator = (dsAllocator*)&systemAllocator;
+	}
+
+	void TearDown() override
+	{
+		EXPECT_EQ(0U, allocator->size);
+	}
+
+	dsSystemAllocator systemAllocator;
+	dsAllocator* allocator;
+};
+
+TEST_F(HashMapTest, Initialize)
+{
+	dsHashMap hashMap;
+	EXPECT_FALSE_ERRNO(EINVAL, dsHashMap_initialize(nullptr, allocator, 0, &dsHashString,
+		&dsHashStringEqual));
+	EXPECT_FALSE_ERRNO(EINVAL, dsHashMap_initialize(&hashMap, nullptr, 0, &dsHashString,
+		&dsHashStringEqual));
+	EXPECT_FALSE_ERRNO(EINVAL, dsHashMap_initialize(&hashMap, allocator, 0, nullptr,
+		&dsHashStringEqual));
+	EXPECT_FALSE_ERRNO(EINVAL, dsHashMap_initialize(&hashMap, allocator, 0, &dsHashString,
+		nullptr));
+
+	dsBufferAllocator bufferAllocator;
+	uint8_t buffer[1024];
+	ASSERT_TRUE(dsBufferAllocator_initialize(&bufferAllocator, buffer, sizeof(buffer)));
+	EXPECT_FALSE_ERRNO(EINVAL, dsHashMap_initialize(&hashMap, (dsAllocator*)&bufferAllocator, 0,
+		&dsHashString, &dsHashStringEqual));
+
+	// No allocations until needed.
+	EXPECT_TRUE(dsHashMap_initialize(&hashMap, allocator, 0, &dsHashString, &dsHashStringEqual));
+	EXPECT_EQ(0U, allocator->currentAllocations);
+	EXPECT_EQ(0U, hashMap.capacity);
+	EXPECT_FALSE(dsHashMap_find(&hashMap, "test"));
+	EXPECT_FALSE(dsHashMap_remove(&hashMap, "test", nullptr));
+	dsHashMap_shutdown(&hashMap);
+
+	EXPECT_TRUE(dsHashMap_initialize(&hashMap, allocator, 100, &dsHashString,
+		&dsHashStringEqual));
+	EXPECT_LE(100U, hashMap.maxEntries);
+	EXPECT_EQ(128U, hashMap.capacity);
+	EXPECT_EQ(112U, hashMap.growthLeft);
+	dsHashMap_shutdown(&hashMap);
+}
+
+TEST_F(HashMapTest, Insert)
+{
+	dsHashMap hashMap;
+	ASSERT_TRUE(dsHashMap_initialize(&hashMap, allocator, 0, &dsHashString, &dsHashStringEqual));
+
+	int value1 = 1, value2 = 2, value3 = 3;
+	void* existingValue;
+	EXPECT_FALSE_ERRNO(EINVAL, dsHashMap_insert(nullptr, "first", &value1, nullptr));
+	EXPECT_TRUE(dsHashMap_insert(&hashMap, "first", &value1, &existingValue));
+	EXPECT_EQ(nullptr, existingValue);
+	EXPECT_TRUE(dsHashMap_insert(&hashMap, "second", &value2, nullptr));
+	EXPECT_TRUE(dsHashMap_insert(&hashMap, "third", &value3, nullptr));
+
+	EXPECT_FALSE_ERRNO(EPERM, dsHashMap_insert(&hashMap, "second", &value3, &existingValue));
+	EXPECT_EQ(&value2, existingValue);
+	EXPECT_EQ(3U, hashMap.entryCount);
+
+	// Entries are stored in insertion order.
+	EXPECT_STREQ("first", (const char*)hashMap.entries[0].key);
+	EXPECT_EQ(&value1, hashMap.entries[0].value);
+	EXPECT_STREQ("second", (const char*)hashMap.entries[1].key);
+	EXPECT_EQ(&value2, hashMap.entries[1].value);
+	EXPECT_STREQ("third", (const char*)hashMap.entries[2].key);
+	EXPECT_EQ(&value3, hashMap.entries[2].value);
+
+	dsHashMap_shutdown(&hashMap);
+}
+
+TEST_F(HashMapTest, Find)
+{
+	dsHashMap hashMap;
+	ASSERT_TRUE(dsHashMap_initialize(&hashMap, allocator, 0, &dsHashString, &dsHashStringEqual));
+
+	int value1 = 1, value2 = 2, value3 = 3;
+	EXPECT_TRUE(dsHashMap_insert(&hashMap, "first", &value1, nullptr));
+	EXPECT_TRUE(dsHashMap_insert(&hashMap, "second", &value2, nullptr));
+	EXPECT_TRUE(dsHashMap_insert(&hashMap, "third", &value3, nullptr));
+
+	EXPECT_EQ(nullptr, dsHashMap_find(nullptr, "first"));
+	dsHashMapEntry* entry = dsHashMap_find(&hashMap, "first");
+	ASSERT_TRUE(entry);
+	EXPECT_EQ(&value1, entry->value);
+
+	entry = dsHashMap_find(&hashMap, "second");
+	ASSERT_TRUE(entry);
+	EXPECT_EQ(&value2, entry->value);
+
+	entry = dsHashMap_find(&hashMap, "third");
+	ASSERT_TRUE(entry);
+	EXPECT_EQ(&value3, entry->value);
+
+	EXPECT_EQ(nullptr, dsHashMap_find(&hashMap, "fourth"));
+
+	dsHashMap_shutdown(&hashMap);
+}
+
+TEST_F(HashMapTest, Remove)
+{
+	dsHashMap hashMap;
+	ASSERT_TRUE(dsHashMap_initialize(&hashMap, allocator, 0, &dsHashString, &dsHashStringEqual));
+
+	int value1 = 1, value2 = 2, value3 = 3;
+	EXPECT_TRUE(dsHashMap_insert(&hashMap, "first", &value1, nullptr));
+	EXPECT_TRUE(dsHashMap_insert(&hashMap, "second", &value2, nullptr));
+	EXPECT_TRUE(dsHashMap_insert(&hashMap, "third", &value3, nullptr));
+
+	dsHashMapEntry removedEntry;
+	EXPECT_FALSE(dsHashMap_remove(nullptr, "first", &removedEntry));
+	EXPECT_FALSE(dsHashMap_remove(&hashMap, "fourth", &removedEntry));
+
+	// The last entry is moved into the removed entry's place.
+	EXPECT_TRUE(dsHashMap_remove(&hashMap, "first", &removedEntry));
+	EXPECT_STREQ("first", (const char*)removedEntry.key);
+	EXPECT_EQ(&value1, removedEntry.value);
+	ASSERT_EQ(2U, hashMap.entryCount);
+	EXPECT_STREQ("third", (const char*)hashMap.entries[0].key);
+	EXPECT_STREQ("second", (const char*)hashMap.entries[1].key);
+
+	EXPECT_EQ(nullptr, dsHashMap_find(&hashMap, "first"));
+	dsHashMapEntry* entry = dsHashMap_find(&hashMap, "third");
+	ASSERT_TRUE(entry);
+	EXPECT_EQ(&value3, entry->value);
+	EXPECT_FALSE(dsHashMap_remove(&hashMap, "first", nullptr));
+
+	EXPECT_TRUE(dsHashMap_remove(&hashMap, "second", nullptr));
+	EXPECT_TRUE(dsHashMap_remove(&hashMap, "third", nullptr));
+	EXPECT_EQ(0U, hashMap.entryCount);
+	EXPECT_EQ(nullptr, dsHashMap_find(&hashMap, "third"));
+
+	// Re-insert after removing.
+	EXPECT_TRUE(dsHashMap_insert(&hashMap, "first", &value1, nullptr));
+	entry = dsHashMap_find(&hashMap, "first");
+	ASSERT_TRUE(entry);
+	EXPECT_EQ(&value1, entry->value);
+
+	dsHashMap_shutdown(&hashMap);
+}
+
+TEST_F(HashMapTest, Clear)
+{
+	dsHashMap hashMap;
+	ASSERT_TRUE(dsHashMap_initialize(&hashMap, allocator, 0, &dsHashString, &dsHashStringEqual));
+
+	int value1 = 1, value2 = 2;
+	EXPECT_TRUE(dsHashMap_insert(&hashMap, "first", &value1, nullptr));
+	EXPECT_TRUE(dsHashMap_insert(&hashMap, "second", &value2, nullptr));
+
+	EXPECT_FALSE_ERRNO(EINVAL, dsHashMap_clear(nullptr));
+	EXPECT_TRUE(dsHashMap_clear(&hashMap));
+	EXPECT_EQ(0U, hashMap.entryCount);
+	EXPECT_EQ(nullptr, dsHashMap_find(&hashMap, "first"));
+	EXPECT_EQ(nullptr, dsHashMap_find(&hashMap, "second"));
+
+	EXPECT_TRUE(dsHashMap_insert(&hashMap, "second", &value2, nullptr));
+	dsHashMapEntry* entry = dsHashMap_find(&hashMap, "second");
+	ASSERT_TRUE(entry);
+	EXPECT_EQ(&value2, entry->value);
+
+	dsHashMap_shutdown(&hashMap);
+}
+
+TEST_F(HashMapTest, Grow)
+{
+	const uint32_t keyCount = 10000;
+	std::vector<uint32_t> keys(keyCount);
+	for (uint32_t i = 0; i < keyCount; ++i)
+		keys[i] = i*7;
+
+	dsHashMap hashMap;
+	ASSERT_TRUE(dsHashMap_initialize(&hashMap, allocator, 0, &dsHash32, &dsHash32Equal));
+	for (uint32_t i = 0; i < keyCount; ++i)
+	{
+		ASSERT_TRUE(dsHashMap_insert(&hashMap, keys.data() + i, (void*)(size_t)i, nullptr));
+	}
+
+	EXPECT_EQ(keyCount, hashMap.entryCount);
+	EXPECT_EQ(16384U, hashMap.capacity);
+	for (uint32_t i = 0; i < keyCount; ++i)
+	{
+		uint32_t key = i*7;
+		dsHashMapEntry* entry = dsHashMap_find(&hashMap, &key);
+		ASSERT_TRUE(entry);
+		EXPECT_EQ(i, (uint32_t)(size_t)entry->value);
+
+		key = i*7 + 1;
+		EXPECT_EQ(nullptr, dsHashMap_find(&hashMap, &key));
+	}
+
+	// Remove every other key, then check the remaining keys are still found after entries are
+	// moved.
+	for (uint32_t i = 0; i < keyCount; i += 2)
+	{
+		ASSERT_TRUE(dsHashMap_remove(&hashMap, keys.data() + i, nullptr));
+	}
+	EXPECT_EQ(keyCount/2, hashMap.entryCount);
+
+	for (uint32_t i = 0; i < keyCount; ++i)
+	{
+		dsHashMapEntry* entry = dsHashMap_find(&hashMap, keys.data() + i);
+		if (i % 2 == 0)
+		{
+			EXPECT_EQ(nullptr, entry);
+		}
+		else
+		{
+			ASSERT_TRUE(entry);
+			EXPECT_EQ(i, (uint32_t)(size_t)entry->value);
+		}
+	}
+
+	// Repeatedly removing and inserting shouldn't grow the table with deleted slots.
+	for (uint32_t j = 0; j < 10; ++j)
+	{
+		for (uint32_t i = 0; i < keyCount; i += 2)
+		{
+			ASSERT_TRUE(dsHashMap_insert(&hashMap, keys.data() + i, (void*)(size_t)i, nullptr));
+		}
+		for (uint32_t i = 0; i < keyCount; i += 2)
+		{
+			ASSERT_TRUE(dsHashMap_remove(&hashMap, keys.data() + i, nullptr));
+		}
+	}
+	EXPECT_EQ(16384U, hashMap.capacity);
+
+	dsHashMap_shutdown(&hashMap);
+}
+
+TEST_F(HashMapTest, Collisions)
+{
+	const uint32_t keyCount = 100;
+	std::vector<uint32_t> keys(keyCount);
+	for (uint32_t i = 0; i < keyCount; ++i)
+		keys[i] = i;
+
+	// All keys share the same hash, requiring probing across groups.
+	dsHashMap hashMap;
+	ASSERT_TRUE(dsHashMap_initialize(&hashMap, allocator, 0, &chainHashFunction,
+		&dsHash32Equal));
+	for (uint32_t i = 0; i < keyCount; ++i)
+	{
+		ASSERT_TRUE(dsHashMap_insert(&hashMap, keys.data() + i, (void*)(size_t)i, nullptr));
+	}
+
+	for (uint32_t i = 0; i < keyCount; ++i)
+	{
+		dsHashMapEntry* entry = dsHashMap_find(&hashMap, keys.data() + i);
+		ASSERT_TRUE(entry);
+		EXPECT_EQ(i, (uint32_t)(size_t)entry->value);
+	}
+
+	for (uint32_t i = 0; i < keyCount; i += 3)
+	{
+		ASSERT_TRUE(dsHashMap_remove(&hashMap, keys.data() + i, nullptr));
+	}
+
+	for (uint32_t i = 0; i < keyCount; ++i)
+	{
+		dsHashMapEntry* entry = dsHashMap_find(&hashMap, keys.data() + i);
+		if (i % 3 == 0)
+		{
+			EXPECT_EQ(nullptr, entry);
+		}
+		else
+		{
+			ASSERT_TRUE(entry);
+			EXPECT_EQ(i, (uint32_t)(size_t)entry->value);
+		}
+	}
+
+	dsHashMap_shutdown(&hashMap);
+}
+
+#if DS_PERFORMANCE_TESTS
+
+namespace
+{
+
+const uint32_t performanceKeyCount = 100000;
+const uint32_t performanceIterations = 10;
+
+struct TestNode
+{
+	dsHashTableNode node;
+	uint32_t value;
+};
+
+void printRate(const char* name, const char* operation, uint64_t ticks, uint32_t count)
+{
+	dsTimer timer = dsTimer_create();
+	double seconds = dsTimer_ticksToSeconds(timer, ticks);
+	printf("%s %s: %f operations/s\n", name, operation, (double)count/seconds);
+}
+
+} // namespace
+
+TEST_F(HashMapTest, Performance)
+{
+	std::vector<uint32_t> keys(performanceKeyCount);
+	std::vector<uint32_t> missingKeys(performanceKeyCount);
+	for (uint32_t i = 0; i < performanceKeyCount; ++i)
+	{
+		keys[i] = i*2;
+		missingKeys[i] = i*2 + 1;
+	}
+
+	const uint32_t totalCount = performanceKeyCount*performanceIterations;
+	size_t tableSize = dsHashTable_tableSize(performanceKeyCount);
+	dsHashTable* hashTable = (dsHashTable*)dsAllocator_alloc(allocator,
+		dsHashTable_sizeof(tableSize));
+	ASSERT_TRUE(hashTable);
+	std::vector<TestNode> nodes(performanceKeyCount);
+
+	uint64_t insertTicks = 0;
+	for (uint32_t j = 0; j < performanceIterations; ++j)
+	{
+		ASSERT_TRUE(dsHashTable_initialize(hashTable, tableSize, &dsHash32, &dsHash32Equal));
+		uint64_t start = dsTimer_currentTicks();
+		for (uint32_t i = 0; i < performanceKeyCount; ++i)
+		{
+			nodes[i].value = i;
+			DS_VERIFY(dsHashTable_insert(hashTable, keys.data() + i, (dsHashTableNode*)&nodes[i],
+				nullptr));
+		}
+		insertTicks += dsTimer_currentTicks() - start;
+	}
+
+	uint64_t start = dsTimer_currentTicks();
+	uint32_t sum = 0;
+	for (uint32_t j = 0; j < performanceIterations; ++j)
+	{
+		for (uint32_t i = 0; i < performanceKeyCount; ++i)
+		{
+			auto node = (TestNode*)dsHashTable_find(hashTable, keys.data() + i);
+			sum += node->value;
+			sum += dsHashTable_find(hashTable, missingKeys.data() + i) != nullptr;
+		}
+	}
+	uint64_t lookupTicks = dsTimer_currentTicks() - start;
+
+	start = dsTimer_currentTicks();
+	for (uint32_t j = 0; j < performanceIterations; ++j)
+	{
+		for (dsListNode* node = hashTable->list.head; node; node = node->next)
+			sum += ((TestNode*)node)->value;
+	}
+	uint64_t iterateTicks = dsTimer_currentTicks() - start;
+
+	printRate("hash table", "insert", insertTicks, totalCount);
+	printRate("hash table", "lookup", lookupTicks, totalCount*2);
+	printRate("hash table", "iterate", iterateTicks, totalCount);
+	printf("\n");
+	DS_VERIFY(dsAllocator_free(allocator, hashTable));
+
+	dsHashMap hashMap;
+	ASSERT_TRUE(dsHashMap_initialize(&hashMap, allocator, 0, &dsHash32, &dsHash32Equal));
+	insertTicks = 0;
+	for (uint32_t j = 0; j < performanceIterations; ++j)
+	{
+		DS_VERIFY(dsHashMap_clear(&hashMap));
+		start = dsTimer_currentTicks();
+		for (uint32_t i = 0; i < performanceKeyCount; ++i)
+		{
+			DS_VERIFY(dsHashMap_insert(&hashMap, keys.data() + i, (void*)(size_t)i, nullptr));
+		}
+		insertTicks += dsTimer_currentTicks() - start;
+	}
+
+	start = dsTimer_currentTicks();
+	for (uint32_t j = 0; j < performanceIterations; ++j)
+	{
+		for (uint32_t i = 0; i < performanceKeyCount; ++i)
+		{
+			dsHashMapEntry* entry = dsHashMap_find(&hashMap, keys.data() + i);
+			sum += (uint32_t)(size_t)entry->value;
+			sum += dsHashMap_find(&hashMap, missingKeys.data() + i) != nullptr;
+		}
+	}
+	lookupTicks = dsTimer_currentTicks() - start;
+
+	start = dsTimer_currentTicks();
+	for (uint32_t j = 0; j < performanceIterations; ++j)
+	{
+		for (uint32_t i = 0; i < hashMap.entryCount; ++i)
+			sum += (uint32_t)(size_t)hashMap.entries[i].value;
+	}
+	iterateTicks = dsTimer_currentTicks() - start;
+
+	printRate("hash map", "insert", insertTicks, totalCount);
+	printRate("hash map", "lookup", lookupTicks, totalCount*2);
+	printRate("hash map", "iterate", iterateTicks, totalCount);
+	printf("(checksum %u)\n", sum);
+	dsHashMap_shutdown(&hashMap);
+}
+
+#endif // DS_PERFORMANCE_TESTS
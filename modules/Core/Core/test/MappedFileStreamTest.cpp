@@ -0,0 +1,147 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Helpers.h"
+
+#include <DeepSea/Core/Streams/FileStream.h>
+#include <DeepSea/Core/Streams/MappedFileStream.h>
+#include <DeepSea/Core/Streams/Path.h>
+#include <DeepSea/Core/Streams/ResourceStream.h>
+#include <DeepSea/Core/Streams/Stream.h>
+
+#include <gtest/gtest.h>
+
+TEST(MappedFileStream, Null)
+{
+	int32_t dummyData;
+	size_t size;
+	EXPECT_EQ_ERRNO(EINVAL, 0U, dsMappedFileStream_read(NULL, &dummyData, sizeof(dummyData)));
+	EXPECT_FALSE_ERRNO(EINVAL, dsMappedFileStream_seek(NULL, 0, dsStreamSeekWay_Beginning));
+	EXPECT_EQ_ERRNO(EINVAL, DS_STREAM_INVALID_POS, dsMappedFileStream_tell(NULL));
+	EXPECT_EQ_ERRNO(EINVAL, nullptr, dsMappedFileStream_getBuffer(NULL, &size));
+	EXPECT_FALSE_ERRNO(EINVAL, dsMappedFileStream_close(NULL));
+}
+
+TEST(MappedFileStream, Empty)
+{
+	dsMappedFileStream stream = {};
+	int32_t dummyData;
+	size_t size;
+	EXPECT_EQ_ERRNO(EINVAL, 0U, dsMappedFileStream_read(&stream, &dummyData, sizeof(dummyData)));
+	EXPECT_FALSE_ERRNO(EINVAL, dsMappedFileStream_seek(&stream, 0, dsStreamSeekWay_Beginning));
+	EXPECT_EQ_ERRNO(EINVAL, DS_STREAM_INVALID_POS, dsMappedFileStream_tell(&stream));
+	EXPECT_EQ_ERRNO(EINVAL, nullptr, dsMappedFileStream_getBuffer(&stream, &size));
+	EXPECT_FALSE_ERRNO(EINVAL, dsMappedFileStream_close(&stream));
+}
+
+TEST(MappedFileStream, InvalidOpen)
+{
+	dsMappedFileStream stream = {};
+	EXPECT_FALSE_ERRNO(EINVAL, dsMappedFileStream_openPath(NULL, "asdf"));
+	EXPECT_FALSE_ERRNO(EINVAL, dsMappedFileStream_openPath(&stream, NULL));
+	EXPECT_FALSE_ERRNO(EINVAL, dsMappedFileStream_openPath(&stream, ""));
+}
+
+// TODO: iOS has restrictive filesystem permissions and we don't have the application code available
+// here to set the proper directory.
+#if !DS_IOS
+
+TEST(MappedFileStream, ReadFile)
+{
+	char path[DS_PATH_MAX];
+	ASSERT_TRUE(dsResourceStream_getPath(path, sizeof(path), dsFileResourceType_Dynamic, "asdf"));
+
+	dsFileStream fileStream;
+	ASSERT_TRUE(dsFileStream_openPath(&fileStream, path, "w"));
+	int32_t dummyData = 1;
+	EXPECT_EQ(sizeof(dummyData), dsFileStream_write(&fileStream, &dummyData, sizeof(dummyData)));
+	dummyData = 2;
+	EXPECT_EQ(sizeof(dummyData), dsFileStream_write(&fileStream, &dummyData, sizeof(dummyData)));
+	EXPECT_TRUE(dsFileStream_close(&fileStream));
+
+	dsMappedFileStream stream;
+	ASSERT_TRUE(dsMappedFileStream_openPath(&stream, path));
+	EXPECT_TRUE(dsStream_canGetBuffer((dsStream*)&stream));
+	EXPECT_EQ(2*sizeof(dummyData), dsStream_remainingBytes((dsStream*)&stream));
+
+	size_t size;
+	auto data = reinterpret_cast<const int32_t*>(dsStream_getBuffer(&size, (dsStream*)&stream));
+	ASSERT_TRUE(data);
+	EXPECT_EQ(2*sizeof(dummyData), size);
+	EXPECT_EQ(1, data[0]);
+	EXPECT_EQ(2, data[1]);
+
+	EXPECT_EQ(sizeof(dummyData), dsStream_read((dsStream*)&stream, &dummyData, sizeof(dummyData)));
+	EXPECT_EQ(1, dummyData);
+	EXPECT_EQ(data + 1, dsStream_getBuffer(&size, (dsStream*)&stream));
+	EXPECT_EQ(sizeof(dummyData), size);
+
+	EXPECT_EQ(sizeof(dummyData)/2, dsStream_read((dsStream*)&stream, &dummyData,
+		sizeof(dummyData)/2));
+	EXPECT_EQ(sizeof(dummyData)/2, dsStream_read((dsStream*)&stream,
+		(uint8_t*)&dummyData + sizeof(dummyData)/2, sizeof(dummyData)));
+	EXPECT_EQ(2, dummyData);
+	EXPECT_EQ(0U, dsStream_remainingBytes((dsStream*)&stream));
+
+	EXPECT_TRUE(dsStream_seek((dsStream*)&stream, 3, dsStreamSeekWay_Beginning));
+	EXPECT_EQ(3U, dsStream_tell((dsStream*)&stream));
+	EXPECT_TRUE(dsStream_seek((dsStream*)&stream, 2, dsStreamSeekWay_Current));
+	EXPECT_EQ(5U, dsStream_tell((dsStream*)&stream));
+	EXPECT_TRUE(dsStream_seek((dsStream*)&stream, -1, dsStreamSeekWay_End));
+	EXPECT_EQ(2*sizeof(dummyData) - 1, dsStream_tell((dsStream*)&stream));
+	EXPECT_FALSE(dsStream_seek((dsStream*)&stream, -4, dsStreamSeekWay_Beginning));
+	EXPECT_FALSE(dsStream_seek((dsStream*)&stream, 1, dsStreamSeekWay_End));
+	EXPECT_EQ(2*sizeof(dummyData) - 1, dsStream_tell((dsStream*)&stream));
+
+	EXPECT_TRUE(dsStream_close((dsStream*)&stream));
+	EXPECT_FALSE_ERRNO(EINVAL, dsMappedFileStream_close(&stream));
+
+	EXPECT_TRUE(dsFileStream_removeFile(path));
+}
+
+TEST(MappedFileStream, EmptyFile)
+{
+	char path[DS_PATH_MAX];
+	ASSERT_TRUE(dsResourceStream_getPath(path, sizeof(path), dsFileResourceType_Dynamic, "asdf"));
+
+	dsFileStream fileStream;
+	ASSERT_TRUE(dsFileStream_openPath(&fileStream, path, "w"));
+	EXPECT_TRUE(dsFileStream_close(&fileStream));
+
+	dsMappedFileStream stream;
+	ASSERT_TRUE(dsMappedFileStream_openPath(&stream, path));
+	size_t size = 1;
+	EXPECT_TRUE(dsStream_getBuffer(&size, (dsStream*)&stream));
+	EXPECT_EQ(0U, size);
+
+	int32_t dummyData;
+	EXPECT_EQ(0U, dsStream_read((dsStream*)&stream, &dummyData, sizeof(dummyData)));
+	EXPECT_TRUE(dsStream_close((dsStream*)&stream));
+
+	EXPECT_TRUE(dsFileStream_removeFile(path));
+}
+
+TEST(MappedFileStream, MissingFile)
+{
+	char path[DS_PATH_MAX];
+	ASSERT_TRUE(dsResourceStream_getPath(path, sizeof(path), dsFileResourceType_Dynamic,
+		"missing"));
+
+	dsMappedFileStream stream;
+	EXPECT_FALSE_ERRNO(ENOENT, dsMappedFileStream_openPath(&stream, path));
+}
+
+#endif // !DS_IOS
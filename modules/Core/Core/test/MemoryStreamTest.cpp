@@ -1,5 +1,5 @@
 /*
- * Copyright 2016-2025 Aaron Barany
+ * Copyright 2016-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -142,6 +142,25 @@ TEST(MemoryStream, ReadWriteStreamFunctions)
 	EXPECT_FALSE_ERRNO(EINVAL, dsStream_close((dsStream*)&stream));
 }
 
+TEST(MemoryStream, GetBuffer)
+{
+	dsMemoryStream stream;
+	int32_t buffer[2] = {1, 2};
+	size_t size;
+
+	EXPECT_TRUE(dsMemoryStream_open(&stream, buffer, sizeof(buffer)));
+	EXPECT_TRUE(dsStream_canGetBuffer((dsStream*)&stream));
+	EXPECT_EQ(buffer, dsStream_getBuffer(&size, (dsStream*)&stream));
+	EXPECT_EQ(sizeof(buffer), size);
+
+	EXPECT_TRUE(dsStream_seek((dsStream*)&stream, sizeof(int32_t), dsStreamSeekWay_Beginning));
+	EXPECT_EQ(buffer + 1, dsStream_getBuffer(&size, (dsStream*)&stream));
+	EXPECT_EQ(sizeof(int32_t), size);
+
+	EXPECT_TRUE(dsMemoryStream_close(&stream));
+	EXPECT_EQ_ERRNO(EINVAL, nullptr, dsMemoryStream_getBuffer(&stream, &size));
+}
+
 TEST(MemoryStream, ReadUntilEnd)
 {
 	dsSystemAllocator allocator;
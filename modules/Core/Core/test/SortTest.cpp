@@ -1,5 +1,5 @@
 /*
- * Copyright 2018-2023 Aaron Barany
+ * Copyright 2018-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -14,8 +14,12 @@
  * limitations under the License.
  */
 
+#include <DeepSea/Core/Memory/SystemAllocator.h>
+#include <DeepSea/Core/Thread/ThreadPool.h>
 #include <DeepSea/Core/Sort.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
 #include <vector>
 
 namespace
@@ -38,6 +42,27 @@ static int compareInt(const void* left, const void* right, void*)
 	return *(const int*)left - *(const int*)right;
 }
 
+struct KeyedValue
+{
+	uint32_t index;
+	union
+	{
+		uint32_t uintKey;
+		float floatKey;
+	};
+};
+
+struct LargeValue
+{
+	uint64_t key;
+	uint8_t padding[13];
+};
+
+static int compareLargeValue(const void* left, const void* right, void*)
+{
+	return DS_CMP(((const LargeValue*)left)->key, ((const LargeValue*)right)->key);
+}
+
 } // namespace
 
 TEST(SortTest, Cmp)
@@ -68,6 +93,209 @@ TEST(SortTest, IndirectSort)
 	EXPECT_EQ(std::vector<int>({4, 3, 2, 1, 0}), data.order);
 }
 
+TEST(SortTest, Sort)
+{
+	std::mt19937 random(0);
+	std::uniform_int_distribution<int> distribution(-1000, 1000);
+	for (std::size_t count : {0, 1, 2, 5, 16, 17, 100, 1000, 10000})
+	{
+		std::vector<int> values(count);
+		for (int& value : values)
+			value = distribution(random);
+
+		std::vector<int> expectedValues = values;
+		std::sort(expectedValues.begin(), expectedValues.end());
+		dsSort(values.data(), values.size(), sizeof(int), &compareInt, NULL);
+		EXPECT_EQ(expectedValues, values);
+
+		// Already sorted and reversed.
+		dsSort(values.data(), values.size(), sizeof(int), &compareInt, NULL);
+		EXPECT_EQ(expectedValues, values);
+
+		std::reverse(values.begin(), values.end());
+		dsSort(values.data(), values.size(), sizeof(int), &compareInt, NULL);
+		EXPECT_EQ(expectedValues, values);
+	}
+
+	// Few unique values.
+	std::vector<int> values(1000);
+	for (std::size_t i = 0; i < values.size(); ++i)
+		values[i] = (int)(i % 3);
+	std::vector<int> expectedValues = values;
+	std::sort(expectedValues.begin(), expectedValues.end());
+	dsSort(values.data(), values.size(), sizeof(int), &compareInt, NULL);
+	EXPECT_EQ(expectedValues, values);
+}
+
+TEST(SortTest, SortLargeMembers)
+{
+	std::mt19937 random(0);
+	std::vector<LargeValue> values(1000);
+	for (LargeValue& value : values)
+	{
+		value.key = random() % 500;
+		for (std::size_t i = 0; i < sizeof(value.padding); ++i)
+			value.padding[i] = (uint8_t)value.key;
+	}
+
+	dsSort(values.data(), values.size(), sizeof(LargeValue), &compareLargeValue, NULL);
+	for (std::size_t i = 0; i < values.size(); ++i)
+	{
+		if (i > 0)
+		{
+			EXPECT_LE(values[i - 1].key, values[i].key);
+		}
+		for (std::size_t j = 0; j < sizeof(values[i].padding); ++j)
+			EXPECT_EQ((uint8_t)values[i].key, values[i].padding[j]);
+	}
+}
+
+TEST(SortTest, ParallelSort)
+{
+	dsSystemAllocator allocator;
+	ASSERT_TRUE(dsSystemAllocator_initialize(&allocator, DS_ALLOCATOR_NO_LIMIT));
+	dsThreadPool* threadPool = dsThreadPool_create((dsAllocator*)&allocator, 3,
+		dsThreadPoolFlags_None, 0, NULL, NULL, NULL);
+	ASSERT_TRUE(threadPool);
+
+	std::mt19937 random(0);
+	std::uniform_int_distribution<int> distribution(-100000, 100000);
+	for (std::size_t count : {100, 100000})
+	{
+		std::vector<int> values(count);
+		for (int& value : values)
+			value = distribution(random);
+
+		std::vector<int> expectedValues = values;
+		std::sort(expectedValues.begin(), expectedValues.end());
+		dsParallelSort(values.data(), values.size(), sizeof(int), &compareInt, NULL, threadPool,
+			(dsAllocator*)&allocator);
+		EXPECT_EQ(expectedValues, values);
+
+		std::reverse(values.begin(), values.end());
+		dsParallelSort(values.data(), values.size(), sizeof(int), &compareInt, NULL, threadPool,
+			(dsAllocator*)&allocator);
+		EXPECT_EQ(expectedValues, values);
+	}
+
+	EXPECT_TRUE(dsThreadPool_destroy(threadPool));
+	EXPECT_EQ(0U, ((dsAllocator*)&allocator)->size);
+}
+
+TEST(SortTest, RadixSortUInt32Key)
+{
+	std::vector<KeyedValue> values(1000);
+	std::vector<KeyedValue> tempValues(values.size());
+	EXPECT_FALSE(dsRadixSortUInt32Key(values.data(), tempValues.data(), values.size(),
+		sizeof(uint32_t), 2));
+	EXPECT_FALSE(dsRadixSortUInt32Key(values.data(), NULL, values.size(), sizeof(KeyedValue),
+		offsetof(KeyedValue, uintKey)));
+
+	std::mt19937 random(0);
+	for (uint32_t maxKey : {100U, 0xFFFFFFFFU})
+	{
+		std::uniform_int_distribution<uint32_t> distribution(0, maxKey);
+		for (uint32_t i = 0; i < values.size(); ++i)
+		{
+			values[i].index = i;
+			values[i].uintKey = distribution(random);
+		}
+
+		std::vector<KeyedValue> expectedValues = values;
+		std::stable_sort(expectedValues.begin(), expectedValues.end(),
+			[](const KeyedValue& left, const KeyedValue& right)
+			{
+				return left.uintKey < right.uintKey;
+			});
+
+		EXPECT_TRUE(dsRadixSortUInt32Key(values.data(), tempValues.data(), values.size(),
+			sizeof(KeyedValue), offsetof(KeyedValue, uintKey)));
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			EXPECT_EQ(expectedValues[i].uintKey, values[i].uintKey);
+			EXPECT_EQ(expectedValues[i].index, values[i].index);
+		}
+	}
+}
+
+TEST(SortTest, RadixSortUInt64Key)
+{
+	struct Keyed64Value
+	{
+		uint64_t key;
+		uint32_t index;
+		uint32_t padding;
+	};
+
+	std::vector<Keyed64Value> values(1000);
+	std::vector<Keyed64Value> tempValues(values.size());
+	EXPECT_FALSE(dsRadixSortUInt64Key(values.data(), tempValues.data(), values.size(),
+		sizeof(uint32_t), 0));
+	EXPECT_FALSE(dsRadixSortUInt64Key(values.data(), tempValues.data(), values.size(),
+		sizeof(Keyed64Value), 12));
+	EXPECT_FALSE(dsRadixSortUInt64Key(values.data(), NULL, values.size(), sizeof(Keyed64Value),
+		offsetof(Keyed64Value, key)));
+
+	std::mt19937_64 random(0);
+	for (uint64_t maxKey : {100ULL, 0xFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL})
+	{
+		std::uniform_int_distribution<uint64_t> distribution(0, maxKey);
+		for (uint32_t i = 0; i < values.size(); ++i)
+		{
+			values[i].key = distribution(random);
+			values[i].index = i;
+		}
+
+		std::vector<Keyed64Value> expectedValues = values;
+		std::stable_sort(expectedValues.begin(), expectedValues.end(),
+			[](const Keyed64Value& left, const Keyed64Value& right)
+			{
+				return left.key < right.key;
+			});
+
+		EXPECT_TRUE(dsRadixSortUInt64Key(values.data(), tempValues.data(), values.size(),
+			sizeof(Keyed64Value), offsetof(Keyed64Value, key)));
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			EXPECT_EQ(expectedValues[i].key, values[i].key);
+			EXPECT_EQ(expectedValues[i].index, values[i].index);
+		}
+	}
+}
+
+TEST(SortTest, RadixSortFloatKey)
+{
+	std::vector<KeyedValue> values(1000);
+	std::vector<KeyedValue> tempValues(values.size());
+
+	std::mt19937 random(0);
+	std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+	for (uint32_t i = 0; i < values.size(); ++i)
+	{
+		values[i].index = i;
+		// Include some duplicates to check for stability.
+		if (i % 10 == 0)
+			values[i].floatKey = 1.5f;
+		else
+			values[i].floatKey = distribution(random);
+	}
+
+	std::vector<KeyedValue> expectedValues = values;
+	std::stable_sort(expectedValues.begin(), expectedValues.end(),
+		[](const KeyedValue& left, const KeyedValue& right)
+		{
+			return left.floatKey < right.floatKey;
+		});
+
+	EXPECT_TRUE(dsRadixSortFloatKey(values.data(), tempValues.data(), values.size(),
+		sizeof(KeyedValue), offsetof(KeyedValue, floatKey)));
+	for (std::size_t i = 0; i < values.size(); ++i)
+	{
+		EXPECT_EQ(expectedValues[i].floatKey, values[i].floatKey);
+		EXPECT_EQ(expectedValues[i].index, values[i].index);
+	}
+}
+
 TEST(SortTest, BinarySearch)
 {
 	std::vector<int> values = {1, 2, 3, 4, 5};
@@ -0,0 +1,221 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Helpers.h"
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Memory/SystemAllocator.h>
+#include <DeepSea/Core/Thread/TaskGraph.h>
+#include <DeepSea/Core/Thread/ThreadPool.h>
+#include <DeepSea/Core/Atomic.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+// Handle older versions of gtest.
+#ifndef INSTANTIATE_TEST_SUITE_P
+#define INSTANTIATE_TEST_SUITE_P INSTANTIATE_TEST_CASE_P
+#endif
+
+namespace
+{
+
+struct GraphState
+{
+	uint32_t nextOrder;
+	std::vector<uint32_t> order;
+};
+
+struct NodeState
+{
+	GraphState* graphState;
+	uint32_t index;
+};
+
+void recordOrder(void* userData)
+{
+	NodeState* nodeState = reinterpret_cast<NodeState*>(userData);
+	GraphState* graphState = nodeState->graphState;
+	graphState->order[nodeState->index] = DS_ATOMIC_FETCH_ADD32(&graphState->nextOrder, 1);
+}
+
+} // namespace
+
+class TaskGraphTest : public testing::TestWithParam<dsThreadPoolFlags>
+{
+public:
+	TaskGraphTest()
+		: allocator(reinterpret_cast<dsAllocator*>(&systemAllocator))
+	{
+	}
+
+	void SetUp() override
+	{
+		EXPECT_TRUE(dsSystemAllocator_initialize(&systemAllocator, DS_ALLOCATOR_NO_LIMIT));
+		threadPool = dsThreadPool_create(allocator, 4, GetParam(), 0, NULL, NULL, NULL);
+		ASSERT_TRUE(threadPool);
+	}
+
+	void TearDown() override
+	{
+		EXPECT_TRUE(dsThreadPool_destroy(threadPool));
+		EXPECT_EQ(0U, allocator->size);
+	}
+
+	dsSystemAllocator systemAllocator;
+	dsAllocator* allocator;
+	dsThreadPool* threadPool;
+};
+
+INSTANTIATE_TEST_SUITE_P(ThreadPoolFlags, TaskGraphTest,
+	testing::Values(dsThreadPoolFlags_None, dsThreadPoolFlags_WorkStealing));
+
+TEST_P(TaskGraphTest, Create)
+{
+	EXPECT_NULL_ERRNO(EINVAL, dsTaskGraph_create(nullptr, threadPool, 20, 0));
+	EXPECT_NULL_ERRNO(EINVAL, dsTaskGraph_create(allocator, nullptr, 20, 0));
+	EXPECT_NULL_ERRNO(EINVAL, dsTaskGraph_create(allocator, threadPool, 0, 0));
+	dsTaskGraph* graph = dsTaskGraph_create(allocator, threadPool, 20, 0);
+	ASSERT_TRUE(graph);
+	EXPECT_EQ(0U, dsTaskGraph_getTaskCount(graph));
+	EXPECT_FALSE_ERRNO(EPERM, dsThreadPool_destroy(threadPool));
+	dsTaskGraph_destroy(graph);
+}
+
+TEST_P(TaskGraphTest, AddTask)
+{
+	dsTaskGraph* graph = dsTaskGraph_create(allocator, threadPool, 20, 0);
+	ASSERT_TRUE(graph);
+
+	EXPECT_EQ(DS_TASK_GRAPH_INVALID_TASK, dsTaskGraph_addTask(nullptr, nullptr, nullptr, 0));
+	EXPECT_EQ(EINVAL, errno);
+	EXPECT_EQ(DS_TASK_GRAPH_INVALID_TASK, dsTaskGraph_addTask(graph, nullptr, nullptr, 1));
+	EXPECT_EQ(EINVAL, errno);
+
+	uint32_t predecessor = 0;
+	EXPECT_EQ(DS_TASK_GRAPH_INVALID_TASK, dsTaskGraph_addTask(graph, nullptr, &predecessor, 1));
+	EXPECT_EQ(EINDEX, errno);
+
+	EXPECT_EQ(0U, dsTaskGraph_addTask(graph, nullptr, nullptr, 0));
+	EXPECT_EQ(1U, dsTaskGraph_addTask(graph, nullptr, &predecessor, 1));
+	EXPECT_EQ(2U, dsTaskGraph_addTask(graph, nullptr, nullptr, 0));
+	EXPECT_EQ(3U, dsTaskGraph_getTaskCount(graph));
+
+	EXPECT_FALSE_ERRNO(EINVAL, dsTaskGraph_addDependency(nullptr, 2, 1));
+	EXPECT_FALSE_ERRNO(EINDEX, dsTaskGraph_addDependency(graph, 3, 1));
+	EXPECT_FALSE_ERRNO(EINDEX, dsTaskGraph_addDependency(graph, 1, 1));
+	EXPECT_FALSE_ERRNO(EINDEX, dsTaskGraph_addDependency(graph, 1, 2));
+	EXPECT_TRUE(dsTaskGraph_addDependency(graph, 2, 1));
+
+	EXPECT_TRUE(dsTaskGraph_start(graph));
+	EXPECT_EQ(DS_TASK_GRAPH_INVALID_TASK, dsTaskGraph_addTask(graph, nullptr, nullptr, 0));
+	EXPECT_EQ(EPERM, errno);
+	EXPECT_FALSE_ERRNO(EPERM, dsTaskGraph_addDependency(graph, 2, 0));
+	EXPECT_FALSE_ERRNO(EPERM, dsTaskGraph_clear(graph));
+	EXPECT_FALSE_ERRNO(EPERM, dsTaskGraph_start(graph));
+	EXPECT_TRUE(dsTaskGraph_wait(graph));
+
+	EXPECT_TRUE(dsTaskGraph_clear(graph));
+	EXPECT_EQ(0U, dsTaskGraph_getTaskCount(graph));
+	EXPECT_TRUE(dsTaskGraph_execute(graph));
+
+	dsTaskGraph_destroy(graph);
+}
+
+TEST_P(TaskGraphTest, Chain)
+{
+	constexpr uint32_t taskCount = 100;
+	dsTaskGraph* graph = dsTaskGraph_create(allocator, threadPool, 20, 0);
+	ASSERT_TRUE(graph);
+
+	GraphState graphState = {0, std::vector<uint32_t>(taskCount)};
+	NodeState nodeStates[taskCount];
+	for (uint32_t i = 0; i < taskCount; ++i)
+	{
+		nodeStates[i].graphState = &graphState;
+		nodeStates[i].index = i;
+		dsThreadTask task = {&recordOrder, nodeStates + i};
+		uint32_t predecessor = i - 1;
+		EXPECT_EQ(i, dsTaskGraph_addTask(graph, &task, &predecessor, i > 0 ? 1 : 0));
+	}
+
+	EXPECT_TRUE(dsTaskGraph_execute(graph));
+	EXPECT_EQ(taskCount, graphState.nextOrder);
+	for (uint32_t i = 0; i < taskCount; ++i)
+		EXPECT_EQ(i, graphState.order[i]);
+
+	dsTaskGraph_destroy(graph);
+}
+
+TEST_P(TaskGraphTest, Dependencies)
+{
+	// Layers of tasks that each depend on every task of the previous layer, joined by an empty
+	// task in the middle.
+	constexpr uint32_t layerSize = 50;
+	constexpr uint32_t layerCount = 4;
+	dsTaskGraph* graph = dsTaskGraph_create(allocator, threadPool, 20, 0);
+	ASSERT_TRUE(graph);
+
+	GraphState graphState = {0, std::vector<uint32_t>(layerSize*layerCount)};
+	std::vector<NodeState> nodeStates(layerSize*layerCount);
+	std::vector<uint32_t> layerTasks[layerCount];
+	uint32_t joinTask = DS_TASK_GRAPH_INVALID_TASK;
+	for (uint32_t i = 0; i < layerCount; ++i)
+	{
+		if (i == layerCount/2)
+		{
+			joinTask = dsTaskGraph_addTask(graph, nullptr, layerTasks[i - 1].data(),
+				layerSize);
+			ASSERT_NE(DS_TASK_GRAPH_INVALID_TASK, joinTask);
+		}
+
+		for (uint32_t j = 0; j < layerSize; ++j)
+		{
+			uint32_t index = i*layerSize + j;
+			nodeStates[index].graphState = &graphState;
+			nodeStates[index].index = index;
+			dsThreadTask task = {&recordOrder, nodeStates.data() + index};
+
+			uint32_t taskIndex;
+			if (i == 0)
+				taskIndex = dsTaskGraph_addTask(graph, &task, nullptr, 0);
+			else if (i == layerCount/2)
+				taskIndex = dsTaskGraph_addTask(graph, &task, &joinTask, 1);
+			else
+			{
+				taskIndex = dsTaskGraph_addTask(graph, &task, nullptr, 0);
+				ASSERT_NE(DS_TASK_GRAPH_INVALID_TASK, taskIndex);
+				for (uint32_t predecessor : layerTasks[i - 1])
+					EXPECT_TRUE(dsTaskGraph_addDependency(graph, taskIndex, predecessor));
+			}
+			ASSERT_NE(DS_TASK_GRAPH_INVALID_TASK, taskIndex);
+			layerTasks[i].push_back(taskIndex);
+		}
+	}
+
+	for (unsigned int iteration = 0; iteration < 10; ++iteration)
+	{
+		graphState.nextOrder = 0;
+		EXPECT_TRUE(dsTaskGraph_execute(graph));
+		EXPECT_EQ(layerSize*layerCount, graphState.nextOrder);
+		for (uint32_t i = 0; i < layerSize*layerCount; ++i)
+		{
+			uint32_t layer = i/layerSize;
+			EXPECT_LE(layer*layerSize, graphState.order[i]);
+			EXPECT_GT((layer + 1)*layerSize, graphState.order[i]);
+		}
+	}
+
+	dsTaskGraph_destroy(graph);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright 2023 Aaron Barany
+ * Copyright 2023-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -21,8 +21,15 @@
 #include <DeepSea/Core/Thread/Mutex.h>
 #include <DeepSea/Core/Thread/Thread.h>
 #include <DeepSea/Core/Thread/ThreadPool.h>
+#include <DeepSea/Core/Thread/ThreadTaskQueue.h>
 #include <DeepSea/Core/Atomic.h>
+#include <DeepSea/Core/Timer.h>
 #include <gtest/gtest.h>
+#include <vector>
+
+// NOTE: Performance tests measure the throughput of many small tasks to compare contention between
+// the default and work stealing modes.
+#define DS_PERFORMANCE_TESTS 0
 
 class ThreadPoolTest : public testing::Test
 {
@@ -57,11 +64,20 @@ static uint64_t splitMix64(uint64_t& state)
 
 TEST_F(ThreadPoolTest, Create)
 {
-	EXPECT_NULL_ERRNO(EINVAL, dsThreadPool_create(NULL, 2, 0, NULL, NULL, NULL));
-	EXPECT_NULL_ERRNO(EINVAL, dsThreadPool_create(allocator, DS_THREAD_POOL_MAX_THREADS + 1, 0,
-		NULL, NULL, NULL));
-	dsThreadPool* threadPool = dsThreadPool_create(allocator, 2, 0, NULL, NULL, NULL);
+	EXPECT_NULL_ERRNO(EINVAL, dsThreadPool_create(NULL, 2, dsThreadPoolFlags_None, 0, NULL, NULL,
+		NULL));
+	EXPECT_NULL_ERRNO(EINVAL, dsThreadPool_create(allocator, DS_THREAD_POOL_MAX_THREADS + 1,
+		dsThreadPoolFlags_None, 0, NULL, NULL, NULL));
+	dsThreadPool* threadPool = dsThreadPool_create(allocator, 2, dsThreadPoolFlags_None, 0, NULL,
+		NULL, NULL);
+	EXPECT_TRUE(threadPool);
+	EXPECT_EQ(dsThreadPoolFlags_None, dsThreadPool_getFlags(threadPool));
+	EXPECT_TRUE(dsThreadPool_destroy(threadPool));
+
+	threadPool = dsThreadPool_create(allocator, 2, dsThreadPoolFlags_WorkStealing, 0, NULL, NULL,
+		NULL);
 	EXPECT_TRUE(threadPool);
+	EXPECT_EQ(dsThreadPoolFlags_WorkStealing, dsThreadPool_getFlags(threadPool));
 	EXPECT_TRUE(dsThreadPool_destroy(threadPool));
 }
 
@@ -87,8 +103,8 @@ TEST_F(ThreadPoolTest, SetThreads)
 		DS_ATOMIC_FETCH_ADD32(&threadData->endCount, 1);
 	};
 
-	dsThreadPool* threadPool = dsThreadPool_create(allocator, 2, 0, startThreadFunc, endThreadFunc,
-		&threadData);
+	dsThreadPool* threadPool = dsThreadPool_create(allocator, 2, dsThreadPoolFlags_None, 0,
+		startThreadFunc, endThreadFunc, &threadData);
 	ASSERT_TRUE(threadPool);
 	EXPECT_EQ(2U, dsThreadPool_getThreadCount(threadPool));
 	EXPECT_EQ(2U, threadData.startCount);
@@ -131,7 +147,8 @@ TEST_F(ThreadPoolTest, StressTestSetThreads)
 	ASSERT_TRUE(startCondition);
 	bool start = false;
 
-	dsThreadPool* threadPool = dsThreadPool_create(allocator, 0, 0, NULL, NULL, NULL);
+	dsThreadPool* threadPool = dsThreadPool_create(allocator, 0, dsThreadPoolFlags_None, 0, NULL,
+		NULL, NULL);
 	ASSERT_TRUE(threadPool);
 
 	uint64_t randomState = 0;
@@ -187,3 +204,74 @@ TEST_F(ThreadPoolTest, StressTestSetThreads)
 	dsMutex_destroy(startMutex);
 	dsConditionVariable_destroy(startCondition);
 }
+
+#if DS_PERFORMANCE_TESTS
+
+static void ThreadPoolTest_PerformanceTaskThroughput(dsAllocator* allocator,
+	dsThreadPoolFlags flags, const char* name)
+{
+	constexpr unsigned int batchSize = 1000;
+	constexpr unsigned int batchCount = 500;
+
+	struct TaskState
+	{
+		uint64_t value;
+		// Avoid false sharing between tasks.
+		uint8_t padding[56];
+	};
+
+	auto taskFunc = [](void* userData)
+	{
+		auto state = reinterpret_cast<TaskState*>(userData);
+		uint64_t value = state->value;
+		for (unsigned int i = 0; i < 100; ++i)
+			value = value*6364136223846793005ULL + 1442695040888963407ULL;
+		state->value = value;
+	};
+
+	std::vector<TaskState> states(batchSize);
+	std::vector<dsThreadTask> tasks(batchSize);
+	for (unsigned int i = 0; i < batchSize; ++i)
+	{
+		states[i].value = i;
+		tasks[i].taskFunc = taskFunc;
+		tasks[i].userData = states.data() + i;
+	}
+
+	dsTimer timer = dsTimer_create();
+	unsigned int maxThreadCount = dsThreadPool_fullThreadCount();
+	for (unsigned int threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+	{
+		dsThreadPool* threadPool = dsThreadPool_create(allocator, threadCount, flags, 0, NULL,
+			NULL, NULL);
+		ASSERT_TRUE(threadPool);
+		dsThreadTaskQueue* taskQueue = dsThreadTaskQueue_create(allocator, threadPool, batchSize,
+			0);
+		ASSERT_TRUE(taskQueue);
+
+		uint64_t start = dsTimer_currentTicks();
+		for (unsigned int i = 0; i < batchCount; ++i)
+		{
+			EXPECT_TRUE(dsThreadTaskQueue_addTasks(taskQueue, tasks.data(), batchSize));
+			EXPECT_TRUE(dsThreadTaskQueue_waitForTasks(taskQueue));
+		}
+		uint64_t end = dsTimer_currentTicks();
+
+		double seconds = dsTimer_ticksToSeconds(timer, end - start);
+		printf("%s %u threads: %f tasks/s\n", name, threadCount,
+			(double)(batchSize*batchCount)/seconds);
+
+		dsThreadTaskQueue_destroy(taskQueue);
+		EXPECT_TRUE(dsThreadPool_destroy(threadPool));
+	}
+}
+
+TEST_F(ThreadPoolTest, Performance)
+{
+	ThreadPoolTest_PerformanceTaskThroughput(allocator, dsThreadPoolFlags_None, "shared");
+	printf("\n");
+	ThreadPoolTest_PerformanceTaskThroughput(allocator, dsThreadPoolFlags_WorkStealing,
+		"work stealing");
+}
+
+#endif // DS_PERFORMANCE_TESTS
@@ -1,5 +1,5 @@
 /*
- * Copyright 2023 Aaron Barany
+ * Copyright 2023-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -22,9 +22,15 @@
 #include <DeepSea/Core/Thread/Thread.h>
 #include <DeepSea/Core/Thread/ThreadPool.h>
 #include <DeepSea/Core/Thread/ThreadTaskQueue.h>
+#include <DeepSea/Core/Atomic.h>
 #include <gtest/gtest.h>
 
-class ThreadTaskQueueTest : public testing::Test
+// Handle older versions of gtest.
+#ifndef INSTANTIATE_TEST_SUITE_P
+#define INSTANTIATE_TEST_SUITE_P INSTANTIATE_TEST_CASE_P
+#endif
+
+class ThreadTaskQueueTest : public testing::TestWithParam<dsThreadPoolFlags>
 {
 public:
 	ThreadTaskQueueTest()
@@ -35,7 +41,7 @@ public:
 	void SetUp() override
 	{
 		EXPECT_TRUE(dsSystemAllocator_initialize(&systemAllocator, DS_ALLOCATOR_NO_LIMIT));
-		threadPool = dsThreadPool_create(allocator, 0, 0, NULL, NULL, NULL);
+		threadPool = dsThreadPool_create(allocator, 0, GetParam(), 0, NULL, NULL, NULL);
 		ASSERT_TRUE(threadPool);
 	}
 
@@ -50,7 +56,10 @@ public:
 	dsThreadPool* threadPool;
 };
 
-TEST_F(ThreadTaskQueueTest, Create)
+INSTANTIATE_TEST_SUITE_P(ThreadPoolFlags, ThreadTaskQueueTest,
+	testing::Values(dsThreadPoolFlags_None, dsThreadPoolFlags_WorkStealing));
+
+TEST_P(ThreadTaskQueueTest, Create)
 {
 	EXPECT_NULL_ERRNO(EINVAL, dsThreadTaskQueue_create(nullptr, threadPool, 20, 0));
 	EXPECT_NULL_ERRNO(EINVAL, dsThreadTaskQueue_create(allocator, nullptr, 20, 0));
@@ -61,7 +70,7 @@ TEST_F(ThreadTaskQueueTest, Create)
 	dsThreadTaskQueue_destroy(taskQueue);
 }
 
-TEST_F(ThreadTaskQueueTest, WaitForTasks)
+TEST_P(ThreadTaskQueueTest, WaitForTasks)
 {
 	constexpr unsigned int taskCount = 5;
 	dsThreadTaskQueue* taskQueue = dsThreadTaskQueue_create(allocator, threadPool, taskCount, 0);
@@ -99,7 +108,7 @@ TEST_F(ThreadTaskQueueTest, WaitForTasks)
 	dsThreadTaskQueue_destroy(taskQueue);
 }
 
-TEST_F(ThreadTaskQueueTest, AddOverLimit)
+TEST_P(ThreadTaskQueueTest, AddOverLimit)
 {
 	constexpr unsigned int taskCount = 5;
 	dsThreadTaskQueue* taskQueue =
@@ -138,7 +147,7 @@ TEST_F(ThreadTaskQueueTest, AddOverLimit)
 	dsThreadTaskQueue_destroy(taskQueue);
 }
 
-TEST_F(ThreadTaskQueueTest, WaitOnDestroy)
+TEST_P(ThreadTaskQueueTest, WaitOnDestroy)
 {
 	constexpr unsigned int taskCount = 5;
 	dsThreadTaskQueue* taskQueue = dsThreadTaskQueue_create(allocator, threadPool, taskCount, 0);
@@ -174,8 +183,12 @@ TEST_F(ThreadTaskQueueTest, WaitOnDestroy)
 	EXPECT_EQ(taskCount, finishedCounter);
 }
 
-TEST_F(ThreadTaskQueueTest, RoundRobin)
+TEST_P(ThreadTaskQueueTest, RoundRobin)
 {
+	// Work stealing doesn't guarantee any ordering between task queues.
+	if (GetParam() & dsThreadPoolFlags_WorkStealing)
+		return;
+
 	constexpr unsigned int taskQueueCount = 5;
 	constexpr unsigned int taskCount = 5;
 	dsThreadTaskQueue* taskQueues[taskQueueCount];
@@ -272,7 +285,7 @@ TEST_F(ThreadTaskQueueTest, RoundRobin)
 	dsConditionVariable_destroy(finishCondition);
 }
 
-TEST_F(ThreadTaskQueueTest, MaxConcurrency)
+TEST_P(ThreadTaskQueueTest, MaxConcurrency)
 {
 	constexpr unsigned int taskCount = 20;
 	constexpr unsigned int threadCount = 4;
@@ -344,7 +357,7 @@ TEST_F(ThreadTaskQueueTest, MaxConcurrency)
 	dsConditionVariable_destroy(state.finishCondition);
 }
 
-TEST_F(ThreadTaskQueueTest, AddTaskWithinTask)
+TEST_P(ThreadTaskQueueTest, AddTaskWithinTask)
 {
 	constexpr unsigned int taskCount = 5;
 	dsThreadTaskQueue* taskQueue = dsThreadTaskQueue_create(allocator, threadPool, taskCount, 0);
@@ -389,3 +402,52 @@ TEST_F(ThreadTaskQueueTest, AddTaskWithinTask)
 
 	dsThreadTaskQueue_destroy(taskQueue);
 }
+
+TEST_P(ThreadTaskQueueTest, ManyTasks)
+{
+	constexpr unsigned int threadCount = 4;
+	constexpr unsigned int batchSize = 100;
+	constexpr unsigned int batchCount = 50;
+	dsThreadTaskQueue* taskQueue = dsThreadTaskQueue_create(allocator, threadPool, batchSize/2,
+		0);
+	ASSERT_TRUE(taskQueue);
+	EXPECT_TRUE(dsThreadPool_setThreadCount(threadPool, threadCount));
+
+	struct TaskState
+	{
+		dsThreadTaskQueue* taskQueue;
+		const dsThreadTask* childTask;
+		uint32_t* finishedCounter;
+	};
+
+	auto childTaskFunc = [](void* userData)
+	{
+		DS_ATOMIC_FETCH_ADD32(reinterpret_cast<uint32_t*>(userData), 1);
+	};
+
+	auto taskFunc = [](void* userData)
+	{
+		auto state = reinterpret_cast<TaskState*>(userData);
+		DS_ATOMIC_FETCH_ADD32(state->finishedCounter, 1);
+		EXPECT_TRUE(dsThreadTaskQueue_addTasks(state->taskQueue, state->childTask, 1));
+	};
+
+	uint32_t finishedCounter = 0;
+	dsThreadTask childTask = {childTaskFunc, &finishedCounter};
+	TaskState state = {taskQueue, &childTask, &finishedCounter};
+	dsThreadTask tasks[batchSize];
+	for (unsigned int i = 0; i < batchSize; ++i)
+	{
+		tasks[i].taskFunc = taskFunc;
+		tasks[i].userData = &state;
+	}
+
+	for (unsigned int i = 0; i < batchCount; ++i)
+	{
+		EXPECT_TRUE(dsThreadTaskQueue_addTasks(taskQueue, tasks, batchSize));
+		EXPECT_TRUE(dsThreadTaskQueue_waitForTasks(taskQueue));
+		EXPECT_EQ((i + 1)*batchSize*2, finishedCounter);
+	}
+
+	dsThreadTaskQueue_destroy(taskQueue);
+}
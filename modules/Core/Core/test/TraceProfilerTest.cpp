@@ -0,0 +1,243 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Helpers.h"
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Memory/SystemAllocator.h>
+#include <DeepSea/Core/Streams/MemoryStream.h>
+#include <DeepSea/Core/Thread/Thread.h>
+#include <DeepSea/Core/Profile.h>
+#include <DeepSea/Core/Timer.h>
+#include <DeepSea/Core/TraceProfiler.h>
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Enable to run performance tests.
+#define DS_PERFORMANCE_TESTS 0
+
+// Call the profile functions directly so the tests don't depend on DS_PROFILING_ENABLED.
+#define PUSH(type, name, dynamicName) \
+	dsProfile_push(nullptr, type, name, __FILE__, __FUNCTION__, __LINE__, dynamicName)
+#define POP(type) dsProfile_pop(type, __FILE__, __FUNCTION__, __LINE__)
+
+class TraceProfilerTest : public testing::Test
+{
+public:
+	TraceProfilerTest()
+		: allocator(reinterpret_cast<dsAllocator*>(&systemAllocator))
+	{
+	}
+
+	void SetUp() override
+	{
+		EXPECT_TRUE(dsSystemAllocator_initialize(&systemAllocator, DS_ALLOCATOR_NO_LIMIT));
+	}
+
+	void TearDown() override
+	{
+		if (dsTraceProfiler_isStarted())
+		{
+			EXPECT_TRUE(dsTraceProfiler_stop());
+		}
+		EXPECT_EQ(0U, allocator->size);
+	}
+
+	static std::string writeJSON()
+	{
+		std::vector<char> buffer(1024*1024);
+		dsMemoryStream stream;
+		EXPECT_TRUE(dsMemoryStream_open(&stream, buffer.data(), buffer.size()));
+		EXPECT_TRUE(dsTraceProfiler_writeJSON(reinterpret_cast<dsStream*>(&stream)));
+		std::string json(buffer.data(), static_cast<size_t>(dsMemoryStream_tell(&stream)));
+		EXPECT_TRUE(dsMemoryStream_close(&stream));
+		return json;
+	}
+
+	static unsigned int countMatches(const std::string& json, const std::string& match)
+	{
+		unsigned int count = 0;
+		for (std::size_t pos = json.find(match); pos != std::string::npos;
+			pos = json.find(match, pos + match.size()))
+		{
+			++count;
+		}
+		return count;
+	}
+
+	static dsThreadReturnType threadFunc(void*)
+	{
+		for (unsigned int i = 0; i < 100; ++i)
+		{
+			PUSH(dsProfileType_Scope, "Thread Scope", false);
+			POP(dsProfileType_Scope);
+		}
+		return 0;
+	}
+
+	dsSystemAllocator systemAllocator;
+	dsAllocator* allocator;
+};
+
+TEST_F(TraceProfilerTest, StartStop)
+{
+	EXPECT_FALSE_ERRNO(EINVAL, dsTraceProfiler_start(nullptr, 0, 0, 0));
+	EXPECT_FALSE_ERRNO(EPERM, dsTraceProfiler_stop());
+
+	ASSERT_TRUE(dsTraceProfiler_start(allocator, 0, 0, 0));
+	EXPECT_TRUE(dsTraceProfiler_isStarted());
+	EXPECT_TRUE(dsProfile_getFunctions()->pushFunc);
+	EXPECT_FALSE_ERRNO(EPERM, dsTraceProfiler_start(allocator, 0, 0, 0));
+
+	EXPECT_TRUE(dsTraceProfiler_stop());
+	EXPECT_FALSE(dsTraceProfiler_isStarted());
+	EXPECT_FALSE(dsProfile_getFunctions()->pushFunc);
+	EXPECT_FALSE_ERRNO(EPERM, dsTraceProfiler_writeJSONFile("trace.json"));
+}
+
+TEST_F(TraceProfilerTest, WriteEvents)
+{
+	ASSERT_TRUE(dsTraceProfiler_start(allocator, 0, 0, 0));
+
+	dsProfile_registerThread("Main");
+	dsProfile_startFrame();
+	PUSH(dsProfileType_Function, "Outer", false);
+
+	// Dynamic names must be copied since the original string may change.
+	char dynamicName[] = "Dynamic \"Scope\"";
+	PUSH(dsProfileType_Scope, dynamicName, true);
+	dynamicName[0] = 'X';
+
+	dsProfile_stat(nullptr, "Stats", "Count", 3.0, __FILE__, __FUNCTION__, __LINE__, false);
+	dsProfile_gpu("GPU", "Draw", 2000000);
+	POP(dsProfileType_Scope);
+	POP(dsProfileType_Function);
+	dsProfile_endFrame();
+
+	std::string json = writeJSON();
+	EXPECT_EQ(0U, json.find("{\"traceEvents\":["));
+	EXPECT_EQ(1U, countMatches(json,
+		"\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Main\"}"));
+	EXPECT_EQ(1U, countMatches(json, "\"name\":\"Frame\",\"cat\":\"Frame\",\"ph\":\"B\""));
+	EXPECT_EQ(1U, countMatches(json, "\"name\":\"Outer\",\"cat\":\"Function\",\"ph\":\"B\""));
+	EXPECT_EQ(1U, countMatches(json,
+		"\"name\":\"Dynamic \\\"Scope\\\"\",\"cat\":\"Scope\",\"ph\":\"B\""));
+	EXPECT_EQ(1U, countMatches(json, "\"name\":\"Count\",\"cat\":\"Stats\",\"ph\":\"C\""));
+	EXPECT_EQ(1U, countMatches(json, "\"args\":{\"value\":3}"));
+	EXPECT_EQ(1U, countMatches(json, "\"name\":\"Draw\",\"cat\":\"GPU\",\"ph\":\"C\""));
+	EXPECT_EQ(1U, countMatches(json, "\"args\":{\"ms\":2}"));
+	EXPECT_EQ(3U, countMatches(json, "\"ph\":\"E\""));
+
+	EXPECT_TRUE(dsTraceProfiler_stop());
+}
+
+TEST_F(TraceProfilerTest, LastFrames)
+{
+	ASSERT_TRUE(dsTraceProfiler_start(allocator, 0, 0, 2));
+
+	for (unsigned int i = 0; i < 5; ++i)
+	{
+		char name[16];
+		std::snprintf(name, sizeof(name), "Frame %u", i);
+		dsProfile_startFrame();
+		PUSH(dsProfileType_Scope, name, true);
+		POP(dsProfileType_Scope);
+		dsProfile_endFrame();
+	}
+
+	std::string json = writeJSON();
+	EXPECT_EQ(0U, countMatches(json, "\"Frame 0\""));
+	EXPECT_EQ(0U, countMatches(json, "\"Frame 1\""));
+	EXPECT_EQ(0U, countMatches(json, "\"Frame 2\""));
+	EXPECT_EQ(1U, countMatches(json, "\"Frame 3\""));
+	EXPECT_EQ(1U, countMatches(json, "\"Frame 4\""));
+	EXPECT_EQ(4U, countMatches(json, "\"ph\":\"B\""));
+	EXPECT_EQ(4U, countMatches(json, "\"ph\":\"E\""));
+
+	EXPECT_TRUE(dsTraceProfiler_stop());
+}
+
+TEST_F(TraceProfilerTest, OverwriteOldest)
+{
+	ASSERT_TRUE(dsTraceProfiler_start(allocator, 64, 0, 0));
+
+	for (unsigned int i = 0; i < 100; ++i)
+	{
+		PUSH(dsProfileType_Scope, "Scope", false);
+		POP(dsProfileType_Scope);
+	}
+	PUSH(dsProfileType_Scope, "Scope", false);
+
+	// The oldest event kept is an end, which should be skipped since its begin was overwritten.
+	std::string json = writeJSON();
+	EXPECT_EQ(32U, countMatches(json, "\"ph\":\"B\""));
+	EXPECT_EQ(31U, countMatches(json, "\"ph\":\"E\""));
+
+	POP(dsProfileType_Scope);
+
+	EXPECT_TRUE(dsTraceProfiler_stop());
+}
+
+TEST_F(TraceProfilerTest, MultipleThreads)
+{
+	ASSERT_TRUE(dsTraceProfiler_start(allocator, 0, 0, 0));
+
+	const unsigned int threadCount = 4;
+	dsThread threads[threadCount];
+	for (unsigned int i = 0; i < threadCount; ++i)
+		ASSERT_TRUE(dsThread_create(threads + i, &threadFunc, nullptr, 0, "Profile Thread"));
+
+	// Exporting while the threads are recording must be safe.
+	writeJSON();
+
+	for (unsigned int i = 0; i < threadCount; ++i)
+		EXPECT_TRUE(dsThread_join(threads + i, nullptr));
+
+	std::string json = writeJSON();
+	EXPECT_EQ(threadCount, countMatches(json, "\"args\":{\"name\":\"Profile Thread\"}"));
+	EXPECT_EQ(threadCount*100,
+		countMatches(json, "\"name\":\"Thread Scope\",\"cat\":\"Scope\",\"ph\":\"B\""));
+
+	EXPECT_TRUE(dsTraceProfiler_stop());
+}
+
+#if DS_PERFORMANCE_TESTS
+TEST_F(TraceProfilerTest, EventOverhead)
+{
+	const unsigned int iterations = 100000;
+	ASSERT_TRUE(dsTraceProfiler_start(allocator, 4096, 0, 0));
+
+	dsTimer timer = dsTimer_create();
+	uint64_t startTicks = dsTimer_currentTicks();
+	for (unsigned int i = 0; i < iterations; ++i)
+	{
+		PUSH(dsProfileType_Scope, "Overhead", false);
+		POP(dsProfileType_Scope);
+	}
+	uint64_t endTicks = dsTimer_currentTicks();
+
+	EXPECT_TRUE(dsTraceProfiler_stop());
+
+	double eventNs = dsTimer_ticksToSeconds(timer, endTicks - startTicks)*1e9/(iterations*2);
+	RecordProperty("EventOverheadNs", std::to_string(eventNs));
+	std::printf("Trace profiler overhead: %.1f ns per event\n", eventNs);
+
+	// Very loose bound to catch accidental locking or allocation for each event.
+	EXPECT_LT(eventNs, 5000.0);
+}
+#endif // DS_PERFORMANCE_TESTS
@@ -1,5 +1,5 @@
 /*
- * Copyright 2025 Aaron Barany
+ * Copyright 2025-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -21,9 +21,12 @@
 #include <DeepSea/Core/Streams/Path.h>
 #include <DeepSea/Core/Streams/Stream.h>
 #include <DeepSea/Core/Streams/ZipArchive.h>
+#include <DeepSea/Core/Thread/ThreadPool.h>
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 #if DS_ZIP_ARCHIVE_ENABLED
 
@@ -631,6 +634,259 @@ TEST_F(ZipArchiveTest, ReadCompressed)
 	dsZipArchive_close(archive);
 }
 
+TEST_F(ZipArchiveTest, CompressedSeek)
+{
+	char buffer[1024];
+	char path[DS_PATH_MAX];
+	ASSERT_TRUE(dsPath_combine(path, sizeof(path), assetDir, "large.zip"));
+	dsZipArchive* archive = dsZipArchive_openResource(allocator, dsFileResourceType_Embedded, path,
+		DS_MIN_ZIP_DECOMPRESS_BUFFER_SIZE);
+	ASSERT_TRUE(archive);
+
+	dsStream* stream = dsZipArchive_openFile(archive, "README.md");
+	ASSERT_TRUE(stream);
+
+	size_t fileSize = 16901;
+	std::vector<char> expected(fileSize);
+	EXPECT_EQ(fileSize, dsStream_read(stream, expected.data(), fileSize));
+
+	const size_t offsets[] = {8000, 62, 16000, 0, 300, 12345};
+	for (size_t offset : offsets)
+	{
+		ASSERT_TRUE(dsStream_seek(stream, offset, dsStreamSeekWay_Beginning));
+		EXPECT_EQ(offset, dsStream_tell(stream));
+		EXPECT_EQ(fileSize - offset, dsStream_remainingBytes(stream));
+
+		size_t readSize = std::min(sizeof(buffer), fileSize - offset);
+		EXPECT_EQ(readSize, dsStream_read(stream, buffer, readSize));
+		EXPECT_EQ(0, std::memcmp(buffer, expected.data() + offset, readSize));
+	}
+
+	ASSERT_TRUE(dsStream_seek(stream, -100, dsStreamSeekWay_Current));
+	EXPECT_EQ(12345U + sizeof(buffer) - 100, dsStream_tell(stream));
+	EXPECT_EQ(100U, dsStream_read(stream, buffer, 100));
+	EXPECT_EQ(0, std::memcmp(buffer, expected.data() + 12345 + sizeof(buffer) - 100, 100));
+
+	ASSERT_TRUE(dsStream_seek(stream, -50, dsStreamSeekWay_End));
+	EXPECT_EQ(fileSize - 50, dsStream_tell(stream));
+	EXPECT_EQ(50U, dsStream_read(stream, buffer, sizeof(buffer)));
+	EXPECT_EQ(0, std::memcmp(buffer, expected.data() + fileSize - 50, 50));
+
+	EXPECT_FALSE_ERRNO(EINVAL, dsStream_seek(stream, -1, dsStreamSeekWay_Beginning));
+	EXPECT_FALSE_ERRNO(EINVAL, dsStream_seek(stream, 1, dsStreamSeekWay_End));
+
+	EXPECT_TRUE(dsStream_close(stream));
+	dsZipArchive_close(archive);
+}
+
+// The counter entry in checkpoints.zip is made of 32-byte records, each a 32-bit little-endian
+// record index followed by fixed text. This allows the expected data to be computed for any
+// position, so reading from the wrong position or with a corrupted window can't go unnoticed.
+static const char counterText[] = "DeepSea zip seek checkpoint\n";
+static const size_t counterRecordSize = 32;
+static const size_t counterSize = 3145728;
+
+static void getCounterData(char* data, size_t offset, size_t size)
+{
+	for (size_t i = 0; i < size; ++i)
+	{
+		size_t position = offset + i;
+		size_t record = position/counterRecordSize;
+		size_t recordOffset = position % counterRecordSize;
+		if (recordOffset < sizeof(uint32_t))
+			data[i] = static_cast<char>((record >> (recordOffset*8)) & 0xFF);
+		else
+			data[i] = counterText[recordOffset - sizeof(uint32_t)];
+	}
+}
+
+static void checkCounterRead(dsStream* stream, size_t offset, size_t size)
+{
+	std::vector<char> expected(size);
+	std::vector<char> buffer(size);
+	getCounterData(expected.data(), offset, size);
+
+	ASSERT_TRUE(dsStream_seek(stream, offset, dsStreamSeekWay_Beginning)) << "offset " << offset;
+	EXPECT_EQ(offset, dsStream_tell(stream));
+	ASSERT_EQ(size, dsStream_read(stream, buffer.data(), size)) << "offset " << offset;
+	EXPECT_EQ(offset + size, dsStream_tell(stream));
+	EXPECT_TRUE(buffer == expected) << "offset " << offset << ", size " << size;
+}
+
+TEST_F(ZipArchiveTest, CompressedSeekCheckpoints)
+{
+	char path[DS_PATH_MAX];
+	ASSERT_TRUE(dsPath_combine(path, sizeof(path), assetDir, "checkpoints.zip"));
+	dsZipArchive* archive = dsZipArchive_openResource(allocator, dsFileResourceType_Embedded, path,
+		DS_MIN_ZIP_DECOMPRESS_BUFFER_SIZE);
+	ASSERT_TRUE(archive);
+
+	// Checkpoints are recorded at the first deflate block boundary after each 1 MB. For the counter
+	// entry these are at the following positions, which aren't on byte boundaries within the
+	// compressed data, so restoring them requires both the bit offset and window.
+	const size_t checkpoints[] = {1310145, 2620769};
+
+	// Seek forward past where the checkpoints will be recorded before reading anything.
+	dsStream* stream = dsZipArchive_openFile(archive, "counter");
+	ASSERT_TRUE(stream);
+	EXPECT_EQ(counterSize, dsStream_remainingBytes(stream));
+	checkCounterRead(stream, checkpoints[1] + 300001, 4096);
+
+	// Seek to just before, at, and after each checkpoint, both backward and forward.
+	std::vector<size_t> offsets = {0, 17};
+	for (size_t checkpoint : checkpoints)
+	{
+		offsets.insert(offsets.end(), {checkpoint - 4099, checkpoint - 1, checkpoint,
+			checkpoint + 1, checkpoint + 65541});
+	}
+	for (auto it = offsets.rbegin(); it != offsets.rend(); ++it)
+		checkCounterRead(stream, *it, 4096);
+	for (size_t offset : offsets)
+		checkCounterRead(stream, offset, 4096);
+
+	// Reads that cross the checkpoints after restoring from an earlier one.
+	checkCounterRead(stream, checkpoints[0] - 100003, 400000);
+	checkCounterRead(stream, 17, checkpoints[0] + 200000);
+	checkCounterRead(stream, checkpoints[0] + 31, checkpoints[1] - checkpoints[0] + 5000);
+
+	// Read to the end after restoring a checkpoint.
+	const size_t endOffset = counterSize - 70001;
+	checkCounterRead(stream, endOffset, counterSize - endOffset);
+	EXPECT_EQ(0U, dsStream_remainingBytes(stream));
+	char extra;
+	EXPECT_EQ(0U, dsStream_read(stream, &extra, 1));
+
+	EXPECT_TRUE(dsStream_seek(stream, -1000003, dsStreamSeekWay_Current));
+	std::vector<char> expected(1000003);
+	std::vector<char> buffer(1000003);
+	getCounterData(expected.data(), counterSize - 1000003, expected.size());
+	EXPECT_EQ(buffer.size(), dsStream_read(stream, buffer.data(), buffer.size()));
+	EXPECT_TRUE(buffer == expected);
+	EXPECT_TRUE(dsStream_close(stream));
+
+	// Read the entire entry in one pass, then seek back through it in reverse.
+	stream = dsZipArchive_openFile(archive, "counter");
+	ASSERT_TRUE(stream);
+	checkCounterRead(stream, 0, counterSize);
+	const size_t step = 65536 + 37;
+	for (size_t offset = counterSize - 4096; offset > step; offset -= step)
+		checkCounterRead(stream, offset, 4096);
+	EXPECT_TRUE(dsStream_close(stream));
+
+	dsZipArchive_close(archive);
+}
+
+TEST_F(ZipArchiveTest, Cache)
+{
+	char path[DS_PATH_MAX];
+	ASSERT_TRUE(dsPath_combine(path, sizeof(path), assetDir, "large.zip"));
+	dsZipArchive* archive = dsZipArchive_openResource(allocator, dsFileResourceType_Embedded, path,
+		DS_MIN_ZIP_DECOMPRESS_BUFFER_SIZE);
+	ASSERT_TRUE(archive);
+
+	EXPECT_EQ(0U, dsZipArchive_getMaxCacheSize(archive));
+	EXPECT_EQ(0U, dsZipArchive_getCacheSize(archive));
+
+	size_t fileSize = 16901;
+	std::vector<char> expected(fileSize);
+	dsStream* stream = dsZipArchive_openFile(archive, "README.md");
+	ASSERT_TRUE(stream);
+	EXPECT_FALSE(dsStream_canGetBuffer(stream));
+	EXPECT_EQ(fileSize, dsStream_read(stream, expected.data(), fileSize));
+	EXPECT_TRUE(dsStream_close(stream));
+	EXPECT_EQ(0U, dsZipArchive_getCacheSize(archive));
+
+	EXPECT_TRUE(dsZipArchive_setMaxCacheSize(archive, 65536));
+	EXPECT_EQ(65536U, dsZipArchive_getMaxCacheSize(archive));
+
+	stream = dsZipArchive_openFile(archive, "README.md");
+	ASSERT_TRUE(stream);
+	EXPECT_EQ(fileSize, dsZipArchive_getCacheSize(archive));
+	EXPECT_EQ(fileSize, dsStream_remainingBytes(stream));
+	ASSERT_TRUE(dsStream_canGetBuffer(stream));
+
+	size_t bufferSize;
+	const void* buffer = dsStream_getBuffer(&bufferSize, stream);
+	ASSERT_TRUE(buffer);
+	EXPECT_EQ(fileSize, bufferSize);
+	EXPECT_EQ(0, std::memcmp(buffer, expected.data(), fileSize));
+
+	char readBuffer[100];
+	ASSERT_TRUE(dsStream_seek(stream, 1000, dsStreamSeekWay_Beginning));
+	EXPECT_EQ(sizeof(readBuffer), dsStream_read(stream, readBuffer, sizeof(readBuffer)));
+	EXPECT_EQ(0, std::memcmp(readBuffer, expected.data() + 1000, sizeof(readBuffer)));
+	EXPECT_EQ(1000U + sizeof(readBuffer), dsStream_tell(stream));
+
+	// Opening again should share the cached data.
+	dsStream* otherStream = dsZipArchive_openFile(archive, "README.md");
+	ASSERT_TRUE(otherStream);
+	EXPECT_EQ(fileSize, dsZipArchive_getCacheSize(archive));
+	EXPECT_EQ(buffer, dsStream_getBuffer(&bufferSize, otherStream));
+	EXPECT_TRUE(dsStream_close(otherStream));
+
+	// Open streams should stay valid after being evicted.
+	EXPECT_TRUE(dsZipArchive_setMaxCacheSize(archive, 1000));
+	EXPECT_EQ(0U, dsZipArchive_getCacheSize(archive));
+	EXPECT_TRUE(dsStream_restart(stream));
+	EXPECT_EQ(sizeof(readBuffer), dsStream_read(stream, readBuffer, sizeof(readBuffer)));
+	EXPECT_EQ(0, std::memcmp(readBuffer, expected.data(), sizeof(readBuffer)));
+	EXPECT_TRUE(dsStream_close(stream));
+
+	// Too large for the cache.
+	stream = dsZipArchive_openFile(archive, "README.md");
+	ASSERT_TRUE(stream);
+	EXPECT_FALSE(dsStream_canGetBuffer(stream));
+	EXPECT_EQ(0U, dsZipArchive_getCacheSize(archive));
+	EXPECT_TRUE(dsStream_close(stream));
+
+	dsZipArchive_close(archive);
+}
+
+TEST_F(ZipArchiveTest, Prefetch)
+{
+	char path[DS_PATH_MAX];
+	ASSERT_TRUE(dsPath_combine(path, sizeof(path), assetDir, "large.zip"));
+	dsZipArchive* archive = dsZipArchive_openResource(allocator, dsFileResourceType_Embedded, path,
+		DS_MIN_ZIP_DECOMPRESS_BUFFER_SIZE);
+	ASSERT_TRUE(archive);
+
+	const char* paths[] = {"README.md", "first", "second", "large"};
+	EXPECT_FALSE_ERRNO(EPERM, dsZipArchive_prefetch(archive, paths, DS_ARRAY_SIZE(paths), NULL));
+
+	EXPECT_TRUE(dsZipArchive_setMaxCacheSize(archive, 65536));
+	const char* missingPaths[] = {"README.md", "missing"};
+	EXPECT_FALSE_ERRNO(ENOENT, dsZipArchive_prefetch(archive, missingPaths,
+		DS_ARRAY_SIZE(missingPaths), NULL));
+	EXPECT_EQ(0U, dsZipArchive_getCacheSize(archive));
+
+	dsThreadPool* threadPool = dsThreadPool_create(allocator, 3, dsThreadPoolFlags_None, 0, NULL,
+		NULL, NULL);
+	ASSERT_TRUE(threadPool);
+
+	EXPECT_TRUE(dsZipArchive_prefetch(archive, paths, DS_ARRAY_SIZE(paths), threadPool));
+	size_t fileSize = 16901;
+	size_t cacheSize = dsZipArchive_getCacheSize(archive);
+	EXPECT_LE(fileSize, cacheSize);
+
+	// Already cached.
+	EXPECT_TRUE(dsZipArchive_prefetch(archive, paths, DS_ARRAY_SIZE(paths), threadPool));
+	EXPECT_EQ(cacheSize, dsZipArchive_getCacheSize(archive));
+
+	dsStream* stream = dsZipArchive_openFile(archive, "README.md");
+	ASSERT_TRUE(stream);
+	EXPECT_TRUE(dsStream_canGetBuffer(stream));
+	EXPECT_EQ(fileSize, dsStream_remainingBytes(stream));
+
+	const char* expected = "# Introduction";
+	char buffer[62];
+	EXPECT_EQ(sizeof(buffer), dsStream_read(stream, buffer, sizeof(buffer)));
+	EXPECT_EQ(0, std::strncmp(buffer, expected, std::strlen(expected)));
+	EXPECT_TRUE(dsStream_close(stream));
+
+	EXPECT_TRUE(dsThreadPool_destroy(threadPool));
+	dsZipArchive_close(archive);
+}
+
 TEST_F(ZipArchiveTest, FileArchiveFunctions)
 {
 	char buffer[32] = {};
@@ -40,6 +40,15 @@ extern "C"
  * lookup performance to degrade to O(n), in which case the extra time spent balancing may be
  * quickly made up with better lookup times.
  *
+ * dsBVH_buildSAH() may alternatively be used to build the BVH using the surface area heuristic
+ * (SAH), evaluated across a fixed number of bins along each axis. This typically gives the best
+ * lookup times, is cheaper to build than the balanced BVH, and can optionally use a thread pool to
+ * build independent subtrees in parallel.
+ *
+ * When SIMD is available, float BVHs will also flatten the tree into nodes with four children each
+ * after building or updating. Queries then test all four children at once. dsBVH_insert() and
+ * dsBVH_remove() will fall back to traversing the binary tree until the next update.
+ *
  * @see dsBVH
  */
 
@@ -115,14 +124,37 @@ DS_GEOMETRY_EXPORT bool dsBVH_setUserData(dsBVH* bvh, void* userData);
 DS_GEOMETRY_EXPORT bool dsBVH_build(dsBVH* bvh, const void* objects, uint32_t objectCount,
 	size_t objectSize, dsBVHObjectBoundsFunction objectBoundsFunc, bool balance);
 
+/**
+ * @brief Builds the hierarchy for a BVH using the surface area heuristic.
+ *
+ * This will replace the contents of the BVH. Objects are split by binning their centers along each
+ * axis and choosing the split that minimizes the surface area of the child bounds weighted by the
+ * number of objects within them. This generally provides better lookup times than dsBVH_build(),
+ * especially when objects are unevenly distributed or vary in size.
+ *
+ * @remark errno will be set on failure.
+ * @param bvh The BVH to build.
+ * @param objects An array of objects to build the BVH for. See dsBVH_build() for details.
+ * @param objectCount The number of objects in the array.
+ * @param objectSize The size of each object inside of the object array. See dsBVH_build() for
+ *     the special values that may be used.
+ * @param objectBoundsFunc The function to query the bounds from each object. This will only be
+ *     called on the current thread.
+ * @param threadPool The thread pool to build subtrees in parallel. This may be NULL to build the
+ *     BVH on the current thread. Smaller BVHs will always be built on the current thread.
+ * @return False if an error occurred. The current contents will be cleared on error.
+ */
+DS_GEOMETRY_EXPORT bool dsBVH_buildSAH(dsBVH* bvh, const void* objects, uint32_t objectCount,
+	size_t objectSize, dsBVHObjectBoundsFunction objectBoundsFunc, dsThreadPool* threadPool);
+
 /**
  * @brief Updates a BVH, querying updated bounds from the objects and updating the bounds
  * accordingly.
  *
  * This will keep the topology of the BVH the same while updating the internal bounds. If the
  * objects move around enough, the tree may become unbalanced, causing lookups to become unbalanced.
- * Consider re-building the BVH if the objects move significantly with respect to each-other if you
- * want to maintain a balanced tree.
+ * Consider using dsBVH_updateIncremental() or re-building the BVH if the objects move
+ * significantly with respect to each-other if you want to maintain a balanced tree.
  *
  * @remark errno will be set on failure.
  * @param bvh The BVH to balance.
@@ -130,6 +162,56 @@ DS_GEOMETRY_EXPORT bool dsBVH_build(dsBVH* bvh, const void* objects, uint32_t ob
  */
 DS_GEOMETRY_EXPORT bool dsBVH_update(dsBVH* bvh);
 
+/**
+ * @brief Updates a BVH, querying updated bounds from the objects and incrementally improving the
+ * tree.
+ *
+ * This updates the bounds similar to dsBVH_update(), but will also apply tree rotations to nodes
+ * where it reduces the surface area of the child nodes. This keeps the quality of the tree from
+ * degrading as objects move, avoiding the need to fully re-build the tree each frame.
+ *
+ * @remark errno will be set on failure.
+ * @param bvh The BVH to update.
+ * @param threadPool The thread pool to update independent subtrees in parallel. This may be NULL to
+ *     update on the current thread. When a thread pool is used the object bounds function must be
+ *     safe to call across multiple threads.
+ * @return False if an error occurred.
+ */
+DS_GEOMETRY_EXPORT bool dsBVH_updateIncremental(dsBVH* bvh, dsThreadPool* threadPool);
+
+/**
+ * @brief Inserts a single object into a BVH.
+ *
+ * This will descend the tree in O(log(n)) time for a balanced tree, choosing the child whose area
+ * would increase the least, without rebuilding the tree. Queries may be slower until the BVH is
+ * next updated.
+ *
+ * @remark errno will be set on failure.
+ * @param bvh The BVH to insert into.
+ * @param object The object to insert. This is the value that will be provided to the visitor
+ *     functions, so it should be the pointer to the object itself when building with
+ *     DS_GEOMETRY_OBJECT_POINTERS or cast from the index with DS_GEOMETRY_OBJECT_INDICES.
+ * @param objectBoundsFunc The function to query the bounds from each object. This must match the
+ *     function used to build the BVH if it isn't empty.
+ * @return False if an error occurred.
+ */
+DS_GEOMETRY_EXPORT bool dsBVH_insert(dsBVH* bvh, const void* object,
+	dsBVHObjectBoundsFunction objectBoundsFunc);
+
+/**
+ * @brief Removes a single object from a BVH.
+ *
+ * This will take O(log(n)) time for a balanced tree when the bounds of the object are the same as
+ * when the BVH was last built or updated. Otherwise, the full tree will be searched for the object.
+ *
+ * @remark errno will be set on failure.
+ * @param bvh The BVH to remove from.
+ * @param object The object to remove. This is the same value that's provided to the visitor
+ *     functions.
+ * @return False if the object couldn't be found.
+ */
+DS_GEOMETRY_EXPORT bool dsBVH_remove(dsBVH* bvh, const void* object);
+
 /**
  * @brief Returns whether or not the BVH is empty.
  * @return True if the BVH is empty.
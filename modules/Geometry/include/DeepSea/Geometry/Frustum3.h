@@ -279,6 +279,24 @@ DS_GEOMETRY_EXPORT dsIntersectResult dsFrustum3f_intersectSphere3x(
 DS_GEOMETRY_EXPORT dsIntersectResult dsFrustum3d_intersectSphere3x(
 	const dsFrustum3d* frustum, const dsVector3xd* center, double radius);
 
+/**
+ * @brief Intersects an array of aligned boxes with a frustum.
+ *
+ * This will use the fastest SIMD implementation available on the host CPU, testing multiple planes
+ * of the frustum at once. Each box is tested with the center and half extents against each plane,
+ * which can give slightly different results compared to dsFrustum3f_intersectAlignedBox() for
+ * boxes that are flat along a plane normal.
+ *
+ * @param[out] results The intersection result for each box. Inside and outside is with respect to
+ *     the frustum. If a box fully contains the frustum, dsIntersectResult_Intersects will be
+ *     returned.
+ * @param frustum The frustum to intersect.
+ * @param boxes The aligned boxes to intersect with.
+ * @param boxCount The number of boxes in results and boxes.
+ */
+DS_GEOMETRY_EXPORT void dsFrustum3f_intersectAlignedBoxesArray(dsIntersectResult* results,
+	const dsFrustum3f* frustum, const dsAlignedBox3f* boxes, uint32_t boxCount);
+
 #if DS_HAS_SIMD
 
 /**
@@ -327,6 +345,32 @@ DS_GEOMETRY_EXPORT dsIntersectResult dsFrustum3f_intersectBoxMatrixSIMD(
 DS_GEOMETRY_EXPORT dsIntersectResult dsFrustum3f_intersectSphereSIMD(
 	const dsFrustum3f* frustum, const dsVector3xf* center, float radius);
 
+/**
+ * @brief Intersects an array of aligned boxes with a frustum using SIMD operations.
+ * @remark This can be used when dsSIMDFeatures_Float4 is available.
+ * @param[out] results The intersection result for each box. Inside and outside is with respect to
+ *     the frustum. If a box fully contains the frustum, dsIntersectResult_Intersects will be
+ *     returned.
+ * @param frustum The frustum to intersect.
+ * @param boxes The aligned boxes to intersect with.
+ * @param boxCount The number of boxes in results and boxes.
+ */
+DS_GEOMETRY_EXPORT void dsFrustum3f_intersectAlignedBoxesArraySIMD(dsIntersectResult* results,
+	const dsFrustum3f* frustum, const dsAlignedBox3f* boxes, uint32_t boxCount);
+
+/**
+ * @brief Intersects an array of aligned boxes with a frustum using 8-wide SIMD operations.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param[out] results The intersection result for each box. Inside and outside is with respect to
+ *     the frustum. If a box fully contains the frustum, dsIntersectResult_Intersects will be
+ *     returned.
+ * @param frustum The frustum to intersect.
+ * @param boxes The aligned boxes to intersect with.
+ * @param boxCount The number of boxes in results and boxes.
+ */
+DS_GEOMETRY_EXPORT void dsFrustum3f_intersectAlignedBoxesArraySIMD8(dsIntersectResult* results,
+	const dsFrustum3f* frustum, const dsAlignedBox3f* boxes, uint32_t boxCount);
+
 #if !DS_DETERMINISTIC_MATH
 
 /**
@@ -375,6 +419,33 @@ DS_GEOMETRY_EXPORT dsIntersectResult dsFrustum3f_intersectBoxMatrixFMA(
 DS_GEOMETRY_EXPORT dsIntersectResult dsFrustum3f_intersectSphereFMA(
 	const dsFrustum3f* frustum, const dsVector3xf* center, float radius);
 
+/**
+ * @brief Intersects an array of aligned boxes with a frustum using fused multiply-add operations.
+ * @remark This can be used when dsSIMDFeatures_Float4 and dsSIMDFeatures_FMA are available.
+ * @param[out] results The intersection result for each box. Inside and outside is with respect to
+ *     the frustum. If a box fully contains the frustum, dsIntersectResult_Intersects will be
+ *     returned.
+ * @param frustum The frustum to intersect.
+ * @param boxes The aligned boxes to intersect with.
+ * @param boxCount The number of boxes in results and boxes.
+ */
+DS_GEOMETRY_EXPORT void dsFrustum3f_intersectAlignedBoxesArrayFMA(dsIntersectResult* results,
+	const dsFrustum3f* frustum, const dsAlignedBox3f* boxes, uint32_t boxCount);
+
+/**
+ * @brief Intersects an array of aligned boxes with a frustum using 8-wide fused multiply-add
+ *     operations.
+ * @remark This can be used when dsSIMDFeatures_Float8 and dsSIMDFeatures_FMA are available.
+ * @param[out] results The intersection result for each box. Inside and outside is with respect to
+ *     the frustum. If a box fully contains the frustum, dsIntersectResult_Intersects will be
+ *     returned.
+ * @param frustum The frustum to intersect.
+ * @param boxes The aligned boxes to intersect with.
+ * @param boxCount The number of boxes in results and boxes.
+ */
+DS_GEOMETRY_EXPORT void dsFrustum3f_intersectAlignedBoxesArrayFMA8(dsIntersectResult* results,
+	const dsFrustum3f* frustum, const dsAlignedBox3f* boxes, uint32_t boxCount);
+
 #endif // !DS_DETERMINISTIC_MATH
 
 /**
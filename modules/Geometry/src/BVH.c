@@ -24,15 +24,43 @@
 #include <DeepSea/Core/Error.h>
 #include <DeepSea/Core/Log.h>
 #include <DeepSea/Core/Sort.h>
+#include <DeepSea/Core/Thread/ThreadPool.h>
+#include <DeepSea/Core/Thread/ThreadTaskQueue.h>
 
 #include <DeepSea/Geometry/AlignedBox2.h>
+#include <DeepSea/Geometry/AlignedBox3.h>
 #include <DeepSea/Geometry/AlignedBox3x.h>
 #include <DeepSea/Geometry/Frustum3.h>
 
+#include <DeepSea/Math/SIMD/SIMD.h>
+
+#include <float.h>
+#include <math.h>
 #include <string.h>
 
 #define INVALID_NODE UINT32_MAX
 
+// Number of bins to evaluate the SAH cost along each axis.
+#define SAH_BIN_COUNT 16
+// Minimum number of objects to build or update in parallel. Subtrees smaller than this will be
+// processed on the current thread.
+#define MIN_TASK_OBJECTS 256
+#define SAH_MIN_DEFERRED_OBJECTS 32
+#define TASK_QUEUE_SIZE 64
+
+// Maximum depth to split the tree for updating in parallel.
+#define MAX_PARALLEL_UPDATE_DEPTH 16
+
+// Number of children for each wide node.
+#define WIDE_CHILD_COUNT 4
+// Size of the traversal stack for wide nodes. Deeper trees recurse once the stack is full.
+#define WIDE_STACK_SIZE 64
+// Flag set on traversal stack entries when the wide node is fully within the volume.
+#define WIDE_ENCLOSED_FLAG 0x80000000U
+// Relative tolerance when testing frustums against wide nodes. This keeps the test conservative
+// with respect to the exact test on the leaf nodes.
+#define WIDE_FRUSTUM_EPSILON 1e-5f
+
 typedef struct dsBVHNode
 {
 	uint32_t leftNode;
@@ -42,6 +70,64 @@ typedef struct dsBVHNode
 	DS_ALIGN(DS_ALLOC_ALIGNMENT) double bounds[];
 } dsBVHNode;
 
+// Flattened 4-wide node with child bounds stored as a structure of arrays to test all children at
+// once with SIMD. Only used for float BVHs, and is built from the binary nodes.
+typedef struct WideNode
+{
+	DS_ALIGN(16) float minBounds[3][WIDE_CHILD_COUNT];
+	DS_ALIGN(16) float maxBounds[3][WIDE_CHILD_COUNT];
+	// Index of the wide node for internal children or the binary node for leaf children.
+	uint32_t children[WIDE_CHILD_COUNT];
+	uint8_t childCount;
+	uint8_t leafMask;
+} WideNode;
+
+typedef struct WideBounds
+{
+	float minBounds[3];
+	float maxBounds[3];
+	uint32_t axisCount;
+} WideBounds;
+
+typedef struct WideFrustum
+{
+	// Normal, distance, and absolute value of the normal for each plane.
+	float planes[dsFrustumPlanes_Count][7];
+	uint32_t planeCount;
+} WideFrustum;
+
+typedef struct SAHPrimitive
+{
+	dsAlignedBox3d bounds;
+	dsVector3d center;
+	uint32_t tempNode;
+} SAHPrimitive;
+
+typedef struct SAHBin
+{
+	dsAlignedBox3d bounds;
+	uint32_t count;
+} SAHBin;
+
+typedef struct SAHContext SAHContext;
+
+typedef struct SAHTask
+{
+	SAHContext* context;
+	uint32_t start;
+	uint32_t count;
+	uint32_t node;
+} SAHTask;
+
+typedef struct UpdateContext UpdateContext;
+
+typedef struct UpdateTask
+{
+	const UpdateContext* context;
+	uint32_t node;
+	bool result;
+} UpdateTask;
+
 struct dsBVH
 {
 	dsAllocator* allocator;
@@ -58,9 +144,33 @@ struct dsBVH
 	dsBVHNode* nodes;
 	uint32_t nodeCount;
 	uint32_t maxNodes;
+	// Linked list of nodes freed when removing objects.
+	uint32_t freeNodes;
 
 	dsBVHNode* tempNodes;
 	size_t maxTempNodes;
+
+	SAHPrimitive* sahPrimitives;
+	size_t maxSAHPrimitives;
+
+	SAHTask* sahTasks;
+	uint32_t sahTaskCount;
+	uint32_t maxSAHTasks;
+
+	dsThreadTask* threadTasks;
+	uint32_t maxThreadTasks;
+
+	uint32_t* updateNodes;
+	uint32_t updateNodeCount;
+	uint32_t maxUpdateNodes;
+
+	UpdateTask* updateTasks;
+	uint32_t maxUpdateTasks;
+
+	// Wide nodes are only valid when wideNodeCount is non-zero.
+	WideNode* wideNodes;
+	uint32_t wideNodeCount;
+	uint32_t maxWideNodes;
 };
 
 typedef struct SortContext
@@ -72,6 +182,24 @@ typedef struct SortContext
 
 typedef void (*AddBoxFunction)(void* bounds, const void* otherBounds);
 typedef dsIntersectResult (*IntersectFunction)(const void* volume, const void* bounds);
+// Returns the mask of children that aren't outside the volume. outInsideMask is set to the mask of
+// children that are fully inside the volume.
+typedef uint32_t (*WideIntersectFunction)(const void* volume, const WideNode* node,
+	uint32_t* outInsideMask);
+
+struct SAHContext
+{
+	dsBVH* bvh;
+	AddBoxFunction addBoxFunc;
+	uint32_t taskThreshold;
+};
+
+struct UpdateContext
+{
+	dsBVH* bvh;
+	AddBoxFunction addBoxFunc;
+	uint32_t parallelDepth;
+};
 
 inline static dsBVHNode* getNode(dsBVHNode* nodes, uint8_t nodeSize, uint32_t index)
 {
@@ -252,63 +380,1106 @@ static uint32_t buildBVHRec(dsBVH* bvh, const void* objects, uint32_t start, uin
 	if (rightNode == INVALID_NODE)
 		return INVALID_NODE;
 
-	// Recursive operations shouldn't have invalidated the pointer.
-	DS_ASSERT(bvhNode == getNode(bvh->nodes, bvh->nodeSize, node));
-	bvhNode->leftNode = leftNode;
-	bvhNode->rightNode = rightNode;
-	bvhNode->object = NULL;
-	memcpy(bvhNode->bounds, getNode(bvh->nodes, bvh->nodeSize, leftNode)->bounds, bvh->boundsSize);
-	addBoxFunc(bvhNode->bounds, getNode(bvh->nodes, bvh->nodeSize, rightNode)->bounds);
-	return node;
+	// Recursive operations shouldn't have invalidated the pointer.
+	DS_ASSERT(bvhNode == getNode(bvh->nodes, bvh->nodeSize, node));
+	bvhNode->leftNode = leftNode;
+	bvhNode->rightNode = rightNode;
+	bvhNode->object = NULL;
+	memcpy(bvhNode->bounds, getNode(bvh->nodes, bvh->nodeSize, leftNode)->bounds, bvh->boundsSize);
+	addBoxFunc(bvhNode->bounds, getNode(bvh->nodes, bvh->nodeSize, rightNode)->bounds);
+	return node;
+}
+
+static AddBoxFunction getAddBoxFunction(const dsBVH* bvh)
+{
+	switch (bvh->element)
+	{
+		case dsGeometryElement_Float:
+			if (bvh->axisCount == 2)
+				return (AddBoxFunction)&dsAlignedBox2f_addBox;
+			else if (bvh->storedAxisCount == 4)
+			{
+				DS_ASSERT(bvh->axisCount == 3);
+				return (AddBoxFunction)&dsAlignedBox3xf_addBox;
+			}
+
+			DS_ASSERT(bvh->axisCount == 3);
+			return (AddBoxFunction)&dsAlignedBox3f_addBox;
+		case dsGeometryElement_Double:
+			if (bvh->axisCount == 2)
+				return (AddBoxFunction)&dsAlignedBox2d_addBox;
+			else if (bvh->storedAxisCount == 4)
+			{
+				DS_ASSERT(bvh->axisCount == 3);
+				return (AddBoxFunction)&dsAlignedBox3xd_addBox;
+			}
+
+			DS_ASSERT(bvh->axisCount == 3);
+			return (AddBoxFunction)&dsAlignedBox3d_addBox;
+		case dsGeometryElement_Int:
+			if (bvh->axisCount == 2)
+				return (AddBoxFunction)&dsAlignedBox2i_addBox;
+
+			DS_ASSERT(bvh->axisCount == 3);
+			return (AddBoxFunction)&dsAlignedBox3i_addBox;
+		default:
+			DS_ASSERT(false);
+			return NULL;
+	}
+}
+
+static bool setupTempNodes(
+	dsBVH* bvh, const void* objects, uint32_t objectCount, size_t objectSize)
+{
+	if (!bvh->tempNodes || objectCount > bvh->maxTempNodes)
+	{
+		dsAllocator_free(bvh->allocator, bvh->tempNodes);
+		bvh->tempNodes = (dsBVHNode*)dsAllocator_allocArray(
+			bvh->allocator, bvh->nodeSize, objectCount);
+		if (!bvh->tempNodes)
+		{
+			bvh->maxTempNodes = 0;
+			return false;
+		}
+		bvh->maxTempNodes = objectCount;
+	}
+
+	for (uint32_t i = 0; i < objectCount; ++i)
+	{
+		dsBVHNode* node = getNode(bvh->tempNodes, bvh->nodeSize, i);
+		node->object = dsSpatialStructure_getObject(objects, objectSize, i);
+		if (!bvh->objectBoundsFunc(node->bounds, bvh, node->object))
+			return false;
+
+		node->leftNode = node->rightNode = INVALID_NODE;
+	}
+
+	return true;
+}
+
+static void getDoubleBounds(dsAlignedBox3d* outBounds, const dsBVH* bvh, const void* bounds)
+{
+	// Bounds are stored as the min values followed by the max values, with storedAxisCount values
+	// each.
+	uint8_t stride = bvh->storedAxisCount;
+	outBounds->min.z = outBounds->max.z = 0.0;
+	switch (bvh->element)
+	{
+		case dsGeometryElement_Float:
+		{
+			const float* values = (const float*)bounds;
+			for (uint8_t i = 0; i < bvh->axisCount; ++i)
+			{
+				outBounds->min.values[i] = values[i];
+				outBounds->max.values[i] = values[stride + i];
+			}
+			break;
+		}
+		case dsGeometryElement_Double:
+		{
+			const double* values = (const double*)bounds;
+			for (uint8_t i = 0; i < bvh->axisCount; ++i)
+			{
+				outBounds->min.values[i] = values[i];
+				outBounds->max.values[i] = values[stride + i];
+			}
+			break;
+		}
+		case dsGeometryElement_Int:
+		{
+			const int* values = (const int*)bounds;
+			for (uint8_t i = 0; i < bvh->axisCount; ++i)
+			{
+				outBounds->min.values[i] = values[i];
+				outBounds->max.values[i] = values[stride + i];
+			}
+			break;
+		}
+		default:
+			DS_ASSERT(false);
+			break;
+	}
+}
+
+static double getBoundsArea(const dsAlignedBox3d* bounds, uint8_t axisCount)
+{
+	// Only the relative areas matter, so use half the surface area. 2D bounds use the perimeter
+	// instead.
+	dsVector3d extents;
+	dsAlignedBox3_extents(extents, *bounds);
+	if (extents.x < 0.0 || extents.y < 0.0 || extents.z < 0.0)
+		return 0.0;
+	if (axisCount == 2)
+		return extents.x + extents.y;
+	return extents.x*extents.y + extents.y*extents.z + extents.z*extents.x;
+}
+
+static inline uint32_t getSAHBin(double value, double minValue, double scale)
+{
+	uint32_t bin = (uint32_t)((value - minValue)*scale);
+	return dsMin(bin, SAH_BIN_COUNT - 1);
+}
+
+static uint32_t splitSAH(const SAHContext* context, dsBVHNode* node, uint32_t start,
+	uint32_t count)
+{
+	const dsBVH* bvh = context->bvh;
+	SAHPrimitive* primitives = bvh->sahPrimitives + start;
+
+	// Compute the bounds for the node itself along with the bounds of the centers to bin.
+	memcpy(node->bounds, getNode(bvh->tempNodes, bvh->nodeSize, primitives[0].tempNode)->bounds,
+		bvh->boundsSize);
+	dsAlignedBox3d centerBounds = {primitives[0].center, primitives[0].center};
+	for (uint32_t i = 1; i < count; ++i)
+	{
+		const SAHPrimitive* primitive = primitives + i;
+		context->addBoxFunc(node->bounds,
+			getNode(bvh->tempNodes, bvh->nodeSize, primitive->tempNode)->bounds);
+		dsAlignedBox3_addPoint(centerBounds, primitive->center);
+	}
+
+	if (count == 2)
+		return 1;
+
+	double bestCost = DBL_MAX;
+	uint8_t bestAxis = 0;
+	uint32_t bestBin = 0;
+	double bestMin = 0.0;
+	double bestScale = 0.0;
+	for (uint8_t axis = 0; axis < bvh->axisCount; ++axis)
+	{
+		double minValue = centerBounds.min.values[axis];
+		double extent = centerBounds.max.values[axis] - minValue;
+		if (extent <= 0.0)
+			continue;
+
+		double scale = SAH_BIN_COUNT/extent;
+		SAHBin bins[SAH_BIN_COUNT];
+		for (uint32_t i = 0; i < SAH_BIN_COUNT; ++i)
+		{
+			dsAlignedBox3d_makeInvalid(&bins[i].bounds);
+			bins[i].count = 0;
+		}
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const SAHPrimitive* primitive = primitives + i;
+			SAHBin* bin = bins + getSAHBin(primitive->center.values[axis], minValue, scale);
+			dsAlignedBox3_addBox(bin->bounds, primitive->bounds);
+			++bin->count;
+		}
+
+		// Sweep from the right to find the cost for the right side of each split, then from the
+		// left to find the total cost.
+		double rightCosts[SAH_BIN_COUNT - 1];
+		dsAlignedBox3d sweepBounds;
+		dsAlignedBox3d_makeInvalid(&sweepBounds);
+		uint32_t sweepCount = 0;
+		for (uint32_t i = SAH_BIN_COUNT - 1; i > 0; --i)
+		{
+			const SAHBin* bin = bins + i;
+			if (bin->count > 0)
+			{
+				dsAlignedBox3_addBox(sweepBounds, bin->bounds);
+				sweepCount += bin->count;
+			}
+			rightCosts[i - 1] =
+				sweepCount > 0 ? getBoundsArea(&sweepBounds, bvh->axisCount)*sweepCount : 0.0;
+		}
+
+		dsAlignedBox3d_makeInvalid(&sweepBounds);
+		sweepCount = 0;
+		for (uint32_t i = 0; i < SAH_BIN_COUNT - 1; ++i)
+		{
+			const SAHBin* bin = bins + i;
+			if (bin->count > 0)
+			{
+				dsAlignedBox3_addBox(sweepBounds, bin->bounds);
+				sweepCount += bin->count;
+			}
+
+			if (sweepCount == 0 || sweepCount == count)
+				continue;
+
+			double cost = getBoundsArea(&sweepBounds, bvh->axisCount)*sweepCount + rightCosts[i];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestBin = i;
+				bestMin = minValue;
+				bestScale = scale;
+			}
+		}
+	}
+
+	// All centers are the same, so any split is as good as any other.
+	if (bestCost == DBL_MAX)
+		return count/2;
+
+	uint32_t left = 0;
+	uint32_t right = count;
+	while (left < right)
+	{
+		if (getSAHBin(primitives[left].center.values[bestAxis], bestMin, bestScale) <= bestBin)
+			++left;
+		else
+		{
+			--right;
+			SAHPrimitive temp = primitives[left];
+			primitives[left] = primitives[right];
+			primitives[right] = temp;
+		}
+	}
+
+	DS_ASSERT(left > 0 && left < count);
+	return left;
+}
+
+static bool deferSAHSubtree(SAHContext* context, uint32_t start, uint32_t count, uint32_t node)
+{
+	dsBVH* bvh = context->bvh;
+	uint32_t index = bvh->sahTaskCount;
+	if (!DS_RESIZEABLE_ARRAY_ADD(bvh->allocator, bvh->sahTasks, bvh->sahTaskCount,
+			bvh->maxSAHTasks, 1))
+	{
+		return false;
+	}
+
+	SAHTask* task = bvh->sahTasks + index;
+	task->context = context;
+	task->start = start;
+	task->count = count;
+	task->node = node;
+	return true;
+}
+
+static void buildSAHRec(SAHContext* context, uint32_t start, uint32_t count, uint32_t nodeIndex,
+	bool canDefer)
+{
+	// Each subtree with n leaves takes 2*n - 1 nodes, allowing the node indices to be computed
+	// up-front. This avoids any shared state when building subtrees in parallel. The smaller
+	// subtree is built recursively to keep the stack depth bounded for unbalanced splits.
+	dsBVH* bvh = context->bvh;
+	while (true)
+	{
+		if (canDefer && count <= context->taskThreshold && count >= SAH_MIN_DEFERRED_OBJECTS &&
+			deferSAHSubtree(context, start, count, nodeIndex))
+		{
+			return;
+		}
+
+		dsBVHNode* node = getNode(bvh->nodes, bvh->nodeSize, nodeIndex);
+		if (count == 1)
+		{
+			memcpy(node, getNode(bvh->tempNodes, bvh->nodeSize,
+				bvh->sahPrimitives[start].tempNode), bvh->nodeSize);
+			return;
+		}
+
+		uint32_t leftCount = splitSAH(context, node, start, count);
+		uint32_t rightCount = count - leftCount;
+		node->leftNode = nodeIndex + 1;
+		node->rightNode = nodeIndex + 2*leftCount;
+		node->object = NULL;
+
+		if (leftCount <= rightCount)
+		{
+			buildSAHRec(context, start, leftCount, node->leftNode, canDefer);
+			start += leftCount;
+			count = rightCount;
+			nodeIndex = node->rightNode;
+		}
+		else
+		{
+			buildSAHRec(context, start + leftCount, rightCount, node->rightNode, canDefer);
+			count = leftCount;
+			nodeIndex = node->leftNode;
+		}
+	}
+}
+
+static void buildSAHTask(void* userData)
+{
+	const SAHTask* task = (const SAHTask*)userData;
+	buildSAHRec(task->context, task->start, task->count, task->node, false);
+}
+
+static void buildSAHParallel(SAHContext* context, uint32_t objectCount, dsThreadPool* threadPool)
+{
+	dsBVH* bvh = context->bvh;
+	dsThreadTaskQueue* taskQueue = dsThreadTaskQueue_create(bvh->allocator, threadPool,
+		TASK_QUEUE_SIZE, 0);
+	if (!taskQueue)
+	{
+		buildSAHRec(context, 0, objectCount, 0, false);
+		return;
+	}
+
+	// Split the top of the tree on the current thread until there are enough subtrees to keep all
+	// threads busy.
+	unsigned int threadCount = dsThreadPool_getThreadCount(threadPool);
+	context->taskThreshold = dsMax(objectCount/((threadCount + 1)*4), MIN_TASK_OBJECTS);
+	bvh->sahTaskCount = 0;
+	buildSAHRec(context, 0, objectCount, 0, true);
+
+	uint32_t taskCount = bvh->sahTaskCount;
+	if (taskCount > bvh->maxThreadTasks)
+	{
+		dsThreadTask* threadTasks = DS_ALLOCATE_OBJECT_ARRAY(bvh->allocator, dsThreadTask,
+			taskCount);
+		if (threadTasks)
+		{
+			DS_VERIFY(dsAllocator_free(bvh->allocator, bvh->threadTasks));
+			bvh->threadTasks = threadTasks;
+			bvh->maxThreadTasks = taskCount;
+		}
+	}
+
+	if (taskCount <= bvh->maxThreadTasks)
+	{
+		for (uint32_t i = 0; i < taskCount; ++i)
+		{
+			dsThreadTask* threadTask = bvh->threadTasks + i;
+			threadTask->taskFunc = &buildSAHTask;
+			threadTask->userData = bvh->sahTasks + i;
+		}
+		DS_VERIFY(dsThreadTaskQueue_addTasks(taskQueue, bvh->threadTasks, taskCount));
+		DS_VERIFY(dsThreadTaskQueue_waitForTasks(taskQueue));
+	}
+	else
+	{
+		for (uint32_t i = 0; i < taskCount; ++i)
+			buildSAHTask(bvh->sahTasks + i);
+	}
+
+	dsThreadTaskQueue_destroy(taskQueue);
+}
+
+static inline bool isLeaf(const dsBVHNode* node)
+{
+	DS_ASSERT((node->leftNode == INVALID_NODE) == (node->rightNode == INVALID_NODE));
+	return node->leftNode == INVALID_NODE;
+}
+
+static uint32_t allocateNode(dsBVH* bvh)
+{
+	if (bvh->freeNodes != INVALID_NODE)
+	{
+		uint32_t index = bvh->freeNodes;
+		bvh->freeNodes = getNode(bvh->nodes, bvh->nodeSize, index)->leftNode;
+		return index;
+	}
+
+	uint32_t index = bvh->nodeCount;
+	if (!dsResizeableArray_add(bvh->allocator, (void**)&bvh->nodes, &bvh->nodeCount,
+			&bvh->maxNodes, bvh->nodeSize, 1))
+	{
+		return INVALID_NODE;
+	}
+
+	return index;
+}
+
+static void freeNode(dsBVH* bvh, uint32_t index)
+{
+	dsBVHNode* node = getNode(bvh->nodes, bvh->nodeSize, index);
+	node->leftNode = bvh->freeNodes;
+	node->rightNode = INVALID_NODE;
+	node->object = NULL;
+	bvh->freeNodes = index;
+}
+
+static void setNodeBoundsFromChildren(
+	const dsBVH* bvh, dsBVHNode* node, AddBoxFunction addBoxFunc)
+{
+	memcpy(node->bounds, getNode(bvh->nodes, bvh->nodeSize, node->leftNode)->bounds,
+		bvh->boundsSize);
+	addBoxFunc(node->bounds, getNode(bvh->nodes, bvh->nodeSize, node->rightNode)->bounds);
+}
+
+static double getAreaIncrease(const dsBVH* bvh, const dsBVHNode* node,
+	const dsAlignedBox3d* bounds)
+{
+	dsAlignedBox3d nodeBounds;
+	getDoubleBounds(&nodeBounds, bvh, node->bounds);
+	double area = getBoundsArea(&nodeBounds, bvh->axisCount);
+	dsAlignedBox3_addBox(nodeBounds, *bounds);
+	return getBoundsArea(&nodeBounds, bvh->axisCount) - area;
+}
+
+static bool containsBounds(const dsBVH* bvh, const dsBVHNode* node, const dsAlignedBox3d* bounds)
+{
+	dsAlignedBox3d nodeBounds;
+	getDoubleBounds(&nodeBounds, bvh, node->bounds);
+	return dsAlignedBox3_containsBox(nodeBounds, *bounds);
+}
+
+static bool removeRec(dsBVH* bvh, uint32_t nodeIndex, const void* object,
+	const dsAlignedBox3d* bounds, AddBoxFunction addBoxFunc)
+{
+	// Only need to check leaf nodes that are direct children since the parent node is replaced by
+	// the sibling.
+	dsBVHNode* node = getNode(bvh->nodes, bvh->nodeSize, nodeIndex);
+	DS_ASSERT(!isLeaf(node));
+	if (bounds && !containsBounds(bvh, node, bounds))
+		return false;
+
+	uint32_t children[2] = {node->leftNode, node->rightNode};
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		const dsBVHNode* child = getNode(bvh->nodes, bvh->nodeSize, children[i]);
+		if (isLeaf(child))
+		{
+			if (child->object != object)
+				continue;
+
+			uint32_t sibling = children[1 - i];
+			memcpy(node, getNode(bvh->nodes, bvh->nodeSize, sibling), bvh->nodeSize);
+			freeNode(bvh, sibling);
+			freeNode(bvh, children[i]);
+			return true;
+		}
+		else if (removeRec(bvh, children[i], object, bounds, addBoxFunc))
+		{
+			setNodeBoundsFromChildren(bvh, node, addBoxFunc);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void rotateNode(const UpdateContext* context, dsBVHNode* node)
+{
+	typedef enum Rotation
+	{
+		Rotation_None,
+		Rotation_LeftRightLeft,
+		Rotation_LeftRightRight,
+		Rotation_RightLeftLeft,
+		Rotation_RightLeftRight
+	} Rotation;
+
+	// A rotation swaps a child with a grandchild on the opposite side. This only changes the bounds
+	// of the child that receives the other child, so choose the rotation that shrinks it the most.
+	const dsBVH* bvh = context->bvh;
+	dsBVHNode* left = getNode(bvh->nodes, bvh->nodeSize, node->leftNode);
+	dsBVHNode* right = getNode(bvh->nodes, bvh->nodeSize, node->rightNode);
+	if (isLeaf(left) && isLeaf(right))
+		return;
+
+	dsAlignedBox3d leftBounds, rightBounds;
+	getDoubleBounds(&leftBounds, bvh, left->bounds);
+	getDoubleBounds(&rightBounds, bvh, right->bounds);
+
+	Rotation rotation = Rotation_None;
+	double bestDiff = 0.0;
+	if (!isLeaf(right))
+	{
+		dsAlignedBox3d rightLeftBounds, rightRightBounds;
+		getDoubleBounds(&rightLeftBounds, bvh,
+			getNode(bvh->nodes, bvh->nodeSize, right->leftNode)->bounds);
+		getDoubleBounds(&rightRightBounds, bvh,
+			getNode(bvh->nodes, bvh->nodeSize, right->rightNode)->bounds);
+		double rightArea = getBoundsArea(&rightBounds, bvh->axisCount);
+
+		dsAlignedBox3d newBounds = leftBounds;
+		dsAlignedBox3_addBox(newBounds, rightRightBounds);
+		double diff = getBoundsArea(&newBounds, bvh->axisCount) - rightArea;
+		if (diff < bestDiff)
+		{
+			rotation = Rotation_LeftRightLeft;
+			bestDiff = diff;
+		}
+
+		newBounds = leftBounds;
+		dsAlignedBox3_addBox(newBounds, rightLeftBounds);
+		diff = getBoundsArea(&newBounds, bvh->axisCount) - rightArea;
+		if (diff < bestDiff)
+		{
+			rotation = Rotation_LeftRightRight;
+			bestDiff = diff;
+		}
+	}
+
+	if (!isLeaf(left))
+	{
+		dsAlignedBox3d leftLeftBounds, leftRightBounds;
+		getDoubleBounds(&leftLeftBounds, bvh,
+			getNode(bvh->nodes, bvh->nodeSize, left->leftNode)->bounds);
+		getDoubleBounds(&leftRightBounds, bvh,
+			getNode(bvh->nodes, bvh->nodeSize, left->rightNode)->bounds);
+		double leftArea = getBoundsArea(&leftBounds, bvh->axisCount);
+
+		dsAlignedBox3d newBounds = rightBounds;
+		dsAlignedBox3_addBox(newBounds, leftRightBounds);
+		double diff = getBoundsArea(&newBounds, bvh->axisCount) - leftArea;
+		if (diff < bestDiff)
+		{
+			rotation = Rotation_RightLeftLeft;
+			bestDiff = diff;
+		}
+
+		newBounds = rightBounds;
+		dsAlignedBox3_addBox(newBounds, leftLeftBounds);
+		diff = getBoundsArea(&newBounds, bvh->axisCount) - leftArea;
+		if (diff < bestDiff)
+			rotation = Rotation_RightLeftRight;
+	}
+
+	uint32_t temp;
+	switch (rotation)
+	{
+		case Rotation_None:
+			return;
+		case Rotation_LeftRightLeft:
+			temp = node->leftNode;
+			node->leftNode = right->leftNode;
+			right->leftNode = temp;
+			setNodeBoundsFromChildren(bvh, right, context->addBoxFunc);
+			break;
+		case Rotation_LeftRightRight:
+			temp = node->leftNode;
+			node->leftNode = right->rightNode;
+			right->rightNode = temp;
+			setNodeBoundsFromChildren(bvh, right, context->addBoxFunc);
+			break;
+		case Rotation_RightLeftLeft:
+			temp = node->rightNode;
+			node->rightNode = left->leftNode;
+			left->leftNode = temp;
+			setNodeBoundsFromChildren(bvh, left, context->addBoxFunc);
+			break;
+		case Rotation_RightLeftRight:
+			temp = node->rightNode;
+			node->rightNode = left->rightNode;
+			left->rightNode = temp;
+			setNodeBoundsFromChildren(bvh, left, context->addBoxFunc);
+			break;
+	}
+}
+
+static bool updateIncrementalRec(const UpdateContext* context, uint32_t nodeIndex, uint32_t depth)
+{
+	// Nodes at the parallel depth are updated by tasks. Tasks start one past the parallel depth so
+	// they never reach it.
+	if (depth == context->parallelDepth)
+		return true;
+
+	const dsBVH* bvh = context->bvh;
+	dsBVHNode* node = getNode(bvh->nodes, bvh->nodeSize, nodeIndex);
+	if (isLeaf(node))
+		return bvh->objectBoundsFunc(node->bounds, bvh, node->object);
+
+	DS_ASSERT(!node->object);
+	if (!updateIncrementalRec(context, node->leftNode, depth + 1) ||
+		!updateIncrementalRec(context, node->rightNode, depth + 1))
+	{
+		return false;
+	}
+
+	rotateNode(context, node);
+	setNodeBoundsFromChildren(bvh, node, context->addBoxFunc);
+	return true;
+}
+
+static void updateIncrementalTask(void* userData)
+{
+	UpdateTask* task = (UpdateTask*)userData;
+	task->result = updateIncrementalRec(task->context, task->node,
+		task->context->parallelDepth + 1);
+}
+
+static bool gatherUpdateNodes(dsBVH* bvh, uint32_t targetCount, uint32_t* outLevelStart,
+	uint32_t* outDepth)
+{
+	// Breadth-first traversal until a level has enough nodes to update in parallel. Leaves above
+	// the final level are updated on the current thread.
+	bvh->updateNodeCount = 0;
+	if (!DS_RESIZEABLE_ARRAY_ADD(bvh->allocator, bvh->updateNodes, bvh->updateNodeCount,
+			bvh->maxUpdateNodes, 1))
+	{
+		return false;
+	}
+	bvh->updateNodes[0] = 0;
+
+	uint32_t levelStart = 0;
+	uint32_t depth = 0;
+	while (bvh->updateNodeCount - levelStart < targetCount && depth < MAX_PARALLEL_UPDATE_DEPTH)
+	{
+		uint32_t levelEnd = bvh->updateNodeCount;
+		for (uint32_t i = levelStart; i < levelEnd; ++i)
+		{
+			const dsBVHNode* node = getNode(bvh->nodes, bvh->nodeSize, bvh->updateNodes[i]);
+			if (isLeaf(node))
+				continue;
+
+			uint32_t index = bvh->updateNodeCount;
+			if (!DS_RESIZEABLE_ARRAY_ADD(bvh->allocator, bvh->updateNodes, bvh->updateNodeCount,
+					bvh->maxUpdateNodes, 2))
+			{
+				return false;
+			}
+
+			bvh->updateNodes[index] = node->leftNode;
+			bvh->updateNodes[index + 1] = node->rightNode;
+		}
+
+		levelStart = levelEnd;
+		++depth;
+		if (levelStart == bvh->updateNodeCount)
+			break;
+	}
+
+	*outLevelStart = levelStart;
+	*outDepth = depth;
+	return true;
+}
+
+static bool updateIncrementalParallel(UpdateContext* context, dsThreadPool* threadPool)
+{
+	dsBVH* bvh = context->bvh;
+	unsigned int threadCount = dsThreadPool_getThreadCount(threadPool);
+	uint32_t levelStart, depth;
+	if (!gatherUpdateNodes(bvh, (threadCount + 1)*4, &levelStart, &depth))
+		return updateIncrementalRec(context, 0, 0);
+
+	uint32_t taskCount = bvh->updateNodeCount - levelStart;
+	if (taskCount > bvh->maxUpdateTasks)
+	{
+		UpdateTask* updateTasks = DS_ALLOCATE_OBJECT_ARRAY(bvh->allocator, UpdateTask, taskCount);
+		if (!updateTasks)
+			return updateIncrementalRec(context, 0, 0);
+
+		DS_VERIFY(dsAllocator_free(bvh->allocator, bvh->updateTasks));
+		bvh->updateTasks = updateTasks;
+		bvh->maxUpdateTasks = taskCount;
+	}
+
+	if (taskCount > bvh->maxThreadTasks)
+	{
+		dsThreadTask* threadTasks = DS_ALLOCATE_OBJECT_ARRAY(bvh->allocator, dsThreadTask,
+			taskCount);
+		if (!threadTasks)
+			return updateIncrementalRec(context, 0, 0);
+
+		DS_VERIFY(dsAllocator_free(bvh->allocator, bvh->threadTasks));
+		bvh->threadTasks = threadTasks;
+		bvh->maxThreadTasks = taskCount;
+	}
+
+	dsThreadTaskQueue* taskQueue = dsThreadTaskQueue_create(bvh->allocator, threadPool,
+		TASK_QUEUE_SIZE, 0);
+	if (!taskQueue)
+		return updateIncrementalRec(context, 0, 0);
+
+	context->parallelDepth = depth;
+	for (uint32_t i = 0; i < taskCount; ++i)
+	{
+		UpdateTask* updateTask = bvh->updateTasks + i;
+		updateTask->context = context;
+		updateTask->node = bvh->updateNodes[levelStart + i];
+		updateTask->result = false;
+
+		dsThreadTask* threadTask = bvh->threadTasks + i;
+		threadTask->taskFunc = &updateIncrementalTask;
+		threadTask->userData = updateTask;
+	}
+	DS_VERIFY(dsThreadTaskQueue_addTasks(taskQueue, bvh->threadTasks, taskCount));
+	DS_VERIFY(dsThreadTaskQueue_waitForTasks(taskQueue));
+	dsThreadTaskQueue_destroy(taskQueue);
+
+	for (uint32_t i = 0; i < taskCount; ++i)
+	{
+		if (!bvh->updateTasks[i].result)
+			return false;
+	}
+
+	// Finish the top of the tree on the current thread.
+	return updateIncrementalRec(context, 0, 0);
+}
+
+static bool updateBVHRec(dsBVH* bvh, dsBVHNode* node, AddBoxFunction addBoxFunc)
+{
+	if (node->leftNode == INVALID_NODE && node->rightNode == INVALID_NODE)
+	{
+		DS_ASSERT(node->leftNode == INVALID_NODE && node->rightNode == INVALID_NODE);
+		return bvh->objectBoundsFunc(node->bounds, bvh, node->object);
+	}
+
+	DS_ASSERT(!node->object);
+	dsBVHNode* left = getNode(bvh->nodes, bvh->nodeSize, node->leftNode);
+	dsBVHNode* right = getNode(bvh->nodes, bvh->nodeSize, node->rightNode);
+	if (!updateBVHRec(bvh, left, addBoxFunc) || !updateBVHRec(bvh, right, addBoxFunc))
+		return false;
+
+	memcpy(node->bounds, left->bounds, bvh->boundsSize);
+	addBoxFunc(node->bounds, right->bounds);
+	return true;
+}
+
+// NOTE: bool return value is whether or not to continue traversing
+static bool intersectBVHRec(const dsBVH* bvh, uint32_t* count, const dsBVHNode* node,
+	const void* volume, dsBVHVisitFunction visitor, void* userData, IntersectFunction intersectFunc,
+	bool enclosing)
+{
+	if (!enclosing)
+	{
+		dsIntersectResult result = intersectFunc(volume, node->bounds);
+		if (result == dsIntersectResult_Outside)
+			return true;
+		enclosing = result == dsIntersectResult_Inside;
+	}
+
+	if (node->leftNode == INVALID_NODE && node->rightNode == INVALID_NODE)
+	{
+		DS_ASSERT(node->leftNode == INVALID_NODE && node->rightNode == INVALID_NODE);
+		++*count;
+		if (visitor)
+			return visitor(userData, bvh, node->object, volume);
+		return true;
+	}
+
+	DS_ASSERT(!node->object);
+	dsBVHNode* left = getNode(bvh->nodes, bvh->nodeSize, node->leftNode);
+	dsBVHNode* right = getNode(bvh->nodes, bvh->nodeSize, node->rightNode);
+	if (!intersectBVHRec(bvh, count, left, volume, visitor, userData, intersectFunc, enclosing))
+		return false;
+	return intersectBVHRec(bvh, count, right, volume, visitor, userData, intersectFunc, enclosing);
+}
+
+static bool canUseWideNodes(const dsBVH* bvh)
+{
+#if DS_HAS_SIMD
+	return bvh->element == dsGeometryElement_Float &&
+		(DS_SIMD_ALWAYS_FLOAT4 || (dsHostSIMDFeatures & dsSIMDFeatures_Float4));
+#else
+	DS_UNUSED(bvh);
+	return false;
+#endif
+}
+
+static uint32_t buildWideNodesRec(dsBVH* bvh, uint32_t nodeIndex)
+{
+	DS_ASSERT(bvh->wideNodeCount < bvh->maxWideNodes);
+	uint32_t wideIndex = bvh->wideNodeCount++;
+
+	// Collapse the binary tree by expanding the internal child with the largest area until all
+	// children are filled or only leaves remain.
+	const dsBVHNode* node = getNode(bvh->nodes, bvh->nodeSize, nodeIndex);
+	DS_ASSERT(!isLeaf(node));
+	uint32_t children[WIDE_CHILD_COUNT] = {node->leftNode, node->rightNode};
+	uint32_t childCount = 2;
+	while (childCount < WIDE_CHILD_COUNT)
+	{
+		uint32_t expandChild = INVALID_NODE;
+		double maxArea = -1.0;
+		for (uint32_t i = 0; i < childCount; ++i)
+		{
+			const dsBVHNode* child = getNode(bvh->nodes, bvh->nodeSize, children[i]);
+			if (isLeaf(child))
+				continue;
+
+			dsAlignedBox3d childBounds;
+			getDoubleBounds(&childBounds, bvh, child->bounds);
+			double area = getBoundsArea(&childBounds, bvh->axisCount);
+			if (area > maxArea)
+			{
+				expandChild = i;
+				maxArea = area;
+			}
+		}
+
+		if (expandChild == INVALID_NODE)
+			break;
+
+		const dsBVHNode* child = getNode(bvh->nodes, bvh->nodeSize, children[expandChild]);
+		children[expandChild] = child->leftNode;
+		children[childCount++] = child->rightNode;
+	}
+
+	// Wide nodes are reserved ahead of time, so the pointer stays valid when recursing.
+	WideNode* wideNode = bvh->wideNodes + wideIndex;
+	memset(wideNode, 0, sizeof(WideNode));
+	wideNode->childCount = (uint8_t)childCount;
+	for (uint32_t i = 0; i < childCount; ++i)
+	{
+		const dsBVHNode* child = getNode(bvh->nodes, bvh->nodeSize, children[i]);
+		const float* childBounds = (const float*)child->bounds;
+		for (uint8_t j = 0; j < bvh->axisCount; ++j)
+		{
+			wideNode->minBounds[j][i] = childBounds[j];
+			wideNode->maxBounds[j][i] = childBounds[bvh->storedAxisCount + j];
+		}
+
+		if (isLeaf(child))
+		{
+			wideNode->children[i] = children[i];
+			wideNode->leafMask = (uint8_t)(wideNode->leafMask | (1 << i));
+		}
+		else
+		{
+			uint32_t childWideIndex = buildWideNodesRec(bvh, children[i]);
+			wideNode->children[i] = childWideIndex;
+		}
+	}
+
+	return wideIndex;
+}
+
+static void buildWideNodes(dsBVH* bvh)
+{
+	bvh->wideNodeCount = 0;
+	if (bvh->nodeCount <= 1 || !canUseWideNodes(bvh))
+		return;
+
+	// Each wide node has at least two children, so can't exceed the number of internal nodes.
+	uint32_t maxWideNodes = bvh->nodeCount/2 + 1;
+	if (!bvh->wideNodes || maxWideNodes > bvh->maxWideNodes)
+	{
+		// The wide nodes are only an optimization, so fall back to the binary nodes on failure.
+		int prevErrno = errno;
+		DS_VERIFY(dsAllocator_free(bvh->allocator, bvh->wideNodes));
+		bvh->wideNodes = DS_ALLOCATE_OBJECT_ARRAY(bvh->allocator, WideNode, maxWideNodes);
+		if (!bvh->wideNodes)
+		{
+			bvh->maxWideNodes = 0;
+			errno = prevErrno;
+			return;
+		}
+		bvh->maxWideNodes = maxWideNodes;
+	}
+
+	buildWideNodesRec(bvh, 0);
+}
+
+static void getWideBounds(WideBounds* outBounds, const dsBVH* bvh, const float* bounds)
+{
+	outBounds->axisCount = bvh->axisCount;
+	for (uint8_t i = 0; i < bvh->axisCount; ++i)
+	{
+		outBounds->minBounds[i] = bounds[i];
+		outBounds->maxBounds[i] = bounds[bvh->storedAxisCount + i];
+	}
+}
+
+static void getWideFrustum(WideFrustum* outFrustum, const dsFrustum3f* frustum)
+{
+	outFrustum->planeCount = dsFrustum3f_isInfinite(frustum) ? dsFrustumPlanes_Far :
+		dsFrustumPlanes_Count;
+	for (uint32_t i = 0; i < outFrustum->planeCount; ++i)
+	{
+		const dsPlane3f* plane = frustum->planes + i;
+		float* widePlane = outFrustum->planes[i];
+		widePlane[0] = plane->n.x;
+		widePlane[1] = plane->n.y;
+		widePlane[2] = plane->n.z;
+		widePlane[3] = plane->d;
+		widePlane[4] = fabsf(plane->n.x);
+		widePlane[5] = fabsf(plane->n.y);
+		widePlane[6] = fabsf(plane->n.z);
+	}
+}
+
+#if DS_HAS_SIMD
+DS_SIMD_START(DS_SIMD_FLOAT4)
+
+static inline uint32_t getWideMask(dsSIMD4fb result)
+{
+	DS_ALIGN(16) uint32_t values[WIDE_CHILD_COUNT];
+	dsSIMD4fb_store(values, result);
+	return (values[0] & 0x1) | (values[1] & 0x2) | (values[2] & 0x4) | (values[3] & 0x8);
+}
+
+static uint32_t intersectWideBoundsSIMD(const void* volume, const WideNode* node,
+	uint32_t* outInsideMask)
+{
+	// Comparisons are exact, so the result for leaves doesn't need to be re-checked.
+	const WideBounds* bounds = (const WideBounds*)volume;
+	dsSIMD4fb result = dsSIMD4fb_true();
+	for (uint32_t i = 0; i < bounds->axisCount; ++i)
+	{
+		result = dsSIMD4fb_and(result, dsSIMD4fb_and(
+			dsSIMD4f_cmple(dsSIMD4f_load(node->minBounds[i]),
+				dsSIMD4f_set1(bounds->maxBounds[i])),
+			dsSIMD4f_cmpge(dsSIMD4f_load(node->maxBounds[i]),
+				dsSIMD4f_set1(bounds->minBounds[i]))));
+	}
+
+	*outInsideMask = 0;
+	return getWideMask(result);
 }
 
-static bool updateBVHRec(dsBVH* bvh, dsBVHNode* node, AddBoxFunction addBoxFunc)
+static uint32_t intersectWideFrustumSIMD(const void* volume, const WideNode* node,
+	uint32_t* outInsideMask)
 {
-	if (node->leftNode == INVALID_NODE && node->rightNode == INVALID_NODE)
+	const WideFrustum* frustum = (const WideFrustum*)volume;
+	dsSIMD4f half = dsSIMD4f_set1(0.5f);
+	dsSIMD4f epsilon = dsSIMD4f_set1(WIDE_FRUSTUM_EPSILON);
+	dsSIMD4f center[3], absCenter[3], halfExtents[3];
+	for (unsigned int i = 0; i < 3; ++i)
 	{
-		DS_ASSERT(node->leftNode == INVALID_NODE && node->rightNode == INVALID_NODE);
-		return bvh->objectBoundsFunc(node->bounds, bvh, node->object);
+		dsSIMD4f minBounds = dsSIMD4f_load(node->minBounds[i]);
+		dsSIMD4f maxBounds = dsSIMD4f_load(node->maxBounds[i]);
+		center[i] = dsSIMD4f_mul(dsSIMD4f_add(minBounds, maxBounds), half);
+		absCenter[i] = dsSIMD4f_abs(center[i]);
+		halfExtents[i] = dsSIMD4f_mul(dsSIMD4f_sub(maxBounds, minBounds), half);
 	}
 
-	DS_ASSERT(!node->object);
-	dsBVHNode* left = getNode(bvh->nodes, bvh->nodeSize, node->leftNode);
-	dsBVHNode* right = getNode(bvh->nodes, bvh->nodeSize, node->rightNode);
-	if (!updateBVHRec(bvh, left, addBoxFunc) || !updateBVHRec(bvh, right, addBoxFunc))
-		return false;
+	dsSIMD4fb notOutside = dsSIMD4fb_true();
+	dsSIMD4fb inside = dsSIMD4fb_true();
+	for (uint32_t i = 0; i < frustum->planeCount; ++i)
+	{
+		const float* plane = frustum->planes[i];
+		dsSIMD4f normalX = dsSIMD4f_set1(plane[0]);
+		dsSIMD4f normalY = dsSIMD4f_set1(plane[1]);
+		dsSIMD4f normalZ = dsSIMD4f_set1(plane[2]);
+		dsSIMD4f absNormalX = dsSIMD4f_set1(plane[4]);
+		dsSIMD4f absNormalY = dsSIMD4f_set1(plane[5]);
+		dsSIMD4f absNormalZ = dsSIMD4f_set1(plane[6]);
+
+		dsSIMD4f centerDist = dsSIMD4f_add(dsSIMD4f_add(dsSIMD4f_add(
+			dsSIMD4f_mul(normalX, center[0]), dsSIMD4f_mul(normalY, center[1])),
+			dsSIMD4f_mul(normalZ, center[2])), dsSIMD4f_set1(plane[3]));
+		dsSIMD4f radius = dsSIMD4f_add(dsSIMD4f_add(dsSIMD4f_mul(absNormalX, halfExtents[0]),
+			dsSIMD4f_mul(absNormalY, halfExtents[1])), dsSIMD4f_mul(absNormalZ, halfExtents[2]));
+
+		// Expand the radius based on the magnitude of the terms to account for rounding errors.
+		dsSIMD4f magnitude = dsSIMD4f_add(dsSIMD4f_add(dsSIMD4f_add(dsSIMD4f_add(
+			dsSIMD4f_mul(absNormalX, absCenter[0]), dsSIMD4f_mul(absNormalY, absCenter[1])),
+			dsSIMD4f_mul(absNormalZ, absCenter[2])), dsSIMD4f_set1(fabsf(plane[3]))), radius);
+		radius = dsSIMD4f_add(radius, dsSIMD4f_mul(magnitude, epsilon));
+
+		notOutside = dsSIMD4fb_and(notOutside,
+			dsSIMD4f_cmpge(centerDist, dsSIMD4f_neg(radius)));
+		inside = dsSIMD4fb_and(inside, dsSIMD4f_cmpgt(centerDist, radius));
+	}
 
-	memcpy(node->bounds, left->bounds, bvh->boundsSize);
-	addBoxFunc(node->bounds, right->bounds);
-	return true;
+	*outInsideMask = getWideMask(inside);
+	return getWideMask(notOutside);
 }
 
-// NOTE: bool return value is whether or not to continue traversing
-static bool intersectBVHRec(const dsBVH* bvh, uint32_t* count, const dsBVHNode* node,
-	const void* volume, dsBVHVisitFunction visitor, void* userData, IntersectFunction intersectFunc,
-	bool enclosing)
+DS_SIMD_END()
+
+#if !DS_DETERMINISTIC_MATH
+DS_SIMD_START(DS_SIMD_FLOAT4,DS_SIMD_FMA)
+
+static uint32_t intersectWideFrustumFMA(const void* volume, const WideNode* node,
+	uint32_t* outInsideMask)
 {
-	if (!enclosing)
+	const WideFrustum* frustum = (const WideFrustum*)volume;
+	dsSIMD4f half = dsSIMD4f_set1(0.5f);
+	dsSIMD4f epsilon = dsSIMD4f_set1(WIDE_FRUSTUM_EPSILON);
+	dsSIMD4f center[3], absCenter[3], halfExtents[3];
+	for (unsigned int i = 0; i < 3; ++i)
 	{
-		dsIntersectResult result = intersectFunc(volume, node->bounds);
-		if (result == dsIntersectResult_Outside)
-			return true;
-		enclosing = result == dsIntersectResult_Inside;
+		dsSIMD4f minBounds = dsSIMD4f_load(node->minBounds[i]);
+		dsSIMD4f maxBounds = dsSIMD4f_load(node->maxBounds[i]);
+		center[i] = dsSIMD4f_mul(dsSIMD4f_add(minBounds, maxBounds), half);
+		absCenter[i] = dsSIMD4f_abs(center[i]);
+		halfExtents[i] = dsSIMD4f_mul(dsSIMD4f_sub(maxBounds, minBounds), half);
 	}
 
-	if (node->leftNode == INVALID_NODE && node->rightNode == INVALID_NODE)
+	dsSIMD4fb notOutside = dsSIMD4fb_true();
+	dsSIMD4fb inside = dsSIMD4fb_true();
+	for (uint32_t i = 0; i < frustum->planeCount; ++i)
 	{
-		DS_ASSERT(node->leftNode == INVALID_NODE && node->rightNode == INVALID_NODE);
-		++*count;
-		if (visitor)
-			return visitor(userData, bvh, node->object, volume);
-		return true;
+		const float* plane = frustum->planes[i];
+		dsSIMD4f absNormalX = dsSIMD4f_set1(plane[4]);
+		dsSIMD4f absNormalY = dsSIMD4f_set1(plane[5]);
+		dsSIMD4f absNormalZ = dsSIMD4f_set1(plane[6]);
+
+		dsSIMD4f centerDist = dsSIMD4f_fmadd(dsSIMD4f_set1(plane[0]), center[0],
+			dsSIMD4f_fmadd(dsSIMD4f_set1(plane[1]), center[1],
+				dsSIMD4f_fmadd(dsSIMD4f_set1(plane[2]), center[2], dsSIMD4f_set1(plane[3]))));
+		dsSIMD4f radius = dsSIMD4f_fmadd(absNormalX, halfExtents[0],
+			dsSIMD4f_fmadd(absNormalY, halfExtents[1], dsSIMD4f_mul(absNormalZ, halfExtents[2])));
+
+		// Expand the radius based on the magnitude of the terms to account for rounding errors.
+		dsSIMD4f magnitude = dsSIMD4f_fmadd(absNormalX, absCenter[0],
+			dsSIMD4f_fmadd(absNormalY, absCenter[1], dsSIMD4f_fmadd(absNormalZ, absCenter[2],
+				dsSIMD4f_add(dsSIMD4f_set1(fabsf(plane[3])), radius))));
+		radius = dsSIMD4f_fmadd(magnitude, epsilon, radius);
+
+		notOutside = dsSIMD4fb_and(notOutside,
+			dsSIMD4f_cmpge(centerDist, dsSIMD4f_neg(radius)));
+		inside = dsSIMD4fb_and(inside, dsSIMD4f_cmpgt(centerDist, radius));
 	}
 
-	DS_ASSERT(!node->object);
-	dsBVHNode* left = getNode(bvh->nodes, bvh->nodeSize, node->leftNode);
-	dsBVHNode* right = getNode(bvh->nodes, bvh->nodeSize, node->rightNode);
-	if (!intersectBVHRec(bvh, count, left, volume, visitor, userData, intersectFunc, enclosing))
-		return false;
-	return intersectBVHRec(bvh, count, right, volume, visitor, userData, intersectFunc, enclosing);
+	*outInsideMask = getWideMask(inside);
+	return getWideMask(notOutside);
+}
+
+DS_SIMD_END()
+#endif // !DS_DETERMINISTIC_MATH
+#endif // DS_HAS_SIMD
+
+// NOTE: bool return value is whether or not to continue traversing
+static bool intersectWideNodes(const dsBVH* bvh, uint32_t* count, uint32_t stackEntry,
+	const void* volume, const void* wideVolume, dsBVHVisitFunction visitor, void* userData,
+	IntersectFunction leafIntersectFunc, WideIntersectFunction wideIntersectFunc)
+{
+	uint32_t stack[WIDE_STACK_SIZE];
+	uint32_t stackCount = 0;
+	stack[stackCount++] = stackEntry;
+	while (stackCount > 0)
+	{
+		stackEntry = stack[--stackCount];
+		const WideNode* node = bvh->wideNodes + (stackEntry & ~WIDE_ENCLOSED_FLAG);
+		uint32_t childMask = (1U << node->childCount) - 1;
+		uint32_t hitMask, insideMask;
+		if (stackEntry & WIDE_ENCLOSED_FLAG)
+			hitMask = insideMask = childMask;
+		else
+		{
+			hitMask = wideIntersectFunc(wideVolume, node, &insideMask) & childMask;
+			insideMask &= hitMask;
+		}
+
+		// Visit leaves first, then push the internal children in reverse order so they are
+		// traversed from first to last.
+		uint32_t leafMask = hitMask & node->leafMask;
+		for (uint32_t i = 0; leafMask; ++i, leafMask >>= 1)
+		{
+			if (!(leafMask & 0x1))
+				continue;
+
+			// The leaf test must match the binary nodes exactly unless the wide test is exact.
+			const dsBVHNode* leaf = getNode(bvh->nodes, bvh->nodeSize, node->children[i]);
+			if (leafIntersectFunc && !(insideMask & (1 << i)) &&
+				leafIntersectFunc(volume, leaf->bounds) == dsIntersectResult_Outside)
+			{
+				continue;
+			}
+
+			++*count;
+			if (visitor && !visitor(userData, bvh, leaf->object, volume))
+				return false;
+		}
+
+		uint32_t internalMask = hitMask & ~(uint32_t)node->leafMask;
+		for (uint32_t i = node->childCount; i-- > 0;)
+		{
+			uint32_t childBit = 1U << i;
+			if (!(internalMask & childBit))
+				continue;
+
+			uint32_t childEntry = node->children[i];
+			if (insideMask & childBit)
+				childEntry |= WIDE_ENCLOSED_FLAG;
+
+			if (stackCount < WIDE_STACK_SIZE)
+				stack[stackCount++] = childEntry;
+			else if (!intersectWideNodes(bvh, count, childEntry, volume, wideVolume, visitor,
+					userData, leafIntersectFunc, wideIntersectFunc))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
 }
 
 dsBVH* dsBVH_create(
@@ -335,6 +1506,7 @@ dsBVH* dsBVH_create(
 	memset(bvh, 0, sizeof(dsBVH));
 	bvh->allocator = dsAllocator_keepPointer(allocator);
 	bvh->userData = userData;
+	bvh->freeNodes = INVALID_NODE;
 	bvh->storedAxisCount = axisCount;
 	// If axisCount is 4, the extra value is padding.
 	bvh->axisCount = dsMin(axisCount, 3);
@@ -490,24 +1662,10 @@ bool dsBVH_build(dsBVH* bvh, const void* objects, uint32_t objectCount, size_t o
 	uint32_t rootNode;
 	if (balance)
 	{
-		if (!bvh->tempNodes || objectCount > bvh->maxTempNodes)
-		{
-			dsAllocator_free(bvh->allocator, bvh->tempNodes);
-			bvh->tempNodes = (dsBVHNode*)dsAllocator_allocArray(
-				bvh->allocator, bvh->nodeSize, objectCount);
-			if (!bvh)
-				return false;
-			bvh->maxTempNodes = objectCount;
-		}
-
-		for (uint32_t i = 0; i < objectCount; ++i)
+		if (!setupTempNodes(bvh, objects, objectCount, objectSize))
 		{
-			dsBVHNode* node = getNode(bvh->tempNodes, bvh->nodeSize, i);
-			node->object = dsSpatialStructure_getObject(objects, objectSize, i);
-			if (!bvh->objectBoundsFunc(node->bounds, bvh, node->object))
-				return false;
-
-			node->leftNode = node->rightNode = INVALID_NODE;
+			dsBVH_clear(bvh);
+			return false;
 		}
 
 		rootNode = buildBVHBalancedRec(
@@ -524,6 +1682,72 @@ bool dsBVH_build(dsBVH* bvh, const void* objects, uint32_t objectCount, size_t o
 
 	DS_ASSERT(rootNode == 0);
 	DS_ASSERT(bvh->nodeCount == nodeCount);
+	buildWideNodes(bvh);
+	return true;
+}
+
+bool dsBVH_buildSAH(dsBVH* bvh, const void* objects, uint32_t objectCount, size_t objectSize,
+	dsBVHObjectBoundsFunction objectBoundsFunc, dsThreadPool* threadPool)
+{
+	dsBVH_clear(bvh);
+	if (!bvh || (!objects && objectCount > 0 && objectSize != DS_GEOMETRY_OBJECT_INDICES) ||
+		!objectBoundsFunc)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (objectCount == 0)
+		return true;
+
+	// Each leaf holds a single object, so l leaves require 2*l - 1 nodes.
+	uint32_t nodeCount = objectCount*2 - 1;
+	if (!dsResizeableArray_add(bvh->allocator, (void**)&bvh->nodes, &bvh->nodeCount,
+			&bvh->maxNodes, bvh->nodeSize, nodeCount))
+	{
+		return false;
+	}
+	bvh->nodeCount = 0;
+
+	bvh->objectBoundsFunc = objectBoundsFunc;
+	if (!setupTempNodes(bvh, objects, objectCount, objectSize))
+	{
+		dsBVH_clear(bvh);
+		return false;
+	}
+
+	if (!bvh->sahPrimitives || objectCount > bvh->maxSAHPrimitives)
+	{
+		DS_VERIFY(dsAllocator_free(bvh->allocator, bvh->sahPrimitives));
+		bvh->sahPrimitives = DS_ALLOCATE_OBJECT_ARRAY(bvh->allocator, SAHPrimitive, objectCount);
+		if (!bvh->sahPrimitives)
+		{
+			bvh->maxSAHPrimitives = 0;
+			dsBVH_clear(bvh);
+			return false;
+		}
+		bvh->maxSAHPrimitives = objectCount;
+	}
+
+	for (uint32_t i = 0; i < objectCount; ++i)
+	{
+		SAHPrimitive* primitive = bvh->sahPrimitives + i;
+		getDoubleBounds(&primitive->bounds, bvh, getNode(bvh->tempNodes, bvh->nodeSize, i)->bounds);
+		dsAlignedBox3_center(primitive->center, primitive->bounds);
+		primitive->tempNode = i;
+	}
+
+	SAHContext context = {bvh, getAddBoxFunction(bvh), 0};
+	if (threadPool && objectCount > MIN_TASK_OBJECTS &&
+		dsThreadPool_getThreadCount(threadPool) > 0)
+	{
+		buildSAHParallel(&context, objectCount, threadPool);
+	}
+	else
+		buildSAHRec(&context, 0, objectCount, 0, false);
+
+	bvh->nodeCount = nodeCount;
+	buildWideNodes(bvh);
 	return true;
 }
 
@@ -538,52 +1762,169 @@ bool dsBVH_update(dsBVH* bvh)
 	if (bvh->nodeCount == 0)
 		return true;
 
-	AddBoxFunction addBoxFunc;
-	switch (bvh->element)
+	bvh->wideNodeCount = 0;
+	AddBoxFunction addBoxFunc = getAddBoxFunction(bvh);
+	if (!updateBVHRec(bvh, bvh->nodes, addBoxFunc))
+		return false;
+
+	buildWideNodes(bvh);
+	return true;
+}
+
+bool dsBVH_updateIncremental(dsBVH* bvh, dsThreadPool* threadPool)
+{
+	if (!bvh)
 	{
-		case dsGeometryElement_Float:
-			if (bvh->axisCount == 2)
-				addBoxFunc = (AddBoxFunction)&dsAlignedBox2f_addBox;
-			else if (bvh->storedAxisCount == 4)
-			{
-				DS_ASSERT(bvh->axisCount == 3);
-				addBoxFunc = (AddBoxFunction)&dsAlignedBox3xf_addBox;
-			}
-			else
-			{
-				DS_ASSERT(bvh->axisCount == 3);
-				addBoxFunc = (AddBoxFunction)&dsAlignedBox3f_addBox;
-			}
-			break;
-		case dsGeometryElement_Double:
-			if (bvh->axisCount == 2)
-				addBoxFunc = (AddBoxFunction)&dsAlignedBox2d_addBox;
-			else if (bvh->storedAxisCount == 4)
-			{
-				DS_ASSERT(bvh->axisCount == 3);
-				addBoxFunc = (AddBoxFunction)&dsAlignedBox3xd_addBox;
-			}
-			else
-			{
-				DS_ASSERT(bvh->axisCount == 3);
-				addBoxFunc = (AddBoxFunction)&dsAlignedBox3d_addBox;
-			}
-			break;
-		case dsGeometryElement_Int:
-			if (bvh->axisCount == 2)
-				addBoxFunc = (AddBoxFunction)&dsAlignedBox2i_addBox;
-			else
-			{
-				DS_ASSERT(bvh->axisCount == 3);
-				addBoxFunc = (AddBoxFunction)&dsAlignedBox3i_addBox;
-			}
-			break;
-		default:
-			DS_ASSERT(false);
+		errno = EINVAL;
+		return false;
+	}
+
+	if (bvh->nodeCount == 0)
+		return true;
+
+	bvh->wideNodeCount = 0;
+	UpdateContext context = {bvh, getAddBoxFunction(bvh), UINT32_MAX};
+	bool success;
+	if (threadPool && bvh->nodeCount > MIN_TASK_OBJECTS*2 &&
+		dsThreadPool_getThreadCount(threadPool) > 0)
+	{
+		success = updateIncrementalParallel(&context, threadPool);
+	}
+	else
+		success = updateIncrementalRec(&context, 0, 0);
+
+	if (!success)
+		return false;
+
+	buildWideNodes(bvh);
+	return true;
+}
+
+bool dsBVH_insert(dsBVH* bvh, const void* object, dsBVHObjectBoundsFunction objectBoundsFunc)
+{
+	if (!bvh || !objectBoundsFunc)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (bvh->nodeCount > 0 && objectBoundsFunc != bvh->objectBoundsFunc)
+	{
+		errno = EINVAL;
+		DS_LOG_ERROR(DS_GEOMETRY_LOG_TAG,
+			"Object bounds function for BVH insert must match the function used to build it.");
+		return false;
+	}
+
+	// dsAlignedBox3xd is the maximum storage size.
+	DS_ALIGN(DS_ALLOC_ALIGNMENT) dsAlignedBox3xd bounds;
+	if (!objectBoundsFunc(&bounds, bvh, object))
+		return false;
+
+	// Wide nodes aren't kept in sync with single changes. They will be re-built on the next update.
+	bvh->wideNodeCount = 0;
+	uint32_t leafIndex = allocateNode(bvh);
+	if (leafIndex == INVALID_NODE)
+		return false;
+
+	if (leafIndex == 0)
+	{
+		DS_ASSERT(bvh->nodeCount == 1);
+		dsBVHNode* root = bvh->nodes;
+		root->leftNode = root->rightNode = INVALID_NODE;
+		root->object = object;
+		memcpy(root->bounds, &bounds, bvh->boundsSize);
+		bvh->objectBoundsFunc = objectBoundsFunc;
+		return true;
+	}
+
+	// Need a second node to hold the existing contents of the node that's being split.
+	uint32_t movedIndex = allocateNode(bvh);
+	if (movedIndex == INVALID_NODE)
+	{
+		freeNode(bvh, leafIndex);
+		return false;
+	}
+
+	// Descend towards the child whose area increases the least, expanding bounds along the way.
+	AddBoxFunction addBoxFunc = getAddBoxFunction(bvh);
+	dsAlignedBox3d doubleBounds;
+	getDoubleBounds(&doubleBounds, bvh, &bounds);
+	dsBVHNode* node = bvh->nodes;
+	while (!isLeaf(node))
+	{
+		dsBVHNode* left = getNode(bvh->nodes, bvh->nodeSize, node->leftNode);
+		dsBVHNode* right = getNode(bvh->nodes, bvh->nodeSize, node->rightNode);
+		addBoxFunc(node->bounds, &bounds);
+		if (getAreaIncrease(bvh, left, &doubleBounds) <= getAreaIncrease(bvh, right, &doubleBounds))
+			node = left;
+		else
+			node = right;
+	}
+
+	// Replace the leaf with a node that holds the original leaf and the new object.
+	memcpy(getNode(bvh->nodes, bvh->nodeSize, movedIndex), node, bvh->nodeSize);
+
+	dsBVHNode* leaf = getNode(bvh->nodes, bvh->nodeSize, leafIndex);
+	leaf->leftNode = leaf->rightNode = INVALID_NODE;
+	leaf->object = object;
+	memcpy(leaf->bounds, &bounds, bvh->boundsSize);
+
+	node->leftNode = movedIndex;
+	node->rightNode = leafIndex;
+	node->object = NULL;
+	addBoxFunc(node->bounds, &bounds);
+	return true;
+}
+
+bool dsBVH_remove(dsBVH* bvh, const void* object)
+{
+	if (!bvh)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (bvh->nodeCount == 0)
+	{
+		errno = ENOTFOUND;
+		return false;
+	}
+
+	dsBVHNode* root = bvh->nodes;
+	if (isLeaf(root))
+	{
+		if (root->object != object)
+		{
+			errno = ENOTFOUND;
 			return false;
+		}
+
+		dsBVH_clear(bvh);
+		return true;
+	}
+
+	// Use the current bounds of the object to limit the search. If the object has moved since the
+	// BVH was last built or updated, fall back to searching the full tree.
+	bvh->wideNodeCount = 0;
+	AddBoxFunction addBoxFunc = getAddBoxFunction(bvh);
+	DS_ALIGN(DS_ALLOC_ALIGNMENT) dsAlignedBox3xd bounds;
+	int prevErrno = errno;
+	if (bvh->objectBoundsFunc(&bounds, bvh, object))
+	{
+		dsAlignedBox3d doubleBounds;
+		getDoubleBounds(&doubleBounds, bvh, &bounds);
+		if (removeRec(bvh, 0, object, &doubleBounds, addBoxFunc))
+			return true;
 	}
+	else
+		errno = prevErrno;
+
+	if (removeRec(bvh, 0, object, NULL, addBoxFunc))
+		return true;
 
-	return updateBVHRec(bvh, bvh->nodes, addBoxFunc);
+	errno = ENOTFOUND;
+	return false;
 }
 
 bool dsBVH_empty(const dsBVH* bvh)
@@ -643,6 +1984,18 @@ uint32_t dsBVH_intersectBounds(
 	}
 
 	uint32_t count = 0;
+#if DS_HAS_SIMD
+	if (bvh->wideNodeCount > 0)
+	{
+		DS_ASSERT(bvh->element == dsGeometryElement_Float);
+		WideBounds wideBounds;
+		getWideBounds(&wideBounds, bvh, (const float*)bounds);
+		intersectWideNodes(bvh, &count, 0, bounds, &wideBounds, visitor, userData, NULL,
+			&intersectWideBoundsSIMD);
+		return count;
+	}
+#endif
+
 	intersectBVHRec(bvh, &count, bvh->nodes, bounds, visitor, userData, intersectFunc, false);
 	return count;
 }
@@ -709,6 +2062,26 @@ uint32_t dsBVH_intersectFrustum(
 	}
 
 	uint32_t count = 0;
+#if DS_HAS_SIMD
+	if (bvh->wideNodeCount > 0)
+	{
+		DS_ASSERT(bvh->element == dsGeometryElement_Float);
+		WideIntersectFunction wideIntersectFunc;
+#if !DS_DETERMINISTIC_MATH
+		if (DS_SIMD_ALWAYS_FMA || (dsHostSIMDFeatures & dsSIMDFeatures_FMA))
+			wideIntersectFunc = &intersectWideFrustumFMA;
+		else
+#endif // !DS_DETERMINISTIC_MATH
+			wideIntersectFunc = &intersectWideFrustumSIMD;
+
+		WideFrustum wideFrustum;
+		getWideFrustum(&wideFrustum, (const dsFrustum3f*)frustum);
+		intersectWideNodes(bvh, &count, 0, frustum, &wideFrustum, visitor, userData,
+			intersectFunc, wideIntersectFunc);
+		return count;
+	}
+#endif
+
 	intersectBVHRec(bvh, &count, bvh->nodes, frustum, visitor, userData, intersectFunc, false);
 	return count;
 }
@@ -719,6 +2092,8 @@ void dsBVH_clear(dsBVH* bvh)
 		return;
 
 	bvh->nodeCount = 0;
+	bvh->freeNodes = INVALID_NODE;
+	bvh->wideNodeCount = 0;
 	bvh->objectBoundsFunc = NULL;
 }
 
@@ -738,5 +2113,11 @@ void dsBVH_destroy(dsBVH* bvh)
 
 	DS_VERIFY(dsAllocator_free(bvh->allocator, bvh->nodes));
 	DS_VERIFY(dsAllocator_free(bvh->allocator, bvh->tempNodes));
+	DS_VERIFY(dsAllocator_free(bvh->allocator, bvh->sahPrimitives));
+	DS_VERIFY(dsAllocator_free(bvh->allocator, bvh->sahTasks));
+	DS_VERIFY(dsAllocator_free(bvh->allocator, bvh->threadTasks));
+	DS_VERIFY(dsAllocator_free(bvh->allocator, bvh->updateNodes));
+	DS_VERIFY(dsAllocator_free(bvh->allocator, bvh->updateTasks));
+	DS_VERIFY(dsAllocator_free(bvh->allocator, bvh->wideNodes));
 	DS_VERIFY(dsAllocator_free(bvh->allocator, bvh));
 }
@@ -542,6 +542,159 @@ dsIntersectResult dsFrustum3d_intersectSphere3x(
 #endif
 }
 
+typedef struct PlaneArrays
+{
+	DS_ALIGN(32) float nx[8];
+	DS_ALIGN(32) float ny[8];
+	DS_ALIGN(32) float nz[8];
+	DS_ALIGN(32) float d[8];
+	DS_ALIGN(32) float absX[8];
+	DS_ALIGN(32) float absY[8];
+	DS_ALIGN(32) float absZ[8];
+} PlaneArrays;
+
+static void setupPlaneArrays(PlaneArrays* planes, const dsFrustum3f* frustum)
+{
+	// Unused lanes have a zero normal with a positive distance so they are always inside.
+	int count = dsFrustum3f_isInfinite(frustum) ? dsFrustumPlanes_Far : dsFrustumPlanes_Count;
+	for (int i = 0; i < 8; ++i)
+	{
+		if (i < count)
+		{
+			const dsPlane3f* plane = frustum->planes + i;
+			planes->nx[i] = plane->n.x;
+			planes->ny[i] = plane->n.y;
+			planes->nz[i] = plane->n.z;
+			planes->d[i] = plane->d;
+			planes->absX[i] = fabsf(plane->n.x);
+			planes->absY[i] = fabsf(plane->n.y);
+			planes->absZ[i] = fabsf(plane->n.z);
+		}
+		else
+		{
+			planes->nx[i] = planes->ny[i] = planes->nz[i] = 0.0f;
+			planes->absX[i] = planes->absY[i] = planes->absZ[i] = 0.0f;
+			planes->d[i] = 1.0f;
+		}
+	}
+}
+
+static inline void getBoxCenterExtents(float* center, float* halfExtents, const dsAlignedBox3f* box)
+{
+	center[0] = (box->min.x + box->max.x)*0.5f;
+	center[1] = (box->min.y + box->max.y)*0.5f;
+	center[2] = (box->min.z + box->max.z)*0.5f;
+	halfExtents[0] = (box->max.x - box->min.x)*0.5f;
+	halfExtents[1] = (box->max.y - box->min.y)*0.5f;
+	halfExtents[2] = (box->max.z - box->min.z)*0.5f;
+}
+
+typedef struct BoxArrays
+{
+	DS_ALIGN(32) float minX[8];
+	DS_ALIGN(32) float minY[8];
+	DS_ALIGN(32) float minZ[8];
+	DS_ALIGN(32) float maxX[8];
+	DS_ALIGN(32) float maxY[8];
+	DS_ALIGN(32) float maxZ[8];
+} BoxArrays;
+
+static void setupBoxArrays(BoxArrays* arrays, const dsAlignedBox3f* boxes, uint32_t count)
+{
+	// Unused lanes are given empty boxes so they don't produce invalid values.
+	for (uint32_t i = 0; i < 8; ++i)
+	{
+		if (i < count)
+		{
+			const dsAlignedBox3f* box = boxes + i;
+			arrays->minX[i] = box->min.x;
+			arrays->minY[i] = box->min.y;
+			arrays->minZ[i] = box->min.z;
+			arrays->maxX[i] = box->max.x;
+			arrays->maxY[i] = box->max.y;
+			arrays->maxZ[i] = box->max.z;
+		}
+		else
+		{
+			arrays->minX[i] = arrays->minY[i] = arrays->minZ[i] = 0.0f;
+			arrays->maxX[i] = arrays->maxY[i] = arrays->maxZ[i] = 0.0f;
+		}
+	}
+}
+
+static inline void setBoxResults(dsIntersectResult* results, const uint32_t* outsideLanes,
+	const uint32_t* insideLanes, uint32_t count)
+{
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		if (outsideLanes[i])
+			results[i] = dsIntersectResult_Outside;
+		else
+			results[i] = insideLanes[i] ? dsIntersectResult_Inside : dsIntersectResult_Intersects;
+	}
+}
+
+static inline dsIntersectResult getBoxResult(uint32_t outsideMask, uint32_t insideMask,
+	uint32_t allMask)
+{
+	if (outsideMask)
+		return dsIntersectResult_Outside;
+	return insideMask == allMask ? dsIntersectResult_Inside : dsIntersectResult_Intersects;
+}
+
+void dsFrustum3f_intersectAlignedBoxesArray(dsIntersectResult* results,
+	const dsFrustum3f* frustum, const dsAlignedBox3f* boxes, uint32_t boxCount)
+{
+	DS_ASSERT(results || boxCount == 0);
+	DS_ASSERT(frustum);
+	DS_ASSERT(boxes || boxCount == 0);
+
+	switch (dsHostSIMDArrayImplementation)
+	{
+#if DS_HAS_SIMD
+#if !DS_DETERMINISTIC_MATH
+		case dsSIMDArrayImplementation_FMA8:
+			dsFrustum3f_intersectAlignedBoxesArrayFMA8(results, frustum, boxes, boxCount);
+			return;
+		case dsSIMDArrayImplementation_FMA:
+			dsFrustum3f_intersectAlignedBoxesArrayFMA(results, frustum, boxes, boxCount);
+			return;
+#endif
+		case dsSIMDArrayImplementation_SIMD8:
+			dsFrustum3f_intersectAlignedBoxesArraySIMD8(results, frustum, boxes, boxCount);
+			return;
+		case dsSIMDArrayImplementation_SIMD:
+			dsFrustum3f_intersectAlignedBoxesArraySIMD(results, frustum, boxes, boxCount);
+			return;
+#endif
+		default:
+			break;
+	}
+
+	PlaneArrays planes;
+	setupPlaneArrays(&planes, frustum);
+	for (uint32_t i = 0; i < boxCount; ++i)
+	{
+		float center[3], halfExtents[3];
+		getBoxCenterExtents(center, halfExtents, boxes + i);
+
+		uint32_t outsideMask = 0, insideMask = 0;
+		for (unsigned int j = 0; j < 8; ++j)
+		{
+			float dist = planes.nx[j]*center[0] + planes.ny[j]*center[1] +
+				planes.nz[j]*center[2] + planes.d[j];
+			float radius = planes.absX[j]*halfExtents[0] + planes.absY[j]*halfExtents[1] +
+				planes.absZ[j]*halfExtents[2];
+			if (dist + radius < 0.0f)
+				outsideMask |= 1U << j;
+			if (dist - radius > 0.0f)
+				insideMask |= 1U << j;
+		}
+
+		results[i] = getBoxResult(outsideMask, insideMask, 0xFF);
+	}
+}
+
 #if DS_HAS_SIMD
 DS_SIMD_START(DS_SIMD_FLOAT4)
 
@@ -654,6 +807,68 @@ dsIntersectResult dsFrustum3f_intersectSphereSIMD(
 	return intersects ? dsIntersectResult_Intersects : dsIntersectResult_Inside;
 }
 
+void dsFrustum3f_intersectAlignedBoxesArraySIMD(dsIntersectResult* results,
+	const dsFrustum3f* frustum, const dsAlignedBox3f* boxes, uint32_t boxCount)
+{
+	DS_ASSERT(results || boxCount == 0);
+	DS_ASSERT(frustum);
+	DS_ASSERT(boxes || boxCount == 0);
+
+	// Test 4 boxes at once against each plane.
+	PlaneArrays planes;
+	setupPlaneArrays(&planes, frustum);
+	int planeCount = dsFrustum3f_isInfinite(frustum) ? dsFrustumPlanes_Far : dsFrustumPlanes_Count;
+	BoxArrays boxArrays;
+	DS_ALIGN(32) uint32_t outsideLanes[4];
+	DS_ALIGN(32) uint32_t insideLanes[4];
+	dsSIMD4f zero = dsSIMD4f_set1(0.0f);
+	dsSIMD4f half = dsSIMD4f_set1(0.5f);
+	for (uint32_t i = 0; i < boxCount; i += 4)
+	{
+		uint32_t count = dsMin(boxCount - i, 4U);
+		setupBoxArrays(&boxArrays, boxes + i, count);
+		dsSIMD4f minX = dsSIMD4f_load(boxArrays.minX);
+		dsSIMD4f minY = dsSIMD4f_load(boxArrays.minY);
+		dsSIMD4f minZ = dsSIMD4f_load(boxArrays.minZ);
+		dsSIMD4f maxX = dsSIMD4f_load(boxArrays.maxX);
+		dsSIMD4f maxY = dsSIMD4f_load(boxArrays.maxY);
+		dsSIMD4f maxZ = dsSIMD4f_load(boxArrays.maxZ);
+		dsSIMD4f cx = dsSIMD4f_mul(dsSIMD4f_add(minX, maxX), half);
+		dsSIMD4f cy = dsSIMD4f_mul(dsSIMD4f_add(minY, maxY), half);
+		dsSIMD4f cz = dsSIMD4f_mul(dsSIMD4f_add(minZ, maxZ), half);
+		dsSIMD4f ex = dsSIMD4f_mul(dsSIMD4f_sub(maxX, minX), half);
+		dsSIMD4f ey = dsSIMD4f_mul(dsSIMD4f_sub(maxY, minY), half);
+		dsSIMD4f ez = dsSIMD4f_mul(dsSIMD4f_sub(maxZ, minZ), half);
+
+		dsSIMD4fb outside = dsSIMD4fb_false();
+		dsSIMD4fb inside = dsSIMD4fb_true();
+		for (int j = 0; j < planeCount; ++j)
+		{
+			dsSIMD4f nx = dsSIMD4f_set1(planes.nx[j]);
+			dsSIMD4f ny = dsSIMD4f_set1(planes.ny[j]);
+			dsSIMD4f nz = dsSIMD4f_set1(planes.nz[j]);
+			dsSIMD4f d = dsSIMD4f_set1(planes.d[j]);
+			dsSIMD4f absX = dsSIMD4f_set1(planes.absX[j]);
+			dsSIMD4f absY = dsSIMD4f_set1(planes.absY[j]);
+			dsSIMD4f absZ = dsSIMD4f_set1(planes.absZ[j]);
+
+			dsSIMD4f dist = dsSIMD4f_add(dsSIMD4f_add(dsSIMD4f_mul(nx, cx), dsSIMD4f_mul(ny, cy)),
+				dsSIMD4f_add(dsSIMD4f_mul(nz, cz), d));
+			dsSIMD4f radius = dsSIMD4f_add(dsSIMD4f_add(dsSIMD4f_mul(absX, ex),
+				dsSIMD4f_mul(absY, ey)), dsSIMD4f_mul(absZ, ez));
+
+			outside = dsSIMD4fb_or(outside,
+				dsSIMD4f_cmplt(dsSIMD4f_add(dist, radius), zero));
+			inside = dsSIMD4fb_and(inside,
+				dsSIMD4f_cmpgt(dsSIMD4f_sub(dist, radius), zero));
+		}
+
+		dsSIMD4fb_store(outsideLanes, outside);
+		dsSIMD4fb_store(insideLanes, inside);
+		setBoxResults(results + i, outsideLanes, insideLanes, count);
+	}
+}
+
 DS_SIMD_END()
 
 #if !DS_DETERMINISTIC_MATH
@@ -768,6 +983,68 @@ dsIntersectResult dsFrustum3f_intersectSphereFMA(
 	return intersects ? dsIntersectResult_Intersects : dsIntersectResult_Inside;
 }
 
+void dsFrustum3f_intersectAlignedBoxesArrayFMA(dsIntersectResult* results,
+	const dsFrustum3f* frustum, const dsAlignedBox3f* boxes, uint32_t boxCount)
+{
+	DS_ASSERT(results || boxCount == 0);
+	DS_ASSERT(frustum);
+	DS_ASSERT(boxes || boxCount == 0);
+
+	// Test 4 boxes at once against each plane.
+	PlaneArrays planes;
+	setupPlaneArrays(&planes, frustum);
+	int planeCount = dsFrustum3f_isInfinite(frustum) ? dsFrustumPlanes_Far : dsFrustumPlanes_Count;
+	BoxArrays boxArrays;
+	DS_ALIGN(32) uint32_t outsideLanes[4];
+	DS_ALIGN(32) uint32_t insideLanes[4];
+	dsSIMD4f zero = dsSIMD4f_set1(0.0f);
+	dsSIMD4f half = dsSIMD4f_set1(0.5f);
+	for (uint32_t i = 0; i < boxCount; i += 4)
+	{
+		uint32_t count = dsMin(boxCount - i, 4U);
+		setupBoxArrays(&boxArrays, boxes + i, count);
+		dsSIMD4f minX = dsSIMD4f_load(boxArrays.minX);
+		dsSIMD4f minY = dsSIMD4f_load(boxArrays.minY);
+		dsSIMD4f minZ = dsSIMD4f_load(boxArrays.minZ);
+		dsSIMD4f maxX = dsSIMD4f_load(boxArrays.maxX);
+		dsSIMD4f maxY = dsSIMD4f_load(boxArrays.maxY);
+		dsSIMD4f maxZ = dsSIMD4f_load(boxArrays.maxZ);
+		dsSIMD4f cx = dsSIMD4f_mul(dsSIMD4f_add(minX, maxX), half);
+		dsSIMD4f cy = dsSIMD4f_mul(dsSIMD4f_add(minY, maxY), half);
+		dsSIMD4f cz = dsSIMD4f_mul(dsSIMD4f_add(minZ, maxZ), half);
+		dsSIMD4f ex = dsSIMD4f_mul(dsSIMD4f_sub(maxX, minX), half);
+		dsSIMD4f ey = dsSIMD4f_mul(dsSIMD4f_sub(maxY, minY), half);
+		dsSIMD4f ez = dsSIMD4f_mul(dsSIMD4f_sub(maxZ, minZ), half);
+
+		dsSIMD4fb outside = dsSIMD4fb_false();
+		dsSIMD4fb inside = dsSIMD4fb_true();
+		for (int j = 0; j < planeCount; ++j)
+		{
+			dsSIMD4f nx = dsSIMD4f_set1(planes.nx[j]);
+			dsSIMD4f ny = dsSIMD4f_set1(planes.ny[j]);
+			dsSIMD4f nz = dsSIMD4f_set1(planes.nz[j]);
+			dsSIMD4f d = dsSIMD4f_set1(planes.d[j]);
+			dsSIMD4f absX = dsSIMD4f_set1(planes.absX[j]);
+			dsSIMD4f absY = dsSIMD4f_set1(planes.absY[j]);
+			dsSIMD4f absZ = dsSIMD4f_set1(planes.absZ[j]);
+
+			dsSIMD4f dist = dsSIMD4f_fmadd(nx, cx,
+				dsSIMD4f_fmadd(ny, cy, dsSIMD4f_fmadd(nz, cz, d)));
+			dsSIMD4f radius = dsSIMD4f_fmadd(absX, ex,
+				dsSIMD4f_fmadd(absY, ey, dsSIMD4f_mul(absZ, ez)));
+
+			outside = dsSIMD4fb_or(outside,
+				dsSIMD4f_cmplt(dsSIMD4f_add(dist, radius), zero));
+			inside = dsSIMD4fb_and(inside,
+				dsSIMD4f_cmpgt(dsSIMD4f_sub(dist, radius), zero));
+		}
+
+		dsSIMD4fb_store(outsideLanes, outside);
+		dsSIMD4fb_store(insideLanes, inside);
+		setBoxResults(results + i, outsideLanes, insideLanes, count);
+	}
+}
+
 DS_SIMD_END()
 #endif // !DS_DETERMINISTIC_MATH
 
@@ -1116,6 +1393,138 @@ dsIntersectResult dsFrustum3d_intersectSphereSIMD4(const dsFrustum3d* DS_ALIGN_P
 }
 
 DS_SIMD_END()
+
+DS_SIMD_START(DS_SIMD_FLOAT8)
+void dsFrustum3f_intersectAlignedBoxesArraySIMD8(dsIntersectResult* results,
+	const dsFrustum3f* frustum, const dsAlignedBox3f* boxes, uint32_t boxCount)
+{
+	DS_ASSERT(results || boxCount == 0);
+	DS_ASSERT(frustum);
+	DS_ASSERT(boxes || boxCount == 0);
+
+	// Test 8 boxes at once against each plane.
+	PlaneArrays planes;
+	setupPlaneArrays(&planes, frustum);
+	int planeCount = dsFrustum3f_isInfinite(frustum) ? dsFrustumPlanes_Far : dsFrustumPlanes_Count;
+	BoxArrays boxArrays;
+	DS_ALIGN(32) uint32_t outsideLanes[8];
+	DS_ALIGN(32) uint32_t insideLanes[8];
+	dsSIMD8f zero = dsSIMD8f_set1(0.0f);
+	dsSIMD8f half = dsSIMD8f_set1(0.5f);
+	for (uint32_t i = 0; i < boxCount; i += 8)
+	{
+		uint32_t count = dsMin(boxCount - i, 8U);
+		setupBoxArrays(&boxArrays, boxes + i, count);
+		dsSIMD8f minX = dsSIMD8f_load(boxArrays.minX);
+		dsSIMD8f minY = dsSIMD8f_load(boxArrays.minY);
+		dsSIMD8f minZ = dsSIMD8f_load(boxArrays.minZ);
+		dsSIMD8f maxX = dsSIMD8f_load(boxArrays.maxX);
+		dsSIMD8f maxY = dsSIMD8f_load(boxArrays.maxY);
+		dsSIMD8f maxZ = dsSIMD8f_load(boxArrays.maxZ);
+		dsSIMD8f cx = dsSIMD8f_mul(dsSIMD8f_add(minX, maxX), half);
+		dsSIMD8f cy = dsSIMD8f_mul(dsSIMD8f_add(minY, maxY), half);
+		dsSIMD8f cz = dsSIMD8f_mul(dsSIMD8f_add(minZ, maxZ), half);
+		dsSIMD8f ex = dsSIMD8f_mul(dsSIMD8f_sub(maxX, minX), half);
+		dsSIMD8f ey = dsSIMD8f_mul(dsSIMD8f_sub(maxY, minY), half);
+		dsSIMD8f ez = dsSIMD8f_mul(dsSIMD8f_sub(maxZ, minZ), half);
+
+		dsSIMD8fb outside = dsSIMD8fb_false();
+		dsSIMD8fb inside = dsSIMD8fb_true();
+		for (int j = 0; j < planeCount; ++j)
+		{
+			dsSIMD8f nx = dsSIMD8f_set1(planes.nx[j]);
+			dsSIMD8f ny = dsSIMD8f_set1(planes.ny[j]);
+			dsSIMD8f nz = dsSIMD8f_set1(planes.nz[j]);
+			dsSIMD8f d = dsSIMD8f_set1(planes.d[j]);
+			dsSIMD8f absX = dsSIMD8f_set1(planes.absX[j]);
+			dsSIMD8f absY = dsSIMD8f_set1(planes.absY[j]);
+			dsSIMD8f absZ = dsSIMD8f_set1(planes.absZ[j]);
+
+			dsSIMD8f dist = dsSIMD8f_add(dsSIMD8f_add(dsSIMD8f_mul(nx, cx), dsSIMD8f_mul(ny, cy)),
+				dsSIMD8f_add(dsSIMD8f_mul(nz, cz), d));
+			dsSIMD8f radius = dsSIMD8f_add(dsSIMD8f_add(dsSIMD8f_mul(absX, ex),
+				dsSIMD8f_mul(absY, ey)), dsSIMD8f_mul(absZ, ez));
+
+			outside = dsSIMD8fb_or(outside,
+				dsSIMD8f_cmplt(dsSIMD8f_add(dist, radius), zero));
+			inside = dsSIMD8fb_and(inside,
+				dsSIMD8f_cmpgt(dsSIMD8f_sub(dist, radius), zero));
+		}
+
+		dsSIMD8fb_store(outsideLanes, outside);
+		dsSIMD8fb_store(insideLanes, inside);
+		setBoxResults(results + i, outsideLanes, insideLanes, count);
+	}
+}
+
+DS_SIMD_END()
+
+#if !DS_DETERMINISTIC_MATH
+DS_SIMD_START(DS_SIMD_FLOAT8,DS_SIMD_FMA)
+void dsFrustum3f_intersectAlignedBoxesArrayFMA8(dsIntersectResult* results,
+	const dsFrustum3f* frustum, const dsAlignedBox3f* boxes, uint32_t boxCount)
+{
+	DS_ASSERT(results || boxCount == 0);
+	DS_ASSERT(frustum);
+	DS_ASSERT(boxes || boxCount == 0);
+
+	// Test 8 boxes at once against each plane.
+	PlaneArrays planes;
+	setupPlaneArrays(&planes, frustum);
+	int planeCount = dsFrustum3f_isInfinite(frustum) ? dsFrustumPlanes_Far : dsFrustumPlanes_Count;
+	BoxArrays boxArrays;
+	DS_ALIGN(32) uint32_t outsideLanes[8];
+	DS_ALIGN(32) uint32_t insideLanes[8];
+	dsSIMD8f zero = dsSIMD8f_set1(0.0f);
+	dsSIMD8f half = dsSIMD8f_set1(0.5f);
+	for (uint32_t i = 0; i < boxCount; i += 8)
+	{
+		uint32_t count = dsMin(boxCount - i, 8U);
+		setupBoxArrays(&boxArrays, boxes + i, count);
+		dsSIMD8f minX = dsSIMD8f_load(boxArrays.minX);
+		dsSIMD8f minY = dsSIMD8f_load(boxArrays.minY);
+		dsSIMD8f minZ = dsSIMD8f_load(boxArrays.minZ);
+		dsSIMD8f maxX = dsSIMD8f_load(boxArrays.maxX);
+		dsSIMD8f maxY = dsSIMD8f_load(boxArrays.maxY);
+		dsSIMD8f maxZ = dsSIMD8f_load(boxArrays.maxZ);
+		dsSIMD8f cx = dsSIMD8f_mul(dsSIMD8f_add(minX, maxX), half);
+		dsSIMD8f cy = dsSIMD8f_mul(dsSIMD8f_add(minY, maxY), half);
+		dsSIMD8f cz = dsSIMD8f_mul(dsSIMD8f_add(minZ, maxZ), half);
+		dsSIMD8f ex = dsSIMD8f_mul(dsSIMD8f_sub(maxX, minX), half);
+		dsSIMD8f ey = dsSIMD8f_mul(dsSIMD8f_sub(maxY, minY), half);
+		dsSIMD8f ez = dsSIMD8f_mul(dsSIMD8f_sub(maxZ, minZ), half);
+
+		dsSIMD8fb outside = dsSIMD8fb_false();
+		dsSIMD8fb inside = dsSIMD8fb_true();
+		for (int j = 0; j < planeCount; ++j)
+		{
+			dsSIMD8f nx = dsSIMD8f_set1(planes.nx[j]);
+			dsSIMD8f ny = dsSIMD8f_set1(planes.ny[j]);
+			dsSIMD8f nz = dsSIMD8f_set1(planes.nz[j]);
+			dsSIMD8f d = dsSIMD8f_set1(planes.d[j]);
+			dsSIMD8f absX = dsSIMD8f_set1(planes.absX[j]);
+			dsSIMD8f absY = dsSIMD8f_set1(planes.absY[j]);
+			dsSIMD8f absZ = dsSIMD8f_set1(planes.absZ[j]);
+
+			dsSIMD8f dist = dsSIMD8f_fmadd(nx, cx,
+				dsSIMD8f_fmadd(ny, cy, dsSIMD8f_fmadd(nz, cz, d)));
+			dsSIMD8f radius = dsSIMD8f_fmadd(absX, ex,
+				dsSIMD8f_fmadd(absY, ey, dsSIMD8f_mul(absZ, ez)));
+
+			outside = dsSIMD8fb_or(outside,
+				dsSIMD8f_cmplt(dsSIMD8f_add(dist, radius), zero));
+			inside = dsSIMD8fb_and(inside,
+				dsSIMD8f_cmpgt(dsSIMD8f_sub(dist, radius), zero));
+		}
+
+		dsSIMD8fb_store(outsideLanes, outside);
+		dsSIMD8fb_store(insideLanes, inside);
+		setBoxResults(results + i, outsideLanes, insideLanes, count);
+	}
+}
+
+DS_SIMD_END()
+#endif // !DS_DETERMINISTIC_MATH
 #endif // DS_HAS_SIMD
 
 void dsFrustum3f_fromMatrix(
@@ -16,6 +16,9 @@
 
 #include <DeepSea/Core/Memory/Allocator.h>
 #include <DeepSea/Core/Memory/SystemAllocator.h>
+#include <DeepSea/Core/Thread/ThreadPool.h>
+#include <DeepSea/Core/Error.h>
+#include <DeepSea/Core/Timer.h>
 
 #include <DeepSea/Geometry/AlignedBox2.h>
 #include <DeepSea/Geometry/AlignedBox3x.h>
@@ -27,12 +30,19 @@
 #include <DeepSea/Math/Vector3.h>
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <random>
+#include <vector>
 
 // Handle older versions of gtest.
 #ifndef TYPED_TEST_SUITE
 #define TYPED_TEST_SUITE TYPED_TEST_CASE
 #endif
 
+#define DS_PERFORMANCE_TESTS 0
+
 namespace
 {
 
@@ -442,6 +452,147 @@ public:
 		dsAllocator_free(reinterpret_cast<dsAllocator*>(&allocator), object);
 	}
 
+	// Integer bounds used to compute the expected results for randomized tests.
+	struct IntBounds
+	{
+		int min[3];
+		int max[3];
+	};
+
+	static bool intersects(const IntBounds& lhs, const IntBounds& rhs)
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			if (lhs.min[i] > rhs.max[i] || lhs.max[i] < rhs.min[i])
+				return false;
+		}
+		return true;
+	}
+
+	static IntBounds randomBounds(std::mt19937& random, int maxSize)
+	{
+		std::uniform_int_distribution<int> positionDistribution(-1000, 1000);
+		std::uniform_int_distribution<int> sizeDistribution(0, maxSize);
+		IntBounds bounds = {};
+		unsigned int boundsAxisCount = axisCount() > 2 ? 3 : 2;
+		for (unsigned int i = 0; i < boundsAxisCount; ++i)
+		{
+			bounds.min[i] = positionDistribution(random);
+			bounds.max[i] = bounds.min[i] + sizeDistribution(random);
+		}
+		return bounds;
+	}
+
+	static AlignedBoxType toAlignedBox(const IntBounds& bounds)
+	{
+		return createBounds(bounds.min[0], bounds.min[1], bounds.min[2], bounds.max[0],
+			bounds.max[1], bounds.max[2]);
+	}
+
+	static void setRandomObjects(std::vector<TestObject>& objects,
+		std::vector<IntBounds>& intBounds, std::mt19937& random)
+	{
+		intBounds.resize(objects.size());
+		for (size_t i = 0; i < objects.size(); ++i)
+		{
+			intBounds[i] = randomBounds(random, 50);
+			objects[i].bounds = toAlignedBox(intBounds[i]);
+			objects[i].data = (int)i;
+		}
+	}
+
+	static void checkRandomQueries(const dsBVH* bvh, const std::vector<IntBounds>& intBounds,
+		const std::vector<bool>* present = nullptr)
+	{
+		std::mt19937 random(54321);
+		for (unsigned int i = 0; i < 100; ++i)
+		{
+			IntBounds queryBounds = randomBounds(random, 200);
+			uint32_t expectedCount = 0;
+			for (size_t j = 0; j < intBounds.size(); ++j)
+			{
+				if ((!present || (*present)[j]) && intersects(intBounds[j], queryBounds))
+					++expectedCount;
+			}
+
+			AlignedBoxType testBounds = toAlignedBox(queryBounds);
+			EXPECT_EQ(expectedCount, dsBVH_intersectBounds(bvh, &testBounds, nullptr, nullptr));
+		}
+
+		IntBounds fullIntBounds = {{INT_MAX, INT_MAX, INT_MAX}, {INT_MIN, INT_MIN, INT_MIN}};
+		for (size_t i = 0; i < intBounds.size(); ++i)
+		{
+			if (present && !(*present)[i])
+				continue;
+
+			for (unsigned int j = 0; j < 3; ++j)
+			{
+				fullIntBounds.min[j] = std::min(fullIntBounds.min[j], intBounds[i].min[j]);
+				fullIntBounds.max[j] = std::max(fullIntBounds.max[j], intBounds[i].max[j]);
+			}
+		}
+
+		AlignedBoxType bounds;
+		EXPECT_TRUE(dsBVH_getBounds(&bounds, bvh));
+		EXPECT_TRUE(boundsEqual(toAlignedBox(fullIntBounds), bounds));
+	}
+
+	static std::vector<int> intersectFrustum(const dsBVH* bvh, const FrustumType& frustum)
+	{
+		std::vector<int> visited;
+		auto visitFunc = [&visited](const TestObject& object)
+		{
+			visited.push_back(object.data);
+		};
+
+		uint32_t count = dsBVH_intersectFrustum(
+			bvh, &frustum, lambdaAdapter(visitFunc), &visitFunc);
+		EXPECT_EQ(visited.size(), count);
+		std::sort(visited.begin(), visited.end());
+		return visited;
+	}
+
+	// Checks that all objects that clearly intersect with the frustum were visited. Objects close to
+	// the boundary may be conservatively included.
+	static void checkFrustumResults(const FrustumType& frustum,
+		const std::vector<IntBounds>& intBounds, const std::vector<int>& results)
+	{
+		if (axisCount() < 3 || element() == dsGeometryElement_Int)
+		{
+			EXPECT_TRUE(results.empty());
+			return;
+		}
+
+		for (size_t i = 0; i < intBounds.size(); ++i)
+		{
+			const IntBounds& bounds = intBounds[i];
+			bool intersects = true;
+			for (const auto& plane : frustum.planes)
+			{
+				double centerDist = plane.d, radius = 0.0, magnitude = fabs(plane.d);
+				for (unsigned int j = 0; j < 3; ++j)
+				{
+					double normal = plane.n.values[j];
+					double center = (bounds.min[j] + bounds.max[j])*0.5;
+					centerDist += normal*center;
+					radius += fabs(normal)*(bounds.max[j] - bounds.min[j])*0.5;
+					magnitude += fabs(normal*center);
+				}
+
+				if (centerDist < -radius + magnitude*1e-3)
+				{
+					intersects = false;
+					break;
+				}
+			}
+
+			if (intersects)
+			{
+				EXPECT_TRUE(std::binary_search(results.begin(), results.end(), (int)i));
+			}
+		}
+	}
+
 	dsSystemAllocator allocator;
 };
 
@@ -640,6 +791,95 @@ TYPED_TEST(BVHTest, SeparateBoxesBalanced)
 	dsBVH_destroy(bvh);
 }
 
+TYPED_TEST(BVHTest, SeparateBoxesSAH)
+{
+	using TestObject = typename TestFixture::TestObject;
+	using AlignedBoxType = typename TestFixture::AlignedBoxType;
+
+	TestFixture* fixture = this;
+	dsBVH* bvh = dsBVH_create(
+		(dsAllocator*)&fixture->allocator, TestFixture::axisCount(), TestFixture::element(), NULL);
+	ASSERT_TRUE(bvh);
+
+	TestObject data[] =
+	{
+		{TestFixture::createBounds(-2, -2, 0, -1, -1, 0), 0},
+		{TestFixture::createBounds( 1, -2, 0,  2, -1, 0), 1},
+		{TestFixture::createBounds(-2,  1, 0, -1,  2, 0), 2},
+		{TestFixture::createBounds( 1,  1, 0,  2,  2, 0), 3}
+	};
+
+	EXPECT_TRUE(dsBVH_empty(bvh));
+	EXPECT_TRUE(dsBVH_buildSAH(
+		bvh, data, DS_ARRAY_SIZE(data), sizeof(TestObject), &TestFixture::getBounds, nullptr));
+	EXPECT_FALSE(dsBVH_empty(bvh));
+
+	AlignedBoxType testBounds = TestFixture::createBounds(0, 0, 0, 0, 0, 0);
+	EXPECT_EQ(0U, dsBVH_intersectBounds(bvh, &testBounds, nullptr, nullptr));
+
+	{
+		auto testFunc = [](const TestObject& object)
+		{
+			EXPECT_EQ(0, object.data);
+		};
+		testBounds = TestFixture::createBounds(-2, -2, 0, 0, 0, 0);
+		EXPECT_EQ(1U, dsBVH_intersectBounds(
+			bvh, &testBounds, fixture->lambdaAdapter(testFunc), &testFunc));
+	}
+
+	{
+		auto testFunc = [](const TestObject& object)
+		{
+			EXPECT_EQ(1, object.data);
+		};
+		testBounds = TestFixture::createBounds(0, -2, 0, 2, 0, 0);
+		EXPECT_EQ(1U, dsBVH_intersectBounds(
+			bvh, &testBounds, fixture->lambdaAdapter(testFunc), &testFunc));
+	}
+
+	{
+		auto testFunc = [](const TestObject& object)
+		{
+			EXPECT_EQ(2, object.data);
+		};
+		testBounds = TestFixture::createBounds(-2, 0, 0, 0, 2, 0);
+		EXPECT_EQ(1U, dsBVH_intersectBounds(
+			bvh, &testBounds, fixture->lambdaAdapter(testFunc), &testFunc));
+	}
+
+	{
+		auto testFunc = [](const TestObject& object)
+		{
+			EXPECT_EQ(3, object.data);
+		};
+		testBounds = TestFixture::createBounds(0, 0, 0, 2, 2, 0);
+		EXPECT_EQ(1U, dsBVH_intersectBounds(
+			bvh, &testBounds, fixture->lambdaAdapter(testFunc), &testFunc));
+	}
+
+	testBounds = TestFixture::createBounds(-1, -1, 0, 1, 1, 0);
+	EXPECT_EQ(4U, dsBVH_intersectBounds(bvh, &testBounds, nullptr, nullptr));
+
+	std::pair<int, int> visitCounts = {0, 1};
+	EXPECT_EQ(1U, dsBVH_intersectBounds(
+		bvh, &testBounds, &TestFixture::limitedVisits, &visitCounts));
+
+	visitCounts = {0, 2};
+	EXPECT_EQ(2U, dsBVH_intersectBounds(
+		bvh, &testBounds, &TestFixture::limitedVisits, &visitCounts));
+
+	visitCounts = {0, 3};
+	EXPECT_EQ(3U, dsBVH_intersectBounds(
+		bvh, &testBounds, &TestFixture::limitedVisits, &visitCounts));
+
+	AlignedBoxType bounds;
+	EXPECT_TRUE(dsBVH_getBounds(&bounds, bvh));
+	AlignedBoxType fullBounds = TestFixture::createBounds(-2, -2, 0, 2, 2, 0);
+	EXPECT_TRUE(TestFixture::boundsEqual(fullBounds, bounds));
+
+	dsBVH_destroy(bvh);
+}
+
 TYPED_TEST(BVHTest, OverlappingBoxes)
 {
 	using TestObject = typename TestFixture::TestObject;
@@ -1263,3 +1503,434 @@ TYPED_TEST(BVHTest, Update)
 
 	dsBVH_destroy(bvh);
 }
+
+TYPED_TEST(BVHTest, RandomBoxesSAH)
+{
+	using TestObject = typename TestFixture::TestObject;
+	using IntBounds = typename TestFixture::IntBounds;
+
+	TestFixture* fixture = this;
+	auto baseAllocator = reinterpret_cast<dsAllocator*>(&fixture->allocator);
+	dsThreadPool* threadPool = dsThreadPool_create(baseAllocator, 3, dsThreadPoolFlags_None, 0,
+		nullptr, nullptr, nullptr);
+	ASSERT_TRUE(threadPool);
+
+	dsBVH* bvh = dsBVH_create(
+		baseAllocator, TestFixture::axisCount(), TestFixture::element(), nullptr);
+	ASSERT_TRUE(bvh);
+
+	std::mt19937 random(12345);
+	std::vector<TestObject> data(2000);
+	std::vector<IntBounds> intBounds;
+	TestFixture::setRandomObjects(data, intBounds, random);
+
+	for (unsigned int threaded = 0; threaded < 2; ++threaded)
+	{
+		EXPECT_TRUE(dsBVH_buildSAH(bvh, data.data(), (uint32_t)data.size(), sizeof(TestObject),
+			&TestFixture::getBounds, threaded ? threadPool : nullptr));
+		TestFixture::checkRandomQueries(bvh, intBounds);
+	}
+
+	dsBVH_destroy(bvh);
+	EXPECT_TRUE(dsThreadPool_destroy(threadPool));
+}
+
+TYPED_TEST(BVHTest, InsertRemove)
+{
+	using TestObject = typename TestFixture::TestObject;
+	using AlignedBoxType = typename TestFixture::AlignedBoxType;
+
+	TestFixture* fixture = this;
+	dsBVH* bvh = dsBVH_create((dsAllocator*)&fixture->allocator, TestFixture::axisCount(),
+		TestFixture::element(), NULL);
+	ASSERT_TRUE(bvh);
+
+	TestObject data[] =
+	{
+		{TestFixture::createBounds(-2, -2, 0, -1, -1, 0), 0},
+		{TestFixture::createBounds( 1, -2, 0,  2, -1, 0), 1},
+		{TestFixture::createBounds(-2,  1, 0, -1,  2, 0), 2},
+		{TestFixture::createBounds( 1,  1, 0,  2,  2, 0), 3}
+	};
+
+	errno = 0;
+	EXPECT_FALSE(dsBVH_insert(bvh, data, nullptr));
+	EXPECT_EQ(EINVAL, errno);
+
+	errno = 0;
+	EXPECT_FALSE(dsBVH_remove(bvh, data));
+	EXPECT_EQ(ENOTFOUND, errno);
+
+	for (TestObject& object : data)
+		EXPECT_TRUE(dsBVH_insert(bvh, &object, &TestFixture::getBounds));
+	EXPECT_FALSE(dsBVH_empty(bvh));
+
+	errno = 0;
+	EXPECT_FALSE(dsBVH_insert(bvh, data, &TestFixture::getBoundsIndex));
+	EXPECT_EQ(EINVAL, errno);
+
+	AlignedBoxType testBounds = TestFixture::createBounds(-1, -1, 0, 1, 1, 0);
+	EXPECT_EQ(4U, dsBVH_intersectBounds(bvh, &testBounds, nullptr, nullptr));
+
+	{
+		auto testFunc = [](const TestObject& object)
+		{
+			EXPECT_EQ(1, object.data);
+		};
+		testBounds = TestFixture::createBounds(0, -2, 0, 2, 0, 0);
+		EXPECT_EQ(1U, dsBVH_intersectBounds(
+			bvh, &testBounds, fixture->lambdaAdapter(testFunc), &testFunc));
+	}
+
+	EXPECT_TRUE(dsBVH_remove(bvh, data + 1));
+	errno = 0;
+	EXPECT_FALSE(dsBVH_remove(bvh, data + 1));
+	EXPECT_EQ(ENOTFOUND, errno);
+
+	EXPECT_EQ(0U, dsBVH_intersectBounds(bvh, &testBounds, nullptr, nullptr));
+	testBounds = TestFixture::createBounds(-1, -1, 0, 1, 1, 0);
+	EXPECT_EQ(3U, dsBVH_intersectBounds(bvh, &testBounds, nullptr, nullptr));
+
+	// Moved objects should still be found.
+	data[0].bounds = TestFixture::createBounds(5, 5, 0, 6, 6, 0);
+	EXPECT_TRUE(dsBVH_remove(bvh, data));
+	EXPECT_EQ(2U, dsBVH_intersectBounds(bvh, &testBounds, nullptr, nullptr));
+
+	AlignedBoxType bounds;
+	EXPECT_TRUE(dsBVH_getBounds(&bounds, bvh));
+	AlignedBoxType expectedBounds = TestFixture::createBounds(-2, 1, 0, 2, 2, 0);
+	EXPECT_TRUE(TestFixture::boundsEqual(expectedBounds, bounds));
+
+	EXPECT_TRUE(dsBVH_remove(bvh, data + 2));
+	EXPECT_TRUE(dsBVH_remove(bvh, data + 3));
+	EXPECT_TRUE(dsBVH_empty(bvh));
+
+	EXPECT_TRUE(dsBVH_insert(bvh, data + 2, &TestFixture::getBounds));
+	EXPECT_EQ(1U, dsBVH_intersectBounds(bvh, &testBounds, nullptr, nullptr));
+
+	dsBVH_destroy(bvh);
+}
+
+TYPED_TEST(BVHTest, RandomInsertRemove)
+{
+	using TestObject = typename TestFixture::TestObject;
+	using IntBounds = typename TestFixture::IntBounds;
+
+	TestFixture* fixture = this;
+	dsBVH* bvh = dsBVH_create((dsAllocator*)&fixture->allocator, TestFixture::axisCount(),
+		TestFixture::element(), NULL);
+	ASSERT_TRUE(bvh);
+
+	std::mt19937 random(12345);
+	std::vector<TestObject> data(1000);
+	std::vector<IntBounds> intBounds;
+	TestFixture::setRandomObjects(data, intBounds, random);
+
+	// Build with half the objects and insert the rest.
+	std::vector<bool> present(data.size(), false);
+	EXPECT_TRUE(dsBVH_buildSAH(bvh, data.data(), (uint32_t)data.size()/2, sizeof(TestObject),
+		&TestFixture::getBounds, nullptr));
+	for (size_t i = 0; i < data.size(); ++i)
+	{
+		if (i >= data.size()/2)
+		{
+			EXPECT_TRUE(dsBVH_insert(bvh, &data[i], &TestFixture::getBounds));
+		}
+		present[i] = true;
+	}
+	TestFixture::checkRandomQueries(bvh, intBounds, &present);
+
+	for (size_t i = 0; i < data.size(); i += 3)
+	{
+		EXPECT_TRUE(dsBVH_remove(bvh, &data[i]));
+		present[i] = false;
+	}
+	TestFixture::checkRandomQueries(bvh, intBounds, &present);
+
+	// Re-insert objects to re-use the removed nodes.
+	for (size_t i = 0; i < data.size(); i += 6)
+	{
+		EXPECT_TRUE(dsBVH_insert(bvh, &data[i], &TestFixture::getBounds));
+		present[i] = true;
+	}
+	TestFixture::checkRandomQueries(bvh, intBounds, &present);
+
+	dsBVH_destroy(bvh);
+}
+
+TYPED_TEST(BVHTest, UpdateIncremental)
+{
+	using TestObject = typename TestFixture::TestObject;
+	using IntBounds = typename TestFixture::IntBounds;
+
+	TestFixture* fixture = this;
+	auto baseAllocator = reinterpret_cast<dsAllocator*>(&fixture->allocator);
+	dsThreadPool* threadPool = dsThreadPool_create(baseAllocator, 3, dsThreadPoolFlags_None, 0,
+		nullptr, nullptr, nullptr);
+	ASSERT_TRUE(threadPool);
+
+	dsBVH* bvh = dsBVH_create(
+		baseAllocator, TestFixture::axisCount(), TestFixture::element(), nullptr);
+	ASSERT_TRUE(bvh);
+
+	errno = 0;
+	EXPECT_FALSE(dsBVH_updateIncremental(nullptr, nullptr));
+	EXPECT_EQ(EINVAL, errno);
+	EXPECT_TRUE(dsBVH_updateIncremental(bvh, nullptr));
+
+	std::mt19937 random(12345);
+	std::vector<TestObject> data(2000);
+	std::vector<IntBounds> intBounds;
+	TestFixture::setRandomObjects(data, intBounds, random);
+
+	for (unsigned int threaded = 0; threaded < 2; ++threaded)
+	{
+		EXPECT_TRUE(dsBVH_buildSAH(bvh, data.data(), (uint32_t)data.size(), sizeof(TestObject),
+			&TestFixture::getBounds, nullptr));
+
+		// Move the objects multiple times to force rotations throughout the tree.
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			TestFixture::setRandomObjects(data, intBounds, random);
+			EXPECT_TRUE(dsBVH_updateIncremental(bvh, threaded ? threadPool : nullptr));
+			TestFixture::checkRandomQueries(bvh, intBounds);
+		}
+	}
+
+	dsBVH_destroy(bvh);
+	EXPECT_TRUE(dsThreadPool_destroy(threadPool));
+}
+
+TYPED_TEST(BVHTest, RandomFrustums)
+{
+	using TestObject = typename TestFixture::TestObject;
+	using IntBounds = typename TestFixture::IntBounds;
+	using FrustumType = typename TestFixture::FrustumType;
+
+	TestFixture* fixture = this;
+	dsBVH* bvh = dsBVH_create((dsAllocator*)&fixture->allocator, TestFixture::axisCount(),
+		TestFixture::element(), NULL);
+	ASSERT_TRUE(bvh);
+
+	std::mt19937 random(12345);
+	std::vector<TestObject> data(2000);
+	std::vector<IntBounds> intBounds;
+	TestFixture::setRandomObjects(data, intBounds, random);
+	EXPECT_TRUE(dsBVH_buildSAH(bvh, data.data(), (uint32_t)data.size(), sizeof(TestObject),
+		&TestFixture::getBounds, nullptr));
+
+	std::vector<FrustumType> frustums;
+	for (unsigned int i = 0; i < 100; ++i)
+	{
+		// Avoid degenerate frustums with zero size.
+		IntBounds queryBounds = TestFixture::randomBounds(random, 400);
+		frustums.push_back(TestFixture::createFrustum((float)queryBounds.min[0],
+			(float)queryBounds.min[1], (float)queryBounds.min[2], (float)queryBounds.max[0] + 1,
+			(float)queryBounds.max[1] + 1, (float)queryBounds.max[2] + 1));
+	}
+
+	std::vector<std::vector<int>> builtResults;
+	for (const FrustumType& frustum : frustums)
+	{
+		builtResults.push_back(TestFixture::intersectFrustum(bvh, frustum));
+		TestFixture::checkFrustumResults(frustum, intBounds, builtResults.back());
+	}
+
+	// Inserting and removing an object will traverse the binary nodes until the next update. The
+	// results after building may be more precise for boxes with zero size along a plane normal, but
+	// must never miss objects.
+	TestObject extraObject = {TestFixture::createBounds(0, 0, 0, 1, 1, 1), -1};
+	EXPECT_TRUE(dsBVH_insert(bvh, &extraObject, &TestFixture::getBounds));
+	EXPECT_TRUE(dsBVH_remove(bvh, &extraObject));
+	for (size_t i = 0; i < frustums.size(); ++i)
+	{
+		std::vector<int> results = TestFixture::intersectFrustum(bvh, frustums[i]);
+		TestFixture::checkFrustumResults(frustums[i], intBounds, results);
+		EXPECT_TRUE(std::includes(results.begin(), results.end(), builtResults[i].begin(),
+			builtResults[i].end()));
+	}
+
+	EXPECT_TRUE(dsBVH_update(bvh));
+	for (size_t i = 0; i < frustums.size(); ++i)
+		EXPECT_EQ(builtResults[i], TestFixture::intersectFrustum(bvh, frustums[i]));
+
+	dsBVH_destroy(bvh);
+}
+
+#if DS_PERFORMANCE_TESTS
+static bool getPerformanceBounds(void* outBounds, const dsBVH*, const void* object)
+{
+	*(dsAlignedBox3f*)outBounds = *(const dsAlignedBox3f*)object;
+	return true;
+}
+
+TEST(BVHPerformanceTest, BuildAndQuery)
+{
+	dsSystemAllocator allocator;
+	ASSERT_TRUE(dsSystemAllocator_initialize(&allocator, DS_ALLOCATOR_NO_LIMIT));
+	auto baseAllocator = reinterpret_cast<dsAllocator*>(&allocator);
+	dsThreadPool* threadPool = dsThreadPool_create(baseAllocator,
+		dsThreadPool_defaultThreadCount(), dsThreadPoolFlags_None, 0, nullptr, nullptr, nullptr);
+	ASSERT_TRUE(threadPool);
+
+	dsBVH* bvh = dsBVH_create(baseAllocator, 3, dsGeometryElement_Float, nullptr);
+	ASSERT_TRUE(bvh);
+
+	// Clustered objects with varying sizes to resemble a typical scene.
+	constexpr unsigned int objectCount = 100000;
+	constexpr unsigned int clusterCount = 64;
+	std::mt19937 random(12345);
+	std::uniform_real_distribution<float> positionDistribution(-1000.0f, 1000.0f);
+	std::normal_distribution<float> offsetDistribution(0.0f, 25.0f);
+	std::exponential_distribution<float> sizeDistribution(0.5f);
+	std::vector<dsVector3f> clusters(clusterCount);
+	for (dsVector3f& cluster : clusters)
+	{
+		cluster.x = positionDistribution(random);
+		cluster.y = positionDistribution(random);
+		cluster.z = positionDistribution(random);
+	}
+
+	std::vector<dsAlignedBox3f> objects(objectCount);
+	for (unsigned int i = 0; i < objectCount; ++i)
+	{
+		const dsVector3f& cluster = clusters[i % clusterCount];
+		dsAlignedBox3f& bounds = objects[i];
+		bounds.min.x = cluster.x + offsetDistribution(random);
+		bounds.min.y = cluster.y + offsetDistribution(random);
+		bounds.min.z = cluster.z + offsetDistribution(random);
+		float size = sizeDistribution(random);
+		bounds.max.x = bounds.min.x + size;
+		bounds.max.y = bounds.min.y + size;
+		bounds.max.z = bounds.min.z + size;
+	}
+
+	constexpr unsigned int queryCount = 10000;
+	std::vector<dsAlignedBox3f> queries(queryCount);
+	for (unsigned int i = 0; i < queryCount; ++i)
+	{
+		const dsVector3f& cluster = clusters[i % clusterCount];
+		dsAlignedBox3f& bounds = queries[i];
+		bounds.min.x = cluster.x + offsetDistribution(random);
+		bounds.min.y = cluster.y + offsetDistribution(random);
+		bounds.min.z = cluster.z + offsetDistribution(random);
+		bounds.max.x = bounds.min.x + 10.0f;
+		bounds.max.y = bounds.min.y + 10.0f;
+		bounds.max.z = bounds.min.z + 10.0f;
+	}
+
+	std::vector<dsFrustum3f> frustums(queryCount);
+	for (unsigned int i = 0; i < queryCount; ++i)
+	{
+		const dsAlignedBox3f& bounds = queries[i];
+		dsMatrix44f matrix;
+		dsMatrix44f_makeOrtho(&matrix, bounds.min.x - 40.0f, bounds.max.x + 40.0f,
+			bounds.min.y - 40.0f, bounds.max.y + 40.0f, -bounds.max.z - 40.0f,
+			-bounds.min.z + 40.0f, dsProjectionMatrixOptions_None);
+		dsFrustum3f_fromMatrix(&frustums[i], &matrix, dsProjectionMatrixOptions_None);
+	}
+
+	const char* modeNames[] = {"Unbalanced", "Balanced", "SAH", "Threaded SAH"};
+	dsTimer timer = dsTimer_create();
+	constexpr unsigned int iterations = 10;
+	for (unsigned int mode = 0; mode < DS_ARRAY_SIZE(modeNames); ++mode)
+	{
+		uint64_t start = dsTimer_currentTicks();
+		for (unsigned int i = 0; i < iterations; ++i)
+		{
+			switch (mode)
+			{
+				case 0:
+				case 1:
+					EXPECT_TRUE(dsBVH_build(bvh, objects.data(), objectCount,
+						sizeof(dsAlignedBox3f), &getPerformanceBounds, mode == 1));
+					break;
+				default:
+					EXPECT_TRUE(dsBVH_buildSAH(bvh, objects.data(), objectCount,
+						sizeof(dsAlignedBox3f), &getPerformanceBounds, mode == 3 ? threadPool :
+						nullptr));
+					break;
+			}
+		}
+		double buildTime = dsTimer_ticksToSeconds(timer, dsTimer_currentTicks() - start)/
+			iterations;
+
+		printf("%s: build %g ms\n", modeNames[mode], buildTime*1000.0);
+
+		// Inserting and removing an object falls back to the binary nodes until the next update.
+		const char* layoutNames[] = {"wide nodes", "binary nodes"};
+		for (unsigned int layout = 0; layout < DS_ARRAY_SIZE(layoutNames); ++layout)
+		{
+			if (layout == 1)
+			{
+				dsAlignedBox3f extraObject = objects[0];
+				EXPECT_TRUE(dsBVH_insert(bvh, &extraObject, &getPerformanceBounds));
+				EXPECT_TRUE(dsBVH_remove(bvh, &extraObject));
+			}
+
+			uint64_t hitCount = 0;
+			start = dsTimer_currentTicks();
+			for (const dsAlignedBox3f& query : queries)
+				hitCount += dsBVH_intersectBounds(bvh, &query, nullptr, nullptr);
+			double queryTime = dsTimer_ticksToSeconds(timer, dsTimer_currentTicks() - start);
+
+			uint64_t frustumHitCount = 0;
+			start = dsTimer_currentTicks();
+			for (const dsFrustum3f& frustum : frustums)
+				frustumHitCount += dsBVH_intersectFrustum(bvh, &frustum, nullptr, nullptr);
+			double frustumTime = dsTimer_ticksToSeconds(timer, dsTimer_currentTicks() - start);
+
+			printf("  %s: %u bounds queries %g ms (%llu hits), %u frustum queries %g ms "
+				"(%llu hits)\n", layoutNames[layout], queryCount, queryTime*1000.0,
+				(unsigned long long)hitCount, queryCount, frustumTime*1000.0,
+				(unsigned long long)frustumHitCount);
+		}
+	}
+
+	// Compare incrementally updating against re-building after moving the objects.
+	std::uniform_real_distribution<float> moveDistribution(-5.0f, 5.0f);
+	const char* updateNames[] = {"SAH re-build", "Incremental update",
+		"Threaded incremental update"};
+	for (unsigned int mode = 0; mode < DS_ARRAY_SIZE(updateNames); ++mode)
+	{
+		EXPECT_TRUE(dsBVH_buildSAH(bvh, objects.data(), objectCount, sizeof(dsAlignedBox3f),
+			&getPerformanceBounds, nullptr));
+
+		double updateTime = 0.0;
+		for (unsigned int i = 0; i < iterations; ++i)
+		{
+			for (dsAlignedBox3f& bounds : objects)
+			{
+				dsVector3f offset = {{moveDistribution(random), moveDistribution(random),
+					moveDistribution(random)}};
+				dsVector3_add(bounds.min, bounds.min, offset);
+				dsVector3_add(bounds.max, bounds.max, offset);
+			}
+
+			uint64_t start = dsTimer_currentTicks();
+			if (mode == 0)
+			{
+				EXPECT_TRUE(dsBVH_buildSAH(bvh, objects.data(), objectCount,
+					sizeof(dsAlignedBox3f), &getPerformanceBounds, nullptr));
+			}
+			else
+				EXPECT_TRUE(dsBVH_updateIncremental(bvh, mode == 2 ? threadPool : nullptr));
+			updateTime += dsTimer_ticksToSeconds(timer, dsTimer_currentTicks() - start);
+		}
+
+		uint64_t hitCount = 0;
+		uint64_t start = dsTimer_currentTicks();
+		for (const dsAlignedBox3f& query : queries)
+			hitCount += dsBVH_intersectBounds(bvh, &query, nullptr, nullptr);
+		double queryTime = dsTimer_ticksToSeconds(timer, dsTimer_currentTicks() - start);
+
+		printf("%s: update %g ms, %u queries %g ms (%llu hits)\n", updateNames[mode],
+			updateTime*1000.0/iterations, queryCount, queryTime*1000.0,
+			(unsigned long long)hitCount);
+	}
+
+	dsBVH_destroy(bvh);
+	EXPECT_TRUE(dsThreadPool_destroy(threadPool));
+	EXPECT_EQ(0U, baseAllocator->size);
+}
+#endif // DS_PERFORMANCE_TESTS
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <DeepSea/Core/Timer.h>
+
 #include <DeepSea/Geometry/AlignedBox3x.h>
 #include <DeepSea/Geometry/Frustum3.h>
 #include <DeepSea/Geometry/OrientedBox3x.h>
@@ -24,6 +26,11 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#define DS_PERFORMANCE_TESTS 0
 
 // Handle older versions of gtest.
 #ifndef TYPED_TEST_SUITE
@@ -1806,6 +1813,103 @@ TYPED_TEST(Frustum3Test, IntersectSphere3x)
 	EXPECT_EQ(dsIntersectResult_Intersects, dsFrustum3_intersectSphere3x(&frustum, &center, radius));
 }
 
+typedef void (*AlignedBoxesArrayFunction)(dsIntersectResult* results,
+	const dsFrustum3f* frustum, const dsAlignedBox3f* boxes, uint32_t boxCount);
+
+static bool referenceIntersectAlignedBox(dsIntersectResult& result, const dsFrustum3f& frustum,
+	const dsAlignedBox3f& box)
+{
+	bool intersects = false;
+	result = dsIntersectResult_Inside;
+	int count = dsFrustum3f_isInfinite(&frustum) ? dsFrustumPlanes_Far : dsFrustumPlanes_Count;
+	for (int i = 0; i < count; ++i)
+	{
+		// Skip boxes that are too close to a plane to reliably compare.
+		const dsPlane3f& plane = frustum.planes[i];
+		float dist = plane.n.x*(box.min.x + box.max.x)*0.5f +
+			plane.n.y*(box.min.y + box.max.y)*0.5f + plane.n.z*(box.min.z + box.max.z)*0.5f +
+			plane.d;
+		float radius = fabsf(plane.n.x)*(box.max.x - box.min.x)*0.5f +
+			fabsf(plane.n.y)*(box.max.y - box.min.y)*0.5f +
+			fabsf(plane.n.z)*(box.max.z - box.min.z)*0.5f;
+		if (fabsf(dist - radius) < 1e-3f || fabsf(dist + radius) < 1e-3f)
+			return false;
+
+		dsIntersectResult planeResult = dsPlane3f_intersectAlignedBox(&plane, &box);
+		if (planeResult == dsIntersectResult_Outside)
+		{
+			result = dsIntersectResult_Outside;
+			return true;
+		}
+		else if (planeResult == dsIntersectResult_Intersects)
+			intersects = true;
+	}
+
+	if (intersects)
+		result = dsIntersectResult_Intersects;
+	return true;
+}
+
+static void createArrayBoxes(std::vector<dsAlignedBox3f>& boxes, unsigned int count)
+{
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> xyDistribution(-30.0f, 30.0f);
+	std::uniform_real_distribution<float> zDistribution(-70.0f, 10.0f);
+	std::uniform_real_distribution<float> sizeDistribution(0.1f, 8.0f);
+	boxes.resize(count);
+	for (dsAlignedBox3f& box : boxes)
+	{
+		box.min.x = xyDistribution(random);
+		box.min.y = xyDistribution(random);
+		box.min.z = zDistribution(random);
+		box.max.x = box.min.x + sizeDistribution(random);
+		box.max.y = box.min.y + sizeDistribution(random);
+		box.max.z = box.min.z + sizeDistribution(random);
+	}
+}
+
+static void testIntersectAlignedBoxesArray(AlignedBoxesArrayFunction function)
+{
+	// Odd count to test the remainder for implementations that process multiple elements.
+	const unsigned int count = 1001;
+	std::vector<dsAlignedBox3f> boxes;
+	createArrayBoxes(boxes, count);
+	std::vector<dsIntersectResult> results(count);
+
+	const float farPlanes[] = {50.0f, INFINITY};
+	for (float farPlane : farPlanes)
+	{
+		dsMatrix44f matrix;
+		dsMatrix44f_makePerspective(&matrix, 1.2f, 1.5f, 1.0f, farPlane,
+			dsProjectionMatrixOptions_None);
+
+		dsFrustum3f frustum;
+		dsFrustum3_fromMatrix(frustum, matrix, dsProjectionMatrixOptions_None);
+		dsFrustum3f_normalize(&frustum);
+
+		function(results.data(), &frustum, boxes.data(), count);
+		unsigned int resultCounts[3] = {};
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			dsIntersectResult expectedResult;
+			if (!referenceIntersectAlignedBox(expectedResult, frustum, boxes[i]))
+				continue;
+
+			EXPECT_EQ(expectedResult, results[i]) << "box " << i;
+			++resultCounts[expectedResult];
+		}
+
+		EXPECT_LT(0U, resultCounts[dsIntersectResult_Outside]);
+		EXPECT_LT(0U, resultCounts[dsIntersectResult_Intersects]);
+		EXPECT_LT(0U, resultCounts[dsIntersectResult_Inside]);
+	}
+}
+
+TEST(Frustum3fTest, IntersectAlignedBoxesArray)
+{
+	testIntersectAlignedBoxesArray(&dsFrustum3f_intersectAlignedBoxesArray);
+}
+
 #if DS_HAS_SIMD
 
 TEST(Frustum3fTest, IntersectAlignedBoxSIMD)
@@ -3491,4 +3595,105 @@ TEST(Frustum3dTest, IntersectSphereSIMD4)
 		dsIntersectResult_Intersects, dsFrustum3d_intersectSphereSIMD4(&frustum, &center, radius));
 }
 
+
+TEST(Frustum3fTest, IntersectAlignedBoxesArraySIMD)
+{
+	if (!(dsHostSIMDFeatures & dsSIMDFeatures_Float4))
+		return;
+
+	testIntersectAlignedBoxesArray(&dsFrustum3f_intersectAlignedBoxesArraySIMD);
+}
+
+TEST(Frustum3fTest, IntersectAlignedBoxesArraySIMD8)
+{
+	if (!(dsHostSIMDFeatures & dsSIMDFeatures_Float8))
+		return;
+
+	testIntersectAlignedBoxesArray(&dsFrustum3f_intersectAlignedBoxesArraySIMD8);
+}
+
+#if !DS_DETERMINISTIC_MATH
+TEST(Frustum3fTest, IntersectAlignedBoxesArrayFMA)
+{
+	if (!(dsHostSIMDFeatures & dsSIMDFeatures_FMA))
+		return;
+
+	testIntersectAlignedBoxesArray(&dsFrustum3f_intersectAlignedBoxesArrayFMA);
+}
+
+TEST(Frustum3fTest, IntersectAlignedBoxesArrayFMA8)
+{
+	const dsSIMDFeatures requiredFeatures = dsSIMDFeatures_FMA | dsSIMDFeatures_Float8;
+	if ((dsHostSIMDFeatures & requiredFeatures) != requiredFeatures)
+		return;
+
+	testIntersectAlignedBoxesArray(&dsFrustum3f_intersectAlignedBoxesArrayFMA8);
+}
+#endif // !DS_DETERMINISTIC_MATH
+
 #endif // DS_HAS_SIMD
+
+#if DS_PERFORMANCE_TESTS
+static void timeIntersectAlignedBoxesArray(const char* name, AlignedBoxesArrayFunction function,
+	dsIntersectResult* results, const dsFrustum3f* frustum, const dsAlignedBox3f* boxes,
+	uint32_t count, dsTimer timer)
+{
+	const unsigned int iterations = 20;
+	uint64_t start = dsTimer_currentTicks();
+	for (unsigned int i = 0; i < iterations; ++i)
+		function(results, frustum, boxes, count);
+	uint64_t end = dsTimer_currentTicks();
+	printf("%s: %f Melements/s\n", name,
+		(double)count*iterations/dsTimer_ticksToSeconds(timer, end - start)*1e-6);
+}
+
+static void scalarIntersectAlignedBoxesArray(dsIntersectResult* results,
+	const dsFrustum3f* frustum, const dsAlignedBox3f* boxes, uint32_t boxCount)
+{
+	for (uint32_t i = 0; i < boxCount; ++i)
+		results[i] = dsFrustum3f_intersectAlignedBox(frustum, boxes + i);
+}
+
+TEST(Frustum3fPerformanceTest, IntersectAlignedBoxesArray)
+{
+	const uint32_t count = 100000;
+	dsTimer timer = dsTimer_create();
+	std::vector<dsAlignedBox3f> boxes;
+	createArrayBoxes(boxes, count);
+	std::vector<dsIntersectResult> results(count);
+
+	dsMatrix44f matrix;
+	dsMatrix44f_makePerspective(&matrix, 1.2f, 1.5f, 1.0f, 50.0f, dsProjectionMatrixOptions_None);
+	dsFrustum3f frustum;
+	dsFrustum3_fromMatrix(frustum, matrix, dsProjectionMatrixOptions_None);
+	dsFrustum3f_normalize(&frustum);
+
+	timeIntersectAlignedBoxesArray("scalar", &scalarIntersectAlignedBoxesArray, results.data(),
+		&frustum, boxes.data(), count, timer);
+#if DS_HAS_SIMD
+	if (dsHostSIMDFeatures & dsSIMDFeatures_Float4)
+	{
+		timeIntersectAlignedBoxesArray("SIMD", &dsFrustum3f_intersectAlignedBoxesArraySIMD,
+			results.data(), &frustum, boxes.data(), count, timer);
+	}
+	if (dsHostSIMDFeatures & dsSIMDFeatures_Float8)
+	{
+		timeIntersectAlignedBoxesArray("SIMD8", &dsFrustum3f_intersectAlignedBoxesArraySIMD8,
+			results.data(), &frustum, boxes.data(), count, timer);
+	}
+#if !DS_DETERMINISTIC_MATH
+	if (dsHostSIMDFeatures & dsSIMDFeatures_FMA)
+	{
+		timeIntersectAlignedBoxesArray("FMA", &dsFrustum3f_intersectAlignedBoxesArrayFMA,
+			results.data(), &frustum, boxes.data(), count, timer);
+	}
+	if ((dsHostSIMDFeatures & dsSIMDFeatures_FMA) &&
+		(dsHostSIMDFeatures & dsSIMDFeatures_Float8))
+	{
+		timeIntersectAlignedBoxesArray("FMA8", &dsFrustum3f_intersectAlignedBoxesArrayFMA8,
+			results.data(), &frustum, boxes.data(), count, timer);
+	}
+#endif
+#endif
+}
+#endif // DS_PERFORMANCE_TESTS
@@ -579,6 +579,51 @@ DS_MATH_EXPORT void dsMatrix44f_makePerspective(dsMatrix44f* result, float fovy,
 DS_MATH_EXPORT void dsMatrix44d_makePerspective(dsMatrix44d* result, double fovy, double aspect,
 	double near, double far, dsProjectionMatrixOptions options);
 
+/**
+ * @brief Multiplies a matrix with an array of matrices.
+ *
+ * This is the same as calling dsMatrix44f_mul() with a and each element of b, but will use the
+ * fastest SIMD implementation available on the host CPU and avoids per-element overhead.
+ *
+ * @param[out] results The results of a*b[i] for each element. This may be the same array as b, but
+ *     must not otherwise overlap with a or b.
+ * @param a The matrix on the left side of each multiplication.
+ * @param b The array of matrices on the right side of each multiplication.
+ * @param count The number of matrices in results and b.
+ */
+DS_MATH_EXPORT void dsMatrix44f_mulArray(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count);
+
+/**
+ * @brief Multiplies an affine matrix with an array of affine matrices.
+ *
+ * This is the same as calling dsMatrix44f_affineMul() with a and each element of b, but will use
+ * the fastest SIMD implementation available on the host CPU and avoids per-element overhead.
+ *
+ * @param[out] results The results of a*b[i] for each element. This may be the same array as b, but
+ *     must not otherwise overlap with a or b.
+ * @param a The matrix on the left side of each multiplication.
+ * @param b The array of matrices on the right side of each multiplication.
+ * @param count The number of matrices in results and b.
+ */
+DS_MATH_EXPORT void dsMatrix44f_affineMulArray(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count);
+
+/**
+ * @brief Transforms an array of points by an affine matrix.
+ *
+ * Each point is treated as having a W value of 1. This will use the fastest SIMD implementation
+ * available on the host CPU.
+ *
+ * @param[out] results The transformed points. This may be the same array as points, but must not
+ *     otherwise overlap with it.
+ * @param mat The matrix to transform with.
+ * @param points The points to transform.
+ * @param count The number of points in results and points.
+ */
+DS_MATH_EXPORT void dsMatrix44f_transformPointsArray(
+	dsVector3xf* results, const dsMatrix44f* mat, const dsVector3xf* points, uint32_t count);
+
 /**
  * @brief Extracts eigenvalues for a symmetric matrix using Jacobi iteration.
  * @param[out] outEigenvectors The resulting eigenvectors.
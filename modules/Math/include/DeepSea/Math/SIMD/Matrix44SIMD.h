@@ -672,6 +672,152 @@ DS_MATH_EXPORT inline void dsMatrix44d_composeTransformSIMD4(dsMatrix44d* DS_ALI
 	const dsVector3xd* DS_ALIGN_PARAM(32) position, const dsQuaternion4d* orientation,
 	const dsVector3xd* DS_ALIGN_PARAM(32) scale);
 
+/**
+ * @brief Multiplies a matrix with an array of matrices.
+ * @remark This can be used when dsSIMDFeatures_Float4 is available.
+ * @param[out] results The results of a*b[i] for each element. This may be the same array as b, but
+ *     must not otherwise overlap with a or b.
+ * @param a The matrix on the left side of each multiplication.
+ * @param b The array of matrices on the right side of each multiplication.
+ * @param count The number of matrices in results and b.
+ */
+DS_MATH_EXPORT void dsMatrix44f_mulArraySIMD(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count);
+
+/**
+ * @brief Multiplies an affine matrix with an array of affine matrices.
+ * @remark This can be used when dsSIMDFeatures_Float4 is available.
+ * @param[out] results The results of a*b[i] for each element. This may be the same array as b, but
+ *     must not otherwise overlap with a or b.
+ * @param a The matrix on the left side of each multiplication.
+ * @param b The array of matrices on the right side of each multiplication.
+ * @param count The number of matrices in results and b.
+ */
+DS_MATH_EXPORT void dsMatrix44f_affineMulArraySIMD(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count);
+
+/**
+ * @brief Transforms an array of points by an affine matrix.
+ * @remark This can be used when dsSIMDFeatures_Float4 is available.
+ * @param[out] results The transformed points. This may be the same array as points, but must not
+ *     otherwise overlap with it.
+ * @param mat The matrix to transform with.
+ * @param points The points to transform.
+ * @param count The number of points in results and points.
+ */
+DS_MATH_EXPORT void dsMatrix44f_transformPointsArraySIMD(
+	dsVector3xf* results, const dsMatrix44f* mat, const dsVector3xf* points, uint32_t count);
+
+/**
+ * @brief Multiplies a matrix with an array of matrices.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param[out] results The results of a*b[i] for each element. This may be the same array as b, but
+ *     must not otherwise overlap with a or b.
+ * @param a The matrix on the left side of each multiplication.
+ * @param b The array of matrices on the right side of each multiplication.
+ * @param count The number of matrices in results and b.
+ */
+DS_MATH_EXPORT void dsMatrix44f_mulArraySIMD8(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count);
+
+/**
+ * @brief Multiplies an affine matrix with an array of affine matrices.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param[out] results The results of a*b[i] for each element. This may be the same array as b, but
+ *     must not otherwise overlap with a or b.
+ * @param a The matrix on the left side of each multiplication.
+ * @param b The array of matrices on the right side of each multiplication.
+ * @param count The number of matrices in results and b.
+ */
+DS_MATH_EXPORT void dsMatrix44f_affineMulArraySIMD8(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count);
+
+/**
+ * @brief Transforms an array of points by an affine matrix.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param[out] results The transformed points. This may be the same array as points, but must not
+ *     otherwise overlap with it.
+ * @param mat The matrix to transform with.
+ * @param points The points to transform.
+ * @param count The number of points in results and points.
+ */
+DS_MATH_EXPORT void dsMatrix44f_transformPointsArraySIMD8(
+	dsVector3xf* results, const dsMatrix44f* mat, const dsVector3xf* points, uint32_t count);
+
+#if !DS_DETERMINISTIC_MATH
+/**
+ * @brief Multiplies a matrix with an array of matrices.
+ * @remark This can be used when dsSIMDFeatures_FMA is available.
+ * @param[out] results The results of a*b[i] for each element. This may be the same array as b, but
+ *     must not otherwise overlap with a or b.
+ * @param a The matrix on the left side of each multiplication.
+ * @param b The array of matrices on the right side of each multiplication.
+ * @param count The number of matrices in results and b.
+ */
+DS_MATH_EXPORT void dsMatrix44f_mulArrayFMA(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count);
+
+/**
+ * @brief Multiplies an affine matrix with an array of affine matrices.
+ * @remark This can be used when dsSIMDFeatures_FMA is available.
+ * @param[out] results The results of a*b[i] for each element. This may be the same array as b, but
+ *     must not otherwise overlap with a or b.
+ * @param a The matrix on the left side of each multiplication.
+ * @param b The array of matrices on the right side of each multiplication.
+ * @param count The number of matrices in results and b.
+ */
+DS_MATH_EXPORT void dsMatrix44f_affineMulArrayFMA(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count);
+
+/**
+ * @brief Transforms an array of points by an affine matrix.
+ * @remark This can be used when dsSIMDFeatures_FMA is available.
+ * @param[out] results The transformed points. This may be the same array as points, but must not
+ *     otherwise overlap with it.
+ * @param mat The matrix to transform with.
+ * @param points The points to transform.
+ * @param count The number of points in results and points.
+ */
+DS_MATH_EXPORT void dsMatrix44f_transformPointsArrayFMA(
+	dsVector3xf* results, const dsMatrix44f* mat, const dsVector3xf* points, uint32_t count);
+
+/**
+ * @brief Multiplies a matrix with an array of matrices.
+ * @remark This can be used when dsSIMDFeatures_FMA and dsSIMDFeatures_Float8 are available.
+ * @param[out] results The results of a*b[i] for each element. This may be the same array as b, but
+ *     must not otherwise overlap with a or b.
+ * @param a The matrix on the left side of each multiplication.
+ * @param b The array of matrices on the right side of each multiplication.
+ * @param count The number of matrices in results and b.
+ */
+DS_MATH_EXPORT void dsMatrix44f_mulArrayFMA8(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count);
+
+/**
+ * @brief Multiplies an affine matrix with an array of affine matrices.
+ * @remark This can be used when dsSIMDFeatures_FMA and dsSIMDFeatures_Float8 are available.
+ * @param[out] results The results of a*b[i] for each element. This may be the same array as b, but
+ *     must not otherwise overlap with a or b.
+ * @param a The matrix on the left side of each multiplication.
+ * @param b The array of matrices on the right side of each multiplication.
+ * @param count The number of matrices in results and b.
+ */
+DS_MATH_EXPORT void dsMatrix44f_affineMulArrayFMA8(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count);
+
+/**
+ * @brief Transforms an array of points by an affine matrix.
+ * @remark This can be used when dsSIMDFeatures_FMA and dsSIMDFeatures_Float8 are available.
+ * @param[out] results The transformed points. This may be the same array as points, but must not
+ *     otherwise overlap with it.
+ * @param mat The matrix to transform with.
+ * @param points The points to transform.
+ * @param count The number of points in results and points.
+ */
+DS_MATH_EXPORT void dsMatrix44f_transformPointsArrayFMA8(
+	dsVector3xf* results, const dsMatrix44f* mat, const dsVector3xf* points, uint32_t count);
+#endif // !DS_DETERMINISTIC_MATH
+
 DS_SIMD_START(DS_SIMD_FLOAT4)
 
 #if DS_X86
@@ -67,6 +67,11 @@
  */
 #define DS_SIMD_ALWAYS_DOUBLE4 0
 
+/**
+ * @brief Define for whether or not SIMD instructions for 8 floats are always available.
+ */
+#define DS_SIMD_ALWAYS_FLOAT8 0
+
 /**
  * @brief Define for whether or not SIMD instructions for horizontal adds are always available.
  */
@@ -119,6 +124,13 @@
  */
 #define DS_SIMD_DOUBLE4
 
+/**
+ * @brief Token to enable 8-float SIMD instructions.
+ *
+ * This should be provided as an argument to DS_SIMD_START().
+ */
+#define DS_SIMD_FLOAT8
+
 /**
  * @brief Token to enable horizontal add SIMD instructions.
  *
@@ -202,20 +214,26 @@ extern "C"
  * - DS_ARM_64: All features except for Double4 are guaranteed to be available at compile time. No
  *   additional features will be detected at runtime.
  *
+ * Float8 is never available on ARM platforms. On x86 it's available with the same CPUs as Double4,
+ * and is intended for batch operations that process 8 elements at once, such as a single plane
+ * against 8 bounding boxes. When both Float8 and FMA are available, the Float8 FMA functions may
+ * also be used.
+ *
  * If DS_DETERMINISTIC_MATH is 1, FMA will always be disabled. DS_SIMD_ALWAYS_FMA will be set to 0,
  * the dsSIMDFeatures_FMA bit will never be set, and functions will not be defined.
  */
 typedef enum dsSIMDFeatures
 {
-	dsSIMDFeatures_None = 0,        ///< No SIMD features are supported.
-	dsSIMDFeatures_Float4 = 0x1,    ///< Standard 4 element float operations.
-	dsSIMDFeatures_Int = 0x2,       ///< Extended integer operations.
-	dsSIMDFeatures_Double2 = 0x4,   ///< Standard 2 element double operations.
-	dsSIMDFeatures_Double4 = 0x8,   ///< Standard 4 element double operations.
-	dsSIMDFeatures_HAdd = 0x10,     ///< Horizontal adds.
-	dsSIMDFeatures_Rounding = 0x20, ///< Floating-point rounding operations.
-	dsSIMDFeatures_FMA = 0x40,      ///< Fused multiply adds.
-	dsSIMDFeatures_HalfFloat = 0x80 ///< Half float conversions.
+	dsSIMDFeatures_None = 0,         ///< No SIMD features are supported.
+	dsSIMDFeatures_Float4 = 0x1,     ///< Standard 4 element float operations.
+	dsSIMDFeatures_Int = 0x2,        ///< Extended integer operations.
+	dsSIMDFeatures_Double2 = 0x4,    ///< Standard 2 element double operations.
+	dsSIMDFeatures_Double4 = 0x8,    ///< Standard 4 element double operations.
+	dsSIMDFeatures_HAdd = 0x10,      ///< Horizontal adds.
+	dsSIMDFeatures_Rounding = 0x20,  ///< Floating-point rounding operations.
+	dsSIMDFeatures_FMA = 0x40,       ///< Fused multiply adds.
+	dsSIMDFeatures_HalfFloat = 0x80, ///< Half float conversions.
+	dsSIMDFeatures_Float8 = 0x100    ///< Standard 8 element float operations.
 } dsSIMDFeatures;
 
 /**
@@ -225,6 +243,29 @@ DS_MATH_EXPORT extern const dsSIMDFeatures dsHostSIMDFeatures;
 
 #endif // DS_HAS_SIMD
 
+/**
+ * @brief Enum for the implementation to use for functions that operate on arrays.
+ *
+ * This chooses the widest implementation available for the host CPU, preferring 8 elements over
+ * 4 elements and FMA over standard operations for the same width. FMA implementations are never
+ * chosen when DS_DETERMINISTIC_MATH is 1.
+ */
+typedef enum dsSIMDArrayImplementation
+{
+	dsSIMDArrayImplementation_Scalar, ///< Scalar implementation without SIMD.
+	dsSIMDArrayImplementation_SIMD,   ///< Standard 4 element float operations.
+	dsSIMDArrayImplementation_FMA,    ///< 4 element float operations with fused multiply adds.
+	dsSIMDArrayImplementation_SIMD8,  ///< Standard 8 element float operations.
+	dsSIMDArrayImplementation_FMA8    ///< 8 element float operations with fused multiply adds.
+} dsSIMDArrayImplementation;
+
+/**
+ * @brief Constant holding the implementation to use for array functions on the current host CPU.
+ *
+ * This is always dsSIMDArrayImplementation_Scalar when DS_HAS_SIMD is 0.
+ */
+DS_MATH_EXPORT extern const dsSIMDArrayImplementation dsHostSIMDArrayImplementation;
+
 #ifdef __cplusplus
 }
 #endif
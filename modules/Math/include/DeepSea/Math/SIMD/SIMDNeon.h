@@ -45,6 +45,7 @@ extern "C"
 #define DS_SIMD_INT
 #define DS_SIMD_DOUBLE2
 #define DS_SIMD_DOUBLE4
+#define DS_SIMD_FLOAT8
 #define DS_SIMD_HADD
 #define DS_SIMD_ROUNDING
 #define DS_SIMD_FMA
@@ -59,6 +60,7 @@ extern "C"
 #define DS_SIMD_ALWAYS_INT 1
 #define DS_SIMD_ALWAYS_DOUBLE2 DS_ARM_64
 #define DS_SIMD_ALWAYS_DOUBLE4 0
+#define DS_SIMD_ALWAYS_FLOAT8 0
 #define DS_SIMD_ALWAYS_HADD 1
 #define DS_SIMD_ALWAYS_ROUNDING DS_ARM_64
 #define DS_SIMD_ALWAYS_FMA !DS_DETERMINISTIC_MATH
@@ -91,6 +93,11 @@ typedef DS_ALIGN(16) struct dsSIMD2d {double x[2];} dsSIMD2d;
  * @brief Type for a SIMD vector of 4 doubles.
  */
 typedef DS_ALIGN(32) struct dsSIMD4d {double x[4];} dsSIMD4d;
+
+/**
+ * @brief Type for a SIMD vector of 8 floats.
+ */
+typedef DS_ALIGN(32) struct dsSIMD8f {float x[8];} dsSIMD8f;
 /// @endcond
 
 /**
@@ -118,6 +125,13 @@ typedef DS_ALIGN(16) struct dsSIMD2db {uint64_t x[2];} dsSIMD2db;
  * Each bitfield value will be stored in a 64-bit value, and will often represent boolean values.
  */
 typedef DS_ALIGN(32) struct dsSIMD4db {uint64_t x[4];} dsSIMD4db;
+
+/**
+ * @brief Type for a SIMD vector of 8 bitfield results.
+ *
+ * Each bitfield value will be stored in a 32-bit value, and will often represent boolean values.
+ */
+typedef DS_ALIGN(32) struct dsSIMD8fb {uint32_t x[8];} dsSIMD8fb;
 /// @endcond
 
 /**
@@ -2820,6 +2834,500 @@ DS_ALWAYS_INLINE uint64_t dsSIMD4db_all(dsSIMD4db a)
 	DS_UNREACHABLE();
 }
 
+/**
+ * @brief Loads float values into an 8-wide SIMD register.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param fp A pointer to the float values to load. This should be aligned to 32 bytes.
+ * @return The loaded SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_load(const void* fp)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Loads float values into an 8-wide SIMD register.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param fp A pointer to the float values to load. This may be unaligned.
+ * @return The loaded SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_loadUnaligned(const void* fp)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Sets a float value into all elements of an 8-wide SIMD register.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param f The value to set.
+ * @return The SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_set1(float f)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Combines two 4-wide SIMD values into an 8-wide SIMD value.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The 4-wide value for the first four elements.
+ * @param b The 4-wide value for the last four elements.
+ * @return The SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_combine4f(dsSIMD4f a, dsSIMD4f b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Gets four elements from an 8-wide SIMD value as a 4-wide SIMD value.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The value to get the elements from.
+ * @param i Constant 0 for the first four elements or 1 for the last four elements.
+ * @return The 4-wide SIMD value.
+ */
+#define dsSIMD8f_get4f(a, i) dsSIMD4f_load((a).x + (i)*4)
+
+/**
+ * @brief Sets an element from each group of four elements to all elements of that group.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The value to get the elements from.
+ * @param i The index of the element within each group of four to get.
+ * @return The SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_set1FromVec4(dsSIMD8f a, unsigned int i)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Stores an 8-wide SIMD register into eight float values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param[out] fp A pointer to the float values to store to. This should be aligned to 32 bytes.
+ * @param a The value to store.
+ */
+DS_ALWAYS_INLINE void dsSIMD8f_store(void* fp, dsSIMD8f a)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Stores an 8-wide SIMD register into eight float values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param[out] fp A pointer to the float values to store to. This may be unaligned.
+ * @param a The value to store.
+ */
+DS_ALWAYS_INLINE void dsSIMD8f_storeUnaligned(void* fp, dsSIMD8f a)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Gets a float element from an 8-wide SIMD value.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The value to get the element from.
+ * @param i The index of the element.
+ * @return The element value.
+ */
+#define dsSIMD8f_get(a, i) ((void)(a), 0.0f)
+
+/**
+ * @brief Negates an 8-wide SIMD value.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The value to negate.
+ * @return The result of -a.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_neg(dsSIMD8f a)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Adds two 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to add.
+ * @param b The second value to add.
+ * @return The result of a + b.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_add(dsSIMD8f a, dsSIMD8f b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Subtracts two 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to subtract.
+ * @param b The second value to subtract.
+ * @return The result of a - b.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_sub(dsSIMD8f a, dsSIMD8f b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Multiplies two 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to multiply.
+ * @param b The second value to multiply.
+ * @return The result of a*b.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_mul(dsSIMD8f a, dsSIMD8f b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Divides two 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to divide.
+ * @param b The second value to divide.
+ * @return The result of a/b.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_div(dsSIMD8f a, dsSIMD8f b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Takes the square root of an 8-wide SIMD value.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The value to take the square root.
+ * @return The result of sqrt(a).
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_sqrt(dsSIMD8f a)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Takes the absolute value of an 8-wide SIMD value.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The value to take the absolute value.
+ * @return The result of abs(a).
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_abs(dsSIMD8f a)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Gets the minimum elements between two 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to take the min of.
+ * @param b The second value to take the min of.
+ * @return The result of min(a, b).
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_min(dsSIMD8f a, dsSIMD8f b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Gets the maximum elements between two 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to take the max of.
+ * @param b The second value to take the max of.
+ * @return The result of max(a, b).
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_max(dsSIMD8f a, dsSIMD8f b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Selects between two 8-wide vectors based on a boolean mask.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The boolean mask to select with.
+ * @param b The first SIMD values to select from.
+ * @param c The second SIMD values to select from.
+ * @return The result of a ? b : c.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_select(dsSIMD8fb a, dsSIMD8f b, dsSIMD8f c)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Checks if two 8-wide SIMD values are equal.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to compare.
+ * @param b The second value to compare.
+ * @return The result of a == b as a dsSIMD8fb.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8f_cmpeq(dsSIMD8f a, dsSIMD8f b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Checks if two 8-wide SIMD values are not equal.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to compare.
+ * @param b The second value to compare.
+ * @return The result of a != b as a dsSIMD8fb.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8f_cmpne(dsSIMD8f a, dsSIMD8f b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Checks if one 8-wide SIMD values is less than another.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to compare.
+ * @param b The second value to compare.
+ * @return The result of a < b as a dsSIMD8fb.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8f_cmplt(dsSIMD8f a, dsSIMD8f b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Checks if one 8-wide SIMD values is less than or equal to another.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to compare.
+ * @param b The second value to compare.
+ * @return The result of a <= b as a dsSIMD8fb.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8f_cmple(dsSIMD8f a, dsSIMD8f b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Checks if one 8-wide SIMD values is greater than another.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to compare.
+ * @param b The second value to compare.
+ * @return The result of a > b as a dsSIMD8fb.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8f_cmpgt(dsSIMD8f a, dsSIMD8f b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Checks if one 8-wide SIMD values is greater than or equal to another.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to compare.
+ * @param b The second value to compare.
+ * @return The result of a >= b as a dsSIMD8fb.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8f_cmpge(dsSIMD8f a, dsSIMD8f b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Creates an 8-wide SIMD value for true.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @return A SIMD value with true on all elements.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_true(void)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Creates an 8-wide SIMD value for false.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @return A SIMD value with false on all elements.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_false(void)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Loads 32-bit int values into an 8-wide SIMD register.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param ip A pointer to the int values to load. This should be aligned to 32 bytes.
+ * @return The loaded SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_load(const void* ip)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Loads 32-bit int values into an 8-wide SIMD register.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param ip A pointer to the int values to load. This may be unaligned.
+ * @return The loaded SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_loadUnaligned(const void* ip)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Sets a 32-bit int value into all elements of an 8-wide SIMD register.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param i The value to set.
+ * @return The SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_set1(uint32_t i)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Stores an 8-wide SIMD bitfield register into eight int values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param[out] ip A pointer to the int values to store to. This should be aligned to 32 bytes.
+ * @param a The value to store.
+ */
+DS_ALWAYS_INLINE void dsSIMD8fb_store(void* ip, dsSIMD8fb a)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Stores an 8-wide SIMD bitfield register into eight int values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param[out] ip A pointer to the int values to store to. This may be unaligned.
+ * @param a The value to store.
+ */
+DS_ALWAYS_INLINE void dsSIMD8fb_storeUnaligned(void* ip, dsSIMD8fb a)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Performs a logical not on an 8-wide SIMD bitfield value.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The value to not.
+ * @return The result of ~a.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_not(dsSIMD8fb a)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Performs a logical and between two 8-wide SIMD bitfield values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to and.
+ * @param b The second value to and.
+ * @return The result of a & b.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_and(dsSIMD8fb a, dsSIMD8fb b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Performs a logical and not between two 8-wide SIMD bitfield values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to not then and.
+ * @param b The second value to and.
+ * @return The result of (~a) & b.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_andnot(dsSIMD8fb a, dsSIMD8fb b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Performs a logical or between two 8-wide SIMD bitfield values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to or.
+ * @param b The second value to or.
+ * @return The result of a | b.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_or(dsSIMD8fb a, dsSIMD8fb b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Performs a logical xor between two 8-wide SIMD bitfield values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to xor.
+ * @param b The second value to xor.
+ * @return The result of a ^ b.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_xor(dsSIMD8fb a, dsSIMD8fb b)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Gets a bitmask for which boolean 8-wide SIMD values are set.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @remark Only the top bit of each element is checked.
+ * @param a The value to check.
+ * @return A bitmask with bit i set when element i of a is true.
+ */
+DS_ALWAYS_INLINE uint32_t dsSIMD8fb_mask(dsSIMD8fb a)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Gets whether any boolean 8-wide SIMD values are set.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @remark Results are undefined if the bit values for each element aren't all 0s or all 1s.
+ * @param a The value to check.
+ * @return All 1s if any element in a is true, all 0s if every elements is false.
+ */
+DS_ALWAYS_INLINE uint32_t dsSIMD8fb_any(dsSIMD8fb a)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Gets whether all boolean 8-wide SIMD values are set.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @remark Results are undefined if the bit values for each element aren't all 0s or all 1s.
+ * @param a The value to check.
+ * @return All 1s if every element in a is true, all 0s if any elements is false.
+ */
+DS_ALWAYS_INLINE uint32_t dsSIMD8fb_all(dsSIMD8fb a)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
 /**
  * @brief Performs a horizontal add between two SIMD values.
  * @remark This can be used when dsSIMDFeatures_Float4 and dsSIMDFeatures_HAdd are available.
@@ -3227,6 +3735,61 @@ DS_ALWAYS_INLINE dsSIMD4d dsSIMD4d_fnmsub(dsSIMD4d a, dsSIMD4d b, dsSIMD4d c)
 	DS_UNREACHABLE();
 }
 
+/**
+ * @brief Performs a fused multiply add with three 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_FMA and dsSIMDFeatures_Float8 is available.
+ * @param a The first value to multiply.
+ * @param b The second value to multiply.
+ * @param c The third value to add.
+ * @return The result of a*b + c.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_fmadd(dsSIMD8f a, dsSIMD8f b, dsSIMD8f c)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Performs a fused multiply subtract with three 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_FMA and dsSIMDFeatures_Float8 is available.
+ * @param a The first value to multiply.
+ * @param b The second value to multiply.
+ * @param c The third value to subtract.
+ * @return The result of a*b - c.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_fmsub(dsSIMD8f a, dsSIMD8f b, dsSIMD8f c)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Performs a fused negate multiply add with three 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_FMA and dsSIMDFeatures_Float8 is available.
+ * @param a The first value to multiply.
+ * @param b The second value to multiply.
+ * @param c The third value to add.
+ * @return The result of -(a*b) + c.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_fnmadd(dsSIMD8f a, dsSIMD8f b, dsSIMD8f c)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
+
+/**
+ * @brief Performs a fused negate multiply subtract with three 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_FMA and dsSIMDFeatures_Float8 is available.
+ * @param a The first value to multiply.
+ * @param b The second value to multiply.
+ * @param c The third value to subtract.
+ * @return The result of -(a*b) - c.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_fnmsub(dsSIMD8f a, dsSIMD8f b, dsSIMD8f c)
+{
+	DS_ASSERT(false);
+	DS_UNREACHABLE();
+}
 #endif // !DS_DETERMINISTIC_MATH
 
 /**
@@ -44,6 +44,7 @@ extern "C"
 #define DS_SIMD_INT sse2
 #define DS_SIMD_DOUBLE2 sse2
 #define DS_SIMD_DOUBLE4 avx2
+#define DS_SIMD_FLOAT8 avx2
 #define DS_SIMD_HADD sse3
 #define DS_SIMD_ROUNDING sse4.1
 // Include extra SSE instructions as some assumptions are made with FMA being the max feature set.
@@ -75,6 +76,7 @@ extern "C"
 #define DS_SIMD_FLOAT4
 #define DS_SIMD_DOUBLE2
 #define DS_SIMD_DOUBLE4
+#define DS_SIMD_FLOAT8
 #define DS_SIMD_HADD
 #define DS_SIMD_FMA
 #define DS_SIMD_HALF_FLOAT
@@ -101,8 +103,10 @@ extern "C"
 
 #if defined(__AVX2__)
 #define DS_SIMD_ALWAYS_DOUBLE4 1
+#define DS_SIMD_ALWAYS_FLOAT8 1
 #else
 #define DS_SIMD_ALWAYS_DOUBLE4 0
+#define DS_SIMD_ALWAYS_FLOAT8 0
 #endif
 
 // NOTE: Windows doesn't have any way to distinguish between AVX and SSE versions > 2, so need to
@@ -151,6 +155,11 @@ typedef __m128d dsSIMD2d;
  */
 typedef __m256d dsSIMD4d;
 
+/**
+ * @brief Type for a SIMD vector of 8 floats.
+ */
+typedef __m256 dsSIMD8f;
+
 /**
  * @brief Type for a SIMD vector of 4 bitfield results.
  *
@@ -176,6 +185,13 @@ typedef __m128i dsSIMD2db;
  */
 typedef __m256i dsSIMD4db;
 
+/**
+ * @brief Type for a SIMD vector of 8 bitfield results.
+ *
+ * Each bitfield value will be stored in a 32-bit value, and will often represent boolean values.
+ */
+typedef __m256i dsSIMD8fb;
+
 /**
  * @brief Type for a SIMD vector of 4 half floats.
  */
@@ -2593,6 +2609,464 @@ DS_ALWAYS_INLINE uint64_t dsSIMD4db_all(dsSIMD4db a)
 #endif
 }
 
+/// @cond
+DS_SIMD_END();
+DS_SIMD_START(DS_SIMD_FLOAT8);
+/// @endcond
+
+/**
+ * @brief Loads float values into an 8-wide SIMD register.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param fp A pointer to the float values to load. This should be aligned to 32 bytes.
+ * @return The loaded SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_load(const void* fp)
+{
+	return _mm256_load_ps((const float*)fp);
+}
+
+/**
+ * @brief Loads float values into an 8-wide SIMD register.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param fp A pointer to the float values to load. This may be unaligned.
+ * @return The loaded SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_loadUnaligned(const void* fp)
+{
+	return _mm256_loadu_ps((const float*)fp);
+}
+
+/**
+ * @brief Sets a float value into all elements of an 8-wide SIMD register.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param f The value to set.
+ * @return The SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_set1(float f)
+{
+	return _mm256_set1_ps(f);
+}
+
+/**
+ * @brief Combines two 4-wide SIMD values into an 8-wide SIMD value.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The 4-wide value for the first four elements.
+ * @param b The 4-wide value for the last four elements.
+ * @return The SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_combine4f(dsSIMD4f a, dsSIMD4f b)
+{
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(a), b, 1);
+}
+
+/**
+ * @brief Gets four elements from an 8-wide SIMD value as a 4-wide SIMD value.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The value to get the elements from.
+ * @param i Constant 0 for the first four elements or 1 for the last four elements.
+ * @return The 4-wide SIMD value.
+ */
+#define dsSIMD8f_get4f(a, i) _mm256_extractf128_ps((a), (i))
+
+/**
+ * @brief Sets an element from each group of four elements to all elements of that group.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The value to get the elements from.
+ * @param i The index of the element within each group of four to get.
+ * @return The SIMD value.
+ */
+#define dsSIMD8f_set1FromVec4(a, i) _mm256_permute_ps((a), _MM_SHUFFLE((i), (i), (i), (i)))
+
+/**
+ * @brief Stores an 8-wide SIMD register into eight float values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param[out] fp A pointer to the float values to store to. This should be aligned to 32 bytes.
+ * @param a The value to store.
+ */
+DS_ALWAYS_INLINE void dsSIMD8f_store(void* fp, dsSIMD8f a)
+{
+	_mm256_store_ps((float*)fp, a);
+}
+
+/**
+ * @brief Stores an 8-wide SIMD register into eight float values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param[out] fp A pointer to the float values to store to. This may be unaligned.
+ * @param a The value to store.
+ */
+DS_ALWAYS_INLINE void dsSIMD8f_storeUnaligned(void* fp, dsSIMD8f a)
+{
+	_mm256_storeu_ps((float*)fp, a);
+}
+
+/**
+ * @brief Gets a float element from an 8-wide SIMD value.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The value to get the element from.
+ * @param i The index of the element.
+ * @return The element value.
+ */
+#define dsSIMD8f_get(a, i) _mm256_cvtss_f32(_mm256_permutevar8x32_ps((a), _mm256_set1_epi32((i))))
+
+/**
+ * @brief Negates an 8-wide SIMD value.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The value to negate.
+ * @return The result of -a.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_neg(dsSIMD8f a)
+{
+	return _mm256_xor_ps(_mm256_set1_ps(-0.0f), a);
+}
+
+/**
+ * @brief Adds two 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to add.
+ * @param b The second value to add.
+ * @return The result of a + b.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_add(dsSIMD8f a, dsSIMD8f b)
+{
+	return _mm256_add_ps(a, b);
+}
+
+/**
+ * @brief Subtracts two 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to subtract.
+ * @param b The second value to subtract.
+ * @return The result of a - b.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_sub(dsSIMD8f a, dsSIMD8f b)
+{
+	return _mm256_sub_ps(a, b);
+}
+
+/**
+ * @brief Multiplies two 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to multiply.
+ * @param b The second value to multiply.
+ * @return The result of a*b.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_mul(dsSIMD8f a, dsSIMD8f b)
+{
+	return _mm256_mul_ps(a, b);
+}
+
+/**
+ * @brief Divides two 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to divide.
+ * @param b The second value to divide.
+ * @return The result of a/b.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_div(dsSIMD8f a, dsSIMD8f b)
+{
+	return _mm256_div_ps(a, b);
+}
+
+/**
+ * @brief Takes the square root of an 8-wide SIMD value.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The value to take the square root.
+ * @return The result of sqrt(a).
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_sqrt(dsSIMD8f a)
+{
+	return _mm256_sqrt_ps(a);
+}
+
+/**
+ * @brief Takes the absolute value of an 8-wide SIMD value.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The value to take the absolute value.
+ * @return The result of abs(a).
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_abs(dsSIMD8f a)
+{
+	return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);
+}
+
+/**
+ * @brief Gets the minimum elements between two 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to take the min of.
+ * @param b The second value to take the min of.
+ * @return The result of min(a, b).
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_min(dsSIMD8f a, dsSIMD8f b)
+{
+	return _mm256_min_ps(a, b);
+}
+
+/**
+ * @brief Gets the maximum elements between two 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to take the max of.
+ * @param b The second value to take the max of.
+ * @return The result of max(a, b).
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_max(dsSIMD8f a, dsSIMD8f b)
+{
+	return _mm256_max_ps(a, b);
+}
+
+/**
+ * @brief Selects between two 8-wide vectors based on a boolean mask.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The boolean mask to select with.
+ * @param b The first SIMD values to select from.
+ * @param c The second SIMD values to select from.
+ * @return The result of a ? b : c.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_select(dsSIMD8fb a, dsSIMD8f b, dsSIMD8f c)
+{
+	return _mm256_blendv_ps(c, b, _mm256_castsi256_ps(a));
+}
+
+/**
+ * @brief Checks if two 8-wide SIMD values are equal.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to compare.
+ * @param b The second value to compare.
+ * @return The result of a == b as a dsSIMD8fb.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8f_cmpeq(dsSIMD8f a, dsSIMD8f b)
+{
+	return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+}
+
+/**
+ * @brief Checks if two 8-wide SIMD values are not equal.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to compare.
+ * @param b The second value to compare.
+ * @return The result of a != b as a dsSIMD8fb.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8f_cmpne(dsSIMD8f a, dsSIMD8f b)
+{
+	return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_NEQ_OQ));
+}
+
+/**
+ * @brief Checks if one 8-wide SIMD values is less than another.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to compare.
+ * @param b The second value to compare.
+ * @return The result of a < b as a dsSIMD8fb.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8f_cmplt(dsSIMD8f a, dsSIMD8f b)
+{
+	return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ));
+}
+
+/**
+ * @brief Checks if one 8-wide SIMD values is less than or equal to another.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to compare.
+ * @param b The second value to compare.
+ * @return The result of a <= b as a dsSIMD8fb.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8f_cmple(dsSIMD8f a, dsSIMD8f b)
+{
+	return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LE_OQ));
+}
+
+/**
+ * @brief Checks if one 8-wide SIMD values is greater than another.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to compare.
+ * @param b The second value to compare.
+ * @return The result of a > b as a dsSIMD8fb.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8f_cmpgt(dsSIMD8f a, dsSIMD8f b)
+{
+	return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GT_OQ));
+}
+
+/**
+ * @brief Checks if one 8-wide SIMD values is greater than or equal to another.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to compare.
+ * @param b The second value to compare.
+ * @return The result of a >= b as a dsSIMD8fb.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8f_cmpge(dsSIMD8f a, dsSIMD8f b)
+{
+	return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GE_OQ));
+}
+
+/**
+ * @brief Creates an 8-wide SIMD value for true.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @return A SIMD value with true on all elements.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_true(void)
+{
+	return _mm256_set1_epi32(-1);
+}
+
+/**
+ * @brief Creates an 8-wide SIMD value for false.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @return A SIMD value with false on all elements.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_false(void)
+{
+	return _mm256_setzero_si256();
+}
+
+/**
+ * @brief Loads 32-bit int values into an 8-wide SIMD register.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param ip A pointer to the int values to load. This should be aligned to 32 bytes.
+ * @return The loaded SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_load(const void* ip)
+{
+	return _mm256_load_si256((const dsSIMD8fb*)ip);
+}
+
+/**
+ * @brief Loads 32-bit int values into an 8-wide SIMD register.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param ip A pointer to the int values to load. This may be unaligned.
+ * @return The loaded SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_loadUnaligned(const void* ip)
+{
+	return _mm256_loadu_si256((const dsSIMD8fb*)ip);
+}
+
+/**
+ * @brief Sets a 32-bit int value into all elements of an 8-wide SIMD register.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param i The value to set.
+ * @return The SIMD value.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_set1(uint32_t i)
+{
+	return _mm256_set1_epi32((int)i);
+}
+
+/**
+ * @brief Stores an 8-wide SIMD bitfield register into eight int values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param[out] ip A pointer to the int values to store to. This should be aligned to 32 bytes.
+ * @param a The value to store.
+ */
+DS_ALWAYS_INLINE void dsSIMD8fb_store(void* ip, dsSIMD8fb a)
+{
+	_mm256_store_si256((dsSIMD8fb*)ip, a);
+}
+
+/**
+ * @brief Stores an 8-wide SIMD bitfield register into eight int values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param[out] ip A pointer to the int values to store to. This may be unaligned.
+ * @param a The value to store.
+ */
+DS_ALWAYS_INLINE void dsSIMD8fb_storeUnaligned(void* ip, dsSIMD8fb a)
+{
+	_mm256_storeu_si256((dsSIMD8fb*)ip, a);
+}
+
+/**
+ * @brief Performs a logical not on an 8-wide SIMD bitfield value.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The value to not.
+ * @return The result of ~a.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_not(dsSIMD8fb a)
+{
+	return _mm256_xor_si256(a, dsSIMD8fb_true());
+}
+
+/**
+ * @brief Performs a logical and between two 8-wide SIMD bitfield values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to and.
+ * @param b The second value to and.
+ * @return The result of a & b.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_and(dsSIMD8fb a, dsSIMD8fb b)
+{
+	return _mm256_and_si256(a, b);
+}
+
+/**
+ * @brief Performs a logical and not between two 8-wide SIMD bitfield values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to not then and.
+ * @param b The second value to and.
+ * @return The result of (~a) & b.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_andnot(dsSIMD8fb a, dsSIMD8fb b)
+{
+	return _mm256_andnot_si256(a, b);
+}
+
+/**
+ * @brief Performs a logical or between two 8-wide SIMD bitfield values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to or.
+ * @param b The second value to or.
+ * @return The result of a | b.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_or(dsSIMD8fb a, dsSIMD8fb b)
+{
+	return _mm256_or_si256(a, b);
+}
+
+/**
+ * @brief Performs a logical xor between two 8-wide SIMD bitfield values.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @param a The first value to xor.
+ * @param b The second value to xor.
+ * @return The result of a ^ b.
+ */
+DS_ALWAYS_INLINE dsSIMD8fb dsSIMD8fb_xor(dsSIMD8fb a, dsSIMD8fb b)
+{
+	return _mm256_xor_si256(a, b);
+}
+
+/**
+ * @brief Gets a bitmask for which boolean 8-wide SIMD values are set.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @remark Only the top bit of each element is checked.
+ * @param a The value to check.
+ * @return A bitmask with bit i set when element i of a is true.
+ */
+DS_ALWAYS_INLINE uint32_t dsSIMD8fb_mask(dsSIMD8fb a)
+{
+	return (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(a));
+}
+
+/**
+ * @brief Gets whether any boolean 8-wide SIMD values are set.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @remark Results are undefined if the bit values for each element aren't all 0s or all 1s.
+ * @param a The value to check.
+ * @return All 1s if any element in a is true, all 0s if every elements is false.
+ */
+DS_ALWAYS_INLINE uint32_t dsSIMD8fb_any(dsSIMD8fb a)
+{
+	return _mm256_testz_si256(a, a) ? 0 : 0xFFFFFFFF;
+}
+
+/**
+ * @brief Gets whether all boolean 8-wide SIMD values are set.
+ * @remark This can be used when dsSIMDFeatures_Float8 is available.
+ * @remark Results are undefined if the bit values for each element aren't all 0s or all 1s.
+ * @param a The value to check.
+ * @return All 1s if every element in a is true, all 0s if any elements is false.
+ */
+DS_ALWAYS_INLINE uint32_t dsSIMD8fb_all(dsSIMD8fb a)
+{
+	return _mm256_testc_si256(a, dsSIMD8fb_true()) ? 0xFFFFFFFF : 0;
+}
 /// @cond
 DS_SIMD_END();
 DS_SIMD_START(DS_SIMD_FLOAT4,DS_SIMD_HADD);
@@ -2966,6 +3440,62 @@ DS_ALWAYS_INLINE dsSIMD4d dsSIMD4d_fnmsub(dsSIMD4d a, dsSIMD4d b, dsSIMD4d c)
 	return _mm256_fnmsub_pd(a, b, c);
 }
 
+/// @cond
+DS_SIMD_END();
+DS_SIMD_START(DS_SIMD_FLOAT8,DS_SIMD_FMA);
+/// @endcond
+
+/**
+ * @brief Performs a fused multiply add with three 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_FMA and dsSIMDFeatures_Float8 is available.
+ * @param a The first value to multiply.
+ * @param b The second value to multiply.
+ * @param c The third value to add.
+ * @return The result of a*b + c.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_fmadd(dsSIMD8f a, dsSIMD8f b, dsSIMD8f c)
+{
+	return _mm256_fmadd_ps(a, b, c);
+}
+
+/**
+ * @brief Performs a fused multiply subtract with three 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_FMA and dsSIMDFeatures_Float8 is available.
+ * @param a The first value to multiply.
+ * @param b The second value to multiply.
+ * @param c The third value to subtract.
+ * @return The result of a*b - c.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_fmsub(dsSIMD8f a, dsSIMD8f b, dsSIMD8f c)
+{
+	return _mm256_fmsub_ps(a, b, c);
+}
+
+/**
+ * @brief Performs a fused negate multiply add with three 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_FMA and dsSIMDFeatures_Float8 is available.
+ * @param a The first value to multiply.
+ * @param b The second value to multiply.
+ * @param c The third value to add.
+ * @return The result of -(a*b) + c.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_fnmadd(dsSIMD8f a, dsSIMD8f b, dsSIMD8f c)
+{
+	return _mm256_fnmadd_ps(a, b, c);
+}
+
+/**
+ * @brief Performs a fused negate multiply subtract with three 8-wide SIMD values.
+ * @remark This can be used when dsSIMDFeatures_FMA and dsSIMDFeatures_Float8 is available.
+ * @param a The first value to multiply.
+ * @param b The second value to multiply.
+ * @param c The third value to subtract.
+ * @return The result of -(a*b) - c.
+ */
+DS_ALWAYS_INLINE dsSIMD8f dsSIMD8f_fnmsub(dsSIMD8f a, dsSIMD8f b, dsSIMD8f c)
+{
+	return _mm256_fnmsub_ps(a, b, c);
+}
 /// @cond
 DS_SIMD_END();
 #endif // !DS_DETERMINISTIC_MATH
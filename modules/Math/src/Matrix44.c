@@ -591,6 +591,117 @@ void dsMatrix44d_makePerspective(dsMatrix44d* result, double fovy, double aspect
 	result->values[3][3] = 0;
 }
 
+void dsMatrix44f_mulArray(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(a);
+	DS_ASSERT(b || count == 0);
+
+	switch (dsHostSIMDArrayImplementation)
+	{
+#if DS_HAS_SIMD
+#if !DS_DETERMINISTIC_MATH
+		case dsSIMDArrayImplementation_FMA8:
+			dsMatrix44f_mulArrayFMA8(results, a, b, count);
+			return;
+		case dsSIMDArrayImplementation_FMA:
+			dsMatrix44f_mulArrayFMA(results, a, b, count);
+			return;
+#endif
+		case dsSIMDArrayImplementation_SIMD8:
+			dsMatrix44f_mulArraySIMD8(results, a, b, count);
+			return;
+		case dsSIMDArrayImplementation_SIMD:
+			dsMatrix44f_mulArraySIMD(results, a, b, count);
+			return;
+#endif
+		default:
+			break;
+	}
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		dsMatrix44f temp;
+		dsMatrix44_mul(temp, *a, b[i]);
+		results[i] = temp;
+	}
+}
+
+void dsMatrix44f_affineMulArray(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(a);
+	DS_ASSERT(b || count == 0);
+
+	switch (dsHostSIMDArrayImplementation)
+	{
+#if DS_HAS_SIMD
+#if !DS_DETERMINISTIC_MATH
+		case dsSIMDArrayImplementation_FMA8:
+			dsMatrix44f_affineMulArrayFMA8(results, a, b, count);
+			return;
+		case dsSIMDArrayImplementation_FMA:
+			dsMatrix44f_affineMulArrayFMA(results, a, b, count);
+			return;
+#endif
+		case dsSIMDArrayImplementation_SIMD8:
+			dsMatrix44f_affineMulArraySIMD8(results, a, b, count);
+			return;
+		case dsSIMDArrayImplementation_SIMD:
+			dsMatrix44f_affineMulArraySIMD(results, a, b, count);
+			return;
+#endif
+		default:
+			break;
+	}
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		dsMatrix44f temp;
+		dsMatrix44_affineMul(temp, *a, b[i]);
+		results[i] = temp;
+	}
+}
+
+void dsMatrix44f_transformPointsArray(
+	dsVector3xf* results, const dsMatrix44f* mat, const dsVector3xf* points, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(mat);
+	DS_ASSERT(points || count == 0);
+
+	switch (dsHostSIMDArrayImplementation)
+	{
+#if DS_HAS_SIMD
+#if !DS_DETERMINISTIC_MATH
+		case dsSIMDArrayImplementation_FMA8:
+			dsMatrix44f_transformPointsArrayFMA8(results, mat, points, count);
+			return;
+		case dsSIMDArrayImplementation_FMA:
+			dsMatrix44f_transformPointsArrayFMA(results, mat, points, count);
+			return;
+#endif
+		case dsSIMDArrayImplementation_SIMD8:
+			dsMatrix44f_transformPointsArraySIMD8(results, mat, points, count);
+			return;
+		case dsSIMDArrayImplementation_SIMD:
+			dsMatrix44f_transformPointsArraySIMD(results, mat, points, count);
+			return;
+#endif
+		default:
+			break;
+	}
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		dsVector4f point = points[i];
+		point.w = 1.0f;
+		dsMatrix44_transform(results[i], *mat, point);
+	}
+}
+
 void dsMatrix44f_decomposeTransformScalar(dsVector3xf* outPosition, dsQuaternion4f* outOrientation,
 	dsVector3xf* outScale, const dsMatrix44f* matrix)
 {
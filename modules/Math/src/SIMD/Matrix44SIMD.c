@@ -110,4 +110,395 @@ void dsMatrix44d_decomposeTransformSIMD4(dsVector3xd* DS_ALIGN_PARAM(32) outPosi
 void dsMatrix44d_composeTransformSIMD4(dsMatrix44d* DS_ALIGN_PARAM(32) result,
 	const dsVector3xd* DS_ALIGN_PARAM(32) position, const dsQuaternion4d* orientation,
 	const dsVector3xd* DS_ALIGN_PARAM(32) scale);
+
+DS_SIMD_START(DS_SIMD_FLOAT4)
+void dsMatrix44f_mulArraySIMD(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(a);
+	DS_ASSERT(b || count == 0);
+
+	dsSIMD4f a0 = a->columns[0].simd;
+	dsSIMD4f a1 = a->columns[1].simd;
+	dsSIMD4f a2 = a->columns[2].simd;
+	dsSIMD4f a3 = a->columns[3].simd;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		// Load all columns before storing any results to allow results to be the same as b.
+		dsSIMD4f b0 = b[i].columns[0].simd;
+		dsSIMD4f b1 = b[i].columns[1].simd;
+		dsSIMD4f b2 = b[i].columns[2].simd;
+		dsSIMD4f b3 = b[i].columns[3].simd;
+
+		dsMatrix44f* result = results + i;
+		result->columns[0].simd = dsSIMD4f_add(dsSIMD4f_add(
+				dsSIMD4f_mul(a0, dsSIMD4f_set1FromVec(b0, 0)),
+				dsSIMD4f_mul(a1, dsSIMD4f_set1FromVec(b0, 1))),
+			dsSIMD4f_add(dsSIMD4f_mul(a2, dsSIMD4f_set1FromVec(b0, 2)),
+				dsSIMD4f_mul(a3, dsSIMD4f_set1FromVec(b0, 3))));
+		result->columns[1].simd = dsSIMD4f_add(dsSIMD4f_add(
+				dsSIMD4f_mul(a0, dsSIMD4f_set1FromVec(b1, 0)),
+				dsSIMD4f_mul(a1, dsSIMD4f_set1FromVec(b1, 1))),
+			dsSIMD4f_add(dsSIMD4f_mul(a2, dsSIMD4f_set1FromVec(b1, 2)),
+				dsSIMD4f_mul(a3, dsSIMD4f_set1FromVec(b1, 3))));
+		result->columns[2].simd = dsSIMD4f_add(dsSIMD4f_add(
+				dsSIMD4f_mul(a0, dsSIMD4f_set1FromVec(b2, 0)),
+				dsSIMD4f_mul(a1, dsSIMD4f_set1FromVec(b2, 1))),
+			dsSIMD4f_add(dsSIMD4f_mul(a2, dsSIMD4f_set1FromVec(b2, 2)),
+				dsSIMD4f_mul(a3, dsSIMD4f_set1FromVec(b2, 3))));
+		result->columns[3].simd = dsSIMD4f_add(dsSIMD4f_add(
+				dsSIMD4f_mul(a0, dsSIMD4f_set1FromVec(b3, 0)),
+				dsSIMD4f_mul(a1, dsSIMD4f_set1FromVec(b3, 1))),
+			dsSIMD4f_add(dsSIMD4f_mul(a2, dsSIMD4f_set1FromVec(b3, 2)),
+				dsSIMD4f_mul(a3, dsSIMD4f_set1FromVec(b3, 3))));
+	}
+}
+
+void dsMatrix44f_affineMulArraySIMD(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(a);
+	DS_ASSERT(b || count == 0);
+
+	dsSIMD4f a0 = a->columns[0].simd;
+	dsSIMD4f a1 = a->columns[1].simd;
+	dsSIMD4f a2 = a->columns[2].simd;
+	dsSIMD4f a3 = a->columns[3].simd;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		dsSIMD4f b0 = b[i].columns[0].simd;
+		dsSIMD4f b1 = b[i].columns[1].simd;
+		dsSIMD4f b2 = b[i].columns[2].simd;
+		dsSIMD4f b3 = b[i].columns[3].simd;
+
+		dsMatrix44f* result = results + i;
+		result->columns[0].simd = dsSIMD4f_add(dsSIMD4f_add(
+				dsSIMD4f_mul(a0, dsSIMD4f_set1FromVec(b0, 0)),
+				dsSIMD4f_mul(a1, dsSIMD4f_set1FromVec(b0, 1))),
+			dsSIMD4f_mul(a2, dsSIMD4f_set1FromVec(b0, 2)));
+		result->columns[1].simd = dsSIMD4f_add(dsSIMD4f_add(
+				dsSIMD4f_mul(a0, dsSIMD4f_set1FromVec(b1, 0)),
+				dsSIMD4f_mul(a1, dsSIMD4f_set1FromVec(b1, 1))),
+			dsSIMD4f_mul(a2, dsSIMD4f_set1FromVec(b1, 2)));
+		result->columns[2].simd = dsSIMD4f_add(dsSIMD4f_add(
+				dsSIMD4f_mul(a0, dsSIMD4f_set1FromVec(b2, 0)),
+				dsSIMD4f_mul(a1, dsSIMD4f_set1FromVec(b2, 1))),
+			dsSIMD4f_mul(a2, dsSIMD4f_set1FromVec(b2, 2)));
+		result->columns[3].simd = dsSIMD4f_add(dsSIMD4f_add(
+				dsSIMD4f_mul(a0, dsSIMD4f_set1FromVec(b3, 0)),
+				dsSIMD4f_mul(a1, dsSIMD4f_set1FromVec(b3, 1))),
+			dsSIMD4f_add(dsSIMD4f_mul(a2, dsSIMD4f_set1FromVec(b3, 2)), a3));
+	}
+}
+
+void dsMatrix44f_transformPointsArraySIMD(
+	dsVector3xf* results, const dsMatrix44f* mat, const dsVector3xf* points, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(mat);
+	DS_ASSERT(points || count == 0);
+
+	dsSIMD4f col0 = mat->columns[0].simd;
+	dsSIMD4f col1 = mat->columns[1].simd;
+	dsSIMD4f col2 = mat->columns[2].simd;
+	dsSIMD4f col3 = mat->columns[3].simd;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		dsSIMD4f point = points[i].simd;
+		results[i].simd = dsSIMD4f_add(dsSIMD4f_add(
+				dsSIMD4f_mul(col0, dsSIMD4f_set1FromVec(point, 0)),
+				dsSIMD4f_mul(col1, dsSIMD4f_set1FromVec(point, 1))),
+			dsSIMD4f_add(dsSIMD4f_mul(col2, dsSIMD4f_set1FromVec(point, 2)), col3));
+	}
+}
+DS_SIMD_END()
+
+DS_SIMD_START(DS_SIMD_FLOAT8)
+// Two columns of a matrix are processed at once, so each column of the left matrix is duplicated
+// for both halves.
+void dsMatrix44f_mulArraySIMD8(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(a);
+	DS_ASSERT(b || count == 0);
+
+	dsSIMD8f a0 = dsSIMD8f_combine4f(a->columns[0].simd, a->columns[0].simd);
+	dsSIMD8f a1 = dsSIMD8f_combine4f(a->columns[1].simd, a->columns[1].simd);
+	dsSIMD8f a2 = dsSIMD8f_combine4f(a->columns[2].simd, a->columns[2].simd);
+	dsSIMD8f a3 = dsSIMD8f_combine4f(a->columns[3].simd, a->columns[3].simd);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		dsSIMD8f b01 = dsSIMD8f_loadUnaligned(b[i].columns);
+		dsSIMD8f b23 = dsSIMD8f_loadUnaligned(b[i].columns + 2);
+
+		dsSIMD8f result01 = dsSIMD8f_add(dsSIMD8f_add(
+				dsSIMD8f_mul(a0, dsSIMD8f_set1FromVec4(b01, 0)),
+				dsSIMD8f_mul(a1, dsSIMD8f_set1FromVec4(b01, 1))),
+			dsSIMD8f_add(dsSIMD8f_mul(a2, dsSIMD8f_set1FromVec4(b01, 2)),
+				dsSIMD8f_mul(a3, dsSIMD8f_set1FromVec4(b01, 3))));
+		dsSIMD8f result23 = dsSIMD8f_add(dsSIMD8f_add(
+				dsSIMD8f_mul(a0, dsSIMD8f_set1FromVec4(b23, 0)),
+				dsSIMD8f_mul(a1, dsSIMD8f_set1FromVec4(b23, 1))),
+			dsSIMD8f_add(dsSIMD8f_mul(a2, dsSIMD8f_set1FromVec4(b23, 2)),
+				dsSIMD8f_mul(a3, dsSIMD8f_set1FromVec4(b23, 3))));
+
+		dsSIMD8f_storeUnaligned(results[i].columns, result01);
+		dsSIMD8f_storeUnaligned(results[i].columns + 2, result23);
+	}
+}
+
+void dsMatrix44f_affineMulArraySIMD8(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(a);
+	DS_ASSERT(b || count == 0);
+
+	dsSIMD8f a0 = dsSIMD8f_combine4f(a->columns[0].simd, a->columns[0].simd);
+	dsSIMD8f a1 = dsSIMD8f_combine4f(a->columns[1].simd, a->columns[1].simd);
+	dsSIMD8f a2 = dsSIMD8f_combine4f(a->columns[2].simd, a->columns[2].simd);
+	// Only the translation column has the last column of a added.
+	dsSIMD8f a3 = dsSIMD8f_combine4f(dsSIMD4f_set1(0.0f), a->columns[3].simd);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		dsSIMD8f b01 = dsSIMD8f_loadUnaligned(b[i].columns);
+		dsSIMD8f b23 = dsSIMD8f_loadUnaligned(b[i].columns + 2);
+
+		dsSIMD8f result01 = dsSIMD8f_add(dsSIMD8f_add(
+				dsSIMD8f_mul(a0, dsSIMD8f_set1FromVec4(b01, 0)),
+				dsSIMD8f_mul(a1, dsSIMD8f_set1FromVec4(b01, 1))),
+			dsSIMD8f_mul(a2, dsSIMD8f_set1FromVec4(b01, 2)));
+		dsSIMD8f result23 = dsSIMD8f_add(dsSIMD8f_add(
+				dsSIMD8f_mul(a0, dsSIMD8f_set1FromVec4(b23, 0)),
+				dsSIMD8f_mul(a1, dsSIMD8f_set1FromVec4(b23, 1))),
+			dsSIMD8f_add(dsSIMD8f_mul(a2, dsSIMD8f_set1FromVec4(b23, 2)), a3));
+
+		dsSIMD8f_storeUnaligned(results[i].columns, result01);
+		dsSIMD8f_storeUnaligned(results[i].columns + 2, result23);
+	}
+}
+
+void dsMatrix44f_transformPointsArraySIMD8(
+	dsVector3xf* results, const dsMatrix44f* mat, const dsVector3xf* points, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(mat);
+	DS_ASSERT(points || count == 0);
+
+	// Two points are processed at once.
+	dsSIMD8f col0 = dsSIMD8f_combine4f(mat->columns[0].simd, mat->columns[0].simd);
+	dsSIMD8f col1 = dsSIMD8f_combine4f(mat->columns[1].simd, mat->columns[1].simd);
+	dsSIMD8f col2 = dsSIMD8f_combine4f(mat->columns[2].simd, mat->columns[2].simd);
+	dsSIMD8f col3 = dsSIMD8f_combine4f(mat->columns[3].simd, mat->columns[3].simd);
+	uint32_t pairCount = count & ~1U;
+	for (uint32_t i = 0; i < pairCount; i += 2)
+	{
+		dsSIMD8f point = dsSIMD8f_loadUnaligned(points + i);
+		dsSIMD8f_storeUnaligned(results + i, dsSIMD8f_add(dsSIMD8f_add(
+				dsSIMD8f_mul(col0, dsSIMD8f_set1FromVec4(point, 0)),
+				dsSIMD8f_mul(col1, dsSIMD8f_set1FromVec4(point, 1))),
+			dsSIMD8f_add(dsSIMD8f_mul(col2, dsSIMD8f_set1FromVec4(point, 2)), col3)));
+	}
+
+	if (pairCount < count)
+	{
+		dsSIMD4f point = points[pairCount].simd;
+		results[pairCount].simd = dsSIMD4f_add(dsSIMD4f_add(
+				dsSIMD4f_mul(mat->columns[0].simd, dsSIMD4f_set1FromVec(point, 0)),
+				dsSIMD4f_mul(mat->columns[1].simd, dsSIMD4f_set1FromVec(point, 1))),
+			dsSIMD4f_add(dsSIMD4f_mul(mat->columns[2].simd, dsSIMD4f_set1FromVec(point, 2)),
+				mat->columns[3].simd));
+	}
+}
+DS_SIMD_END()
+
+#if !DS_DETERMINISTIC_MATH
+DS_SIMD_START(DS_SIMD_FLOAT4,DS_SIMD_FMA)
+void dsMatrix44f_mulArrayFMA(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(a);
+	DS_ASSERT(b || count == 0);
+
+	dsSIMD4f a0 = a->columns[0].simd;
+	dsSIMD4f a1 = a->columns[1].simd;
+	dsSIMD4f a2 = a->columns[2].simd;
+	dsSIMD4f a3 = a->columns[3].simd;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		dsSIMD4f b0 = b[i].columns[0].simd;
+		dsSIMD4f b1 = b[i].columns[1].simd;
+		dsSIMD4f b2 = b[i].columns[2].simd;
+		dsSIMD4f b3 = b[i].columns[3].simd;
+
+		dsMatrix44f* result = results + i;
+		result->columns[0].simd = dsSIMD4f_fmadd(a0, dsSIMD4f_set1FromVec(b0, 0),
+			dsSIMD4f_fmadd(a1, dsSIMD4f_set1FromVec(b0, 1),
+			dsSIMD4f_fmadd(a2, dsSIMD4f_set1FromVec(b0, 2),
+			dsSIMD4f_mul(a3, dsSIMD4f_set1FromVec(b0, 3)))));
+		result->columns[1].simd = dsSIMD4f_fmadd(a0, dsSIMD4f_set1FromVec(b1, 0),
+			dsSIMD4f_fmadd(a1, dsSIMD4f_set1FromVec(b1, 1),
+			dsSIMD4f_fmadd(a2, dsSIMD4f_set1FromVec(b1, 2),
+			dsSIMD4f_mul(a3, dsSIMD4f_set1FromVec(b1, 3)))));
+		result->columns[2].simd = dsSIMD4f_fmadd(a0, dsSIMD4f_set1FromVec(b2, 0),
+			dsSIMD4f_fmadd(a1, dsSIMD4f_set1FromVec(b2, 1),
+			dsSIMD4f_fmadd(a2, dsSIMD4f_set1FromVec(b2, 2),
+			dsSIMD4f_mul(a3, dsSIMD4f_set1FromVec(b2, 3)))));
+		result->columns[3].simd = dsSIMD4f_fmadd(a0, dsSIMD4f_set1FromVec(b3, 0),
+			dsSIMD4f_fmadd(a1, dsSIMD4f_set1FromVec(b3, 1),
+			dsSIMD4f_fmadd(a2, dsSIMD4f_set1FromVec(b3, 2),
+			dsSIMD4f_mul(a3, dsSIMD4f_set1FromVec(b3, 3)))));
+	}
+}
+
+void dsMatrix44f_affineMulArrayFMA(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(a);
+	DS_ASSERT(b || count == 0);
+
+	dsSIMD4f a0 = a->columns[0].simd;
+	dsSIMD4f a1 = a->columns[1].simd;
+	dsSIMD4f a2 = a->columns[2].simd;
+	dsSIMD4f a3 = a->columns[3].simd;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		dsSIMD4f b0 = b[i].columns[0].simd;
+		dsSIMD4f b1 = b[i].columns[1].simd;
+		dsSIMD4f b2 = b[i].columns[2].simd;
+		dsSIMD4f b3 = b[i].columns[3].simd;
+
+		dsMatrix44f* result = results + i;
+		result->columns[0].simd = dsSIMD4f_fmadd(a0, dsSIMD4f_set1FromVec(b0, 0),
+			dsSIMD4f_fmadd(a1, dsSIMD4f_set1FromVec(b0, 1),
+			dsSIMD4f_mul(a2, dsSIMD4f_set1FromVec(b0, 2))));
+		result->columns[1].simd = dsSIMD4f_fmadd(a0, dsSIMD4f_set1FromVec(b1, 0),
+			dsSIMD4f_fmadd(a1, dsSIMD4f_set1FromVec(b1, 1),
+			dsSIMD4f_mul(a2, dsSIMD4f_set1FromVec(b1, 2))));
+		result->columns[2].simd = dsSIMD4f_fmadd(a0, dsSIMD4f_set1FromVec(b2, 0),
+			dsSIMD4f_fmadd(a1, dsSIMD4f_set1FromVec(b2, 1),
+			dsSIMD4f_mul(a2, dsSIMD4f_set1FromVec(b2, 2))));
+		result->columns[3].simd = dsSIMD4f_fmadd(a0, dsSIMD4f_set1FromVec(b3, 0),
+			dsSIMD4f_fmadd(a1, dsSIMD4f_set1FromVec(b3, 1),
+			dsSIMD4f_fmadd(a2, dsSIMD4f_set1FromVec(b3, 2), a3)));
+	}
+}
+
+void dsMatrix44f_transformPointsArrayFMA(
+	dsVector3xf* results, const dsMatrix44f* mat, const dsVector3xf* points, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(mat);
+	DS_ASSERT(points || count == 0);
+
+	dsSIMD4f col0 = mat->columns[0].simd;
+	dsSIMD4f col1 = mat->columns[1].simd;
+	dsSIMD4f col2 = mat->columns[2].simd;
+	dsSIMD4f col3 = mat->columns[3].simd;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		dsSIMD4f point = points[i].simd;
+		results[i].simd = dsSIMD4f_fmadd(col0, dsSIMD4f_set1FromVec(point, 0),
+			dsSIMD4f_fmadd(col1, dsSIMD4f_set1FromVec(point, 1),
+			dsSIMD4f_fmadd(col2, dsSIMD4f_set1FromVec(point, 2), col3)));
+	}
+}
+DS_SIMD_END()
+
+DS_SIMD_START(DS_SIMD_FLOAT8,DS_SIMD_FMA)
+void dsMatrix44f_mulArrayFMA8(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(a);
+	DS_ASSERT(b || count == 0);
+
+	dsSIMD8f a0 = dsSIMD8f_combine4f(a->columns[0].simd, a->columns[0].simd);
+	dsSIMD8f a1 = dsSIMD8f_combine4f(a->columns[1].simd, a->columns[1].simd);
+	dsSIMD8f a2 = dsSIMD8f_combine4f(a->columns[2].simd, a->columns[2].simd);
+	dsSIMD8f a3 = dsSIMD8f_combine4f(a->columns[3].simd, a->columns[3].simd);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		dsSIMD8f b01 = dsSIMD8f_loadUnaligned(b[i].columns);
+		dsSIMD8f b23 = dsSIMD8f_loadUnaligned(b[i].columns + 2);
+
+		dsSIMD8f result01 = dsSIMD8f_fmadd(a0, dsSIMD8f_set1FromVec4(b01, 0),
+			dsSIMD8f_fmadd(a1, dsSIMD8f_set1FromVec4(b01, 1),
+			dsSIMD8f_fmadd(a2, dsSIMD8f_set1FromVec4(b01, 2),
+			dsSIMD8f_mul(a3, dsSIMD8f_set1FromVec4(b01, 3)))));
+		dsSIMD8f result23 = dsSIMD8f_fmadd(a0, dsSIMD8f_set1FromVec4(b23, 0),
+			dsSIMD8f_fmadd(a1, dsSIMD8f_set1FromVec4(b23, 1),
+			dsSIMD8f_fmadd(a2, dsSIMD8f_set1FromVec4(b23, 2),
+			dsSIMD8f_mul(a3, dsSIMD8f_set1FromVec4(b23, 3)))));
+
+		dsSIMD8f_storeUnaligned(results[i].columns, result01);
+		dsSIMD8f_storeUnaligned(results[i].columns + 2, result23);
+	}
+}
+
+void dsMatrix44f_affineMulArrayFMA8(
+	dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(a);
+	DS_ASSERT(b || count == 0);
+
+	dsSIMD8f a0 = dsSIMD8f_combine4f(a->columns[0].simd, a->columns[0].simd);
+	dsSIMD8f a1 = dsSIMD8f_combine4f(a->columns[1].simd, a->columns[1].simd);
+	dsSIMD8f a2 = dsSIMD8f_combine4f(a->columns[2].simd, a->columns[2].simd);
+	dsSIMD8f a3 = dsSIMD8f_combine4f(dsSIMD4f_set1(0.0f), a->columns[3].simd);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		dsSIMD8f b01 = dsSIMD8f_loadUnaligned(b[i].columns);
+		dsSIMD8f b23 = dsSIMD8f_loadUnaligned(b[i].columns + 2);
+
+		dsSIMD8f result01 = dsSIMD8f_fmadd(a0, dsSIMD8f_set1FromVec4(b01, 0),
+			dsSIMD8f_fmadd(a1, dsSIMD8f_set1FromVec4(b01, 1),
+			dsSIMD8f_mul(a2, dsSIMD8f_set1FromVec4(b01, 2))));
+		dsSIMD8f result23 = dsSIMD8f_fmadd(a0, dsSIMD8f_set1FromVec4(b23, 0),
+			dsSIMD8f_fmadd(a1, dsSIMD8f_set1FromVec4(b23, 1),
+			dsSIMD8f_fmadd(a2, dsSIMD8f_set1FromVec4(b23, 2), a3)));
+
+		dsSIMD8f_storeUnaligned(results[i].columns, result01);
+		dsSIMD8f_storeUnaligned(results[i].columns + 2, result23);
+	}
+}
+
+void dsMatrix44f_transformPointsArrayFMA8(
+	dsVector3xf* results, const dsMatrix44f* mat, const dsVector3xf* points, uint32_t count)
+{
+	DS_ASSERT(results || count == 0);
+	DS_ASSERT(mat);
+	DS_ASSERT(points || count == 0);
+
+	dsSIMD8f col0 = dsSIMD8f_combine4f(mat->columns[0].simd, mat->columns[0].simd);
+	dsSIMD8f col1 = dsSIMD8f_combine4f(mat->columns[1].simd, mat->columns[1].simd);
+	dsSIMD8f col2 = dsSIMD8f_combine4f(mat->columns[2].simd, mat->columns[2].simd);
+	dsSIMD8f col3 = dsSIMD8f_combine4f(mat->columns[3].simd, mat->columns[3].simd);
+	uint32_t pairCount = count & ~1U;
+	for (uint32_t i = 0; i < pairCount; i += 2)
+	{
+		dsSIMD8f point = dsSIMD8f_loadUnaligned(points + i);
+		dsSIMD8f_storeUnaligned(results + i, dsSIMD8f_fmadd(col0, dsSIMD8f_set1FromVec4(point, 0),
+			dsSIMD8f_fmadd(col1, dsSIMD8f_set1FromVec4(point, 1),
+			dsSIMD8f_fmadd(col2, dsSIMD8f_set1FromVec4(point, 2), col3))));
+	}
+
+	if (pairCount < count)
+	{
+		dsSIMD4f point = points[pairCount].simd;
+		results[pairCount].simd = dsSIMD4f_fmadd(mat->columns[0].simd,
+			dsSIMD4f_set1FromVec(point, 0), dsSIMD4f_fmadd(mat->columns[1].simd,
+			dsSIMD4f_set1FromVec(point, 1), dsSIMD4f_fmadd(mat->columns[2].simd,
+			dsSIMD4f_set1FromVec(point, 2), mat->columns[3].simd)));
+	}
+}
+DS_SIMD_END()
+#endif // !DS_DETERMINISTIC_MATH
+
 #endif
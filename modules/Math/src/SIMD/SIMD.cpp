@@ -86,7 +86,7 @@ static dsSIMDFeatures detectSIMDFeatures()
 
 	__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx);
 	if (ebx & avx2Bit)
-		features |= dsSIMDFeatures_Double4;
+		features |= dsSIMDFeatures_Double4 | dsSIMDFeatures_Float8;
 
 	return features;
 }
@@ -108,3 +108,28 @@ static dsSIMDFeatures detectSIMDFeatures()
 const dsSIMDFeatures dsHostSIMDFeatures = detectSIMDFeatures();
 
 #endif
+
+static dsSIMDArrayImplementation getArrayImplementation()
+{
+#if DS_HAS_SIMD
+	dsSIMDFeatures features = dsHostSIMDFeatures;
+#if !DS_DETERMINISTIC_MATH
+	if ((features & (dsSIMDFeatures_FMA | dsSIMDFeatures_Float8)) ==
+			(dsSIMDFeatures_FMA | dsSIMDFeatures_Float8))
+	{
+		return dsSIMDArrayImplementation_FMA8;
+	}
+#endif
+	if (DS_SIMD_ALWAYS_FLOAT8 || (features & dsSIMDFeatures_Float8))
+		return dsSIMDArrayImplementation_SIMD8;
+#if !DS_DETERMINISTIC_MATH
+	if (DS_SIMD_ALWAYS_FMA || (features & dsSIMDFeatures_FMA))
+		return dsSIMDArrayImplementation_FMA;
+#endif
+	if (DS_SIMD_ALWAYS_FLOAT4 || (features & dsSIMDFeatures_Float4))
+		return dsSIMDArrayImplementation_SIMD;
+#endif
+	return dsSIMDArrayImplementation_Scalar;
+}
+
+const dsSIMDArrayImplementation dsHostSIMDArrayImplementation = getArrayImplementation();
@@ -15,12 +15,17 @@
  */
 
 #include "Determinism.h"
+#include <DeepSea/Core/Timer.h>
 #include <DeepSea/Math/Matrix44.h>
 #include <DeepSea/Math/Quaternion.h>
 #include <DeepSea/Math/Vector3.h>
 #include <DeepSea/Math/Vector4.h>
 #include <gtest/gtest.h>
 #include <cmath>
+#include <cstdio>
+#include <vector>
+
+#define DS_PERFORMANCE_TESTS 0
 
 // Handle older versions of gtest.
 #ifndef TYPED_TEST_SUITE
@@ -1448,6 +1453,110 @@ TYPED_TEST(Matrix44Test, MakePerspective)
 	EXPECT_EQ(TypeParam(2), matrix.values[3][2]);
 }
 
+typedef void (*MatrixArrayFunction)(dsMatrix44f* results, const dsMatrix44f* a,
+	const dsMatrix44f* b, uint32_t count);
+typedef void (*PointArrayFunction)(dsVector3xf* results, const dsMatrix44f* mat,
+	const dsVector3xf* points, uint32_t count);
+
+static const float arrayEpsilon = 1e-4f;
+
+static void createArrayMatrix(dsMatrix44f& matrix, unsigned int index)
+{
+	// Unique values for each matrix, keeping the last row affine.
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		for (unsigned int j = 0; j < 3; ++j)
+			matrix.values[i][j] = 5.0f*sinf((float)(index*16 + i*4 + j)*0.7f);
+		matrix.values[i][3] = i == 3 ? 1.0f : 0.0f;
+	}
+}
+
+static void expectMatricesNear(const dsMatrix44f& expected, const dsMatrix44f& actual,
+	float epsilon)
+{
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		for (unsigned int j = 0; j < 4; ++j)
+			EXPECT_NEAR(expected.values[i][j], actual.values[i][j], epsilon);
+	}
+}
+
+static void testMulArray(MatrixArrayFunction function, bool affine)
+{
+	// Odd count to test the remainder for implementations that process multiple elements.
+	const unsigned int count = 7;
+	dsMatrix44f a;
+	createArrayMatrix(a, count);
+	dsMatrix44f b[count], results[count];
+	for (unsigned int i = 0; i < count; ++i)
+		createArrayMatrix(b[i], i);
+
+	function(results, &a, b, count);
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		dsMatrix44f expected;
+		if (affine)
+			dsMatrix44_affineMul(expected, a, b[i]);
+		else
+			dsMatrix44_mul(expected, a, b[i]);
+		expectMatricesNear(expected, results[i], arrayEpsilon);
+	}
+
+	function(b, &a, b, count);
+	for (unsigned int i = 0; i < count; ++i)
+		expectMatricesNear(results[i], b[i], 0.0f);
+}
+
+static void testTransformPointsArray(PointArrayFunction function)
+{
+	const unsigned int count = 7;
+	dsMatrix44f matrix;
+	createArrayMatrix(matrix, count);
+	dsVector3xf points[count], results[count];
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		points[i].x = 3.0f*cosf((float)i);
+		points[i].y = 3.0f*sinf((float)i*1.3f);
+		points[i].z = (float)i - 2.5f;
+		// W should be ignored.
+		points[i].w = 10.0f;
+	}
+
+	function(results, &matrix, points, count);
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		dsVector4f point = {{points[i].x, points[i].y, points[i].z, 1.0f}};
+		dsVector4f expected;
+		dsMatrix44_transform(expected, matrix, point);
+		EXPECT_NEAR(expected.x, results[i].x, arrayEpsilon);
+		EXPECT_NEAR(expected.y, results[i].y, arrayEpsilon);
+		EXPECT_NEAR(expected.z, results[i].z, arrayEpsilon);
+	}
+
+	function(points, &matrix, points, count);
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		EXPECT_EQ(results[i].x, points[i].x);
+		EXPECT_EQ(results[i].y, points[i].y);
+		EXPECT_EQ(results[i].z, points[i].z);
+	}
+}
+
+TEST(Matrix44fTest, MulArray)
+{
+	testMulArray(&dsMatrix44f_mulArray, false);
+}
+
+TEST(Matrix44fTest, AffineMulArray)
+{
+	testMulArray(&dsMatrix44f_affineMulArray, true);
+}
+
+TEST(Matrix44fTest, TransformPointsArray)
+{
+	testTransformPointsArray(&dsMatrix44f_transformPointsArray);
+}
+
 #if DS_HAS_SIMD
 
 TEST(Matrix44fTest, MultiplySIMD)
@@ -4263,6 +4372,50 @@ TEST(Matrix44dTest, TransformCompisitionSIMD4)
 	EXPECT_EQ_DETERMINISTIC(0.3, extractedScale.z, epsilon);
 }
 
+
+TEST(Matrix44fTest, ArraySIMD)
+{
+	if (!(dsHostSIMDFeatures & dsSIMDFeatures_Float4))
+		return;
+
+	testMulArray(&dsMatrix44f_mulArraySIMD, false);
+	testMulArray(&dsMatrix44f_affineMulArraySIMD, true);
+	testTransformPointsArray(&dsMatrix44f_transformPointsArraySIMD);
+}
+
+TEST(Matrix44fTest, ArraySIMD8)
+{
+	if (!(dsHostSIMDFeatures & dsSIMDFeatures_Float8))
+		return;
+
+	testMulArray(&dsMatrix44f_mulArraySIMD8, false);
+	testMulArray(&dsMatrix44f_affineMulArraySIMD8, true);
+	testTransformPointsArray(&dsMatrix44f_transformPointsArraySIMD8);
+}
+
+#if !DS_DETERMINISTIC_MATH
+TEST(Matrix44fTest, ArrayFMA)
+{
+	if (!(dsHostSIMDFeatures & dsSIMDFeatures_FMA))
+		return;
+
+	testMulArray(&dsMatrix44f_mulArrayFMA, false);
+	testMulArray(&dsMatrix44f_affineMulArrayFMA, true);
+	testTransformPointsArray(&dsMatrix44f_transformPointsArrayFMA);
+}
+
+TEST(Matrix44fTest, ArrayFMA8)
+{
+	const dsSIMDFeatures requiredFeatures = dsSIMDFeatures_FMA | dsSIMDFeatures_Float8;
+	if ((dsHostSIMDFeatures & requiredFeatures) != requiredFeatures)
+		return;
+
+	testMulArray(&dsMatrix44f_mulArrayFMA8, false);
+	testMulArray(&dsMatrix44f_affineMulArrayFMA8, true);
+	testTransformPointsArray(&dsMatrix44f_transformPointsArrayFMA8);
+}
+#endif // !DS_DETERMINISTIC_MATH
+
 #endif // DS_HAS_SIMD
 
 TEST(Matrix44Test, ConvertFloatToDouble)
@@ -4322,3 +4475,111 @@ TEST(Matrix44Test, ConvertDoubleToFloat)
 	EXPECT_FLOAT_EQ((float)matrixd.values[2][2], matrixf.values[2][2]);
 	EXPECT_FLOAT_EQ((float)matrixd.values[2][3], matrixf.values[2][3]);
 }
+
+#if DS_PERFORMANCE_TESTS
+static void timeMatrixArray(const char* name, MatrixArrayFunction function, dsMatrix44f* results,
+	const dsMatrix44f* a, const dsMatrix44f* b, uint32_t count, dsTimer timer)
+{
+	const unsigned int iterations = 20;
+	uint64_t start = dsTimer_currentTicks();
+	for (unsigned int i = 0; i < iterations; ++i)
+		function(results, a, b, count);
+	uint64_t end = dsTimer_currentTicks();
+	printf("%s: %f Melements/s\n", name,
+		(double)count*iterations/dsTimer_ticksToSeconds(timer, end - start)*1e-6);
+}
+
+static void timePointArray(const char* name, PointArrayFunction function, dsVector3xf* results,
+	const dsMatrix44f* mat, const dsVector3xf* points, uint32_t count, dsTimer timer)
+{
+	const unsigned int iterations = 20;
+	uint64_t start = dsTimer_currentTicks();
+	for (unsigned int i = 0; i < iterations; ++i)
+		function(results, mat, points, count);
+	uint64_t end = dsTimer_currentTicks();
+	printf("%s: %f Melements/s\n", name,
+		(double)count*iterations/dsTimer_ticksToSeconds(timer, end - start)*1e-6);
+}
+
+static void scalarAffineMulArray(dsMatrix44f* results, const dsMatrix44f* a, const dsMatrix44f* b,
+	uint32_t count)
+{
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		dsMatrix44f temp;
+		dsMatrix44_affineMul(temp, *a, b[i]);
+		results[i] = temp;
+	}
+}
+
+static void scalarTransformPointsArray(dsVector3xf* results, const dsMatrix44f* mat,
+	const dsVector3xf* points, uint32_t count)
+{
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		dsVector4f point = {{points[i].x, points[i].y, points[i].z, 1.0f}};
+		dsVector4f result;
+		dsMatrix44_transform(result, *mat, point);
+		results[i].x = result.x;
+		results[i].y = result.y;
+		results[i].z = result.z;
+		results[i].w = result.w;
+	}
+}
+
+TEST(Matrix44fPerformanceTest, ArrayFunctions)
+{
+	const uint32_t count = 100000;
+	dsTimer timer = dsTimer_create();
+	dsMatrix44f a;
+	createArrayMatrix(a, count);
+	std::vector<dsMatrix44f> matrices(count), matrixResults(count);
+	std::vector<dsVector3xf> points(count), pointResults(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		createArrayMatrix(matrices[i], i);
+		points[i].x = matrices[i].values[0][0];
+		points[i].y = matrices[i].values[1][1];
+		points[i].z = matrices[i].values[2][2];
+		points[i].w = 1.0f;
+	}
+
+	timeMatrixArray("scalar affineMulArray", &scalarAffineMulArray, matrixResults.data(), &a,
+		matrices.data(), count, timer);
+	timePointArray("scalar transformPointsArray", &scalarTransformPointsArray,
+		pointResults.data(), &a, points.data(), count, timer);
+#if DS_HAS_SIMD
+	if (dsHostSIMDFeatures & dsSIMDFeatures_Float4)
+	{
+		timeMatrixArray("SIMD affineMulArray", &dsMatrix44f_affineMulArraySIMD,
+			matrixResults.data(), &a, matrices.data(), count, timer);
+		timePointArray("SIMD transformPointsArray", &dsMatrix44f_transformPointsArraySIMD,
+			pointResults.data(), &a, points.data(), count, timer);
+	}
+	if (dsHostSIMDFeatures & dsSIMDFeatures_Float8)
+	{
+		timeMatrixArray("SIMD8 affineMulArray", &dsMatrix44f_affineMulArraySIMD8,
+			matrixResults.data(), &a, matrices.data(), count, timer);
+		timePointArray("SIMD8 transformPointsArray", &dsMatrix44f_transformPointsArraySIMD8,
+			pointResults.data(), &a, points.data(), count, timer);
+	}
+#if !DS_DETERMINISTIC_MATH
+	if (dsHostSIMDFeatures & dsSIMDFeatures_FMA)
+	{
+		timeMatrixArray("FMA affineMulArray", &dsMatrix44f_affineMulArrayFMA,
+			matrixResults.data(), &a, matrices.data(), count, timer);
+		timePointArray("FMA transformPointsArray", &dsMatrix44f_transformPointsArrayFMA,
+			pointResults.data(), &a, points.data(), count, timer);
+	}
+	if ((dsHostSIMDFeatures & dsSIMDFeatures_FMA) &&
+		(dsHostSIMDFeatures & dsSIMDFeatures_Float8))
+	{
+		timeMatrixArray("FMA8 affineMulArray", &dsMatrix44f_affineMulArrayFMA8,
+			matrixResults.data(), &a, matrices.data(), count, timer);
+		timePointArray("FMA8 transformPointsArray", &dsMatrix44f_transformPointsArrayFMA8,
+			pointResults.data(), &a, points.data(), count, timer);
+	}
+#endif
+#endif
+}
+#endif // DS_PERFORMANCE_TESTS
@@ -19,6 +19,7 @@
 #include <DeepSea/Math/SIMD/SIMD.h>
 #include <DeepSea/Math/Types.h>
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cmath>
 
 #if DS_HAS_SIMD
@@ -600,6 +601,116 @@ TEST(SIMDTest, Double4)
 	SIMDTest_Double4();
 }
 
+DS_SIMD_START(DS_SIMD_FLOAT4,DS_SIMD_FLOAT8);
+static void SIMDTest_Float8()
+{
+	constexpr float epsilon = 1e-6f;
+	float padding1; // Keep next value unalied.
+	DS_UNUSED(padding1);
+	float cpuA[8] = {1.2f, 3.4f, 5.6f, 7.8f, 9.1f, 2.3f, 4.5f, 6.7f};
+	DS_ALIGN(32) float cpuB[8] = {-9.8f, -7.6f, -5.4f, -3.2f, -1.9f, -8.7f, -6.5f, -4.3f};
+	DS_ALIGN(32) float cpuResult[8];
+	float padding2; // Keep next value unalied.
+	DS_UNUSED(padding2);
+	float unalginedCPUResult[8];
+
+	dsSIMD8f a = dsSIMD8f_loadUnaligned(&cpuA);
+	dsSIMD8f b = dsSIMD8f_load(&cpuB);
+
+	dsSIMD8f result = dsSIMD8f_set1(0.1f);
+	dsSIMD8f_storeUnaligned(&unalginedCPUResult, result);
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(0.1f, unalginedCPUResult[i]);
+
+	EXPECT_EQ(cpuA[0], dsSIMD8f_get(a, 0));
+	EXPECT_EQ(cpuA[3], dsSIMD8f_get(a, 3));
+	EXPECT_EQ(cpuA[4], dsSIMD8f_get(a, 4));
+	EXPECT_EQ(cpuA[7], dsSIMD8f_get(a, 7));
+
+	dsVector4f cpuResult4;
+	dsSIMD4f_store(&cpuResult4, dsSIMD8f_get4f(a, 0));
+	EXPECT_EQ(cpuA[0], cpuResult4.x);
+	EXPECT_EQ(cpuA[1], cpuResult4.y);
+	EXPECT_EQ(cpuA[2], cpuResult4.z);
+	EXPECT_EQ(cpuA[3], cpuResult4.w);
+
+	dsSIMD4f_store(&cpuResult4, dsSIMD8f_get4f(a, 1));
+	EXPECT_EQ(cpuA[4], cpuResult4.x);
+	EXPECT_EQ(cpuA[5], cpuResult4.y);
+	EXPECT_EQ(cpuA[6], cpuResult4.z);
+	EXPECT_EQ(cpuA[7], cpuResult4.w);
+
+	result = dsSIMD8f_combine4f(dsSIMD4f_set4(0.1f, 0.2f, 0.3f, 0.4f),
+		dsSIMD4f_set4(0.5f, 0.6f, 0.7f, 0.8f));
+	dsSIMD8f_store(&cpuResult, result);
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ((float)(i + 1)*0.1f, cpuResult[i]);
+
+	result = dsSIMD8f_neg(a);
+	dsSIMD8f_store(&cpuResult, result);
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(-cpuA[i], cpuResult[i]);
+
+	result = dsSIMD8f_add(a, b);
+	dsSIMD8f_store(&cpuResult, result);
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(cpuA[i] + cpuB[i], cpuResult[i]);
+
+	result = dsSIMD8f_sub(a, b);
+	dsSIMD8f_store(&cpuResult, result);
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(cpuA[i] - cpuB[i], cpuResult[i]);
+
+	result = dsSIMD8f_mul(a, b);
+	dsSIMD8f_store(&cpuResult, result);
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(cpuA[i]*cpuB[i], cpuResult[i]);
+
+	result = dsSIMD8f_div(a, b);
+	dsSIMD8f_store(&cpuResult, result);
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_NEAR(cpuA[i]/cpuB[i], cpuResult[i], epsilon);
+
+	result = dsSIMD8f_sqrt(a);
+	dsSIMD8f_store(&cpuResult, result);
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_NEAR(std::sqrt(cpuA[i]), cpuResult[i], epsilon);
+
+	result = dsSIMD8f_abs(b);
+	dsSIMD8f_store(&cpuResult, result);
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(-cpuB[i], cpuResult[i]);
+
+	dsSIMD8f negA = dsSIMD8f_neg(a);
+	result = dsSIMD8f_min(negA, b);
+	dsSIMD8f_store(&cpuResult, result);
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(std::min(-cpuA[i], cpuB[i]), cpuResult[i]);
+
+	result = dsSIMD8f_max(negA, b);
+	dsSIMD8f_store(&cpuResult, result);
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(std::max(-cpuA[i], cpuB[i]), cpuResult[i]);
+}
+DS_SIMD_END();
+
+TEST(SIMDTest, Float8)
+{
+#if DS_SIMD_ALWAYS_FLOAT8
+	ASSERT_TRUE(dsHostSIMDFeatures & dsSIMDFeatures_Float8);
+#else
+	if (dsHostSIMDFeatures & dsSIMDFeatures_Float8)
+		DS_LOG_INFO("SIMDTest", "Enabling float8 SIMD at runtime.");
+	else
+	{
+		DS_LOG_INFO("SIMDTest", "Skipping float8 SIMD tests.");
+		return;
+	}
+#endif
+
+	SIMDTest_Float8();
+}
+
 DS_SIMD_START(DS_SIMD_FLOAT4);
 static void SIMDTest_CompareLogicFloat4()
 {
@@ -1073,6 +1184,94 @@ TEST(SIMDTest, CompareLogicDouble4)
 	SIMDTest_CompareLogicDouble4();
 }
 
+DS_SIMD_START(DS_SIMD_FLOAT8);
+static void SIMDTest_CompareLogicFloat8()
+{
+	DS_ALIGN(32) float cpuA[8] = {1.2f, 3.4f, 5.6f, 7.8f, 9.1f, 2.3f, 4.5f, 6.7f};
+	DS_ALIGN(32) float cpuB[8] = {1.2f, -3.4f, 6.5f, 7.8f, -9.1f, 2.3f, 5.4f, 6.7f};
+	DS_ALIGN(32) float cpuResult[8];
+	DS_ALIGN(32) uint32_t cpuMask[8];
+
+	dsSIMD8f a = dsSIMD8f_load(&cpuA);
+	dsSIMD8f b = dsSIMD8f_load(&cpuB);
+
+	dsSIMD8fb_store(&cpuMask, dsSIMD8f_cmpeq(a, b));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(cpuA[i] == cpuB[i] ? 0xFFFFFFFF : 0U, cpuMask[i]);
+
+	dsSIMD8fb_store(&cpuMask, dsSIMD8f_cmpne(a, b));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(cpuA[i] != cpuB[i] ? 0xFFFFFFFF : 0U, cpuMask[i]);
+
+	dsSIMD8fb_store(&cpuMask, dsSIMD8f_cmplt(a, b));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(cpuA[i] < cpuB[i] ? 0xFFFFFFFF : 0U, cpuMask[i]);
+
+	dsSIMD8fb_store(&cpuMask, dsSIMD8f_cmple(a, b));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(cpuA[i] <= cpuB[i] ? 0xFFFFFFFF : 0U, cpuMask[i]);
+
+	dsSIMD8fb_store(&cpuMask, dsSIMD8f_cmpgt(a, b));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(cpuA[i] > cpuB[i] ? 0xFFFFFFFF : 0U, cpuMask[i]);
+
+	dsSIMD8fb_store(&cpuMask, dsSIMD8f_cmpge(a, b));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(cpuA[i] >= cpuB[i] ? 0xFFFFFFFF : 0U, cpuMask[i]);
+
+	dsSIMD8fb lessMask = dsSIMD8f_cmplt(a, b);
+	dsSIMD8fb equalMask = dsSIMD8f_cmpeq(a, b);
+	dsSIMD8f_store(&cpuResult, dsSIMD8f_select(lessMask, a, b));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(cpuA[i] < cpuB[i] ? cpuA[i] : cpuB[i], cpuResult[i]);
+
+	dsSIMD8fb_store(&cpuMask, dsSIMD8fb_or(lessMask, equalMask));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(cpuA[i] <= cpuB[i] ? 0xFFFFFFFF : 0U, cpuMask[i]);
+
+	dsSIMD8fb_store(&cpuMask, dsSIMD8fb_and(lessMask, equalMask));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(0U, cpuMask[i]);
+
+	dsSIMD8fb_store(&cpuMask, dsSIMD8fb_andnot(equalMask, dsSIMD8fb_true()));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(cpuA[i] != cpuB[i] ? 0xFFFFFFFF : 0U, cpuMask[i]);
+
+	dsSIMD8fb_store(&cpuMask, dsSIMD8fb_xor(equalMask, dsSIMD8fb_not(equalMask)));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_EQ(0xFFFFFFFF, cpuMask[i]);
+
+	EXPECT_EQ(0x44U, dsSIMD8fb_mask(lessMask));
+	EXPECT_EQ(0xA9U, dsSIMD8fb_mask(equalMask));
+	EXPECT_EQ(0xFFU, dsSIMD8fb_mask(dsSIMD8fb_true()));
+	EXPECT_EQ(0U, dsSIMD8fb_mask(dsSIMD8fb_false()));
+
+	EXPECT_EQ(0xFFFFFFFF, dsSIMD8fb_any(lessMask));
+	EXPECT_EQ(0U, dsSIMD8fb_all(lessMask));
+	EXPECT_EQ(0U, dsSIMD8fb_any(dsSIMD8fb_false()));
+	EXPECT_EQ(0xFFFFFFFF, dsSIMD8fb_all(dsSIMD8fb_true()));
+	EXPECT_EQ(0xFFFFFFFF, dsSIMD8fb_all(dsSIMD8fb_set1(0xFFFFFFFF)));
+	EXPECT_EQ(0xFFFFFFFF, dsSIMD8fb_any(dsSIMD8fb_loadUnaligned(&cpuMask)));
+}
+DS_SIMD_END();
+
+TEST(SIMDTest, CompareLogicFloat8)
+{
+#if DS_SIMD_ALWAYS_FLOAT8
+	ASSERT_TRUE(dsHostSIMDFeatures & dsSIMDFeatures_Float8);
+#else
+	if (dsHostSIMDFeatures & dsSIMDFeatures_Float8)
+		DS_LOG_INFO("SIMDTest", "Enabling float8 compare logic SIMD at runtime.");
+	else
+	{
+		DS_LOG_INFO("SIMDTest", "Skipping float8 compare logic SIMD tests.");
+		return;
+	}
+#endif
+
+	SIMDTest_CompareLogicFloat8();
+}
+
 DS_SIMD_START(DS_SIMD_FLOAT4,DS_SIMD_INT);
 static void SIMDTest_FloatBitfield4()
 {
@@ -2341,6 +2540,55 @@ TEST(SIMDTest, FMADouble4)
 	SIMDTest_FMADouble4();
 }
 
+DS_SIMD_START(DS_SIMD_FLOAT8,DS_SIMD_FMA);
+static void SIMDTest_FMAFloat8()
+{
+	constexpr float epsilon = 1e-5f;
+	DS_ALIGN(32) float cpuA[8] = {1.2f, 3.4f, 5.6f, 7.8f, 9.1f, 2.3f, 4.5f, 6.7f};
+	DS_ALIGN(32) float cpuB[8] = {-9.8f, -7.6f, -5.4f, -3.2f, -1.9f, -8.7f, -6.5f, -4.3f};
+	DS_ALIGN(32) float cpuC[8] = {7.8f, 5.6f, -3.4f, -1.2f, 2.1f, -4.3f, 6.5f, -8.7f};
+	DS_ALIGN(32) float cpuResult[8];
+
+	dsSIMD8f a = dsSIMD8f_load(&cpuA);
+	dsSIMD8f b = dsSIMD8f_load(&cpuB);
+	dsSIMD8f c = dsSIMD8f_load(&cpuC);
+
+	dsSIMD8f_store(&cpuResult, dsSIMD8f_fmadd(a, b, c));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_NEAR(cpuA[i]*cpuB[i] + cpuC[i], cpuResult[i], epsilon);
+
+	dsSIMD8f_store(&cpuResult, dsSIMD8f_fmsub(a, b, c));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_NEAR(cpuA[i]*cpuB[i] - cpuC[i], cpuResult[i], epsilon);
+
+	dsSIMD8f_store(&cpuResult, dsSIMD8f_fnmadd(a, b, c));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_NEAR(-(cpuA[i]*cpuB[i]) + cpuC[i], cpuResult[i], epsilon);
+
+	dsSIMD8f_store(&cpuResult, dsSIMD8f_fnmsub(a, b, c));
+	for (unsigned int i = 0; i < 8; ++i)
+		EXPECT_NEAR(-(cpuA[i]*cpuB[i]) - cpuC[i], cpuResult[i], epsilon);
+}
+DS_SIMD_END();
+
+TEST(SIMDTest, FMAFloat8)
+{
+	dsSIMDFeatures features = dsSIMDFeatures_FMA | dsSIMDFeatures_Float8;
+#if DS_SIMD_ALWAYS_FMA && DS_SIMD_ALWAYS_FLOAT8
+	ASSERT_EQ(features, dsHostSIMDFeatures & features);
+#else
+	if ((dsHostSIMDFeatures & features) == features)
+		DS_LOG_INFO("SIMDTest", "Enabling float8 fused multiply-add SIMD at runtime.");
+	else
+	{
+		DS_LOG_INFO("SIMDTest", "Skipping float8 fused multiply-add SIMD tests.");
+		return;
+	}
+#endif
+
+	SIMDTest_FMAFloat8();
+}
+
 #endif // !DS_DETERMINISTIC_MATH
 
 DS_SIMD_START(DS_SIMD_FLOAT4,DS_SIMD_HALF_FLOAT);
@@ -203,14 +203,6 @@ static BufferInfo* getDrawBuffer(
 	return bufferInfo;
 }
 
-static int particleRefCompare(const void* left, const void* right)
-{
-	// Sort from far to near. These are in view space, so -Z faces the viewer.s
-	const ParticleRef* leftRef = (ParticleRef*)left;
-	const ParticleRef* rightRef = (ParticleRef*)right;
-	return DS_CMP(leftRef->viewZ, rightRef->viewZ);
-}
-
 static void collectParticles(dsParticleDraw* drawer, const dsMatrix44f* viewMatrix,
 	const dsParticleEmitter* const* emitters, uint32_t emitterCount, uint32_t particleCount)
 {
@@ -247,7 +239,10 @@ static void collectParticles(dsParticleDraw* drawer, const dsMatrix44f* viewMatr
 	DS_UNUSED(curParticleCount);
 	DS_ASSERT(curParticleCount == particleCount);
 	DS_ASSERT(curParticleRef == drawer->particles + particleCount);
-	qsort(drawer->particles, particleCount, sizeof(ParticleRef), &particleRefCompare);
+	// Sort from far to near. These are in view space, so -Z faces the viewer. The second half of
+	// the particle array is reserved as temporary space for the sort.
+	DS_VERIFY(dsRadixSortFloatKey(drawer->particles, drawer->particles + drawer->maxParticles,
+		particleCount, sizeof(ParticleRef), offsetof(ParticleRef, viewZ)));
 
 	DS_PROFILE_FUNC_RETURN_VOID();
 }
@@ -607,11 +602,11 @@ bool dsParticleDraw_draw(dsParticleDraw* drawer, dsCommandBuffer* commandBuffer,
 	}
 
 	// Make sure we have enough storage for the particle data. Use max particles to reach a steady
-	// state sooner.
+	// state sooner. Twice the space is needed to leave room for sorting.
 	if (maxParticles > drawer->maxParticles)
 	{
 		ParticleRef* newParticles = (ParticleRef*)dsAllocator_reallocWithFallback(drawer->allocator,
-			drawer->particles, 0, maxParticles*sizeof(ParticleRef));
+			drawer->particles, 0, maxParticles*2*sizeof(ParticleRef));
 		if (!newParticles)
 			DS_PROFILE_FUNC_RETURN(false);
 
@@ -59,11 +59,13 @@ extern "C"
  * @param resourceManager The resource manager to acquire resource contexts from.
  * @param threadCount The initial number of threads. This may not exceed the maximum number of
  *     resource contexts.
+ * @param flags Flags to control the behavior of the thread pool.
  * @param stackSize The size of the stack of each thread in bytes. Set to 0 for the system default.
  * @return The thread pool or NULL if an error occurred.
  */
 DS_RENDER_EXPORT dsThreadPool* dsResourceManager_createThreadPool(dsAllocator* allocator,
-	dsResourceManager* resourceManager, unsigned int threadCount, size_t stackSize);
+	dsResourceManager* resourceManager, unsigned int threadCount, dsThreadPoolFlags flags,
+	size_t stackSize);
 
 /**
  * @brief Acquires a resource context for the current thread.
@@ -117,6 +117,28 @@ DS_RENDER_EXPORT dsTextureData* dsTextureData_loadArchive(
  */
 DS_RENDER_EXPORT dsTextureData* dsTextureData_loadStream(dsAllocator* allocator, dsStream* stream);
 
+/**
+ * @brief Loads a texture file asynchronously to a new texture data instance.
+ *
+ * This will try each of the supported texture file formats. Both reading and decoding the file
+ * happen on an IO thread, so the allocators must be thread-safe. The texture itself must still be
+ * created with dsTextureData_createTexture() on a thread that may create resources.
+ *
+ * @remark errno will be set on failure.
+ * @param asyncIO The asynchronous IO manager to read the file with.
+ * @param allocator The allocator to create the texture data with.
+ * @param tempAllocator The allocator for the file contents. This must support freeing memory. If
+ *     NULL, allocator will be used.
+ * @param file The file to load. The path will be copied.
+ * @param completeFunc The function to call with the loaded texture data on the IO thread.
+ * @param userData The user data to pass to completeFunc.
+ * @return False if the load couldn't be started. If true is returned, completeFunc is guaranteed
+ *     to be called.
+ */
+DS_RENDER_EXPORT bool dsTextureData_loadAsync(dsAsyncIO* asyncIO, dsAllocator* allocator,
+	dsAllocator* tempAllocator, const dsAsyncIOFile* file,
+	dsAsyncLoadCompleteFunction completeFunc, void* userData);
+
 /**
  * @brief Loads a texture file to a new texture instance.
  *
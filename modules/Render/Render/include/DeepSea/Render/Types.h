@@ -17,6 +17,7 @@
 #pragma once
 
 #include <DeepSea/Core/Config.h>
+#include <DeepSea/Core/Memory/Types.h>
 #include <DeepSea/Core/Thread/Types.h>
 #include <DeepSea/Geometry/Types.h>
 #include <DeepSea/Math/Types.h>
@@ -2068,6 +2069,14 @@ struct dsRenderer
 	 */
 	uint64_t frameNumber;
 
+	/**
+	 * @brief Allocator for temporary memory used while processing a frame.
+	 *
+	 * Memory may be allocated from any thread and is reclaimed automatically by
+	 * dsRenderer_beginFrame(). Allocations remain valid for the current and previous frame.
+	 */
+	dsFrameAllocator* frameAllocator;
+
 	// --------------------------------- Renderer capabilities -------------------------------------
 
 	/**
@@ -20,6 +20,7 @@
 #include "ResourceCommandBuffers.h"
 
 #include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Memory/FrameAllocator.h>
 #include <DeepSea/Core/Memory/StackAllocator.h>
 #include <DeepSea/Core/Thread/Thread.h>
 #include <DeepSea/Core/Assert.h>
@@ -50,6 +51,8 @@
 _Static_assert(DS_MAX_ATTACHMENTS == MSL_MAX_ATTACHMENTS, "Max attachments don't match.");
 
 #define MAX_STACK_STRING_LENGTH 131072
+// Keep temporary memory for the current and previous frame.
+#define FRAME_ALLOCATOR_FRAME_COUNT 2
 
 static bool getBlitSurfaceInfo(dsGfxFormat* outFormat, dsTextureDim* outDim, uint32_t* outWidth,
 	uint32_t* outHeight, uint32_t* outLayers, uint32_t* outMipLevels, const dsRenderer* renderer,
@@ -620,6 +623,8 @@ bool dsRenderer_beginFrame(dsRenderer* renderer)
 
 	++renderer->frameNumber;
 	renderer->mainCommandBuffer->frameActive = true;
+	if (renderer->frameAllocator)
+		DS_VERIFY(dsFrameAllocator_beginFrame(renderer->frameAllocator, renderer->frameNumber));
 
 	// Gurarantee that errors in one frame won't carry over into the next.
 	renderer->mainCommandBuffer->boundSurface = NULL;
@@ -1687,6 +1692,17 @@ bool dsRenderer_initializeResources(dsRenderer* renderer)
 		renderer->resourceManager, renderer->allocator);
 	renderer->_resourceCommandBuffers = dsResourceCommandBuffers_create(
 		renderer, renderer->allocator);
+	renderer->frameAllocator = dsFrameAllocator_create(renderer->allocator,
+		DS_DEFAULT_FRAME_ALLOCATOR_BLOCK_SIZE, FRAME_ALLOCATOR_FRAME_COUNT);
+	if (!renderer->frameAllocator)
+	{
+		dsGPUProfileContext_destroy(renderer->_profileContext);
+		dsResourceCommandBuffers_destroy(renderer->_resourceCommandBuffers);
+		renderer->_profileContext = NULL;
+		renderer->_resourceCommandBuffers = NULL;
+		return false;
+	}
+
 	return true;
 }
 
@@ -1700,6 +1716,8 @@ bool dsRenderer_shutdownResources(dsRenderer* renderer)
 
 	dsGPUProfileContext_destroy(renderer->_profileContext);
 	dsResourceCommandBuffers_destroy(renderer->_resourceCommandBuffers);
+	dsFrameAllocator_destroy(renderer->frameAllocator);
+	renderer->frameAllocator = NULL;
 	return true;
 }
 
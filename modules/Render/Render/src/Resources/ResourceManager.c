@@ -60,7 +60,8 @@ const char* dsResourceManager_noContextError = "Resources can only be manipulate
 	"thread or threads that have created a resource context.";
 
 dsThreadPool* dsResourceManager_createThreadPool(dsAllocator* allocator,
-	dsResourceManager* resourceManager, unsigned int threadCount, size_t stackSize)
+	dsResourceManager* resourceManager, unsigned int threadCount, dsThreadPoolFlags flags,
+	size_t stackSize)
 {
 	if (!allocator || !resourceManager)
 	{
@@ -77,8 +78,8 @@ dsThreadPool* dsResourceManager_createThreadPool(dsAllocator* allocator,
 		return NULL;
 	}
 
-	return dsThreadPool_create(allocator, threadCount, stackSize, &startThreadFunc, &endThreadFunc,
-		resourceManager);
+	return dsThreadPool_create(allocator, threadCount, flags, stackSize, &startThreadFunc,
+		&endThreadFunc, resourceManager);
 }
 
 bool dsResourceManager_acquireResourceContext(dsResourceManager* resourceManager)
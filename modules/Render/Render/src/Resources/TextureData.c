@@ -17,8 +17,10 @@
 #include <DeepSea/Render/Resources/TextureData.h>
 
 #include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Streams/AsyncIO.h>
 #include <DeepSea/Core/Streams/FileArchive.h>
 #include <DeepSea/Core/Streams/FileStream.h>
+#include <DeepSea/Core/Streams/MemoryStream.h>
 #include <DeepSea/Core/Streams/ResourceStream.h>
 #include <DeepSea/Core/Streams/Stream.h>
 #include <DeepSea/Core/Assert.h>
@@ -32,6 +34,8 @@
 #include <DeepSea/Render/Resources/Texture.h>
 #include <DeepSea/Render/Types.h>
 
+#include <string.h>
+
 dsTextureData* dsTextureData_loadDDS(
 	bool* isDDS, dsAllocator* allocator, dsStream* stream, const char* filePath);
 dsTextureData* dsTextureData_loadKTX(
@@ -162,6 +166,65 @@ dsTexture* dsTextureData_createTexture(dsResourceManager* resourceManager,
 	return dsTexture_create(resourceManager, allocator, usage, memoryHints, &info, data, dataSize);
 }
 
+typedef struct LoadAsyncContext
+{
+	dsAllocator* allocator;
+	dsAllocator* tempAllocator;
+	dsAsyncLoadCompleteFunction completeFunc;
+	void* userData;
+} LoadAsyncContext;
+
+static void loadAsyncComplete(void* userData, const dsAsyncIORequest* request, void* data,
+	size_t size, int errorCode)
+{
+	DS_PROFILE_FUNC_START();
+
+	LoadAsyncContext* context = (LoadAsyncContext*)userData;
+	const char* filePath = request->file.path;
+	dsTextureData* textureData = NULL;
+	if (data)
+	{
+		dsMemoryStream stream;
+		DS_VERIFY(dsMemoryStream_open(&stream, data, size));
+
+		bool isFormat = true;
+		for (size_t i = 0; i < DS_ARRAY_SIZE(loadTextureFuncs); ++i)
+		{
+			textureData = loadTextureFuncs[i](&isFormat, context->allocator, (dsStream*)&stream,
+				filePath);
+			if (textureData || isFormat)
+				break;
+
+			if (i < DS_ARRAY_SIZE(loadTextureFuncs) - 1)
+				dsMemoryStream_seek(&stream, 0, dsStreamSeekWay_Beginning);
+		}
+
+		// If check is false, we couldn't find the format.
+		if (!isFormat)
+		{
+			DS_LOG_ERROR_F(DS_RENDER_LOG_TAG,
+				"Unknown texture file format when reading file '%s'.", filePath);
+			errno = EFORMAT;
+		}
+
+		if (!textureData)
+			errorCode = errno;
+		DS_VERIFY(dsAllocator_free(context->tempAllocator, data));
+	}
+	else
+	{
+		DS_LOG_ERROR_F(DS_RENDER_LOG_TAG, "Couldn't open texture file '%s'.", filePath);
+		if (errorCode == 0)
+			errorCode = EFORMAT;
+	}
+
+	dsAsyncLoadCompleteFunction completeFunc = context->completeFunc;
+	void* completeUserData = context->userData;
+	DS_VERIFY(dsAllocator_free(context->tempAllocator, context));
+	completeFunc(completeUserData, textureData, errorCode);
+	DS_PROFILE_FUNC_RETURN_VOID();
+}
+
 dsTextureData* dsTextureData_loadFile(dsAllocator* allocator, const char* filePath)
 {
 	DS_PROFILE_FUNC_START();
@@ -340,6 +403,52 @@ dsTextureData* dsTextureData_loadStream(dsAllocator* allocator, dsStream* stream
 	DS_PROFILE_FUNC_RETURN(textureData);
 }
 
+bool dsTextureData_loadAsync(dsAsyncIO* asyncIO, dsAllocator* allocator,
+	dsAllocator* tempAllocator, const dsAsyncIOFile* file,
+	dsAsyncLoadCompleteFunction completeFunc, void* userData)
+{
+	if (!asyncIO || !allocator || !file || !file->path || !completeFunc)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (!tempAllocator)
+		tempAllocator = allocator;
+
+	if (!tempAllocator->freeFunc)
+	{
+		errno = EINVAL;
+		DS_LOG_ERROR(DS_RENDER_LOG_TAG,
+			"Texture data temp allocator must support freeing memory for async loads.");
+		return false;
+	}
+
+	LoadAsyncContext* context = DS_ALLOCATE_OBJECT(tempAllocator, LoadAsyncContext);
+	if (!context)
+		return false;
+
+	context->allocator = allocator;
+	context->tempAllocator = tempAllocator;
+	context->completeFunc = completeFunc;
+	context->userData = userData;
+
+	dsAsyncIORequest request;
+	memset(&request, 0, sizeof(request));
+	request.file = *file;
+	request.allocator = tempAllocator;
+	request.completeFunc = &loadAsyncComplete;
+	request.userData = context;
+	request.completeOnIOThread = true;
+	if (!dsAsyncIO_addRequests(asyncIO, &request, 1))
+	{
+		DS_VERIFY(dsAllocator_free(tempAllocator, context));
+		return false;
+	}
+
+	return true;
+}
+
 dsTexture* dsTextureData_loadFileToTexture(dsResourceManager* resourceManager,
 	dsAllocator* textureAllocator, dsAllocator* tempAllocator, const char* filePath,
 	const dsTextureDataOptions* options, dsTextureUsage usage, dsGfxMemory memoryHints)
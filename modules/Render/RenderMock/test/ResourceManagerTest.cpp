@@ -1,5 +1,5 @@
 /*
- * Copyright 2016-2023 Aaron Barany
+ * Copyright 2016-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -150,7 +150,7 @@ TEST_F(ResourceManagerTest, CreateThreadPool)
 	ASSERT_TRUE(threadData.condition);
 
 	dsThreadPool* threadPool = dsResourceManager_createThreadPool(&allocator.allocator,
-		resourceManager, threadCount, 0);
+		resourceManager, threadCount, dsThreadPoolFlags_None, 0);
 	ASSERT_TRUE(threadPool);
 
 	dsThreadTaskQueue* taskQueue = dsThreadTaskQueue_create(&allocator.allocator, threadPool,
@@ -31,9 +31,8 @@
 #include <DeepSea/Core/Containers/ResizeableArray.h>
 #include <DeepSea/Core/Memory/Allocator.h>
 #include <DeepSea/Core/Memory/BufferAllocator.h>
-#include <DeepSea/Core/Memory/PoolAllocator.h>
+#include <DeepSea/Core/Memory/ConcurrentPoolAllocator.h>
 #include <DeepSea/Core/Thread/Mutex.h>
-#include <DeepSea/Core/Thread/Spinlock.h>
 #include <DeepSea/Core/Thread/Thread.h>
 #include <DeepSea/Core/Assert.h>
 #include <DeepSea/Core/Error.h>
@@ -208,31 +207,6 @@ static void printGLInfo(dsGLRenderer* renderer, uint32_t major, uint32_t minor,
 		DS_LOG_DEBUG_F(DS_RENDER_OPENGL_LOG_TAG, "Extensions: %s", glGetString(GL_EXTENSIONS));
 }
 
-static dsPoolAllocator* addPool(dsAllocator* allocator, dsPoolAllocator** pools, uint32_t* curPools,
-	uint32_t* maxPools, uint32_t elemSize, uint32_t poolElements)
-{
-	DS_ASSERT(allocator);
-	DS_ASSERT(pools);
-	DS_ASSERT(curPools);
-	DS_ASSERT(allocator);
-	DS_ASSERT(maxPools);
-	DS_ASSERT(*pools || *curPools == 0);
-
-	size_t poolSize = dsPoolAllocator_bufferSize(elemSize, poolElements);
-	void* poolBuffer = dsAllocator_alloc(allocator, poolSize);
-	if (!poolBuffer)
-		return NULL;
-
-	size_t index = *curPools;
-	if (!DS_RESIZEABLE_ARRAY_ADD(allocator, *pools, *curPools, *maxPools, 1))
-		return NULL;
-
-	DS_ASSERT(index < *maxPools);
-	dsPoolAllocator* pool = *pools + index;
-	DS_VERIFY(dsPoolAllocator_initialize(pool, elemSize, poolElements, poolBuffer, poolSize));
-	return pool;
-}
-
 static void deleteDestroyedObjects(dsGLRenderer* renderer)
 {
 	if (renderer->curDestroyVaos)
@@ -276,31 +250,8 @@ bool dsGLRenderer_destroy(dsRenderer* renderer)
 	DS_VERIFY(dsAllocator_free(renderer->allocator, glRenderer->destroyFbos));
 	dsMutex_destroy(glRenderer->contextMutex);
 
-	if (glRenderer->syncPools)
-	{
-		for (size_t i = 0; i < glRenderer->curSyncPools; ++i)
-		{
-			dsPoolAllocator* pool = glRenderer->syncPools + i;
-			void* buffer = pool->buffer;
-			dsPoolAllocator_shutdown(pool);
-			DS_VERIFY(dsAllocator_free(renderer->allocator, buffer));
-		}
-		DS_VERIFY(dsAllocator_free(renderer->allocator, glRenderer->syncPools));
-	}
-	dsSpinlock_shutdown(&glRenderer->syncPoolLock);
-
-	if (glRenderer->syncRefPools)
-	{
-		for (size_t i = 0; i < glRenderer->curSyncRefPools; ++i)
-		{
-			dsPoolAllocator* pool = glRenderer->syncRefPools + i;
-			void* buffer = pool->buffer;
-			dsPoolAllocator_shutdown(pool);
-			DS_VERIFY(dsAllocator_free(renderer->allocator, buffer));
-		}
-		DS_VERIFY(dsAllocator_free(renderer->allocator, glRenderer->syncRefPools));
-	}
-	dsSpinlock_shutdown(&glRenderer->syncRefPoolLock);
+	dsConcurrentPoolAllocator_destroy(glRenderer->syncPool);
+	dsConcurrentPoolAllocator_destroy(glRenderer->syncRefPool);
 
 	if (glRenderer->releaseDisplay)
 	{
@@ -541,8 +492,6 @@ dsRenderer* dsGLRenderer_create(dsAllocator* allocator, const dsRendererOptions*
 
 	DS_VERIFY(dsRenderer_initialize(baseRenderer));
 	baseRenderer->allocator = allocator;
-	DS_VERIFY(dsSpinlock_initialize(&renderer->syncPoolLock));
-	DS_VERIFY(dsSpinlock_initialize(&renderer->syncRefPoolLock));
 
 	renderer->options = *options;
 	if (options->shaderCacheDir)
@@ -562,6 +511,18 @@ dsRenderer* dsGLRenderer_create(dsAllocator* allocator, const dsRendererOptions*
 		renderer->releaseDisplay = true;
 	}
 
+	renderer->syncPool = dsConcurrentPoolAllocator_create(allocator, sizeof(dsGLFenceSync),
+		DS_SYNC_POOL_COUNT, false);
+	renderer->syncRefPool = dsConcurrentPoolAllocator_create(allocator, sizeof(dsGLFenceSyncRef),
+		DS_SYNC_POOL_COUNT, false);
+	if (!renderer->syncPool || !renderer->syncRefPool)
+	{
+		int prevErrno = errno;
+		dsGLRenderer_destroy(baseRenderer);
+		errno = prevErrno;
+		return NULL;
+	}
+
 	void* display = renderer->options.gfxDisplay;
 	renderer->sharedConfig = dsGLPlatform_createConfig(
 		&renderer->platform, allocator, display, options, false);
@@ -1005,36 +966,10 @@ void dsGLRenderer_restoreFramebuffer(dsRenderer* renderer)
 dsGLFenceSync* dsGLRenderer_createSync(dsRenderer* renderer, GLsync sync)
 {
 	dsGLRenderer* glRenderer = (dsGLRenderer*)renderer;
-	DS_VERIFY(dsSpinlock_lock(&glRenderer->syncPoolLock));
-
-	int prevErrno = errno;
-	dsAllocator* pool = NULL;
-	dsGLFenceSync* fenceSync = NULL;
-	for (size_t i = 0; i < glRenderer->curSyncPools && !fenceSync; ++i)
-	{
-		pool = (dsAllocator*)(glRenderer->syncPools + i);
-		fenceSync = DS_ALLOCATE_OBJECT(pool, dsGLFenceSync);
-		if (fenceSync)
-			break;
-	}
-	errno = prevErrno;
-
-	// All pools are full.
+	dsAllocator* pool = (dsAllocator*)glRenderer->syncPool;
+	dsGLFenceSync* fenceSync = DS_ALLOCATE_OBJECT(pool, dsGLFenceSync);
 	if (!fenceSync)
-	{
-		pool = (dsAllocator*)addPool(renderer->allocator, &glRenderer->syncPools,
-			&glRenderer->curSyncPools, &glRenderer->maxSyncPools, sizeof(dsGLFenceSync),
-			DS_SYNC_POOL_COUNT);
-		if (!pool)
-		{
-			DS_VERIFY(dsSpinlock_unlock(&glRenderer->syncPoolLock));
-			return NULL;
-		}
-
-		fenceSync = DS_ALLOCATE_OBJECT(pool, dsGLFenceSync);
-		DS_ASSERT(fenceSync);
-	}
-	DS_VERIFY(dsSpinlock_unlock(&glRenderer->syncPoolLock));
+		return NULL;
 
 	fenceSync->allocator = pool;
 	fenceSync->refCount = 1;
@@ -1045,36 +980,10 @@ dsGLFenceSync* dsGLRenderer_createSync(dsRenderer* renderer, GLsync sync)
 dsGLFenceSyncRef* dsGLRenderer_createSyncRef(dsRenderer* renderer)
 {
 	dsGLRenderer* glRenderer = (dsGLRenderer*)renderer;
-	DS_VERIFY(dsSpinlock_lock(&glRenderer->syncRefPoolLock));
-
-	int prevErrno = errno;
-	dsAllocator* pool = NULL;
-	dsGLFenceSyncRef* fenceSyncRef = NULL;
-	for (size_t i = 0; i < glRenderer->curSyncRefPools && !fenceSyncRef; ++i)
-	{
-		pool = (dsAllocator*)(glRenderer->syncRefPools + i);
-		fenceSyncRef = DS_ALLOCATE_OBJECT(pool, dsGLFenceSyncRef);
-		if (fenceSyncRef)
-			break;
-	}
-	errno = prevErrno;
-
-	// All pools are full.
+	dsAllocator* pool = (dsAllocator*)glRenderer->syncRefPool;
+	dsGLFenceSyncRef* fenceSyncRef = DS_ALLOCATE_OBJECT(pool, dsGLFenceSyncRef);
 	if (!fenceSyncRef)
-	{
-		pool = (dsAllocator*)addPool(renderer->allocator, &glRenderer->syncRefPools,
-			&glRenderer->curSyncRefPools, &glRenderer->maxSyncRefPools, sizeof(dsGLFenceSyncRef),
-			DS_SYNC_POOL_COUNT);
-		if (!pool)
-		{
-			DS_VERIFY(dsSpinlock_unlock(&glRenderer->syncPoolLock));
-			return NULL;
-		}
-
-		fenceSyncRef = DS_ALLOCATE_OBJECT(pool, dsGLFenceSyncRef);
-		DS_ASSERT(fenceSyncRef);
-	}
-	DS_VERIFY(dsSpinlock_unlock(&glRenderer->syncRefPoolLock));
+		return NULL;
 
 	fenceSyncRef->allocator = pool;
 	fenceSyncRef->refCount = 1;
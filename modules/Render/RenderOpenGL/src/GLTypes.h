@@ -308,15 +308,8 @@ typedef struct dsGLRenderer
 	GLuint tempFramebuffer;
 	GLuint tempCopyFramebuffer;
 
-	dsPoolAllocator* syncPools;
-	uint32_t curSyncPools;
-	uint32_t maxSyncPools;
-	dsSpinlock syncPoolLock;
-
-	dsPoolAllocator* syncRefPools;
-	uint32_t curSyncRefPools;
-	uint32_t maxSyncRefPools;
-	dsSpinlock syncRefPoolLock;
+	dsConcurrentPoolAllocator* syncPool;
+	dsConcurrentPoolAllocator* syncRefPool;
 
 	void* curGLSurface;
 	bool curGLSurfaceVSync;
@@ -29,7 +29,9 @@ extern "C"
  * @file
  * @brief Functions for creating dsSceneInstanceData instances that manage instance transforms.
  *
- * This populates the uniforms found in DeepSea/Scene/Shaders/InstanceTransform.mslh
+ * This populates the uniforms found in DeepSea/Scene/Shaders/InstanceTransform.mslh, or
+ * DeepSea/Scene/Shaders/InstancedTransform.mslh when created with
+ * dsInstanceTransformData_createInstanced().
  *
  * @see dsSceneInstanceData
  */
@@ -44,6 +46,12 @@ DS_SCENE_EXPORT extern const char* const dsInstanceTransformData_typeName;
  */
 DS_SCENE_EXPORT extern const char* const dsInstanceTransformData_uniformName;
 
+/**
+ * @brief The instance transform data shader buffer name when created with
+ *     dsInstanceTransformData_createInstanced().
+ */
+DS_SCENE_EXPORT extern const char* const dsInstanceTransformData_instancedUniformName;
+
 /**
  * @brief Creates the shader variable group description used to describe the variables for instance
  *     transforms.
@@ -81,6 +89,30 @@ DS_SCENE_EXPORT dsSceneInstanceData* dsInstanceTransformData_create(dsAllocator*
 	dsResourceManager* resourceManager, dsAllocator* resourceAllocator,
 	const dsShaderVariableGroupDesc* transformDesc);
 
+/**
+ * @brief Creates instance transform data that supports instanced draws.
+ *
+ * The transforms are bound as an array that is indexed by the instance index, matching
+ * DeepSea/Scene/Shaders/InstancedTransform.mslh. The material element should be named
+ * dsInstanceTransformData_instancedUniformName with the type dsMaterialType_UniformBuffer and
+ * instance binding.
+ *
+ * @remark errno will be set on failure.
+ * @param allocator The allocator to create the transform data with. This must support freeing
+ *     memory.
+ * @param resourceManager The resource manager. This must support uniform buffers.
+ * @param resourceAllocator The allocator to create graphics resources with. If NULL this will
+ *     default to allocator.
+ * @param transformDesc The shader variable group description created from
+ *     dsInstanceTransformData_createShaderVariableGroupDesc(). This must remain alive at least as
+ *     long as the instance data object.
+ * @return The instance data or NULL if an error occurred.
+ * @see dsSceneInstanceVariables_createInstanced()
+ */
+DS_SCENE_EXPORT dsSceneInstanceData* dsInstanceTransformData_createInstanced(
+	dsAllocator* allocator, dsResourceManager* resourceManager, dsAllocator* resourceAllocator,
+	const dsShaderVariableGroupDesc* transformDesc);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <DeepSea/Core/Config.h>
+#include <DeepSea/Scene/Export.h>
+#include <DeepSea/Scene/Types.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @file
+ * @brief Functions for creating and manipulating indirect model lists.
+ *
+ * The indirect model list uploads the instances for its models once, and only updates them when
+ * nodes are added, removed, or have their transforms changed. Before the render pass, a compute
+ * shader culls the instances against the view and writes the visible instances along with the
+ * instance counts of the indirect draws. The models are then drawn with indirect draws without any
+ * per-instance work on the CPU.
+ *
+ * The cull shader is dispatched with DS_SCENE_INDIRECT_CULL_WORK_GROUP_SIZE invocations per work
+ * group along the X axis with the view's global values. The cull material must have the following
+ * elements with type dsMaterialType_UniformBuffer and binding dsMaterialBinding_Material:
+ * - dsSceneIndirectModelList_instancesName: array of dsSceneIndirectInstance for each instance.
+ *   The length of the array is the number of instances.
+ * - dsSceneIndirectModelList_visibleInstancesName: array of uint for the visible instance indices.
+ * - dsSceneIndirectModelList_drawArgsName: array of dsDrawIndexedRange for each indirect draw. The
+ *   instanceCount for each draw is reset to 0 before the dispatch.
+ *
+ * For each visible instance, the cull shader should atomically increment instanceCount for the draw
+ * at drawIndex, and write the index of the instance to the visible instances array at firstInstance
+ * plus the previous instance count. DeepSea/Scene/Shaders/IndirectCull.mslh provides a reference
+ * implementation of the cull shader.
+ *
+ * The model shaders must have dsSceneIndirectModelList_instancesName and
+ * dsSceneIndirectModelList_visibleInstancesName as dsMaterialType_UniformBuffer elements with
+ * dsMaterialBinding_Instance binding. The instance index, which includes firstInstance, is the
+ * index into the visible instances array to get the index of the dsSceneIndirectInstance.
+ * DeepSea/Scene/Shaders/IndirectInstance.mslh declares the instances for use in shaders.
+ *
+ * Only models with index buffers are supported, and the draw ranges must draw a single instance.
+ * Models that compute their bounds dynamically are never culled.
+ *
+ * @see dsSceneIndirectModelList
+ */
+
+/**
+ * @brief The number of invocations in the X axis of a cull shader work group.
+ */
+#define DS_SCENE_INDIRECT_CULL_WORK_GROUP_SIZE 64
+
+/**
+ * @brief The scene indirect model list type name.
+ */
+DS_SCENE_EXPORT extern const char* const dsSceneIndirectModelList_typeName;
+
+/**
+ * @brief The name of the buffer element for the instances.
+ */
+DS_SCENE_EXPORT extern const char* const dsSceneIndirectModelList_instancesName;
+
+/**
+ * @brief The name of the buffer element for the visible instance indices.
+ */
+DS_SCENE_EXPORT extern const char* const dsSceneIndirectModelList_visibleInstancesName;
+
+/**
+ * @brief The name of the buffer element for the indirect draw arguments.
+ */
+DS_SCENE_EXPORT extern const char* const dsSceneIndirectModelList_drawArgsName;
+
+/**
+ * @brief Gets the type of an indirect model list.
+ * @return The type of an indirect model list.
+ */
+DS_SCENE_EXPORT const dsSceneItemListType* dsSceneIndirectModelList_type(void);
+
+/**
+ * @brief Checks whether or not indirect model lists are supported.
+ * @param renderer The renderer.
+ * @return Whether or not indirect model lists can be used.
+ */
+DS_SCENE_EXPORT bool dsSceneIndirectModelList_isSupported(const dsRenderer* renderer);
+
+/**
+ * @brief Creates a scene indirect model list.
+ * @remark errno will be set on failure.
+ * @param allocator The allocator to create the list with. This must support freeing memory.
+ * @param resourceManager The resource manager to create graphics resources with.
+ * @param resourceAllocator The allocator to create graphics resources with. If NULL, allocator
+ *     will be used.
+ * @param name The name of the indirect model list. This will be copied.
+ * @param viewFilter The filter for what views process, or NULL to accept all views.
+ * @param cullShader The compute shader to cull the instances with.
+ * @param cullMaterial The material to use with the cull shader. The buffer elements will be set by
+ *     the model list.
+ * @param renderStates The render states to use, or NULL if no special render states are needed.
+ * @return The indirect model list or NULL if an error occurred.
+ */
+DS_SCENE_EXPORT dsSceneIndirectModelList* dsSceneIndirectModelList_create(dsAllocator* allocator,
+	dsResourceManager* resourceManager, dsAllocator* resourceAllocator, const char* name,
+	const dsViewFilter* viewFilter, dsShader* cullShader, dsMaterial* cullMaterial,
+	const dsDynamicRenderStates* renderStates);
+
+/**
+ * @brief Gets the number of instances that are culled on the GPU.
+ *
+ * This will be updated before the next render pass after nodes are added or removed.
+ *
+ * @param modelList The indirect model list.
+ * @return The number of instances.
+ */
+DS_SCENE_EXPORT uint32_t dsSceneIndirectModelList_getInstanceCount(
+	const dsSceneIndirectModelList* modelList);
+
+/**
+ * @brief Gets the number of indirect draws.
+ *
+ * This will be updated before the next render pass after nodes are added or removed.
+ *
+ * @param modelList The indirect model list.
+ * @return The number of indirect draws.
+ */
+DS_SCENE_EXPORT uint32_t dsSceneIndirectModelList_getDrawCount(
+	const dsSceneIndirectModelList* modelList);
+
+#ifdef __cplusplus
+}
+#endif
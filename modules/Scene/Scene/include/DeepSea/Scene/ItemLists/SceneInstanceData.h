@@ -83,6 +83,19 @@ DS_SCENE_EXPORT bool dsSceneInstanceData_populateData(dsSceneInstanceData* insta
 DS_SCENE_EXPORT bool dsSceneInstanceData_bindInstance(
 	dsSceneInstanceData* instanceData, uint32_t index, dsSharedMaterialValues* values);
 
+/**
+ * @brief Binds the data for a range of instances to use with an instanced draw.
+ * @remark errno will be set on failure.
+ * @param instanceData The instance data.
+ * @param index The index for the first instance to bind.
+ * @param count The number of instances to bind. This must not be larger than
+ *     instanceData->maxInstanceRange.
+ * @param values The values to bind to.
+ * @return False if an error occurred.
+ */
+DS_SCENE_EXPORT bool dsSceneInstanceData_bindInstanceRange(dsSceneInstanceData* instanceData,
+	uint32_t index, uint32_t count, dsSharedMaterialValues* values);
+
 /**
  * @brief Finishes the current set of instance data.
  *
@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2025 Aaron Barany
+ * Copyright 2019-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -28,6 +28,12 @@ extern "C"
 /**
  * @file
  * @brief Functions for creating and manipulating scene instance variables.
+ *
+ * Instance variables created with dsSceneInstanceVariables_create() bind each instance as a
+ * separate uniform block. Instance variables created with
+ * dsSceneInstanceVariables_createInstanced() instead bind a buffer with an array of instances,
+ * which allows multiple instances to be drawn with a single instanced draw.
+ *
  * @see dsSceneInstanceData
  */
 
@@ -56,6 +62,37 @@ DS_SCENE_EXPORT dsSceneInstanceData* dsSceneInstanceVariables_create(dsAllocator
 	const dsShaderVariableGroupDesc* dataDesc, uint32_t nameID,
 	const dsSceneInstanceVariablesType* instanceVariablesType, void* userData);
 
+/**
+ * @brief Creates a scene instance variables object that supports binding ranges of instances.
+ *
+ * The data is bound as a uniform buffer, which should be declared in the shader as a readonly
+ * buffer with a runtime sized array of structs. The data for each instance is selected with the
+ * instance index, and is laid out with the std140 rules for the struct. The array stride is the
+ * size of the struct rounded up to a multiple of 16 bytes, which matches std430 when the members of
+ * the struct are aligned to 16 bytes.
+ *
+ * The material element should have the type dsMaterialType_UniformBuffer with instance binding.
+ * The index of the first instance that is bound must be a multiple of instanceAlignment on the
+ * instance data.
+ *
+ * @remark errno will be set on failure.
+ * @param allocator The allocator to create the data with. This must support freeing memory.
+ * @param resourceManager The resource manager to create graphics resources with. This must
+ *     support uniform buffers.
+ * @param resourceAllocator The allocator to create graphics resources with. If NULL this will
+ *     default to allocator.
+ * @param dataDesc The description for the data held for each instance. This must remain alive at
+ *     least as long as the instance data object.
+ * @param nameID The name ID to use when setting the buffer data on the dsSharedMaterialValues
+ *     instance.
+ * @param instanceVariablesType The type for the instance variables.
+ * @param userData The user data that will be provided to populateDataFunc. This may be NULL.
+ */
+DS_SCENE_EXPORT dsSceneInstanceData* dsSceneInstanceVariables_createInstanced(
+	dsAllocator* allocator, dsResourceManager* resourceManager, dsAllocator* resourceAllocator,
+	const dsShaderVariableGroupDesc* dataDesc, uint32_t nameID,
+	const dsSceneInstanceVariablesType* instanceVariablesType, void* userData);
+
 #ifdef __cplusplus
 }
 #endif
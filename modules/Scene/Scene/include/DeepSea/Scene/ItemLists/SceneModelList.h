@@ -95,6 +95,57 @@ DS_SCENE_EXPORT const dsDynamicRenderStates* dsSceneModelList_getRenderStates(
 DS_SCENE_EXPORT void dsSceneModelList_setRenderStates(dsSceneModelList* modelList,
 	const dsDynamicRenderStates* renderStates);
 
+/**
+ * @brief Gets whether instancing is enabled for a model list.
+ * @param modelList The model list.
+ * @return Whether instancing is enabled.
+ */
+DS_SCENE_EXPORT bool dsSceneModelList_getInstancing(const dsSceneModelList* modelList);
+
+/**
+ * @brief Sets whether instancing is enabled for a model list.
+ *
+ * When enabled, consecutive models after sorting that share the same shader, material, geometry,
+ * and draw ranges are drawn with a single instanced draw call. The instance data is bound as a
+ * contiguous range of instances with dsSceneInstanceData_bindInstanceRange(), so the shaders must
+ * select the data for each instance based on the instance index. Instance variables must be
+ * created with dsSceneInstanceVariables_createInstanced() to support this, such as with
+ * dsInstanceTransformData_createInstanced().
+ *
+ * Models will be drawn individually when the renderer doesn't support instanced drawing, any of
+ * the instance datas have a maxInstanceRange of 1, or the draw ranges already draw multiple
+ * instances.
+ *
+ * @param modelList The model list.
+ * @param instancing Whether to enable instancing.
+ */
+DS_SCENE_EXPORT void dsSceneModelList_setInstancing(dsSceneModelList* modelList, bool instancing);
+
+/**
+ * @brief Gets whether incremental sorting is enabled for a model list.
+ * @param modelList The model list.
+ * @return Whether incremental sorting is enabled.
+ */
+DS_SCENE_EXPORT bool dsSceneModelList_getIncrementalSort(const dsSceneModelList* modelList);
+
+/**
+ * @brief Sets whether incremental sorting is enabled for a model list.
+ *
+ * When enabled, the sorted order of the models is kept between frames. Models that are still
+ * visible start from their previous order, newly visible models are added at the end, and the
+ * list is fixed up with an insertion sort. This is faster than a full sort when the camera and
+ * models move little between frames. A full sort is used instead when the order changed too much,
+ * the sort type changed, or there's no order kept for the view.
+ *
+ * The order is kept separately for each view the model list is drawn with, up to 4 views. When
+ * drawn with more views, the order for the least recently drawn view is replaced.
+ *
+ * @param modelList The model list.
+ * @param incrementalSort Whether to enable incremental sorting.
+ */
+DS_SCENE_EXPORT void dsSceneModelList_setIncrementalSort(dsSceneModelList* modelList,
+	bool incrementalSort);
+
 #ifdef __cplusplus
 }
 #endif
@@ -119,6 +119,22 @@ typedef bool (*dsPopulateSceneInstanceDataFunction)(dsSceneInstanceData* instanc
 typedef bool (*dsBindSceneInstanceDataFunction)(
 	dsSceneInstanceData* instanceData, uint32_t index, dsSharedMaterialValues* values);
 
+/**
+ * @brief Function for binding a range of instances from scene instance data.
+ *
+ * This is used for instanced draws, where the instance within the range is selected in the shader
+ * based on the instance index.
+ *
+ * @remark errno should be set on failure.
+ * @param instanceData The instance data.
+ * @param index The index of the first instance to bind.
+ * @param count The number of instances to bind.
+ * @param values The material values to bind to.
+ * @return False if an error occurred.
+ */
+typedef bool (*dsBindSceneInstanceRangeFunction)(dsSceneInstanceData* instanceData,
+	uint32_t index, uint32_t count, dsSharedMaterialValues* values);
+
 /**
  * @brief Function for finishing the current set of instance data.
  * @remark errno should be set on failure.
@@ -172,6 +188,13 @@ typedef struct dsSceneInstanceDataType
 	 */
 	dsBindSceneInstanceDataFunction bindInstanceFunc;
 
+	/**
+	 * @brief Function to bind a range of instances for instanced draws.
+	 *
+	 * This may be NULL if instances can only be bound individually.
+	 */
+	dsBindSceneInstanceRangeFunction bindInstanceRangeFunc;
+
 	/**
 	 * @brief Function to finish using the current set of instance data.
 	 */
@@ -230,6 +253,23 @@ struct dsSceneInstanceData
 	 * instance data starts.
 	 */
 	bool needsCommandBuffer;
+
+	/**
+	 * @brief The maximum number of instances that may be bound at once with
+	 *     dsSceneInstanceData_bindInstanceRange().
+	 *
+	 * This should be 1 if bindInstanceRangeFunc is NULL.
+	 */
+	uint32_t maxInstanceRange;
+
+	/**
+	 * @brief The alignment of the first instance index when binding instances.
+	 *
+	 * Indices passed to bindInstanceFunc and bindInstanceRangeFunc must be a multiple of this, so
+	 * item lists must pad the instances they populate to respect it. This is 1 if any index may be
+	 * bound.
+	 */
+	uint32_t instanceAlignment;
 };
 
 /**
@@ -377,6 +417,38 @@ typedef void (*dsCommitSceneItemListFunction)(
 	dsSceneItemList* itemList, const dsView* view, dsCommandBuffer* commandBuffer,
 	const dsViewRenderPassParams* renderPassParams);
 
+/**
+ * @brief Function for preparing to commit a scene item list in ranges.
+ * @param itemList The scene item list to prepare.
+ * @param view The view used with the scene item list.
+ * @param renderPassParams The parameters for drawing to the render pass.
+ * @return The number of items to commit. This will be split into ranges passed to
+ *     dsCommitSceneItemListRangeFunction.
+ */
+typedef uint32_t (*dsPrepareCommitSceneItemListRangesFunction)(dsSceneItemList* itemList,
+	const dsView* view, const dsViewRenderPassParams* renderPassParams);
+
+/**
+ * @brief Function for committing a range of items within a scene item list.
+ * @param itemList The scene item list to execute.
+ * @param view The view used with the scene item list.
+ * @param commandBuffer The command buffer to execute with.
+ * @param renderPassParams The parameters for drawing to the render pass.
+ * @param start The first item to commit.
+ * @param count The number of items to commit.
+ */
+typedef void (*dsCommitSceneItemListRangeFunction)(dsSceneItemList* itemList, const dsView* view,
+	dsCommandBuffer* commandBuffer, const dsViewRenderPassParams* renderPassParams,
+	uint32_t start, uint32_t count);
+
+/**
+ * @brief Function for finishing committing a scene item list in ranges.
+ * @param itemList The scene item list that was committed.
+ * @param view The view used with the scene item list.
+ */
+typedef void (*dsFinishCommitSceneItemListRangesFunction)(
+	dsSceneItemList* itemList, const dsView* view);
+
 /**
  * @brief Function to get the hash for a scene item list.
  * @param itemList The item list to get the hash for.
@@ -475,6 +547,38 @@ typedef struct dsSceneItemListType
 	 */
 	dsCommitSceneItemListFunction commitFunc;
 
+	/**
+	 * @brief Function for preparing to commit the scene item list in ranges.
+	 *
+	 * This may be NULL if the item list can't be committed in ranges, and must be set if
+	 * commitRangeFunc is set. It will be called in place of commitFunc when drawing a render pass
+	 * with a dsSceneThreadManager, after preRenderPassFunc if set.
+	 */
+	dsPrepareCommitSceneItemListRangesFunction prepareCommitRangesFunc;
+
+	/**
+	 * @brief Function for committing a range of items in the scene item list.
+	 *
+	 * When drawing a render pass with a dsSceneThreadManager, the items returned from
+	 * prepareCommitRangesFunc will be split into ranges that are each recorded to a separate
+	 * secondary command buffer on different threads, allowing large item lists to be processed in
+	 * parallel. The command buffers are submitted in the order of the ranges.
+	 *
+	 * This may be NULL if the item list can't be committed in ranges. commitFunc must still be
+	 * provided, which is used when not drawing with a dsSceneThreadManager.
+	 *
+	 * @remark This may be called concurrently across multiple threads for different ranges.
+	 */
+	dsCommitSceneItemListRangeFunction commitRangeFunc;
+
+	/**
+	 * @brief Function for finishing committing the scene item list in ranges.
+	 *
+	 * This will be called once all ranges have been committed, and may be called on a different
+	 * thread than prepareCommitRangesFunc. This may be NULL if no cleanup is needed.
+	 */
+	dsFinishCommitSceneItemListRangesFunction finishCommitRangesFunc;
+
 	/**
 	 * @brief Function to get the hash for a scene item list.
 	 *
@@ -567,6 +671,71 @@ struct dsSceneItemList
  */
 typedef struct dsSceneModelList dsSceneModelList;
 
+/**
+ * @brief Per-instance data uploaded for GPU culling with dsSceneIndirectModelList.
+ *
+ * This matches the std430 layout of the following GLSL struct:
+ *
+ * ```
+ * struct IndirectInstance
+ * {
+ *     mat4 transform;
+ *     mat4 boxMatrix;
+ *     uint drawIndex;
+ *     uint hasBounds;
+ *     vec2 distanceRange;
+ * };
+ * ```
+ *
+ * @see SceneIndirectModelList.h
+ */
+typedef struct dsSceneIndirectInstance
+{
+	/**
+	 * @brief The world transform for the instance.
+	 */
+	dsMatrix44f transform;
+
+	/**
+	 * @brief The world space bounds as a box matrix.
+	 *
+	 * This transforms the cube in the range [-1, 1] to the bounding box. This is only valid if
+	 * hasBounds is set.
+	 */
+	dsMatrix44f boxMatrix;
+
+	/**
+	 * @brief The index of the dsDrawIndexedRange in the indirect draw buffer for the instance.
+	 */
+	uint32_t drawIndex;
+
+	/**
+	 * @brief Whether or not boxMatrix is valid.
+	 *
+	 * Instances without bounds should always be considered visible.
+	 */
+	uint32_t hasBounds;
+
+	/**
+	 * @brief The distance range to draw the model for LODs.
+	 *
+	 * The instance should only be visible when the distance to the camera is in the range
+	 * [distanceRange.x, distanceRange.y). If distanceRange.x > distanceRange.y, the instance is
+	 * visible at any distance.
+	 */
+	dsVector2f distanceRange;
+} dsSceneIndirectInstance;
+
+/**
+ * @brief Scene item list implementation for drawing models that are culled on the GPU.
+ *
+ * This will hold information from dsSceneModelNode node types, and is intended for static content
+ * where the transforms rarely change.
+ *
+ * @see SceneIndirectModelList.h
+ */
+typedef struct dsSceneIndirectModelList dsSceneIndirectModelList;
+
 /**
  * @brief Full screen resolve within a scene.
  *
@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2022 Aaron Barany
+ * Copyright 2019-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <DeepSea/Core/Bits.h>
 #include <DeepSea/Core/Config.h>
 #include <DeepSea/Scene/Nodes/Types.h>
 #include <DeepSea/Scene/Export.h>
@@ -51,6 +52,51 @@ DS_SCENE_EXPORT void* dsSceneNodeItemData_findName(const dsSceneNodeItemData* it
 DS_SCENE_EXPORT void* dsSceneNodeItemData_findID(const dsSceneNodeItemData* itemData,
 	uint32_t nameID);
 
+/**
+ * @brief Gets a bitmask of the item data indices for a set of item lists.
+ *
+ * The item data for each tree node is in the same order as the item lists for the scene node, so
+ * the indices stay the same for the lifetime of the tree node. This can be computed once when a
+ * node is added to an item list, even before the item data for later item lists is set up, and
+ * used with dsSceneNodeItemData_anyInMask() each frame rather than searching by name ID.
+ *
+ * @remark errno will be set on failure.
+ * @param[out] outMask The bitmask, where bit i is set when the item list at index i matches one
+ *     of the name IDs.
+ * @param node The scene node to get the indices for.
+ * @param nameIDs The IDs for the names of the item lists.
+ * @param nameIDCount The number of name IDs.
+ * @return False if the parameters are invalid or a matching item list is past the first 64, in
+ *     which case errno will be set to ERANGE. In that case dsSceneNodeItemData_findID() should
+ *     be used instead.
+ */
+DS_SCENE_EXPORT bool dsSceneNodeItemData_getIndexMask(uint64_t* outMask, const dsSceneNode* node,
+	const uint32_t* nameIDs, uint32_t nameIDCount);
+
+/**
+ * @brief Checks whether any of the item data in an index mask is non-NULL.
+ *
+ * This is typically used to check the results of cull lists, where a non-zero result means the
+ * node is out of view.
+ *
+ * @param itemData The item data to check.
+ * @param mask The bitmask of item data indices from dsSceneNodeItemData_getIndexMask().
+ * @return Whether any of the item data is set.
+ */
+DS_SCENE_EXPORT inline bool dsSceneNodeItemData_anyInMask(const dsSceneNodeItemData* itemData,
+	uint64_t mask);
+
+inline bool dsSceneNodeItemData_anyInMask(const dsSceneNodeItemData* itemData, uint64_t mask)
+{
+	for (; mask; mask &= mask - 1)
+	{
+		if (itemData->itemData[dsCtz64(mask)].data)
+			return true;
+	}
+
+	return false;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -175,6 +175,38 @@ DS_SCENE_EXPORT dsScene* dsScene_loadData(dsAllocator* allocator, dsAllocator* r
 	dsDestroyUserDataFunction destroyUserDataFunc, dsScene* prevScene, const void* data,
 	size_t size);
 
+/**
+ * @brief Loads a scene asynchronously.
+ *
+ * The file is read on an IO thread, while the scene itself is loaded when the request is processed
+ * with dsAsyncIO_processCompleted() or dsAsyncIO_waitForRequests(). This is because loading the
+ * scene creates graphics resources and uses the scratch data, neither of which may be accessed
+ * across threads. The scratch data allocator must be thread-safe since the file is read into
+ * memory allocated from it on the IO thread.
+ *
+ * @remark errno will be set on failure.
+ * @param asyncIO The asynchronous IO manager to read the file with.
+ * @param allocator The allocator to create the scene.
+ * @param resourceAllocator The allocator to create graphics resources with. If NULL, it will use
+ *     the scene allocator.
+ * @param loadContext The scene load context. This must remain alive until completeFunc is called.
+ * @param scratchData The scene scratch data. This must remain alive until completeFunc is called.
+ * @param userData User data to hold with the scene.
+ * @param destroyUserDataFunc Function to destroy the user data for the scene.
+ * @param prevScene The previous scene that this scene is intended to replace. See
+ *     dsScene_loadFile() for details. This will be destroyed, even if creation fails.
+ * @param file The file to load. The path will be copied.
+ * @param completeFunc The function to call with the loaded scene.
+ * @param completeUserData The user data to pass to completeFunc.
+ * @return False if the load couldn't be started. If true is returned, completeFunc is guaranteed
+ *     to be called.
+ */
+DS_SCENE_EXPORT bool dsScene_loadAsync(dsAsyncIO* asyncIO, dsAllocator* allocator,
+	dsAllocator* resourceAllocator, const dsSceneLoadContext* loadContext,
+	dsSceneLoadScratchData* scratchData, void* userData,
+	dsDestroyUserDataFunction destroyUserDataFunc, dsScene* prevScene, const dsAsyncIOFile* file,
+	dsAsyncLoadCompleteFunction completeFunc, void* completeUserData);
+
 /**
  * @brief Gets the allocator used for a scene.
  * @param scene The scene to get the allocator for.
@@ -265,6 +297,33 @@ DS_SCENE_EXPORT dsSceneItemList* dsScene_findItemList(dsScene* scene, const char
 DS_SCENE_EXPORT bool dsScene_forEachItemList(
 	const dsScene* scene, dsVisitSceneItemListsFunction visitFunc, void* userData);
 
+/**
+ * @brief Gets the thread pool used to update the scene.
+ * @param scene The scene.
+ * @return The thread pool or NULL if the scene is updated on the calling thread.
+ */
+DS_SCENE_EXPORT dsThreadPool* dsScene_getUpdateThreadPool(const dsScene* scene);
+
+/**
+ * @brief Sets the thread pool used to update the scene.
+ *
+ * When set, dsScene_update() will split the dirty nodes into independent subtrees and update their
+ * transforms in parallel. The item lists will still be updated for each node on the calling thread
+ * after all transforms are updated, in a consistent order, so the item lists don't need to be
+ * thread-safe and the results are deterministic.
+ *
+ * This is primarily beneficial for scenes with large numbers of nodes updated each frame, such as
+ * many animated nodes. The thread pool isn't transferred when replacing the scene with
+ * dsScene_create() or dsScene_loadFile().
+ *
+ * @remark errno will be set on failure.
+ * @param scene The scene.
+ * @param threadPool The thread pool to update with, or NULL to update on the calling thread. This
+ *     must remain alive as long as it's set on the scene.
+ * @return False if the thread pool couldn't be set.
+ */
+DS_SCENE_EXPORT bool dsScene_setUpdateThreadPool(dsScene* scene, dsThreadPool* threadPool);
+
 /**
  * @brief Gets the tick provided for the last update.
  *
@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2023 Aaron Barany
+ * Copyright 2019-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -36,6 +36,9 @@ extern "C"
  * @brief Creates a scene thread manager.
  *
  * The item lists declared within a dsScene will be executed in parallel within the thread pool.
+ * Item lists within a render pass that provide commitRangeFunc will have their items split into
+ * ranges that are each recorded to a separate command buffer, allowing a single large item list to
+ * be processed across multiple threads.
  *
  * @remark errno will be set on failure.
  * @param allocator The allocator to create the thread manager with. This must support freeing
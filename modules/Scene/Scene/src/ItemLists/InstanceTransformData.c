@@ -216,6 +216,28 @@ inline static const dsSceneInstanceVariablesType* optimalInstanceVariablesType(v
 
 const char* const dsInstanceTransformData_typeName = "InstanceTransformData";
 const char* const dsInstanceTransformData_uniformName = "dsInstanceTransformData";
+const char* const dsInstanceTransformData_instancedUniformName = "dsInstancedTransformData";
+
+static bool checkCreateParams(dsAllocator* allocator,
+	const dsShaderVariableGroupDesc* transformDesc)
+{
+	if (!allocator || !transformDesc)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (!dsInstanceTransformData_isShaderVariableGroupCompatible(transformDesc))
+	{
+		errno = EINVAL;
+		DS_LOG_ERROR(DS_SCENE_LOG_TAG,
+			"Instance transform data's shader variable group description must have been created "
+			"with dsInstanceTransformData_createShaderVariableGroupDesc().");
+		return false;
+	}
+
+	return true;
+}
 
 dsShaderVariableGroupDesc* dsInstanceTransformData_createShaderVariableGroupDesc(
 	dsResourceManager* resourceManager, dsAllocator* allocator)
@@ -242,22 +264,22 @@ dsSceneInstanceData* dsInstanceTransformData_create(dsAllocator* allocator,
 	dsResourceManager* resourceManager, dsAllocator* resourceAllocator,
 	const dsShaderVariableGroupDesc* transformDesc)
 {
-	if (!allocator || !transformDesc)
-	{
-		errno = EINVAL;
+	if (!checkCreateParams(allocator, transformDesc))
 		return NULL;
-	}
-
-	if (!dsInstanceTransformData_isShaderVariableGroupCompatible(transformDesc))
-	{
-		errno = EINVAL;
-		DS_LOG_ERROR(DS_SCENE_LOG_TAG,
-			"Instance transform data's shader variable group description must have been created "
-			"with dsInstanceTransformData_createShaderVariableGroupDesc().");
-		return NULL;
-	}
 
 	return dsSceneInstanceVariables_create(allocator, resourceManager, resourceAllocator,
 		transformDesc, dsUniqueNameID_create(dsInstanceTransformData_uniformName),
 		optimalInstanceVariablesType(), NULL);
 }
+
+dsSceneInstanceData* dsInstanceTransformData_createInstanced(dsAllocator* allocator,
+	dsResourceManager* resourceManager, dsAllocator* resourceAllocator,
+	const dsShaderVariableGroupDesc* transformDesc)
+{
+	if (!checkCreateParams(allocator, transformDesc))
+		return NULL;
+
+	return dsSceneInstanceVariables_createInstanced(allocator, resourceManager, resourceAllocator,
+		transformDesc, dsUniqueNameID_create(dsInstanceTransformData_instancedUniformName),
+		optimalInstanceVariablesType(), NULL);
+}
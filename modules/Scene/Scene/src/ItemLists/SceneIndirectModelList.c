@@ -0,0 +1,851 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <DeepSea/Scene/ItemLists/SceneIndirectModelList.h>
+
+#include <DeepSea/Core/Containers/Hash.h>
+#include <DeepSea/Core/Containers/ResizeableArray.h>
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Memory/BufferAllocator.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Error.h>
+#include <DeepSea/Core/Log.h>
+#include <DeepSea/Core/Profile.h>
+#include <DeepSea/Core/Sort.h>
+#include <DeepSea/Core/UniqueNameID.h>
+
+#include <DeepSea/Math/Core.h>
+#include <DeepSea/Math/Matrix44.h>
+
+#include <DeepSea/Render/Resources/GfxBuffer.h>
+#include <DeepSea/Render/Resources/Material.h>
+#include <DeepSea/Render/Resources/MaterialDesc.h>
+#include <DeepSea/Render/Resources/Shader.h>
+#include <DeepSea/Render/Resources/SharedMaterialValues.h>
+#include <DeepSea/Render/Renderer.h>
+
+#include <DeepSea/Scene/ItemLists/SceneItemListEntries.h>
+#include <DeepSea/Scene/Nodes/SceneModelNode.h>
+#include <DeepSea/Scene/Nodes/SceneNode.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct Entry
+{
+	const dsSceneModelNode* node;
+	const dsMatrix44f* transform;
+	uint64_t nodeID;
+} Entry;
+
+typedef struct DrawItem
+{
+	dsShader* shader;
+	dsMaterial* material;
+	dsDrawGeometry* geometry;
+	dsPrimitiveType primitiveType;
+	dsDrawIndexedRange drawRange;
+} DrawItem;
+
+typedef struct InstanceItem
+{
+	DrawItem draw;
+	const dsSceneModelInfo* model;
+	uint32_t entry;
+} InstanceItem;
+
+struct dsSceneIndirectModelList
+{
+	dsSceneItemList itemList;
+	dsResourceManager* resourceManager;
+	dsAllocator* resourceAllocator;
+
+	dsShader* cullShader;
+	dsMaterial* cullMaterial;
+	uint32_t instancesElement;
+	uint32_t visibleInstancesElement;
+	uint32_t drawArgsElement;
+
+	dsDynamicRenderStates renderStates;
+	bool hasRenderStates;
+
+	dsSharedMaterialValues* instanceValues;
+
+	Entry* entries;
+	uint32_t entryCount;
+	uint32_t maxEntries;
+	uint64_t nextNodeID;
+
+	uint64_t* removeEntries;
+	uint32_t removeEntryCount;
+	uint32_t maxRemoveEntries;
+
+	// Entries were added or removed, requiring the draws to be rebuilt.
+	bool entriesChanged;
+	// Transforms were changed, requiring the instances to be updated.
+	bool transformsChanged;
+	// The buffers need to be updated on the GPU.
+	bool needsUpload;
+
+	InstanceItem* instanceItems;
+	uint32_t instanceCount;
+	uint32_t maxInstanceItems;
+
+	dsSceneIndirectInstance* instances;
+	uint32_t maxInstances;
+
+	DrawItem* drawItems;
+	uint32_t drawCount;
+	uint32_t maxDrawItems;
+
+	// Initial draw arguments, with instanceCount set to 0.
+	dsDrawIndexedRange* drawArgs;
+	uint32_t maxDrawArgs;
+
+	dsGfxBuffer* instanceBuffer;
+	dsGfxBuffer* visibleInstanceBuffer;
+	dsGfxBuffer* drawArgsBuffer;
+};
+
+static int compareDrawItems(const DrawItem* left, const DrawItem* right)
+{
+	int shaderCmp = DS_CMP(left->shader, right->shader);
+	int materialCmp = DS_CMP(left->material, right->material);
+	int geometryCmp = DS_CMP(left->geometry, right->geometry);
+	int primitiveCmp = DS_CMP(left->primitiveType, right->primitiveType);
+	int rangeCmp = memcmp(&left->drawRange, &right->drawRange, sizeof(dsDrawIndexedRange));
+
+	int result = dsCombineCmp(shaderCmp, materialCmp);
+	result = dsCombineCmp(result, geometryCmp);
+	result = dsCombineCmp(result, primitiveCmp);
+	return dsCombineCmp(result, rangeCmp);
+}
+
+static int sortInstanceItems(const void* left, const void* right)
+{
+	const InstanceItem* leftItem = (const InstanceItem*)left;
+	const InstanceItem* rightItem = (const InstanceItem*)right;
+	// Keep the entry order for consistent results.
+	return dsCombineCmp(compareDrawItems(&leftItem->draw, &rightItem->draw),
+		DS_CMP(leftItem->entry, rightItem->entry));
+}
+
+static bool isModelValid(const dsSceneModelInfo* model)
+{
+	if (!model->geometry->indexBuffer.buffer)
+		return false;
+
+	for (uint32_t i = 0; i < model->drawRangeCount; ++i)
+	{
+		const dsDrawIndexedRange* drawRange = &model->drawRanges[i].drawIndexedRange;
+		if (drawRange->instanceCount != 1 || drawRange->firstInstance != 0)
+			return false;
+	}
+
+	return true;
+}
+
+static void updateInstances(dsSceneIndirectModelList* modelList)
+{
+	DS_PROFILE_FUNC_START();
+
+	for (uint32_t i = 0; i < modelList->instanceCount; ++i)
+	{
+		const InstanceItem* item = modelList->instanceItems + i;
+		const Entry* entry = modelList->entries + item->entry;
+		const dsSceneCullNode* cullNode = &entry->node->node;
+		dsSceneIndirectInstance* instance = modelList->instances + i;
+
+		instance->transform = *entry->transform;
+		// Bounds computed on the CPU each frame can't be uploaded once, so never cull them.
+		if (cullNode->hasBounds && !cullNode->getBoundsFunc)
+		{
+			dsMatrix44f_affineMul(&instance->boxMatrix, entry->transform,
+				&cullNode->staticLocalBoxMatrix);
+			instance->hasBounds = true;
+		}
+		else
+		{
+			memset(&instance->boxMatrix, 0, sizeof(dsMatrix44f));
+			instance->hasBounds = false;
+		}
+		instance->distanceRange = item->model->distanceRange;
+	}
+
+	DS_PROFILE_FUNC_RETURN_VOID();
+}
+
+static bool rebuildInstances(dsSceneIndirectModelList* modelList)
+{
+	DS_PROFILE_FUNC_START();
+
+	dsSceneItemList* itemList = (dsSceneItemList*)modelList;
+	modelList->instanceCount = 0;
+	modelList->drawCount = 0;
+	for (uint32_t i = 0; i < modelList->entryCount; ++i)
+	{
+		const dsSceneModelNode* modelNode = modelList->entries[i].node;
+		for (uint32_t j = 0; j < modelNode->modelCount; ++j)
+		{
+			const dsSceneModelInfo* model = modelNode->models + j;
+			if (model->modelListID != itemList->nameID)
+				continue;
+
+			uint32_t index = modelList->instanceCount;
+			if (!DS_RESIZEABLE_ARRAY_ADD(itemList->allocator, modelList->instanceItems,
+					modelList->instanceCount, modelList->maxInstanceItems, model->drawRangeCount))
+			{
+				modelList->instanceCount = 0;
+				DS_PROFILE_FUNC_RETURN(false);
+			}
+
+			for (uint32_t k = 0; k < model->drawRangeCount; ++k)
+			{
+				InstanceItem* item = modelList->instanceItems + index + k;
+				item->draw.shader = model->shader;
+				item->draw.material = model->material;
+				item->draw.geometry = model->geometry;
+				item->draw.primitiveType = model->primitiveType;
+				item->draw.drawRange = model->drawRanges[k].drawIndexedRange;
+				item->model = model;
+				item->entry = i;
+			}
+		}
+	}
+
+	uint32_t dummyInstanceCount = 0;
+	if (!DS_RESIZEABLE_ARRAY_ADD(itemList->allocator, modelList->instances, dummyInstanceCount,
+			modelList->maxInstances, modelList->instanceCount))
+	{
+		modelList->instanceCount = 0;
+		DS_PROFILE_FUNC_RETURN(false);
+	}
+
+	// Sort by draw so each draw has a contiguous range of visible instances.
+	qsort(modelList->instanceItems, modelList->instanceCount, sizeof(InstanceItem),
+		&sortInstanceItems);
+
+	for (uint32_t i = 0; i < modelList->instanceCount; ++i)
+	{
+		const InstanceItem* item = modelList->instanceItems + i;
+		if (i == 0 || compareDrawItems(&modelList->drawItems[modelList->drawCount - 1],
+				&item->draw) != 0)
+		{
+			uint32_t drawIndex = modelList->drawCount;
+			if (!DS_RESIZEABLE_ARRAY_ADD(itemList->allocator, modelList->drawItems,
+					modelList->drawCount, modelList->maxDrawItems, 1))
+			{
+				modelList->instanceCount = 0;
+				modelList->drawCount = 0;
+				DS_PROFILE_FUNC_RETURN(false);
+			}
+
+			uint32_t dummyDrawCount = drawIndex;
+			if (!DS_RESIZEABLE_ARRAY_ADD(itemList->allocator, modelList->drawArgs,
+					dummyDrawCount, modelList->maxDrawArgs, 1))
+			{
+				modelList->instanceCount = 0;
+				modelList->drawCount = 0;
+				DS_PROFILE_FUNC_RETURN(false);
+			}
+
+			modelList->drawItems[drawIndex] = item->draw;
+			dsDrawIndexedRange* drawArgs = modelList->drawArgs + drawIndex;
+			*drawArgs = item->draw.drawRange;
+			drawArgs->instanceCount = 0;
+			drawArgs->firstInstance = i;
+		}
+
+		dsSceneIndirectInstance* instance = modelList->instances + i;
+		instance->drawIndex = modelList->drawCount - 1;
+	}
+
+	updateInstances(modelList);
+	DS_PROFILE_FUNC_RETURN(true);
+}
+
+static bool reserveBuffer(dsSceneIndirectModelList* modelList, dsGfxBuffer** buffer,
+	dsGfxBufferUsage usage, size_t size)
+{
+	if (*buffer && (*buffer)->size >= size)
+		return true;
+
+	// Grow the buffer to avoid re-creating it each time a node is added.
+	size_t newSize = size;
+	if (*buffer)
+	{
+		newSize = dsMax(newSize, (*buffer)->size*2);
+		DS_VERIFY(dsGfxBuffer_destroy(*buffer));
+	}
+
+	*buffer = dsGfxBuffer_create(modelList->resourceManager, modelList->resourceAllocator, usage,
+		dsGfxMemory_GPUOnly | dsGfxMemory_Draw, NULL, newSize);
+	return *buffer != NULL;
+}
+
+static bool uploadInstances(dsSceneIndirectModelList* modelList, dsCommandBuffer* commandBuffer)
+{
+	DS_PROFILE_FUNC_START();
+
+	size_t instancesSize = sizeof(dsSceneIndirectInstance)*modelList->instanceCount;
+	size_t visibleInstancesSize = sizeof(uint32_t)*modelList->instanceCount;
+	size_t drawArgsSize = sizeof(dsDrawIndexedRange)*modelList->drawCount;
+	if (!reserveBuffer(modelList, &modelList->instanceBuffer,
+			dsGfxBufferUsage_UniformBuffer | dsGfxBufferUsage_CopyTo, instancesSize) ||
+		!reserveBuffer(modelList, &modelList->visibleInstanceBuffer,
+			dsGfxBufferUsage_UniformBuffer, visibleInstancesSize) ||
+		!reserveBuffer(modelList, &modelList->drawArgsBuffer,
+			dsGfxBufferUsage_UniformBuffer | dsGfxBufferUsage_IndirectDraw |
+				dsGfxBufferUsage_CopyTo, drawArgsSize))
+	{
+		DS_PROFILE_FUNC_RETURN(false);
+	}
+
+	if (!dsGfxBuffer_copyData(modelList->instanceBuffer, commandBuffer, 0, modelList->instances,
+			instancesSize))
+	{
+		DS_PROFILE_FUNC_RETURN(false);
+	}
+
+	// Buffers may have been re-created, so always set the latest ranges.
+	dsMaterial* cullMaterial = modelList->cullMaterial;
+	if (!dsMaterial_setBuffer(cullMaterial, modelList->instancesElement,
+			modelList->instanceBuffer, 0, instancesSize) ||
+		!dsMaterial_setBuffer(cullMaterial, modelList->visibleInstancesElement,
+			modelList->visibleInstanceBuffer, 0, visibleInstancesSize) ||
+		!dsMaterial_setBuffer(cullMaterial, modelList->drawArgsElement,
+			modelList->drawArgsBuffer, 0, drawArgsSize))
+	{
+		DS_PROFILE_FUNC_RETURN(false);
+	}
+
+	dsSharedMaterialValues* instanceValues = modelList->instanceValues;
+	if (!dsSharedMaterialValues_setBufferName(instanceValues,
+			dsSceneIndirectModelList_instancesName, modelList->instanceBuffer, 0,
+			instancesSize) ||
+		!dsSharedMaterialValues_setBufferName(instanceValues,
+			dsSceneIndirectModelList_visibleInstancesName, modelList->visibleInstanceBuffer, 0,
+			visibleInstancesSize))
+	{
+		DS_PROFILE_FUNC_RETURN(false);
+	}
+
+	DS_PROFILE_FUNC_RETURN(true);
+}
+
+static void cullInstances(dsSceneIndirectModelList* modelList, const dsView* view,
+	dsCommandBuffer* commandBuffer)
+{
+	DS_PROFILE_FUNC_START();
+
+	dsRenderer* renderer = commandBuffer->renderer;
+	if (!DS_CHECK(DS_SCENE_LOG_TAG, dsGfxBuffer_copyData(modelList->drawArgsBuffer,
+			commandBuffer, 0, modelList->drawArgs,
+			sizeof(dsDrawIndexedRange)*modelList->drawCount)))
+	{
+		DS_PROFILE_FUNC_RETURN_VOID();
+	}
+
+	dsGfxMemoryBarrier copyBarrier = {dsGfxAccess_CopyWrite,
+		dsGfxAccess_UniformBufferRead | dsGfxAccess_UniformBufferWrite};
+	DS_CHECK(DS_SCENE_LOG_TAG, dsRenderer_memoryBarrier(renderer, commandBuffer,
+		dsGfxPipelineStage_Copy,
+		dsGfxPipelineStage_ComputeShader | dsGfxPipelineStage_VertexShader, &copyBarrier, 1));
+
+	if (!DS_CHECK(DS_SCENE_LOG_TAG, dsShader_bindCompute(modelList->cullShader, commandBuffer,
+			modelList->cullMaterial, view->globalValues)))
+	{
+		DS_PROFILE_FUNC_RETURN_VOID();
+	}
+
+	uint32_t groupCount = (modelList->instanceCount + DS_SCENE_INDIRECT_CULL_WORK_GROUP_SIZE - 1)/
+		DS_SCENE_INDIRECT_CULL_WORK_GROUP_SIZE;
+	DS_CHECK(DS_SCENE_LOG_TAG,
+		dsRenderer_dispatchCompute(renderer, commandBuffer, groupCount, 1, 1));
+	DS_CHECK(DS_SCENE_LOG_TAG, dsShader_unbindCompute(modelList->cullShader, commandBuffer));
+
+	dsGfxMemoryBarrier cullBarrier = {dsGfxAccess_UniformBufferWrite,
+		dsGfxAccess_IndirectCommandRead | dsGfxAccess_UniformBufferRead};
+	DS_CHECK(DS_SCENE_LOG_TAG, dsRenderer_memoryBarrier(renderer, commandBuffer,
+		dsGfxPipelineStage_ComputeShader,
+		dsGfxPipelineStage_DrawIndirect | dsGfxPipelineStage_VertexShader, &cullBarrier, 1));
+
+	DS_PROFILE_FUNC_RETURN_VOID();
+}
+
+static void drawInstances(dsSceneIndirectModelList* modelList, const dsView* view,
+	dsCommandBuffer* commandBuffer)
+{
+	DS_PROFILE_FUNC_START();
+
+	dsRenderer* renderer = commandBuffer->renderer;
+	dsShader* lastShader = NULL;
+	dsMaterial* lastMaterial = NULL;
+	dsDynamicRenderStates* renderStates =
+		modelList->hasRenderStates ? &modelList->renderStates : NULL;
+	for (uint32_t i = 0; i < modelList->drawCount;)
+	{
+		const DrawItem* drawItem = modelList->drawItems + i;
+
+		// Consecutive draws that only differ by draw range can be drawn together.
+		uint32_t count = 1;
+		while (i + count < modelList->drawCount)
+		{
+			const DrawItem* nextItem = drawItem + count;
+			if (nextItem->shader != drawItem->shader || nextItem->material != drawItem->material ||
+				nextItem->geometry != drawItem->geometry ||
+				nextItem->primitiveType != drawItem->primitiveType)
+			{
+				break;
+			}
+			++count;
+		}
+
+		uint32_t firstDraw = i;
+		i += count;
+
+		if (drawItem->shader != lastShader || drawItem->material != lastMaterial)
+		{
+			if (lastShader)
+				dsShader_unbind(lastShader, commandBuffer);
+
+			lastShader = NULL;
+			lastMaterial = NULL;
+			if (!DS_CHECK(DS_SCENE_LOG_TAG, dsShader_bind(drawItem->shader, commandBuffer,
+					drawItem->material, view->globalValues, renderStates)))
+			{
+				continue;
+			}
+
+			lastShader = drawItem->shader;
+			lastMaterial = drawItem->material;
+			DS_CHECK(DS_SCENE_LOG_TAG, dsShader_updateInstanceValues(drawItem->shader,
+				commandBuffer, modelList->instanceValues));
+		}
+
+		DS_CHECK(DS_SCENE_LOG_TAG, dsRenderer_drawIndexedIndirect(renderer, commandBuffer,
+			drawItem->geometry, modelList->drawArgsBuffer,
+			sizeof(dsDrawIndexedRange)*firstDraw, count, sizeof(dsDrawIndexedRange),
+			drawItem->primitiveType));
+	}
+
+	if (lastShader)
+		dsShader_unbind(lastShader, commandBuffer);
+
+	DS_PROFILE_FUNC_RETURN_VOID();
+}
+
+static uint64_t dsSceneIndirectModelList_addNode(dsSceneItemList* itemList, dsSceneNode* node,
+	dsSceneTreeNode* treeNode, const dsSceneNodeItemData* itemData, void** thisItemData)
+{
+	DS_ASSERT(itemList);
+	DS_UNUSED(itemData);
+	DS_UNUSED(thisItemData);
+	if (!dsSceneNode_isOfType(node, dsSceneModelNode_type()))
+		return DS_NO_SCENE_NODE;
+
+	const dsSceneModelNode* modelNode = (const dsSceneModelNode*)node;
+	for (uint32_t i = 0; i < modelNode->modelCount; ++i)
+	{
+		dsSceneModelInfo* model = modelNode->models + i;
+		if (model->modelListID != itemList->nameID)
+			continue;
+
+		if (!model->shader || !model->material)
+			return DS_NO_SCENE_NODE;
+
+		if (!isModelValid(model))
+		{
+			DS_LOG_ERROR_F(DS_SCENE_LOG_TAG, "Models for indirect model list '%s' must have index "
+				"buffers and draw a single instance.", itemList->name);
+			return DS_NO_SCENE_NODE;
+		}
+	}
+
+	dsSceneIndirectModelList* modelList = (dsSceneIndirectModelList*)itemList;
+
+	uint32_t index = modelList->entryCount;
+	if (!DS_RESIZEABLE_ARRAY_ADD(itemList->allocator, modelList->entries, modelList->entryCount,
+			modelList->maxEntries, 1))
+	{
+		return DS_NO_SCENE_NODE;
+	}
+
+	Entry* entry = modelList->entries + index;
+	entry->node = modelNode;
+	entry->transform = &treeNode->curFrameWorldTransform;
+	entry->nodeID = modelList->nextNodeID++;
+	modelList->entriesChanged = true;
+	return entry->nodeID;
+}
+
+static void dsSceneIndirectModelList_updateNode(
+	dsSceneItemList* itemList, dsSceneTreeNode* treeNode, uint64_t nodeID)
+{
+	DS_ASSERT(itemList);
+	DS_UNUSED(treeNode);
+	DS_UNUSED(nodeID);
+
+	// Only called when the transform changes, otherwise the uploaded instances are kept.
+	dsSceneIndirectModelList* modelList = (dsSceneIndirectModelList*)itemList;
+	modelList->transformsChanged = true;
+}
+
+static void dsSceneIndirectModelList_removeNode(
+	dsSceneItemList* itemList, dsSceneTreeNode* treeNode, uint64_t nodeID)
+{
+	DS_ASSERT(itemList);
+	DS_UNUSED(treeNode);
+	dsSceneIndirectModelList* modelList = (dsSceneIndirectModelList*)itemList;
+	modelList->entriesChanged = true;
+
+	uint32_t index = modelList->removeEntryCount;
+	if (DS_RESIZEABLE_ARRAY_ADD(itemList->allocator, modelList->removeEntries,
+			modelList->removeEntryCount, modelList->maxRemoveEntries, 1))
+	{
+		modelList->removeEntries[index] = nodeID;
+	}
+	else
+	{
+		dsSceneItemListEntries_removeSingle(modelList->entries, &modelList->entryCount,
+			sizeof(Entry), offsetof(Entry, nodeID), nodeID);
+	}
+}
+
+static void dsSceneIndirectModelList_preRenderPass(dsSceneItemList* itemList, const dsView* view,
+	dsCommandBuffer* commandBuffer, const dsViewRenderPassParams* renderPassParams)
+{
+	DS_ASSERT(itemList);
+	DS_UNUSED(renderPassParams);
+	dsSceneIndirectModelList* modelList = (dsSceneIndirectModelList*)itemList;
+	dsRenderer* renderer = commandBuffer->renderer;
+	dsRenderer_pushDebugGroup(renderer, commandBuffer, itemList->name);
+
+	// Lazily remove entries.
+	dsSceneItemListEntries_removeMulti(modelList->entries, &modelList->entryCount, sizeof(Entry),
+		offsetof(Entry, nodeID), modelList->removeEntries, modelList->removeEntryCount);
+	modelList->removeEntryCount = 0;
+
+	if (modelList->entriesChanged)
+	{
+		// Try again next time if the instances couldn't be rebuilt.
+		bool rebuilt = rebuildInstances(modelList);
+		modelList->needsUpload = rebuilt;
+		modelList->entriesChanged = !rebuilt;
+		modelList->transformsChanged = false;
+	}
+	else if (modelList->transformsChanged)
+	{
+		updateInstances(modelList);
+		modelList->needsUpload = true;
+		modelList->transformsChanged = false;
+	}
+
+	if (modelList->instanceCount == 0)
+	{
+		dsRenderer_popDebugGroup(renderer, commandBuffer);
+		return;
+	}
+
+	// Previous draws with the same buffers, such as from another view, must finish before they are
+	// written to again.
+	dsGfxMemoryBarrier drawBarrier = {
+		dsGfxAccess_IndirectCommandRead | dsGfxAccess_UniformBufferRead,
+		dsGfxAccess_CopyWrite | dsGfxAccess_UniformBufferWrite};
+	DS_CHECK(DS_SCENE_LOG_TAG, dsRenderer_memoryBarrier(renderer, commandBuffer,
+		dsGfxPipelineStage_DrawIndirect | dsGfxPipelineStage_VertexShader,
+		dsGfxPipelineStage_Copy | dsGfxPipelineStage_ComputeShader, &drawBarrier, 1));
+
+	if (modelList->needsUpload)
+	{
+		if (!DS_CHECK(DS_SCENE_LOG_TAG, uploadInstances(modelList, commandBuffer)))
+		{
+			// Avoid drawing with partially updated buffers.
+			modelList->drawCount = 0;
+			modelList->entriesChanged = true;
+			dsRenderer_popDebugGroup(renderer, commandBuffer);
+			return;
+		}
+		modelList->needsUpload = false;
+	}
+
+	cullInstances(modelList, view, commandBuffer);
+	dsRenderer_popDebugGroup(renderer, commandBuffer);
+}
+
+static void dsSceneIndirectModelList_commit(dsSceneItemList* itemList, const dsView* view,
+	dsCommandBuffer* commandBuffer, const dsViewRenderPassParams* renderPassParams)
+{
+	DS_ASSERT(itemList);
+	DS_UNUSED(renderPassParams);
+	dsSceneIndirectModelList* modelList = (dsSceneIndirectModelList*)itemList;
+	if (modelList->instanceCount == 0 || modelList->drawCount == 0)
+		return;
+
+	dsRenderer_pushDebugGroup(commandBuffer->renderer, commandBuffer, itemList->name);
+	drawInstances(modelList, view, commandBuffer);
+	dsRenderer_popDebugGroup(commandBuffer->renderer, commandBuffer);
+}
+
+static uint32_t dsSceneIndirectModelList_hash(const dsSceneItemList* itemList,
+	uint32_t commonHash)
+{
+	DS_ASSERT(itemList);
+	const dsSceneIndirectModelList* modelList = (const dsSceneIndirectModelList*)itemList;
+	const void* hashPtrs[2] = {modelList->cullShader, modelList->cullMaterial};
+	uint32_t hash = dsHashCombineBytes(commonHash, hashPtrs, sizeof(hashPtrs));
+	if (modelList->hasRenderStates)
+		hash = dsHashCombineBytes(hash, &modelList->renderStates, sizeof(dsDynamicRenderStates));
+	return hash;
+}
+
+static bool dsSceneIndirectModelList_equal(const dsSceneItemList* left,
+	const dsSceneItemList* right)
+{
+	DS_ASSERT(left);
+	DS_ASSERT(left->type == dsSceneIndirectModelList_type());
+	DS_ASSERT(right);
+	DS_ASSERT(right->type == dsSceneIndirectModelList_type());
+
+	const dsSceneIndirectModelList* leftModelList = (const dsSceneIndirectModelList*)left;
+	const dsSceneIndirectModelList* rightModelList = (const dsSceneIndirectModelList*)right;
+	return leftModelList->cullShader == rightModelList->cullShader &&
+		leftModelList->cullMaterial == rightModelList->cullMaterial &&
+		leftModelList->hasRenderStates == rightModelList->hasRenderStates &&
+		(!leftModelList->hasRenderStates || memcmp(&leftModelList->renderStates,
+			&rightModelList->renderStates, sizeof(dsDynamicRenderStates)) == 0);
+}
+
+static void dsSceneIndirectModelList_destroy(dsSceneItemList* itemList)
+{
+	DS_ASSERT(itemList);
+	dsSceneIndirectModelList* modelList = (dsSceneIndirectModelList*)itemList;
+	DS_VERIFY(dsGfxBuffer_destroy(modelList->instanceBuffer));
+	DS_VERIFY(dsGfxBuffer_destroy(modelList->visibleInstanceBuffer));
+	DS_VERIFY(dsGfxBuffer_destroy(modelList->drawArgsBuffer));
+	dsSharedMaterialValues_destroy(modelList->instanceValues);
+	DS_VERIFY(dsAllocator_free(itemList->allocator, modelList->entries));
+	DS_VERIFY(dsAllocator_free(itemList->allocator, modelList->removeEntries));
+	DS_VERIFY(dsAllocator_free(itemList->allocator, modelList->instanceItems));
+	DS_VERIFY(dsAllocator_free(itemList->allocator, modelList->instances));
+	DS_VERIFY(dsAllocator_free(itemList->allocator, modelList->drawItems));
+	DS_VERIFY(dsAllocator_free(itemList->allocator, modelList->drawArgs));
+	DS_VERIFY(dsAllocator_free(itemList->allocator, modelList));
+}
+
+const char* const dsSceneIndirectModelList_typeName = "IndirectModelList";
+const char* const dsSceneIndirectModelList_instancesName = "IndirectInstances";
+const char* const dsSceneIndirectModelList_visibleInstancesName = "IndirectVisibleInstances";
+const char* const dsSceneIndirectModelList_drawArgsName = "IndirectDrawArgs";
+
+static dsSceneItemListType itemListType =
+{
+	.addNodeFunc = &dsSceneIndirectModelList_addNode,
+	.updateNodeFunc = &dsSceneIndirectModelList_updateNode,
+	.removeNodeFunc = &dsSceneIndirectModelList_removeNode,
+	.preRenderPassFunc = &dsSceneIndirectModelList_preRenderPass,
+	.commitFunc = &dsSceneIndirectModelList_commit,
+	.hashFunc = &dsSceneIndirectModelList_hash,
+	.equalFunc = &dsSceneIndirectModelList_equal,
+	.destroyFunc = &dsSceneIndirectModelList_destroy
+};
+
+static uint32_t findCullBufferElement(const dsMaterialDesc* materialDesc, const char* name)
+{
+	uint32_t element = dsMaterialDesc_findElement(materialDesc, name);
+	if (element == DS_MATERIAL_UNKNOWN)
+	{
+		DS_LOG_ERROR_F(DS_SCENE_LOG_TAG,
+			"Indirect model list cull material doesn't contain element '%s'.", name);
+		return DS_MATERIAL_UNKNOWN;
+	}
+
+	const dsMaterialElement* materialElement = materialDesc->elements + element;
+	if (materialElement->type != dsMaterialType_UniformBuffer ||
+		materialElement->binding != dsMaterialBinding_Material)
+	{
+		DS_LOG_ERROR_F(DS_SCENE_LOG_TAG, "Indirect model list cull material element '%s' must "
+			"be a uniform buffer with material binding.", name);
+		return DS_MATERIAL_UNKNOWN;
+	}
+
+	return element;
+}
+
+const dsSceneItemListType* dsSceneIndirectModelList_type(void)
+{
+	return &itemListType;
+}
+
+bool dsSceneIndirectModelList_isSupported(const dsRenderer* renderer)
+{
+	if (!renderer)
+		return false;
+
+	dsGfxBufferUsage requiredBuffers = dsGfxBufferUsage_UniformBuffer |
+		dsGfxBufferUsage_IndirectDraw | dsGfxBufferUsage_CopyTo;
+	return renderer->hasStartInstance && renderer->drawIndexedIndirectFunc &&
+		renderer->maxComputeWorkGroupSize[0] >= DS_SCENE_INDIRECT_CULL_WORK_GROUP_SIZE &&
+		(renderer->resourceManager->supportedBuffers & requiredBuffers) == requiredBuffers;
+}
+
+dsSceneIndirectModelList* dsSceneIndirectModelList_create(dsAllocator* allocator,
+	dsResourceManager* resourceManager, dsAllocator* resourceAllocator, const char* name,
+	const dsViewFilter* viewFilter, dsShader* cullShader, dsMaterial* cullMaterial,
+	const dsDynamicRenderStates* renderStates)
+{
+	if (!allocator || !resourceManager || !name || !cullShader || !cullMaterial)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (!allocator->freeFunc)
+	{
+		errno = EINVAL;
+		DS_LOG_ERROR(DS_SCENE_LOG_TAG,
+			"Scene indirect model list allocator must support freeing memory.");
+		return NULL;
+	}
+
+	if (!dsSceneIndirectModelList_isSupported(resourceManager->renderer))
+	{
+		errno = EPERM;
+		DS_LOG_ERROR(DS_SCENE_LOG_TAG,
+			"Current target doesn't support the features required for indirect model lists.");
+		return NULL;
+	}
+
+	if (!dsShader_hasStage(cullShader, dsShaderStage_Compute))
+	{
+		errno = EINVAL;
+		DS_LOG_ERROR(DS_SCENE_LOG_TAG,
+			"Scene indirect model list cull shader must have a compute stage.");
+		return NULL;
+	}
+
+	const dsMaterialDesc* cullMaterialDesc = dsMaterial_getDescription(cullMaterial);
+	uint32_t instancesElement = findCullBufferElement(cullMaterialDesc,
+		dsSceneIndirectModelList_instancesName);
+	uint32_t visibleInstancesElement = findCullBufferElement(cullMaterialDesc,
+		dsSceneIndirectModelList_visibleInstancesName);
+	uint32_t drawArgsElement = findCullBufferElement(cullMaterialDesc,
+		dsSceneIndirectModelList_drawArgsName);
+	if (instancesElement == DS_MATERIAL_UNKNOWN ||
+		visibleInstancesElement == DS_MATERIAL_UNKNOWN || drawArgsElement == DS_MATERIAL_UNKNOWN)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if (!resourceAllocator)
+		resourceAllocator = allocator;
+
+	const uint32_t instanceValueCount = 2;
+	size_t fullSize = sizeof(dsSceneIndirectModelList);
+	size_t nameLen = strlen(name) + 1;
+	dsMemorySize sizes[] =
+	{
+		{sizeof(char), nameLen},
+		{dsSharedMaterialValues_fullAllocSize(instanceValueCount), 1}
+	};
+	if (!dsAccumulateAlignedSizes(&fullSize, sizes, DS_ARRAY_SIZE(sizes), DS_ALLOC_ALIGNMENT))
+		return NULL;
+
+	void* buffer = dsAllocator_alloc(allocator, fullSize);
+	if (!buffer)
+		return NULL;
+
+	dsBufferAllocator bufferAlloc;
+	DS_VERIFY(dsBufferAllocator_initialize(&bufferAlloc, buffer, fullSize));
+	dsSceneIndirectModelList* modelList =
+		DS_ALLOCATE_OBJECT(&bufferAlloc, dsSceneIndirectModelList);
+	DS_ASSERT(modelList);
+
+	dsSceneItemList* itemList = (dsSceneItemList*)modelList;
+	itemList->allocator = allocator;
+	itemList->type = dsSceneIndirectModelList_type();
+	itemList->viewFilter = viewFilter;
+	itemList->name = DS_ALLOCATE_OBJECT_ARRAY(&bufferAlloc, char, nameLen);
+	memcpy((void*)itemList->name, name, nameLen);
+	itemList->nameID = dsUniqueNameID_create(name);
+	itemList->globalValueCount = 0;
+	itemList->needsCommandBuffer = true;
+	itemList->skipPreRenderPass = false;
+
+	modelList->resourceManager = resourceManager;
+	modelList->resourceAllocator = resourceAllocator;
+	modelList->cullShader = cullShader;
+	modelList->cullMaterial = cullMaterial;
+	modelList->instancesElement = instancesElement;
+	modelList->visibleInstancesElement = visibleInstancesElement;
+	modelList->drawArgsElement = drawArgsElement;
+
+	if (renderStates)
+	{
+		modelList->renderStates = *renderStates;
+		modelList->hasRenderStates = true;
+	}
+	else
+		modelList->hasRenderStates = false;
+
+	modelList->instanceValues = dsSharedMaterialValues_create(
+		(dsAllocator*)&bufferAlloc, instanceValueCount);
+	DS_ASSERT(modelList->instanceValues);
+
+	modelList->entries = NULL;
+	modelList->entryCount = 0;
+	modelList->maxEntries = 0;
+	modelList->nextNodeID = 0;
+
+	modelList->removeEntries = NULL;
+	modelList->removeEntryCount = 0;
+	modelList->maxRemoveEntries = 0;
+
+	modelList->entriesChanged = false;
+	modelList->transformsChanged = false;
+	modelList->needsUpload = false;
+
+	modelList->instanceItems = NULL;
+	modelList->instanceCount = 0;
+	modelList->maxInstanceItems = 0;
+
+	modelList->instances = NULL;
+	modelList->maxInstances = 0;
+
+	modelList->drawItems = NULL;
+	modelList->drawCount = 0;
+	modelList->maxDrawItems = 0;
+
+	modelList->drawArgs = NULL;
+	modelList->maxDrawArgs = 0;
+
+	modelList->instanceBuffer = NULL;
+	modelList->visibleInstanceBuffer = NULL;
+	modelList->drawArgsBuffer = NULL;
+
+	return modelList;
+}
+
+uint32_t dsSceneIndirectModelList_getInstanceCount(const dsSceneIndirectModelList* modelList)
+{
+	return modelList ? modelList->instanceCount : 0;
+}
+
+uint32_t dsSceneIndirectModelList_getDrawCount(const dsSceneIndirectModelList* modelList)
+{
+	return modelList ? modelList->drawCount : 0;
+}
@@ -18,6 +18,7 @@
 
 #include <DeepSea/Core/Containers/Hash.h>
 #include <DeepSea/Core/Error.h>
+#include <DeepSea/Core/Log.h>
 
 bool dsSceneInstanceData_populateData(dsSceneInstanceData* instanceData,
 	const dsView* view, dsCommandBuffer* commandBuffer,
@@ -48,6 +49,30 @@ bool dsSceneInstanceData_bindInstance(
 	return instanceData->type->bindInstanceFunc(instanceData, index, values);
 }
 
+bool dsSceneInstanceData_bindInstanceRange(dsSceneInstanceData* instanceData,
+	uint32_t index, uint32_t count, dsSharedMaterialValues* values)
+{
+	if (!instanceData || !instanceData->type || !instanceData->type->bindInstanceFunc ||
+		(!values && instanceData->valueCount > 0) || count == 0)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (count == 1)
+		return instanceData->type->bindInstanceFunc(instanceData, index, values);
+
+	if (!instanceData->type->bindInstanceRangeFunc || count > instanceData->maxInstanceRange)
+	{
+		errno = EPERM;
+		DS_LOG_ERROR(DS_SCENE_LOG_TAG,
+			"Instance range is larger than supported by the scene instance data.");
+		return false;
+	}
+
+	return instanceData->type->bindInstanceRangeFunc(instanceData, index, count, values);
+}
+
 bool dsSceneInstanceData_finish(dsSceneInstanceData* instanceData)
 {
 	if (!instanceData || !instanceData->type || !instanceData->type->finishFunc)
@@ -59,6 +59,7 @@ typedef struct dsSceneInstanceVariables
 	uint32_t nameID;
 	uint32_t instanceSize;
 	uint32_t stride;
+	bool instanced;
 
 	const dsSceneInstanceVariablesType* instanceVariablesType;
 	void* userData;
@@ -124,9 +125,11 @@ static bool reserveSpace(dsSceneInstanceVariables* variables, uint32_t maxInstan
 		}
 
 		dsGfxMemory memoryHints = dsGfxMemory_Stream | dsGfxMemory_Synchronize;
+		dsGfxBufferUsage usage = variables->instanced ? dsGfxBufferUsage_UniformBuffer :
+			dsGfxBufferUsage_UniformBlock;
 		BufferInfo* bufferInfo = variables->buffers + index;
-		bufferInfo->buffer = dsGfxBuffer_create(resourceManager, resourceAllocator,
-			dsGfxBufferUsage_UniformBlock, memoryHints, NULL, requiredSize);
+		bufferInfo->buffer = dsGfxBuffer_create(resourceManager, resourceAllocator, usage,
+			memoryHints, NULL, requiredSize);
 		if (!bufferInfo->buffer)
 		{
 			--variables->bufferCount;
@@ -178,7 +181,8 @@ static bool dsSceneInstanceVariables_bindInstance(
 	DS_ASSERT(variables);
 	DS_ASSERT(values);
 
-	if (index >= variables->curInstanceCount)
+	if (index >= variables->curInstanceCount ||
+		index % ((dsSceneInstanceData*)variables)->instanceAlignment != 0)
 	{
 		errno = EINDEX;
 		return false;
@@ -187,8 +191,10 @@ static bool dsSceneInstanceVariables_bindInstance(
 	BufferInfo* curBuffer = variables->curBuffer;
 	if (curBuffer)
 	{
+		// Instanced data is bound as an array, so include the padding for the array stride.
 		return dsSharedMaterialValues_setBufferID(values, variables->nameID, curBuffer->buffer,
-			index*variables->stride, variables->instanceSize);
+			index*variables->stride,
+			variables->instanced ? variables->stride : variables->instanceSize);
 	}
 
 	// Instance count should be 0 if not in a valid state, so should only get here if fallback.
@@ -238,6 +244,29 @@ static bool dsSceneInstanceVariables_bindInstance(
 	return dsSharedMaterialValues_setVariableGroupID(values, variables->nameID, group);
 }
 
+static bool dsSceneInstanceVariables_bindInstanceRange(dsSceneInstanceData* instanceData,
+	uint32_t index, uint32_t count, dsSharedMaterialValues* values)
+{
+	dsSceneInstanceVariables* variables = (dsSceneInstanceVariables*)instanceData;
+	DS_ASSERT(variables);
+	DS_ASSERT(values);
+
+	if (!DS_IS_BUFFER_RANGE_VALID(index, count, variables->curInstanceCount) ||
+		index % instanceData->instanceAlignment != 0)
+	{
+		errno = EINDEX;
+		return false;
+	}
+
+	// Only instanced variables have a max instance range larger than 1, and never use the
+	// fallback.
+	DS_ASSERT(variables->instanced);
+	BufferInfo* curBuffer = variables->curBuffer;
+	DS_ASSERT(curBuffer);
+	return dsSharedMaterialValues_setBufferID(values, variables->nameID, curBuffer->buffer,
+		index*variables->stride, count*variables->stride);
+}
+
 static bool dsSceneInstanceVariables_finish(dsSceneInstanceData* instanceData)
 {
 	dsSceneInstanceVariables* variables = (dsSceneInstanceVariables*)instanceData;
@@ -256,6 +285,7 @@ static uint32_t dsSceneInstanceVariables_hash(
 	DS_ASSERT(variables);
 
 	uint32_t hash = dsHashCombinePointer(commonHash, variables->instanceVariablesType);
+	hash = dsHashCombine8(hash, &variables->instanced);
 	dsHashSceneInstanceVariablesFunction hashFunc = variables->instanceVariablesType->hashFunc;
 	if (hashFunc)
 		hash = hashFunc(variables->userData, hash);
@@ -276,6 +306,7 @@ static bool dsSceneInstanceVariables_equal(
 	dsSceneInstanceVariablesEqualFunction equalFunc =
 		leftVariables->instanceVariablesType->equalFunc;
 	return leftVariables->instanceVariablesType == rightVariables->instanceVariablesType &&
+		leftVariables->instanced == rightVariables->instanced &&
 		(!equalFunc || equalFunc(leftVariables->userData, rightVariables->userData));
 }
 
@@ -311,6 +342,7 @@ static dsSceneInstanceDataType instanceDataType =
 {
 	&dsSceneInstanceVariables_populateData,
 	&dsSceneInstanceVariables_bindInstance,
+	&dsSceneInstanceVariables_bindInstanceRange,
 	&dsSceneInstanceVariables_finish,
 	&dsSceneInstanceVariables_hash,
 	&dsSceneInstanceVariables_equal,
@@ -322,10 +354,10 @@ const dsSceneInstanceDataType* dsSceneInstanceVariables_type(void)
 	return &instanceDataType;
 }
 
-dsSceneInstanceData* dsSceneInstanceVariables_create(dsAllocator* allocator,
+static dsSceneInstanceData* createInstanceVariables(dsAllocator* allocator,
 	dsResourceManager* resourceManager, dsAllocator* resourceAllocator,
 	const dsShaderVariableGroupDesc* dataDesc, uint32_t nameID,
-	const dsSceneInstanceVariablesType* instanceVariablesType, void* userData)
+	const dsSceneInstanceVariablesType* instanceVariablesType, void* userData, bool instanced)
 {
 	if (!allocator || !resourceManager || !dataDesc || !instanceVariablesType ||
 		!instanceVariablesType->populateFunc)
@@ -347,11 +379,22 @@ dsSceneInstanceData* dsSceneInstanceVariables_create(dsAllocator* allocator,
 		return NULL;
 	}
 
+	if (instanced && !(resourceManager->supportedBuffers & dsGfxBufferUsage_UniformBuffer))
+	{
+		dsDestroyUserDataFunction destroyUserDataFunc = instanceVariablesType->destroyUserDataFunc;
+		if (destroyUserDataFunc)
+			destroyUserDataFunc(userData);
+		errno = EPERM;
+		DS_LOG_ERROR(DS_SCENE_LOG_TAG,
+			"Instanced scene instance variables require support for uniform buffers.");
+		return NULL;
+	}
+
 	if (!resourceAllocator)
 		resourceAllocator = allocator;
 
 	size_t fullSize = sizeof(dsSceneInstanceVariables);
-	bool needsFallback = !dsShaderVariableGroup_useGfxBuffer(resourceManager);
+	bool needsFallback = !instanced && !dsShaderVariableGroup_useGfxBuffer(resourceManager);
 	if (needsFallback)
 	{
 		size_t variableGroupSize = dsShaderVariableGroup_fullAllocSize(resourceManager, dataDesc);
@@ -403,11 +446,32 @@ dsSceneInstanceData* dsSceneInstanceVariables_create(dsAllocator* allocator,
 	DS_ASSERT(instanceSize <= UINT_MAX);
 	variables->instanceSize = (uint32_t)instanceSize;
 
-	size_t stride = instanceSize;
-	if (resourceManager->minUniformBlockAlignment > 0)
-		stride = DS_ALIGNED_SIZE(stride, resourceManager->minUniformBlockAlignment);
-	DS_ASSERT(stride <= UINT_MAX);
-	variables->stride = (uint32_t)stride;
+	if (instanced)
+	{
+		// Instances are packed as an array of structs with std140 rules, which rounds the stride up
+		// to a multiple of a vec4. The first instance bound must match the buffer offset
+		// alignment, which is a number of instances based on the stride.
+		uint32_t stride = (uint32_t)DS_ALIGNED_SIZE(variables->instanceSize, 16);
+		uint32_t instanceAlignment = 1;
+		uint32_t offsetAlignment = resourceManager->minUniformBufferAlignment;
+		while (offsetAlignment > 0 && (stride*instanceAlignment) % offsetAlignment != 0)
+			++instanceAlignment;
+
+		variables->stride = stride;
+		instanceData->maxInstanceRange = UINT32_MAX;
+		instanceData->instanceAlignment = instanceAlignment;
+	}
+	else
+	{
+		size_t stride = instanceSize;
+		if (resourceManager->minUniformBlockAlignment > 0)
+			stride = DS_ALIGNED_SIZE(stride, resourceManager->minUniformBlockAlignment);
+		DS_ASSERT(stride <= UINT_MAX);
+		variables->stride = (uint32_t)stride;
+		instanceData->maxInstanceRange = 1;
+		instanceData->instanceAlignment = 1;
+	}
+	variables->instanced = instanced;
 
 	variables->instanceVariablesType = instanceVariablesType;
 	variables->userData = userData;
@@ -452,3 +516,21 @@ dsSceneInstanceData* dsSceneInstanceVariables_create(dsAllocator* allocator,
 
 	return instanceData;
 }
+
+dsSceneInstanceData* dsSceneInstanceVariables_create(dsAllocator* allocator,
+	dsResourceManager* resourceManager, dsAllocator* resourceAllocator,
+	const dsShaderVariableGroupDesc* dataDesc, uint32_t nameID,
+	const dsSceneInstanceVariablesType* instanceVariablesType, void* userData)
+{
+	return createInstanceVariables(allocator, resourceManager, resourceAllocator, dataDesc, nameID,
+		instanceVariablesType, userData, false);
+}
+
+dsSceneInstanceData* dsSceneInstanceVariables_createInstanced(dsAllocator* allocator,
+	dsResourceManager* resourceManager, dsAllocator* resourceAllocator,
+	const dsShaderVariableGroupDesc* dataDesc, uint32_t nameID,
+	const dsSceneInstanceVariablesType* instanceVariablesType, void* userData)
+{
+	return createInstanceVariables(allocator, resourceManager, resourceAllocator, dataDesc, nameID,
+		instanceVariablesType, userData, true);
+}
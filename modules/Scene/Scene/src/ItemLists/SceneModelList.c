@@ -17,9 +17,11 @@
 #include <DeepSea/Scene/ItemLists/SceneModelList.h>
 
 #include <DeepSea/Core/Containers/Hash.h>
+#include <DeepSea/Core/Containers/HashMap.h>
 #include <DeepSea/Core/Containers/ResizeableArray.h>
 #include <DeepSea/Core/Memory/Allocator.h>
 #include <DeepSea/Core/Memory/BufferAllocator.h>
+#include <DeepSea/Core/Memory/StackAllocator.h>
 #include <DeepSea/Core/Assert.h>
 #include <DeepSea/Core/Error.h>
 #include <DeepSea/Core/Log.h>
@@ -30,6 +32,7 @@
 #include <DeepSea/Geometry/OrientedBox3.h>
 #include <DeepSea/Geometry/Frustum3.h>
 
+#include <DeepSea/Math/Core.h>
 #include <DeepSea/Math/Matrix44.h>
 #include <DeepSea/Math/Sqrt.h>
 #include <DeepSea/Math/Vector3.h>
@@ -43,6 +46,7 @@
 #include <DeepSea/Scene/Nodes/SceneModelNode.h>
 #include <DeepSea/Scene/Nodes/SceneNode.h>
 #include <DeepSea/Scene/Nodes/SceneNodeItemData.h>
+#include <DeepSea/Scene/Scene.h>
 
 #include <stdlib.h>
 #include <string.h>
@@ -53,7 +57,12 @@ typedef struct Entry
 	const dsSceneTreeNode* treeNode;
 	const dsMatrix44f* transform;
 	const dsSceneNodeItemData* itemData;
+	// Packed shader, material, and geometry sort IDs for each model, interned when added.
+	uint64_t* modelSortIDs;
 	uint64_t nodeID;
+	// Indices for the cull list results within the item data.
+	uint64_t cullMask;
+	bool searchCullLists;
 } Entry;
 
 typedef struct DrawItem
@@ -62,13 +71,63 @@ typedef struct DrawItem
 	dsMaterial* material;
 	dsDrawGeometry* geometry;
 	uint32_t instance;
+	// Number of instances drawn when instancing, or 0 if drawn as part of a previous item.
+	uint32_t instanceCount;
 	float flatDistance;
 
 	const dsSceneModelDrawRange* drawRanges;
 	uint32_t drawRangeCount;
 	dsPrimitiveType primitiveType;
+	uint64_t sortIDs;
+
+	// Identifies the draw item across frames for incremental sorting.
+	uint64_t nodeID;
+	uint32_t modelIndex;
 } DrawItem;
 
+// Packed key with the index of the draw item so the radix sort only moves 16 bytes per item.
+typedef struct SortItem
+{
+	uint64_t key;
+	uint32_t index;
+	uint32_t padding;
+} SortItem;
+
+// Draw item from the previous sort, ordered by node ID and model index.
+typedef struct SortHistoryItem
+{
+	uint64_t nodeID;
+	uint32_t modelIndex;
+	uint32_t sortIndex;
+} SortHistoryItem;
+
+// Sorted order from the last time the model list was drawn with a view.
+typedef struct SortHistory
+{
+	const dsView* view;
+	dsModelSortType sortType;
+	uint64_t lastUsed;
+	SortHistoryItem* items;
+	uint32_t itemCount;
+	uint32_t maxItems;
+} SortHistory;
+
+// Bits for the object IDs packed into the sort keys. Material sorting uses shader, material, and
+// geometry IDs, while depth sorting uses the upper 32 bits for the distance and the lower 32 bits
+// for the shader and material IDs.
+#define SHADER_ID_BITS 20
+#define MATERIAL_ID_BITS 22
+#define GEOMETRY_ID_BITS 22
+#define DEPTH_ID_BITS 16
+
+// Maximum average number of places each item may move for an incremental sort before falling back
+// to a full sort.
+#define MAX_INCREMENTAL_SORT_SHIFTS 4
+
+// Maximum number of views to keep the sort history for. The least recently used history is
+// replaced when drawing with more views.
+#define MAX_SORT_HISTORY_VIEWS 4
+
 struct dsSceneModelList
 {
 	dsSceneItemList itemList;
@@ -76,6 +135,8 @@ struct dsSceneModelList
 	dsDynamicRenderStates renderStates;
 	bool hasRenderStates;
 	dsModelSortType sortType;
+	bool instancing;
+	bool incrementalSort;
 
 	dsSharedMaterialValues* instanceValues;
 	dsSceneInstanceData** instanceData;
@@ -96,9 +157,30 @@ struct dsSceneModelList
 	uint32_t instanceCount;
 	uint32_t maxInstances;
 
+	const dsSceneTreeNode** batchedInstances;
+	uint32_t maxBatchedInstances;
+
 	DrawItem* drawItems;
 	uint32_t drawItemCount;
 	uint32_t maxDrawItems;
+
+	SortItem* sortItems;
+	uint32_t maxSortItems;
+
+	SortItem* tempSortItems;
+	uint32_t maxTempSortItems;
+
+	// Maps shader, material, and geometry pointers to small IDs for the sort keys.
+	dsHashMap sortIDs;
+	uint32_t nextShaderID;
+	uint32_t nextMaterialID;
+	uint32_t nextGeometryID;
+
+	SortHistory sortHistories[MAX_SORT_HISTORY_VIEWS];
+	uint64_t sortHistoryCounter;
+
+	uint32_t* historySlots;
+	uint32_t maxHistorySlots;
 };
 
 static void addInstances(dsSceneItemList* itemList, const dsView* view)
@@ -113,16 +195,21 @@ static void addInstances(dsSceneItemList* itemList, const dsView* view)
 	{
 		const Entry* entry = modelList->entries + i;
 		const dsSceneModelNode* modelNode = entry->node;
+		// Non-zero cull result means out of view.
 		bool culled = false;
-		for (uint32_t j = 0; j < modelList->cullListCount; ++j)
+		if (entry->searchCullLists)
 		{
-			// Non-zero cull result means out of view.
-			if (dsSceneNodeItemData_findID(entry->itemData, modelList->cullListIDs[j]))
+			for (uint32_t j = 0; j < modelList->cullListCount; ++j)
 			{
-				culled = true;
-				break;
+				if (dsSceneNodeItemData_findID(entry->itemData, modelList->cullListIDs[j]))
+				{
+					culled = true;
+					break;
+				}
 			}
 		}
+		else
+			culled = dsSceneNodeItemData_anyInMask(entry->itemData, entry->cullMask);
 		if (culled)
 			continue;
 
@@ -162,11 +249,16 @@ static void addInstances(dsSceneItemList* itemList, const dsView* view)
 			item->material = model->material;
 			item->geometry = model->geometry;
 			item->instance = instanceIndex;
+			item->instanceCount = 1;
 			item->flatDistance = flatDistance;
 
 			item->drawRanges = model->drawRanges;
 			item->drawRangeCount = model->drawRangeCount;
 			item->primitiveType = model->primitiveType;
+			item->sortIDs = entry->modelSortIDs[j];
+
+			item->nodeID = entry->nodeID;
+			item->modelIndex = j;
 		}
 
 		if (!hasAny)
@@ -200,62 +292,405 @@ static void setupInstances(dsSceneModelList* modelList, const dsView* view,
 	DS_PROFILE_FUNC_RETURN_VOID();
 }
 
-static inline int sortByMaterial(const void* left, const void* right)
+static uint64_t getSortID(dsSceneModelList* modelList, const void* object, uint32_t* nextID)
+{
+	dsHashMapEntry* entry = dsHashMap_find(&modelList->sortIDs, object);
+	if (entry)
+		return (uint32_t)(size_t)entry->value;
+
+	// Objects that fail to be added may share an ID with another object, which only affects the
+	// sort quality.
+	uint32_t id = *nextID;
+	if (dsHashMap_insert(&modelList->sortIDs, object, (void*)(size_t)id, NULL))
+		++*nextID;
+	return id;
+}
+
+static void internModelSortIDs(dsSceneModelList* modelList, Entry* entry)
+{
+	const dsSceneModelNode* modelNode = entry->node;
+	for (uint32_t i = 0; i < modelNode->modelCount; ++i)
+	{
+		const dsSceneModelInfo* model = modelNode->models + i;
+		uint64_t shaderID = getSortID(modelList, model->shader, &modelList->nextShaderID);
+		uint64_t materialID = getSortID(modelList, model->material, &modelList->nextMaterialID);
+		uint64_t geometryID = getSortID(modelList, model->geometry, &modelList->nextGeometryID);
+		entry->modelSortIDs[i] = shaderID << (MATERIAL_ID_BITS + GEOMETRY_ID_BITS) |
+			materialID << GEOMETRY_ID_BITS | geometryID;
+	}
+}
+
+static void addModelSortIDs(dsSceneModelList* modelList, Entry* entry)
+{
+	// Start the IDs over once they would no longer fit in the key, re-interning the IDs for all
+	// entries. IDs for objects that are no longer used are otherwise kept, so they remain stable
+	// across frames.
+	uint32_t modelCount = entry->node->modelCount;
+	if (modelList->nextShaderID + modelCount > (1U << SHADER_ID_BITS) ||
+		modelList->nextMaterialID + modelCount > (1U << MATERIAL_ID_BITS) ||
+		modelList->nextGeometryID + modelCount > (1U << GEOMETRY_ID_BITS))
+	{
+		DS_VERIFY(dsHashMap_clear(&modelList->sortIDs));
+		modelList->nextShaderID = 0;
+		modelList->nextMaterialID = 0;
+		modelList->nextGeometryID = 0;
+		for (uint32_t i = 0; i < modelList->entryCount; ++i)
+		{
+			Entry* otherEntry = modelList->entries + i;
+			if (otherEntry != entry && otherEntry->modelSortIDs)
+				internModelSortIDs(modelList, otherEntry);
+		}
+	}
+
+	internModelSortIDs(modelList, entry);
+}
+
+static inline uint32_t sortableDistance(float distance)
+{
+	// Flip the sign bit for positive values and all bits for negative values so the integer order
+	// matches the float order.
+	uint32_t bits;
+	memcpy(&bits, &distance, sizeof(uint32_t));
+	uint32_t mask = -(int32_t)(bits >> 31) | 0x80000000;
+	return bits ^ mask;
+}
+
+static inline int compareHistory(const SortHistoryItem* history, const DrawItem* drawItem)
+{
+	int nodeCmp = DS_CMP(history->nodeID, drawItem->nodeID);
+	int modelCmp = DS_CMP(history->modelIndex, drawItem->modelIndex);
+	return dsCombineCmp(nodeCmp, modelCmp);
+}
+
+static SortHistory* findSortHistory(dsSceneModelList* modelList, const dsView* view)
+{
+	for (uint32_t i = 0; i < MAX_SORT_HISTORY_VIEWS; ++i)
+	{
+		SortHistory* sortHistory = modelList->sortHistories + i;
+		if (sortHistory->view == view)
+			return sortHistory;
+	}
+
+	return NULL;
+}
+
+static bool resortFromHistory(dsSceneModelList* modelList, const dsView* view)
+{
+	const SortHistory* sortHistory = findSortHistory(modelList, view);
+	if (!sortHistory || sortHistory->itemCount == 0 ||
+		modelList->sortType != sortHistory->sortType)
+	{
+		return false;
+	}
+
+	uint32_t historyCount = sortHistory->itemCount;
+
+	dsSceneItemList* itemList = (dsSceneItemList*)modelList;
+	uint32_t slotCount = 0;
+	if (!DS_RESIZEABLE_ARRAY_ADD(itemList->allocator, modelList->historySlots, slotCount,
+			modelList->maxHistorySlots, historyCount))
+	{
+		return false;
+	}
+
+	// Draw items are added in node ID and model order, same as the history, so the items from the
+	// previous frame can be matched with a single pass. Each matched item is placed in the slot
+	// for its previous sorted position, while new items are placed at the end.
+	uint32_t* historySlots = modelList->historySlots;
+	memset(historySlots, 0xFF, sizeof(uint32_t)*historyCount);
+	const SortHistoryItem* history = sortHistory->items;
+	const SortItem* sortItems = modelList->sortItems;
+	SortItem* tempSortItems = modelList->tempSortItems;
+	uint32_t drawItemCount = modelList->drawItemCount;
+	uint32_t newItemCount = 0;
+	uint32_t historyIndex = 0;
+	for (uint32_t i = 0; i < drawItemCount; ++i)
+	{
+		const DrawItem* drawItem = modelList->drawItems + i;
+		int cmp = -1;
+		while (historyIndex < historyCount &&
+			(cmp = compareHistory(history + historyIndex, drawItem)) < 0)
+		{
+			++historyIndex;
+		}
+
+		if (cmp == 0)
+			historySlots[history[historyIndex++].sortIndex] = i;
+		else
+			tempSortItems[drawItemCount - ++newItemCount] = sortItems[i];
+	}
+
+	uint32_t matchedCount = 0;
+	for (uint32_t i = 0; i < historyCount; ++i)
+	{
+		uint32_t index = historySlots[i];
+		if (index != UINT32_MAX)
+			tempSortItems[matchedCount++] = sortItems[index];
+	}
+	DS_ASSERT(matchedCount + newItemCount == drawItemCount);
+
+	// The previous order should be nearly sorted, so fix it up with an insertion sort. Give up if
+	// it's moving too many items.
+	size_t maxShifts = (size_t)drawItemCount*MAX_INCREMENTAL_SORT_SHIFTS;
+	size_t shifts = 0;
+	for (uint32_t i = 1; i < drawItemCount; ++i)
+	{
+		SortItem item = tempSortItems[i];
+		uint32_t j = i;
+		for (; j > 0 && tempSortItems[j - 1].key > item.key; --j)
+			tempSortItems[j] = tempSortItems[j - 1];
+
+		shifts += i - j;
+		if (shifts > maxShifts)
+			return false;
+		tempSortItems[j] = item;
+	}
+
+	modelList->tempSortItems = modelList->sortItems;
+	modelList->sortItems = tempSortItems;
+	uint32_t maxSortItems = modelList->maxSortItems;
+	modelList->maxSortItems = modelList->maxTempSortItems;
+	modelList->maxTempSortItems = maxSortItems;
+	return true;
+}
+
+static void saveSortHistory(dsSceneModelList* modelList, const dsView* view)
+{
+	SortHistory* sortHistory = findSortHistory(modelList, view);
+	if (!sortHistory)
+	{
+		// Replace the least recently used history, which includes any unused histories.
+		sortHistory = modelList->sortHistories;
+		for (uint32_t i = 1; i < MAX_SORT_HISTORY_VIEWS; ++i)
+		{
+			SortHistory* otherHistory = modelList->sortHistories + i;
+			if (otherHistory->lastUsed < sortHistory->lastUsed)
+				sortHistory = otherHistory;
+		}
+	}
+
+	dsSceneItemList* itemList = (dsSceneItemList*)modelList;
+	sortHistory->view = view;
+	sortHistory->lastUsed = ++modelList->sortHistoryCounter;
+	sortHistory->itemCount = 0;
+	if (!DS_RESIZEABLE_ARRAY_ADD(itemList->allocator, sortHistory->items, sortHistory->itemCount,
+			sortHistory->maxItems, modelList->drawItemCount))
+	{
+		return;
+	}
+
+	for (uint32_t i = 0; i < modelList->drawItemCount; ++i)
+	{
+		uint32_t index = modelList->sortItems[i].index;
+		const DrawItem* drawItem = modelList->drawItems + index;
+		SortHistoryItem* history = sortHistory->items + index;
+		history->nodeID = drawItem->nodeID;
+		history->modelIndex = drawItem->modelIndex;
+		history->sortIndex = i;
+	}
+
+	sortHistory->sortType = modelList->sortType;
+}
+
+static void sortGeometry(dsSceneModelList* modelList, const dsView* view)
+{
+	DS_PROFILE_FUNC_START();
+
+	dsSceneItemList* itemList = (dsSceneItemList*)modelList;
+	uint32_t sortItemCount = 0;
+	uint32_t tempSortItemCount = 0;
+	if (!DS_CHECK(DS_SCENE_LOG_TAG, DS_RESIZEABLE_ARRAY_ADD(itemList->allocator,
+			modelList->sortItems, sortItemCount, modelList->maxSortItems,
+			modelList->drawItemCount)) ||
+		!DS_CHECK(DS_SCENE_LOG_TAG, DS_RESIZEABLE_ARRAY_ADD(itemList->allocator,
+			modelList->tempSortItems, tempSortItemCount, modelList->maxTempSortItems,
+			modelList->drawItemCount)))
+	{
+		modelList->drawItemCount = 0;
+		DS_PROFILE_FUNC_RETURN_VOID();
+	}
+
+	// The sort IDs were interned when adding the nodes, so the keys only need to be packed.
+	const uint64_t depthIDMask = (1U << DEPTH_ID_BITS) - 1;
+	dsModelSortType sortType = modelList->sortType;
+	for (uint32_t i = 0; i < sortItemCount; ++i)
+	{
+		const DrawItem* drawItem = modelList->drawItems + i;
+		SortItem* sortItem = modelList->sortItems + i;
+		sortItem->index = i;
+		sortItem->padding = 0;
+		switch (sortType)
+		{
+			case dsModelSortType_Material:
+				sortItem->key = drawItem->sortIDs;
+				break;
+			case dsModelSortType_BackToFront:
+			case dsModelSortType_FrontToBack:
+			{
+				uint32_t distance = sortableDistance(drawItem->flatDistance);
+				if (sortType == dsModelSortType_BackToFront)
+					distance = ~distance;
+				uint64_t shaderID =
+					(drawItem->sortIDs >> (MATERIAL_ID_BITS + GEOMETRY_ID_BITS)) & depthIDMask;
+				uint64_t materialID = (drawItem->sortIDs >> GEOMETRY_ID_BITS) & depthIDMask;
+				sortItem->key = (uint64_t)distance << 32 | shaderID << DEPTH_ID_BITS | materialID;
+				break;
+			}
+			default:
+				sortItem->key = 0;
+				break;
+		}
+	}
+
+	// The radix sort is stable, so draw items with the same key stay in instance order.
+	if (sortType != dsModelSortType_None)
+	{
+		if (!modelList->incrementalSort || !resortFromHistory(modelList, view))
+		{
+			DS_VERIFY(dsRadixSortUInt64Key(modelList->sortItems, modelList->tempSortItems,
+				sortItemCount, sizeof(SortItem), offsetof(SortItem, key)));
+		}
+
+		if (modelList->incrementalSort)
+			saveSortHistory(modelList, view);
+	}
+
+	DS_PROFILE_FUNC_RETURN_VOID();
+}
+
+static bool canInstanceDrawRanges(const DrawItem* drawItem)
 {
-	const DrawItem* leftInfo = (const DrawItem*)left;
-	const DrawItem* rightInfo = (const DrawItem*)right;
-	int shaderCmp = DS_CMP(leftInfo->shader, rightInfo->shader);
-	int materialCmp = DS_CMP(leftInfo->material, rightInfo->material);
-	int geometryCmp = DS_CMP(leftInfo->geometry, rightInfo->geometry);
-	// Small enough that subtract should be safe.
-	int instanceCmp = leftInfo->instance - rightInfo->instance;
+	bool indexed = drawItem->geometry->indexBuffer.buffer != NULL;
+	for (uint32_t i = 0; i < drawItem->drawRangeCount; ++i)
+	{
+		const dsSceneModelDrawRange* drawRange = drawItem->drawRanges + i;
+		if (indexed)
+		{
+			if (drawRange->drawIndexedRange.instanceCount != 1 ||
+				drawRange->drawIndexedRange.firstInstance != 0)
+			{
+				return false;
+			}
+		}
+		else if (drawRange->drawRange.instanceCount != 1 || drawRange->drawRange.firstInstance != 0)
+			return false;
+	}
 
-	int result = dsCombineCmp(shaderCmp, materialCmp);
-	result = dsCombineCmp(result, geometryCmp);
-	return dsCombineCmp(result, instanceCmp);
+	return true;
 }
 
-static int sortBackToFront(const void* left, const void* right)
+static bool canBatchDrawItems(const DrawItem* first, const DrawItem* drawItem)
 {
-	const DrawItem* leftInfo = (const DrawItem*)left;
-	const DrawItem* rightInfo = (const DrawItem*)right;
-	return DS_CMP(rightInfo->flatDistance, leftInfo->flatDistance);
+	if (first->shader != drawItem->shader || first->material != drawItem->material ||
+		first->geometry != drawItem->geometry || first->primitiveType != drawItem->primitiveType ||
+		first->drawRangeCount != drawItem->drawRangeCount)
+	{
+		return false;
+	}
+
+	if (first->drawRanges == drawItem->drawRanges)
+		return true;
+
+	// Only compare the active member of the union, since the rest may be uninitialized.
+	size_t rangeSize = first->geometry->indexBuffer.buffer ? sizeof(dsDrawIndexedRange) :
+		sizeof(dsDrawRange);
+	for (uint32_t i = 0; i < first->drawRangeCount; ++i)
+	{
+		if (memcmp(first->drawRanges + i, drawItem->drawRanges + i, rangeSize) != 0)
+			return false;
+	}
+
+	return true;
 }
 
-static int sortFrontToBack(const void* left, const void* right)
+static uint32_t leastCommonMultiple(uint32_t left, uint32_t right)
 {
-	const DrawItem* leftInfo = (const DrawItem*)left;
-	const DrawItem* rightInfo = (const DrawItem*)right;
-	return DS_CMP(leftInfo->flatDistance, rightInfo->flatDistance);
+	uint32_t a = left, b = right;
+	while (b)
+	{
+		uint32_t temp = a % b;
+		a = b;
+		b = temp;
+	}
+	return left/a*right;
 }
 
-static void sortGeometry(dsSceneModelList* modelList)
+static void layoutInstances(dsSceneModelList* modelList, const dsRenderer* renderer)
 {
 	DS_PROFILE_FUNC_START();
 
-	switch (modelList->sortType)
+	uint32_t maxBatchSize = modelList->instancing && renderer->hasInstancedDrawing ? UINT32_MAX : 1;
+	uint32_t instanceAlignment = 1;
+	for (uint32_t i = 0; i < modelList->instanceDataCount; ++i)
+	{
+		const dsSceneInstanceData* instanceData = modelList->instanceData[i];
+		if (instanceData->type->bindInstanceRangeFunc)
+			maxBatchSize = dsMin(maxBatchSize, instanceData->maxInstanceRange);
+		else
+			maxBatchSize = 1;
+		instanceAlignment = leastCommonMultiple(instanceAlignment,
+			dsMax(instanceData->instanceAlignment, 1U));
+	}
+
+	if (maxBatchSize <= 1 && instanceAlignment <= 1)
+		DS_PROFILE_FUNC_RETURN_VOID();
+
+	// Each draw item gets its own instance so the instances for each batch are contiguous. Nodes
+	// with multiple models will have an instance for each model. The first instance of each draw is
+	// padded to the instance alignment by repeating the instance.
+	dsSceneItemList* itemList = (dsSceneItemList*)modelList;
+	uint32_t batchedInstanceCount = 0;
+	DrawItem* batchStart = NULL;
+	for (uint32_t i = 0; i < modelList->drawItemCount; ++i)
 	{
-		case dsModelSortType_Material:
-			qsort(modelList->drawItems, modelList->drawItemCount, sizeof(DrawItem),
-				&sortByMaterial);
-			break;
-		case dsModelSortType_BackToFront:
-			qsort(modelList->drawItems, modelList->drawItemCount, sizeof(DrawItem),
-				&sortBackToFront);
-			break;
-		case dsModelSortType_FrontToBack:
-			qsort(modelList->drawItems, modelList->drawItemCount, sizeof(DrawItem),
-				&sortFrontToBack);
-			break;
-		default:
-			break;
+		DrawItem* drawItem = modelList->drawItems + modelList->sortItems[i].index;
+		const dsSceneTreeNode* instance = modelList->instances[drawItem->instance];
+		bool addToBatch = batchStart && batchStart->instanceCount < maxBatchSize &&
+			canBatchDrawItems(batchStart, drawItem);
+		uint32_t firstInstance = batchedInstanceCount;
+		uint32_t padding = addToBatch ? 0 :
+			(instanceAlignment - firstInstance % instanceAlignment) % instanceAlignment;
+		if (!DS_CHECK(DS_SCENE_LOG_TAG, DS_RESIZEABLE_ARRAY_ADD(itemList->allocator,
+				modelList->batchedInstances, batchedInstanceCount,
+				modelList->maxBatchedInstances, padding + 1)))
+		{
+			// Can't bind the instances with the original layout if it doesn't match the alignment.
+			if (instanceAlignment > 1)
+				modelList->drawItemCount = 0;
+			DS_PROFILE_FUNC_RETURN_VOID();
+		}
+
+		for (uint32_t j = firstInstance; j < batchedInstanceCount; ++j)
+			modelList->batchedInstances[j] = instance;
+		drawItem->instance = batchedInstanceCount - 1;
+
+		if (addToBatch)
+		{
+			++batchStart->instanceCount;
+			drawItem->instanceCount = 0;
+		}
+		else
+		{
+			drawItem->instanceCount = 1;
+			batchStart = maxBatchSize > 1 && canInstanceDrawRanges(drawItem) ? drawItem : NULL;
+		}
 	}
 
+	// Swap the arrays so the instance data is populated in the batched order.
+	const dsSceneTreeNode** instances = modelList->instances;
+	uint32_t maxInstances = modelList->maxInstances;
+	modelList->instances = modelList->batchedInstances;
+	modelList->instanceCount = batchedInstanceCount;
+	modelList->maxInstances = modelList->maxBatchedInstances;
+	modelList->batchedInstances = instances;
+	modelList->maxBatchedInstances = maxInstances;
+
 	DS_PROFILE_FUNC_RETURN_VOID();
 }
 
-static void drawGeometry(
-	dsSceneModelList* modelList, const dsView* view, dsCommandBuffer* commandBuffer)
+static void drawGeometry(dsSceneModelList* modelList, const dsView* view,
+	dsCommandBuffer* commandBuffer, dsSharedMaterialValues* instanceValues, uint32_t start,
+	uint32_t count)
 {
 	DS_PROFILE_FUNC_START();
 
@@ -266,9 +701,12 @@ static void drawGeometry(
 	dsDynamicRenderStates* renderStates =
 		modelList->hasRenderStates ? &modelList->renderStates : NULL;
 	bool hasInstances = modelList->instanceDataCount > 0;
-	for (uint32_t i = 0; i < modelList->drawItemCount; ++i)
+	for (uint32_t i = start; i < start + count; ++i)
 	{
-		const DrawItem* drawItem = modelList->drawItems + i;
+		const DrawItem* drawItem = modelList->drawItems + modelList->sortItems[i].index;
+		if (drawItem->instanceCount == 0)
+			continue;
+
 		bool updateInstances = false;
 		if (drawItem->shader != lastShader || drawItem->material != lastMaterial)
 		{
@@ -286,12 +724,25 @@ static void drawGeometry(
 			updateInstances = hasInstances;
 		}
 
-		if (drawItem->instance != lastInstance && hasInstances)
+		if (drawItem->instanceCount > 1 && hasInstances)
+		{
+			for (uint32_t j = 0; j < modelList->instanceDataCount; ++j)
+			{
+				DS_CHECK(DS_SCENE_LOG_TAG, dsSceneInstanceData_bindInstanceRange(
+					modelList->instanceData[j], drawItem->instance, drawItem->instanceCount,
+					instanceValues));
+			}
+
+			// Make sure the next individual instance is bound again.
+			lastInstance = UINT32_MAX;
+			updateInstances = true;
+		}
+		else if (drawItem->instance != lastInstance && hasInstances)
 		{
 			for (uint32_t j = 0; j < modelList->instanceDataCount; ++j)
 			{
 				DS_CHECK(DS_SCENE_LOG_TAG, dsSceneInstanceData_bindInstance(
-					modelList->instanceData[j], drawItem->instance, modelList->instanceValues));
+					modelList->instanceData[j], drawItem->instance, instanceValues));
 			}
 
 			lastInstance = drawItem->instance;
@@ -301,25 +752,41 @@ static void drawGeometry(
 		if (updateInstances)
 		{
 			DS_CHECK(DS_SCENE_LOG_TAG, dsShader_updateInstanceValues(drawItem->shader,
-				commandBuffer, modelList->instanceValues));
+				commandBuffer, instanceValues));
 		}
 
 		if (drawItem->geometry->indexBuffer.buffer)
 		{
 			for (uint32_t j = 0; j < drawItem->drawRangeCount; ++j)
 			{
+				const dsDrawIndexedRange* drawRange = &drawItem->drawRanges[j].drawIndexedRange;
+				dsDrawIndexedRange instancedRange;
+				if (drawItem->instanceCount > 1)
+				{
+					instancedRange = *drawRange;
+					instancedRange.instanceCount = drawItem->instanceCount;
+					drawRange = &instancedRange;
+				}
+
 				DS_CHECK(DS_SCENE_LOG_TAG, dsRenderer_drawIndexed(renderer, commandBuffer,
-					drawItem->geometry, &drawItem->drawRanges[j].drawIndexedRange,
-					drawItem->primitiveType));
+					drawItem->geometry, drawRange, drawItem->primitiveType));
 			}
 		}
 		else
 		{
 			for (uint32_t j = 0; j < drawItem->drawRangeCount; ++j)
 			{
+				const dsDrawRange* drawRange = &drawItem->drawRanges[j].drawRange;
+				dsDrawRange instancedRange;
+				if (drawItem->instanceCount > 1)
+				{
+					instancedRange = *drawRange;
+					instancedRange.instanceCount = drawItem->instanceCount;
+					drawRange = &instancedRange;
+				}
+
 				DS_CHECK(DS_SCENE_LOG_TAG, dsRenderer_draw(renderer, commandBuffer,
-					drawItem->geometry, &drawItem->drawRanges[j].drawRange,
-					drawItem->primitiveType));
+					drawItem->geometry, drawRange, drawItem->primitiveType));
 			}
 		}
 	}
@@ -369,11 +836,22 @@ static uint64_t dsSceneModelList_addNode(dsSceneItemList* itemList, dsSceneNode*
 	}
 
 	Entry* entry = modelList->entries + index;
+	entry->modelSortIDs = DS_ALLOCATE_OBJECT_ARRAY(itemList->allocator, uint64_t,
+		modelNode->modelCount);
+	if (!entry->modelSortIDs && modelNode->modelCount > 0)
+	{
+		--modelList->entryCount;
+		return DS_NO_SCENE_NODE;
+	}
+
 	entry->node = modelNode;
 	entry->treeNode = treeNode;
 	entry->transform = &treeNode->curFrameWorldTransform;
 	entry->itemData = itemData;
+	addModelSortIDs(modelList, entry);
 	entry->nodeID = modelList->nextNodeID++;
+	entry->searchCullLists = !dsSceneNodeItemData_getIndexMask(&entry->cullMask, node,
+		modelList->cullListIDs, modelList->cullListCount);
 	return entry->nodeID;
 }
 
@@ -384,6 +862,14 @@ static void dsSceneModelList_removeNode(
 	DS_UNUSED(treeNode);
 	dsSceneModelList* modelList = (dsSceneModelList*)itemList;
 
+	Entry* entry = (Entry*)dsSceneItemListEntries_findEntry(modelList->entries,
+		modelList->entryCount, sizeof(Entry), offsetof(Entry, nodeID), nodeID);
+	if (!entry)
+		return;
+
+	DS_VERIFY(dsAllocator_free(itemList->allocator, entry->modelSortIDs));
+	entry->modelSortIDs = NULL;
+
 	uint32_t index = modelList->removeEntryCount;
 	if (DS_RESIZEABLE_ARRAY_ADD(itemList->allocator, modelList->removeEntries,
 			modelList->removeEntryCount, modelList->maxRemoveEntries, 1))
@@ -392,8 +878,8 @@ static void dsSceneModelList_removeNode(
 	}
 	else
 	{
-		dsSceneItemListEntries_removeSingle(modelList->entries, &modelList->entryCount,
-			sizeof(Entry), offsetof(Entry, nodeID), nodeID);
+		dsSceneItemListEntries_removeSingleIndex(modelList->entries, &modelList->entryCount,
+			sizeof(Entry), entry - modelList->entries);
 	}
 }
 
@@ -411,6 +897,8 @@ static void dsSceneModelList_preRenderPass(dsSceneItemList* itemList, const dsVi
 	modelList->removeEntryCount = 0;
 
 	addInstances(itemList, view);
+	sortGeometry(modelList, view);
+	layoutInstances(modelList, commandBuffer->renderer);
 	setupInstances(modelList, view, commandBuffer, renderPassParams);
 
 	dsRenderer_popDebugGroup(commandBuffer->renderer, commandBuffer);
@@ -432,15 +920,76 @@ static void dsSceneModelList_commit(dsSceneItemList* itemList, const dsView* vie
 		modelList->removeEntryCount = 0;
 
 		addInstances(itemList, view);
+		sortGeometry(modelList, view);
+		layoutInstances(modelList, commandBuffer->renderer);
 		setupInstances(modelList, view, NULL, renderPassParams);
 	}
-	sortGeometry(modelList);
-	drawGeometry(modelList, view, commandBuffer);
+	drawGeometry(modelList, view, commandBuffer, modelList->instanceValues, 0,
+		modelList->drawItemCount);
 	cleanup(modelList);
 
 	dsRenderer_popDebugGroup(commandBuffer->renderer, commandBuffer);
 }
 
+static uint32_t dsSceneModelList_prepareCommitRanges(dsSceneItemList* itemList,
+	const dsView* view, const dsViewRenderPassParams* renderPassParams)
+{
+	DS_ASSERT(itemList);
+	dsSceneModelList* modelList = (dsSceneModelList*)itemList;
+
+	if (itemList->skipPreRenderPass)
+	{
+		// Lazily remove entries.
+		dsSceneItemListEntries_removeMulti(modelList->entries, &modelList->entryCount,
+			sizeof(Entry), offsetof(Entry, nodeID), modelList->removeEntries,
+			modelList->removeEntryCount);
+		modelList->removeEntryCount = 0;
+
+		addInstances(itemList, view);
+		sortGeometry(modelList, view);
+		layoutInstances(modelList, dsScene_getRenderer(view->scene));
+		setupInstances(modelList, view, NULL, renderPassParams);
+	}
+
+	return modelList->drawItemCount;
+}
+
+static void dsSceneModelList_commitRange(dsSceneItemList* itemList, const dsView* view,
+	dsCommandBuffer* commandBuffer, const dsViewRenderPassParams* renderPassParams,
+	uint32_t start, uint32_t count)
+{
+	DS_ASSERT(itemList);
+	DS_UNUSED(renderPassParams);
+	dsSceneModelList* modelList = (dsSceneModelList*)itemList;
+	DS_ASSERT(start + count <= modelList->drawItemCount);
+	dsRenderer_pushDebugGroup(commandBuffer->renderer, commandBuffer, itemList->name);
+
+	// Ranges may be committed concurrently, so each needs its own instance values to bind to.
+	dsSharedMaterialValues* instanceValues = NULL;
+	if (modelList->instanceValues)
+	{
+		uint32_t maxValues = dsSharedMaterialValues_getMaxValues(modelList->instanceValues);
+		size_t valuesSize = dsSharedMaterialValues_fullAllocSize(maxValues);
+		dsBufferAllocator bufferAlloc;
+		DS_VERIFY(dsBufferAllocator_initialize(&bufferAlloc,
+			DS_ALLOCATE_STACK_OBJECT_ARRAY(uint8_t, valuesSize), valuesSize));
+		instanceValues = dsSharedMaterialValues_create((dsAllocator*)&bufferAlloc, maxValues);
+		DS_ASSERT(instanceValues);
+	}
+
+	drawGeometry(modelList, view, commandBuffer, instanceValues, start, count);
+	dsSharedMaterialValues_destroy(instanceValues);
+
+	dsRenderer_popDebugGroup(commandBuffer->renderer, commandBuffer);
+}
+
+static void dsSceneModelList_finishCommitRanges(dsSceneItemList* itemList, const dsView* view)
+{
+	DS_ASSERT(itemList);
+	DS_UNUSED(view);
+	cleanup((dsSceneModelList*)itemList);
+}
+
 static uint32_t dsSceneModelList_hash(const dsSceneItemList* itemList, uint32_t commonHash)
 {
 	DS_ASSERT(itemList);
@@ -449,6 +998,7 @@ static uint32_t dsSceneModelList_hash(const dsSceneItemList* itemList, uint32_t
 	if (modelList->hasRenderStates)
 		hash = dsHashCombineBytes(hash, &modelList->renderStates, sizeof(dsDynamicRenderStates));
 	hash = dsHashCombine32(hash, &modelList->sortType);
+	hash = dsHashCombine8(hash, &modelList->instancing);
 	for (uint32_t i = 0; i < modelList->instanceDataCount; ++i)
 		hash = dsSceneInstanceData_hash(modelList->instanceData[i], hash);
 	hash = dsHashCombineBytes(
@@ -470,6 +1020,7 @@ static bool dsSceneModelList_equal(const dsSceneItemList* left, const dsSceneIte
 		(leftModelList->hasRenderStates && memcmp(&leftModelList->renderStates,
 			&rightModelList->renderStates, sizeof(dsDynamicRenderStates)) != 0) ||
 		leftModelList->sortType != rightModelList->sortType ||
+		leftModelList->instancing != rightModelList->instancing ||
 		leftModelList->instanceDataCount != rightModelList->instanceDataCount ||
 		leftModelList->cullListCount != rightModelList->cullListCount)
 	{
@@ -499,10 +1050,19 @@ static void dsSceneModelList_destroy(dsSceneItemList* itemList)
 	dsSceneModelList* modelList = (dsSceneModelList*)itemList;
 	destroyInstanceData(modelList->instanceData, modelList->instanceDataCount);
 	dsSharedMaterialValues_destroy(modelList->instanceValues);
+	for (uint32_t i = 0; i < modelList->entryCount; ++i)
+		DS_VERIFY(dsAllocator_free(itemList->allocator, modelList->entries[i].modelSortIDs));
 	DS_VERIFY(dsAllocator_free(itemList->allocator, modelList->entries));
 	DS_VERIFY(dsAllocator_free(itemList->allocator, modelList->removeEntries));
 	DS_VERIFY(dsAllocator_free(itemList->allocator, (void*)modelList->instances));
+	DS_VERIFY(dsAllocator_free(itemList->allocator, (void*)modelList->batchedInstances));
 	DS_VERIFY(dsAllocator_free(itemList->allocator, modelList->drawItems));
+	DS_VERIFY(dsAllocator_free(itemList->allocator, modelList->sortItems));
+	DS_VERIFY(dsAllocator_free(itemList->allocator, modelList->tempSortItems));
+	for (uint32_t i = 0; i < MAX_SORT_HISTORY_VIEWS; ++i)
+		DS_VERIFY(dsAllocator_free(itemList->allocator, modelList->sortHistories[i].items));
+	DS_VERIFY(dsAllocator_free(itemList->allocator, modelList->historySlots));
+	dsHashMap_shutdown(&modelList->sortIDs);
 	DS_VERIFY(dsAllocator_free(itemList->allocator, modelList));
 }
 
@@ -514,6 +1074,9 @@ static dsSceneItemListType itemListType =
 	.removeNodeFunc = &dsSceneModelList_removeNode,
 	.preRenderPassFunc = &dsSceneModelList_preRenderPass,
 	.commitFunc = &dsSceneModelList_commit,
+	.prepareCommitRangesFunc = &dsSceneModelList_prepareCommitRanges,
+	.commitRangeFunc = &dsSceneModelList_commitRange,
+	.finishCommitRangesFunc = &dsSceneModelList_finishCommitRanges,
 	.hashFunc = &dsSceneModelList_hash,
 	.equalFunc = &dsSceneModelList_equal,
 	.destroyFunc = &dsSceneModelList_destroy
@@ -620,6 +1183,8 @@ dsSceneModelList* dsSceneModelList_create(dsAllocator* allocator, const char* na
 	else
 		modelList->hasRenderStates = false;
 	modelList->sortType = sortType;
+	modelList->instancing = false;
+	modelList->incrementalSort = false;
 
 	if (instanceDataCount > 0)
 	{
@@ -668,10 +1233,31 @@ dsSceneModelList* dsSceneModelList_create(dsAllocator* allocator, const char* na
 	modelList->instanceCount = 0;
 	modelList->maxInstances = 0;
 
+	modelList->batchedInstances = NULL;
+	modelList->maxBatchedInstances = 0;
+
 	modelList->drawItems = NULL;
 	modelList->drawItemCount = 0;
 	modelList->maxDrawItems = 0;
 
+	modelList->sortItems = NULL;
+	modelList->maxSortItems = 0;
+
+	modelList->tempSortItems = NULL;
+	modelList->maxTempSortItems = 0;
+
+	DS_VERIFY(dsHashMap_initialize(&modelList->sortIDs, allocator, 0, &dsHashPointer,
+		&dsHashPointerEqual));
+	modelList->nextShaderID = 0;
+	modelList->nextMaterialID = 0;
+	modelList->nextGeometryID = 0;
+
+	memset(modelList->sortHistories, 0, sizeof(modelList->sortHistories));
+	modelList->sortHistoryCounter = 0;
+
+	modelList->historySlots = NULL;
+	modelList->maxHistorySlots = 0;
+
 	return modelList;
 }
 
@@ -705,3 +1291,29 @@ void dsSceneModelList_setRenderStates(
 	else
 		modelList->hasRenderStates = false;
 }
+
+bool dsSceneModelList_getInstancing(const dsSceneModelList* modelList)
+{
+	return modelList && modelList->instancing;
+}
+
+void dsSceneModelList_setInstancing(dsSceneModelList* modelList, bool instancing)
+{
+	if (modelList)
+		modelList->instancing = instancing;
+}
+
+bool dsSceneModelList_getIncrementalSort(const dsSceneModelList* modelList)
+{
+	return modelList && modelList->incrementalSort;
+}
+
+void dsSceneModelList_setIncrementalSort(dsSceneModelList* modelList, bool incrementalSort)
+{
+	if (!modelList)
+		return;
+
+	modelList->incrementalSort = incrementalSort;
+	for (uint32_t i = 0; i < MAX_SORT_HISTORY_VIEWS; ++i)
+		modelList->sortHistories[i].itemCount = 0;
+}
@@ -23,6 +23,8 @@
 #include <DeepSea/Core/Error.h>
 #include <DeepSea/Core/UniqueNameID.h>
 
+#include <DeepSea/Geometry/AlignedBox3.h>
+#include <DeepSea/Geometry/BVH.h>
 #include <DeepSea/Geometry/Frustum3.h>
 
 #include <DeepSea/Math/Matrix44.h>
@@ -33,16 +35,28 @@
 #include <DeepSea/Scene/View.h>
 
 #include <limits.h>
+#include <math.h>
 #include <string.h>
 
 #define MIN_DYNAMIC_ENTRY_ID LLONG_MAX
 
+typedef enum Visibility
+{
+	Visibility_Hidden,
+	Visibility_WasVisible,
+	Visibility_Visible
+} Visibility;
+
 typedef struct StaticEntry
 {
+	// Cached world-space box matrix, updated only when the node's transform changes.
+	dsMatrix44f boxMatrix;
 	dsMatrix44f localBoxMatrix;
 	const dsMatrix44f* transform;
 	bool* result;
 	uint64_t nodeID;
+	bool dirty;
+	uint8_t visibility;
 } StaticEntry;
 
 typedef struct DynamicEntry
@@ -66,6 +80,27 @@ typedef struct dsViewCullList
 	uint32_t removeStaticEntryCount;
 	uint32_t maxRemoveStaticEntries;
 
+	// Node IDs for the static entries with changed transforms.
+	uint64_t* dirtyStaticEntries;
+	uint32_t dirtyStaticEntryCount;
+	uint32_t maxDirtyStaticEntries;
+
+	// Indices of the static entries that were visible for the last commit. Only the results for
+	// entries that change visibility are written when culling with the BVH.
+	uint32_t* visibleStaticEntries;
+	uint32_t visibleStaticEntryCount;
+	uint32_t maxVisibleStaticEntries;
+
+	uint32_t* nextVisibleStaticEntries;
+	uint32_t nextVisibleStaticEntryCount;
+	uint32_t maxNextVisibleStaticEntries;
+
+	// BVH of the static entries by index to cull them in clusters.
+	dsBVH* staticBVH;
+	bool staticEntriesChanged;
+	bool staticBVHValid;
+	bool resetStaticResults;
+
 	DynamicEntry* dynamicEntries;
 	uint32_t dynamicEntryCount;
 	uint32_t maxDynamicEntries;
@@ -76,6 +111,24 @@ typedef struct dsViewCullList
 	uint32_t maxRemoveDynamicEntries;
 } dsViewCullList;
 
+static bool markStaticEntryDirty(dsViewCullList* cullList, StaticEntry* entry)
+{
+	if (entry->dirty)
+		return true;
+
+	uint32_t index = cullList->dirtyStaticEntryCount;
+	if (!DS_RESIZEABLE_ARRAY_ADD(((dsSceneItemList*)cullList)->allocator,
+			cullList->dirtyStaticEntries, cullList->dirtyStaticEntryCount,
+			cullList->maxDirtyStaticEntries, 1))
+	{
+		return false;
+	}
+
+	cullList->dirtyStaticEntries[index] = entry->nodeID;
+	entry->dirty = true;
+	return true;
+}
+
 static uint64_t dsViewCullList_addNode(dsSceneItemList* itemList, dsSceneNode* node,
 	dsSceneTreeNode* treeNode, const dsSceneNodeItemData* itemData, void** thisItemData)
 {
@@ -118,9 +171,32 @@ static uint64_t dsViewCullList_addNode(dsSceneItemList* itemList, dsSceneNode* n
 	entry->transform = &treeNode->curFrameWorldTransform;
 	entry->result = (bool*)thisItemData;
 	entry->nodeID = cullList->nextStaticNodeID++;
+	entry->dirty = false;
+	entry->visibility = Visibility_Hidden;
+	cullList->staticEntriesChanged = true;
+
+	// Compute the box matrix immediately if it can't be tracked as dirty.
+	if (!markStaticEntryDirty(cullList, entry))
+		dsMatrix44f_affineMul(&entry->boxMatrix, entry->transform, &entry->localBoxMatrix);
 	return entry->nodeID;
 }
 
+static void dsViewCullList_updateNode(
+	dsSceneItemList* itemList, dsSceneTreeNode* treeNode, uint64_t nodeID)
+{
+	DS_ASSERT(itemList);
+	DS_UNUSED(treeNode);
+	if (nodeID >= MIN_DYNAMIC_ENTRY_ID)
+		return;
+
+	// Only called when the transform changes, so the cached bounds are otherwise kept.
+	dsViewCullList* cullList = (dsViewCullList*)itemList;
+	StaticEntry* entry = (StaticEntry*)dsSceneItemListEntries_findEntry(cullList->staticEntries,
+		cullList->staticEntryCount, sizeof(StaticEntry), offsetof(StaticEntry, nodeID), nodeID);
+	if (entry && !markStaticEntryDirty(cullList, entry))
+		dsMatrix44f_affineMul(&entry->boxMatrix, entry->transform, &entry->localBoxMatrix);
+}
+
 static void dsViewCullList_removeNode(
 	dsSceneItemList* itemList, dsSceneTreeNode* treeNode, uint64_t nodeID)
 {
@@ -129,6 +205,7 @@ static void dsViewCullList_removeNode(
 	dsViewCullList* cullList = (dsViewCullList*)itemList;
 	if (nodeID < MIN_DYNAMIC_ENTRY_ID)
 	{
+		cullList->staticEntriesChanged = true;
 		uint32_t index = cullList->removeStaticEntryCount;
 		if (DS_RESIZEABLE_ARRAY_ADD(itemList->allocator, cullList->removeStaticEntries,
 				cullList->removeStaticEntryCount, cullList->maxRemoveStaticEntries, 1))
@@ -172,9 +249,158 @@ static void lazyRemoveEntries(dsViewCullList* cullList)
 	cullList->removeDynamicEntryCount = 0;
 }
 
+static bool getStaticEntryBounds(void* outBounds, const dsBVH* bvh, const void* object)
+{
+	const dsViewCullList* cullList = (const dsViewCullList*)dsBVH_getUserData(bvh);
+	const StaticEntry* entry = cullList->staticEntries + (size_t)object;
+	const dsMatrix44f* boxMatrix = &entry->boxMatrix;
+	dsAlignedBox3f* bounds = (dsAlignedBox3f*)outBounds;
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		float center = boxMatrix->columns[3].values[i];
+		float extent = fabsf(boxMatrix->columns[0].values[i]) +
+			fabsf(boxMatrix->columns[1].values[i]) + fabsf(boxMatrix->columns[2].values[i]);
+		bounds->min.values[i] = center - extent;
+		bounds->max.values[i] = center + extent;
+	}
+	return true;
+}
+
+static void updateStaticEntries(dsViewCullList* cullList)
+{
+	lazyRemoveEntries(cullList);
+
+	// Entries that were removed after being marked dirty won't be found.
+	bool transformsChanged = cullList->dirtyStaticEntryCount > 0;
+	for (uint32_t i = 0; i < cullList->dirtyStaticEntryCount; ++i)
+	{
+		StaticEntry* entry = (StaticEntry*)dsSceneItemListEntries_findEntry(
+			cullList->staticEntries, cullList->staticEntryCount, sizeof(StaticEntry),
+			offsetof(StaticEntry, nodeID), cullList->dirtyStaticEntries[i]);
+		if (!entry)
+			continue;
+
+		dsMatrix44f_affineMul(&entry->boxMatrix, entry->transform, &entry->localBoxMatrix);
+		entry->dirty = false;
+	}
+	cullList->dirtyStaticEntryCount = 0;
+
+	// Entries are referenced by index, so re-build when any are added or removed. Otherwise only
+	// refit the BVH when transforms change.
+	if (cullList->staticEntriesChanged)
+	{
+		cullList->staticEntriesChanged = false;
+		cullList->staticBVHValid = false;
+		// The visible indices are no longer valid, so all results are written for the next cull.
+		cullList->resetStaticResults = true;
+
+		// Reserve space for every entry to be visible so the BVH visitor doesn't need to allocate.
+		dsAllocator* allocator = ((dsSceneItemList*)cullList)->allocator;
+		uint32_t visibleCount = 0, nextVisibleCount = 0;
+		if (!DS_RESIZEABLE_ARRAY_ADD(allocator, cullList->visibleStaticEntries, visibleCount,
+				cullList->maxVisibleStaticEntries, cullList->staticEntryCount) ||
+			!DS_RESIZEABLE_ARRAY_ADD(allocator, cullList->nextVisibleStaticEntries,
+				nextVisibleCount, cullList->maxNextVisibleStaticEntries,
+				cullList->staticEntryCount))
+		{
+			return;
+		}
+
+		if (!cullList->staticBVH)
+		{
+			cullList->staticBVH = dsBVH_create(allocator, 3, dsGeometryElement_Float, cullList);
+			if (!cullList->staticBVH)
+				return;
+		}
+
+		cullList->staticBVHValid = dsBVH_buildSAH(cullList->staticBVH, NULL,
+			cullList->staticEntryCount, DS_GEOMETRY_OBJECT_INDICES, &getStaticEntryBounds, NULL);
+	}
+	else if (transformsChanged && cullList->staticBVHValid)
+		cullList->staticBVHValid = dsBVH_updateIncremental(cullList->staticBVH, NULL);
+}
+
+static inline void setStaticEntryResult(dsViewCullList* cullList, uint32_t index, bool outside)
+{
+	if (outside)
+		return;
+
+	StaticEntry* entry = cullList->staticEntries + index;
+	if (entry->visibility == Visibility_Hidden)
+		*entry->result = false;
+	entry->visibility = Visibility_Visible;
+	cullList->nextVisibleStaticEntries[cullList->nextVisibleStaticEntryCount++] = index;
+}
+
+// NOTE: Falls back to culling each entry individually if the BVH couldn't be built.
+static bool cullStaticEntriesBVH(
+	dsViewCullList* cullList, const dsView* view, dsBVHVisitFunction visitFunc)
+{
+	if (!cullList->staticBVHValid ||
+		cullList->maxNextVisibleStaticEntries < cullList->staticEntryCount)
+	{
+		return false;
+	}
+
+	if (cullList->resetStaticResults)
+	{
+		for (uint32_t i = 0; i < cullList->staticEntryCount; ++i)
+		{
+			StaticEntry* entry = cullList->staticEntries + i;
+			*entry->result = true;
+			entry->visibility = Visibility_Hidden;
+		}
+		cullList->visibleStaticEntryCount = 0;
+		cullList->resetStaticResults = false;
+	}
+
+	// Only entries that were visible for the last commit or are visited by the BVH may change
+	// results, so this doesn't need to touch every entry.
+	for (uint32_t i = 0; i < cullList->visibleStaticEntryCount; ++i)
+	{
+		cullList->staticEntries[cullList->visibleStaticEntries[i]].visibility =
+			Visibility_WasVisible;
+	}
+
+	cullList->nextVisibleStaticEntryCount = 0;
+	dsBVH_intersectFrustum(cullList->staticBVH, &view->viewFrustum, visitFunc, cullList);
+
+	for (uint32_t i = 0; i < cullList->visibleStaticEntryCount; ++i)
+	{
+		StaticEntry* entry = cullList->staticEntries + cullList->visibleStaticEntries[i];
+		if (entry->visibility == Visibility_WasVisible)
+		{
+			*entry->result = true;
+			entry->visibility = Visibility_Hidden;
+		}
+	}
+
+	uint32_t* visibleEntries = cullList->visibleStaticEntries;
+	uint32_t maxVisibleEntries = cullList->maxVisibleStaticEntries;
+	cullList->visibleStaticEntries = cullList->nextVisibleStaticEntries;
+	cullList->visibleStaticEntryCount = cullList->nextVisibleStaticEntryCount;
+	cullList->maxVisibleStaticEntries = cullList->maxNextVisibleStaticEntries;
+	cullList->nextVisibleStaticEntries = visibleEntries;
+	cullList->nextVisibleStaticEntryCount = 0;
+	cullList->maxNextVisibleStaticEntries = maxVisibleEntries;
+	return true;
+}
+
 #if DS_HAS_SIMD
 
 DS_SIMD_START(DS_SIMD_FLOAT4)
+static bool visitStaticEntrySIMD(
+	void* userData, const dsBVH* bvh, const void* object, const void* frustum)
+{
+	DS_UNUSED(bvh);
+	dsViewCullList* cullList = (dsViewCullList*)userData;
+	uint32_t index = (uint32_t)(size_t)object;
+	const StaticEntry* entry = cullList->staticEntries + index;
+	setStaticEntryResult(cullList, index, dsFrustum3f_intersectBoxMatrixSIMD(
+		(const dsFrustum3f*)frustum, &entry->boxMatrix) == dsIntersectResult_Outside);
+	return true;
+}
+
 static void dsViewCullList_commitSIMD(dsSceneItemList* itemList, const dsView* view,
 	dsCommandBuffer* commandBuffer, const dsViewRenderPassParams* renderPassParams)
 {
@@ -182,15 +408,17 @@ static void dsViewCullList_commitSIMD(dsSceneItemList* itemList, const dsView* v
 	DS_UNUSED(commandBuffer);
 	DS_UNUSED(renderPassParams);
 	dsViewCullList* cullList = (dsViewCullList*)itemList;
-	lazyRemoveEntries(cullList);
+	updateStaticEntries(cullList);
 
-	for (uint32_t i = 0; i < cullList->staticEntryCount; ++i)
+	if (!cullStaticEntriesBVH(cullList, view, &visitStaticEntrySIMD))
 	{
-		const StaticEntry* entry = cullList->staticEntries + i;
-		dsMatrix44f boxMatrix;
-		dsMatrix44f_affineMulSIMD(&boxMatrix, entry->transform, &entry->localBoxMatrix);
-		*entry->result = dsFrustum3f_intersectBoxMatrixSIMD(&view->viewFrustum, &boxMatrix) ==
-			dsIntersectResult_Outside;
+		cullList->resetStaticResults = true;
+		for (uint32_t i = 0; i < cullList->staticEntryCount; ++i)
+		{
+			const StaticEntry* entry = cullList->staticEntries + i;
+			*entry->result = dsFrustum3f_intersectBoxMatrixSIMD(&view->viewFrustum,
+				&entry->boxMatrix) == dsIntersectResult_Outside;
+		}
 	}
 
 	for (uint32_t i = 0; i < cullList->dynamicEntryCount; ++i)
@@ -210,6 +438,18 @@ DS_SIMD_END()
 
 #if !DS_DETERMINISTIC_MATH
 DS_SIMD_START(DS_SIMD_FLOAT4,DS_SIMD_FMA)
+static bool visitStaticEntryFMA(
+	void* userData, const dsBVH* bvh, const void* object, const void* frustum)
+{
+	DS_UNUSED(bvh);
+	dsViewCullList* cullList = (dsViewCullList*)userData;
+	uint32_t index = (uint32_t)(size_t)object;
+	const StaticEntry* entry = cullList->staticEntries + index;
+	setStaticEntryResult(cullList, index, dsFrustum3f_intersectBoxMatrixFMA(
+		(const dsFrustum3f*)frustum, &entry->boxMatrix) == dsIntersectResult_Outside);
+	return true;
+}
+
 static void dsViewCullList_commitFMA(dsSceneItemList* itemList, const dsView* view,
 	dsCommandBuffer* commandBuffer, const dsViewRenderPassParams* renderPassParams)
 {
@@ -217,15 +457,17 @@ static void dsViewCullList_commitFMA(dsSceneItemList* itemList, const dsView* vi
 	DS_UNUSED(commandBuffer);
 	DS_UNUSED(renderPassParams);
 	dsViewCullList* cullList = (dsViewCullList*)itemList;
-	lazyRemoveEntries(cullList);
+	updateStaticEntries(cullList);
 
-	for (uint32_t i = 0; i < cullList->staticEntryCount; ++i)
+	if (!cullStaticEntriesBVH(cullList, view, &visitStaticEntryFMA))
 	{
-		const StaticEntry* entry = cullList->staticEntries + i;
-		dsMatrix44f boxMatrix;
-		dsMatrix44f_affineMulFMA(&boxMatrix, entry->transform, &entry->localBoxMatrix);
-		*entry->result = dsFrustum3f_intersectBoxMatrixFMA(&view->viewFrustum, &boxMatrix) ==
-			dsIntersectResult_Outside;
+		cullList->resetStaticResults = true;
+		for (uint32_t i = 0; i < cullList->staticEntryCount; ++i)
+		{
+			const StaticEntry* entry = cullList->staticEntries + i;
+			*entry->result = dsFrustum3f_intersectBoxMatrixFMA(&view->viewFrustum,
+				&entry->boxMatrix) == dsIntersectResult_Outside;
+		}
 	}
 
 	for (uint32_t i = 0; i < cullList->dynamicEntryCount; ++i)
@@ -246,6 +488,18 @@ DS_SIMD_END()
 
 #endif // DS_HAS_SIMD
 
+static bool visitStaticEntry(
+	void* userData, const dsBVH* bvh, const void* object, const void* frustum)
+{
+	DS_UNUSED(bvh);
+	dsViewCullList* cullList = (dsViewCullList*)userData;
+	uint32_t index = (uint32_t)(size_t)object;
+	const StaticEntry* entry = cullList->staticEntries + index;
+	setStaticEntryResult(cullList, index, dsFrustum3f_intersectBoxMatrix(
+		(const dsFrustum3f*)frustum, &entry->boxMatrix) == dsIntersectResult_Outside);
+	return true;
+}
+
 static void dsViewCullList_commit(dsSceneItemList* itemList, const dsView* view,
 	dsCommandBuffer* commandBuffer, const dsViewRenderPassParams* renderPassParams)
 {
@@ -253,15 +507,17 @@ static void dsViewCullList_commit(dsSceneItemList* itemList, const dsView* view,
 	DS_UNUSED(commandBuffer);
 	DS_UNUSED(renderPassParams);
 	dsViewCullList* cullList = (dsViewCullList*)itemList;
-	lazyRemoveEntries(cullList);
+	updateStaticEntries(cullList);
 
-	for (uint32_t i = 0; i < cullList->staticEntryCount; ++i)
+	if (!cullStaticEntriesBVH(cullList, view, &visitStaticEntry))
 	{
-		const StaticEntry* entry = cullList->staticEntries + i;
-		dsMatrix44f boxMatrix;
-		dsMatrix44f_affineMul(&boxMatrix, entry->transform, &entry->localBoxMatrix);
-		*entry->result = dsFrustum3f_intersectBoxMatrix(&view->viewFrustum, &boxMatrix) ==
-			dsIntersectResult_Outside;
+		cullList->resetStaticResults = true;
+		for (uint32_t i = 0; i < cullList->staticEntryCount; ++i)
+		{
+			const StaticEntry* entry = cullList->staticEntries + i;
+			*entry->result = dsFrustum3f_intersectBoxMatrix(&view->viewFrustum,
+				&entry->boxMatrix) == dsIntersectResult_Outside;
+		}
 	}
 
 	for (uint32_t i = 0; i < cullList->dynamicEntryCount; ++i)
@@ -284,6 +540,10 @@ static void dsViewCullList_destroy(dsSceneItemList* itemList)
 	dsViewCullList* cullList = (dsViewCullList*)itemList;
 	DS_VERIFY(dsAllocator_free(itemList->allocator, cullList->staticEntries));
 	DS_VERIFY(dsAllocator_free(itemList->allocator, cullList->removeStaticEntries));
+	DS_VERIFY(dsAllocator_free(itemList->allocator, cullList->dirtyStaticEntries));
+	DS_VERIFY(dsAllocator_free(itemList->allocator, cullList->visibleStaticEntries));
+	DS_VERIFY(dsAllocator_free(itemList->allocator, cullList->nextVisibleStaticEntries));
+	dsBVH_destroy(cullList->staticBVH);
 	DS_VERIFY(dsAllocator_free(itemList->allocator, cullList->dynamicEntries));
 	DS_VERIFY(dsAllocator_free(itemList->allocator, cullList->removeDynamicEntries));
 	DS_VERIFY(dsAllocator_free(itemList->allocator, itemList));
@@ -295,6 +555,7 @@ const char* const dsViewCullList_typeName = "ViewCullList";
 static dsSceneItemListType itemListTypeSIMD =
 {
 	.addNodeFunc = &dsViewCullList_addNode,
+	.updateNodeFunc = &dsViewCullList_updateNode,
 	.removeNodeFunc = &dsViewCullList_removeNode,
 	.commitFunc = &dsViewCullList_commitSIMD,
 	.destroyFunc = &dsViewCullList_destroy
@@ -304,6 +565,7 @@ static dsSceneItemListType itemListTypeSIMD =
 static dsSceneItemListType itemListTypeFMA =
 {
 	.addNodeFunc = &dsViewCullList_addNode,
+	.updateNodeFunc = &dsViewCullList_updateNode,
 	.removeNodeFunc = &dsViewCullList_removeNode,
 	.commitFunc = &dsViewCullList_commitFMA,
 	.destroyFunc = &dsViewCullList_destroy
@@ -314,6 +576,7 @@ static dsSceneItemListType itemListTypeFMA =
 static dsSceneItemListType itemListType =
 {
 	.addNodeFunc = &dsViewCullList_addNode,
+	.updateNodeFunc = &dsViewCullList_updateNode,
 	.removeNodeFunc = &dsViewCullList_removeNode,
 	.commitFunc = &dsViewCullList_commit,
 	.destroyFunc = &dsViewCullList_destroy
@@ -382,6 +645,23 @@ dsSceneItemList* dsViewCullList_create(
 	cullList->removeStaticEntryCount = 0;
 	cullList->maxRemoveStaticEntries = 0;
 
+	cullList->dirtyStaticEntries = NULL;
+	cullList->dirtyStaticEntryCount = 0;
+	cullList->maxDirtyStaticEntries = 0;
+
+	cullList->visibleStaticEntries = NULL;
+	cullList->visibleStaticEntryCount = 0;
+	cullList->maxVisibleStaticEntries = 0;
+
+	cullList->nextVisibleStaticEntries = NULL;
+	cullList->nextVisibleStaticEntryCount = 0;
+	cullList->maxNextVisibleStaticEntries = 0;
+
+	cullList->staticBVH = NULL;
+	cullList->staticEntriesChanged = false;
+	cullList->staticBVHValid = false;
+	cullList->resetStaticResults = false;
+
 	cullList->dynamicEntries = NULL;
 	cullList->dynamicEntryCount = 0;
 	cullList->maxDynamicEntries = 0;
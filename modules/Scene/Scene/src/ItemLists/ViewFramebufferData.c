@@ -188,6 +188,14 @@ static bool dsViewFramebufferData_bindInstance(
 		values, framebufferData->nameID, framebufferData->curBuffer, 0, sizeof(ViewFramebuffer));
 }
 
+static bool dsViewFramebufferData_bindInstanceRange(dsSceneInstanceData* instanceData,
+	uint32_t index, uint32_t count, dsSharedMaterialValues* values)
+{
+	// The same data is used for every instance.
+	DS_UNUSED(count);
+	return dsViewFramebufferData_bindInstance(instanceData, index, values);
+}
+
 static bool dsViewFramebufferData_finish(dsSceneInstanceData* instanceData)
 {
 	dsViewFramebufferData* framebufferData = (dsViewFramebufferData*)instanceData;
@@ -247,6 +255,7 @@ static dsSceneInstanceDataType instanceDataType =
 {
 	&dsViewFramebufferData_populateData,
 	&dsViewFramebufferData_bindInstance,
+	&dsViewFramebufferData_bindInstanceRange,
 	&dsViewFramebufferData_finish,
 	&dsViewFramebufferData_hash,
 	&dsViewFramebufferData_equal,
@@ -337,6 +346,8 @@ dsSceneInstanceData* dsViewFramebufferData_create(dsAllocator* allocator,
 	instanceData->type = dsViewFramebufferData_type();
 	instanceData->valueCount = 1;
 	instanceData->needsCommandBuffer = false;
+	instanceData->maxInstanceRange = UINT32_MAX;
+	instanceData->instanceAlignment = 1;
 
 	framebufferData->resourceAllocator = resourceAllocator;
 	framebufferData->resourceManager = resourceManager;
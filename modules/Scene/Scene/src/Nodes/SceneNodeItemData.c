@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2024 Aaron Barany
+ * Copyright 2019-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,6 +16,7 @@
 
 #include <DeepSea/Scene/Nodes/SceneNodeItemData.h>
 
+#include <DeepSea/Core/Error.h>
 #include <DeepSea/Core/UniqueNameID.h>
 
 void* dsSceneNodeItemData_findName(const dsSceneNodeItemData* itemData, const char* name)
@@ -36,3 +37,38 @@ void* dsSceneNodeItemData_findID(const dsSceneNodeItemData* itemData, uint32_t n
 
 	return NULL;
 }
+
+bool dsSceneNodeItemData_getIndexMask(uint64_t* outMask, const dsSceneNode* node,
+	const uint32_t* nameIDs, uint32_t nameIDCount)
+{
+	if (!outMask || !node || (!nameIDs && nameIDCount > 0))
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	uint64_t mask = 0;
+	for (uint32_t i = 0; i < node->itemListCount && nameIDCount > 0; ++i)
+	{
+		uint32_t nameID = dsUniqueNameID_get(node->itemLists[i]);
+		for (uint32_t j = 0; j < nameIDCount; ++j)
+		{
+			if (nameIDs[j] != nameID)
+				continue;
+
+			if (i >= 64)
+			{
+				errno = ERANGE;
+				return false;
+			}
+
+			mask |= (uint64_t)1 << i;
+			break;
+		}
+	}
+
+	*outMask = mask;
+	return true;
+}
+
+bool dsSceneNodeItemData_anyInMask(const dsSceneNodeItemData* itemData, uint64_t mask);
@@ -387,7 +387,7 @@ static void moveToScene(
 		moveToScene(node->children[i], newScene, commonItemLists);
 }
 
-static bool updateSubtreeRec(
+static bool updateNodeTransform(
 	dsSceneTreeNode* node, uint64_t frameNumber, uint64_t stepNumber, float stepT)
 {
 	// Check frame for prevFrameWorldTransform as multiple updates may occur per frame.
@@ -397,6 +397,16 @@ static bool updateSubtreeRec(
 		node->lastUpdatedFrame = frameNumber;
 	}
 
+	// Check for stepT equal to 1 for either intermediate steps or dynamic updates where the
+	// transforms don't need interpolation.
+	if (stepT >= 1.0f)
+	{
+		updateOnlyCurTransform(node);
+		node->lastUpdatedStep = stepNumber;
+		node->lastUpdatedStepT = 1.0f;
+		return true;
+	}
+
 	// If this was last updated in a previous step, then the transform becomes the current step's
 	// transform, ignoring stepT for the current step.
 	bool updateFinished;
@@ -412,34 +422,11 @@ static bool updateSubtreeRec(
 		node->lastUpdatedStep = stepNumber;
 		node->lastUpdatedStepT = stepT;
 	}
-
-	for (uint32_t i = 0; i < node->node->itemListCount; ++i)
-	{
-		const dsSceneItemEntry* itemListEntry = node->itemLists + i;
-		uint64_t entry = itemListEntry->entry;
-		dsSceneItemList* list = itemListEntry->list;
-		if (entry != DS_NO_SCENE_NODE && list->type->updateNodeFunc)
-			list->type->updateNodeFunc(list, node, entry);
-	}
-
-	for (uint32_t i = 0; i < node->childCount; ++i)
-		updateFinished &= updateSubtreeRec(node->children[i], frameNumber, stepNumber, stepT);
 	return updateFinished;
 }
 
-static void updateSubtreeOnlyCurTransformRec(
-	dsSceneTreeNode* node, uint64_t frameNumber, uint64_t stepNumber)
+static void updateNodeItemLists(dsSceneTreeNode* node)
 {
-	// Check frame for prevFrameWorldTransform as multiple updates may occur per frame.
-	if (node->lastUpdatedFrame != frameNumber)
-	{
-		node->prevFrameWorldTransform = node->curFrameWorldTransform;
-		node->lastUpdatedFrame = frameNumber;
-	}
-
-	updateOnlyCurTransform(node);
-	node->lastUpdatedStep = stepNumber;
-	node->lastUpdatedStepT = 1.0f;
 	for (uint32_t i = 0; i < node->node->itemListCount; ++i)
 	{
 		const dsSceneItemEntry* itemListEntry = node->itemLists + i;
@@ -448,9 +435,16 @@ static void updateSubtreeOnlyCurTransformRec(
 		if (entry != DS_NO_SCENE_NODE && list->type->updateNodeFunc)
 			list->type->updateNodeFunc(list, node, entry);
 	}
+}
 
+static bool updateSubtreeRec(
+	dsSceneTreeNode* node, uint64_t frameNumber, uint64_t stepNumber, float stepT)
+{
+	bool updateFinished = updateNodeTransform(node, frameNumber, stepNumber, stepT);
+	updateNodeItemLists(node);
 	for (uint32_t i = 0; i < node->childCount; ++i)
-		updateSubtreeOnlyCurTransformRec(node->children[i], frameNumber, stepNumber);
+		updateFinished &= updateSubtreeRec(node->children[i], frameNumber, stepNumber, stepT);
+	return updateFinished;
 }
 
 dsScene* dsSceneTreeNode_getScene(dsSceneTreeNode* node)
@@ -578,13 +572,49 @@ bool dsSceneTreeNode_updateSubtree(
 	while (node->parent && isDirty(node->parent, stepNumber, stepT))
 		node = node->parent;
 
-	// Check for stepT equal to 1 for either intermediate steps or dynamic updates where the
-	// transforms don't need interpolation.
-	if (stepT < 1.0f)
-		return updateSubtreeRec(node, frameNumber, stepNumber, stepT);
+	return updateSubtreeRec(node, frameNumber, stepNumber, stepT);
+}
 
-	updateSubtreeOnlyCurTransformRec(node, frameNumber, stepNumber);
-	return true;
+dsSceneTreeNode* dsSceneTreeNode_findUpdateRoot(
+	dsSceneTreeNode* node, uint64_t stepNumber, float stepT)
+{
+	if (!isDirty(node, stepNumber, stepT))
+		return NULL;
+
+	// Check all ancestors rather than stopping at the first clean parent so that any two roots
+	// will either be the same node or have disjoint subtrees.
+	dsSceneTreeNode* root = node;
+	for (dsSceneTreeNode* parent = node->parent; parent; parent = parent->parent)
+	{
+		if (isDirty(parent, stepNumber, stepT))
+			root = parent;
+	}
+	return root;
+}
+
+bool dsSceneTreeNode_updateTransform(
+	dsSceneTreeNode* node, uint64_t frameNumber, uint64_t stepNumber, float stepT)
+{
+	return updateNodeTransform(node, frameNumber, stepNumber, stepT);
+}
+
+bool dsSceneTreeNode_updateSubtreeTransforms(
+	dsSceneTreeNode* node, uint64_t frameNumber, uint64_t stepNumber, float stepT)
+{
+	bool updateFinished = updateNodeTransform(node, frameNumber, stepNumber, stepT);
+	for (uint32_t i = 0; i < node->childCount; ++i)
+	{
+		updateFinished &= dsSceneTreeNode_updateSubtreeTransforms(
+			node->children[i], frameNumber, stepNumber, stepT);
+	}
+	return updateFinished;
+}
+
+void dsSceneTreeNode_updateSubtreeItemLists(dsSceneTreeNode* node)
+{
+	updateNodeItemLists(node);
+	for (uint32_t i = 0; i < node->childCount; ++i)
+		dsSceneTreeNode_updateSubtreeItemLists(node->children[i]);
 }
 
 void dsSceneTreeNode_markDirty(dsSceneTreeNode* node)
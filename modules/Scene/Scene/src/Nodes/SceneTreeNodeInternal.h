@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2025 Aaron Barany
+ * Copyright 2019-2026 Aaron Barany
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -28,3 +28,16 @@ bool dsSceneTreeNode_transferSceneNodes(dsSceneNode* prevRoot, dsSceneNode* newR
 // Returns false if another update will be required later.
 bool dsSceneTreeNode_updateSubtree(
 	dsSceneTreeNode* node, uint64_t frameNumber, uint64_t stepNumber, float stepT);
+
+// Functions to update the scene in multiple stages, used for multithreaded updates.
+// Returns NULL if the node isn't dirty, otherwise the top-most dirty node that contains it.
+dsSceneTreeNode* dsSceneTreeNode_findUpdateRoot(
+	dsSceneTreeNode* node, uint64_t stepNumber, float stepT);
+// Updates the transform for a single node without updating the children or item lists.
+bool dsSceneTreeNode_updateTransform(
+	dsSceneTreeNode* node, uint64_t frameNumber, uint64_t stepNumber, float stepT);
+// Updates the transforms for a subtree without updating the item lists. This is safe to call
+// across threads for disjoint subtrees.
+bool dsSceneTreeNode_updateSubtreeTransforms(
+	dsSceneTreeNode* node, uint64_t frameNumber, uint64_t stepNumber, float stepT);
+void dsSceneTreeNode_updateSubtreeItemLists(dsSceneTreeNode* node);
@@ -17,14 +17,16 @@
 #include <DeepSea/Scene/Scene.h>
 
 #include "Nodes/SceneTreeNodeInternal.h"
+#include "SceneParallelUpdate.h"
 #include "SceneTypes.h"
 
 #include <DeepSea/Core/Containers/Hash.h>
 #include <DeepSea/Core/Containers/HashTable.h>
 #include <DeepSea/Core/Memory/Allocator.h>
 #include <DeepSea/Core/Memory/BufferAllocator.h>
+#include <DeepSea/Core/Streams/AsyncIO.h>
 #include <DeepSea/Core/Streams/FileArchive.h>
-#include <DeepSea/Core/Streams/FileStream.h>
+#include <DeepSea/Core/Streams/MappedFileStream.h>
 #include <DeepSea/Core/Streams/ResourceStream.h>
 #include <DeepSea/Core/Streams/Stream.h>
 #include <DeepSea/Core/Assert.h>
@@ -137,6 +139,15 @@ static size_t fullAllocSize(uint32_t* outNameCount, uint32_t* outGlobalValueCoun
 						errno = EINVAL;
 						return 0;
 					}
+					else if (itemList->type->commitRangeFunc &&
+						!itemList->type->prepareCommitRangesFunc)
+					{
+						DS_LOG_ERROR_F(DS_SCENE_LOG_TAG,
+							"Scene item list '%s' with a commit range function must also have a "
+							"prepare commit ranges function.", itemList->name);
+						errno = EINVAL;
+						return 0;
+					}
 					else if (itemList->globalValueCount > 0)
 					{
 						DS_LOG_ERROR_F(DS_SCENE_LOG_TAG,
@@ -293,6 +304,54 @@ dsScene* dsScene_loadImpl(dsAllocator* allocator, dsAllocator* resourceAllocator
 	size_t dataSize, void* userData, dsDestroyUserDataFunction destroyUserDataFunc,
 	dsScene* prevScene, const char* fileName);
 
+typedef struct LoadAsyncContext
+{
+	dsAllocator* allocator;
+	dsAllocator* resourceAllocator;
+	const dsSceneLoadContext* loadContext;
+	dsSceneLoadScratchData* scratchData;
+	void* userData;
+	dsDestroyUserDataFunction destroyUserDataFunc;
+	dsScene* prevScene;
+	dsAsyncLoadCompleteFunction completeFunc;
+	void* completeUserData;
+} LoadAsyncContext;
+
+static void loadAsyncComplete(void* userData, const dsAsyncIORequest* request, void* data,
+	size_t size, int errorCode)
+{
+	DS_PROFILE_FUNC_START();
+
+	LoadAsyncContext* context = (LoadAsyncContext*)userData;
+	dsAllocator* scratchAllocator = request->allocator;
+	const char* filePath = request->file.path;
+	dsScene* scene = NULL;
+	if (data)
+	{
+		scene = dsScene_loadImpl(context->allocator, context->resourceAllocator,
+			context->loadContext, context->scratchData, data, size, context->userData,
+			context->destroyUserDataFunc, context->prevScene, filePath);
+		if (!scene)
+			errorCode = errno;
+		DS_VERIFY(dsAllocator_free(scratchAllocator, data));
+	}
+	else
+	{
+		DS_LOG_ERROR_F(DS_SCENE_LOG_TAG, "Couldn't open scene file '%s'.", filePath);
+		if (context->destroyUserDataFunc)
+			context->destroyUserDataFunc(context->userData);
+		dsScene_destroy(context->prevScene);
+		if (errorCode == 0)
+			errorCode = EFORMAT;
+	}
+
+	dsAsyncLoadCompleteFunction completeFunc = context->completeFunc;
+	void* completeUserData = context->completeUserData;
+	DS_VERIFY(dsAllocator_free(scratchAllocator, context));
+	completeFunc(completeUserData, scene, errorCode);
+	DS_PROFILE_FUNC_RETURN_VOID();
+}
+
 dsScene* dsScene_create(dsAllocator* allocator, dsRenderer* renderer,
 	const dsSceneItemLists* sharedItems, uint32_t sharedItemCount,
 	const dsScenePipelineItem* pipeline, uint32_t pipelineCount, void* userData,
@@ -428,6 +487,7 @@ dsScene* dsScene_create(dsAllocator* allocator, dsRenderer* renderer,
 	scene->dirtyNodes = NULL;
 	scene->dirtyNodeCount = 0;
 	scene->maxDirtyNodes = 0;
+	scene->parallelUpdate = NULL;
 
 	dsSceneItemListNode* itemNodes = DS_ALLOCATE_OBJECT_ARRAY(
 		&bufferAlloc, dsSceneItemListNode, nameCount);
@@ -524,22 +584,21 @@ dsScene* dsScene_loadFile(dsAllocator* allocator, dsAllocator* resourceAllocator
 	if (!resourceAllocator)
 		resourceAllocator = allocator;
 
-	dsFileStream stream;
-	if (!dsFileStream_openPath(&stream, filePath, "rb"))
+	dsMappedFileStream stream;
+	if (!dsMappedFileStream_openPath(&stream, filePath))
 	{
 		DS_LOG_ERROR_F(DS_RENDER_LOG_TAG, "Couldn't open scene file '%s'.", filePath);
 		DS_PROFILE_FUNC_RETURN(NULL);
 	}
 
+	// Load directly from the mapped file rather than copying it to a separate buffer.
 	size_t size;
-	void* buffer = dsSceneLoadScratchData_readUntilEnd(&size, scratchData, (dsStream*)&stream);
-	dsFileStream_close(&stream);
-	if (!buffer)
-		DS_PROFILE_FUNC_RETURN(NULL);
+	const void* buffer = dsMappedFileStream_getBuffer(&stream, &size);
+	DS_ASSERT(buffer);
 
 	dsScene* scene = dsScene_loadImpl(allocator, resourceAllocator, loadContext, scratchData,
 		buffer, size, userData, destroyUserDataFunc, prevScene, filePath);
-	DS_VERIFY(dsSceneLoadScratchData_freeReadBuffer(scratchData, buffer));
+	DS_VERIFY(dsMappedFileStream_close(&stream));
 	DS_PROFILE_FUNC_RETURN(scene);
 }
 
@@ -648,6 +707,63 @@ dsScene* dsScene_loadData(dsAllocator* allocator, dsAllocator* resourceAllocator
 	DS_PROFILE_FUNC_RETURN(scene);
 }
 
+bool dsScene_loadAsync(dsAsyncIO* asyncIO, dsAllocator* allocator,
+	dsAllocator* resourceAllocator, const dsSceneLoadContext* loadContext,
+	dsSceneLoadScratchData* scratchData, void* userData,
+	dsDestroyUserDataFunction destroyUserDataFunc, dsScene* prevScene, const dsAsyncIOFile* file,
+	dsAsyncLoadCompleteFunction completeFunc, void* completeUserData)
+{
+	DS_PROFILE_FUNC_START();
+
+	if (!asyncIO || !allocator || !loadContext || !scratchData || !file || !file->path ||
+		!completeFunc)
+	{
+		errno = EINVAL;
+		if (destroyUserDataFunc)
+			destroyUserDataFunc(userData);
+		dsScene_destroy(prevScene);
+		DS_PROFILE_FUNC_RETURN(false);
+	}
+
+	dsAllocator* scratchAllocator = dsSceneLoadScratchData_getAllocator(scratchData);
+	LoadAsyncContext* context = DS_ALLOCATE_OBJECT(scratchAllocator, LoadAsyncContext);
+	if (!context)
+	{
+		if (destroyUserDataFunc)
+			destroyUserDataFunc(userData);
+		dsScene_destroy(prevScene);
+		DS_PROFILE_FUNC_RETURN(false);
+	}
+
+	context->allocator = allocator;
+	context->resourceAllocator = resourceAllocator ? resourceAllocator : allocator;
+	context->loadContext = loadContext;
+	context->scratchData = scratchData;
+	context->userData = userData;
+	context->destroyUserDataFunc = destroyUserDataFunc;
+	context->prevScene = prevScene;
+	context->completeFunc = completeFunc;
+	context->completeUserData = completeUserData;
+
+	dsAsyncIORequest request;
+	memset(&request, 0, sizeof(request));
+	request.file = *file;
+	request.allocator = scratchAllocator;
+	request.completeFunc = &loadAsyncComplete;
+	request.userData = context;
+	request.completeOnIOThread = false;
+	if (!dsAsyncIO_addRequests(asyncIO, &request, 1))
+	{
+		DS_VERIFY(dsAllocator_free(scratchAllocator, context));
+		if (destroyUserDataFunc)
+			destroyUserDataFunc(userData);
+		dsScene_destroy(prevScene);
+		DS_PROFILE_FUNC_RETURN(false);
+	}
+
+	DS_PROFILE_FUNC_RETURN(true);
+}
+
 dsAllocator* dsScene_getAllocator(const dsScene* scene)
 {
 	if (!scene)
@@ -759,6 +875,38 @@ bool dsScene_forEachItemList(
 	return true;
 }
 
+dsThreadPool* dsScene_getUpdateThreadPool(const dsScene* scene)
+{
+	if (!scene || !scene->parallelUpdate)
+		return NULL;
+
+	return dsSceneParallelUpdate_getThreadPool(scene->parallelUpdate);
+}
+
+bool dsScene_setUpdateThreadPool(dsScene* scene, dsThreadPool* threadPool)
+{
+	if (!scene)
+	{
+		errno = EINVAL;
+		return false;
+	}
+
+	if (dsScene_getUpdateThreadPool(scene) == threadPool)
+		return true;
+
+	dsSceneParallelUpdate* parallelUpdate = NULL;
+	if (threadPool)
+	{
+		parallelUpdate = dsSceneParallelUpdate_create(scene->allocator, threadPool);
+		if (!parallelUpdate)
+			return false;
+	}
+
+	dsSceneParallelUpdate_destroy(scene->parallelUpdate);
+	scene->parallelUpdate = parallelUpdate;
+	return true;
+}
+
 const dsSceneTick* dsScene_getLastUpdateTick(const dsScene* scene)
 {
 	if (!scene)
@@ -803,14 +951,20 @@ bool dsScene_update(dsScene* scene, const dsSceneTick* tick)
 
 		// Update the transforms for each dirty scene tree node. They may remain dirty if the
 		// transform requires further updating if it's  currently using an interpolated value.
-		uint32_t newDirtyNodeCount = 0;
-		for (uint32_t j = 0; j < scene->dirtyNodeCount; ++j)
+		// Fall back to updating on this thread if the parallel update couldn't be performed.
+		if (!scene->parallelUpdate || scene->dirtyNodeCount == 0 ||
+			!dsSceneParallelUpdate_updateNodes(
+				scene->parallelUpdate, scene, frameNumber, thisStep, thisStepT))
 		{
-			dsSceneTreeNode* node = scene->dirtyNodes[j];
-			if (!dsSceneTreeNode_updateSubtree(node, frameNumber, thisStep, thisStepT))
-				scene->dirtyNodes[newDirtyNodeCount++] = node;
+			uint32_t newDirtyNodeCount = 0;
+			for (uint32_t j = 0; j < scene->dirtyNodeCount; ++j)
+			{
+				dsSceneTreeNode* node = scene->dirtyNodes[j];
+				if (!dsSceneTreeNode_updateSubtree(node, frameNumber, thisStep, thisStepT))
+					scene->dirtyNodes[newDirtyNodeCount++] = node;
+			}
+			scene->dirtyNodeCount = newDirtyNodeCount;
 		}
-		scene->dirtyNodeCount = newDirtyNodeCount;
 
 		for (dsListNode* node = scene->itemLists->list.head; node; node = node->next)
 		{
@@ -847,6 +1001,7 @@ void dsScene_destroy(dsScene* scene)
 	destroyObjects(scene->sharedItems, scene->sharedItemCount, scene->pipeline,
 		scene->pipelineCount, scene->userData, scene->destroyUserDataFunc);
 	DS_VERIFY(dsAllocator_free(scene->allocator, scene->dirtyNodes));
+	dsSceneParallelUpdate_destroy(scene->parallelUpdate);
 
 	DS_VERIFY(dsAllocator_free(scene->allocator, scene));
 }
@@ -0,0 +1,404 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SceneParallelUpdate.h"
+
+#include "Nodes/SceneTreeNodeInternal.h"
+
+#include <DeepSea/Core/Containers/ResizeableArray.h>
+#include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Thread/ThreadPool.h>
+#include <DeepSea/Core/Thread/ThreadTaskQueue.h>
+#include <DeepSea/Core/Assert.h>
+#include <DeepSea/Core/Error.h>
+#include <DeepSea/Core/Profile.h>
+#include <DeepSea/Core/Sort.h>
+
+#include <DeepSea/Math/Core.h>
+
+#include <string.h>
+
+// Aim for multiple tasks per thread to balance out uneven subtrees.
+#define TASKS_PER_THREAD 4
+// Limit how many levels of the tree are updated on the calling thread before splitting up tasks.
+#define MAX_SPLIT_DEPTH 8
+#define MAX_TASKS 100
+#define NO_ROOT ((uint32_t)-1)
+
+typedef struct DirtyNodeInfo
+{
+	dsSceneTreeNode* root;
+	uint32_t rootIndex;
+} DirtyNodeInfo;
+
+typedef struct RootCandidate
+{
+	dsSceneTreeNode* root;
+	uint32_t dirtyIndex;
+} RootCandidate;
+
+typedef struct UpdateRoot
+{
+	dsSceneTreeNode* node;
+	bool updateFinished;
+} UpdateRoot;
+
+typedef struct SubtreeEntry
+{
+	dsSceneTreeNode* node;
+	uint32_t rootIndex;
+	bool updateFinished;
+} SubtreeEntry;
+
+typedef struct SubtreeTask
+{
+	dsSceneParallelUpdate* update;
+	uint32_t firstEntry;
+	uint32_t entryCount;
+} SubtreeTask;
+
+struct dsSceneParallelUpdate
+{
+	dsAllocator* allocator;
+	dsThreadPool* threadPool;
+	dsThreadTaskQueue* taskQueue;
+
+	uint64_t frameNumber;
+	uint64_t stepNumber;
+	float stepT;
+
+	DirtyNodeInfo* dirtyNodes;
+	uint32_t dirtyNodeCount;
+	uint32_t maxDirtyNodes;
+
+	RootCandidate* rootCandidates;
+	uint32_t rootCandidateCount;
+	uint32_t maxRootCandidates;
+
+	UpdateRoot* roots;
+	uint32_t rootCount;
+	uint32_t maxRoots;
+
+	SubtreeEntry* entries;
+	uint32_t entryCount;
+	uint32_t maxEntries;
+
+	SubtreeTask* subtreeTasks;
+	dsThreadTask* threadTasks;
+	uint32_t taskCount;
+	uint32_t maxTasks;
+};
+
+static int compareRootCandidates(const void* left, const void* right, void* context)
+{
+	DS_UNUSED(context);
+	const RootCandidate* leftCandidate = (const RootCandidate*)left;
+	const RootCandidate* rightCandidate = (const RootCandidate*)right;
+	uintptr_t leftRoot = (uintptr_t)leftCandidate->root;
+	uintptr_t rightRoot = (uintptr_t)rightCandidate->root;
+	int rootCmp = (leftRoot > rightRoot) - (leftRoot < rightRoot);
+	return dsCombineCmp(rootCmp, (leftCandidate->dirtyIndex > rightCandidate->dirtyIndex) -
+		(leftCandidate->dirtyIndex < rightCandidate->dirtyIndex));
+}
+
+static void updateSubtreesTask(void* userData)
+{
+	SubtreeTask* task = (SubtreeTask*)userData;
+	dsSceneParallelUpdate* update = task->update;
+	SubtreeEntry* entries = update->entries + task->firstEntry;
+	for (uint32_t i = 0; i < task->entryCount; ++i)
+	{
+		SubtreeEntry* entry = entries + i;
+		entry->updateFinished = dsSceneTreeNode_updateSubtreeTransforms(entry->node,
+			update->frameNumber, update->stepNumber, update->stepT);
+	}
+}
+
+static bool findRoots(dsSceneParallelUpdate* update, dsScene* scene)
+{
+	uint32_t dirtyNodeCount = scene->dirtyNodeCount;
+	update->dirtyNodeCount = 0;
+	update->rootCandidateCount = 0;
+	update->rootCount = 0;
+	if (!DS_RESIZEABLE_ARRAY_ADD(update->allocator, update->dirtyNodes, update->dirtyNodeCount,
+			update->maxDirtyNodes, dirtyNodeCount) ||
+		!DS_RESIZEABLE_ARRAY_ADD(update->allocator, update->rootCandidates,
+			update->rootCandidateCount, update->maxRootCandidates, dirtyNodeCount) ||
+		!DS_RESIZEABLE_ARRAY_ADD(update->allocator, update->roots, update->rootCount,
+			update->maxRoots, dirtyNodeCount))
+	{
+		return false;
+	}
+
+	update->rootCandidateCount = 0;
+	for (uint32_t i = 0; i < dirtyNodeCount; ++i)
+	{
+		DirtyNodeInfo* dirtyNode = update->dirtyNodes + i;
+		dirtyNode->root = dsSceneTreeNode_findUpdateRoot(
+			scene->dirtyNodes[i], update->stepNumber, update->stepT);
+		dirtyNode->rootIndex = NO_ROOT;
+		if (!dirtyNode->root)
+			continue;
+
+		RootCandidate* candidate = update->rootCandidates + update->rootCandidateCount++;
+		candidate->root = dirtyNode->root;
+		candidate->dirtyIndex = i;
+	}
+
+	// Multiple dirty nodes may share the same root. Only the first dirty node for each root will
+	// own it, matching the single-threaded update where later dirty nodes are no longer dirty.
+	dsSort(update->rootCandidates, update->rootCandidateCount, sizeof(RootCandidate),
+		&compareRootCandidates, NULL);
+	for (uint32_t i = 0; i < update->rootCandidateCount; ++i)
+	{
+		const RootCandidate* candidate = update->rootCandidates + i;
+		if (i == 0 || candidate->root != update->rootCandidates[i - 1].root)
+			update->dirtyNodes[candidate->dirtyIndex].rootIndex = 0;
+	}
+
+	update->rootCount = 0;
+	for (uint32_t i = 0; i < dirtyNodeCount; ++i)
+	{
+		DirtyNodeInfo* dirtyNode = update->dirtyNodes + i;
+		if (dirtyNode->rootIndex == NO_ROOT)
+			continue;
+
+		dirtyNode->rootIndex = update->rootCount++;
+		UpdateRoot* root = update->roots + dirtyNode->rootIndex;
+		root->node = dirtyNode->root;
+		root->updateFinished = true;
+	}
+
+	return true;
+}
+
+static void splitSubtrees(dsSceneParallelUpdate* update, uint32_t targetEntryCount)
+{
+	// Update the top levels of the subtrees on this thread until there are enough independent
+	// subtrees to distribute across threads. Each level is appended to the end of the entries, with
+	// the final level being the subtrees to update in parallel.
+	uint32_t levelStart = 0;
+	for (unsigned int depth = 0; depth < MAX_SPLIT_DEPTH; ++depth)
+	{
+		uint32_t levelEnd = update->entryCount;
+		uint32_t levelCount = levelEnd - levelStart;
+		if (levelCount == 0 || levelCount >= targetEntryCount)
+			break;
+
+		uint32_t childCount = 0;
+		for (uint32_t i = levelStart; i < levelEnd; ++i)
+			childCount += update->entries[i].node->childCount;
+
+		// Reserve the space for the next level before modifying any nodes. If this fails, the
+		// current level may still be updated in parallel.
+		uint32_t nextLevelStart = update->entryCount;
+		if (!DS_RESIZEABLE_ARRAY_ADD(update->allocator, update->entries, update->entryCount,
+				update->maxEntries, childCount))
+		{
+			break;
+		}
+
+		uint32_t nextEntry = nextLevelStart;
+		for (uint32_t i = levelStart; i < levelEnd; ++i)
+		{
+			const SubtreeEntry* entry = update->entries + i;
+			dsSceneTreeNode* node = entry->node;
+			uint32_t rootIndex = entry->rootIndex;
+			if (!dsSceneTreeNode_updateTransform(node, update->frameNumber, update->stepNumber,
+					update->stepT))
+			{
+				update->roots[rootIndex].updateFinished = false;
+			}
+
+			for (uint32_t j = 0; j < node->childCount; ++j)
+			{
+				SubtreeEntry* childEntry = update->entries + nextEntry++;
+				childEntry->node = node->children[j];
+				childEntry->rootIndex = rootIndex;
+				childEntry->updateFinished = true;
+			}
+		}
+		DS_ASSERT(nextEntry == update->entryCount);
+
+		levelStart = nextLevelStart;
+	}
+
+	// Move the final level to the start of the entries.
+	uint32_t finalCount = update->entryCount - levelStart;
+	if (levelStart > 0)
+	{
+		memmove(update->entries, update->entries + levelStart,
+			sizeof(SubtreeEntry)*finalCount);
+	}
+	update->entryCount = finalCount;
+}
+
+static bool queueSubtrees(dsSceneParallelUpdate* update, uint32_t targetTaskCount)
+{
+	uint32_t taskCount = dsMin(update->entryCount, targetTaskCount);
+	update->taskCount = 0;
+	if (taskCount > update->maxTasks)
+	{
+		SubtreeTask* subtreeTasks = DS_ALLOCATE_OBJECT_ARRAY(update->allocator, SubtreeTask,
+			taskCount);
+		if (!subtreeTasks)
+			return false;
+
+		dsThreadTask* threadTasks = DS_ALLOCATE_OBJECT_ARRAY(update->allocator, dsThreadTask,
+			taskCount);
+		if (!threadTasks)
+		{
+			DS_VERIFY(dsAllocator_free(update->allocator, subtreeTasks));
+			return false;
+		}
+
+		DS_VERIFY(dsAllocator_free(update->allocator, update->subtreeTasks));
+		DS_VERIFY(dsAllocator_free(update->allocator, update->threadTasks));
+		update->subtreeTasks = subtreeTasks;
+		update->threadTasks = threadTasks;
+		update->maxTasks = taskCount;
+	}
+
+	// Distribute the entries as evenly as possible across the tasks.
+	uint32_t firstEntry = 0;
+	for (uint32_t i = 0; i < taskCount; ++i)
+	{
+		uint32_t endEntry = (uint32_t)(((uint64_t)update->entryCount*(i + 1))/taskCount);
+		SubtreeTask* subtreeTask = update->subtreeTasks + i;
+		subtreeTask->update = update;
+		subtreeTask->firstEntry = firstEntry;
+		subtreeTask->entryCount = endEntry - firstEntry;
+		firstEntry = endEntry;
+
+		dsThreadTask* threadTask = update->threadTasks + i;
+		threadTask->taskFunc = &updateSubtreesTask;
+		threadTask->userData = subtreeTask;
+	}
+	update->taskCount = taskCount;
+
+	return dsThreadTaskQueue_addTasks(update->taskQueue, update->threadTasks, taskCount);
+}
+
+dsSceneParallelUpdate* dsSceneParallelUpdate_create(dsAllocator* allocator,
+	dsThreadPool* threadPool)
+{
+	DS_ASSERT(allocator && allocator->freeFunc);
+	DS_ASSERT(threadPool);
+
+	dsSceneParallelUpdate* update = DS_ALLOCATE_OBJECT(allocator, dsSceneParallelUpdate);
+	if (!update)
+		return NULL;
+
+	memset(update, 0, sizeof(dsSceneParallelUpdate));
+	update->allocator = dsAllocator_keepPointer(allocator);
+	update->threadPool = threadPool;
+	update->taskQueue = dsThreadTaskQueue_create(allocator, threadPool, MAX_TASKS, 0);
+	if (!update->taskQueue)
+	{
+		DS_VERIFY(dsAllocator_free(allocator, update));
+		return NULL;
+	}
+
+	return update;
+}
+
+dsThreadPool* dsSceneParallelUpdate_getThreadPool(const dsSceneParallelUpdate* update)
+{
+	DS_ASSERT(update);
+	return update->threadPool;
+}
+
+bool dsSceneParallelUpdate_updateNodes(dsSceneParallelUpdate* update, dsScene* scene,
+	uint64_t frameNumber, uint64_t stepNumber, float stepT)
+{
+	DS_PROFILE_FUNC_START();
+	DS_ASSERT(update);
+	DS_ASSERT(scene);
+
+	update->frameNumber = frameNumber;
+	update->stepNumber = stepNumber;
+	update->stepT = stepT;
+	if (!findRoots(update, scene))
+		DS_PROFILE_FUNC_RETURN(false);
+
+	update->entryCount = 0;
+	if (!DS_RESIZEABLE_ARRAY_ADD(update->allocator, update->entries, update->entryCount,
+			update->maxEntries, update->rootCount))
+	{
+		DS_PROFILE_FUNC_RETURN(false);
+	}
+
+	for (uint32_t i = 0; i < update->rootCount; ++i)
+	{
+		SubtreeEntry* entry = update->entries + i;
+		entry->node = update->roots[i].node;
+		entry->rootIndex = i;
+		entry->updateFinished = true;
+	}
+
+	// Include the current thread since it will also process tasks when waiting.
+	uint32_t targetTaskCount = dsThreadPool_getThreadCount(update->threadPool) + 1;
+	uint32_t targetEntryCount = targetTaskCount*TASKS_PER_THREAD;
+	splitSubtrees(update, targetEntryCount);
+
+	// Past this point nodes may have been modified, so fall back to updating on this thread if the
+	// tasks can't be queued.
+	if (!queueSubtrees(update, targetEntryCount))
+	{
+		SubtreeTask task = {update, 0, update->entryCount};
+		updateSubtreesTask(&task);
+	}
+	DS_VERIFY(dsThreadTaskQueue_waitForTasks(update->taskQueue));
+
+	for (uint32_t i = 0; i < update->entryCount; ++i)
+	{
+		const SubtreeEntry* entry = update->entries + i;
+		if (!entry->updateFinished)
+			update->roots[entry->rootIndex].updateFinished = false;
+	}
+
+	// Item lists aren't guaranteed to be thread-safe, so update them on this thread in a consistent
+	// order once all transforms have been updated.
+	for (uint32_t i = 0; i < update->rootCount; ++i)
+		dsSceneTreeNode_updateSubtreeItemLists(update->roots[i].node);
+
+	// Nodes remain dirty if any node in their subtree requires further updates.
+	uint32_t newDirtyNodeCount = 0;
+	for (uint32_t i = 0; i < update->dirtyNodeCount; ++i)
+	{
+		const DirtyNodeInfo* dirtyNode = update->dirtyNodes + i;
+		if (dirtyNode->rootIndex != NO_ROOT && !update->roots[dirtyNode->rootIndex].updateFinished)
+			scene->dirtyNodes[newDirtyNodeCount++] = scene->dirtyNodes[i];
+	}
+	scene->dirtyNodeCount = newDirtyNodeCount;
+
+	DS_PROFILE_FUNC_RETURN(true);
+}
+
+void dsSceneParallelUpdate_destroy(dsSceneParallelUpdate* update)
+{
+	if (!update)
+		return;
+
+	dsThreadTaskQueue_destroy(update->taskQueue);
+	DS_VERIFY(dsAllocator_free(update->allocator, update->dirtyNodes));
+	DS_VERIFY(dsAllocator_free(update->allocator, update->rootCandidates));
+	DS_VERIFY(dsAllocator_free(update->allocator, update->roots));
+	DS_VERIFY(dsAllocator_free(update->allocator, update->entries));
+	DS_VERIFY(dsAllocator_free(update->allocator, update->subtreeTasks));
+	DS_VERIFY(dsAllocator_free(update->allocator, update->threadTasks));
+	DS_VERIFY(dsAllocator_free(update->allocator, update));
+}
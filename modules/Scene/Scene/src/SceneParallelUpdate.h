@@ -0,0 +1,32 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <DeepSea/Core/Config.h>
+#include "SceneTypes.h"
+
+dsSceneParallelUpdate* dsSceneParallelUpdate_create(dsAllocator* allocator,
+	dsThreadPool* threadPool);
+dsThreadPool* dsSceneParallelUpdate_getThreadPool(const dsSceneParallelUpdate* update);
+
+// Updates the transforms for the dirty nodes in the scene, updating the dirty node list in the
+// same way as dsSceneTreeNode_updateSubtree(). Returns false if the update couldn't be performed,
+// in which case no nodes will have been modified.
+bool dsSceneParallelUpdate_updateNodes(dsSceneParallelUpdate* update, dsScene* scene,
+	uint64_t frameNumber, uint64_t stepNumber, float stepT);
+
+void dsSceneParallelUpdate_destroy(dsSceneParallelUpdate* update);
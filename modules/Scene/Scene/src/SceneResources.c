@@ -22,7 +22,7 @@
 #include <DeepSea/Core/Memory/BufferAllocator.h>
 #include <DeepSea/Core/Memory/PoolAllocator.h>
 #include <DeepSea/Core/Streams/FileArchive.h>
-#include <DeepSea/Core/Streams/FileStream.h>
+#include <DeepSea/Core/Streams/MappedFileStream.h>
 #include <DeepSea/Core/Streams/Path.h>
 #include <DeepSea/Core/Streams/RelativePathStream.h>
 #include <DeepSea/Core/Streams/ResourceStream.h>
@@ -181,19 +181,6 @@ dsSceneResources* dsSceneResources_loadFile(dsAllocator* allocator, dsAllocator*
 		DS_PROFILE_FUNC_RETURN(NULL);
 	}
 
-	dsFileStream stream;
-	if (!dsFileStream_openPath(&stream, filePath, "rb"))
-	{
-		DS_LOG_ERROR_F(DS_RENDER_LOG_TAG, "Couldn't open scene resources file '%s'.", filePath);
-		DS_PROFILE_FUNC_RETURN(NULL);
-	}
-
-	size_t size;
-	void* buffer = dsSceneLoadScratchData_readUntilEnd(&size, scratchData, (dsStream*)&stream);
-	dsFileStream_close(&stream);
-	if (!buffer)
-		DS_PROFILE_FUNC_RETURN(NULL);
-
 	char baseDirectory[DS_PATH_MAX];
 	if (!dsPath_getDirectoryName(baseDirectory, sizeof(baseDirectory), filePath))
 	{
@@ -203,11 +190,23 @@ dsSceneResources* dsSceneResources_loadFile(dsAllocator* allocator, dsAllocator*
 			DS_PROFILE_FUNC_RETURN(NULL);
 	}
 
+	dsMappedFileStream stream;
+	if (!dsMappedFileStream_openPath(&stream, filePath))
+	{
+		DS_LOG_ERROR_F(DS_RENDER_LOG_TAG, "Couldn't open scene resources file '%s'.", filePath);
+		DS_PROFILE_FUNC_RETURN(NULL);
+	}
+
+	// Load directly from the mapped file rather than copying it to a separate buffer.
+	size_t size;
+	const void* buffer = dsMappedFileStream_getBuffer(&stream, &size);
+	DS_ASSERT(buffer);
+
 	dsFileRelativePath fileInfo = {baseDirectory};
 	dsSceneResources* resources = dsSceneResources_loadImpl(allocator, resourceAllocator,
 		loadContext, scratchData, buffer, size, filePath, &fileInfo, &dsFileRelativePath_open,
 		&dsFileRelativePath_close);
-	DS_VERIFY(dsSceneLoadScratchData_freeReadBuffer(scratchData, buffer));
+	DS_VERIFY(dsMappedFileStream_close(&stream));
 	DS_PROFILE_FUNC_RETURN(resources);
 }
 
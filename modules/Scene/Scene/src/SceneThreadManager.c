@@ -31,6 +31,8 @@
 #include <DeepSea/Core/Log.h>
 #include <DeepSea/Core/Profile.h>
 
+#include <DeepSea/Math/Core.h>
+
 #include <DeepSea/Render/Resources/Framebuffer.h>
 #include <DeepSea/Render/Resources/GfxFormat.h>
 #include <DeepSea/Render/Resources/Renderbuffer.h>
@@ -47,6 +49,9 @@
 #include <string.h>
 
 #define MAX_TASKS 100
+// Minimum number of items for each range when committing item lists in ranges.
+#define MIN_COMMIT_RANGE_SIZE 128
+#define NO_COMMIT_RANGE ((uint32_t)-1)
 
 // Keep to 32 bytes on a 64-bit system to ensure cache friendliness.
 typedef struct CommandBufferInfo
@@ -65,6 +70,21 @@ typedef struct TaskData
 	CommandBufferInfo* commandBufferInfo;
 } TaskData;
 
+typedef struct CommitRangeTaskData
+{
+	dsSceneThreadManager* threadManager;
+	dsCommandBuffer* commandBuffer;
+	uint32_t commandBufferInfo;
+	uint32_t start;
+	uint32_t count;
+} CommitRangeTaskData;
+
+typedef struct CommitRanges
+{
+	uint32_t firstTask;
+	uint32_t taskCount;
+} CommitRanges;
+
 typedef struct ThreadCommandBufferPools
 {
 	dsCommandBufferPool* computeCommandBuffers;
@@ -93,6 +113,18 @@ struct dsSceneThreadManager
 	uint32_t maxTaskData;
 	uint32_t nextCommandBuffer;
 
+	// Range tasks for each command buffer info. firstTask is NO_COMMIT_RANGE if not committed in
+	// ranges.
+	CommitRanges* commitRanges;
+	uint32_t maxCommitRanges;
+
+	// Each item list committed in ranges reserves maxRangesPerList tasks up front so that ranges
+	// can be queued from within the tasks.
+	CommitRangeTaskData* commitRangeTasks;
+	uint32_t commitRangeTaskCount;
+	uint32_t maxCommitRangeTasks;
+	uint32_t maxRangesPerList;
+
 	const dsView* curView;
 	const dsViewFramebufferInfo* curFramebufferInfos;
 	const dsRotatedFramebuffer* curFramebuffers;
@@ -193,10 +225,113 @@ static void setupRenderPassParams(dsViewRenderPassParams* outParams,
 	outParams->scissor.max.y *= height;
 }
 
-static bool processCommandBufferRenderPass(dsCommandBuffer* commandBuffer,
-	const dsView* view, dsSceneItemList* itemList, const dsViewRenderPassParams* renderPassParams,
-	const dsFramebuffer* framebuffer)
+static void commitRangeTaskFunc(void* userData)
+{
+	CommitRangeTaskData* taskData = (CommitRangeTaskData*)userData;
+	dsSceneThreadManager* threadManager = taskData->threadManager;
+	const CommandBufferInfo* commandBufferInfo =
+		threadManager->commandBufferInfos + taskData->commandBufferInfo;
+	const dsView* view = threadManager->curView;
+	dsSceneItemList* itemList = commandBufferInfo->itemList;
+	DS_ASSERT(itemList->type->commitRangeFunc);
+	const dsSceneRenderPass* renderPass = commandBufferInfo->renderPass;
+	DS_ASSERT(renderPass);
+
+	dsCommandBuffer* commandBuffer = getSubpassCommandBuffer(threadManager);
+	if (!commandBuffer)
+		return;
+
+	const dsRotatedFramebuffer* framebuffer =
+		threadManager->curFramebuffers + commandBufferInfo->framebuffer;
+	const dsViewFramebufferInfo *framebufferInfo =
+		threadManager->curFramebufferInfos + commandBufferInfo->framebuffer;
+
+	dsViewRenderPassParams renderPassParams;
+	setupRenderPassParams(&renderPassParams, view, framebuffer, framebufferInfo,
+		renderPass->renderPass, commandBufferInfo->subpass);
+	if (!dsCommandBuffer_beginSecondary(commandBuffer, framebuffer->framebuffer,
+			renderPassParams.renderPass, renderPassParams.subpass, &renderPassParams.viewport,
+			&renderPassParams.scissor, dsGfxOcclusionQueryState_Disabled))
+	{
+		return;
+	}
+
+	DS_PROFILE_DYNAMIC_SCOPE_START(itemList->name);
+	itemList->type->commitRangeFunc(itemList, view, commandBuffer, &renderPassParams,
+		taskData->start, taskData->count);
+	DS_PROFILE_SCOPE_END();
+
+	DS_VERIFY(dsCommandBuffer_end(commandBuffer));
+	taskData->commandBuffer = commandBuffer;
+}
+
+static void queueCommitRanges(
+	dsSceneThreadManager* threadManager, uint32_t commandBufferIndex, uint32_t itemCount)
+{
+	CommitRanges* commitRanges = threadManager->commitRanges + commandBufferIndex;
+	DS_ASSERT(commitRanges->firstTask != NO_COMMIT_RANGE);
+	if (itemCount == 0)
+		return;
+
+	// Split the items into ranges, limited by the number of threads that can process them.
+	uint32_t rangeCount = dsMin((itemCount + MIN_COMMIT_RANGE_SIZE - 1)/MIN_COMMIT_RANGE_SIZE,
+		threadManager->maxRangesPerList);
+	CommitRangeTaskData* rangeTasks = threadManager->commitRangeTasks + commitRanges->firstTask;
+	uint32_t start = 0;
+	for (uint32_t i = 0; i < rangeCount; ++i)
+	{
+		uint32_t end = (uint32_t)(((uint64_t)itemCount*(i + 1))/rangeCount);
+		CommitRangeTaskData* taskData = rangeTasks + i;
+		taskData->threadManager = threadManager;
+		taskData->commandBuffer = NULL;
+		taskData->commandBufferInfo = commandBufferIndex;
+		taskData->start = start;
+		taskData->count = end - start;
+		start = end;
+	}
+	commitRanges->taskCount = rangeCount;
+
+	// Queue the remaining ranges from within the current task so they run alongside the other
+	// item lists, then commit the first range on this thread. They are all waited on together.
+	uint32_t taskCount = 0;
+	dsThreadTask tasks[MAX_TASKS];
+	for (uint32_t i = 1; i < rangeCount; ++i)
+	{
+		dsThreadTask* task = tasks + (taskCount++);
+		task->taskFunc = &commitRangeTaskFunc;
+		task->userData = rangeTasks + i;
+		if (taskCount == MAX_TASKS)
+		{
+			DS_VERIFY(dsThreadTaskQueue_addTasks(threadManager->taskQueue, tasks, taskCount));
+			taskCount = 0;
+		}
+	}
+
+	if (taskCount > 0)
+		DS_VERIFY(dsThreadTaskQueue_addTasks(threadManager->taskQueue, tasks, taskCount));
+	commitRangeTaskFunc(rangeTasks);
+}
+
+static bool processCommandBufferRenderPass(dsSceneThreadManager* threadManager,
+	uint32_t commandBufferIndex, const dsView* view, dsSceneItemList* itemList,
+	const dsViewRenderPassParams* renderPassParams, const dsFramebuffer* framebuffer)
 {
+	const dsSceneItemListType* itemListType = itemList->type;
+	if (itemListType->commitRangeFunc)
+	{
+		DS_ASSERT(itemListType->prepareCommitRangesFunc);
+		DS_PROFILE_DYNAMIC_SCOPE_START(itemList->name);
+		uint32_t itemCount =
+			itemListType->prepareCommitRangesFunc(itemList, view, renderPassParams);
+		DS_PROFILE_SCOPE_END();
+		queueCommitRanges(threadManager, commandBufferIndex, itemCount);
+		return true;
+	}
+
+	dsCommandBuffer* commandBuffer = getSubpassCommandBuffer(threadManager);
+	if (!commandBuffer)
+		return false;
+
 	if (!dsCommandBuffer_beginSecondary(commandBuffer, framebuffer, renderPassParams->renderPass,
 			renderPassParams->subpass, &renderPassParams->viewport, &renderPassParams->scissor,
 			dsGfxOcclusionQueryState_Disabled))
@@ -205,10 +340,11 @@ static bool processCommandBufferRenderPass(dsCommandBuffer* commandBuffer,
 	}
 
 	DS_PROFILE_DYNAMIC_SCOPE_START(itemList->name);
-	itemList->type->commitFunc(itemList, view, commandBuffer, renderPassParams);
+	itemListType->commitFunc(itemList, view, commandBuffer, renderPassParams);
 	DS_PROFILE_SCOPE_END();
 
 	DS_VERIFY(dsCommandBuffer_end(commandBuffer));
+	threadManager->commandBufferInfos[commandBufferIndex].commandBuffer = commandBuffer;
 	return true;
 }
 
@@ -224,10 +360,6 @@ static void taskFunc(void* userData)
 	dsSceneRenderPass* renderPass = commandBufferInfo->renderPass;
 	if (renderPass)
 	{
-		dsCommandBuffer* commandBuffer = getSubpassCommandBuffer(threadManager);
-		if (!commandBuffer)
-			return;
-
 		const dsRotatedFramebuffer* framebuffer =
 			threadManager->curFramebuffers + commandBufferInfo->framebuffer;
 		const dsViewFramebufferInfo *framebufferInfo =
@@ -239,9 +371,9 @@ static void taskFunc(void* userData)
 
 		// If the render pass has a pre render pass call, it would have been handled then.
 		DS_ASSERT(!itemListType->preRenderPassFunc || itemList->skipPreRenderPass);
-		processCommandBufferRenderPass(
-			commandBuffer, view, itemList, &renderPassParams, framebuffer->framebuffer);
-		commandBufferInfo->commandBuffer = commandBuffer;
+		processCommandBufferRenderPass(threadManager,
+			(uint32_t)(commandBufferInfo - threadManager->commandBufferInfos), view, itemList,
+			&renderPassParams, framebuffer->framebuffer);
 	}
 	else
 	{
@@ -275,13 +407,8 @@ static void taskFunc(void* userData)
 
 			// Immediately process the corresponding render pass command buffer to avoid
 			// thread synchronization issues.
-			commandBuffer = getSubpassCommandBuffer(threadManager);
-			if (!commandBuffer)
-				return;
-
-			processCommandBufferRenderPass(
-				commandBuffer, view, itemList, &renderPassParams, framebuffer->framebuffer);
-			otherCommandBufferInfo->commandBuffer = commandBuffer;
+			processCommandBufferRenderPass(threadManager, commandBufferInfo->subpass, view,
+				itemList, &renderPassParams, framebuffer->framebuffer);
 		}
 		else
 		{
@@ -306,6 +433,21 @@ static void taskFunc(void* userData)
 	}
 }
 
+static void finishCommitRanges(dsSceneThreadManager* threadManager, uint32_t firstCommandBuffer)
+{
+	for (uint32_t i = firstCommandBuffer; i < threadManager->commandBufferInfoCount; ++i)
+	{
+		if (threadManager->commitRanges[i].firstTask == NO_COMMIT_RANGE)
+			continue;
+
+		dsSceneItemList* itemList = threadManager->commandBufferInfos[i].itemList;
+		dsFinishCommitSceneItemListRangesFunction finishFunc =
+			itemList->type->finishCommitRangesFunc;
+		if (finishFunc)
+			finishFunc(itemList, threadManager->curView);
+	}
+}
+
 static bool triggerThreads(dsSceneThreadManager* threadManager)
 {
 	// Pre-allocate enough memory for all tasks.
@@ -318,8 +460,40 @@ static bool triggerThreads(dsSceneThreadManager* threadManager)
 	DS_ASSERT(taskDataCount == threadManager->commandBufferInfoCount);
 	taskDataCount = 0;
 
+	uint32_t commitRangesCount = 0;
+	if (!DS_RESIZEABLE_ARRAY_ADD(threadManager->allocator, threadManager->commitRanges,
+			commitRangesCount, threadManager->maxCommitRanges,
+			threadManager->commandBufferInfoCount))
+	{
+		return false;
+	}
+
+	// Reserve the range tasks for any item lists committed in ranges.
 	uint32_t firstCommandBuffer = threadManager->nextCommandBuffer;
 	uint32_t commandBufferCount = threadManager->commandBufferInfoCount - firstCommandBuffer;
+	uint32_t firstRangeTask = threadManager->commitRangeTaskCount;
+	uint32_t rangeTaskCount = 0;
+	for (uint32_t i = 0; i < commandBufferCount; ++i)
+	{
+		const CommandBufferInfo* commandBufferInfo =
+			threadManager->commandBufferInfos + i + firstCommandBuffer;
+		CommitRanges* commitRanges = threadManager->commitRanges + i + firstCommandBuffer;
+		if (commandBufferInfo->renderPass && commandBufferInfo->itemList->type->commitRangeFunc)
+		{
+			commitRanges->firstTask = firstRangeTask + rangeTaskCount;
+			rangeTaskCount += threadManager->maxRangesPerList;
+		}
+		else
+			commitRanges->firstTask = NO_COMMIT_RANGE;
+		commitRanges->taskCount = 0;
+	}
+
+	if (rangeTaskCount > 0 && !DS_RESIZEABLE_ARRAY_ADD(threadManager->allocator,
+			threadManager->commitRangeTasks, threadManager->commitRangeTaskCount,
+			threadManager->maxCommitRangeTasks, rangeTaskCount))
+	{
+		return false;
+	}
 
 	// Set up the tasks for each command buffer.
 	bool didQueue = false;
@@ -363,8 +537,12 @@ static bool triggerThreads(dsSceneThreadManager* threadManager)
 		DS_VERIFY(dsThreadTaskQueue_addTasks(threadManager->taskQueue, tasks, taskCount));
 	}
 
-	if (didQueue)
+	// Ranges may have been queued even when executing a single task.
+	if (didQueue || rangeTaskCount > 0)
 		DS_VERIFY(dsThreadTaskQueue_waitForTasks(threadManager->taskQueue));
+
+	if (rangeTaskCount > 0)
+		finishCommitRanges(threadManager, firstCommandBuffer);
 	threadManager->nextCommandBuffer = threadManager->commandBufferInfoCount;
 	return true;
 }
@@ -554,7 +732,8 @@ static bool submitCommandBuffers(
 	for (uint32_t i = 0; i < threadManager->commandBufferInfoCount; ++i)
 	{
 		CommandBufferInfo* commandBufferInfo = threadManager->commandBufferInfos + i;
-		if (!commandBufferInfo->commandBuffer)
+		const CommitRanges* commitRanges = threadManager->commitRanges + i;
+		if (!commandBufferInfo->commandBuffer && commitRanges->taskCount == 0)
 			continue;
 
 		if (commandBufferInfo->renderPass != prevRenderPass ||
@@ -609,12 +788,25 @@ static bool submitCommandBuffers(
 			prevSubpass = commandBufferInfo->subpass;
 		}
 
-		if (!dsCommandBuffer_submit(commandBuffer, commandBufferInfo->commandBuffer))
+		if (commandBufferInfo->commandBuffer &&
+			!dsCommandBuffer_submit(commandBuffer, commandBufferInfo->commandBuffer))
 		{
 			if (prevRenderPass)
 				dsRenderPass_end(prevRenderPass->renderPass, commandBuffer);
 			return false;
 		}
+
+		for (uint32_t j = 0; j < commitRanges->taskCount; ++j)
+		{
+			dsCommandBuffer* rangeCommandBuffer =
+				threadManager->commitRangeTasks[commitRanges->firstTask + j].commandBuffer;
+			if (rangeCommandBuffer && !dsCommandBuffer_submit(commandBuffer, rangeCommandBuffer))
+			{
+				if (prevRenderPass)
+					dsRenderPass_end(prevRenderPass->renderPass, commandBuffer);
+				return false;
+			}
+		}
 	}
 
 	if (prevRenderPass && !dsRenderPass_end(prevRenderPass->renderPass, commandBuffer))
@@ -674,6 +866,9 @@ bool dsSceneThreadManager_draw(dsSceneThreadManager* threadManager, const dsView
 	dsRenderer* renderer = scene->renderer;
 
 	threadManager->commandBufferInfoCount = 0;
+	threadManager->commitRangeTaskCount = 0;
+	threadManager->maxRangesPerList =
+		dsThreadPool_getThreadCountUnlocked(threadManager->threadPool) + 1;
 	threadManager->curView = view;
 	threadManager->curFramebufferInfos = framebufferInfos;
 	threadManager->curFramebuffers = framebuffers;
@@ -780,6 +975,8 @@ bool dsSceneThreadManager_destroy(dsSceneThreadManager* threadManager)
 	DS_VERIFY(dsAllocator_free(threadManager->allocator, threadManager->commandBufferPools));
 	DS_VERIFY(dsAllocator_free(threadManager->allocator, threadManager->commandBufferInfos));
 	DS_VERIFY(dsAllocator_free(threadManager->allocator, threadManager->taskData));
+	DS_VERIFY(dsAllocator_free(threadManager->allocator, threadManager->commitRanges));
+	DS_VERIFY(dsAllocator_free(threadManager->allocator, threadManager->commitRangeTasks));
 	DS_VERIFY(dsAllocator_free(threadManager->allocator, threadManager));
 	return true;
 }
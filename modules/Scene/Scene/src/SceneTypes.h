@@ -29,6 +29,8 @@ extern "C"
 #define DS_MAX_SCENE_TYPES 128
 #define DS_SCENE_TYPE_TABLE_SIZE 173
 
+typedef struct dsSceneParallelUpdate dsSceneParallelUpdate;
+
 typedef struct dsSceneTreeRootNode
 {
 	dsSceneTreeNode node;
@@ -66,6 +68,8 @@ struct dsScene
 	uint32_t dirtyNodeCount;
 	uint32_t maxDirtyNodes;
 
+	dsSceneParallelUpdate* parallelUpdate;
+
 	dsSceneTick lastUpdateTick;
 };
 
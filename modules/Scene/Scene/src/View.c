@@ -25,7 +25,7 @@
 #include <DeepSea/Core/Memory/Allocator.h>
 #include <DeepSea/Core/Memory/BufferAllocator.h>
 #include <DeepSea/Core/Streams/FileArchive.h>
-#include <DeepSea/Core/Streams/FileStream.h>
+#include <DeepSea/Core/Streams/MappedFileStream.h>
 #include <DeepSea/Core/Streams/ResourceStream.h>
 #include <DeepSea/Core/Streams/Stream.h>
 #include <DeepSea/Core/Thread/Spinlock.h>
@@ -681,23 +681,22 @@ dsView* dsView_loadFile(dsAllocator* allocator, const char* name, const dsScene*
 	if (!resourceAllocator)
 		resourceAllocator = allocator;
 
-	dsFileStream stream;
-	if (!dsFileStream_openPath(&stream, filePath, "rb"))
+	dsMappedFileStream stream;
+	if (!dsMappedFileStream_openPath(&stream, filePath))
 	{
 		DS_LOG_ERROR_F(DS_RENDER_LOG_TAG, "Couldn't open view file '%s'.", filePath);
 		DS_PROFILE_FUNC_RETURN(NULL);
 	}
 
+	// Load directly from the mapped file rather than copying it to a separate buffer.
 	size_t size;
-	void* buffer = dsSceneLoadScratchData_readUntilEnd(&size, scratchData, (dsStream*)&stream);
-	dsFileStream_close(&stream);
-	if (!buffer)
-		DS_PROFILE_FUNC_RETURN(NULL);
+	const void* buffer = dsMappedFileStream_getBuffer(&stream, &size);
+	DS_ASSERT(buffer);
 
 	dsView* view = dsView_loadImpl(allocator, name, scene, resourceAllocator, scratchData, buffer,
 		size, surfaces, surfaceCount, width, height, rotation, userData, destroyUserDataFunc,
 		filePath);
-	DS_VERIFY(dsSceneLoadScratchData_freeReadBuffer(scratchData, buffer));
+	DS_VERIFY(dsMappedFileStream_close(&stream));
 	DS_PROFILE_FUNC_RETURN(view);
 }
 
@@ -0,0 +1,1117 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FixtureBase.h"
+
+#include <DeepSea/Core/Timer.h>
+
+#include <DeepSea/Math/Core.h>
+#include <DeepSea/Math/Matrix33.h>
+#include <DeepSea/Math/Matrix44.h>
+#include <DeepSea/Math/Vector3.h>
+
+#include <DeepSea/Render/Resources/DrawGeometry.h>
+#include <DeepSea/Render/Resources/Framebuffer.h>
+#include <DeepSea/Render/Resources/GfxBuffer.h>
+#include <DeepSea/Render/Resources/GfxFormat.h>
+#include <DeepSea/Render/Resources/Material.h>
+#include <DeepSea/Render/Resources/MaterialDesc.h>
+#include <DeepSea/Render/Resources/Shader.h>
+#include <DeepSea/Render/Resources/ShaderModule.h>
+#include <DeepSea/Render/Resources/ShaderVariableGroupDesc.h>
+#include <DeepSea/Render/Resources/SharedMaterialValues.h>
+#include <DeepSea/Render/Resources/VertexFormat.h>
+#include <DeepSea/Render/RenderPass.h>
+#include <DeepSea/Render/RenderSurface.h>
+
+#include <DeepSea/Scene/ItemLists/SceneIndirectModelList.h>
+#include <DeepSea/Scene/ItemLists/SceneInstanceVariables.h>
+#include <DeepSea/Scene/ItemLists/SceneItemList.h>
+#include <DeepSea/Scene/ItemLists/SceneModelList.h>
+#include <DeepSea/Scene/Nodes/SceneModelNode.h>
+#include <DeepSea/Scene/Nodes/SceneNode.h>
+#include <DeepSea/Scene/Nodes/SceneNodeItemData.h>
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+
+// Enable to run performance tests.
+#define DS_PERFORMANCE_TESTS 0
+
+namespace
+{
+
+const uint32_t nodeCount = 10;
+
+std::vector<uint32_t> drawInstanceCounts;
+std::vector<uint32_t> drawFirstVertices;
+std::vector<uint32_t> indirectDrawCounts;
+uint32_t dispatchCount;
+
+const char* const instancedTransformName = "InstancedTransform";
+dsUpdateShaderInstanceValuesFunction updateShaderInstanceValues;
+std::vector<std::pair<size_t, size_t>> boundInstanceRanges;
+
+// GPU-only buffers can't be read back from the mock, so keep a copy of the uploaded data.
+dsCopyGfxBufferDataFunction copyBufferData;
+std::map<const dsGfxBuffer*, std::vector<uint8_t>> bufferContents;
+
+bool countDraw(dsRenderer*, dsCommandBuffer*, const dsDrawGeometry*, const dsDrawRange* drawRange,
+	dsPrimitiveType)
+{
+	drawInstanceCounts.push_back(drawRange->instanceCount);
+	drawFirstVertices.push_back(drawRange->firstVertex);
+	return true;
+}
+
+bool countIndirectDraw(dsRenderer*, dsCommandBuffer*, const dsDrawGeometry*, const dsGfxBuffer*,
+	size_t, uint32_t count, uint32_t, dsPrimitiveType)
+{
+	indirectDrawCounts.push_back(count);
+	return true;
+}
+
+bool countDispatch(dsRenderer*, dsCommandBuffer*, uint32_t, uint32_t, uint32_t)
+{
+	++dispatchCount;
+	return true;
+}
+
+bool recordInstanceValues(dsResourceManager* resourceManager, dsCommandBuffer* commandBuffer,
+	const dsShader* shader, const dsSharedMaterialValues* instanceValues)
+{
+	size_t offset, size;
+	if (dsSharedMaterialValues_getBufferID(&offset, &size, instanceValues,
+			dsUniqueNameID_get(instancedTransformName)))
+	{
+		boundInstanceRanges.emplace_back(offset, size);
+	}
+	return updateShaderInstanceValues(resourceManager, commandBuffer, shader, instanceValues);
+}
+
+bool recordBufferData(dsResourceManager* resourceManager, dsCommandBuffer* commandBuffer,
+	dsGfxBuffer* buffer, size_t offset, const void* data, size_t size)
+{
+	std::vector<uint8_t>& contents = bufferContents[buffer];
+	if (contents.size() < offset + size)
+		contents.resize(offset + size);
+	std::memcpy(contents.data() + offset, data, size);
+	return copyBufferData(resourceManager, commandBuffer, buffer, offset, data, size);
+}
+
+template <typename T>
+std::vector<T> getBufferContents(const dsMaterial* material, const dsMaterialDesc* materialDesc,
+	const char* name)
+{
+	size_t offset, size;
+	const dsGfxBuffer* buffer = dsMaterial_getBuffer(&offset, &size, material,
+		dsMaterialDesc_findElement(materialDesc, name));
+	auto foundContents = bufferContents.find(buffer);
+	if (!buffer || foundContents == bufferContents.end() ||
+		foundContents->second.size() < offset + size)
+	{
+		return std::vector<T>();
+	}
+
+	std::vector<T> values(size/sizeof(T));
+	std::memcpy(values.data(), foundContents->second.data() + offset, values.size()*sizeof(T));
+	return values;
+}
+
+// Same as the cull in IndirectCull.mslh, except without the frustum check.
+void cullIndirectInstances(std::vector<dsDrawIndexedRange>& drawArgs,
+	std::vector<uint32_t>& visibleInstances,
+	const std::vector<dsSceneIndirectInstance>& instances, const dsVector3f& cameraPos)
+{
+	for (uint32_t i = 0; i < instances.size(); ++i)
+	{
+		const dsSceneIndirectInstance& instance = instances[i];
+		const dsVector2f& distanceRange = instance.distanceRange;
+		if (distanceRange.x <= distanceRange.y)
+		{
+			float distance = dsSqrtf(dsVector3_dist2(instance.transform.columns[3], cameraPos));
+			if (distance < distanceRange.x || distance >= distanceRange.y)
+				continue;
+		}
+
+		dsDrawIndexedRange& draw = drawArgs[instance.drawIndex];
+		visibleInstances[draw.firstInstance + draw.instanceCount++] = i;
+	}
+}
+
+void populateInstances(void*, const dsView*, const dsViewRenderPassParams*,
+	const dsSceneTreeNode* const*, uint32_t, const dsShaderVariableGroupDesc*, uint8_t*, uint32_t)
+{
+}
+
+dsSceneInstanceVariablesType instanceVariablesType = {&populateInstances, nullptr, nullptr,
+	nullptr};
+
+} // namespace
+
+class SceneModelListTest : public FixtureBase
+{
+public:
+	void SetUp() override
+	{
+		FixtureBase::SetUp();
+		drawInstanceCounts.clear();
+		drawFirstVertices.clear();
+		indirectDrawCounts.clear();
+		boundInstanceRanges.clear();
+		dispatchCount = 0;
+		renderer->drawFunc = &countDraw;
+		renderer->drawIndexedIndirectFunc = &countIndirectDraw;
+		renderer->dispatchComputeFunc = &countDispatch;
+		updateShaderInstanceValues = resourceManager->updateShaderInstanceValuesFunc;
+		resourceManager->updateShaderInstanceValuesFunc = &recordInstanceValues;
+		bufferContents.clear();
+		copyBufferData = resourceManager->copyBufferDataFunc;
+		resourceManager->copyBufferDataFunc = &recordBufferData;
+
+		dsAttachmentInfo attachment = {dsAttachmentUsage_KeepAfter, renderer->surfaceColorFormat,
+			DS_DEFAULT_ANTIALIAS_SAMPLES};
+		dsAttachmentRef colorAttachment = {0, true};
+		dsRenderSubpassInfo subpass =
+			{"test", nullptr, &colorAttachment, {DS_NO_ATTACHMENT, false}, 0, 1};
+		renderPass = dsRenderPass_create(renderer, nullptr, &attachment, 1, &subpass, 1, nullptr,
+			0);
+		ASSERT_TRUE(renderPass);
+
+		renderSurface = dsRenderSurface_create(renderer, nullptr, "test", nullptr, nullptr,
+			dsRenderSurfaceType_Direct, dsRenderSurfaceUsage_Standard, 1920, 1080);
+		ASSERT_TRUE(renderSurface);
+
+		dsFramebufferSurface surface =
+			{dsGfxSurfaceType_ColorRenderSurface, dsCubeFace_None, 0, 0, renderSurface};
+		framebuffer = dsFramebuffer_create(resourceManager, nullptr, "test", &surface, 1,
+			renderSurface->width, renderSurface->height, 1);
+		ASSERT_TRUE(framebuffer);
+
+		dsShaderVariableElement transformElements[] =
+		{
+			{"modelViewProjection", dsMaterialType_Mat4, 0},
+			{"normalMat", dsMaterialType_Mat3, 0}
+		};
+		transformDesc = dsShaderVariableGroupDesc_create(resourceManager, nullptr,
+			transformElements, DS_ARRAY_SIZE(transformElements));
+		ASSERT_TRUE(transformDesc);
+
+		dsMaterialElement elements[] =
+		{
+			{"diffuseTexture", dsMaterialType_Texture, 0, nullptr, dsMaterialBinding_Material, 0},
+			{"colorMultiplier", dsMaterialType_Vec4, 0, nullptr, dsMaterialBinding_Material, 0},
+			{"textureScaleOffset", dsMaterialType_Vec2, 2, nullptr, dsMaterialBinding_Material,
+				0},
+			{"Transform", dsMaterialType_VariableGroup, 0, transformDesc,
+				dsMaterialBinding_Instance, 0}
+		};
+		materialDesc = dsMaterialDesc_create(resourceManager, nullptr, elements,
+			DS_ARRAY_SIZE(elements));
+		ASSERT_TRUE(materialDesc);
+
+		shaderModule = dsShaderModule_loadFile(resourceManager, nullptr, DS_SCENE_TEST_SHADER,
+			"test");
+		ASSERT_TRUE(shaderModule);
+		shader = dsShader_createName(resourceManager, nullptr, shaderModule, "Test", materialDesc);
+		ASSERT_TRUE(shader);
+
+		material1 = dsMaterial_create(resourceManager, nullptr, materialDesc);
+		ASSERT_TRUE(material1);
+		material2 = dsMaterial_create(resourceManager, nullptr, materialDesc);
+		ASSERT_TRUE(material2);
+
+		dsMaterialElement instancedElements[] =
+		{
+			{"diffuseTexture", dsMaterialType_Texture, 0, nullptr, dsMaterialBinding_Material, 0},
+			{"colorMultiplier", dsMaterialType_Vec4, 0, nullptr, dsMaterialBinding_Material, 0},
+			{"textureScaleOffset", dsMaterialType_Vec2, 2, nullptr, dsMaterialBinding_Material,
+				0},
+			{"Transform", dsMaterialType_VariableGroup, 0, transformDesc,
+				dsMaterialBinding_Material, 0},
+			{instancedTransformName, dsMaterialType_UniformBuffer, 0, nullptr,
+				dsMaterialBinding_Instance, 0}
+		};
+		instancedMaterialDesc = dsMaterialDesc_create(resourceManager, nullptr, instancedElements,
+			DS_ARRAY_SIZE(instancedElements));
+		ASSERT_TRUE(instancedMaterialDesc);
+
+		instancedShader = dsShader_createName(resourceManager, nullptr, shaderModule, "Test",
+			instancedMaterialDesc);
+		ASSERT_TRUE(instancedShader);
+
+		instancedMaterial1 = dsMaterial_create(resourceManager, nullptr, instancedMaterialDesc);
+		ASSERT_TRUE(instancedMaterial1);
+		instancedMaterial2 = dsMaterial_create(resourceManager, nullptr, instancedMaterialDesc);
+		ASSERT_TRUE(instancedMaterial2);
+
+		vertexGfxBuffer = dsGfxBuffer_create(resourceManager, nullptr, dsGfxBufferUsage_Vertex,
+			dsGfxMemory_Static | dsGfxMemory_Draw, nullptr, 1024);
+		ASSERT_TRUE(vertexGfxBuffer);
+
+		dsVertexBuffer vertexBuffer = {};
+		ASSERT_TRUE(dsVertexFormat_initialize(&vertexBuffer.format));
+		EXPECT_TRUE(dsVertexFormat_setAttribEnabled(&vertexBuffer.format,
+			dsVertexAttrib_Position, true));
+		vertexBuffer.format.elements[dsVertexAttrib_Position].format =
+			dsGfxFormat_decorate(dsGfxFormat_X32Y32Z32, dsGfxFormat_Float);
+		EXPECT_TRUE(dsVertexFormat_computeOffsetsAndSize(&vertexBuffer.format));
+		vertexBuffer.buffer = vertexGfxBuffer;
+		vertexBuffer.offset = 0;
+		vertexBuffer.count = nodeCount + 2;
+
+		dsVertexBuffer* vertexBuffers[DS_MAX_GEOMETRY_VERTEX_BUFFERS] = {&vertexBuffer};
+		geometry = dsDrawGeometry_create(resourceManager, nullptr, vertexBuffers, nullptr);
+		ASSERT_TRUE(geometry);
+
+		indexGfxBuffer = dsGfxBuffer_create(resourceManager, nullptr, dsGfxBufferUsage_Index,
+			dsGfxMemory_Static | dsGfxMemory_Draw, nullptr, 1024);
+		ASSERT_TRUE(indexGfxBuffer);
+
+		dsIndexBuffer indexBuffer = {indexGfxBuffer, 0, 3, sizeof(uint16_t)};
+		indexedGeometry = dsDrawGeometry_create(resourceManager, nullptr, vertexBuffers,
+			&indexBuffer);
+		ASSERT_TRUE(indexedGeometry);
+	}
+
+	void TearDown() override
+	{
+		EXPECT_TRUE(dsDrawGeometry_destroy(indexedGeometry));
+		EXPECT_TRUE(dsDrawGeometry_destroy(geometry));
+		EXPECT_TRUE(dsGfxBuffer_destroy(indexGfxBuffer));
+		EXPECT_TRUE(dsGfxBuffer_destroy(vertexGfxBuffer));
+		dsMaterial_destroy(instancedMaterial1);
+		dsMaterial_destroy(instancedMaterial2);
+		EXPECT_TRUE(dsShader_destroy(instancedShader));
+		EXPECT_TRUE(dsMaterialDesc_destroy(instancedMaterialDesc));
+		dsMaterial_destroy(material1);
+		dsMaterial_destroy(material2);
+		EXPECT_TRUE(dsShader_destroy(shader));
+		EXPECT_TRUE(dsShaderModule_destroy(shaderModule));
+		EXPECT_TRUE(dsMaterialDesc_destroy(materialDesc));
+		EXPECT_TRUE(dsShaderVariableGroupDesc_destroy(transformDesc));
+		EXPECT_TRUE(dsFramebuffer_destroy(framebuffer));
+		EXPECT_TRUE(dsRenderSurface_destroy(renderSurface));
+		EXPECT_TRUE(dsRenderPass_destroy(renderPass));
+		FixtureBase::TearDown();
+	}
+
+	dsSceneModelList* createModelList(const char* const* cullLists = nullptr,
+		uint32_t cullListCount = 0)
+	{
+		dsSceneInstanceData* instanceData = dsSceneInstanceVariables_create(
+			&allocator.allocator, resourceManager, nullptr, transformDesc,
+			dsUniqueNameID_create("Transform"), &instanceVariablesType, nullptr);
+		if (!instanceData)
+			return nullptr;
+
+		return dsSceneModelList_create(&allocator.allocator, "models", nullptr, &instanceData, 1,
+			dsModelSortType_Material, nullptr, cullLists, cullListCount);
+	}
+
+	dsSceneModelList* createInstancedModelList()
+	{
+		dsSceneInstanceData* instanceData = dsSceneInstanceVariables_createInstanced(
+			&allocator.allocator, resourceManager, nullptr, transformDesc,
+			dsUniqueNameID_create(instancedTransformName), &instanceVariablesType, nullptr);
+		if (!instanceData)
+			return nullptr;
+
+		return dsSceneModelList_create(&allocator.allocator, "models", nullptr, &instanceData, 1,
+			dsModelSortType_Material, nullptr, nullptr, 0);
+	}
+
+	dsSceneModelNode* createModelNode(dsMaterial* material, uint32_t firstVertex = 0)
+	{
+		dsSceneModelDrawRange drawRange;
+		drawRange.drawRange.vertexCount = 3;
+		drawRange.drawRange.instanceCount = 1;
+		drawRange.drawRange.firstVertex = firstVertex;
+		drawRange.drawRange.firstInstance = 0;
+		return createModelNode(shader, material, geometry, drawRange);
+	}
+
+	dsSceneModelNode* createInstancedModelNode(dsMaterial* material)
+	{
+		dsSceneModelDrawRange drawRange;
+		drawRange.drawRange.vertexCount = 3;
+		drawRange.drawRange.instanceCount = 1;
+		drawRange.drawRange.firstVertex = 0;
+		drawRange.drawRange.firstInstance = 0;
+		return createModelNode(instancedShader, material, geometry, drawRange);
+	}
+
+	dsSceneModelNode* createIndexedModelNode(dsShader* modelShader, dsMaterial* material)
+	{
+		dsSceneModelDrawRange drawRange;
+		drawRange.drawIndexedRange.indexCount = 3;
+		drawRange.drawIndexedRange.instanceCount = 1;
+		drawRange.drawIndexedRange.firstIndex = 0;
+		drawRange.drawIndexedRange.vertexOffset = 0;
+		drawRange.drawIndexedRange.firstInstance = 0;
+		return createModelNode(modelShader, material, indexedGeometry, drawRange);
+	}
+
+	dsSceneModelNode* createModelNode(dsShader* modelShader, dsMaterial* material,
+		dsDrawGeometry* modelGeometry, const dsSceneModelDrawRange& drawRange,
+		const char* const* extraItemLists = nullptr, uint32_t extraItemListCount = 0)
+	{
+		dsSceneModelInitInfo model = {};
+		model.shader = modelShader;
+		model.material = material;
+		model.geometry = modelGeometry;
+		model.distanceRange.x = 0.0f;
+		model.distanceRange.y = -1.0f;
+		model.drawRanges = &drawRange;
+		model.drawRangeCount = 1;
+		model.primitiveType = dsPrimitiveType_TriangleList;
+		model.modelList = "models";
+		return dsSceneModelNode_create(&allocator.allocator, &model, 1, extraItemLists,
+			extraItemListCount, nullptr, 0, nullptr);
+	}
+
+	static void initView(dsView& view)
+	{
+		view = {};
+		dsMatrix44_identity(view.cameraMatrix);
+		view.lodBias = 1.0f;
+	}
+
+	void draw(dsSceneItemList* itemList)
+	{
+		dsView view;
+		initView(view);
+		draw(itemList, view);
+	}
+
+	void draw(dsSceneItemList* itemList, const dsView& view)
+	{
+		dsViewRenderPassParams renderPassParams = {};
+		renderPassParams.framebufferWidth = framebuffer->width;
+		renderPassParams.framebufferHeight = framebuffer->height;
+		renderPassParams.renderPass = renderPass;
+
+		dsCommandBuffer* commandBuffer = renderer->mainCommandBuffer;
+		if (itemList->type->preRenderPassFunc && !itemList->skipPreRenderPass)
+		{
+			itemList->type->preRenderPassFunc(itemList, &view, commandBuffer, &renderPassParams);
+		}
+		ASSERT_TRUE(dsRenderPass_begin(renderPass, commandBuffer, framebuffer, nullptr, nullptr,
+			nullptr, 0, false));
+		itemList->type->commitFunc(itemList, &view, commandBuffer, &renderPassParams);
+		EXPECT_TRUE(dsRenderPass_end(renderPass, commandBuffer));
+	}
+
+	void drawRanges(dsSceneItemList* itemList, uint32_t rangeCount)
+	{
+		dsView view = {};
+		dsMatrix44_identity(view.cameraMatrix);
+		view.lodBias = 1.0f;
+
+		dsViewRenderPassParams renderPassParams = {};
+		renderPassParams.framebufferWidth = framebuffer->width;
+		renderPassParams.framebufferHeight = framebuffer->height;
+		renderPassParams.renderPass = renderPass;
+
+		dsCommandBuffer* commandBuffer = renderer->mainCommandBuffer;
+		if (itemList->type->preRenderPassFunc && !itemList->skipPreRenderPass)
+		{
+			itemList->type->preRenderPassFunc(itemList, &view, commandBuffer, &renderPassParams);
+		}
+		uint32_t itemCount = itemList->type->prepareCommitRangesFunc(itemList, &view,
+			&renderPassParams);
+		ASSERT_TRUE(dsRenderPass_begin(renderPass, commandBuffer, framebuffer, nullptr, nullptr,
+			nullptr, 0, false));
+		uint32_t start = 0;
+		for (uint32_t i = 0; i < rangeCount; ++i)
+		{
+			uint32_t end = itemCount*(i + 1)/rangeCount;
+			itemList->type->commitRangeFunc(itemList, &view, commandBuffer, &renderPassParams,
+				start, end - start);
+			start = end;
+		}
+		EXPECT_TRUE(dsRenderPass_end(renderPass, commandBuffer));
+		if (itemList->type->finishCommitRangesFunc)
+			itemList->type->finishCommitRangesFunc(itemList, &view);
+	}
+
+	void addNodes(dsSceneItemList* itemList, dsSceneNode* const* nodes,
+		uint64_t* nodeIDs = nullptr)
+	{
+		for (uint32_t i = 0; i < nodeCount; ++i)
+		{
+			treeNodes[i] = {};
+			dsMatrix44_identity(treeNodes[i].curFrameWorldTransform);
+			treeNodes[i].curFrameWorldTransform.columns[3].x = static_cast<float>(i);
+			void* thisItemData = nullptr;
+			uint64_t nodeID = itemList->type->addNodeFunc(itemList, nodes[i], treeNodes + i,
+				&itemData, &thisItemData);
+			EXPECT_NE(DS_NO_SCENE_NODE, nodeID);
+			if (nodeIDs)
+				nodeIDs[i] = nodeID;
+		}
+	}
+
+	dsRenderPass* renderPass;
+	dsRenderSurface* renderSurface;
+	dsFramebuffer* framebuffer;
+	dsShaderVariableGroupDesc* transformDesc;
+	dsMaterialDesc* materialDesc;
+	dsShaderModule* shaderModule;
+	dsShader* shader;
+	dsMaterial* material1;
+	dsMaterial* material2;
+	dsMaterialDesc* instancedMaterialDesc;
+	dsShader* instancedShader;
+	dsMaterial* instancedMaterial1;
+	dsMaterial* instancedMaterial2;
+	dsGfxBuffer* vertexGfxBuffer;
+	dsGfxBuffer* indexGfxBuffer;
+	dsDrawGeometry* geometry;
+	dsDrawGeometry* indexedGeometry;
+
+	dsSceneTreeNode treeNodes[nodeCount];
+	dsSceneNodeItemData itemData = {};
+};
+
+TEST_F(SceneModelListTest, InstancedDrawCount)
+{
+	// Align the buffer offsets to 4 instances to check the padding between draws.
+	const uint32_t transformSize = 112;
+	resourceManager->minUniformBufferAlignment = 64;
+	dsSceneModelList* modelList = createInstancedModelList();
+	ASSERT_TRUE(modelList);
+	dsSceneItemList* itemList = reinterpret_cast<dsSceneItemList*>(modelList);
+	EXPECT_FALSE(dsSceneModelList_getInstancing(modelList));
+
+	// Interleave the materials to check that instancing is applied after sorting.
+	dsSceneNode* nodes[nodeCount];
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		nodes[i] = reinterpret_cast<dsSceneNode*>(
+			createInstancedModelNode(i % 2 == 0 ? instancedMaterial1 : instancedMaterial2));
+		ASSERT_TRUE(nodes[i]);
+	}
+	addNodes(itemList, nodes);
+
+	draw(itemList);
+	ASSERT_EQ(nodeCount, drawInstanceCounts.size());
+	for (uint32_t instanceCount : drawInstanceCounts)
+		EXPECT_EQ(1U, instanceCount);
+	ASSERT_EQ(nodeCount, boundInstanceRanges.size());
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		EXPECT_EQ(i*4*transformSize, boundInstanceRanges[i].first);
+		EXPECT_EQ(transformSize, boundInstanceRanges[i].second);
+	}
+
+	dsSceneModelList_setInstancing(modelList, true);
+	EXPECT_TRUE(dsSceneModelList_getInstancing(modelList));
+	drawInstanceCounts.clear();
+	boundInstanceRanges.clear();
+	draw(itemList);
+	ASSERT_EQ(2U, drawInstanceCounts.size());
+	EXPECT_EQ(nodeCount/2, drawInstanceCounts[0]);
+	EXPECT_EQ(nodeCount/2, drawInstanceCounts[1]);
+
+	// The second batch starts at the next multiple of 4 instances.
+	ASSERT_EQ(2U, boundInstanceRanges.size());
+	EXPECT_EQ(0U, boundInstanceRanges[0].first);
+	EXPECT_EQ(nodeCount/2*transformSize, boundInstanceRanges[0].second);
+	EXPECT_EQ(8*transformSize, boundInstanceRanges[1].first);
+	EXPECT_EQ(nodeCount/2*transformSize, boundInstanceRanges[1].second);
+
+	dsSceneItemList_destroy(itemList);
+	for (uint32_t i = 0; i < nodeCount; ++i)
+		dsSceneNode_freeRef(nodes[i]);
+}
+
+TEST_F(SceneModelListTest, NoInstanceRanges)
+{
+	// Instance variables only bind ranges when explicitly created as instanced.
+	dsSceneModelList* modelList = createModelList();
+	ASSERT_TRUE(modelList);
+	dsSceneItemList* itemList = reinterpret_cast<dsSceneItemList*>(modelList);
+	dsSceneModelList_setInstancing(modelList, true);
+
+	dsSceneNode* nodes[nodeCount];
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		nodes[i] = reinterpret_cast<dsSceneNode*>(createModelNode(material1));
+		ASSERT_TRUE(nodes[i]);
+	}
+	addNodes(itemList, nodes);
+
+	draw(itemList);
+	ASSERT_EQ(nodeCount, drawInstanceCounts.size());
+	for (uint32_t instanceCount : drawInstanceCounts)
+		EXPECT_EQ(1U, instanceCount);
+
+	dsSceneItemList_destroy(itemList);
+	for (uint32_t i = 0; i < nodeCount; ++i)
+		dsSceneNode_freeRef(nodes[i]);
+}
+
+TEST_F(SceneModelListTest, NoInstancedDrawing)
+{
+	renderer->hasInstancedDrawing = false;
+
+	dsSceneModelList* modelList = createInstancedModelList();
+	ASSERT_TRUE(modelList);
+	dsSceneItemList* itemList = reinterpret_cast<dsSceneItemList*>(modelList);
+	dsSceneModelList_setInstancing(modelList, true);
+
+	dsSceneNode* nodes[nodeCount];
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		nodes[i] = reinterpret_cast<dsSceneNode*>(createInstancedModelNode(instancedMaterial1));
+		ASSERT_TRUE(nodes[i]);
+	}
+	addNodes(itemList, nodes);
+
+	draw(itemList);
+	ASSERT_EQ(nodeCount, drawInstanceCounts.size());
+	for (uint32_t instanceCount : drawInstanceCounts)
+		EXPECT_EQ(1U, instanceCount);
+
+	dsSceneItemList_destroy(itemList);
+	for (uint32_t i = 0; i < nodeCount; ++i)
+		dsSceneNode_freeRef(nodes[i]);
+}
+
+// This only covers the mock renderer: it checks the buffers and commands the list records, and runs
+// a CPU version of the cull for the compaction. The cull shader itself hasn't been run on a real
+// device, such as lavapipe.
+TEST_F(SceneModelListTest, IndirectDraw)
+{
+	ASSERT_TRUE(dsSceneIndirectModelList_isSupported(renderer));
+
+	dsMaterialElement drawElements[] =
+	{
+		{"diffuseTexture", dsMaterialType_Texture, 0, nullptr, dsMaterialBinding_Material, 0},
+		{"colorMultiplier", dsMaterialType_Vec4, 0, nullptr, dsMaterialBinding_Material, 0},
+		{"textureScaleOffset", dsMaterialType_Vec2, 2, nullptr, dsMaterialBinding_Material, 0},
+		{"Transform", dsMaterialType_VariableGroup, 0, transformDesc, dsMaterialBinding_Material,
+			0},
+		{dsSceneIndirectModelList_instancesName, dsMaterialType_UniformBuffer, 0, nullptr,
+			dsMaterialBinding_Instance, 0},
+		{dsSceneIndirectModelList_visibleInstancesName, dsMaterialType_UniformBuffer, 0, nullptr,
+			dsMaterialBinding_Instance, 0}
+	};
+	dsMaterialDesc* drawDesc = dsMaterialDesc_create(resourceManager, nullptr, drawElements,
+		DS_ARRAY_SIZE(drawElements));
+	ASSERT_TRUE(drawDesc);
+
+	dsMaterialElement cullElements[] =
+	{
+		{"diffuseTexture", dsMaterialType_Texture, 0, nullptr, dsMaterialBinding_Material, 0},
+		{"colorMultiplier", dsMaterialType_Vec4, 0, nullptr, dsMaterialBinding_Material, 0},
+		{"textureScaleOffset", dsMaterialType_Vec2, 2, nullptr, dsMaterialBinding_Material, 0},
+		{"Transform", dsMaterialType_VariableGroup, 0, transformDesc, dsMaterialBinding_Material,
+			0},
+		{dsSceneIndirectModelList_instancesName, dsMaterialType_UniformBuffer, 0, nullptr,
+			dsMaterialBinding_Material, 0},
+		{dsSceneIndirectModelList_visibleInstancesName, dsMaterialType_UniformBuffer, 0, nullptr,
+			dsMaterialBinding_Material, 0},
+		{dsSceneIndirectModelList_drawArgsName, dsMaterialType_UniformBuffer, 0, nullptr,
+			dsMaterialBinding_Material, 0}
+	};
+	dsMaterialDesc* cullDesc = dsMaterialDesc_create(resourceManager, nullptr, cullElements,
+		DS_ARRAY_SIZE(cullElements));
+	ASSERT_TRUE(cullDesc);
+
+	dsShader* drawShader = dsShader_createName(resourceManager, nullptr, shaderModule, "Test",
+		drawDesc);
+	ASSERT_TRUE(drawShader);
+	dsShader* cullShader = dsShader_createName(resourceManager, nullptr, shaderModule, "Test",
+		cullDesc);
+	ASSERT_TRUE(cullShader);
+
+	dsMaterial* drawMaterial1 = dsMaterial_create(resourceManager, nullptr, drawDesc);
+	ASSERT_TRUE(drawMaterial1);
+	dsMaterial* drawMaterial2 = dsMaterial_create(resourceManager, nullptr, drawDesc);
+	ASSERT_TRUE(drawMaterial2);
+	dsMaterial* cullMaterial = dsMaterial_create(resourceManager, nullptr, cullDesc);
+	ASSERT_TRUE(cullMaterial);
+
+	EXPECT_FALSE(dsSceneIndirectModelList_create(&allocator.allocator, resourceManager, nullptr,
+		"models", nullptr, cullShader, drawMaterial1, nullptr));
+	EXPECT_EQ(EINVAL, errno);
+
+	dsSceneIndirectModelList* modelList = dsSceneIndirectModelList_create(&allocator.allocator,
+		resourceManager, nullptr, "models", nullptr, cullShader, cullMaterial, nullptr);
+	ASSERT_TRUE(modelList);
+	dsSceneItemList* itemList = reinterpret_cast<dsSceneItemList*>(modelList);
+
+	// Non-indexed geometry can't be drawn indirectly.
+	dsSceneModelDrawRange nonIndexedDrawRange;
+	nonIndexedDrawRange.drawRange.vertexCount = 3;
+	nonIndexedDrawRange.drawRange.instanceCount = 1;
+	nonIndexedDrawRange.drawRange.firstVertex = 0;
+	nonIndexedDrawRange.drawRange.firstInstance = 0;
+	dsSceneNode* nonIndexedNode = reinterpret_cast<dsSceneNode*>(createModelNode(drawShader,
+		drawMaterial1, geometry, nonIndexedDrawRange));
+	ASSERT_TRUE(nonIndexedNode);
+	dsSceneTreeNode nonIndexedTreeNode = {};
+	void* thisItemData = nullptr;
+	EXPECT_EQ(DS_NO_SCENE_NODE, itemList->type->addNodeFunc(itemList, nonIndexedNode,
+		&nonIndexedTreeNode, &itemData, &thisItemData));
+	dsSceneNode_freeRef(nonIndexedNode);
+
+	dsSceneNode* nodes[nodeCount];
+	for (uint32_t i = 0; i < nodeCount - 1; ++i)
+	{
+		nodes[i] = reinterpret_cast<dsSceneNode*>(createIndexedModelNode(drawShader,
+			i % 2 == 0 ? drawMaterial1 : drawMaterial2));
+		ASSERT_TRUE(nodes[i]);
+	}
+
+	// Last node has bounds and a distance range that culls it.
+	dsSceneModelDrawRange boundsDrawRange;
+	boundsDrawRange.drawIndexedRange.indexCount = 3;
+	boundsDrawRange.drawIndexedRange.instanceCount = 1;
+	boundsDrawRange.drawIndexedRange.firstIndex = 0;
+	boundsDrawRange.drawIndexedRange.vertexOffset = 0;
+	boundsDrawRange.drawIndexedRange.firstInstance = 0;
+
+	dsSceneModelInitInfo boundsModel = {};
+	boundsModel.shader = drawShader;
+	boundsModel.material = drawMaterial2;
+	boundsModel.geometry = indexedGeometry;
+	boundsModel.distanceRange.x = 0.0f;
+	boundsModel.distanceRange.y = 5.0f;
+	boundsModel.drawRanges = &boundsDrawRange;
+	boundsModel.drawRangeCount = 1;
+	boundsModel.primitiveType = dsPrimitiveType_TriangleList;
+	boundsModel.modelList = "models";
+
+	dsOrientedBox3f bounds;
+	dsMatrix33_identity(bounds.orientation);
+	bounds.center.x = 0.0f;
+	bounds.center.y = 1.0f;
+	bounds.center.z = 2.0f;
+	bounds.halfExtents.x = 1.0f;
+	bounds.halfExtents.y = 2.0f;
+	bounds.halfExtents.z = 3.0f;
+	nodes[nodeCount - 1] = reinterpret_cast<dsSceneNode*>(dsSceneModelNode_create(
+		&allocator.allocator, &boundsModel, 1, nullptr, 0, nullptr, 0, &bounds));
+	ASSERT_TRUE(nodes[nodeCount - 1]);
+
+	uint64_t nodeIDs[nodeCount];
+	addNodes(itemList, nodes, nodeIDs);
+
+	draw(itemList);
+	EXPECT_EQ(nodeCount, dsSceneIndirectModelList_getInstanceCount(modelList));
+	EXPECT_EQ(2U, dsSceneIndirectModelList_getDrawCount(modelList));
+	EXPECT_EQ(1U, dispatchCount);
+	ASSERT_EQ(2U, indirectDrawCounts.size());
+	EXPECT_EQ(1U, indirectDrawCounts[0]);
+	EXPECT_EQ(1U, indirectDrawCounts[1]);
+	EXPECT_TRUE(drawInstanceCounts.empty());
+
+	// Check the uploaded instances and draw arguments.
+	std::vector<dsSceneIndirectInstance> instances = getBufferContents<dsSceneIndirectInstance>(
+		cullMaterial, cullDesc, dsSceneIndirectModelList_instancesName);
+	std::vector<dsDrawIndexedRange> drawArgs = getBufferContents<dsDrawIndexedRange>(
+		cullMaterial, cullDesc, dsSceneIndirectModelList_drawArgsName);
+	ASSERT_EQ(nodeCount, instances.size());
+	ASSERT_EQ(2U, drawArgs.size());
+
+	uint32_t instancesPerDraw[2] = {};
+	uint32_t materialDraws[2] = {UINT32_MAX, UINT32_MAX};
+	bool foundNodes[nodeCount] = {};
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		const dsSceneIndirectInstance& instance = instances[i];
+		uint32_t node = static_cast<uint32_t>(instance.transform.columns[3].x);
+		ASSERT_GT(nodeCount, node);
+		EXPECT_FALSE(foundNodes[node]);
+		foundNodes[node] = true;
+		EXPECT_EQ(0, std::memcmp(&treeNodes[node].curFrameWorldTransform, &instance.transform,
+			sizeof(dsMatrix44f)));
+
+		// Instances are grouped by draw, which is based on the material.
+		ASSERT_GT(drawArgs.size(), instance.drawIndex);
+		uint32_t& materialDraw = materialDraws[node % 2];
+		if (materialDraw == UINT32_MAX)
+			materialDraw = instance.drawIndex;
+		EXPECT_EQ(materialDraw, instance.drawIndex);
+		const dsDrawIndexedRange& draw = drawArgs[instance.drawIndex];
+		EXPECT_LE(draw.firstInstance, i);
+		EXPECT_EQ(draw.firstInstance + instancesPerDraw[instance.drawIndex]++, i);
+
+		if (node == nodeCount - 1)
+		{
+			const dsSceneCullNode* cullNode =
+				reinterpret_cast<const dsSceneCullNode*>(nodes[node]);
+			dsMatrix44f boxMatrix;
+			dsMatrix44f_affineMul(&boxMatrix, &treeNodes[node].curFrameWorldTransform,
+				&cullNode->staticLocalBoxMatrix);
+			EXPECT_EQ(1U, instance.hasBounds);
+			EXPECT_EQ(0, std::memcmp(&boxMatrix, &instance.boxMatrix, sizeof(dsMatrix44f)));
+			EXPECT_EQ(0.0f, instance.distanceRange.x);
+			EXPECT_EQ(5.0f, instance.distanceRange.y);
+		}
+		else
+		{
+			EXPECT_EQ(0U, instance.hasBounds);
+			EXPECT_EQ(0.0f, instance.distanceRange.x);
+			EXPECT_EQ(-1.0f, instance.distanceRange.y);
+		}
+	}
+
+	for (const dsDrawIndexedRange& draw : drawArgs)
+	{
+		EXPECT_EQ(3U, draw.indexCount);
+		EXPECT_EQ(0U, draw.instanceCount);
+		EXPECT_EQ(0U, draw.firstIndex);
+		EXPECT_EQ(0, draw.vertexOffset);
+	}
+	EXPECT_NE(materialDraws[0], materialDraws[1]);
+	EXPECT_EQ(nodeCount/2, instancesPerDraw[0]);
+	EXPECT_EQ(nodeCount/2, instancesPerDraw[1]);
+
+	// Compacting the visible instances with the draw arguments should give each draw its own range
+	// of the visible instances.
+	std::vector<uint32_t> visibleInstances(nodeCount, UINT32_MAX);
+	dsVector3f cameraPos = {{0.0f, 0.0f, 0.0f}};
+	cullIndirectInstances(drawArgs, visibleInstances, instances, cameraPos);
+	uint32_t lastDraw = instances[nodeCount - 1].drawIndex;
+	EXPECT_EQ(nodeCount/2, drawArgs[1 - lastDraw].instanceCount);
+	EXPECT_EQ(nodeCount/2 - 1, drawArgs[lastDraw].instanceCount);
+	for (uint32_t i = 0; i < drawArgs.size(); ++i)
+	{
+		const dsDrawIndexedRange& draw = drawArgs[i];
+		for (uint32_t j = 0; j < draw.instanceCount; ++j)
+		{
+			uint32_t instance = visibleInstances[draw.firstInstance + j];
+			ASSERT_GT(nodeCount, instance);
+			EXPECT_EQ(i, instances[instance].drawIndex);
+			EXPECT_NE(nodeCount - 1,
+				static_cast<uint32_t>(instances[instance].transform.columns[3].x));
+		}
+	}
+
+	// Each frame is culled again without rebuilding the instances.
+	indirectDrawCounts.clear();
+	draw(itemList);
+	EXPECT_EQ(2U, dispatchCount);
+	EXPECT_EQ(2U, indirectDrawCounts.size());
+
+	for (uint32_t i = 1; i < nodeCount; i += 2)
+		itemList->type->removeNodeFunc(itemList, treeNodes + i, nodeIDs[i]);
+
+	indirectDrawCounts.clear();
+	draw(itemList);
+	EXPECT_EQ(nodeCount/2, dsSceneIndirectModelList_getInstanceCount(modelList));
+	EXPECT_EQ(1U, dsSceneIndirectModelList_getDrawCount(modelList));
+	EXPECT_EQ(3U, dispatchCount);
+	EXPECT_EQ(1U, indirectDrawCounts.size());
+
+	dsSceneItemList_destroy(itemList);
+	for (uint32_t i = 0; i < nodeCount; ++i)
+		dsSceneNode_freeRef(nodes[i]);
+
+	dsMaterial_destroy(cullMaterial);
+	dsMaterial_destroy(drawMaterial2);
+	dsMaterial_destroy(drawMaterial1);
+	EXPECT_TRUE(dsShader_destroy(cullShader));
+	EXPECT_TRUE(dsShader_destroy(drawShader));
+	EXPECT_TRUE(dsMaterialDesc_destroy(cullDesc));
+	EXPECT_TRUE(dsMaterialDesc_destroy(drawDesc));
+}
+
+TEST_F(SceneModelListTest, IncrementalSort)
+{
+	dsSceneModelList* modelList = createModelList();
+	ASSERT_TRUE(modelList);
+	dsSceneItemList* itemList = reinterpret_cast<dsSceneItemList*>(modelList);
+	dsSceneModelList_setSortType(modelList, dsModelSortType_BackToFront);
+	EXPECT_FALSE(dsSceneModelList_getIncrementalSort(modelList));
+	dsSceneModelList_setIncrementalSort(modelList, true);
+	EXPECT_TRUE(dsSceneModelList_getIncrementalSort(modelList));
+
+	// The first vertex identifies each node when drawn.
+	dsSceneNode* nodes[nodeCount];
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		nodes[i] = reinterpret_cast<dsSceneNode*>(createModelNode(material1, i));
+		ASSERT_TRUE(nodes[i]);
+	}
+	uint64_t nodeIDs[nodeCount];
+	addNodes(itemList, nodes, nodeIDs);
+
+	// Distance along the view direction is the negative Z.
+	for (uint32_t i = 0; i < nodeCount; ++i)
+		treeNodes[i].curFrameWorldTransform.columns[3].z = -static_cast<float>(i);
+
+	draw(itemList);
+	std::vector<uint32_t> expectedOrder = {9, 8, 7, 6, 5, 4, 3, 2, 1, 0};
+	EXPECT_EQ(expectedOrder, drawFirstVertices);
+
+	// Move nodes, remove a node, and add it back as a new entry.
+	treeNodes[2].curFrameWorldTransform.columns[3].z = -7.0f;
+	treeNodes[7].curFrameWorldTransform.columns[3].z = -2.0f;
+	itemList->type->removeNodeFunc(itemList, treeNodes + 5, nodeIDs[5]);
+	drawFirstVertices.clear();
+	draw(itemList);
+	expectedOrder = {9, 8, 2, 6, 4, 3, 7, 1, 0};
+	EXPECT_EQ(expectedOrder, drawFirstVertices);
+
+	treeNodes[5].curFrameWorldTransform.columns[3].z = -5.5f;
+	void* thisItemData = nullptr;
+	EXPECT_NE(DS_NO_SCENE_NODE, itemList->type->addNodeFunc(itemList, nodes[5], treeNodes + 5,
+		&itemData, &thisItemData));
+	drawFirstVertices.clear();
+	draw(itemList);
+	expectedOrder = {9, 8, 2, 6, 5, 4, 3, 7, 1, 0};
+	EXPECT_EQ(expectedOrder, drawFirstVertices);
+
+	// Should be the same as a full sort.
+	dsSceneModelList_setIncrementalSort(modelList, false);
+	drawFirstVertices.clear();
+	draw(itemList);
+	EXPECT_EQ(expectedOrder, drawFirstVertices);
+
+	// Alternate between views facing opposite directions, which keep separate orders.
+	dsSceneModelList_setIncrementalSort(modelList, true);
+	dsView views[2];
+	initView(views[0]);
+	initView(views[1]);
+	dsMatrix44f_makeRotate(&views[1].cameraMatrix, 0.0f, M_PIf, 0.0f);
+	std::vector<uint32_t> reverseOrder(expectedOrder.rbegin(), expectedOrder.rend());
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		drawFirstVertices.clear();
+		draw(itemList, views[i % 2]);
+		EXPECT_EQ(i % 2 ? reverseOrder : expectedOrder, drawFirstVertices) << "frame " << i;
+	}
+
+	dsSceneItemList_destroy(itemList);
+	for (uint32_t i = 0; i < nodeCount; ++i)
+		dsSceneNode_freeRef(nodes[i]);
+}
+
+#if DS_PERFORMANCE_TESTS
+TEST_F(SceneModelListTest, IncrementalSortPerformance)
+{
+	const uint32_t performanceNodeCount = 10000;
+	const uint32_t performanceFrames = 100;
+
+	dsSceneModelList* modelList = createModelList();
+	ASSERT_TRUE(modelList);
+	dsSceneItemList* itemList = reinterpret_cast<dsSceneItemList*>(modelList);
+	dsSceneModelList_setSortType(modelList, dsModelSortType_BackToFront);
+
+	dsSceneNode* nodes[] =
+	{
+		reinterpret_cast<dsSceneNode*>(createModelNode(material1)),
+		reinterpret_cast<dsSceneNode*>(createModelNode(material2))
+	};
+	ASSERT_TRUE(nodes[0]);
+	ASSERT_TRUE(nodes[1]);
+
+	// Static camera with a grid of nodes in front of it.
+	std::vector<dsSceneTreeNode> performanceTreeNodes(performanceNodeCount);
+	for (uint32_t i = 0; i < performanceNodeCount; ++i)
+	{
+		dsSceneTreeNode& treeNode = performanceTreeNodes[i];
+		treeNode = {};
+		dsMatrix44_identity(treeNode.curFrameWorldTransform);
+		treeNode.curFrameWorldTransform.columns[3].x = static_cast<float>(i % 100);
+		treeNode.curFrameWorldTransform.columns[3].z = -static_cast<float>(i/100);
+		void* thisItemData = nullptr;
+		EXPECT_NE(DS_NO_SCENE_NODE, itemList->type->addNodeFunc(itemList, nodes[i % 2],
+			&treeNode, &itemData, &thisItemData));
+	}
+
+	// Alternate between two views looking at the grid from opposite sides, such as for separate
+	// reflection and main views.
+	dsView views[2];
+	initView(views[0]);
+	initView(views[1]);
+	dsMatrix44f_makeRotate(&views[1].cameraMatrix, 0.0f, M_PIf, 0.0f);
+	views[1].cameraMatrix.columns[3].z = -100.0f;
+
+	const char* modeNames[] = {"Full sort", "Incremental sort", "Full sort, two views",
+		"Incremental sort, two views"};
+	dsTimer timer = dsTimer_create();
+	for (unsigned int mode = 0; mode < DS_ARRAY_SIZE(modeNames); ++mode)
+	{
+		dsSceneModelList_setIncrementalSort(modelList, mode % 2 == 1);
+		unsigned int viewCount = mode < 2 ? 1 : 2;
+		uint64_t start = dsTimer_currentTicks();
+		for (uint32_t i = 0; i < performanceFrames; ++i)
+		{
+			drawInstanceCounts.clear();
+			drawFirstVertices.clear();
+			draw(itemList, views[i % viewCount]);
+		}
+		double frameTime = dsTimer_ticksToSeconds(timer, dsTimer_currentTicks() - start)/
+			performanceFrames;
+		EXPECT_EQ(performanceNodeCount, drawInstanceCounts.size());
+
+		printf("%s: %g ms/frame\n", modeNames[mode], frameTime*1000.0);
+	}
+
+	dsSceneItemList_destroy(itemList);
+	dsSceneNode_freeRef(nodes[0]);
+	dsSceneNode_freeRef(nodes[1]);
+}
+#endif // DS_PERFORMANCE_TESTS
+
+TEST_F(SceneModelListTest, CullLists)
+{
+	const char* cullLists[] = {"cull"};
+	dsSceneModelList* modelList = createModelList(cullLists, DS_ARRAY_SIZE(cullLists));
+	ASSERT_TRUE(modelList);
+	dsSceneItemList* itemList = reinterpret_cast<dsSceneItemList*>(modelList);
+
+	dsSceneModelDrawRange drawRange;
+	drawRange.drawRange.vertexCount = 3;
+	drawRange.drawRange.instanceCount = 1;
+	drawRange.drawRange.firstVertex = 0;
+	drawRange.drawRange.firstInstance = 0;
+	dsSceneNode* node = reinterpret_cast<dsSceneNode*>(createModelNode(shader, material1,
+		geometry, drawRange, cullLists, DS_ARRAY_SIZE(cullLists)));
+	ASSERT_TRUE(node);
+
+	uint32_t cullListID = dsUniqueNameID_get(cullLists[0]);
+	uint64_t cullMask = 0;
+	EXPECT_FALSE(dsSceneNodeItemData_getIndexMask(nullptr, node, &cullListID, 1));
+	EXPECT_FALSE(dsSceneNodeItemData_getIndexMask(&cullMask, nullptr, &cullListID, 1));
+	ASSERT_TRUE(dsSceneNodeItemData_getIndexMask(&cullMask, node, &cullListID, 1));
+	ASSERT_NE(0U, cullMask);
+	uint32_t cullIndex = dsCtz64(cullMask);
+	EXPECT_EQ(static_cast<uint64_t>(1) << cullIndex, cullMask);
+	ASSERT_LT(cullIndex, node->itemListCount);
+	EXPECT_STREQ(cullLists[0], node->itemLists[cullIndex]);
+
+	// Item data for two tree nodes, where the second is culled.
+	dsSceneItemData itemDataSlots[2][2] = {};
+	dsSceneNodeItemData nodeItemData[2];
+	ASSERT_EQ(2U, node->itemListCount);
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		for (uint32_t j = 0; j < node->itemListCount; ++j)
+			itemDataSlots[i][j].nameID = dsUniqueNameID_get(node->itemLists[j]);
+		nodeItemData[i].itemData = itemDataSlots[i];
+		nodeItemData[i].count = node->itemListCount;
+	}
+	itemDataSlots[1][cullIndex].data = reinterpret_cast<void*>(true);
+
+	EXPECT_FALSE(dsSceneNodeItemData_anyInMask(nodeItemData, cullMask));
+	EXPECT_TRUE(dsSceneNodeItemData_anyInMask(nodeItemData + 1, cullMask));
+	EXPECT_FALSE(dsSceneNodeItemData_anyInMask(nodeItemData + 1, 0));
+
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		treeNodes[i] = {};
+		dsMatrix44_identity(treeNodes[i].curFrameWorldTransform);
+		void* thisItemData = nullptr;
+		EXPECT_NE(DS_NO_SCENE_NODE, itemList->type->addNodeFunc(itemList, node, treeNodes + i,
+			nodeItemData + i, &thisItemData));
+	}
+
+	draw(itemList);
+	EXPECT_EQ(1U, drawInstanceCounts.size());
+
+	itemDataSlots[1][cullIndex].data = nullptr;
+	drawInstanceCounts.clear();
+	draw(itemList);
+	EXPECT_EQ(2U, drawInstanceCounts.size());
+
+	dsSceneItemList_destroy(itemList);
+	dsSceneNode_freeRef(node);
+}
+
+TEST_F(SceneModelListTest, CommitRanges)
+{
+	dsSceneModelList* modelList = createModelList();
+	ASSERT_TRUE(modelList);
+	dsSceneItemList* itemList = reinterpret_cast<dsSceneItemList*>(modelList);
+	ASSERT_TRUE(itemList->type->prepareCommitRangesFunc);
+	ASSERT_TRUE(itemList->type->commitRangeFunc);
+	// Process the instances before the ranges as if the instance data needs a command buffer,
+	// since the view doesn't have a scene to get the renderer from.
+	itemList->skipPreRenderPass = false;
+
+	dsSceneNode* nodes[nodeCount];
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		nodes[i] = reinterpret_cast<dsSceneNode*>(
+			createModelNode(i % 2 == 0 ? material1 : material2, i));
+		ASSERT_TRUE(nodes[i]);
+	}
+	addNodes(itemList, nodes);
+
+	draw(itemList);
+	ASSERT_EQ(nodeCount, drawFirstVertices.size());
+	std::vector<uint32_t> expectedFirstVertices = drawFirstVertices;
+
+	for (uint32_t rangeCount = 1; rangeCount <= 4; ++rangeCount)
+	{
+		drawFirstVertices.clear();
+		drawRanges(itemList, rangeCount);
+		EXPECT_EQ(expectedFirstVertices, drawFirstVertices);
+	}
+
+	dsSceneItemList_destroy(itemList);
+	for (uint32_t i = 0; i < nodeCount; ++i)
+		dsSceneNode_freeRef(nodes[i]);
+}
+
+TEST_F(SceneModelListTest, CommitRangesInstanced)
+{
+	resourceManager->minUniformBufferAlignment = 64;
+	dsSceneModelList* modelList = createInstancedModelList();
+	ASSERT_TRUE(modelList);
+	dsSceneItemList* itemList = reinterpret_cast<dsSceneItemList*>(modelList);
+	dsSceneModelList_setInstancing(modelList, true);
+	itemList->skipPreRenderPass = false;
+
+	dsSceneNode* nodes[nodeCount];
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		nodes[i] = reinterpret_cast<dsSceneNode*>(
+			createInstancedModelNode(i % 2 == 0 ? instancedMaterial1 : instancedMaterial2));
+		ASSERT_TRUE(nodes[i]);
+	}
+	addNodes(itemList, nodes);
+
+	draw(itemList);
+	ASSERT_EQ(2U, drawInstanceCounts.size());
+	std::vector<uint32_t> expectedInstanceCounts = drawInstanceCounts;
+	std::vector<std::pair<size_t, size_t>> expectedInstanceRanges = boundInstanceRanges;
+
+	// Ranges may split the draw items for a batch, which should still be drawn once.
+	for (uint32_t rangeCount = 1; rangeCount <= 4; ++rangeCount)
+	{
+		drawInstanceCounts.clear();
+		boundInstanceRanges.clear();
+		drawRanges(itemList, rangeCount);
+		EXPECT_EQ(expectedInstanceCounts, drawInstanceCounts);
+		EXPECT_EQ(expectedInstanceRanges, boundInstanceRanges);
+	}
+
+	dsSceneItemList_destroy(itemList);
+	for (uint32_t i = 0; i < nodeCount; ++i)
+		dsSceneNode_freeRef(nodes[i]);
+}
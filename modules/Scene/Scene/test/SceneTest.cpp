@@ -19,6 +19,8 @@
 #include <DeepSea/Core/Containers/Hash.h>
 #include <DeepSea/Core/Containers/ResizeableArray.h>
 #include <DeepSea/Core/Memory/Allocator.h>
+#include <DeepSea/Core/Thread/ThreadPool.h>
+#include <DeepSea/Core/Timer.h>
 
 #include <DeepSea/Math/Core.h>
 #include <DeepSea/Math/Matrix44.h>
@@ -32,6 +34,10 @@
 #include <DeepSea/Scene/SceneTick.h>
 
 #include <gtest/gtest.h>
+#include <cstdio>
+
+// Enable to run performance tests.
+#define DS_PERFORMANCE_TESTS 0
 
 namespace
 {
@@ -222,6 +228,54 @@ MockSceneItemList* createMockSceneItems(
 	return mockItems;
 }
 
+dsSceneNode* createTransformTree(dsAllocator* allocator, dsSceneNode* leafNode,
+	unsigned int depth, unsigned int childCount, unsigned int index)
+{
+	dsMatrix44f rotate, translate, transform;
+	dsMatrix44f_makeRotate(&rotate, 0.1f*(float)index, -0.2f*(float)depth, 0.3f);
+	dsMatrix44f_makeTranslate(&translate, (float)index, -(float)depth, 0.5f*(float)index);
+	dsMatrix44f_affineMul(&transform, &translate, &rotate);
+	auto node = reinterpret_cast<dsSceneNode*>(
+		dsSceneTransformNode_create(allocator, &transform, nullptr, 0));
+	if (!node)
+		return nullptr;
+
+	if (depth == 0)
+	{
+		EXPECT_TRUE(dsSceneNode_addChild(node, leafNode));
+		return node;
+	}
+
+	for (unsigned int i = 0; i < childCount; ++i)
+	{
+		dsSceneNode* child = createTransformTree(allocator, leafNode, depth - 1, childCount, i);
+		EXPECT_TRUE(child);
+		if (!child)
+			break;
+
+		EXPECT_TRUE(dsSceneNode_addChild(node, child));
+		dsSceneNode_freeRef(child);
+	}
+
+	return node;
+}
+
+void expectSameTransforms(const dsSceneTreeNode* expected, const dsSceneTreeNode* actual)
+{
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		for (unsigned int j = 0; j < 4; ++j)
+		{
+			EXPECT_EQ(expected->curFrameWorldTransform.values[i][j],
+				actual->curFrameWorldTransform.values[i][j]);
+		}
+	}
+
+	ASSERT_EQ(expected->childCount, actual->childCount);
+	for (uint32_t i = 0; i < expected->childCount; ++i)
+		expectSameTransforms(expected->children[i], actual->children[i]);
+}
+
 } // namespace
 
 class SceneTest : public FixtureBase
@@ -347,3 +401,159 @@ TEST_F(SceneTest, CreateExistingScene)
 	dsSceneNode_freeRef((dsSceneNode*)transform1);
 	dsSceneNode_freeRef((dsSceneNode*)transform2);
 }
+
+TEST_F(SceneTest, UpdateThreadPool)
+{
+	dsSceneTick tick;
+	ASSERT_TRUE(dsSceneTick_initialize(&tick, 0.0f, 0.0f));
+
+	auto baseAllocator = reinterpret_cast<dsAllocator*>(&allocator);
+	dsThreadPool* threadPool = dsThreadPool_create(baseAllocator, 4, dsThreadPoolFlags_None, 0,
+		nullptr, nullptr, nullptr);
+	ASSERT_TRUE(threadPool);
+
+	// Same node hierarchy in two scenes, one updated on a single thread and one with the thread
+	// pool.
+	bool listsAlive[2];
+	MockSceneItemList* mockLists[2];
+	dsScene* scenes[2];
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		mockLists[i] = createMockSceneItems(baseAllocator, testListNames[0], i, listsAlive[i]);
+		ASSERT_TRUE(mockLists[i]);
+		dsScenePipelineItem pipeline = {nullptr, (dsSceneItemList*)mockLists[i]};
+		scenes[i] = dsScene_create(baseAllocator, renderer, nullptr, 0, &pipeline, 1, nullptr,
+			nullptr, nullptr);
+		ASSERT_TRUE(scenes[i]);
+	}
+
+	errno = 0;
+	EXPECT_FALSE(dsScene_setUpdateThreadPool(nullptr, threadPool));
+	EXPECT_EQ(EINVAL, errno);
+	EXPECT_FALSE(dsScene_getUpdateThreadPool(scenes[1]));
+	EXPECT_TRUE(dsScene_setUpdateThreadPool(scenes[1], threadPool));
+	EXPECT_EQ(threadPool, dsScene_getUpdateThreadPool(scenes[1]));
+
+	dsSceneNode* mockNode = createMockNode(baseAllocator);
+	ASSERT_TRUE(mockNode);
+	constexpr unsigned int depth = 3;
+	constexpr unsigned int childCount = 5;
+	constexpr uint32_t leafCount = childCount*childCount*childCount;
+	dsSceneNode* rootNode = createTransformTree(baseAllocator, mockNode, depth, childCount, 0);
+	ASSERT_TRUE(rootNode);
+	dsSceneNode_freeRef(mockNode);
+
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		ASSERT_TRUE(dsScene_addNode(scenes[i], rootNode));
+		EXPECT_TRUE(dsScene_update(scenes[i], &tick));
+		EXPECT_EQ(leafCount, mockLists[i]->itemCount);
+	}
+	ASSERT_EQ(2U, rootNode->treeNodeCount);
+	expectSameTransforms(rootNode->treeNodes[0], rootNode->treeNodes[1]);
+
+	// Update the root and several nested nodes so some dirty nodes share the same subtree.
+	dsMatrix44f transform;
+	dsMatrix44f_makeRotate(&transform, 0.5f, 0.25f, -0.75f);
+	EXPECT_TRUE(dsSceneTransformNode_setTransform(
+		reinterpret_cast<dsSceneTransformNode*>(rootNode), &transform));
+	dsSceneNode* child = rootNode->children[2];
+	dsSceneNode* grandchild = child->children[1];
+	dsMatrix44f_makeTranslate(&transform, 1.0f, 2.0f, 3.0f);
+	EXPECT_TRUE(dsSceneTransformNode_setTransform(
+		reinterpret_cast<dsSceneTransformNode*>(grandchild), &transform));
+	EXPECT_TRUE(dsSceneTransformNode_setTransform(
+		reinterpret_cast<dsSceneTransformNode*>(child), &transform));
+
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		for (uint32_t j = 0; j < mockLists[i]->itemCount; ++j)
+			mockLists[i]->items[j].updateCount = 0;
+		EXPECT_TRUE(dsScene_update(scenes[i], &tick));
+		for (uint32_t j = 0; j < mockLists[i]->itemCount; ++j)
+			EXPECT_EQ(1U, mockLists[i]->items[j].updateCount);
+	}
+	expectSameTransforms(rootNode->treeNodes[0], rootNode->treeNodes[1]);
+
+	// Only update a nested subtree.
+	dsMatrix44f_makeScale(&transform, 2.0f, 3.0f, 4.0f);
+	EXPECT_TRUE(dsSceneTransformNode_setTransform(
+		reinterpret_cast<dsSceneTransformNode*>(child), &transform));
+	for (unsigned int i = 0; i < 2; ++i)
+		EXPECT_TRUE(dsScene_update(scenes[i], &tick));
+	expectSameTransforms(rootNode->treeNodes[0], rootNode->treeNodes[1]);
+
+	EXPECT_TRUE(dsScene_setUpdateThreadPool(scenes[1], nullptr));
+	EXPECT_FALSE(dsScene_getUpdateThreadPool(scenes[1]));
+	EXPECT_TRUE(dsScene_setUpdateThreadPool(scenes[1], threadPool));
+
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		dsScene_destroy(scenes[i]);
+		EXPECT_FALSE(listsAlive[i]);
+	}
+	dsSceneNode_freeRef(rootNode);
+	EXPECT_TRUE(dsThreadPool_destroy(threadPool));
+}
+
+#if DS_PERFORMANCE_TESTS
+TEST_F(SceneTest, UpdatePerformance)
+{
+	dsSceneTick tick;
+	ASSERT_TRUE(dsSceneTick_initialize(&tick, 0.0f, 0.0f));
+
+	auto baseAllocator = reinterpret_cast<dsAllocator*>(&allocator);
+	dsThreadPool* threadPool = dsThreadPool_create(baseAllocator,
+		dsThreadPool_defaultThreadCount(), dsThreadPoolFlags_None, 0, nullptr, nullptr, nullptr);
+	ASSERT_TRUE(threadPool);
+
+	bool listAlive;
+	MockSceneItemList* mockList = createMockSceneItems(baseAllocator, testListNames[0], 0,
+		listAlive);
+	ASSERT_TRUE(mockList);
+	dsScenePipelineItem pipeline = {nullptr, (dsSceneItemList*)mockList};
+	dsScene* scene = dsScene_create(baseAllocator, renderer, nullptr, 0, &pipeline, 1, nullptr,
+		nullptr, nullptr);
+	ASSERT_TRUE(scene);
+
+	dsSceneNode* mockNode = createMockNode(baseAllocator);
+	ASSERT_TRUE(mockNode);
+	// 8^5 leaves with a transform node above each.
+	constexpr unsigned int depth = 5;
+	constexpr unsigned int childCount = 8;
+	dsSceneNode* rootNode = createTransformTree(baseAllocator, mockNode, depth, childCount, 0);
+	ASSERT_TRUE(rootNode);
+	dsSceneNode_freeRef(mockNode);
+	ASSERT_TRUE(dsScene_addNode(scene, rootNode));
+	EXPECT_TRUE(dsScene_update(scene, &tick));
+
+	uint32_t nodeCount = 0;
+	uint32_t levelCount = 1;
+	for (unsigned int i = 0; i <= depth; ++i)
+	{
+		nodeCount += levelCount*2;
+		levelCount *= childCount;
+	}
+
+	dsTimer timer = dsTimer_create();
+	constexpr unsigned int iterations = 100;
+	for (unsigned int threaded = 0; threaded < 2; ++threaded)
+	{
+		EXPECT_TRUE(dsScene_setUpdateThreadPool(scene, threaded ? threadPool : nullptr));
+		uint64_t start = dsTimer_currentTicks();
+		for (unsigned int i = 0; i < iterations; ++i)
+		{
+			dsSceneTreeNode_markDirty(rootNode->treeNodes[0]);
+			EXPECT_TRUE(dsScene_update(scene, &tick));
+		}
+		double elapsed = dsTimer_ticksToSeconds(timer, dsTimer_currentTicks() - start);
+		printf("%s update: %u nodes, %g nodes/ms\n", threaded ? "Threaded" : "Single-threaded",
+			nodeCount, nodeCount*iterations/(elapsed*1000.0));
+	}
+
+	dsScene_destroy(scene);
+	EXPECT_FALSE(listAlive);
+	dsSceneNode_freeRef(rootNode);
+	EXPECT_TRUE(dsThreadPool_destroy(threadPool));
+}
+#endif // DS_PERFORMANCE_TESTS
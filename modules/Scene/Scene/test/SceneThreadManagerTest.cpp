@@ -0,0 +1,341 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FixtureBase.h"
+
+#include <DeepSea/Core/Thread/ThreadPool.h>
+
+#include <DeepSea/Render/Resources/DrawGeometry.h>
+#include <DeepSea/Render/Resources/GfxBuffer.h>
+#include <DeepSea/Render/Resources/GfxFormat.h>
+#include <DeepSea/Render/Resources/Material.h>
+#include <DeepSea/Render/Resources/MaterialDesc.h>
+#include <DeepSea/Render/Resources/ResourceManager.h>
+#include <DeepSea/Render/Resources/Shader.h>
+#include <DeepSea/Render/Resources/ShaderModule.h>
+#include <DeepSea/Render/Resources/ShaderVariableGroupDesc.h>
+#include <DeepSea/Render/Resources/VertexFormat.h>
+#include <DeepSea/Render/RenderPass.h>
+#include <DeepSea/Render/RenderSurface.h>
+
+#include <DeepSea/Scene/ItemLists/SceneInstanceVariables.h>
+#include <DeepSea/Scene/ItemLists/SceneModelList.h>
+#include <DeepSea/Scene/Nodes/SceneModelNode.h>
+#include <DeepSea/Scene/Nodes/SceneNode.h>
+#include <DeepSea/Scene/Scene.h>
+#include <DeepSea/Scene/SceneRenderPass.h>
+#include <DeepSea/Scene/SceneThreadManager.h>
+#include <DeepSea/Scene/SceneTick.h>
+#include <DeepSea/Scene/View.h>
+
+#include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+
+// Enough for the model lists to be split into multiple ranges.
+const uint32_t nodeCount = 1000;
+const uint32_t otherNodeCount = 10;
+
+// Draws are recorded per command buffer, and appended to the command buffer they are submitted
+// to. The draws for the main command buffer are then in the order they will be executed.
+std::mutex drawMutex;
+std::map<const dsCommandBuffer*, std::vector<uint32_t>> commandBufferDraws;
+std::vector<const dsCommandBuffer*> submittedCommandBuffers;
+dsSubmitCommandBufferFunction submitCommandBuffer;
+
+bool recordDraw(dsRenderer*, dsCommandBuffer* commandBuffer, const dsDrawGeometry*,
+	const dsDrawRange* drawRange, dsPrimitiveType)
+{
+	std::lock_guard<std::mutex> lock(drawMutex);
+	commandBufferDraws[commandBuffer].push_back(drawRange->firstVertex);
+	return true;
+}
+
+bool recordSubmit(dsRenderer* renderer, dsCommandBuffer* commandBuffer,
+	dsCommandBuffer* submitBuffer)
+{
+	{
+		std::lock_guard<std::mutex> lock(drawMutex);
+		std::vector<uint32_t>& draws = commandBufferDraws[commandBuffer];
+		const std::vector<uint32_t>& submitDraws = commandBufferDraws[submitBuffer];
+		draws.insert(draws.end(), submitDraws.begin(), submitDraws.end());
+		submittedCommandBuffers.push_back(submitBuffer);
+	}
+	return submitCommandBuffer(renderer, commandBuffer, submitBuffer);
+}
+
+void populateInstances(void*, const dsView*, const dsViewRenderPassParams*,
+	const dsSceneTreeNode* const*, uint32_t, const dsShaderVariableGroupDesc*, uint8_t*, uint32_t)
+{
+}
+
+dsSceneInstanceVariablesType instanceVariablesType = {&populateInstances, nullptr, nullptr,
+	nullptr};
+
+} // namespace
+
+class SceneThreadManagerTest : public FixtureBase
+{
+public:
+	void SetUp() override
+	{
+		FixtureBase::SetUp();
+		commandBufferDraws.clear();
+		submittedCommandBuffers.clear();
+		renderer->drawFunc = &recordDraw;
+		submitCommandBuffer = renderer->submitCommandBufferFunc;
+		renderer->submitCommandBufferFunc = &recordSubmit;
+
+		renderSurface = dsRenderSurface_create(renderer, nullptr, "test", nullptr, nullptr,
+			dsRenderSurfaceType_Direct, dsRenderSurfaceUsage_Standard, 1920, 1080);
+		ASSERT_TRUE(renderSurface);
+
+		dsShaderVariableElement transformElements[] =
+		{
+			{"modelViewProjection", dsMaterialType_Mat4, 0},
+			{"normalMat", dsMaterialType_Mat3, 0}
+		};
+		transformDesc = dsShaderVariableGroupDesc_create(resourceManager, nullptr,
+			transformElements, DS_ARRAY_SIZE(transformElements));
+		ASSERT_TRUE(transformDesc);
+
+		dsMaterialElement elements[] =
+		{
+			{"diffuseTexture", dsMaterialType_Texture, 0, nullptr, dsMaterialBinding_Material, 0},
+			{"colorMultiplier", dsMaterialType_Vec4, 0, nullptr, dsMaterialBinding_Material, 0},
+			{"textureScaleOffset", dsMaterialType_Vec2, 2, nullptr, dsMaterialBinding_Material,
+				0},
+			{"Transform", dsMaterialType_VariableGroup, 0, transformDesc,
+				dsMaterialBinding_Instance, 0}
+		};
+		materialDesc = dsMaterialDesc_create(resourceManager, nullptr, elements,
+			DS_ARRAY_SIZE(elements));
+		ASSERT_TRUE(materialDesc);
+
+		shaderModule = dsShaderModule_loadFile(resourceManager, nullptr, DS_SCENE_TEST_SHADER,
+			"test");
+		ASSERT_TRUE(shaderModule);
+		shader = dsShader_createName(resourceManager, nullptr, shaderModule, "Test", materialDesc);
+		ASSERT_TRUE(shader);
+
+		material1 = dsMaterial_create(resourceManager, nullptr, materialDesc);
+		ASSERT_TRUE(material1);
+		material2 = dsMaterial_create(resourceManager, nullptr, materialDesc);
+		ASSERT_TRUE(material2);
+
+		dsVertexBuffer vertexBuffer = {};
+		ASSERT_TRUE(dsVertexFormat_initialize(&vertexBuffer.format));
+		EXPECT_TRUE(dsVertexFormat_setAttribEnabled(&vertexBuffer.format,
+			dsVertexAttrib_Position, true));
+		vertexBuffer.format.elements[dsVertexAttrib_Position].format =
+			dsGfxFormat_decorate(dsGfxFormat_X32Y32Z32, dsGfxFormat_Float);
+		EXPECT_TRUE(dsVertexFormat_computeOffsetsAndSize(&vertexBuffer.format));
+		vertexBuffer.offset = 0;
+		vertexBuffer.count = nodeCount + otherNodeCount + 2;
+
+		vertexGfxBuffer = dsGfxBuffer_create(resourceManager, nullptr, dsGfxBufferUsage_Vertex,
+			dsGfxMemory_Static | dsGfxMemory_Draw, nullptr,
+			vertexBuffer.count*vertexBuffer.format.size);
+		ASSERT_TRUE(vertexGfxBuffer);
+		vertexBuffer.buffer = vertexGfxBuffer;
+
+		dsVertexBuffer* vertexBuffers[DS_MAX_GEOMETRY_VERTEX_BUFFERS] = {&vertexBuffer};
+		geometry = dsDrawGeometry_create(resourceManager, nullptr, vertexBuffers, nullptr);
+		ASSERT_TRUE(geometry);
+
+		// Threads need resource contexts to create the instance data buffers.
+		constexpr unsigned int threadCount = 3;
+		resourceManager->maxResourceContexts = threadCount;
+		threadPool = dsResourceManager_createThreadPool(&allocator.allocator, resourceManager,
+			threadCount, dsThreadPoolFlags_None, 0);
+		ASSERT_TRUE(threadPool);
+		threadManager = dsSceneThreadManager_create(&allocator.allocator, renderer, threadPool);
+		ASSERT_TRUE(threadManager);
+
+		scene = createScene();
+		ASSERT_TRUE(scene);
+
+		dsViewSurfaceInfo surfaceInfo = {};
+		surfaceInfo.name = "window";
+		surfaceInfo.surfaceType = dsGfxSurfaceType_ColorRenderSurface;
+		surfaceInfo.windowFramebuffer = true;
+		surfaceInfo.surface = renderSurface;
+
+		dsFramebufferSurface framebufferSurface =
+			{dsGfxSurfaceType_ColorRenderSurface, dsCubeFace_None, 0, 0, (void*)"window"};
+		dsViewFramebufferInfo framebufferInfo = {"window", &framebufferSurface, 1, -1.0f, -1.0f,
+			1, {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}}, {{0.0f, 0.0f}, {1.0f, 1.0f}}};
+		view = dsView_create(&allocator.allocator, "view", scene, nullptr, &surfaceInfo, 1,
+			&framebufferInfo, 1, renderSurface->width, renderSurface->height,
+			dsRenderSurfaceRotation_0, 1.0f, dsViewScreenSizeDim_Width, nullptr, nullptr);
+		ASSERT_TRUE(view);
+	}
+
+	void TearDown() override
+	{
+		EXPECT_TRUE(dsView_destroy(view));
+		dsScene_destroy(scene);
+		for (dsSceneNode* node : nodes)
+			dsSceneNode_freeRef(node);
+		nodes.clear();
+		EXPECT_TRUE(dsSceneThreadManager_destroy(threadManager));
+		EXPECT_TRUE(dsThreadPool_destroy(threadPool));
+		EXPECT_TRUE(dsDrawGeometry_destroy(geometry));
+		EXPECT_TRUE(dsGfxBuffer_destroy(vertexGfxBuffer));
+		dsMaterial_destroy(material1);
+		dsMaterial_destroy(material2);
+		EXPECT_TRUE(dsShader_destroy(shader));
+		EXPECT_TRUE(dsShaderModule_destroy(shaderModule));
+		EXPECT_TRUE(dsMaterialDesc_destroy(materialDesc));
+		EXPECT_TRUE(dsShaderVariableGroupDesc_destroy(transformDesc));
+		EXPECT_TRUE(dsRenderSurface_destroy(renderSurface));
+		FixtureBase::TearDown();
+	}
+
+	dsSceneItemList* createModelList(const char* name)
+	{
+		dsSceneInstanceData* instanceData = dsSceneInstanceVariables_create(
+			&allocator.allocator, resourceManager, nullptr, transformDesc,
+			dsUniqueNameID_create("Transform"), &instanceVariablesType, nullptr);
+		if (!instanceData)
+			return nullptr;
+
+		return reinterpret_cast<dsSceneItemList*>(dsSceneModelList_create(&allocator.allocator,
+			name, nullptr, &instanceData, 1, dsModelSortType_Material, nullptr, nullptr, 0));
+	}
+
+	dsScene* createScene()
+	{
+		dsAttachmentInfo attachment = {dsAttachmentUsage_KeepAfter, renderer->surfaceColorFormat,
+			DS_DEFAULT_ANTIALIAS_SAMPLES};
+		dsAttachmentRef colorAttachment = {0, true};
+		dsRenderSubpassInfo subpass =
+			{"test", nullptr, &colorAttachment, {DS_NO_ATTACHMENT, false}, 0, 1};
+		dsRenderPass* renderPass = dsRenderPass_create(renderer, nullptr, &attachment, 1,
+			&subpass, 1, nullptr, 0);
+		if (!renderPass)
+			return nullptr;
+
+		// A list that's committed in ranges along with a small list that's committed in a single
+		// range.
+		dsSceneItemList* itemLists[] = {createModelList("models"), createModelList("otherModels")};
+		EXPECT_TRUE(itemLists[0]);
+		EXPECT_TRUE(itemLists[1]);
+		dsSceneItemLists drawLists = {itemLists, DS_ARRAY_SIZE(itemLists)};
+		dsSceneRenderPass* sceneRenderPass = dsSceneRenderPass_create(&allocator.allocator,
+			renderPass, "window", nullptr, 0, &drawLists, 1);
+		if (!sceneRenderPass)
+			return nullptr;
+
+		dsScenePipelineItem pipelineItem = {sceneRenderPass, nullptr};
+		return dsScene_create(&allocator.allocator, renderer, nullptr, 0, &pipelineItem, 1,
+			nullptr, nullptr, nullptr);
+	}
+
+	bool addNodes(const char* modelList, uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			dsSceneModelDrawRange drawRange;
+			drawRange.drawRange.vertexCount = 3;
+			drawRange.drawRange.instanceCount = 1;
+			drawRange.drawRange.firstVertex = static_cast<uint32_t>(nodes.size());
+			drawRange.drawRange.firstInstance = 0;
+
+			dsSceneModelInitInfo model = {};
+			model.shader = shader;
+			model.material = i % 2 == 0 ? material1 : material2;
+			model.geometry = geometry;
+			model.distanceRange.x = 0.0f;
+			model.distanceRange.y = -1.0f;
+			model.drawRanges = &drawRange;
+			model.drawRangeCount = 1;
+			model.primitiveType = dsPrimitiveType_TriangleList;
+			model.modelList = modelList;
+			dsSceneNode* node = reinterpret_cast<dsSceneNode*>(dsSceneModelNode_create(
+				&allocator.allocator, &model, 1, nullptr, 0, nullptr, 0, nullptr));
+			if (!node)
+				return false;
+
+			nodes.push_back(node);
+			if (!dsScene_addNode(scene, node))
+				return false;
+		}
+
+		return true;
+	}
+
+	std::vector<uint32_t> draw(dsSceneThreadManager* drawThreadManager)
+	{
+		commandBufferDraws.clear();
+		submittedCommandBuffers.clear();
+		dsCommandBuffer* commandBuffer = renderer->mainCommandBuffer;
+		EXPECT_TRUE(dsView_draw(view, commandBuffer, drawThreadManager));
+		return commandBufferDraws[commandBuffer];
+	}
+
+	dsRenderSurface* renderSurface;
+	dsShaderVariableGroupDesc* transformDesc;
+	dsMaterialDesc* materialDesc;
+	dsShaderModule* shaderModule;
+	dsShader* shader;
+	dsMaterial* material1;
+	dsMaterial* material2;
+	dsGfxBuffer* vertexGfxBuffer;
+	dsDrawGeometry* geometry;
+	dsThreadPool* threadPool;
+	dsSceneThreadManager* threadManager;
+	dsScene* scene;
+	dsView* view;
+	std::vector<dsSceneNode*> nodes;
+};
+
+TEST_F(SceneThreadManagerTest, CommitRanges)
+{
+	ASSERT_TRUE(addNodes("models", nodeCount));
+	ASSERT_TRUE(addNodes("otherModels", otherNodeCount));
+
+	dsSceneTick tick;
+	ASSERT_TRUE(dsSceneTick_initialize(&tick, 0.0f, 0.0f));
+	ASSERT_TRUE(dsScene_update(scene, &tick));
+	ASSERT_TRUE(dsView_update(view));
+
+	std::vector<uint32_t> expectedDraws = draw(nullptr);
+	ASSERT_EQ(nodeCount + otherNodeCount, expectedDraws.size());
+	EXPECT_TRUE(submittedCommandBuffers.empty());
+
+	// The large list is split into a range for each thread plus the one for the other list.
+	EXPECT_EQ(expectedDraws, draw(threadManager));
+	EXPECT_EQ(dsThreadPool_getThreadCount(threadPool) + 2, submittedCommandBuffers.size());
+
+	// Draw again to re-use the tasks and command buffers.
+	EXPECT_EQ(expectedDraws, draw(threadManager));
+	EXPECT_EQ(dsThreadPool_getThreadCount(threadPool) + 2, submittedCommandBuffers.size());
+
+	// Small enough to only use a single range.
+	for (uint32_t i = 0; i < nodeCount - 10; ++i)
+		ASSERT_TRUE(dsScene_removeNode(scene, nodes[i]));
+	ASSERT_TRUE(dsScene_update(scene, &tick));
+
+	expectedDraws = draw(nullptr);
+	ASSERT_EQ(otherNodeCount + 10, expectedDraws.size());
+	EXPECT_EQ(expectedDraws, draw(threadManager));
+	EXPECT_EQ(2U, submittedCommandBuffers.size());
+}
@@ -0,0 +1,356 @@
+/*
+ * Copyright 2026 Aaron Barany
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FixtureBase.h"
+
+#include <DeepSea/Geometry/Frustum3.h>
+
+#include <DeepSea/Math/Matrix33.h>
+#include <DeepSea/Math/Matrix44.h>
+
+#include <DeepSea/Render/Resources/DrawGeometry.h>
+#include <DeepSea/Render/Resources/GfxBuffer.h>
+#include <DeepSea/Render/Resources/GfxFormat.h>
+#include <DeepSea/Render/Resources/VertexFormat.h>
+
+#include <DeepSea/Scene/ItemLists/SceneItemList.h>
+#include <DeepSea/Scene/ItemLists/ViewCullList.h>
+#include <DeepSea/Scene/Nodes/SceneModelNode.h>
+#include <DeepSea/Scene/Nodes/SceneNode.h>
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+
+// Grid of nodes that extends past the frustum on the X and Y axes.
+const int gridMinX = -15;
+const int gridMaxX = 15;
+const int gridMinY = -12;
+const int gridMaxY = 12;
+const uint32_t gridNodeCount = (gridMaxX - gridMinX + 1)*(gridMaxY - gridMinY + 1);
+const uint32_t maxNodes = gridNodeCount*2 + 2;
+
+// Node IDs for dynamic entries are in a separate range from static entries.
+const uint64_t dynamicNodeIDStart = 0x7FFFFFFFFFFFFFFFULL;
+
+bool getDynamicBounds(dsMatrix44f* outBoxMatrix, const dsSceneCullNode* node,
+	const dsSceneTreeNode* treeNode)
+{
+	dsMatrix44f_affineMul(outBoxMatrix, &treeNode->curFrameWorldTransform,
+		&node->staticLocalBoxMatrix);
+	return true;
+}
+
+} // namespace
+
+class ViewCullListTest : public FixtureBase
+{
+public:
+	void SetUp() override
+	{
+		FixtureBase::SetUp();
+
+		vertexGfxBuffer = dsGfxBuffer_create(resourceManager, nullptr, dsGfxBufferUsage_Vertex,
+			dsGfxMemory_Static | dsGfxMemory_Draw, nullptr, 1024);
+		ASSERT_TRUE(vertexGfxBuffer);
+
+		dsVertexBuffer vertexBuffer = {};
+		ASSERT_TRUE(dsVertexFormat_initialize(&vertexBuffer.format));
+		EXPECT_TRUE(dsVertexFormat_setAttribEnabled(&vertexBuffer.format,
+			dsVertexAttrib_Position, true));
+		vertexBuffer.format.elements[dsVertexAttrib_Position].format =
+			dsGfxFormat_decorate(dsGfxFormat_X32Y32Z32, dsGfxFormat_Float);
+		EXPECT_TRUE(dsVertexFormat_computeOffsetsAndSize(&vertexBuffer.format));
+		vertexBuffer.buffer = vertexGfxBuffer;
+		vertexBuffer.offset = 0;
+		vertexBuffer.count = 3;
+
+		dsVertexBuffer* vertexBuffers[DS_MAX_GEOMETRY_VERTEX_BUFFERS] = {&vertexBuffer};
+		geometry = dsDrawGeometry_create(resourceManager, nullptr, vertexBuffers, nullptr);
+		ASSERT_TRUE(geometry);
+
+		dsSceneModelDrawRange drawRange;
+		drawRange.drawRange.vertexCount = 3;
+		drawRange.drawRange.instanceCount = 1;
+		drawRange.drawRange.firstVertex = 0;
+		drawRange.drawRange.firstInstance = 0;
+
+		dsSceneModelInitInfo model = {};
+		model.geometry = geometry;
+		model.distanceRange.x = 0.0f;
+		model.distanceRange.y = -1.0f;
+		model.drawRanges = &drawRange;
+		model.drawRangeCount = 1;
+		model.primitiveType = dsPrimitiveType_TriangleList;
+
+		// Keep the bounds away from the frustum planes at integer positions to avoid precision
+		// differences between the cull implementations.
+		dsOrientedBox3f bounds;
+		dsMatrix33_identity(bounds.orientation);
+		bounds.center.x = 0.0f;
+		bounds.center.y = 0.0f;
+		bounds.center.z = 0.0f;
+		bounds.halfExtents.x = 0.4f;
+		bounds.halfExtents.y = 0.4f;
+		bounds.halfExtents.z = 0.4f;
+
+		staticNode = reinterpret_cast<dsSceneNode*>(dsSceneModelNode_create(&allocator.allocator,
+			&model, 1, nullptr, 0, nullptr, 0, &bounds));
+		ASSERT_TRUE(staticNode);
+
+		dynamicNode = reinterpret_cast<dsSceneNode*>(dsSceneModelNode_create(
+			&allocator.allocator, &model, 1, nullptr, 0, nullptr, 0, &bounds));
+		ASSERT_TRUE(dynamicNode);
+		reinterpret_cast<dsSceneCullNode*>(dynamicNode)->getBoundsFunc = &getDynamicBounds;
+
+		cullList = dsViewCullList_create(&allocator.allocator, "cull", nullptr);
+		ASSERT_TRUE(cullList);
+
+		view = {};
+		setViewOffset(0.0f);
+
+		treeNodes.resize(maxNodes);
+		results.resize(maxNodes);
+		nodeIDs.resize(maxNodes, DS_NO_SCENE_NODE);
+		nodeCount = 0;
+	}
+
+	void TearDown() override
+	{
+		dsSceneItemList_destroy(cullList);
+		dsSceneNode_freeRef(dynamicNode);
+		dsSceneNode_freeRef(staticNode);
+		EXPECT_TRUE(dsDrawGeometry_destroy(geometry));
+		EXPECT_TRUE(dsGfxBuffer_destroy(vertexGfxBuffer));
+		FixtureBase::TearDown();
+	}
+
+	void setPosition(uint32_t index, float x, float y)
+	{
+		dsSceneTreeNode& treeNode = treeNodes[index];
+		dsMatrix44_identity(treeNode.curFrameWorldTransform);
+		treeNode.curFrameWorldTransform.columns[3].x = x;
+		treeNode.curFrameWorldTransform.columns[3].y = y;
+		treeNode.curFrameWorldTransform.columns[3].z = -5.0f;
+	}
+
+	uint32_t addNode(dsSceneNode* node, float x, float y)
+	{
+		EXPECT_GT(maxNodes, nodeCount);
+		uint32_t index = nodeCount++;
+		treeNodes[index] = {};
+		setPosition(index, x, y);
+		// Set all bytes so results that aren't written are caught.
+		results[index] = reinterpret_cast<void*>(UINTPTR_MAX);
+		nodeIDs[index] = cullList->type->addNodeFunc(cullList, node, &treeNodes[index], nullptr,
+			&results[index]);
+		EXPECT_NE(DS_NO_SCENE_NODE, nodeIDs[index]);
+		return index;
+	}
+
+	void addGrid(dsSceneNode* node, int offset = 0)
+	{
+		for (int y = gridMinY; y <= gridMaxY; ++y)
+		{
+			for (int x = gridMinX; x <= gridMaxX; ++x)
+				addNode(node, static_cast<float>(x + offset), static_cast<float>(y));
+		}
+	}
+
+	void moveNode(uint32_t index, float x, float y)
+	{
+		setPosition(index, x, y);
+		if (cullList->type->updateNodeFunc)
+			cullList->type->updateNodeFunc(cullList, &treeNodes[index], nodeIDs[index]);
+	}
+
+	void removeNode(uint32_t index)
+	{
+		cullList->type->removeNodeFunc(cullList, &treeNodes[index], nodeIDs[index]);
+		nodeIDs[index] = DS_NO_SCENE_NODE;
+	}
+
+	void setViewOffset(float x)
+	{
+		dsMatrix44f projection;
+		dsMatrix44f_makeOrtho(&projection, -10.3f + x, 10.3f + x, -7.3f, 7.3f, 0.0f, 100.0f,
+			dsProjectionMatrixOptions_None);
+		dsFrustum3_fromMatrix(view.viewFrustum, projection, dsProjectionMatrixOptions_None);
+		dsFrustum3f_normalize(&view.viewFrustum);
+	}
+
+	// Culls with the view cull list and checks against culling each node individually. Results
+	// are kept between commits, since only the results that change are written.
+	void checkCull(uint32_t& outVisibleCount)
+	{
+		outVisibleCount = 0;
+		cullList->type->commitFunc(cullList, &view, nullptr, nullptr);
+		for (uint32_t i = 0; i < nodeCount; ++i)
+		{
+			if (nodeIDs[i] == DS_NO_SCENE_NODE)
+				continue;
+
+			const dsSceneCullNode* cullNode = reinterpret_cast<const dsSceneCullNode*>(
+				nodeIDs[i] < dynamicNodeIDStart ? staticNode : dynamicNode);
+			dsMatrix44f boxMatrix;
+			dsMatrix44f_affineMul(&boxMatrix, &treeNodes[i].curFrameWorldTransform,
+				&cullNode->staticLocalBoxMatrix);
+			bool expectedCulled = dsFrustum3f_intersectBoxMatrix(&view.viewFrustum,
+				&boxMatrix) == dsIntersectResult_Outside;
+			// The result is written as a bool to the start of the item data.
+			uint8_t culled = *reinterpret_cast<const uint8_t*>(&results[i]);
+			EXPECT_EQ(static_cast<uint8_t>(expectedCulled), culled) << "node " <<
+				i << " at (" << treeNodes[i].curFrameWorldTransform.columns[3].x << ", " <<
+				treeNodes[i].curFrameWorldTransform.columns[3].y << ")";
+			if (!expectedCulled)
+				++outVisibleCount;
+		}
+	}
+
+	dsGfxBuffer* vertexGfxBuffer;
+	dsDrawGeometry* geometry;
+	dsSceneNode* staticNode;
+	dsSceneNode* dynamicNode;
+	dsSceneItemList* cullList;
+	dsView view;
+
+	std::vector<dsSceneTreeNode> treeNodes;
+	std::vector<void*> results;
+	std::vector<uint64_t> nodeIDs;
+	uint32_t nodeCount;
+};
+
+TEST_F(ViewCullListTest, StaticNodes)
+{
+	addGrid(staticNode);
+
+	// Nodes in [-10, 10] on X and [-7, 7] on Y are in view.
+	const uint32_t gridVisibleCount = 21*15;
+	uint32_t visibleCount;
+	checkCull(visibleCount);
+	EXPECT_EQ(gridVisibleCount, visibleCount);
+
+	// Cull again without changes to re-use the BVH.
+	checkCull(visibleCount);
+	EXPECT_EQ(gridVisibleCount, visibleCount);
+
+	// Results aren't written again when nothing changes.
+	std::vector<void*> prevResults = results;
+	for (uint32_t i = 0; i < nodeCount; ++i)
+		results[i] = reinterpret_cast<void*>(UINTPTR_MAX);
+	cullList->type->commitFunc(cullList, &view, nullptr, nullptr);
+	for (uint32_t i = 0; i < nodeCount; ++i)
+		EXPECT_EQ(reinterpret_cast<void*>(UINTPTR_MAX), results[i]);
+	results = prevResults;
+
+	// Move the view so nodes enter and leave it.
+	setViewOffset(8.0f);
+	checkCull(visibleCount);
+	EXPECT_EQ(18*15U, visibleCount);
+
+	setViewOffset(-20.0f);
+	checkCull(visibleCount);
+	EXPECT_EQ(6*15U, visibleCount);
+}
+
+TEST_F(ViewCullListTest, AddRemoveStaticNodes)
+{
+	addGrid(staticNode);
+	uint32_t visibleCount;
+	checkCull(visibleCount);
+
+	// Remove every third node and add a shifted grid between frames.
+	for (uint32_t i = 0; i < gridNodeCount; i += 3)
+		removeNode(i);
+	addGrid(staticNode, 20);
+	checkCull(visibleCount);
+
+	// Only remove nodes.
+	for (uint32_t i = 1; i < nodeCount; i += 5)
+	{
+		if (nodeIDs[i] != DS_NO_SCENE_NODE)
+			removeNode(i);
+	}
+	checkCull(visibleCount);
+
+	// Only add nodes.
+	addNode(staticNode, 0.0f, 0.0f);
+	addNode(staticNode, 30.0f, 0.0f);
+	checkCull(visibleCount);
+
+	// Remove all nodes.
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		if (nodeIDs[i] != DS_NO_SCENE_NODE)
+			removeNode(i);
+	}
+	checkCull(visibleCount);
+	EXPECT_EQ(0U, visibleCount);
+}
+
+TEST_F(ViewCullListTest, MoveStaticNodes)
+{
+	addGrid(staticNode);
+	uint32_t visibleCount;
+	checkCull(visibleCount);
+
+	// Move nodes into and out of view so the BVH must be refit to visit them.
+	for (uint32_t i = 0; i < gridNodeCount; i += 7)
+	{
+		float x = treeNodes[i].curFrameWorldTransform.columns[3].x;
+		float y = treeNodes[i].curFrameWorldTransform.columns[3].y;
+		moveNode(i, -y, x);
+	}
+	checkCull(visibleCount);
+
+	// Move a single node far out of view and another from out of view to the center.
+	moveNode(gridNodeCount/2, 100.0f, 100.0f);
+	moveNode(0, 0.0f, 0.0f);
+	checkCull(visibleCount);
+
+	// Move and add nodes in the same frame.
+	moveNode(gridNodeCount/2, 1.0f, 1.0f);
+	addNode(staticNode, 2.0f, 2.0f);
+	checkCull(visibleCount);
+}
+
+TEST_F(ViewCullListTest, MixedStaticDynamicNodes)
+{
+	addGrid(staticNode);
+	uint32_t firstDynamic = nodeCount;
+	addGrid(dynamicNode, 5);
+	for (uint32_t i = firstDynamic; i < nodeCount; ++i)
+		EXPECT_LE(dynamicNodeIDStart, nodeIDs[i]);
+
+	uint32_t visibleCount;
+	checkCull(visibleCount);
+
+	// Dynamic nodes don't need to be updated when moved.
+	for (uint32_t i = firstDynamic; i < nodeCount; i += 3)
+	{
+		treeNodes[i].curFrameWorldTransform.columns[3].x =
+			-treeNodes[i].curFrameWorldTransform.columns[3].x;
+	}
+	for (uint32_t i = 0; i < firstDynamic; i += 4)
+		moveNode(i, 0.0f, 3.0f);
+	checkCull(visibleCount);
+
+	for (uint32_t i = 0; i < nodeCount; i += 2)
+		removeNode(i);
+	checkCull(visibleCount);
+}
@@ -657,6 +657,8 @@ dsSceneInstanceData* dsSceneSkinningData_create(dsAllocator* allocator,
 	else
 		instanceData->valueCount = 2;
 	instanceData->needsCommandBuffer = !useBuffers;
+	instanceData->maxInstanceRange = 1;
+	instanceData->instanceAlignment = 1;
 
 	skinningData->resourceAllocator = resourceAllocator ? resourceAllocator : allocator;
 	skinningData->resourceManager = resourceManager;
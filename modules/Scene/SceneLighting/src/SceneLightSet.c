@@ -35,12 +35,14 @@
 #include <DeepSea/SceneLighting/SceneLight.h>
 
 #include <float.h>
+#include <stddef.h>
 
 typedef struct LightNode
 {
 	dsHashTableNode node;
 	// Store ID separately in node to guarantee user changes to the ID field won't break this.
 	uint32_t id;
+	bool inSpatialLights;
 	dsSceneLight light;
 } LightNode;
 
@@ -84,6 +86,11 @@ static bool destroyResource(void* resource)
 	return true;
 }
 
+static LightNode* getLightNode(dsSceneLight* light)
+{
+	return (LightNode*)((uint8_t*)light - offsetof(LightNode, light));
+}
+
 static bool getLightBounds(void* outBounds, const dsBVH* bvh, const void* object)
 {
 	const dsSceneLightSet* lightSet = (const dsSceneLightSet*)dsBVH_getUserData(bvh);
@@ -302,6 +309,7 @@ dsSceneLight* dsSceneLightSet_addLightID(dsSceneLightSet* lightSet, uint32_t nam
 		return NULL;
 	}
 
+	node->inSpatialLights = false;
 	node->light.nameID = nameID;
 	return &node->light;
 }
@@ -351,6 +359,9 @@ bool dsSceneLightSet_removeLightID(dsSceneLightSet* lightSet, uint32_t nameID)
 	if (!node)
 		return false;
 
+	if (node->inSpatialLights)
+		DS_VERIFY(dsBVH_remove(lightSet->spatialLights, &node->light));
+
 	DS_VERIFY(dsAllocator_free((dsAllocator*)&lightSet->lightAllocator, node));
 	return true;
 }
@@ -395,6 +406,7 @@ bool dsSceneLightSet_clearLights(dsSceneLightSet* lightSet)
 	for (dsListNode* node = lightSet->lightTable->list.head; node; node = node->next)
 		DS_VERIFY(dsAllocator_free((dsAllocator*)&lightSet->lightAllocator, node));
 	DS_VERIFY(dsHashTable_clear(lightSet->lightTable));
+	dsBVH_clear(lightSet->spatialLights);
 	return true;
 }
 
@@ -475,16 +487,28 @@ bool dsSceneLightSet_prepare(dsSceneLightSet* lightSet, float intensityThreshold
 	lightSet->intensityThreshold = intensityThreshold;
 	lightSet->directionalLightCount = 0;
 
-	// Use the remaining space in directionalLights for temporary storage for building the BVH.
+	// Use the remaining space in directionalLights for temporary storage for the spatial lights.
 	uint32_t maxLights = (uint32_t)lightSet->lightAllocator.chunkCount;
 	uint32_t spatialLightCount = 0;
+	uint32_t newSpatialLightCount = 0;
+	bool rebuild = false;
 	dsListNode* node = lightSet->lightTable->list.head;
 	while (node)
 	{
-		dsSceneLight* light = &((LightNode*)node)->light;
+		LightNode* lightNode = (LightNode*)node;
+		dsSceneLight* light = &lightNode->light;
 		node = node->next;
 
 		float intensity = dsColor3f_grayscale(&light->color)*light->intensity;
+		bool isSpatial = light->type != dsSceneLightType_Directional &&
+			intensity >= intensityThreshold;
+		if (lightNode->inSpatialLights && !isSpatial)
+		{
+			if (!dsBVH_remove(lightSet->spatialLights, light))
+				rebuild = true;
+			lightNode->inSpatialLights = false;
+		}
+
 		if (intensity < intensityThreshold)
 			continue;
 
@@ -494,20 +518,55 @@ bool dsSceneLightSet_prepare(dsSceneLightSet* lightSet, float intensityThreshold
 		{
 			uint32_t index = maxLights - (++spatialLightCount);
 			lightSet->directionalLights[index] = light;
+			if (!lightNode->inSpatialLights)
+				++newSpatialLightCount;
 		}
 	}
 
-	// Build a BVH for the spatial (point and spot) lights.
+	dsSceneLight** spatialLights = lightSet->directionalLights + maxLights - spatialLightCount;
 	if (spatialLightCount == 0)
+	{
 		dsBVH_clear(lightSet->spatialLights);
-	else
+		return true;
+	}
+
+	// Insert any new lights and incrementally update the existing lights, which may have moved or
+	// changed the intensity threshold. Update after inserting so the BVH is fully refreshed for
+	// queries. Fully re-build if most of the lights are new.
+	if (!rebuild && newSpatialLightCount*2 <= spatialLightCount)
 	{
-		dsSceneLight** spatialLights = lightSet->directionalLights + maxLights - spatialLightCount;
-		if (!dsBVH_build(lightSet->spatialLights, spatialLights, spatialLightCount,
-				DS_GEOMETRY_OBJECT_POINTERS, &getLightBounds, false))
+		for (uint32_t i = 0; i < spatialLightCount && !rebuild; ++i)
 		{
-			return false;
+			LightNode* lightNode = getLightNode(spatialLights[i]);
+			if (lightNode->inSpatialLights)
+				continue;
+
+			if (dsBVH_insert(lightSet->spatialLights, spatialLights[i], &getLightBounds))
+				lightNode->inSpatialLights = true;
+			else
+				rebuild = true;
 		}
+
+		if (!rebuild && dsBVH_updateIncremental(lightSet->spatialLights, NULL))
+			return true;
+	}
+
+	for (uint32_t i = 0; i < spatialLightCount; ++i)
+	{
+		LightNode* lightNode = getLightNode(spatialLights[i]);
+		lightNode->inSpatialLights = false;
+	}
+
+	if (!dsBVH_buildSAH(lightSet->spatialLights, spatialLights, spatialLightCount,
+			DS_GEOMETRY_OBJECT_POINTERS, &getLightBounds, NULL))
+	{
+		return false;
+	}
+
+	for (uint32_t i = 0; i < spatialLightCount; ++i)
+	{
+		LightNode* lightNode = getLightNode(spatialLights[i]);
+		lightNode->inSpatialLights = true;
 	}
 
 	return true;
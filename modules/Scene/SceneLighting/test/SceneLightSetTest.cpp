@@ -236,6 +236,80 @@ TEST_F(SceneLightSetTest, FindBrightestLights)
 	dsSceneLightSet_destroy(lightSet);
 }
 
+TEST_F(SceneLightSetTest, PrepareAfterChanges)
+{
+	dsColor3f color = {{1.0f, 1.0f, 1.0f}};
+	dsSceneLightSet* lightSet = dsSceneLightSet_create((dsAllocator*)&allocator, 8, &color, 0.1f);
+	ASSERT_TRUE(lightSet);
+
+	dsVector3xf position = {{0.0f, 0.0f, 0.0f}};
+	dsSceneLight* lights[5];
+	const char* lightNames[] = {"first", "second", "third", "fourth", "fifth"};
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		position.x = (float)i*10.0f;
+		lights[i] = dsSceneLightSet_addLightName(lightSet, lightNames[i]);
+		ASSERT_TRUE(dsSceneLight_makePoint(lights[i], &position, &color, 1.0f, 1.0f, 1.0f));
+	}
+
+	EXPECT_TRUE(dsSceneLightSet_prepare(lightSet, 0.1f));
+
+	const dsSceneLight* brightestLights[4];
+	bool hasMain = false;
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		position.x = (float)i*10.0f;
+		ASSERT_EQ(1U, dsSceneLightSet_findBrightestLights(
+			brightestLights, 4, &hasMain, lightSet, &position));
+		EXPECT_EQ(lights[i], brightestLights[0]);
+	}
+
+	// Add a single light after the initial preparation.
+	position.x = 40.0f;
+	lights[4] = dsSceneLightSet_addLightName(lightSet, lightNames[4]);
+	ASSERT_TRUE(dsSceneLight_makePoint(lights[4], &position, &color, 1.0f, 1.0f, 1.0f));
+	EXPECT_TRUE(dsSceneLightSet_prepare(lightSet, 0.1f));
+	ASSERT_EQ(1U, dsSceneLightSet_findBrightestLights(
+		brightestLights, 4, &hasMain, lightSet, &position));
+	EXPECT_EQ(lights[4], brightestLights[0]);
+
+	// Move a light.
+	lights[0]->position.x = 50.0f;
+	EXPECT_TRUE(dsSceneLightSet_prepare(lightSet, 0.1f));
+	position.x = 0.0f;
+	EXPECT_EQ(0U, dsSceneLightSet_findBrightestLights(
+		brightestLights, 4, &hasMain, lightSet, &position));
+	position.x = 50.0f;
+	ASSERT_EQ(1U, dsSceneLightSet_findBrightestLights(
+		brightestLights, 4, &hasMain, lightSet, &position));
+	EXPECT_EQ(lights[0], brightestLights[0]);
+
+	// Remove a light and dim another below the threshold.
+	EXPECT_TRUE(dsSceneLightSet_removeLight(lightSet, lights[1]));
+	lights[2]->intensity = 0.05f;
+	EXPECT_TRUE(dsSceneLightSet_prepare(lightSet, 0.1f));
+	for (unsigned int i = 1; i < 3; ++i)
+	{
+		position.x = (float)i*10.0f;
+		EXPECT_EQ(0U, dsSceneLightSet_findBrightestLights(
+			brightestLights, 4, &hasMain, lightSet, &position));
+	}
+
+	position.x = 30.0f;
+	ASSERT_EQ(1U, dsSceneLightSet_findBrightestLights(
+		brightestLights, 4, &hasMain, lightSet, &position));
+	EXPECT_EQ(lights[3], brightestLights[0]);
+
+	lights[2]->intensity = 1.0f;
+	EXPECT_TRUE(dsSceneLightSet_prepare(lightSet, 0.1f));
+	position.x = 20.0f;
+	ASSERT_EQ(1U, dsSceneLightSet_findBrightestLights(
+		brightestLights, 4, &hasMain, lightSet, &position));
+	EXPECT_EQ(lights[2], brightestLights[0]);
+
+	dsSceneLightSet_destroy(lightSet);
+}
+
 TEST_F(SceneLightSetTest, ForEachLightInFrustum)
 {
 	dsColor3f color = {{1.0f, 1.0f, 1.0f}};
@@ -48,6 +48,9 @@ typedef struct Entry
 	dsParticleEmitter* emitter;
 	const dsSceneNodeItemData* itemData;
 	uint64_t nodeID;
+	// Indices for the cull list results within the item data.
+	uint64_t cullMask;
+	bool searchCullLists;
 } Entry;
 
 typedef struct dsSceneParticleDrawList
@@ -95,16 +98,21 @@ static void setupInstances(dsSceneItemList* itemList, const dsView* view,
 	{
 		// Particle draw uses the view frustum for culling.
 		Entry* entry = drawList->entries + i;
+		// Non-zero cull result means out of view.
 		bool culled = false;
-		for (uint32_t j = 0; j < drawList->cullListCount; ++j)
+		if (entry->searchCullLists)
 		{
-			// Non-zero cull result means out of view.
-			if (dsSceneNodeItemData_findID(entry->itemData, drawList->cullListIDs[j]))
+			for (uint32_t j = 0; j < drawList->cullListCount; ++j)
 			{
-				culled = true;
-				break;
+				if (dsSceneNodeItemData_findID(entry->itemData, drawList->cullListIDs[j]))
+				{
+					culled = true;
+					break;
+				}
 			}
 		}
+		else
+			culled = dsSceneNodeItemData_anyInMask(entry->itemData, entry->cullMask);
 		if (culled)
 			continue;
 
@@ -183,6 +191,8 @@ static uint64_t dsSceneParticleDrawList_addNode(dsSceneItemList* itemList, dsSce
 	entry->emitter = emitter;
 	entry->itemData = itemData;
 	entry->nodeID = drawList->nextNodeID++;
+	entry->searchCullLists = !dsSceneNodeItemData_getIndexMask(&entry->cullMask, node,
+		drawList->cullListIDs, drawList->cullListCount);
 	return entry->nodeID;
 }
 
@@ -403,7 +403,7 @@ static bool setup(TestLighting* testLighting, dsApplication* application, dsAllo
 	testLighting->renderer = renderer;
 
 	testLighting->threadPool = dsResourceManager_createThreadPool(
-		allocator, resourceManager, dsThreadPool_defaultThreadCount(), 0);
+		allocator, resourceManager, dsThreadPool_defaultThreadCount(), dsThreadPoolFlags_None, 0);
 	if (!testLighting->threadPool)
 		return false;
 
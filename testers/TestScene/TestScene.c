@@ -348,7 +348,8 @@ static bool setup(
 	testScene->secondarySceneSet = true;
 
 	testScene->threadPool = dsResourceManager_createThreadPool(
-		allocator, renderer->resourceManager, dsThreadPool_defaultThreadCount(), 0);
+		allocator, renderer->resourceManager, dsThreadPool_defaultThreadCount(),
+		dsThreadPoolFlags_None, 0);
 	if (!testScene->threadPool)
 		return false;
 